@@ -0,0 +1,153 @@
+#ifndef CORNER_CASES_CUBELIB_BATCH_H
+#define CORNER_CASES_CUBELIB_BATCH_H 1
+
+
+#include "cubelib/cubelib.h"
+
+#ifndef __OPENCL_VERSION__
+    #include <stddef.h>
+    #include <stdint.h>
+#endif
+
+/**
+ * @addtogroup cubelib-batch-group Batch API
+ *
+ * Structure-of-arrays versions of the most common cubelib queries, for processing many elements at once.
+ *
+ * Every array holds the raw `value` of the elements, one `uint8_t` per element (see cubelib_corner_t::value etc.).
+ * Input and output arrays must not overlap; all inputs must be valid, non-null elements (the batch functions do not assert). Outputs are the same
+ * as the corresponding single-element function, including null elements where that function returns them.
+ *
+ * Each function comes in three flavours:
+ *  * `*_n_scalar()`: a plain branch-free loop, written so that the compiler can auto-vectorize it.
+ *  * `*_n_sse42()`, `*_n_avx2()`: explicit SSE4.2/AVX2 paths; only available when
+ *      @c CUBELIB_BATCH_HAS_X86_SIMD is defined, and only callable if the CPU supports the instruction set.
+ *  * `*_n()`: picks the widest of the above that the CPU supports, at runtime (see cubelib_batch_isa()).
+ *
+ * Define @c CUBELIB_BATCH_NO_SIMD to compile out the explicit paths.
+ *  @{
+ */
+
+#if defined(__cplusplus)
+    #define CUBELIB_RESTRICT __restrict
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 199901L
+    #define CUBELIB_RESTRICT restrict
+#else
+    #define CUBELIB_RESTRICT
+#endif
+
+#if !defined(CUBELIB_BATCH_NO_SIMD) && !defined(__OPENCL_VERSION__) \
+        && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64)) \
+        && (defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER))
+    #define CUBELIB_BATCH_HAS_X86_SIMD 1
+#endif
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+    ///@brief The instruction sets cubelib_batch_isa() can pick.
+    typedef enum cubelib_batch_isa_t{
+          CUBELIB_BATCH_ISA_SCALAR = 0
+        , CUBELIB_BATCH_ISA_SSE42 = 1
+        , CUBELIB_BATCH_ISA_AVX2 = 2
+    } cubelib_batch_isa_t;
+
+    ///@brief Queries the CPU for the widest instruction set the batch functions have a path for.
+    CUBELIB_FUNCTION_QUALIFIER cubelib_batch_isa_t cubelib_batch_detect_isa(void);
+    ///@brief Same as cubelib_batch_detect_isa(), but only queries the CPU once (per translation unit).
+    CUBELIB_FUNCTION_QUALIFIER cubelib_batch_isa_t cubelib_batch_isa(void);
+
+
+    ///@brief `result[i] = cubelib_get_opposite_corner(corners[i])`
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_get_opposite_corner_n(const uint8_t* CUBELIB_RESTRICT corners
+                                                                , uint8_t* CUBELIB_RESTRICT result, size_t n);
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_get_opposite_corner_n_scalar(const uint8_t* CUBELIB_RESTRICT corners
+                                                                       , uint8_t* CUBELIB_RESTRICT result, size_t n);
+
+    ///@brief `result[i] = cubelib_get_adjacent_corner(corners[i], directions[i])`
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_get_adjacent_corner_n(const uint8_t* CUBELIB_RESTRICT corners
+                                                                , const uint8_t* CUBELIB_RESTRICT directions
+                                                                , uint8_t* CUBELIB_RESTRICT result, size_t n);
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_get_adjacent_corner_n_scalar(const uint8_t* CUBELIB_RESTRICT corners
+                                                                       , const uint8_t* CUBELIB_RESTRICT directions
+                                                                       , uint8_t* CUBELIB_RESTRICT result, size_t n);
+
+    ///@brief `result[i] = cubelib_corner_move(corners[i], directions[i])`; null corners where the move leaves the cube.
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_corner_move_n(const uint8_t* CUBELIB_RESTRICT corners
+                                                        , const uint8_t* CUBELIB_RESTRICT directions
+                                                        , uint8_t* CUBELIB_RESTRICT result, size_t n);
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_corner_move_n_scalar(const uint8_t* CUBELIB_RESTRICT corners
+                                                               , const uint8_t* CUBELIB_RESTRICT directions
+                                                               , uint8_t* CUBELIB_RESTRICT result, size_t n);
+
+    ///@brief `result[i] = cubelib_get_edge_by_corners(corners0[i], corners1[i])`; each pair must be adjacent.
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_get_edge_by_corners_n(const uint8_t* CUBELIB_RESTRICT corners0
+                                                                , const uint8_t* CUBELIB_RESTRICT corners1
+                                                                , uint8_t* CUBELIB_RESTRICT result, size_t n);
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_get_edge_by_corners_n_scalar(const uint8_t* CUBELIB_RESTRICT corners0
+                                                                       , const uint8_t* CUBELIB_RESTRICT corners1
+                                                                       , uint8_t* CUBELIB_RESTRICT result, size_t n);
+
+    ///@brief `result[i] = cubelib_get_opposite_edge(edges[i])`
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_get_opposite_edge_n(const uint8_t* CUBELIB_RESTRICT edges
+                                                              , uint8_t* CUBELIB_RESTRICT result, size_t n);
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_get_opposite_edge_n_scalar(const uint8_t* CUBELIB_RESTRICT edges
+                                                                     , uint8_t* CUBELIB_RESTRICT result, size_t n);
+
+    ///@brief `result[i] = cubelib_get_corner_by_float3(xs[i], ys[i], zs[i])`
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_get_corner_by_float3_n(const float* CUBELIB_RESTRICT xs
+                                                                 , const float* CUBELIB_RESTRICT ys
+                                                                 , const float* CUBELIB_RESTRICT zs
+                                                                 , uint8_t* CUBELIB_RESTRICT result, size_t n);
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_get_corner_by_float3_n_scalar(const float* CUBELIB_RESTRICT xs
+                                                                        , const float* CUBELIB_RESTRICT ys
+                                                                        , const float* CUBELIB_RESTRICT zs
+                                                                        , uint8_t* CUBELIB_RESTRICT result, size_t n);
+
+#ifdef CUBELIB_BATCH_HAS_X86_SIMD
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_get_opposite_corner_n_sse42(const uint8_t* CUBELIB_RESTRICT corners
+                                                                      , uint8_t* CUBELIB_RESTRICT result, size_t n);
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_get_opposite_corner_n_avx2(const uint8_t* CUBELIB_RESTRICT corners
+                                                                     , uint8_t* CUBELIB_RESTRICT result, size_t n);
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_get_adjacent_corner_n_sse42(const uint8_t* CUBELIB_RESTRICT corners
+                                                                      , const uint8_t* CUBELIB_RESTRICT directions
+                                                                      , uint8_t* CUBELIB_RESTRICT result, size_t n);
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_get_adjacent_corner_n_avx2(const uint8_t* CUBELIB_RESTRICT corners
+                                                                     , const uint8_t* CUBELIB_RESTRICT directions
+                                                                     , uint8_t* CUBELIB_RESTRICT result, size_t n);
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_corner_move_n_sse42(const uint8_t* CUBELIB_RESTRICT corners
+                                                              , const uint8_t* CUBELIB_RESTRICT directions
+                                                              , uint8_t* CUBELIB_RESTRICT result, size_t n);
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_corner_move_n_avx2(const uint8_t* CUBELIB_RESTRICT corners
+                                                             , const uint8_t* CUBELIB_RESTRICT directions
+                                                             , uint8_t* CUBELIB_RESTRICT result, size_t n);
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_get_edge_by_corners_n_sse42(const uint8_t* CUBELIB_RESTRICT corners0
+                                                                      , const uint8_t* CUBELIB_RESTRICT corners1
+                                                                      , uint8_t* CUBELIB_RESTRICT result, size_t n);
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_get_edge_by_corners_n_avx2(const uint8_t* CUBELIB_RESTRICT corners0
+                                                                     , const uint8_t* CUBELIB_RESTRICT corners1
+                                                                     , uint8_t* CUBELIB_RESTRICT result, size_t n);
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_get_opposite_edge_n_sse42(const uint8_t* CUBELIB_RESTRICT edges
+                                                                    , uint8_t* CUBELIB_RESTRICT result, size_t n);
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_get_opposite_edge_n_avx2(const uint8_t* CUBELIB_RESTRICT edges
+                                                                   , uint8_t* CUBELIB_RESTRICT result, size_t n);
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_get_corner_by_float3_n_sse42(const float* CUBELIB_RESTRICT xs
+                                                                       , const float* CUBELIB_RESTRICT ys
+                                                                       , const float* CUBELIB_RESTRICT zs
+                                                                       , uint8_t* CUBELIB_RESTRICT result, size_t n);
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_get_corner_by_float3_n_avx2(const float* CUBELIB_RESTRICT xs
+                                                                      , const float* CUBELIB_RESTRICT ys
+                                                                      , const float* CUBELIB_RESTRICT zs
+                                                                      , uint8_t* CUBELIB_RESTRICT result, size_t n);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+/** @} */ // end of group cubelib-batch-group
+
+
+#include "cubelib/detail/batch.inl.h"
+
+#endif // CORNER_CASES_CUBELIB_BATCH_H
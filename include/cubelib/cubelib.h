@@ -6,10 +6,13 @@
 
 #ifdef __OPENCL_VERSION__
 
-    #include "cubelib.clgen.h"
+    #ifndef CUBELIB_NO_TABLES
+        #include "cubelib.clgen.h"
+    #endif
 
-    #define GLOBAL_STATIC_CONST __constant const
-    #define LOCAL_STATIC_CONST const
+    #define CUBELIB_GLOBAL_STATIC_CONST __constant const
+    #define CUBELIB_LOCAL_STATIC_CONST const
+    #define CUBELIB_TABLE_STATIC_CONST __constant const
     #define CUBELIB_FUNCTION_QUALIFIER static inline
     
     typedef uint8_t uint_fast8_t;
@@ -19,15 +22,135 @@
     #include <assert.h>
     #include <stdint.h>
     #include <stdlib.h>
+    #ifndef __cplusplus
+        #include <stdbool.h>
+    #endif
+
+    #ifndef CUBELIB_NO_TABLES
+        ///generated by cubelib-clgen-consts; the build regenerates it, and checks the copy in the source tree is current
+        #include "cubelib/detail/cubelib.tables.h"
+    #endif
 
     #define CUBELIB_GLOBAL_STATIC_CONST static const
     #define CUBELIB_LOCAL_STATIC_CONST static const
+    #if defined(__cplusplus) && __cplusplus >= 201103L
+        #define CUBELIB_TABLE_STATIC_CONST static constexpr
+    #else
+        #define CUBELIB_TABLE_STATIC_CONST static const
+    #endif
     
     #ifndef CUBELIB_FUNCTION_QUALIFIER
       #define CUBELIB_FUNCTION_QUALIFIER static inline
     #endif
-    
+
+#endif
+
+/**
+ * @addtogroup cubelib-strategy-group Table/arithmetic strategy selection
+ *
+ * Every relation query (`cubelib_get_*`, `cubelib_corner_move()` etc.) can be answered either by
+ * indexing a precomputed table, or by computing the answer from the bit encoding of its arguments
+ * (the `cubelib_calc_*` functions). Which is faster depends on the target: on a CPU the tables are
+ * tiny and stay in L1; on OpenCL targets `__constant` memory is scarce and a few ALU ops are usually
+ * cheaper.
+ *
+ * Define @c CUBELIB_STRATEGY to @c CUBELIB_STRATEGY_TABLE or @c CUBELIB_STRATEGY_ARITH before including
+ * cubelib.h to pick the default for all relations, and/or define any of the per-relation macros
+ * (e.g. @c CUBELIB_STRATEGY_EDGE_BY_CORNERS) to override a single relation.
+ *
+ * The default is @c CUBELIB_STRATEGY_TABLE on the host, and @c CUBELIB_STRATEGY_ARITH under OpenCL (or with
+ * @c CUBELIB_NO_TABLES);
+ * except that relations that are a single bitwise operation on the encoding (opposites, edge axes)
+ * default to @c CUBELIB_STRATEGY_ARITH everywhere, unless @c CUBELIB_STRATEGY is defined explicitly.
+ *  @{
+ */
+#define CUBELIB_STRATEGY_ARITH 0
+#define CUBELIB_STRATEGY_TABLE 1
+
+#ifndef CUBELIB_STRATEGY
+    #if defined(__OPENCL_VERSION__) || defined(CUBELIB_NO_TABLES)
+        #define CUBELIB_STRATEGY CUBELIB_STRATEGY_ARITH
+    #else
+        #define CUBELIB_STRATEGY CUBELIB_STRATEGY_TABLE
+    #endif
+    #define CUBELIB_DETAIL_BITWISE_STRATEGY CUBELIB_STRATEGY_ARITH
+#else
+    #define CUBELIB_DETAIL_BITWISE_STRATEGY CUBELIB_STRATEGY
+#endif
+
+///@brief cubelib_get_opposite_corner()
+#ifndef CUBELIB_STRATEGY_OPPOSITE_CORNER
+    #define CUBELIB_STRATEGY_OPPOSITE_CORNER CUBELIB_DETAIL_BITWISE_STRATEGY
+#endif
+///@brief cubelib_get_adjacent_corner()
+#ifndef CUBELIB_STRATEGY_ADJACENT_CORNER
+    #define CUBELIB_STRATEGY_ADJACENT_CORNER CUBELIB_STRATEGY
+#endif
+///@brief cubelib_corner_move()
+#ifndef CUBELIB_STRATEGY_CORNER_MOVE
+    #define CUBELIB_STRATEGY_CORNER_MOVE CUBELIB_STRATEGY
+#endif
+///@brief cubelib_corner_push()
+#ifndef CUBELIB_STRATEGY_CORNER_PUSH
+    #define CUBELIB_STRATEGY_CORNER_PUSH CUBELIB_STRATEGY
 #endif
+///@brief cubelib_is_corner_adjacent_corner()
+#ifndef CUBELIB_STRATEGY_IS_CORNER_ADJACENT_CORNER
+    #define CUBELIB_STRATEGY_IS_CORNER_ADJACENT_CORNER CUBELIB_STRATEGY
+#endif
+///@brief cubelib_is_corner_on_face()
+#ifndef CUBELIB_STRATEGY_IS_CORNER_ON_FACE
+    #define CUBELIB_STRATEGY_IS_CORNER_ON_FACE CUBELIB_STRATEGY
+#endif
+///@brief cubelib_get_opposite_direction()
+#ifndef CUBELIB_STRATEGY_OPPOSITE_DIRECTION
+    #define CUBELIB_STRATEGY_OPPOSITE_DIRECTION CUBELIB_DETAIL_BITWISE_STRATEGY
+#endif
+///@brief cubelib_get_edge_by_corner_direction()
+#ifndef CUBELIB_STRATEGY_EDGE_BY_CORNER_DIRECTION
+    #define CUBELIB_STRATEGY_EDGE_BY_CORNER_DIRECTION CUBELIB_STRATEGY
+#endif
+///@brief cubelib_get_edge_by_corners()
+#ifndef CUBELIB_STRATEGY_EDGE_BY_CORNERS
+    #define CUBELIB_STRATEGY_EDGE_BY_CORNERS CUBELIB_STRATEGY
+#endif
+///@brief cubelib_get_opposite_edge()
+#ifndef CUBELIB_STRATEGY_OPPOSITE_EDGE
+    #define CUBELIB_STRATEGY_OPPOSITE_EDGE CUBELIB_DETAIL_BITWISE_STRATEGY
+#endif
+///@brief cubelib_get_edge_corner0(), cubelib_get_edge_corner1()
+#ifndef CUBELIB_STRATEGY_EDGE_CORNERS
+    #define CUBELIB_STRATEGY_EDGE_CORNERS CUBELIB_STRATEGY
+#endif
+///@brief cubelib_get_edge_direction()
+#ifndef CUBELIB_STRATEGY_EDGE_DIRECTION
+    #define CUBELIB_STRATEGY_EDGE_DIRECTION CUBELIB_STRATEGY
+#endif
+///@brief cubelib_get_edge_base_axis(), cubelib_get_edge_secondary_axis(), cubelib_get_edge_tertiary_axis()
+#ifndef CUBELIB_STRATEGY_EDGE_AXES
+    #define CUBELIB_STRATEGY_EDGE_AXES CUBELIB_DETAIL_BITWISE_STRATEGY
+#endif
+///@brief cubelib_edge_push()
+#ifndef CUBELIB_STRATEGY_EDGE_PUSH
+    #define CUBELIB_STRATEGY_EDGE_PUSH CUBELIB_STRATEGY
+#endif
+///@brief cubelib_get_face_on_edge()
+#ifndef CUBELIB_STRATEGY_FACE_ON_EDGE
+    #define CUBELIB_STRATEGY_FACE_ON_EDGE CUBELIB_STRATEGY
+#endif
+///@brief cubelib_is_face_on_edge(), cubelib_is_edge_on_face()
+#ifndef CUBELIB_STRATEGY_IS_FACE_ON_EDGE
+    #define CUBELIB_STRATEGY_IS_FACE_ON_EDGE CUBELIB_STRATEGY
+#endif
+///@brief cubelib_get_edge_on_face()
+#ifndef CUBELIB_STRATEGY_EDGE_ON_FACE
+    #define CUBELIB_STRATEGY_EDGE_ON_FACE CUBELIB_STRATEGY
+#endif
+///@brief cubelib_get_corner_on_face()
+#ifndef CUBELIB_STRATEGY_CORNER_ON_FACE
+    #define CUBELIB_STRATEGY_CORNER_ON_FACE CUBELIB_STRATEGY
+#endif
+/** @} */ // end of group cubelib-strategy-group
 
 #ifdef __cplusplus
 extern "C"{
@@ -201,6 +324,7 @@ extern "C"{
      * @brief Return the corner on the opposite side of the cube.
      */
     CUBELIB_FUNCTION_QUALIFIER cubelib_corner_t cubelib_get_opposite_corner(cubelib_corner_t corner);
+    CUBELIB_FUNCTION_QUALIFIER cubelib_corner_t cubelib_calc_opposite_corner(cubelib_corner_t corner);
     
     /**
      * @brief Retrieve an adjacent a corner in a specified dimension.
@@ -221,6 +345,7 @@ extern "C"{
      * @see cubelib_corner_push(), cubelib_get_adjacent_corner()
      */
     CUBELIB_FUNCTION_QUALIFIER cubelib_corner_t cubelib_corner_move(cubelib_corner_t corner, cubelib_direction_t direction);
+    CUBELIB_FUNCTION_QUALIFIER cubelib_corner_t cubelib_calc_corner_move(cubelib_corner_t corner, cubelib_direction_t direction);
     /**
      * @brief Push a corner in a specified direction.
      *
@@ -229,6 +354,7 @@ extern "C"{
      * @see cubelib_corner_move(), cubelib_get_adjacent_corner()
      */
     CUBELIB_FUNCTION_QUALIFIER cubelib_corner_t cubelib_corner_push(cubelib_corner_t corner, cubelib_direction_t direction);
+    CUBELIB_FUNCTION_QUALIFIER cubelib_corner_t cubelib_calc_corner_push(cubelib_corner_t corner, cubelib_direction_t direction);
     
     
     CUBELIB_FUNCTION_QUALIFIER bool cubelib_calc_is_corner_adjacent_corner(cubelib_corner_t corner0, cubelib_corner_t corner1);
@@ -347,6 +473,7 @@ extern "C"{
      * @brief Returns the opposite direction.
      */
     CUBELIB_FUNCTION_QUALIFIER cubelib_direction_t cubelib_get_opposite_direction(cubelib_direction_t direction);
+    CUBELIB_FUNCTION_QUALIFIER cubelib_direction_t cubelib_calc_opposite_direction(cubelib_direction_t direction);
     
     ///@brief convert a direction to a face
     ///@see cubelib_face_t, cubelib_get_face_direction()
@@ -399,6 +526,7 @@ extern "C"{
     ///@brief given two corners, this returns the edge between them. the given corners must be adjacent; the same edge will
     /// be returned regardless of the order of the given corners.
     CUBELIB_FUNCTION_QUALIFIER cubelib_edge_t cubelib_get_edge_by_corners(cubelib_corner_t corner0, cubelib_corner_t corner1);
+    CUBELIB_FUNCTION_QUALIFIER cubelib_edge_t cubelib_calc_edge_by_corners(cubelib_corner_t corner0, cubelib_corner_t corner1);
     ///@brief Return a edge based on the 0-based index returned by cubelib_get_edge_index().
     ///
     ///@see cubelib_get_edge_index()
@@ -409,16 +537,20 @@ extern "C"{
     CUBELIB_FUNCTION_QUALIFIER uint_fast8_t cubelib_get_edge_index(cubelib_edge_t edge);
     ///@brief Returns the edge on the opposite side of the cube.
     CUBELIB_FUNCTION_QUALIFIER cubelib_edge_t cubelib_get_opposite_edge(cubelib_edge_t edge);
+    CUBELIB_FUNCTION_QUALIFIER cubelib_edge_t cubelib_calc_opposite_edge(cubelib_edge_t edge);
     
     ///@brief Return the lower corner of the edge (where lower means closer to the lower corner of the cube).
     CUBELIB_FUNCTION_QUALIFIER cubelib_corner_t cubelib_get_edge_corner0(cubelib_edge_t edge);
     ///@brief Return the upper corner of the edge (where lower means closer to the lower corner of the cube
     /// and upper is the opposite corner of the lower corner).
     CUBELIB_FUNCTION_QUALIFIER cubelib_corner_t cubelib_get_edge_corner1(cubelib_edge_t edge);
+    CUBELIB_FUNCTION_QUALIFIER cubelib_corner_t cubelib_calc_edge_corner0(cubelib_edge_t edge);
+    CUBELIB_FUNCTION_QUALIFIER cubelib_corner_t cubelib_calc_edge_corner1(cubelib_edge_t edge);
     
     ///@brief Returns a direction that is parallel to the edge; it will always be a positively
     /// pointing direction.
     CUBELIB_FUNCTION_QUALIFIER cubelib_direction_t cubelib_get_edge_direction(cubelib_edge_t edge);
+    CUBELIB_FUNCTION_QUALIFIER cubelib_direction_t cubelib_calc_edge_direction(cubelib_edge_t edge);
     
     CUBELIB_FUNCTION_QUALIFIER uint_fast8_t cubelib_calc_edge_base_axis(cubelib_edge_t edge);
     CUBELIB_FUNCTION_QUALIFIER uint_fast8_t cubelib_calc_edge_secondary_axis(cubelib_edge_t edge);
@@ -465,6 +597,7 @@ extern "C"{
     ///@brief Returns true if the given face is on the given edge
     ///@see cubelib_is_edge_on_face()
     CUBELIB_FUNCTION_QUALIFIER bool cubelib_is_face_on_edge(cubelib_face_t face, cubelib_edge_t edge);
+    CUBELIB_FUNCTION_QUALIFIER bool cubelib_calc_is_face_on_edge(cubelib_face_t face, cubelib_edge_t edge);
     
     
     
@@ -515,6 +648,7 @@ extern "C"{
     
     ///@brief Returns true if the given corner is on the given face
     CUBELIB_FUNCTION_QUALIFIER bool cubelib_is_corner_on_face(cubelib_corner_t corner, cubelib_face_t face);
+    CUBELIB_FUNCTION_QUALIFIER bool cubelib_calc_is_corner_on_face(cubelib_corner_t corner, cubelib_face_t face);
     
     
 /* -------------------------------------------------------------------------- */
@@ -525,60 +659,12 @@ extern "C"{
      * Corner constants
      * ---------------------------------------------------------------------
      */
-#ifdef __OPENCL_VERSION__
-    CUBELIB_GLOBAL_STATIC_CONST cubelib_corner_t cubelib_cnr_adj_cnrs[8][3] = CUBELIB_CNR_ADJ_CNRS;
-#else
-/** @addtogroup cubelib-corner-group
- *  @{
- */
-    
-    ///@brief Index through this array with the corner's index, to obtain the 3 adjacent corners.
-    ///
-    ///Example:
-    ///
-    ///\code{.c}
-    ///for (int i = 0; i < 3; ++i)
-    ///    cubelib_corner_t adj_corner_i = cubelib_cnr_adj_cnrs[ cubelib_get_corner_index(corner) ][i];
-    ///\endcode
-    ///
-    ///@see cubelib_get_corner_index()
-    CUBELIB_GLOBAL_STATIC_CONST cubelib_corner_t cubelib_cnr_adj_cnrs[8][3] =
-        {
-              {   cubelib_calc_cnr_adj_cnr(cubelib_get_corner_by_index(0), 0)
-                , cubelib_calc_cnr_adj_cnr(cubelib_get_corner_by_index(0), 1)
-                , cubelib_calc_cnr_adj_cnr(cubelib_get_corner_by_index(0), 2)}
-            , {   cubelib_calc_cnr_adj_cnr(cubelib_get_corner_by_index(1), 0)
-                , cubelib_calc_cnr_adj_cnr(cubelib_get_corner_by_index(1), 1)
-                , cubelib_calc_cnr_adj_cnr(cubelib_get_corner_by_index(1), 2)}
-            , {   cubelib_calc_cnr_adj_cnr(cubelib_get_corner_by_index(2), 0)
-                , cubelib_calc_cnr_adj_cnr(cubelib_get_corner_by_index(2), 1)
-                , cubelib_calc_cnr_adj_cnr(cubelib_get_corner_by_index(2), 2)}
-            , {   cubelib_calc_cnr_adj_cnr(cubelib_get_corner_by_index(3), 0)
-                , cubelib_calc_cnr_adj_cnr(cubelib_get_corner_by_index(3), 1)
-                , cubelib_calc_cnr_adj_cnr(cubelib_get_corner_by_index(3), 2)}
-            , {   cubelib_calc_cnr_adj_cnr(cubelib_get_corner_by_index(4), 0)
-                , cubelib_calc_cnr_adj_cnr(cubelib_get_corner_by_index(4), 1)
-                , cubelib_calc_cnr_adj_cnr(cubelib_get_corner_by_index(4), 2)}
-            , {   cubelib_calc_cnr_adj_cnr(cubelib_get_corner_by_index(5), 0)
-                , cubelib_calc_cnr_adj_cnr(cubelib_get_corner_by_index(5), 1)
-                , cubelib_calc_cnr_adj_cnr(cubelib_get_corner_by_index(5), 2)}
-            , {   cubelib_calc_cnr_adj_cnr(cubelib_get_corner_by_index(6), 0)
-                , cubelib_calc_cnr_adj_cnr(cubelib_get_corner_by_index(6), 1)
-                , cubelib_calc_cnr_adj_cnr(cubelib_get_corner_by_index(6), 2)}
-            , {   cubelib_calc_cnr_adj_cnr(cubelib_get_corner_by_index(7), 0)
-                , cubelib_calc_cnr_adj_cnr(cubelib_get_corner_by_index(7), 1)
-                , cubelib_calc_cnr_adj_cnr(cubelib_get_corner_by_index(7), 2)}
-
-        };
-    
-#endif
     
     CUBELIB_GLOBAL_STATIC_CONST cubelib_corner_t cubelib_all_corners[8] = { {0}, {1}
                                             , {2}, {3}
                                             , {4}, {5}
                                             , {6}, {7}
                                             };
-/** @} */ // end of group cubelib-corner-group
 
     /*
      * ---------------------------------------------------------------------
@@ -593,57 +679,6 @@ extern "C"{
      * edge constants
      * ---------------------------------------------------------------------
      */
-
-#ifdef __OPENCL_VERSION__
-    CUBELIB_GLOBAL_STATIC_CONST cubelib_face_t cubelib_faces_on_edge[6][4] = CUBELIB_FACES_ON_EDGE;
-#else
-/** @addtogroup cubelib-edge-group
- *  @{
- */
- 
-    ///@brief Index through this array with the edges's index, to obtain the 2 adjacent faces.
-    ///
-    ///Example:
-    ///
-    ///\code{.c}
-    ///for (int i = 0; i < 2; ++i)
-    ///    cubelib_face_t face_on_edge = cubelib_faces_on_edge[ cubelib_get_edge_index(edge) ][i];
-    ///\endcode
-    ///
-    ///@see cubelib_get_edge_index()
-    CUBELIB_GLOBAL_STATIC_CONST cubelib_face_t cubelib_faces_on_edge[12][2] =
-        {
-              {   cubelib_calc_face_on_edge(cubelib_get_edge_by_index(0), 0)
-                , cubelib_calc_face_on_edge(cubelib_get_edge_by_index(0), 1)}
-            , {   cubelib_calc_face_on_edge(cubelib_get_edge_by_index(1), 0)
-                , cubelib_calc_face_on_edge(cubelib_get_edge_by_index(1), 1)}
-            , {   cubelib_calc_face_on_edge(cubelib_get_edge_by_index(2), 0)
-                , cubelib_calc_face_on_edge(cubelib_get_edge_by_index(2), 1)}
-            , {   cubelib_calc_face_on_edge(cubelib_get_edge_by_index(3), 0)
-                , cubelib_calc_face_on_edge(cubelib_get_edge_by_index(3), 1)}
-            , {   cubelib_calc_face_on_edge(cubelib_get_edge_by_index(4), 0)
-                , cubelib_calc_face_on_edge(cubelib_get_edge_by_index(4), 1)}
-            , {   cubelib_calc_face_on_edge(cubelib_get_edge_by_index(5), 0)
-                , cubelib_calc_face_on_edge(cubelib_get_edge_by_index(5), 1)}
-            , {   cubelib_calc_face_on_edge(cubelib_get_edge_by_index(6), 0)
-                , cubelib_calc_face_on_edge(cubelib_get_edge_by_index(6), 1)}
-            , {   cubelib_calc_face_on_edge(cubelib_get_edge_by_index(7), 0)
-                , cubelib_calc_face_on_edge(cubelib_get_edge_by_index(7), 1)}
-            , {   cubelib_calc_face_on_edge(cubelib_get_edge_by_index(8), 0)
-                , cubelib_calc_face_on_edge(cubelib_get_edge_by_index(8), 1)}
-            , {   cubelib_calc_face_on_edge(cubelib_get_edge_by_index(9), 0)
-                , cubelib_calc_face_on_edge(cubelib_get_edge_by_index(9), 1)}
-            , {   cubelib_calc_face_on_edge(cubelib_get_edge_by_index(10), 0)
-                , cubelib_calc_face_on_edge(cubelib_get_edge_by_index(10), 1)}
-            , {   cubelib_calc_face_on_edge(cubelib_get_edge_by_index(11), 0)
-                , cubelib_calc_face_on_edge(cubelib_get_edge_by_index(11), 1)}
-        };
-    
-    
-    
-    
-#endif
-
      
     CUBELIB_GLOBAL_STATIC_CONST cubelib_edge_t cubelib_all_edges[12] = {  {0}, {1}
                                                         , {2}, {3}
@@ -659,14 +694,64 @@ extern "C"{
      * ---------------------------------------------------------------------
      */
 
-#ifdef __OPENCL_VERSION__
-    CUBELIB_GLOBAL_STATIC_CONST cubelib_edge_t cubelib_edges_on_face[6][4] = CUBELIB_EDGES_ON_FACE;
-#else
-/** @addtogroup cubelib-face-group
+    CUBELIB_GLOBAL_STATIC_CONST cubelib_face_t posxface = {1};
+    CUBELIB_GLOBAL_STATIC_CONST cubelib_face_t posyface = {2};
+    CUBELIB_GLOBAL_STATIC_CONST cubelib_face_t poszface = {4};
+    CUBELIB_GLOBAL_STATIC_CONST cubelib_face_t negxface = {6};
+    CUBELIB_GLOBAL_STATIC_CONST cubelib_face_t negyface = {5};
+    CUBELIB_GLOBAL_STATIC_CONST cubelib_face_t negzface = {3};
+
+    CUBELIB_GLOBAL_STATIC_CONST cubelib_face_t cubelib_all_faces[6] = { {1}, {2}, {3}, {4}, {5}, {6} };
+
+    /*
+     * ---------------------------------------------------------------------
+     * Tables
+     * ---------------------------------------------------------------------
+     */
+#ifndef CUBELIB_NO_TABLES
+/** @addtogroup cubelib-strategy-group
  *  @{
  */
- 
-    ///@brief Index through this array with the face's index, to obtain the 4 adjacent corners.
+
+    ///Every table below is indexed with the 0-based indices of its arguments (cubelib_get_corner_index(),
+    /// cubelib_get_direction_index(), cubelib_get_edge_index(), cubelib_get_face_index()), in the same order
+    /// as the arguments of the relation it caches; entries for which the relation has no answer hold the
+    /// null element (or @c false).
+    ///
+    ///The initializers are literals from the generated cubelib.clgen.h (cubelib/detail/cubelib.tables.h on the
+    /// host), so the tables are true constants: they live in read-only data, cost nothing at startup, and are
+    /// `constexpr` in C++11. On the host they are always available; under OpenCL a table is only declared when
+    /// its relation is set to @c CUBELIB_STRATEGY_TABLE. Define @c CUBELIB_NO_TABLES to declare none of them (all
+    /// relations then default to @c CUBELIB_STRATEGY_ARITH).
+
+    ///@brief Index through this array with the corner's index, to obtain the 3 adjacent corners.
+    ///
+    ///Example:
+    ///
+    ///\code{.c}
+    ///for (int i = 0; i < 3; ++i)
+    ///    cubelib_corner_t adj_corner_i = cubelib_cnr_adj_cnrs[ cubelib_get_corner_index(corner) ][i];
+    ///\endcode
+    ///
+    ///@see cubelib_get_corner_index()
+    CUBELIB_TABLE_STATIC_CONST cubelib_corner_t cubelib_cnr_adj_cnrs[8][3] = CUBELIB_CNR_ADJ_CNRS;
+
+#if !defined(__OPENCL_VERSION__) || CUBELIB_STRATEGY_FACE_ON_EDGE == CUBELIB_STRATEGY_TABLE
+    ///@brief Index through this array with the edges's index, to obtain the 2 adjacent faces.
+    ///
+    ///Example:
+    ///
+    ///\code{.c}
+    ///for (int i = 0; i < 2; ++i)
+    ///    cubelib_face_t face_on_edge = cubelib_faces_on_edge[ cubelib_get_edge_index(edge) ][i];
+    ///\endcode
+    ///
+    ///@see cubelib_get_edge_index()
+    CUBELIB_TABLE_STATIC_CONST cubelib_face_t cubelib_faces_on_edge[12][2] = CUBELIB_FACES_ON_EDGE;
+#endif
+
+#if !defined(__OPENCL_VERSION__) || CUBELIB_STRATEGY_EDGE_ON_FACE == CUBELIB_STRATEGY_TABLE
+    ///@brief Index through this array with the face's index, to obtain the 4 edges on the face.
     ///
     ///Example:
     ///
@@ -676,94 +761,77 @@ extern "C"{
     ///\endcode
     ///
     ///@see cubelib_get_face_index()
-    CUBELIB_GLOBAL_STATIC_CONST cubelib_edge_t cubelib_edges_on_face[6][4] =
-        {
-              {   cubelib_calc_edge_on_face(cubelib_get_face_by_index(0), 0)
-                , cubelib_calc_edge_on_face(cubelib_get_face_by_index(0), 1)
-                , cubelib_calc_edge_on_face(cubelib_get_face_by_index(0), 2)
-                , cubelib_calc_edge_on_face(cubelib_get_face_by_index(0), 3)}
-            , {   cubelib_calc_edge_on_face(cubelib_get_face_by_index(1), 0)
-                , cubelib_calc_edge_on_face(cubelib_get_face_by_index(1), 1)
-                , cubelib_calc_edge_on_face(cubelib_get_face_by_index(1), 2)
-                , cubelib_calc_edge_on_face(cubelib_get_face_by_index(1), 3)}
-            , {   cubelib_calc_edge_on_face(cubelib_get_face_by_index(2), 0)
-                , cubelib_calc_edge_on_face(cubelib_get_face_by_index(2), 1)
-                , cubelib_calc_edge_on_face(cubelib_get_face_by_index(2), 2)
-                , cubelib_calc_edge_on_face(cubelib_get_face_by_index(2), 3)}
-            , {   cubelib_calc_edge_on_face(cubelib_get_face_by_index(3), 0)
-                , cubelib_calc_edge_on_face(cubelib_get_face_by_index(3), 1)
-                , cubelib_calc_edge_on_face(cubelib_get_face_by_index(3), 2)
-                , cubelib_calc_edge_on_face(cubelib_get_face_by_index(3), 3)}
-            , {   cubelib_calc_edge_on_face(cubelib_get_face_by_index(4), 0)
-                , cubelib_calc_edge_on_face(cubelib_get_face_by_index(4), 1)
-                , cubelib_calc_edge_on_face(cubelib_get_face_by_index(4), 2)
-                , cubelib_calc_edge_on_face(cubelib_get_face_by_index(4), 3)}
-            , {   cubelib_calc_edge_on_face(cubelib_get_face_by_index(5), 0)
-                , cubelib_calc_edge_on_face(cubelib_get_face_by_index(5), 1)
-                , cubelib_calc_edge_on_face(cubelib_get_face_by_index(5), 2)
-                , cubelib_calc_edge_on_face(cubelib_get_face_by_index(5), 3)}
-        };
-    
-    
-    
-    
+    CUBELIB_TABLE_STATIC_CONST cubelib_edge_t cubelib_edges_on_face[6][4] = CUBELIB_EDGES_ON_FACE;
 #endif
 
-#ifdef __OPENCL_VERSION__
-    CUBELIB_GLOBAL_STATIC_CONST cubelib_corner_t cubelib_corners_on_face[6][4] = CUBELIB_CORNERS_ON_FACE;
-#else
-
-    
-    CUBELIB_GLOBAL_STATIC_CONST cubelib_corner_t cubelib_corners_on_face[6][4] = {
-        {     cubelib_calc_corner_on_face(cubelib_get_face_by_index(0), 0)
-            , cubelib_calc_corner_on_face(cubelib_get_face_by_index(0), 1)
-            , cubelib_calc_corner_on_face(cubelib_get_face_by_index(0), 2)
-            , cubelib_calc_corner_on_face(cubelib_get_face_by_index(0), 3)}
-        , {   cubelib_calc_corner_on_face(cubelib_get_face_by_index(1), 0)
-            , cubelib_calc_corner_on_face(cubelib_get_face_by_index(1), 1)
-            , cubelib_calc_corner_on_face(cubelib_get_face_by_index(1), 2)
-            , cubelib_calc_corner_on_face(cubelib_get_face_by_index(1), 3)}
-        , {   cubelib_calc_corner_on_face(cubelib_get_face_by_index(2), 0)
-            , cubelib_calc_corner_on_face(cubelib_get_face_by_index(2), 1)
-            , cubelib_calc_corner_on_face(cubelib_get_face_by_index(2), 2)
-            , cubelib_calc_corner_on_face(cubelib_get_face_by_index(2), 3)}
-        , {   cubelib_calc_corner_on_face(cubelib_get_face_by_index(3), 0)
-            , cubelib_calc_corner_on_face(cubelib_get_face_by_index(3), 1)
-            , cubelib_calc_corner_on_face(cubelib_get_face_by_index(3), 2)
-            , cubelib_calc_corner_on_face(cubelib_get_face_by_index(3), 3)}
-        , {   cubelib_calc_corner_on_face(cubelib_get_face_by_index(4), 0)
-            , cubelib_calc_corner_on_face(cubelib_get_face_by_index(4), 1)
-            , cubelib_calc_corner_on_face(cubelib_get_face_by_index(4), 2)
-            , cubelib_calc_corner_on_face(cubelib_get_face_by_index(4), 3)}
-        , {   cubelib_calc_corner_on_face(cubelib_get_face_by_index(5), 0)
-            , cubelib_calc_corner_on_face(cubelib_get_face_by_index(5), 1)
-            , cubelib_calc_corner_on_face(cubelib_get_face_by_index(5), 2)
-            , cubelib_calc_corner_on_face(cubelib_get_face_by_index(5), 3)}
-    };
-    
+#if !defined(__OPENCL_VERSION__) || CUBELIB_STRATEGY_CORNER_ON_FACE == CUBELIB_STRATEGY_TABLE
+    ///@brief Index through this array with the face's index, to obtain the 4 corners on the face.
+    ///@see cubelib_get_face_index()
+    CUBELIB_TABLE_STATIC_CONST cubelib_corner_t cubelib_corners_on_face[6][4] = CUBELIB_CORNERS_ON_FACE;
 #endif
-    
-#ifdef __OPENCL_VERSION__
-    
-    CUBELIB_GLOBAL_STATIC_CONST cubelib_face_t posxface = POSXFACE;
-    CUBELIB_GLOBAL_STATIC_CONST cubelib_face_t posyface = POSYFACE;
-    CUBELIB_GLOBAL_STATIC_CONST cubelib_face_t poszface = POSZFACE;
-    CUBELIB_GLOBAL_STATIC_CONST cubelib_face_t negxface = NEGXFACE;
-    CUBELIB_GLOBAL_STATIC_CONST cubelib_face_t negyface = NEGYFACE;
-    CUBELIB_GLOBAL_STATIC_CONST cubelib_face_t negzface = NEGZFACE;
-    
-    CUBELIB_GLOBAL_STATIC_CONST cubelib_face_t all_faces[6] = cubelib_all_directions;
-#else
 
-    CUBELIB_GLOBAL_STATIC_CONST cubelib_face_t posxface = cubelib_get_direction_face(cubelib_get_direction_by_int3(+1, 0, 0));
-    CUBELIB_GLOBAL_STATIC_CONST cubelib_face_t posyface = cubelib_get_direction_face(cubelib_get_direction_by_int3( 0,+1, 0));
-    CUBELIB_GLOBAL_STATIC_CONST cubelib_face_t poszface = cubelib_get_direction_face(cubelib_get_direction_by_int3( 0, 0,+1));
-    CUBELIB_GLOBAL_STATIC_CONST cubelib_face_t negxface = cubelib_get_direction_face(cubelib_get_direction_by_int3(-1, 0, 0));
-    CUBELIB_GLOBAL_STATIC_CONST cubelib_face_t negyface = cubelib_get_direction_face(cubelib_get_direction_by_int3( 0,-1, 0));
-    CUBELIB_GLOBAL_STATIC_CONST cubelib_face_t negzface = cubelib_get_direction_face(cubelib_get_direction_by_int3( 0, 0,-1));
+#if !defined(__OPENCL_VERSION__) || CUBELIB_STRATEGY_OPPOSITE_CORNER == CUBELIB_STRATEGY_TABLE
+    ///@brief `cubelib_opposite_corners[corner]`
+    CUBELIB_TABLE_STATIC_CONST cubelib_corner_t cubelib_opposite_corners[8] = CUBELIB_OPPOSITE_CORNERS;
+#endif
+#if !defined(__OPENCL_VERSION__) || CUBELIB_STRATEGY_ADJACENT_CORNER == CUBELIB_STRATEGY_TABLE
+    ///@brief `cubelib_adjacent_corners[corner][direction]`
+    CUBELIB_TABLE_STATIC_CONST cubelib_corner_t cubelib_adjacent_corners[8][6] = CUBELIB_ADJACENT_CORNERS;
+#endif
+#if !defined(__OPENCL_VERSION__) || CUBELIB_STRATEGY_CORNER_MOVE == CUBELIB_STRATEGY_TABLE
+    ///@brief `cubelib_corner_moves[corner][direction]`
+    CUBELIB_TABLE_STATIC_CONST cubelib_corner_t cubelib_corner_moves[8][6] = CUBELIB_CORNER_MOVES;
+#endif
+#if !defined(__OPENCL_VERSION__) || CUBELIB_STRATEGY_CORNER_PUSH == CUBELIB_STRATEGY_TABLE
+    ///@brief `cubelib_corner_pushes[corner][direction]`
+    CUBELIB_TABLE_STATIC_CONST cubelib_corner_t cubelib_corner_pushes[8][6] = CUBELIB_CORNER_PUSHES;
+#endif
+#if !defined(__OPENCL_VERSION__) || CUBELIB_STRATEGY_IS_CORNER_ADJACENT_CORNER == CUBELIB_STRATEGY_TABLE
+    ///@brief `cubelib_corner_adjacency[corner0][corner1]`
+    CUBELIB_TABLE_STATIC_CONST bool cubelib_corner_adjacency[8][8] = CUBELIB_CORNER_ADJACENCY;
+#endif
+#if !defined(__OPENCL_VERSION__) || CUBELIB_STRATEGY_IS_CORNER_ON_FACE == CUBELIB_STRATEGY_TABLE
+    ///@brief `cubelib_corner_face_incidence[corner][face]`
+    CUBELIB_TABLE_STATIC_CONST bool cubelib_corner_face_incidence[8][6] = CUBELIB_CORNER_FACE_INCIDENCE;
+#endif
+#if !defined(__OPENCL_VERSION__) || CUBELIB_STRATEGY_OPPOSITE_DIRECTION == CUBELIB_STRATEGY_TABLE
+    ///@brief `cubelib_opposite_directions[direction]`
+    CUBELIB_TABLE_STATIC_CONST cubelib_direction_t cubelib_opposite_directions[6] = CUBELIB_OPPOSITE_DIRECTIONS;
+#endif
+#if !defined(__OPENCL_VERSION__) || CUBELIB_STRATEGY_EDGE_BY_CORNER_DIRECTION == CUBELIB_STRATEGY_TABLE
+    ///@brief `cubelib_edges_by_corner_direction[corner][direction]`
+    CUBELIB_TABLE_STATIC_CONST cubelib_edge_t cubelib_edges_by_corner_direction[8][6] = CUBELIB_EDGES_BY_CORNER_DIRECTION;
+#endif
+#if !defined(__OPENCL_VERSION__) || CUBELIB_STRATEGY_EDGE_BY_CORNERS == CUBELIB_STRATEGY_TABLE
+    ///@brief `cubelib_edges_by_corners[corner0][corner1]`
+    CUBELIB_TABLE_STATIC_CONST cubelib_edge_t cubelib_edges_by_corners[8][8] = CUBELIB_EDGES_BY_CORNERS;
+#endif
+#if !defined(__OPENCL_VERSION__) || CUBELIB_STRATEGY_OPPOSITE_EDGE == CUBELIB_STRATEGY_TABLE
+    ///@brief `cubelib_opposite_edges[edge]`
+    CUBELIB_TABLE_STATIC_CONST cubelib_edge_t cubelib_opposite_edges[12] = CUBELIB_OPPOSITE_EDGES;
+#endif
+#if !defined(__OPENCL_VERSION__) || CUBELIB_STRATEGY_EDGE_CORNERS == CUBELIB_STRATEGY_TABLE
+    ///@brief `cubelib_edge_corners[edge][0]` is cubelib_get_edge_corner0(), `cubelib_edge_corners[edge][1]` is cubelib_get_edge_corner1()
+    CUBELIB_TABLE_STATIC_CONST cubelib_corner_t cubelib_edge_corners[12][2] = CUBELIB_EDGE_CORNERS;
+#endif
+#if !defined(__OPENCL_VERSION__) || CUBELIB_STRATEGY_EDGE_DIRECTION == CUBELIB_STRATEGY_TABLE
+    ///@brief `cubelib_edge_directions[edge]`
+    CUBELIB_TABLE_STATIC_CONST cubelib_direction_t cubelib_edge_directions[12] = CUBELIB_EDGE_DIRECTIONS;
+#endif
+#if !defined(__OPENCL_VERSION__) || CUBELIB_STRATEGY_EDGE_AXES == CUBELIB_STRATEGY_TABLE
+    ///@brief `cubelib_edge_axes[edge]` holds the base, secondary and tertiary axes, in that order.
+    CUBELIB_TABLE_STATIC_CONST uint_fast8_t cubelib_edge_axes[12][3] = CUBELIB_EDGE_AXES;
+#endif
+#if !defined(__OPENCL_VERSION__) || CUBELIB_STRATEGY_EDGE_PUSH == CUBELIB_STRATEGY_TABLE
+    ///@brief `cubelib_edge_pushes[edge][direction]`
+    CUBELIB_TABLE_STATIC_CONST cubelib_edge_t cubelib_edge_pushes[12][6] = CUBELIB_EDGE_PUSHES;
+#endif
+#if !defined(__OPENCL_VERSION__) || CUBELIB_STRATEGY_IS_FACE_ON_EDGE == CUBELIB_STRATEGY_TABLE
+    ///@brief `cubelib_edge_face_incidence[edge][face]`
+    CUBELIB_TABLE_STATIC_CONST bool cubelib_edge_face_incidence[12][6] = CUBELIB_EDGE_FACE_INCIDENCE;
+#endif
+/** @} */ // end of group cubelib-strategy-group
 #endif
-
-    CUBELIB_GLOBAL_STATIC_CONST cubelib_face_t cubelib_all_faces[6] = { {1}, {2}, {3}, {4}, {5}, {6} };
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,505 @@
+#ifndef CORNER_CASES_CUBELIB_BATCH_INL_H
+#define CORNER_CASES_CUBELIB_BATCH_INL_H
+
+#ifdef CUBELIB_BATCH_HAS_X86_SIMD
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #include <intrin.h>
+        #include <immintrin.h>
+        #define CUBELIB_BATCH_TARGET(isa)
+    #else
+        #include <immintrin.h>
+        #define CUBELIB_BATCH_TARGET(isa) __attribute__((target(isa)))
+    #endif
+#endif
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+
+    /*
+     * ---------------------------------------------------------------------
+     * Dispatch
+     * ---------------------------------------------------------------------
+     */
+    CUBELIB_FUNCTION_QUALIFIER cubelib_batch_isa_t cubelib_batch_detect_isa(void)
+    {
+#if !defined(CUBELIB_BATCH_HAS_X86_SIMD)
+        return CUBELIB_BATCH_ISA_SCALAR;
+#elif defined(_MSC_VER) && !defined(__clang__)
+        int info[4];
+        __cpuid(info, 0);
+        int max_leaf = info[0];
+        if (max_leaf < 1)
+            return CUBELIB_BATCH_ISA_SCALAR;
+        __cpuid(info, 1);
+        bool sse42 = (info[2] >> 20) & 1;
+        bool osxsave = (info[2] >> 27) & 1;
+        bool avx = (info[2] >> 28) & 1;
+        ///the OS must also save the ymm registers on context switches
+        bool ymm_enabled = osxsave && avx && ((_xgetbv(0) & 0x6) == 0x6);
+        bool avx2 = false;
+        if (max_leaf >= 7)
+        {
+            __cpuidex(info, 7, 0);
+            avx2 = (info[1] >> 5) & 1;
+        }
+        if (avx2 && ymm_enabled)
+            return CUBELIB_BATCH_ISA_AVX2;
+        if (sse42)
+            return CUBELIB_BATCH_ISA_SSE42;
+        return CUBELIB_BATCH_ISA_SCALAR;
+#else
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+            return CUBELIB_BATCH_ISA_AVX2;
+        if (__builtin_cpu_supports("sse4.2"))
+            return CUBELIB_BATCH_ISA_SSE42;
+        return CUBELIB_BATCH_ISA_SCALAR;
+#endif
+    }
+
+    CUBELIB_FUNCTION_QUALIFIER cubelib_batch_isa_t cubelib_batch_isa(void)
+    {
+        ///-1 means not yet detected; a race here is benign, every thread stores the same value.
+        static volatile int isa = -1;
+        if (isa < 0)
+            isa = (int)cubelib_batch_detect_isa();
+        return (cubelib_batch_isa_t)isa;
+    }
+
+
+    /*
+     * ---------------------------------------------------------------------
+     * Scalar (auto-vectorizable) paths
+     * ---------------------------------------------------------------------
+     *
+     * These work directly on the bit encodings, without branches or table lookups, so that each loop
+     * body compiles to a handful of byte-wide vector ops:
+     *  * a corner is 0bZYX, so the opposite corner flips all three bits.
+     *  * a positive direction is the axis' corner bit (0b001, 0b010, 0b100), and a negative direction is
+     *      its complement; a direction is positive iff it is a power of two.
+     *  * an edge is 0bBBTS, so the opposite edge flips S and T.
+     */
+
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_get_opposite_corner_n_scalar(const uint8_t* CUBELIB_RESTRICT corners
+                                                                       , uint8_t* CUBELIB_RESTRICT result, size_t n)
+    {
+        for (size_t i = 0; i < n; ++i)
+            result[i] = (uint8_t)(corners[i] ^ 0x7);
+    }
+
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_get_adjacent_corner_n_scalar(const uint8_t* CUBELIB_RESTRICT corners
+                                                                       , const uint8_t* CUBELIB_RESTRICT directions
+                                                                       , uint8_t* CUBELIB_RESTRICT result, size_t n)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            uint8_t direction = directions[i];
+            uint8_t positive = (direction & (direction - 1)) == 0;
+            uint8_t axis_bit = positive ? direction : (uint8_t)(direction ^ 0x7);
+
+            result[i] = (uint8_t)(corners[i] ^ axis_bit);
+        }
+    }
+
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_corner_move_n_scalar(const uint8_t* CUBELIB_RESTRICT corners
+                                                               , const uint8_t* CUBELIB_RESTRICT directions
+                                                               , uint8_t* CUBELIB_RESTRICT result, size_t n)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            uint8_t corner = corners[i];
+            uint8_t direction = directions[i];
+            uint8_t positive = (direction & (direction - 1)) == 0;
+            uint8_t axis_bit = positive ? direction : (uint8_t)(direction ^ 0x7);
+
+            ///a corner can move in a positive direction iff it is on the lower side of that axis, and vice-versa
+            uint8_t lower = (corner & axis_bit) == 0;
+
+            result[i] = lower == positive ? (uint8_t)(corner ^ axis_bit) : (uint8_t)8 /*null corner*/;
+        }
+    }
+
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_get_edge_by_corners_n_scalar(const uint8_t* CUBELIB_RESTRICT corners0
+                                                                       , const uint8_t* CUBELIB_RESTRICT corners1
+                                                                       , uint8_t* CUBELIB_RESTRICT result, size_t n)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            ///the corner bit that differs is the base axis; the lower corner holds the projection bits
+            uint8_t axis_bit = corners0[i] ^ corners1[i];
+            uint8_t lower = corners0[i] & corners1[i];
+            uint8_t base_axis = axis_bit >> 1;
+
+            ///rotate the 3 corner bits right by base_axis + 1, so the secondary axis bit lands in bit 0
+            /// and the tertiary axis bit in bit 1
+            uint8_t projections = (uint8_t)(((lower | (lower << 3)) >> (base_axis + 1)) & 0x3);
+
+            result[i] = (uint8_t)((base_axis << 2) | projections);
+        }
+    }
+
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_get_opposite_edge_n_scalar(const uint8_t* CUBELIB_RESTRICT edges
+                                                                     , uint8_t* CUBELIB_RESTRICT result, size_t n)
+    {
+        for (size_t i = 0; i < n; ++i)
+            result[i] = (uint8_t)(edges[i] ^ 0x3);
+    }
+
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_get_corner_by_float3_n_scalar(const float* CUBELIB_RESTRICT xs
+                                                                        , const float* CUBELIB_RESTRICT ys
+                                                                        , const float* CUBELIB_RESTRICT zs
+                                                                        , uint8_t* CUBELIB_RESTRICT result, size_t n)
+    {
+        for (size_t i = 0; i < n; ++i)
+            result[i] = (uint8_t)((xs[i] > 0 ? 1 : 0) | (ys[i] > 0 ? 2 : 0) | (zs[i] > 0 ? 4 : 0));
+    }
+
+
+#ifdef CUBELIB_BATCH_HAS_X86_SIMD
+    /*
+     * ---------------------------------------------------------------------
+     * SSE4.2 paths; 16 elements at a time, the rest goes through the scalar path
+     * ---------------------------------------------------------------------
+     */
+
+    ///`axis bit` and `is positive` of each direction value, for use with pshufb
+    #define CUBELIB_BATCH_DIRECTION_AXIS_BITS 0, 1, 2, 4, 4, 2, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0
+    #define CUBELIB_BATCH_DIRECTION_POSITIVE 0, -1, -1, 0, -1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+    ///the edge for a lower corner (the low 3 bits of the index) and a base axis of x (bit 3 clear) or y (bit 3 set)
+    #define CUBELIB_BATCH_XY_EDGES_BY_LOWER_CORNER 0, 0, 1, 1, 2, 2, 3, 3, 4, 6, 4, 6, 5, 7, 5, 7
+
+    CUBELIB_FUNCTION_QUALIFIER CUBELIB_BATCH_TARGET("sse4.2")
+    void cubelib_get_opposite_corner_n_sse42(const uint8_t* CUBELIB_RESTRICT corners
+                                           , uint8_t* CUBELIB_RESTRICT result, size_t n)
+    {
+        const __m128i seven = _mm_set1_epi8(0x7);
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16)
+        {
+            __m128i corner = _mm_loadu_si128((const __m128i*)(corners + i));
+            _mm_storeu_si128((__m128i*)(result + i), _mm_xor_si128(corner, seven));
+        }
+        cubelib_get_opposite_corner_n_scalar(corners + i, result + i, n - i);
+    }
+
+    CUBELIB_FUNCTION_QUALIFIER CUBELIB_BATCH_TARGET("sse4.2")
+    void cubelib_get_adjacent_corner_n_sse42(const uint8_t* CUBELIB_RESTRICT corners
+                                           , const uint8_t* CUBELIB_RESTRICT directions
+                                           , uint8_t* CUBELIB_RESTRICT result, size_t n)
+    {
+        const __m128i axis_bits = _mm_setr_epi8(CUBELIB_BATCH_DIRECTION_AXIS_BITS);
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16)
+        {
+            __m128i corner = _mm_loadu_si128((const __m128i*)(corners + i));
+            __m128i direction = _mm_loadu_si128((const __m128i*)(directions + i));
+            __m128i axis_bit = _mm_shuffle_epi8(axis_bits, direction);
+            _mm_storeu_si128((__m128i*)(result + i), _mm_xor_si128(corner, axis_bit));
+        }
+        cubelib_get_adjacent_corner_n_scalar(corners + i, directions + i, result + i, n - i);
+    }
+
+    CUBELIB_FUNCTION_QUALIFIER CUBELIB_BATCH_TARGET("sse4.2")
+    void cubelib_corner_move_n_sse42(const uint8_t* CUBELIB_RESTRICT corners
+                                   , const uint8_t* CUBELIB_RESTRICT directions
+                                   , uint8_t* CUBELIB_RESTRICT result, size_t n)
+    {
+        const __m128i axis_bits = _mm_setr_epi8(CUBELIB_BATCH_DIRECTION_AXIS_BITS);
+        const __m128i positives = _mm_setr_epi8(CUBELIB_BATCH_DIRECTION_POSITIVE);
+        const __m128i null_corner = _mm_set1_epi8(8);
+        const __m128i zero = _mm_setzero_si128();
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16)
+        {
+            __m128i corner = _mm_loadu_si128((const __m128i*)(corners + i));
+            __m128i direction = _mm_loadu_si128((const __m128i*)(directions + i));
+            __m128i axis_bit = _mm_shuffle_epi8(axis_bits, direction);
+            __m128i positive = _mm_shuffle_epi8(positives, direction);
+            __m128i lower = _mm_cmpeq_epi8(_mm_and_si128(corner, axis_bit), zero);
+            __m128i movable = _mm_cmpeq_epi8(lower, positive);
+            __m128i moved = _mm_blendv_epi8(null_corner, _mm_xor_si128(corner, axis_bit), movable);
+            _mm_storeu_si128((__m128i*)(result + i), moved);
+        }
+        cubelib_corner_move_n_scalar(corners + i, directions + i, result + i, n - i);
+    }
+
+    CUBELIB_FUNCTION_QUALIFIER CUBELIB_BATCH_TARGET("sse4.2")
+    void cubelib_get_edge_by_corners_n_sse42(const uint8_t* CUBELIB_RESTRICT corners0
+                                           , const uint8_t* CUBELIB_RESTRICT corners1
+                                           , uint8_t* CUBELIB_RESTRICT result, size_t n)
+    {
+        const __m128i xy_edges = _mm_setr_epi8(CUBELIB_BATCH_XY_EDGES_BY_LOWER_CORNER);
+        const __m128i two = _mm_set1_epi8(2);
+        const __m128i three = _mm_set1_epi8(3);
+        const __m128i four = _mm_set1_epi8(4);
+        const __m128i z_base = _mm_set1_epi8(2 << 2);
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16)
+        {
+            __m128i corner0 = _mm_loadu_si128((const __m128i*)(corners0 + i));
+            __m128i corner1 = _mm_loadu_si128((const __m128i*)(corners1 + i));
+            __m128i axis_bit = _mm_xor_si128(corner0, corner1);
+            __m128i lower = _mm_and_si128(corner0, corner1);
+
+            ///x and y base axes come out of the table; for z, the projection bits are the corner's x and y bits
+            __m128i index = _mm_or_si128(lower, _mm_slli_epi16(_mm_and_si128(axis_bit, two), 2));
+            __m128i xy_edge = _mm_shuffle_epi8(xy_edges, index);
+            __m128i z_edge = _mm_or_si128(_mm_and_si128(lower, three), z_base);
+            __m128i edge = _mm_blendv_epi8(xy_edge, z_edge, _mm_cmpeq_epi8(axis_bit, four));
+            _mm_storeu_si128((__m128i*)(result + i), edge);
+        }
+        cubelib_get_edge_by_corners_n_scalar(corners0 + i, corners1 + i, result + i, n - i);
+    }
+
+    CUBELIB_FUNCTION_QUALIFIER CUBELIB_BATCH_TARGET("sse4.2")
+    void cubelib_get_opposite_edge_n_sse42(const uint8_t* CUBELIB_RESTRICT edges
+                                         , uint8_t* CUBELIB_RESTRICT result, size_t n)
+    {
+        const __m128i three = _mm_set1_epi8(0x3);
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16)
+        {
+            __m128i edge = _mm_loadu_si128((const __m128i*)(edges + i));
+            _mm_storeu_si128((__m128i*)(result + i), _mm_xor_si128(edge, three));
+        }
+        cubelib_get_opposite_edge_n_scalar(edges + i, result + i, n - i);
+    }
+
+    CUBELIB_FUNCTION_QUALIFIER CUBELIB_BATCH_TARGET("sse4.2")
+    __m128i cubelib_batch_corner_bits_sse42(const float* xs, const float* ys, const float* zs)
+    {
+        const __m128 zero = _mm_setzero_ps();
+        __m128i x = _mm_and_si128(_mm_castps_si128(_mm_cmpgt_ps(_mm_loadu_ps(xs), zero)), _mm_set1_epi32(1));
+        __m128i y = _mm_and_si128(_mm_castps_si128(_mm_cmpgt_ps(_mm_loadu_ps(ys), zero)), _mm_set1_epi32(2));
+        __m128i z = _mm_and_si128(_mm_castps_si128(_mm_cmpgt_ps(_mm_loadu_ps(zs), zero)), _mm_set1_epi32(4));
+        return _mm_or_si128(_mm_or_si128(x, y), z);
+    }
+
+    CUBELIB_FUNCTION_QUALIFIER CUBELIB_BATCH_TARGET("sse4.2")
+    void cubelib_get_corner_by_float3_n_sse42(const float* CUBELIB_RESTRICT xs
+                                            , const float* CUBELIB_RESTRICT ys
+                                            , const float* CUBELIB_RESTRICT zs
+                                            , uint8_t* CUBELIB_RESTRICT result, size_t n)
+    {
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16)
+        {
+            __m128i c0 = cubelib_batch_corner_bits_sse42(xs + i + 0, ys + i + 0, zs + i + 0);
+            __m128i c1 = cubelib_batch_corner_bits_sse42(xs + i + 4, ys + i + 4, zs + i + 4);
+            __m128i c2 = cubelib_batch_corner_bits_sse42(xs + i + 8, ys + i + 8, zs + i + 8);
+            __m128i c3 = cubelib_batch_corner_bits_sse42(xs + i + 12, ys + i + 12, zs + i + 12);
+            __m128i packed = _mm_packus_epi16(_mm_packs_epi32(c0, c1), _mm_packs_epi32(c2, c3));
+            _mm_storeu_si128((__m128i*)(result + i), packed);
+        }
+        cubelib_get_corner_by_float3_n_scalar(xs + i, ys + i, zs + i, result + i, n - i);
+    }
+
+
+    /*
+     * ---------------------------------------------------------------------
+     * AVX2 paths; 32 elements at a time, the rest goes through the SSE4.2 path
+     * ---------------------------------------------------------------------
+     */
+
+    CUBELIB_FUNCTION_QUALIFIER CUBELIB_BATCH_TARGET("avx2")
+    void cubelib_get_opposite_corner_n_avx2(const uint8_t* CUBELIB_RESTRICT corners
+                                          , uint8_t* CUBELIB_RESTRICT result, size_t n)
+    {
+        const __m256i seven = _mm256_set1_epi8(0x7);
+        size_t i = 0;
+        for (; i + 32 <= n; i += 32)
+        {
+            __m256i corner = _mm256_loadu_si256((const __m256i*)(corners + i));
+            _mm256_storeu_si256((__m256i*)(result + i), _mm256_xor_si256(corner, seven));
+        }
+        cubelib_get_opposite_corner_n_sse42(corners + i, result + i, n - i);
+    }
+
+    CUBELIB_FUNCTION_QUALIFIER CUBELIB_BATCH_TARGET("avx2")
+    void cubelib_get_adjacent_corner_n_avx2(const uint8_t* CUBELIB_RESTRICT corners
+                                          , const uint8_t* CUBELIB_RESTRICT directions
+                                          , uint8_t* CUBELIB_RESTRICT result, size_t n)
+    {
+        ///vpshufb looks up within each 128 bit lane, so both lanes get a copy of the table
+        const __m256i axis_bits = _mm256_setr_epi8(CUBELIB_BATCH_DIRECTION_AXIS_BITS, CUBELIB_BATCH_DIRECTION_AXIS_BITS);
+        size_t i = 0;
+        for (; i + 32 <= n; i += 32)
+        {
+            __m256i corner = _mm256_loadu_si256((const __m256i*)(corners + i));
+            __m256i direction = _mm256_loadu_si256((const __m256i*)(directions + i));
+            __m256i axis_bit = _mm256_shuffle_epi8(axis_bits, direction);
+            _mm256_storeu_si256((__m256i*)(result + i), _mm256_xor_si256(corner, axis_bit));
+        }
+        cubelib_get_adjacent_corner_n_sse42(corners + i, directions + i, result + i, n - i);
+    }
+
+    CUBELIB_FUNCTION_QUALIFIER CUBELIB_BATCH_TARGET("avx2")
+    void cubelib_corner_move_n_avx2(const uint8_t* CUBELIB_RESTRICT corners
+                                  , const uint8_t* CUBELIB_RESTRICT directions
+                                  , uint8_t* CUBELIB_RESTRICT result, size_t n)
+    {
+        const __m256i axis_bits = _mm256_setr_epi8(CUBELIB_BATCH_DIRECTION_AXIS_BITS, CUBELIB_BATCH_DIRECTION_AXIS_BITS);
+        const __m256i positives = _mm256_setr_epi8(CUBELIB_BATCH_DIRECTION_POSITIVE, CUBELIB_BATCH_DIRECTION_POSITIVE);
+        const __m256i null_corner = _mm256_set1_epi8(8);
+        const __m256i zero = _mm256_setzero_si256();
+        size_t i = 0;
+        for (; i + 32 <= n; i += 32)
+        {
+            __m256i corner = _mm256_loadu_si256((const __m256i*)(corners + i));
+            __m256i direction = _mm256_loadu_si256((const __m256i*)(directions + i));
+            __m256i axis_bit = _mm256_shuffle_epi8(axis_bits, direction);
+            __m256i positive = _mm256_shuffle_epi8(positives, direction);
+            __m256i lower = _mm256_cmpeq_epi8(_mm256_and_si256(corner, axis_bit), zero);
+            __m256i movable = _mm256_cmpeq_epi8(lower, positive);
+            __m256i moved = _mm256_blendv_epi8(null_corner, _mm256_xor_si256(corner, axis_bit), movable);
+            _mm256_storeu_si256((__m256i*)(result + i), moved);
+        }
+        cubelib_corner_move_n_sse42(corners + i, directions + i, result + i, n - i);
+    }
+
+    CUBELIB_FUNCTION_QUALIFIER CUBELIB_BATCH_TARGET("avx2")
+    void cubelib_get_edge_by_corners_n_avx2(const uint8_t* CUBELIB_RESTRICT corners0
+                                          , const uint8_t* CUBELIB_RESTRICT corners1
+                                          , uint8_t* CUBELIB_RESTRICT result, size_t n)
+    {
+        const __m256i xy_edges = _mm256_setr_epi8(CUBELIB_BATCH_XY_EDGES_BY_LOWER_CORNER, CUBELIB_BATCH_XY_EDGES_BY_LOWER_CORNER);
+        const __m256i two = _mm256_set1_epi8(2);
+        const __m256i three = _mm256_set1_epi8(3);
+        const __m256i four = _mm256_set1_epi8(4);
+        const __m256i z_base = _mm256_set1_epi8(2 << 2);
+        size_t i = 0;
+        for (; i + 32 <= n; i += 32)
+        {
+            __m256i corner0 = _mm256_loadu_si256((const __m256i*)(corners0 + i));
+            __m256i corner1 = _mm256_loadu_si256((const __m256i*)(corners1 + i));
+            __m256i axis_bit = _mm256_xor_si256(corner0, corner1);
+            __m256i lower = _mm256_and_si256(corner0, corner1);
+
+            __m256i index = _mm256_or_si256(lower, _mm256_slli_epi16(_mm256_and_si256(axis_bit, two), 2));
+            __m256i xy_edge = _mm256_shuffle_epi8(xy_edges, index);
+            __m256i z_edge = _mm256_or_si256(_mm256_and_si256(lower, three), z_base);
+            __m256i edge = _mm256_blendv_epi8(xy_edge, z_edge, _mm256_cmpeq_epi8(axis_bit, four));
+            _mm256_storeu_si256((__m256i*)(result + i), edge);
+        }
+        cubelib_get_edge_by_corners_n_sse42(corners0 + i, corners1 + i, result + i, n - i);
+    }
+
+    CUBELIB_FUNCTION_QUALIFIER CUBELIB_BATCH_TARGET("avx2")
+    void cubelib_get_opposite_edge_n_avx2(const uint8_t* CUBELIB_RESTRICT edges
+                                        , uint8_t* CUBELIB_RESTRICT result, size_t n)
+    {
+        const __m256i three = _mm256_set1_epi8(0x3);
+        size_t i = 0;
+        for (; i + 32 <= n; i += 32)
+        {
+            __m256i edge = _mm256_loadu_si256((const __m256i*)(edges + i));
+            _mm256_storeu_si256((__m256i*)(result + i), _mm256_xor_si256(edge, three));
+        }
+        cubelib_get_opposite_edge_n_sse42(edges + i, result + i, n - i);
+    }
+
+    CUBELIB_FUNCTION_QUALIFIER CUBELIB_BATCH_TARGET("avx2")
+    __m256i cubelib_batch_corner_bits_avx2(const float* xs, const float* ys, const float* zs)
+    {
+        const __m256 zero = _mm256_setzero_ps();
+        __m256i x = _mm256_and_si256(_mm256_castps_si256(_mm256_cmp_ps(_mm256_loadu_ps(xs), zero, _CMP_GT_OQ)), _mm256_set1_epi32(1));
+        __m256i y = _mm256_and_si256(_mm256_castps_si256(_mm256_cmp_ps(_mm256_loadu_ps(ys), zero, _CMP_GT_OQ)), _mm256_set1_epi32(2));
+        __m256i z = _mm256_and_si256(_mm256_castps_si256(_mm256_cmp_ps(_mm256_loadu_ps(zs), zero, _CMP_GT_OQ)), _mm256_set1_epi32(4));
+        return _mm256_or_si256(_mm256_or_si256(x, y), z);
+    }
+
+    CUBELIB_FUNCTION_QUALIFIER CUBELIB_BATCH_TARGET("avx2")
+    void cubelib_get_corner_by_float3_n_avx2(const float* CUBELIB_RESTRICT xs
+                                           , const float* CUBELIB_RESTRICT ys
+                                           , const float* CUBELIB_RESTRICT zs
+                                           , uint8_t* CUBELIB_RESTRICT result, size_t n)
+    {
+        ///the packs work within 128 bit lanes, leaving the 4-byte groups in the order 0,2,4,6,1,3,5,7
+        const __m256i unshuffle = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+        size_t i = 0;
+        for (; i + 32 <= n; i += 32)
+        {
+            __m256i c0 = cubelib_batch_corner_bits_avx2(xs + i + 0, ys + i + 0, zs + i + 0);
+            __m256i c1 = cubelib_batch_corner_bits_avx2(xs + i + 8, ys + i + 8, zs + i + 8);
+            __m256i c2 = cubelib_batch_corner_bits_avx2(xs + i + 16, ys + i + 16, zs + i + 16);
+            __m256i c3 = cubelib_batch_corner_bits_avx2(xs + i + 24, ys + i + 24, zs + i + 24);
+            __m256i packed = _mm256_packus_epi16(_mm256_packs_epi32(c0, c1), _mm256_packs_epi32(c2, c3));
+            _mm256_storeu_si256((__m256i*)(result + i), _mm256_permutevar8x32_epi32(packed, unshuffle));
+        }
+        cubelib_get_corner_by_float3_n_sse42(xs + i, ys + i, zs + i, result + i, n - i);
+    }
+
+    #undef CUBELIB_BATCH_XY_EDGES_BY_LOWER_CORNER
+    #undef CUBELIB_BATCH_DIRECTION_POSITIVE
+    #undef CUBELIB_BATCH_DIRECTION_AXIS_BITS
+#endif
+
+
+    /*
+     * ---------------------------------------------------------------------
+     * Runtime-dispatched entry points
+     * ---------------------------------------------------------------------
+     */
+
+#ifdef CUBELIB_BATCH_HAS_X86_SIMD
+    #define CUBELIB_BATCH_DISPATCH(name, args)                  \
+        switch (cubelib_batch_isa())                            \
+        {                                                       \
+            case CUBELIB_BATCH_ISA_AVX2: name##_avx2 args; return; \
+            case CUBELIB_BATCH_ISA_SSE42: name##_sse42 args; return; \
+            default: name##_scalar args; return;                \
+        }
+#else
+    #define CUBELIB_BATCH_DISPATCH(name, args) name##_scalar args;
+#endif
+
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_get_opposite_corner_n(const uint8_t* CUBELIB_RESTRICT corners
+                                                                , uint8_t* CUBELIB_RESTRICT result, size_t n)
+    {
+        CUBELIB_BATCH_DISPATCH(cubelib_get_opposite_corner_n, (corners, result, n))
+    }
+
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_get_adjacent_corner_n(const uint8_t* CUBELIB_RESTRICT corners
+                                                                , const uint8_t* CUBELIB_RESTRICT directions
+                                                                , uint8_t* CUBELIB_RESTRICT result, size_t n)
+    {
+        CUBELIB_BATCH_DISPATCH(cubelib_get_adjacent_corner_n, (corners, directions, result, n))
+    }
+
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_corner_move_n(const uint8_t* CUBELIB_RESTRICT corners
+                                                        , const uint8_t* CUBELIB_RESTRICT directions
+                                                        , uint8_t* CUBELIB_RESTRICT result, size_t n)
+    {
+        CUBELIB_BATCH_DISPATCH(cubelib_corner_move_n, (corners, directions, result, n))
+    }
+
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_get_edge_by_corners_n(const uint8_t* CUBELIB_RESTRICT corners0
+                                                                , const uint8_t* CUBELIB_RESTRICT corners1
+                                                                , uint8_t* CUBELIB_RESTRICT result, size_t n)
+    {
+        CUBELIB_BATCH_DISPATCH(cubelib_get_edge_by_corners_n, (corners0, corners1, result, n))
+    }
+
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_get_opposite_edge_n(const uint8_t* CUBELIB_RESTRICT edges
+                                                              , uint8_t* CUBELIB_RESTRICT result, size_t n)
+    {
+        CUBELIB_BATCH_DISPATCH(cubelib_get_opposite_edge_n, (edges, result, n))
+    }
+
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_get_corner_by_float3_n(const float* CUBELIB_RESTRICT xs
+                                                                 , const float* CUBELIB_RESTRICT ys
+                                                                 , const float* CUBELIB_RESTRICT zs
+                                                                 , uint8_t* CUBELIB_RESTRICT result, size_t n)
+    {
+        CUBELIB_BATCH_DISPATCH(cubelib_get_corner_by_float3_n, (xs, ys, zs, result, n))
+    }
+
+    #undef CUBELIB_BATCH_DISPATCH
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -134,10 +134,7 @@ extern "C"{
     }
 
 
-    /**
-
-     */
-    CUBELIB_FUNCTION_QUALIFIER cubelib_corner_t cubelib_get_opposite_corner(cubelib_corner_t corner)
+    CUBELIB_FUNCTION_QUALIFIER cubelib_corner_t cubelib_calc_opposite_corner(cubelib_corner_t corner)
     {
         assert(cubelib_is_corner_valid(corner));
         assert(!cubelib_is_corner_null(corner));
@@ -147,7 +144,19 @@ extern "C"{
         return result;
     }
 
-    CUBELIB_FUNCTION_QUALIFIER cubelib_corner_t cubelib_corner_move(cubelib_corner_t corner, cubelib_direction_t direction)
+    CUBELIB_FUNCTION_QUALIFIER cubelib_corner_t cubelib_get_opposite_corner(cubelib_corner_t corner)
+    {
+        assert(cubelib_is_corner_valid(corner));
+        assert(!cubelib_is_corner_null(corner));
+
+#if CUBELIB_STRATEGY_OPPOSITE_CORNER == CUBELIB_STRATEGY_TABLE
+        return cubelib_opposite_corners[cubelib_get_corner_index(corner)];
+#else
+        return cubelib_calc_opposite_corner(corner);
+#endif
+    }
+
+    CUBELIB_FUNCTION_QUALIFIER cubelib_corner_t cubelib_calc_corner_move(cubelib_corner_t corner, cubelib_direction_t direction)
     {
         assert(cubelib_is_corner_valid(corner));
         assert(!cubelib_is_corner_null(corner));
@@ -168,7 +177,21 @@ extern "C"{
         return cubelib_get_corner_by_int3(x,y,z);
     }
 
-    CUBELIB_FUNCTION_QUALIFIER cubelib_corner_t cubelib_corner_push(cubelib_corner_t corner, cubelib_direction_t direction)
+    CUBELIB_FUNCTION_QUALIFIER cubelib_corner_t cubelib_corner_move(cubelib_corner_t corner, cubelib_direction_t direction)
+    {
+        assert(cubelib_is_corner_valid(corner));
+        assert(!cubelib_is_corner_null(corner));
+        assert(cubelib_is_direction_valid(direction));
+        assert(!cubelib_is_direction_null(direction));
+
+#if CUBELIB_STRATEGY_CORNER_MOVE == CUBELIB_STRATEGY_TABLE
+        return cubelib_corner_moves[cubelib_get_corner_index(corner)][cubelib_get_direction_index(direction)];
+#else
+        return cubelib_calc_corner_move(corner, direction);
+#endif
+    }
+
+    CUBELIB_FUNCTION_QUALIFIER cubelib_corner_t cubelib_calc_corner_push(cubelib_corner_t corner, cubelib_direction_t direction)
     {
         assert(cubelib_is_corner_valid(corner));
         assert(!cubelib_is_corner_null(corner));
@@ -182,6 +205,20 @@ extern "C"{
 
         return cubelib_get_corner_by_int3(x,y,z);
     }
+
+    CUBELIB_FUNCTION_QUALIFIER cubelib_corner_t cubelib_corner_push(cubelib_corner_t corner, cubelib_direction_t direction)
+    {
+        assert(cubelib_is_corner_valid(corner));
+        assert(!cubelib_is_corner_null(corner));
+        assert(cubelib_is_direction_valid(direction));
+        assert(!cubelib_is_direction_null(direction));
+
+#if CUBELIB_STRATEGY_CORNER_PUSH == CUBELIB_STRATEGY_TABLE
+        return cubelib_corner_pushes[cubelib_get_corner_index(corner)][cubelib_get_direction_index(direction)];
+#else
+        return cubelib_calc_corner_push(corner, direction);
+#endif
+    }
     
     CUBELIB_FUNCTION_QUALIFIER cubelib_corner_t cubelib_calc_adjacent_corner(cubelib_corner_t corner, cubelib_direction_t direction)
     {
@@ -204,7 +241,11 @@ extern "C"{
         assert(!cubelib_is_corner_null(corner));
         assert(cubelib_is_direction_valid(direction));
         assert(!cubelib_is_direction_null(direction));
+#if CUBELIB_STRATEGY_ADJACENT_CORNER == CUBELIB_STRATEGY_TABLE
+        return cubelib_adjacent_corners[cubelib_get_corner_index(corner)][cubelib_get_direction_index(direction)];
+#else
         return cubelib_calc_adjacent_corner(corner, direction);
+#endif
     }
 
     CUBELIB_FUNCTION_QUALIFIER uint_fast8_t cubelib_get_corner_index(cubelib_corner_t corner){
@@ -248,7 +289,11 @@ extern "C"{
         assert(cubelib_is_corner_valid(corner1));
         assert(!cubelib_is_corner_null(corner0));
         assert(!cubelib_is_corner_null(corner1));
+#if CUBELIB_STRATEGY_IS_CORNER_ADJACENT_CORNER == CUBELIB_STRATEGY_TABLE
+        return cubelib_corner_adjacency[cubelib_get_corner_index(corner0)][cubelib_get_corner_index(corner1)];
+#else
         return cubelib_calc_is_corner_adjacent_corner(corner0, corner1);
+#endif
     }
 
     
@@ -260,7 +305,7 @@ extern "C"{
         return left.value == right.value;
     }
 
-    CUBELIB_FUNCTION_QUALIFIER bool cubelib_is_corner_on_face(cubelib_corner_t corner, cubelib_face_t face)
+    CUBELIB_FUNCTION_QUALIFIER bool cubelib_calc_is_corner_on_face(cubelib_corner_t corner, cubelib_face_t face)
     {
         assert(cubelib_is_corner_valid(corner));
         assert(!cubelib_is_corner_null(corner));
@@ -272,6 +317,19 @@ extern "C"{
         return cubelib_get_corner_i(corner, sigdim) == cubelib_get_direction_i(direction,sigdim);
     }
 
+    CUBELIB_FUNCTION_QUALIFIER bool cubelib_is_corner_on_face(cubelib_corner_t corner, cubelib_face_t face)
+    {
+        assert(cubelib_is_corner_valid(corner));
+        assert(!cubelib_is_corner_null(corner));
+        assert(cubelib_is_face_valid(face));
+        assert(!cubelib_is_face_null(face));
+#if CUBELIB_STRATEGY_IS_CORNER_ON_FACE == CUBELIB_STRATEGY_TABLE
+        return cubelib_corner_face_incidence[cubelib_get_corner_index(corner)][cubelib_get_face_index(face)];
+#else
+        return cubelib_calc_is_corner_on_face(corner, face);
+#endif
+    }
+
 
     /*
      * ---------------------------------------------------------------------
@@ -404,7 +462,7 @@ extern "C"{
     }
     
 
-    CUBELIB_FUNCTION_QUALIFIER cubelib_direction_t cubelib_get_opposite_direction(cubelib_direction_t direction)
+    CUBELIB_FUNCTION_QUALIFIER cubelib_direction_t cubelib_calc_opposite_direction(cubelib_direction_t direction)
     {
         assert(cubelib_is_direction_valid(direction));
         assert(!cubelib_is_direction_null(direction));
@@ -415,6 +473,17 @@ extern "C"{
         return result;
     }
 
+    CUBELIB_FUNCTION_QUALIFIER cubelib_direction_t cubelib_get_opposite_direction(cubelib_direction_t direction)
+    {
+        assert(cubelib_is_direction_valid(direction));
+        assert(!cubelib_is_direction_null(direction));
+#if CUBELIB_STRATEGY_OPPOSITE_DIRECTION == CUBELIB_STRATEGY_TABLE
+        return cubelib_opposite_directions[cubelib_get_direction_index(direction)];
+#else
+        return cubelib_calc_opposite_direction(direction);
+#endif
+    }
+
     CUBELIB_FUNCTION_QUALIFIER cubelib_direction_t get_opposite_face(cubelib_direction_t direction)
     {
         assert(cubelib_is_direction_valid(direction));
@@ -515,7 +584,7 @@ extern "C"{
         
         assert(cubelib_is_edge_valid(result));
         assert(!cubelib_is_edge_null(result));
-        assert(cubelib_get_edge_base_axis(result) == base_axis);
+        assert(cubelib_calc_edge_base_axis(result) == base_axis);
         assert(cubelib_is_edge_projected_secondary(result) == project_secondary);
         assert(cubelib_is_edge_projected_tertiary(result) == project_tertiary);
         
@@ -550,21 +619,21 @@ extern "C"{
         assert(cubelib_is_direction_valid(direction));
         assert(!cubelib_is_direction_null(direction));
         
-        cubelib_corner_t next_corner = cubelib_corner_move(corner, direction);
+        cubelib_corner_t next_corner = cubelib_calc_corner_move(corner, direction);
         assert(!cubelib_is_corner_null(next_corner) && "there is no adjacent corner in that direction");
         
-        assert(cubelib_is_corner_adjacent_corner(corner,next_corner));
+        assert(cubelib_calc_is_corner_adjacent_corner(corner,next_corner));
         
-        cubelib_edge_t result = cubelib_get_edge_by_corners(corner,next_corner);
+        cubelib_edge_t result = cubelib_calc_edge_by_corners(corner,next_corner);
         
         assert(cubelib_is_edge_valid(result));
         assert(!cubelib_is_edge_null(result));
         
         ///corner == corner0(edge) || corner == corner1(edge)
-        assert(cubelib_is_corner_equal(cubelib_get_edge_corner0(result), corner) || cubelib_is_corner_equal(cubelib_get_edge_corner1(result), corner));
+        assert(cubelib_is_corner_equal(cubelib_calc_edge_corner0(result), corner) || cubelib_is_corner_equal(cubelib_calc_edge_corner1(result), corner));
         
         ///next_corner == corner0(edge) || next_corner == corner1(edge)
-        assert(cubelib_is_corner_equal(cubelib_get_edge_corner0(result), next_corner) || cubelib_is_corner_equal(cubelib_get_edge_corner1(result), next_corner));
+        assert(cubelib_is_corner_equal(cubelib_calc_edge_corner0(result), next_corner) || cubelib_is_corner_equal(cubelib_calc_edge_corner1(result), next_corner));
         
         return result;
     }
@@ -576,13 +645,19 @@ extern "C"{
         assert(cubelib_is_direction_valid(direction));
         assert(!cubelib_is_direction_null(direction));
         
+#if CUBELIB_STRATEGY_EDGE_BY_CORNER_DIRECTION == CUBELIB_STRATEGY_TABLE
+        cubelib_edge_t result = cubelib_edges_by_corner_direction[cubelib_get_corner_index(corner)][cubelib_get_direction_index(direction)];
+        assert(!cubelib_is_edge_null(result) && "there is no adjacent corner in that direction");
+        return result;
+#else
         return cubelib_calc_edge_by_corner_direction(corner,direction);
+#endif
     }
     
     
     
     
-    CUBELIB_FUNCTION_QUALIFIER cubelib_edge_t cubelib_get_opposite_edge(cubelib_edge_t edge)
+    CUBELIB_FUNCTION_QUALIFIER cubelib_edge_t cubelib_calc_opposite_edge(cubelib_edge_t edge)
     {
         assert(cubelib_is_edge_valid(edge));
         assert(!cubelib_is_edge_null(edge));
@@ -608,6 +683,17 @@ extern "C"{
         return result;
     }
     
+    CUBELIB_FUNCTION_QUALIFIER cubelib_edge_t cubelib_get_opposite_edge(cubelib_edge_t edge)
+    {
+        assert(cubelib_is_edge_valid(edge));
+        assert(!cubelib_is_edge_null(edge));
+#if CUBELIB_STRATEGY_OPPOSITE_EDGE == CUBELIB_STRATEGY_TABLE
+        return cubelib_opposite_edges[cubelib_get_edge_index(edge)];
+#else
+        return cubelib_calc_opposite_edge(edge);
+#endif
+    }
+    
     
     
     
@@ -636,20 +722,32 @@ extern "C"{
     CUBELIB_FUNCTION_QUALIFIER uint_fast8_t cubelib_get_edge_base_axis(cubelib_edge_t edge) {
         assert(cubelib_is_edge_valid(edge));
         assert(!cubelib_is_edge_null(edge));
+#if CUBELIB_STRATEGY_EDGE_AXES == CUBELIB_STRATEGY_TABLE
+        return cubelib_edge_axes[cubelib_get_edge_index(edge)][0];
+#else
         return cubelib_calc_edge_base_axis(edge);
+#endif
     }
     
     
     CUBELIB_FUNCTION_QUALIFIER uint_fast8_t cubelib_get_edge_secondary_axis(cubelib_edge_t edge) {
         assert(cubelib_is_edge_valid(edge));
         assert(!cubelib_is_edge_null(edge));
+#if CUBELIB_STRATEGY_EDGE_AXES == CUBELIB_STRATEGY_TABLE
+        return cubelib_edge_axes[cubelib_get_edge_index(edge)][1];
+#else
         return cubelib_calc_edge_secondary_axis(edge);
+#endif
     }
     
     CUBELIB_FUNCTION_QUALIFIER uint_fast8_t cubelib_get_edge_tertiary_axis(cubelib_edge_t edge) {
         assert(cubelib_is_edge_valid(edge));
         assert(!cubelib_is_edge_null(edge));
+#if CUBELIB_STRATEGY_EDGE_AXES == CUBELIB_STRATEGY_TABLE
+        return cubelib_edge_axes[cubelib_get_edge_index(edge)][2];
+#else
         return cubelib_calc_edge_tertiary_axis(edge);
+#endif
     }
     
     
@@ -670,31 +768,31 @@ extern "C"{
     }
     
     
-    CUBELIB_FUNCTION_QUALIFIER cubelib_corner_t calc_edge_corner0(cubelib_edge_t edge)
+    CUBELIB_FUNCTION_QUALIFIER cubelib_corner_t cubelib_calc_edge_corner0(cubelib_edge_t edge)
     {
         assert(cubelib_is_edge_valid(edge));
         assert(!cubelib_is_edge_null(edge));
         
         int xyz[] = {-1, -1, -1};
         
-        xyz[cubelib_get_edge_secondary_axis(edge)] += cubelib_is_edge_projected_secondary(edge) ? 2 : 0;
-        xyz[cubelib_get_edge_tertiary_axis(edge)] += cubelib_is_edge_projected_tertiary(edge) ? 2 : 0;
+        xyz[cubelib_calc_edge_secondary_axis(edge)] += cubelib_is_edge_projected_secondary(edge) ? 2 : 0;
+        xyz[cubelib_calc_edge_tertiary_axis(edge)] += cubelib_is_edge_projected_tertiary(edge) ? 2 : 0;
         return cubelib_get_corner_by_int3( xyz[0], xyz[1], xyz[2] );
     }
     
     
     
-    CUBELIB_FUNCTION_QUALIFIER cubelib_corner_t calc_edge_corner1(cubelib_edge_t edge)
+    CUBELIB_FUNCTION_QUALIFIER cubelib_corner_t cubelib_calc_edge_corner1(cubelib_edge_t edge)
     {
         assert(cubelib_is_edge_valid(edge));
         assert(!cubelib_is_edge_null(edge));
         
         int xyz[] = {-1, -1, -1};
         
-        xyz[cubelib_get_edge_secondary_axis(edge)] += cubelib_is_edge_projected_secondary(edge) ? 2 : 0;
-        xyz[cubelib_get_edge_tertiary_axis(edge)] += cubelib_is_edge_projected_tertiary(edge) ? 2 : 0;
+        xyz[cubelib_calc_edge_secondary_axis(edge)] += cubelib_is_edge_projected_secondary(edge) ? 2 : 0;
+        xyz[cubelib_calc_edge_tertiary_axis(edge)] += cubelib_is_edge_projected_tertiary(edge) ? 2 : 0;
         
-        xyz[cubelib_get_edge_base_axis(edge)] += 2;
+        xyz[cubelib_calc_edge_base_axis(edge)] += 2;
         return cubelib_get_corner_by_int3( xyz[0], xyz[1], xyz[2] );
     }
     
@@ -708,7 +806,11 @@ extern "C"{
         assert(cubelib_is_edge_valid(edge));
         assert(!cubelib_is_edge_null(edge));
         
-        return calc_edge_corner0(edge);
+#if CUBELIB_STRATEGY_EDGE_CORNERS == CUBELIB_STRATEGY_TABLE
+        return cubelib_edge_corners[cubelib_get_edge_index(edge)][0];
+#else
+        return cubelib_calc_edge_corner0(edge);
+#endif
     }
     
     CUBELIB_FUNCTION_QUALIFIER cubelib_corner_t cubelib_get_edge_corner1(cubelib_edge_t edge)
@@ -716,20 +818,24 @@ extern "C"{
         assert(cubelib_is_edge_valid(edge));
         assert(!cubelib_is_edge_null(edge));
         
-        return calc_edge_corner1(edge);
+#if CUBELIB_STRATEGY_EDGE_CORNERS == CUBELIB_STRATEGY_TABLE
+        return cubelib_edge_corners[cubelib_get_edge_index(edge)][1];
+#else
+        return cubelib_calc_edge_corner1(edge);
+#endif
     }
     
     
     
     
-    CUBELIB_FUNCTION_QUALIFIER cubelib_edge_t calc_edge_by_corners(cubelib_corner_t corner0, cubelib_corner_t corner1)
+    CUBELIB_FUNCTION_QUALIFIER cubelib_edge_t cubelib_calc_edge_by_corners(cubelib_corner_t corner0, cubelib_corner_t corner1)
     {
         assert(cubelib_is_corner_valid(corner0));
         assert(cubelib_is_corner_valid(corner1));
         assert(!cubelib_is_corner_null(corner0));
         assert(!cubelib_is_corner_null(corner1));
         assert(!cubelib_is_corner_equal(corner0, corner1));
-        assert(cubelib_is_corner_adjacent_corner(corner0, corner1));
+        assert(cubelib_calc_is_corner_adjacent_corner(corner0, corner1));
         
         ///the value will be in the form of 0bBBTS; where BB is the base axis bits, and S,T are the "is projected" bits
         /// for the Secondary and Tertiary axes.
@@ -767,15 +873,15 @@ extern "C"{
         
         assert(cubelib_is_edge_valid(result));
         assert(!cubelib_is_edge_null(result));
-        assert(cubelib_get_edge_base_axis(result) == base_axis);
-        assert(cubelib_get_edge_secondary_axis(result) == secondary_axis);
-        assert(cubelib_get_edge_tertiary_axis(result) == tertiary_axis);
+        assert(cubelib_calc_edge_base_axis(result) == base_axis);
+        assert(cubelib_calc_edge_secondary_axis(result) == secondary_axis);
+        assert(cubelib_calc_edge_tertiary_axis(result) == tertiary_axis);
         assert(cubelib_is_edge_projected_secondary(result) == is_projected_secondary_bit);
         assert(cubelib_is_edge_projected_tertiary(result) == is_projected_tertiary_bit);
         //assert(cubelib_is_corner_adjacent_edge(corner0, result));
         //assert(cubelib_is_corner_adjacent_edge(corner1, result));
-        assert(cubelib_is_corner_equal(cubelib_get_edge_corner0(result), corner0) || cubelib_is_corner_equal(cubelib_get_edge_corner0(result), corner1));
-        assert(cubelib_is_corner_equal(cubelib_get_edge_corner1(result), corner0) || cubelib_is_corner_equal(cubelib_get_edge_corner1(result), corner1));
+        assert(cubelib_is_corner_equal(cubelib_calc_edge_corner0(result), corner0) || cubelib_is_corner_equal(cubelib_calc_edge_corner0(result), corner1));
+        assert(cubelib_is_corner_equal(cubelib_calc_edge_corner1(result), corner0) || cubelib_is_corner_equal(cubelib_calc_edge_corner1(result), corner1));
         return result;
     }
     
@@ -787,12 +893,24 @@ extern "C"{
         assert(!cubelib_is_corner_null(corner1));
         assert(cubelib_is_corner_adjacent_corner(corner0, corner1));
 
-        return calc_edge_by_corners(corner0, corner1);
+#if CUBELIB_STRATEGY_EDGE_BY_CORNERS == CUBELIB_STRATEGY_TABLE
+        return cubelib_edges_by_corners[cubelib_get_corner_index(corner0)][cubelib_get_corner_index(corner1)];
+#else
+        return cubelib_calc_edge_by_corners(corner0, corner1);
+#endif
     }
     
     CUBELIB_FUNCTION_QUALIFIER cubelib_edge_t cubelib_edge_push(cubelib_edge_t edge, cubelib_direction_t direction)
     {
+        assert(cubelib_is_edge_valid(edge));
+        assert(!cubelib_is_edge_null(edge));
+        assert(cubelib_is_direction_valid(direction));
+        assert(!cubelib_is_direction_null(direction));
+#if CUBELIB_STRATEGY_EDGE_PUSH == CUBELIB_STRATEGY_TABLE
+        return cubelib_edge_pushes[cubelib_get_edge_index(edge)][cubelib_get_direction_index(direction)];
+#else
         return cubelib_calc_edge_push(edge, direction);
+#endif
     }
     CUBELIB_FUNCTION_QUALIFIER cubelib_edge_t cubelib_calc_edge_push(cubelib_edge_t edge, cubelib_direction_t direction)
     {
@@ -802,19 +920,19 @@ extern "C"{
         assert(!cubelib_is_direction_null(direction));
         
         
-        cubelib_corner_t corner0 = cubelib_get_edge_corner0(edge);
-        cubelib_direction_t edge_dir = cubelib_get_edge_direction(edge);
+        cubelib_corner_t corner0 = cubelib_calc_edge_corner0(edge);
+        cubelib_direction_t edge_dir = cubelib_calc_edge_direction(edge);
         
         ///move the base of the edge
-        corner0 = cubelib_corner_push(corner0, direction);
+        corner0 = cubelib_calc_corner_push(corner0, direction);
         
         ///now recalculate the other corner of the edge
-        cubelib_corner_t corner1 = cubelib_get_adjacent_corner(corner0, edge_dir);
+        cubelib_corner_t corner1 = cubelib_calc_adjacent_corner(corner0, edge_dir);
         
         ///recreate the edge
-        cubelib_edge_t result = cubelib_get_edge_by_corners(corner0, corner1);
+        cubelib_edge_t result = cubelib_calc_edge_by_corners(corner0, corner1);
         
-        assert(cubelib_get_edge_base_axis(edge) == cubelib_get_edge_base_axis(result));
+        assert(cubelib_calc_edge_base_axis(edge) == cubelib_calc_edge_base_axis(result));
          
         
         return result;
@@ -823,12 +941,12 @@ extern "C"{
     
     
     
-    CUBELIB_FUNCTION_QUALIFIER cubelib_direction_t cubelib_get_edge_direction(cubelib_edge_t edge)
+    CUBELIB_FUNCTION_QUALIFIER cubelib_direction_t cubelib_calc_edge_direction(cubelib_edge_t edge)
     {
         assert(cubelib_is_edge_valid(edge));
         assert(!cubelib_is_edge_null(edge));
         
-        uint_fast8_t base_axis = cubelib_get_edge_base_axis(edge);
+        uint_fast8_t base_axis = cubelib_calc_edge_base_axis(edge);
         
         int xyz[] = {0,0,0};
         xyz[base_axis] = +1;
@@ -840,6 +958,17 @@ extern "C"{
         return result;
     }
     
+    CUBELIB_FUNCTION_QUALIFIER cubelib_direction_t cubelib_get_edge_direction(cubelib_edge_t edge)
+    {
+        assert(cubelib_is_edge_valid(edge));
+        assert(!cubelib_is_edge_null(edge));
+#if CUBELIB_STRATEGY_EDGE_DIRECTION == CUBELIB_STRATEGY_TABLE
+        return cubelib_edge_directions[cubelib_get_edge_index(edge)];
+#else
+        return cubelib_calc_edge_direction(edge);
+#endif
+    }
+    
     
     
     /*
@@ -930,7 +1059,11 @@ extern "C"{
         assert(cubelib_is_face_valid(face));
         assert(!cubelib_is_face_null(face));
         assert(idx < 4);
+#if CUBELIB_STRATEGY_CORNER_ON_FACE == CUBELIB_STRATEGY_TABLE
         return cubelib_corners_on_face[cubelib_get_face_index(face)][idx];
+#else
+        return cubelib_calc_corner_on_face(face, idx);
+#endif
     }
 
     
@@ -973,11 +1106,11 @@ extern "C"{
             cubelib_edge_t pair_base_edge = cubelib_get_edge_by_axis(base_axis, false, false);
             
             ///push it into the face; now this will be in this face
-            cubelib_edge_t pair_face_base_edge = cubelib_edge_push(pair_base_edge, direction);
+            cubelib_edge_t pair_face_base_edge = cubelib_calc_edge_push(pair_base_edge, direction);
             
             
             ///push pair_face_base_edge across the face
-            cubelib_edge_t pair_face_2nd_edge = cubelib_edge_push(pair_face_base_edge, other_axis_direction);
+            cubelib_edge_t pair_face_2nd_edge = cubelib_calc_edge_push(pair_face_base_edge, other_axis_direction);
             
             
             face_edges[edge_pair_i*2 + 0] = pair_face_base_edge;
@@ -995,7 +1128,11 @@ extern "C"{
         assert(cubelib_is_face_valid(face));
         assert(!cubelib_is_face_null(face));
         
+#if CUBELIB_STRATEGY_EDGE_ON_FACE == CUBELIB_STRATEGY_TABLE
         return cubelib_edges_on_face[cubelib_get_face_index(face)][idx];
+#else
+        return cubelib_calc_edge_on_face(face, idx);
+#endif
     }
     
     
@@ -1006,33 +1143,7 @@ extern "C"{
         assert(cubelib_is_face_valid(face));
         assert(!cubelib_is_face_null(face));
         
-        
-        assert(cubelib_is_face_valid(face));
-        assert(!cubelib_is_face_null(face));
-        assert(cubelib_is_edge_valid(edge));
-        assert(!cubelib_is_edge_null(edge));
-        
-        cubelib_direction_t direction = cubelib_get_face_direction(face);
-        int xyz[] = {cubelib_get_direction_x(direction), cubelib_get_direction_y(direction), cubelib_get_direction_z(direction) };
-        
-        
-        uint_fast8_t base_axis = cubelib_get_edge_base_axis(edge);
-        uint_fast8_t secondary_axis = cubelib_get_edge_secondary_axis(edge);
-        uint_fast8_t tertiary_axis = cubelib_get_edge_tertiary_axis(edge);
-        
-        int secondary_magnitude = cubelib_is_edge_projected_secondary(edge) ? +1 : -1;
-        int tertiary_magnitude = cubelib_is_edge_projected_tertiary(edge) ? +1 : -1;
-        
-        if (xyz[base_axis] != 0)
-            return false;
-        
-        if (xyz[secondary_axis] != 0 && xyz[secondary_axis] != secondary_magnitude)
-            return false;
-        
-        if (xyz[tertiary_axis] != 0 && xyz[tertiary_axis] != tertiary_magnitude)
-            return false;
-        
-        return true;
+        return cubelib_is_face_on_edge(face, edge);
     }
     
     
@@ -1059,13 +1170,12 @@ extern "C"{
         
         int face_xyz[2][3] = {{0,0,0},{0,0,0}};
         
-        face_xyz[0][cubelib_get_edge_secondary_axis(edge)] = cubelib_is_edge_projected_secondary(edge) ? +1 : -1;
-        face_xyz[1][cubelib_get_edge_tertiary_axis(edge)] = cubelib_is_edge_projected_tertiary(edge) ? +1 : -1;
+        face_xyz[0][cubelib_calc_edge_secondary_axis(edge)] = cubelib_is_edge_projected_secondary(edge) ? +1 : -1;
+        face_xyz[1][cubelib_calc_edge_tertiary_axis(edge)] = cubelib_is_edge_projected_tertiary(edge) ? +1 : -1;
         
         cubelib_face_t result = cubelib_get_direction_face( cubelib_get_direction_by_int3(face_xyz[idx][0], face_xyz[idx][1], face_xyz[idx][2]) );
         
-        assert(cubelib_is_edge_on_face(edge, result));
-        assert(cubelib_is_face_on_edge(result, edge));
+        assert(cubelib_calc_is_face_on_edge(result, edge));
         return result;
     }
     CUBELIB_FUNCTION_QUALIFIER cubelib_face_t cubelib_get_face_on_edge(cubelib_edge_t edge, uint_fast8_t idx)
@@ -1073,13 +1183,17 @@ extern "C"{
         assert(cubelib_is_edge_valid(edge));
         assert(!cubelib_is_edge_null(edge));
         assert(idx < 2);
+#if CUBELIB_STRATEGY_FACE_ON_EDGE == CUBELIB_STRATEGY_TABLE
         cubelib_face_t result = cubelib_faces_on_edge[cubelib_get_edge_index(edge)][idx];
+#else
+        cubelib_face_t result = cubelib_calc_face_on_edge(edge, idx);
+#endif
         assert(cubelib_is_edge_on_face(edge, result));
         assert(cubelib_is_face_on_edge(result, edge));
         return result;
     }
     
-    CUBELIB_FUNCTION_QUALIFIER bool cubelib_is_face_on_edge(cubelib_face_t face, cubelib_edge_t edge)
+    CUBELIB_FUNCTION_QUALIFIER bool cubelib_calc_is_face_on_edge(cubelib_face_t face, cubelib_edge_t edge)
     {
         assert(cubelib_is_face_valid(face));
         assert(!cubelib_is_face_null(face));
@@ -1090,9 +1204,9 @@ extern "C"{
         int xyz[] = {cubelib_get_direction_x(direction), cubelib_get_direction_y(direction), cubelib_get_direction_z(direction) };
         
         
-        uint_fast8_t base_axis = cubelib_get_edge_base_axis(edge);
-        uint_fast8_t secondary_axis = cubelib_get_edge_secondary_axis(edge);
-        uint_fast8_t tertiary_axis = cubelib_get_edge_tertiary_axis(edge);
+        uint_fast8_t base_axis = cubelib_calc_edge_base_axis(edge);
+        uint_fast8_t secondary_axis = cubelib_calc_edge_secondary_axis(edge);
+        uint_fast8_t tertiary_axis = cubelib_calc_edge_tertiary_axis(edge);
         
         int secondary_magnitude = cubelib_is_edge_projected_secondary(edge) ? +1 : -1;
         int tertiary_magnitude = cubelib_is_edge_projected_tertiary(edge) ? +1 : -1;
@@ -1108,6 +1222,19 @@ extern "C"{
         
         return true;
     }
+    
+    CUBELIB_FUNCTION_QUALIFIER bool cubelib_is_face_on_edge(cubelib_face_t face, cubelib_edge_t edge)
+    {
+        assert(cubelib_is_face_valid(face));
+        assert(!cubelib_is_face_null(face));
+        assert(cubelib_is_edge_valid(edge));
+        assert(!cubelib_is_edge_null(edge));
+#if CUBELIB_STRATEGY_IS_FACE_ON_EDGE == CUBELIB_STRATEGY_TABLE
+        return cubelib_edge_face_incidence[cubelib_get_edge_index(edge)][cubelib_get_face_index(face)];
+#else
+        return cubelib_calc_is_face_on_edge(face, edge);
+#endif
+    }
 
 #ifdef __cplusplus
 }
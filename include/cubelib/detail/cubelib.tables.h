@@ -0,0 +1,254 @@
+///Generated via cubelib-gen-consts.cpp
+///
+///
+///DO NOT MODIFY
+///MODIFICATIONS WILL BE OVERWRITTEN WHEN THIS FILE IS REGENERATED
+///EDIT THE GENERATOR IF NECESSARY
+
+#ifndef CORNER_CASES_CUBELIB_TABLES_H
+#define CORNER_CASES_CUBELIB_TABLES_H 1
+
+
+///@brief Initializer for `cubelib_corner_t cubelib_cnr_adj_cnrs[8][3]`
+#define CUBELIB_CNR_ADJ_CNRS \
+    {   { {1}, {2}, {4} } \
+      , { {0}, {3}, {5} } \
+      , { {3}, {0}, {6} } \
+      , { {2}, {1}, {7} } \
+      , { {5}, {6}, {0} } \
+      , { {4}, {7}, {1} } \
+      , { {7}, {4}, {2} } \
+      , { {6}, {5}, {3} } \
+    }
+#define CUBELIB_BLOB_OFFSET_CNR_ADJ_CNRS 0
+
+///@brief Initializer for `cubelib_face_t cubelib_faces_on_edge[12][2]`
+#define CUBELIB_FACES_ON_EDGE \
+    {   { {5}, {3} } \
+      , { {2}, {3} } \
+      , { {5}, {4} } \
+      , { {2}, {4} } \
+      , { {3}, {6} } \
+      , { {4}, {6} } \
+      , { {3}, {1} } \
+      , { {4}, {1} } \
+      , { {6}, {5} } \
+      , { {1}, {5} } \
+      , { {6}, {2} } \
+      , { {1}, {2} } \
+    }
+#define CUBELIB_BLOB_OFFSET_FACES_ON_EDGE 24
+
+///@brief Initializer for `cubelib_edge_t cubelib_edges_on_face[6][4]`
+#define CUBELIB_EDGES_ON_FACE \
+    {   { {6}, {7}, {9}, {11} } \
+      , { {10}, {11}, {1}, {3} } \
+      , { {0}, {1}, {4}, {6} } \
+      , { {2}, {3}, {5}, {7} } \
+      , { {8}, {9}, {0}, {2} } \
+      , { {4}, {5}, {8}, {10} } \
+    }
+#define CUBELIB_BLOB_OFFSET_EDGES_ON_FACE 48
+
+///@brief Initializer for `cubelib_corner_t cubelib_corners_on_face[6][4]`
+#define CUBELIB_CORNERS_ON_FACE \
+    {   { {1}, {3}, {5}, {7} } \
+      , { {2}, {3}, {6}, {7} } \
+      , { {0}, {1}, {2}, {3} } \
+      , { {4}, {5}, {6}, {7} } \
+      , { {0}, {1}, {4}, {5} } \
+      , { {0}, {2}, {4}, {6} } \
+    }
+#define CUBELIB_BLOB_OFFSET_CORNERS_ON_FACE 72
+
+///@brief Initializer for `cubelib_corner_t cubelib_opposite_corners[8]`
+#define CUBELIB_OPPOSITE_CORNERS \
+    { {7}, {6}, {5}, {4}, {3}, {2}, {1}, {0} }
+#define CUBELIB_BLOB_OFFSET_OPPOSITE_CORNERS 96
+
+///@brief Initializer for `cubelib_corner_t cubelib_adjacent_corners[8][6]`
+#define CUBELIB_ADJACENT_CORNERS \
+    {   { {1}, {2}, {4}, {4}, {2}, {1} } \
+      , { {0}, {3}, {5}, {5}, {3}, {0} } \
+      , { {3}, {0}, {6}, {6}, {0}, {3} } \
+      , { {2}, {1}, {7}, {7}, {1}, {2} } \
+      , { {5}, {6}, {0}, {0}, {6}, {5} } \
+      , { {4}, {7}, {1}, {1}, {7}, {4} } \
+      , { {7}, {4}, {2}, {2}, {4}, {7} } \
+      , { {6}, {5}, {3}, {3}, {5}, {6} } \
+    }
+#define CUBELIB_BLOB_OFFSET_ADJACENT_CORNERS 104
+
+///@brief Initializer for `cubelib_corner_t cubelib_corner_moves[8][6]`
+#define CUBELIB_CORNER_MOVES \
+    {   { {1}, {2}, {8}, {4}, {8}, {8} } \
+      , { {8}, {3}, {8}, {5}, {8}, {0} } \
+      , { {3}, {8}, {8}, {6}, {0}, {8} } \
+      , { {8}, {8}, {8}, {7}, {1}, {2} } \
+      , { {5}, {6}, {0}, {8}, {8}, {8} } \
+      , { {8}, {7}, {1}, {8}, {8}, {4} } \
+      , { {7}, {8}, {2}, {8}, {4}, {8} } \
+      , { {8}, {8}, {3}, {8}, {5}, {6} } \
+    }
+#define CUBELIB_BLOB_OFFSET_CORNER_MOVES 152
+
+///@brief Initializer for `cubelib_corner_t cubelib_corner_pushes[8][6]`
+#define CUBELIB_CORNER_PUSHES \
+    {   { {1}, {2}, {0}, {4}, {0}, {0} } \
+      , { {1}, {3}, {1}, {5}, {1}, {0} } \
+      , { {3}, {2}, {2}, {6}, {0}, {2} } \
+      , { {3}, {3}, {3}, {7}, {1}, {2} } \
+      , { {5}, {6}, {0}, {4}, {4}, {4} } \
+      , { {5}, {7}, {1}, {5}, {5}, {4} } \
+      , { {7}, {6}, {2}, {6}, {4}, {6} } \
+      , { {7}, {7}, {3}, {7}, {5}, {6} } \
+    }
+#define CUBELIB_BLOB_OFFSET_CORNER_PUSHES 200
+
+///@brief Initializer for `bool cubelib_corner_adjacency[8][8]`
+#define CUBELIB_CORNER_ADJACENCY \
+    {   { 0, 1, 1, 0, 1, 0, 0, 0 } \
+      , { 1, 0, 0, 1, 0, 1, 0, 0 } \
+      , { 1, 0, 0, 1, 0, 0, 1, 0 } \
+      , { 0, 1, 1, 0, 0, 0, 0, 1 } \
+      , { 1, 0, 0, 0, 0, 1, 1, 0 } \
+      , { 0, 1, 0, 0, 1, 0, 0, 1 } \
+      , { 0, 0, 1, 0, 1, 0, 0, 1 } \
+      , { 0, 0, 0, 1, 0, 1, 1, 0 } \
+    }
+#define CUBELIB_BLOB_OFFSET_CORNER_ADJACENCY 248
+
+///@brief Initializer for `bool cubelib_corner_face_incidence[8][6]`
+#define CUBELIB_CORNER_FACE_INCIDENCE \
+    {   { 0, 0, 1, 0, 1, 1 } \
+      , { 1, 0, 1, 0, 1, 0 } \
+      , { 0, 1, 1, 0, 0, 1 } \
+      , { 1, 1, 1, 0, 0, 0 } \
+      , { 0, 0, 0, 1, 1, 1 } \
+      , { 1, 0, 0, 1, 1, 0 } \
+      , { 0, 1, 0, 1, 0, 1 } \
+      , { 1, 1, 0, 1, 0, 0 } \
+    }
+#define CUBELIB_BLOB_OFFSET_CORNER_FACE_INCIDENCE 312
+
+///@brief Initializer for `cubelib_direction_t cubelib_opposite_directions[6]`
+#define CUBELIB_OPPOSITE_DIRECTIONS \
+    { {6}, {5}, {4}, {3}, {2}, {1} }
+#define CUBELIB_BLOB_OFFSET_OPPOSITE_DIRECTIONS 360
+
+///@brief Initializer for `cubelib_edge_t cubelib_edges_by_corner_direction[8][6]`
+#define CUBELIB_EDGES_BY_CORNER_DIRECTION \
+    {   { {0}, {4}, {12}, {8}, {12}, {12} } \
+      , { {12}, {6}, {12}, {9}, {12}, {0} } \
+      , { {1}, {12}, {12}, {10}, {4}, {12} } \
+      , { {12}, {12}, {12}, {11}, {6}, {1} } \
+      , { {2}, {5}, {8}, {12}, {12}, {12} } \
+      , { {12}, {7}, {9}, {12}, {12}, {2} } \
+      , { {3}, {12}, {10}, {12}, {5}, {12} } \
+      , { {12}, {12}, {11}, {12}, {7}, {3} } \
+    }
+#define CUBELIB_BLOB_OFFSET_EDGES_BY_CORNER_DIRECTION 366
+
+///@brief Initializer for `cubelib_edge_t cubelib_edges_by_corners[8][8]`
+#define CUBELIB_EDGES_BY_CORNERS \
+    {   { {12}, {0}, {4}, {12}, {8}, {12}, {12}, {12} } \
+      , { {0}, {12}, {12}, {6}, {12}, {9}, {12}, {12} } \
+      , { {4}, {12}, {12}, {1}, {12}, {12}, {10}, {12} } \
+      , { {12}, {6}, {1}, {12}, {12}, {12}, {12}, {11} } \
+      , { {8}, {12}, {12}, {12}, {12}, {2}, {5}, {12} } \
+      , { {12}, {9}, {12}, {12}, {2}, {12}, {12}, {7} } \
+      , { {12}, {12}, {10}, {12}, {5}, {12}, {12}, {3} } \
+      , { {12}, {12}, {12}, {11}, {12}, {7}, {3}, {12} } \
+    }
+#define CUBELIB_BLOB_OFFSET_EDGES_BY_CORNERS 414
+
+///@brief Initializer for `cubelib_edge_t cubelib_opposite_edges[12]`
+#define CUBELIB_OPPOSITE_EDGES \
+    { {3}, {2}, {1}, {0}, {7}, {6}, {5}, {4}, {11}, {10}, {9}, {8} }
+#define CUBELIB_BLOB_OFFSET_OPPOSITE_EDGES 478
+
+///@brief Initializer for `cubelib_corner_t cubelib_edge_corners[12][2]`
+#define CUBELIB_EDGE_CORNERS \
+    {   { {0}, {1} } \
+      , { {2}, {3} } \
+      , { {4}, {5} } \
+      , { {6}, {7} } \
+      , { {0}, {2} } \
+      , { {4}, {6} } \
+      , { {1}, {3} } \
+      , { {5}, {7} } \
+      , { {0}, {4} } \
+      , { {1}, {5} } \
+      , { {2}, {6} } \
+      , { {3}, {7} } \
+    }
+#define CUBELIB_BLOB_OFFSET_EDGE_CORNERS 490
+
+///@brief Initializer for `cubelib_direction_t cubelib_edge_directions[12]`
+#define CUBELIB_EDGE_DIRECTIONS \
+    { {1}, {1}, {1}, {1}, {2}, {2}, {2}, {2}, {4}, {4}, {4}, {4} }
+#define CUBELIB_BLOB_OFFSET_EDGE_DIRECTIONS 514
+
+///@brief Initializer for `uint_fast8_t cubelib_edge_axes[12][3]`
+#define CUBELIB_EDGE_AXES \
+    {   { 0, 1, 2 } \
+      , { 0, 1, 2 } \
+      , { 0, 1, 2 } \
+      , { 0, 1, 2 } \
+      , { 1, 2, 0 } \
+      , { 1, 2, 0 } \
+      , { 1, 2, 0 } \
+      , { 1, 2, 0 } \
+      , { 2, 0, 1 } \
+      , { 2, 0, 1 } \
+      , { 2, 0, 1 } \
+      , { 2, 0, 1 } \
+    }
+#define CUBELIB_BLOB_OFFSET_EDGE_AXES 526
+
+///@brief Initializer for `cubelib_edge_t cubelib_edge_pushes[12][6]`
+#define CUBELIB_EDGE_PUSHES \
+    {   { {0}, {1}, {0}, {2}, {0}, {0} } \
+      , { {1}, {1}, {1}, {3}, {0}, {1} } \
+      , { {2}, {3}, {0}, {2}, {2}, {2} } \
+      , { {3}, {3}, {1}, {3}, {2}, {3} } \
+      , { {6}, {4}, {4}, {5}, {4}, {4} } \
+      , { {7}, {5}, {4}, {5}, {5}, {5} } \
+      , { {6}, {6}, {6}, {7}, {6}, {4} } \
+      , { {7}, {7}, {6}, {7}, {7}, {5} } \
+      , { {9}, {10}, {8}, {8}, {8}, {8} } \
+      , { {9}, {11}, {9}, {9}, {9}, {8} } \
+      , { {11}, {10}, {10}, {10}, {8}, {10} } \
+      , { {11}, {11}, {11}, {11}, {9}, {10} } \
+    }
+#define CUBELIB_BLOB_OFFSET_EDGE_PUSHES 562
+
+///@brief Initializer for `bool cubelib_edge_face_incidence[12][6]`
+#define CUBELIB_EDGE_FACE_INCIDENCE \
+    {   { 0, 0, 1, 0, 1, 0 } \
+      , { 0, 1, 1, 0, 0, 0 } \
+      , { 0, 0, 0, 1, 1, 0 } \
+      , { 0, 1, 0, 1, 0, 0 } \
+      , { 0, 0, 1, 0, 0, 1 } \
+      , { 0, 0, 0, 1, 0, 1 } \
+      , { 1, 0, 1, 0, 0, 0 } \
+      , { 1, 0, 0, 1, 0, 0 } \
+      , { 0, 0, 0, 0, 1, 1 } \
+      , { 1, 0, 0, 0, 1, 0 } \
+      , { 0, 1, 0, 0, 0, 1 } \
+      , { 1, 1, 0, 0, 0, 0 } \
+    }
+#define CUBELIB_BLOB_OFFSET_EDGE_FACE_INCIDENCE 634
+
+///@brief Size in bytes of the blob backend's output
+#define CUBELIB_BLOB_SIZE 706
+
+
+#define POSXFACE (cubelib_face_t){1}
+#define NEGXFACE (cubelib_face_t){6}
+#define POSYFACE (cubelib_face_t){2}
+#define NEGYFACE (cubelib_face_t){5}
+#define POSZFACE (cubelib_face_t){4}
+#define NEGZFACE (cubelib_face_t){3}
+
+#endif // CORNER_CASES_CUBELIB_TABLES_H
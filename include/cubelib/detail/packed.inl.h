@@ -0,0 +1,284 @@
+#ifndef CORNER_CASES_CUBELIB_PACKED_INL_H
+#define CORNER_CASES_CUBELIB_PACKED_INL_H
+
+#ifndef __OPENCL_VERSION__
+    #include <assert.h>
+    #include <string.h>
+    #if defined(__SSE2__) || defined(__BMI2__)
+        #include <immintrin.h>
+    #endif
+#endif
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+
+    /*
+     * ---------------------------------------------------------------------
+     * Element access
+     * ---------------------------------------------------------------------
+     */
+    CUBELIB_FUNCTION_QUALIFIER uint_fast8_t cubelib_packed4_get(const uint8_t* bytes, size_t i)
+    {
+        return (bytes[i >> 1] >> ((i & 1) << 2)) & 0x0F;
+    }
+
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_packed4_set(uint8_t* bytes, size_t i, uint_fast8_t index)
+    {
+        assert(index < 16);
+        uint_fast8_t shift = (i & 1) << 2;
+        uint8_t* byte = &bytes[i >> 1];
+        *byte = (uint8_t)((*byte & ~(0x0F << shift)) | (index << shift));
+    }
+
+    CUBELIB_FUNCTION_QUALIFIER uint_fast8_t cubelib_packed3_get(const uint8_t* bytes, size_t i)
+    {
+        const uint8_t* group = &bytes[(i >> 3) * 3];
+        uint_fast32_t word = (uint_fast32_t)group[0] | ((uint_fast32_t)group[1] << 8) | ((uint_fast32_t)group[2] << 16);
+        return (word >> ((i & 7) * 3)) & 0x07;
+    }
+
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_packed3_set(uint8_t* bytes, size_t i, uint_fast8_t index)
+    {
+        assert(index < 8);
+        uint8_t* group = &bytes[(i >> 3) * 3];
+        uint_fast32_t word = (uint_fast32_t)group[0] | ((uint_fast32_t)group[1] << 8) | ((uint_fast32_t)group[2] << 16);
+        uint_fast8_t shift = (i & 7) * 3;
+        word = (word & ~((uint_fast32_t)0x07 << shift)) | ((uint_fast32_t)index << shift);
+        group[0] = (uint8_t)(word);
+        group[1] = (uint8_t)(word >> 8);
+        group[2] = (uint8_t)(word >> 16);
+    }
+
+
+    /*
+     * ---------------------------------------------------------------------
+     * Bulk pack/unpack
+     * ---------------------------------------------------------------------
+     */
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_packed4_pack_n(const uint8_t* indices, uint8_t* bytes, size_t n)
+    {
+        size_t i = 0;
+#if defined(__SSE2__)
+        ///32 indices to 16 bytes: in each 16 bit lane, merge the odd byte into the high nibble of the even one,
+        /// then narrow the lanes back to bytes
+        const __m128i low_bytes = _mm_set1_epi16(0x00FF);
+        for (; i + 32 <= n; i += 32)
+        {
+            __m128i v0 = _mm_loadu_si128((const __m128i*)(indices + i));
+            __m128i v1 = _mm_loadu_si128((const __m128i*)(indices + i + 16));
+            v0 = _mm_or_si128(_mm_and_si128(v0, low_bytes), _mm_slli_epi16(_mm_srli_epi16(v0, 8), 4));
+            v1 = _mm_or_si128(_mm_and_si128(v1, low_bytes), _mm_slli_epi16(_mm_srli_epi16(v1, 8), 4));
+            _mm_storeu_si128((__m128i*)(bytes + (i >> 1)), _mm_packus_epi16(v0, v1));
+        }
+#endif
+        for (; i + 2 <= n; i += 2)
+        {
+            assert(indices[i] < 16 && indices[i + 1] < 16);
+            bytes[i >> 1] = (uint8_t)(indices[i] | (indices[i + 1] << 4));
+        }
+        if (i < n)
+        {
+            assert(indices[i] < 16);
+            bytes[i >> 1] = indices[i];
+        }
+    }
+
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_packed4_unpack_n(const uint8_t* bytes, uint8_t* indices, size_t n)
+    {
+        size_t i = 0;
+#if defined(__SSE2__)
+        ///16 bytes to 32 indices: split the nibbles, then interleave them back into element order
+        const __m128i low_nibbles = _mm_set1_epi8(0x0F);
+        for (; i + 32 <= n; i += 32)
+        {
+            __m128i v = _mm_loadu_si128((const __m128i*)(bytes + (i >> 1)));
+            __m128i lo = _mm_and_si128(v, low_nibbles);
+            __m128i hi = _mm_and_si128(_mm_srli_epi16(v, 4), low_nibbles);
+            _mm_storeu_si128((__m128i*)(indices + i), _mm_unpacklo_epi8(lo, hi));
+            _mm_storeu_si128((__m128i*)(indices + i + 16), _mm_unpackhi_epi8(lo, hi));
+        }
+#endif
+        for (; i + 2 <= n; i += 2)
+        {
+            uint8_t byte = bytes[i >> 1];
+            indices[i] = byte & 0x0F;
+            indices[i + 1] = byte >> 4;
+        }
+        if (i < n)
+            indices[i] = bytes[i >> 1] & 0x0F;
+    }
+
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_packed3_pack_n(const uint8_t* indices, uint8_t* bytes, size_t n)
+    {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            uint8_t* group = bytes + (i >> 3) * 3;
+#if defined(__BMI2__) && (defined(__x86_64__) || defined(_M_X64))
+            ///gather the low 3 bits of each of the 8 bytes into a 24 bit word
+            uint64_t eight;
+            memcpy(&eight, indices + i, 8);
+            assert((eight & ~UINT64_C(0x0707070707070707)) == 0);
+            uint32_t word = (uint32_t)_pext_u64(eight, UINT64_C(0x0707070707070707));
+#else
+            uint_fast32_t word = 0;
+            for (uint_fast8_t k = 0; k < 8; ++k)
+            {
+                assert(indices[i + k] < 8);
+                word |= (uint_fast32_t)indices[i + k] << (k * 3);
+            }
+#endif
+            group[0] = (uint8_t)(word);
+            group[1] = (uint8_t)(word >> 8);
+            group[2] = (uint8_t)(word >> 16);
+        }
+        if (i < n)
+        {
+            ///partial last group; the unused elements are zero
+            uint_fast32_t word = 0;
+            for (uint_fast8_t k = 0; i + k < n; ++k)
+            {
+                assert(indices[i + k] < 8);
+                word |= (uint_fast32_t)indices[i + k] << (k * 3);
+            }
+            uint8_t* group = bytes + (i >> 3) * 3;
+            group[0] = (uint8_t)(word);
+            group[1] = (uint8_t)(word >> 8);
+            group[2] = (uint8_t)(word >> 16);
+        }
+    }
+
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_packed3_unpack_n(const uint8_t* bytes, uint8_t* indices, size_t n)
+    {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            const uint8_t* group = bytes + (i >> 3) * 3;
+            uint_fast32_t word = (uint_fast32_t)group[0] | ((uint_fast32_t)group[1] << 8) | ((uint_fast32_t)group[2] << 16);
+#if defined(__BMI2__) && (defined(__x86_64__) || defined(_M_X64))
+            ///scatter the 24 bit word into the low 3 bits of 8 bytes
+            uint64_t eight = _pdep_u64(word, UINT64_C(0x0707070707070707));
+            memcpy(indices + i, &eight, 8);
+#else
+            for (uint_fast8_t k = 0; k < 8; ++k)
+                indices[i + k] = (word >> (k * 3)) & 0x07;
+#endif
+        }
+        for (; i < n; ++i)
+            indices[i] = cubelib_packed3_get(bytes, i);
+    }
+
+
+    /*
+     * ---------------------------------------------------------------------
+     * Typed arrays
+     * ---------------------------------------------------------------------
+     */
+
+///defines get/set/pack/unpack for cubelib_packed_<element>_array_t; pack/unpack convert to and from indices through
+/// a small stack buffer so the bulk kernels above do the bit twiddling
+#define CUBELIB_PACKED_ARRAY_DEFINE(ELEMENT)                                                                        \
+    CUBELIB_FUNCTION_QUALIFIER cubelib_##ELEMENT##_t                                                                \
+    cubelib_packed_##ELEMENT##_array_get(cubelib_packed_##ELEMENT##_array_t array, size_t i)                        \
+    {                                                                                                               \
+        assert(i < array.size);                                                                                     \
+        uint_fast8_t index = array.bits == 3 ? cubelib_packed3_get(array.bytes, i)                                  \
+                                             : cubelib_packed4_get(array.bytes, i);                                 \
+        return cubelib_get_##ELEMENT##_by_index(index);                                                             \
+    }                                                                                                               \
+                                                                                                                    \
+    CUBELIB_FUNCTION_QUALIFIER void                                                                                 \
+    cubelib_packed_##ELEMENT##_array_set(cubelib_packed_##ELEMENT##_array_t array, size_t i,                        \
+                                         cubelib_##ELEMENT##_t element)                                             \
+    {                                                                                                               \
+        assert(i < array.size);                                                                                     \
+        assert(!cubelib_is_##ELEMENT##_null(element));                                                              \
+        uint_fast8_t index = cubelib_get_##ELEMENT##_index(element);                                                \
+        if (array.bits == 3)                                                                                        \
+            cubelib_packed3_set(array.bytes, i, index);                                                             \
+        else                                                                                                        \
+            cubelib_packed4_set(array.bytes, i, index);                                                             \
+    }                                                                                                               \
+                                                                                                                    \
+    CUBELIB_FUNCTION_QUALIFIER void                                                                                 \
+    cubelib_packed_##ELEMENT##_array_pack(cubelib_packed_##ELEMENT##_array_t array,                                 \
+                                          const cubelib_##ELEMENT##_t* elements)                                    \
+    {                                                                                                               \
+        uint8_t indices[256];                                                                                       \
+        for (size_t first = 0; first < array.size; first += 256)                                                   \
+        {                                                                                                           \
+            size_t count = array.size - first < 256 ? array.size - first : 256;                                     \
+            for (size_t k = 0; k < count; ++k)                                                                      \
+            {                                                                                                       \
+                assert(!cubelib_is_##ELEMENT##_null(elements[first + k]));                                          \
+                indices[k] = (uint8_t)cubelib_get_##ELEMENT##_index(elements[first + k]);                           \
+            }                                                                                                       \
+            uint8_t* bytes = array.bytes + CUBELIB_PACKED_BYTES(first, array.bits);                                 \
+            if (array.bits == 3)                                                                                    \
+                cubelib_packed3_pack_n(indices, bytes, count);                                                      \
+            else                                                                                                    \
+                cubelib_packed4_pack_n(indices, bytes, count);                                                      \
+        }                                                                                                           \
+    }                                                                                                               \
+                                                                                                                    \
+    CUBELIB_FUNCTION_QUALIFIER void                                                                                 \
+    cubelib_packed_##ELEMENT##_array_unpack(cubelib_packed_##ELEMENT##_array_t array,                               \
+                                            cubelib_##ELEMENT##_t* elements)                                        \
+    {                                                                                                               \
+        uint8_t indices[256];                                                                                       \
+        for (size_t first = 0; first < array.size; first += 256)                                                    \
+        {                                                                                                           \
+            size_t count = array.size - first < 256 ? array.size - first : 256;                                     \
+            const uint8_t* bytes = array.bytes + CUBELIB_PACKED_BYTES(first, array.bits);                           \
+            if (array.bits == 3)                                                                                    \
+                cubelib_packed3_unpack_n(bytes, indices, count);                                                    \
+            else                                                                                                    \
+                cubelib_packed4_unpack_n(bytes, indices, count);                                                    \
+            for (size_t k = 0; k < count; ++k)                                                                      \
+                elements[first + k] = cubelib_get_##ELEMENT##_by_index(indices[k]);                                 \
+        }                                                                                                           \
+    }
+
+    CUBELIB_PACKED_ARRAY_DEFINE(corner)
+    CUBELIB_PACKED_ARRAY_DEFINE(direction)
+    CUBELIB_PACKED_ARRAY_DEFINE(edge)
+    CUBELIB_PACKED_ARRAY_DEFINE(face)
+
+#undef CUBELIB_PACKED_ARRAY_DEFINE
+
+
+    CUBELIB_FUNCTION_QUALIFIER cubelib_packed_corner_array_t cubelib_packed_corner_array(uint8_t* bytes, size_t size, uint_fast8_t bits)
+    {
+        assert(bits == 3 || bits == 4);
+        cubelib_packed_corner_array_t array = {bytes, size, bits};
+        return array;
+    }
+
+    CUBELIB_FUNCTION_QUALIFIER cubelib_packed_direction_array_t cubelib_packed_direction_array(uint8_t* bytes, size_t size, uint_fast8_t bits)
+    {
+        assert(bits == 3 || bits == 4);
+        cubelib_packed_direction_array_t array = {bytes, size, bits};
+        return array;
+    }
+
+    CUBELIB_FUNCTION_QUALIFIER cubelib_packed_edge_array_t cubelib_packed_edge_array(uint8_t* bytes, size_t size)
+    {
+        cubelib_packed_edge_array_t array = {bytes, size, 4};
+        return array;
+    }
+
+    CUBELIB_FUNCTION_QUALIFIER cubelib_packed_face_array_t cubelib_packed_face_array(uint8_t* bytes, size_t size, uint_fast8_t bits)
+    {
+        assert(bits == 3 || bits == 4);
+        cubelib_packed_face_array_t array = {bytes, size, bits};
+        return array;
+    }
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CORNER_CASES_CUBELIB_PACKED_INL_H
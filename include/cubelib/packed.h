@@ -0,0 +1,130 @@
+#ifndef CORNER_CASES_CUBELIB_PACKED_H
+#define CORNER_CASES_CUBELIB_PACKED_H 1
+
+
+#include "cubelib/cubelib.h"
+
+#ifndef __OPENCL_VERSION__
+    #include <stddef.h>
+    #include <stdint.h>
+#endif
+
+/**
+ * @addtogroup cubelib-packed-group Packed arrays
+ *
+ * Dense storage for large arrays of corners, directions, edges or faces, for annotating every node of an
+ * octree or every vertex of a mesh.
+ *
+ * An element is stored as its 0-based index (cubelib_get_corner_index() etc.), in one of two encodings:
+ *  * 4 bits: two elements per byte; element `i` is the low nibble of byte `i/2` if `i` is even, and the high
+ *      nibble otherwise. Works for every element type.
+ *  * 3 bits: eight elements per three bytes; element `i` is bits `3*(i%8)` through `3*(i%8)+2` of the little-endian
+ *      24 bit word at byte `3*(i/8)`. Only for corners, directions and faces (edges need 4 bits).
+ *
+ * Null elements cannot be stored. The storage is owned by the caller; use CUBELIB_PACKED_BYTES() to size it.
+ *
+ * The `cubelib_packed_*_n()` functions work on raw indices, one per byte, and use SSE2 (4 bit) or BMI2 (3 bit)
+ * when the compiler targets them. The typed arrays (e.g. cubelib_packed_corner_array_t) wrap the same storage for
+ * element access.
+ *  @{
+ */
+
+///@brief The number of bytes needed to store @p n elements with @p bits bits per element (3 or 4).
+///
+///3 bit storage is rounded up to whole groups of 8 elements (3 bytes).
+#define CUBELIB_PACKED_BYTES(n, bits) ((bits) == 3 ? (((n) + 7) / 8) * 3 : ((n) + 1) / 2)
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+    ///@brief Element @p i of 4 bit storage.
+    CUBELIB_FUNCTION_QUALIFIER uint_fast8_t cubelib_packed4_get(const uint8_t* bytes, size_t i);
+    ///@brief Sets element @p i of 4 bit storage to @p index (`< 16`).
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_packed4_set(uint8_t* bytes, size_t i, uint_fast8_t index);
+    ///@brief Element @p i of 3 bit storage.
+    CUBELIB_FUNCTION_QUALIFIER uint_fast8_t cubelib_packed3_get(const uint8_t* bytes, size_t i);
+    ///@brief Sets element @p i of 3 bit storage to @p index (`< 8`).
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_packed3_set(uint8_t* bytes, size_t i, uint_fast8_t index);
+
+    ///@brief Packs @p n indices into 4 bit storage, overwriting all CUBELIB_PACKED_BYTES(n, 4) bytes.
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_packed4_pack_n(const uint8_t* indices, uint8_t* bytes, size_t n);
+    ///@brief Unpacks the first @p n elements of 4 bit storage, one index per byte.
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_packed4_unpack_n(const uint8_t* bytes, uint8_t* indices, size_t n);
+    ///@brief Packs @p n indices into 3 bit storage, overwriting all CUBELIB_PACKED_BYTES(n, 3) bytes.
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_packed3_pack_n(const uint8_t* indices, uint8_t* bytes, size_t n);
+    ///@brief Unpacks the first @p n elements of 3 bit storage, one index per byte.
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_packed3_unpack_n(const uint8_t* bytes, uint8_t* indices, size_t n);
+
+
+    ///@brief A view of caller-owned packed storage, as an array of corners.
+    typedef struct cubelib_packed_corner_array_t{
+        uint8_t* bytes;
+        size_t size;
+        ///3 or 4
+        uint_fast8_t bits;
+    } cubelib_packed_corner_array_t;
+
+    ///@brief A view of caller-owned packed storage, as an array of directions.
+    typedef struct cubelib_packed_direction_array_t{
+        uint8_t* bytes;
+        size_t size;
+        ///3 or 4
+        uint_fast8_t bits;
+    } cubelib_packed_direction_array_t;
+
+    ///@brief A view of caller-owned packed storage, as an array of edges; always 4 bits per edge.
+    typedef struct cubelib_packed_edge_array_t{
+        uint8_t* bytes;
+        size_t size;
+        ///always 4
+        uint_fast8_t bits;
+    } cubelib_packed_edge_array_t;
+
+    ///@brief A view of caller-owned packed storage, as an array of faces.
+    typedef struct cubelib_packed_face_array_t{
+        uint8_t* bytes;
+        size_t size;
+        ///3 or 4
+        uint_fast8_t bits;
+    } cubelib_packed_face_array_t;
+
+    ///@brief Wraps @p bytes (at least CUBELIB_PACKED_BYTES(size, bits) of them) as an array of @p size corners.
+    CUBELIB_FUNCTION_QUALIFIER cubelib_packed_corner_array_t cubelib_packed_corner_array(uint8_t* bytes, size_t size, uint_fast8_t bits);
+    CUBELIB_FUNCTION_QUALIFIER cubelib_corner_t cubelib_packed_corner_array_get(cubelib_packed_corner_array_t array, size_t i);
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_packed_corner_array_set(cubelib_packed_corner_array_t array, size_t i, cubelib_corner_t corner);
+    ///@brief Overwrites the whole array with `corners[0 .. array.size)`.
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_packed_corner_array_pack(cubelib_packed_corner_array_t array, const cubelib_corner_t* corners);
+    ///@brief Copies the whole array out to `corners[0 .. array.size)`.
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_packed_corner_array_unpack(cubelib_packed_corner_array_t array, cubelib_corner_t* corners);
+
+    ///@brief Wraps @p bytes (at least CUBELIB_PACKED_BYTES(size, bits) of them) as an array of @p size directions.
+    CUBELIB_FUNCTION_QUALIFIER cubelib_packed_direction_array_t cubelib_packed_direction_array(uint8_t* bytes, size_t size, uint_fast8_t bits);
+    CUBELIB_FUNCTION_QUALIFIER cubelib_direction_t cubelib_packed_direction_array_get(cubelib_packed_direction_array_t array, size_t i);
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_packed_direction_array_set(cubelib_packed_direction_array_t array, size_t i, cubelib_direction_t direction);
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_packed_direction_array_pack(cubelib_packed_direction_array_t array, const cubelib_direction_t* directions);
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_packed_direction_array_unpack(cubelib_packed_direction_array_t array, cubelib_direction_t* directions);
+
+    ///@brief Wraps @p bytes (at least CUBELIB_PACKED_BYTES(size, 4) of them) as an array of @p size edges.
+    CUBELIB_FUNCTION_QUALIFIER cubelib_packed_edge_array_t cubelib_packed_edge_array(uint8_t* bytes, size_t size);
+    CUBELIB_FUNCTION_QUALIFIER cubelib_edge_t cubelib_packed_edge_array_get(cubelib_packed_edge_array_t array, size_t i);
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_packed_edge_array_set(cubelib_packed_edge_array_t array, size_t i, cubelib_edge_t edge);
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_packed_edge_array_pack(cubelib_packed_edge_array_t array, const cubelib_edge_t* edges);
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_packed_edge_array_unpack(cubelib_packed_edge_array_t array, cubelib_edge_t* edges);
+
+    ///@brief Wraps @p bytes (at least CUBELIB_PACKED_BYTES(size, bits) of them) as an array of @p size faces.
+    CUBELIB_FUNCTION_QUALIFIER cubelib_packed_face_array_t cubelib_packed_face_array(uint8_t* bytes, size_t size, uint_fast8_t bits);
+    CUBELIB_FUNCTION_QUALIFIER cubelib_face_t cubelib_packed_face_array_get(cubelib_packed_face_array_t array, size_t i);
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_packed_face_array_set(cubelib_packed_face_array_t array, size_t i, cubelib_face_t face);
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_packed_face_array_pack(cubelib_packed_face_array_t array, const cubelib_face_t* faces);
+    CUBELIB_FUNCTION_QUALIFIER void cubelib_packed_face_array_unpack(cubelib_packed_face_array_t array, cubelib_face_t* faces);
+
+#ifdef __cplusplus
+}
+#endif
+/** @} */ // end of group cubelib-packed-group
+
+
+#include "cubelib/detail/packed.inl.h"
+
+#endif // CORNER_CASES_CUBELIB_PACKED_H
@@ -0,0 +1,99 @@
+/*
+    Copyright (c) 2012 Azriel Fasten azriel.fasten@gmail.com
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef CORNER_CASES_CUBEXX_ASYMPTOTIC_DECIDER_HPP
+#define CORNER_CASES_CUBEXX_ASYMPTOTIC_DECIDER_HPP
+
+#include "cubexx/cubexx.hpp"
+#include "cubexx/marching_cubes.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+
+namespace cubexx{
+
+///@name Asymptotic decider
+/**
+ * A face is ambiguous when its inside corners are on a diagonal; the surface may either separate them (as the
+ * plain marching_cubes_triangle() tables always do) or connect them across the face. The bilinear interpolant on
+ * the face has a saddle, and the asymptotic decider connects the inside corners if the saddle is inside.
+ *
+ * Shifted by the isovalue, with `p`, `q` the values on the inside diagonal and `r`, `s` on the other, the saddle's
+ * value is `(pq - rs) / (p + q - r - s)`; the denominator is negative, so the saddle is inside exactly when
+ * `pq > rs`. The test is two products and a compare per face, with no division and no branches.
+ *
+ * The extended tables give a triangulation for every case and every choice of connected faces among its ambiguous
+ * ones; the connected faces of a case are ranked among its ambiguous ones to index them, so the tables only
+ * hold the combinations that can happen. Two cells sharing a face decide it from the same 4 values, so they agree
+ * on it and the surface stays watertight.
+ *
+ * No triangle side crosses a face of the cell, other than the face's own segments, so neighbors cannot cross or
+ * share sides there. Some of the long loops around a tunnel cannot be split into triangles that way; as in MC33,
+ * such a loop is fanned around a vertex inside the cell instead, which the triangles give as edge_t::null_edge().
+ * A cell has at most one; marching_cubes_center_edges() are the edges of its loop, and the mean of the points where
+ * the surface crosses them will do for its position.
+ */
+///@{
+
+///The ambiguous faces of case @p inside.
+constexpr face_set_t marching_cubes_ambiguous_faces(const corner_set_t& inside);
+
+/**
+ * @brief The ambiguous faces of case @p inside whose inside corners are connected, by the asymptotic decider.
+ *
+ * @p values are the values at the 8 corners, by corner_t::index().
+ */
+CORNER_CASES_CUBEXX_INLINE face_set_t asymptotic_decider(const corner_set_t& inside, const std::array<float, 8>& values,
+                                                         float isovalue);
+/**
+ * @brief asymptotic_decider() for a row of @p n cells along x; the rows of values and @p isovalue as for
+ *          marching_cubes_classify_row(), and @p cases as it writes them.
+ *
+ * The connected faces of cell `x` are written to `connected[x]`, as face_set_t::mask(). With SSE2, 4 cells at a time.
+ */
+CORNER_CASES_CUBEXX_INLINE void asymptotic_decider_row(const float* const* rows, std::size_t n, float isovalue,
+                                                       const std::uint8_t* cases, std::uint8_t* connected);
+
+///The most triangles any case has, with any connected faces.
+constexpr std::size_t marching_cubes_max_decided_triangles();
+///The number of triangles in case @p inside, with the ambiguous faces @p connected connecting the inside corners.
+constexpr std::size_t marching_cubes_triangle_count(const corner_set_t& inside, const face_set_t& connected);
+/**
+ * @brief The @p i-th triangle in case @p inside, with the ambiguous faces @p connected connecting the inside corners.
+ *
+ * A null edge stands for the vertex inside the cell.
+ */
+constexpr std::array<edge_t, 3> marching_cubes_triangle(const corner_set_t& inside, const face_set_t& connected,
+                                                        std::size_t i);
+///The edges of the loop fanned around the vertex inside the cell in case @p inside with @p connected; empty if none is.
+constexpr edge_set_t marching_cubes_center_edges(const corner_set_t& inside, const face_set_t& connected);
+///@}
+
+} // namespace cubexx
+
+#include "cubexx/detail/asymptotic_decider.inl.hpp"
+
+#endif // CORNER_CASES_CUBEXX_ASYMPTOTIC_DECIDER_HPP
@@ -0,0 +1,77 @@
+/*
+    Copyright (c) 2012 Azriel Fasten azriel.fasten@gmail.com
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef CORNER_CASES_CUBEXX_BALANCE_HPP
+#define CORNER_CASES_CUBEXX_BALANCE_HPP
+
+#include "cubexx/cubexx.hpp"
+#include "cubexx/morton.hpp"
+#include "cubexx/linear_octree.hpp"
+#include "cubexx/thread_pool.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+
+namespace cubexx{
+
+///Which leaves count as neighbors when balancing; each includes the ones before it.
+enum class adjacency_t
+{
+  ///Leaves sharing a face (across a direction_t).
+  face,
+  ///Leaves sharing a face or an edge (across an edge_t).
+  edge,
+  ///Leaves sharing a face, an edge or a corner (across a corner_t).
+  corner
+};
+
+/**
+ * @brief The coarsest refinement of @p octree in which leaves that are neighbors (by @p adjacency) differ by at most
+ *          one level; the 2:1 balance condition.
+ *
+ * A leaf that is split gives a copy of its value to each of the leaves it is split into. Parts of the root cell
+ * without leaves are left alone; they impose nothing, and are not filled in.
+ *
+ * The refinement ripples from the deepest level up, a level at a time, with no recursive work queue. For the
+ * leaves on level `L`, in parallel, the neighboring cells on level `L-1` that must not be inside a coarser leaf are
+ * collected; they are sorted (with a parallel radix sort) and deduplicated into a Morton ordered bucket, the leaf
+ * coarser than each is found by binary search, and the leaves are split, in parallel, just enough that each
+ * such cell becomes a leaf. The new leaves are all on level `L-1` or above, so the levels still to come take
+ * care of what they force in turn.
+ */
+template<typename T, std::size_t MaxDepth>
+linear_octree_t<T, MaxDepth> balance(const linear_octree_t<T, MaxDepth>& octree, adjacency_t adjacency,
+                                     thread_pool_t& pool);
+
+///Whether the leaves of @p octree that are neighbors (by @p adjacency) differ by at most one level.
+template<typename T, std::size_t MaxDepth>
+bool is_balanced(const linear_octree_t<T, MaxDepth>& octree, adjacency_t adjacency);
+
+} // namespace cubexx
+
+#include "cubexx/detail/balance.inl.hpp"
+
+#endif // CORNER_CASES_CUBEXX_BALANCE_HPP
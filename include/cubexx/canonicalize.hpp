@@ -0,0 +1,83 @@
+/*
+    Copyright (c) 2012 Azriel Fasten azriel.fasten@gmail.com
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef CORNER_CASES_CUBEXX_CANONICALIZE_HPP
+#define CORNER_CASES_CUBEXX_CANONICALIZE_HPP
+
+#include "cubexx/cubexx.hpp"
+#include "cubexx/cube_symmetry.hpp"
+
+#include <cstdint>
+#include <cstddef>
+
+
+namespace cubexx{
+
+///The group of symmetries that canonicalize() reduces by.
+enum class cube_symmetry_group_t
+{
+  ///The 24 rotations; see cube_symmetry_t::is_rotation().
+  rotations,
+  ///All 48 symmetries, rotations and reflections.
+  all
+};
+
+/**
+ * @brief A set in its canonical form, and the symmetry that takes it there.
+ *
+ * @param set_t
+ *          corner_set_t, edge_set_t or face_set_t.
+ */
+template<typename set_t>
+struct canonical_form_t
+{
+  ///The canonical representative of the set's orbit.
+  set_t set;
+  ///A symmetry (the lowest indexed one) taking the original set to @p set; its inverse() takes it back.
+  cube_symmetry_t symmetry;
+};
+
+///@name Canonical forms
+/**
+ * The canonical form of a set is the one with the lowest mask() among its images under a group of symmetries;
+ * so two sets have the same canonical form exactly when a symmetry of the group takes one to the other. There are
+ * 23 canonical corner_set_t under the rotations (22 with reflections), 218 edge_set_t (144) and 10 face_set_t (10).
+ *
+ * Each is a lookup in a table computed at compile time, from the cube_symmetry_t tables; 256 entries per group
+ * for corner_set_t, 4096 for edge_set_t and 64 for face_set_t.
+ */
+///@{
+constexpr canonical_form_t<corner_set_t> canonicalize(const corner_set_t& corners,
+                                                      cube_symmetry_group_t group = cube_symmetry_group_t::rotations);
+constexpr canonical_form_t<edge_set_t> canonicalize(const edge_set_t& edges,
+                                                    cube_symmetry_group_t group = cube_symmetry_group_t::rotations);
+constexpr canonical_form_t<face_set_t> canonicalize(const face_set_t& faces,
+                                                    cube_symmetry_group_t group = cube_symmetry_group_t::rotations);
+///@}
+
+} // namespace cubexx
+
+#include "cubexx/detail/canonicalize.inl.hpp"
+
+#endif // CORNER_CASES_CUBEXX_CANONICALIZE_HPP
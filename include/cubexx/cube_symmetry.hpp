@@ -0,0 +1,121 @@
+/*
+    Copyright (c) 2012 Azriel Fasten azriel.fasten@gmail.com
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef CORNER_CASES_CUBEXX_CUBE_SYMMETRY_HPP
+#define CORNER_CASES_CUBEXX_CUBE_SYMMETRY_HPP
+
+#include "cubexx/cubexx.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+
+namespace cubexx{
+
+namespace detail{
+
+///Builds the precomputed symmetry tables at compile time.
+struct cube_symmetry_builder_t;
+
+} // namespace detail
+
+/**
+ * @class cube_symmetry_t
+ * @brief One of the 48 symmetries of the cube: the 24 rotations, and the 24 rotations combined with a reflection.
+ *
+ * A symmetry is a signed permutation of the axes; it takes the positive x, y and z directions to three
+ * perpendicular directions (see get(const direction_t&, const direction_t&, const direction_t&)), and every
+ * element of the cube along with them.
+ *
+ * It is stored in a single byte, the index(); every transform is a lookup in a table precomputed at compile time:
+ * a permutation for each kind of element, a 256-entry table per symmetry for corner_set_t, a 4096-entry one for
+ * edge_set_t, and a 64-entry one for face_set_t and direction_set_t. Composition and inverses are tables too.
+ */
+struct cube_symmetry_t
+{
+  ///The identity.
+  constexpr cube_symmetry_t();
+
+  /**
+   * @brief The symmetry that takes the positive x, y and z directions to @p x, @p y and @p z respectively.
+   *
+   * The three must be perpendicular; if their handedness is reversed, the symmetry is a reflection.
+   */
+  static constexpr cube_symmetry_t get(const direction_t& x, const direction_t& y, const direction_t& z);
+  ///Return the symmetry represented by an index.
+  ///@see index()
+  static constexpr cube_symmetry_t get(std::uint_fast8_t idx);
+  ///All 48 symmetries, by index(); the first is the identity.
+  static constexpr const std::array<cube_symmetry_t, 48>& all();
+  static constexpr cube_symmetry_t identity();
+
+  ///Returns true if this is a rotation; false if it is a reflection (it reverses handedness).
+  constexpr bool is_rotation() const;
+  ///The symmetry that undoes this one.
+  constexpr cube_symmetry_t inverse() const;
+  ///The composition; applies @p other, then this.
+  constexpr cube_symmetry_t operator*(const cube_symmetry_t& other) const;
+
+  ///@name Transforms
+  ///@{
+  constexpr const corner_t& operator()(const corner_t& corner) const;
+  constexpr const edge_t& operator()(const edge_t& edge) const;
+  constexpr const face_t& operator()(const face_t& face) const;
+  constexpr const direction_t& operator()(const direction_t& direction) const;
+  constexpr corner_set_t operator()(const corner_set_t& corners) const;
+  constexpr edge_set_t operator()(const edge_set_t& edges) const;
+  constexpr face_set_t operator()(const face_set_t& faces) const;
+  constexpr direction_set_t operator()(const direction_set_t& directions) const;
+  ///@}
+
+  ///Retrieve a numeric 0-based index for the symmetry, less than SIZE(); the identity is 0.
+  ///@see get(std::uint_fast8_t idx)
+  constexpr std::uint_fast8_t index() const;
+  ///Comparison
+  constexpr bool operator<(const cube_symmetry_t& other) const;
+  ///Comparison
+  constexpr bool operator==(const cube_symmetry_t& other) const;
+  ///Comparison
+  constexpr bool operator!=(const cube_symmetry_t& other) const;
+
+  ///Number of symmetries.
+  CORNER_CASES_CUBEXX_INLINE static constexpr std::size_t SIZE(){ return 48; }
+private:
+  friend struct detail::cube_symmetry_builder_t;
+
+  /**
+   * 8 times the index of the permutation of the axes (among the 6, in lexicographic order of the axes that x, y
+   * and z go to), plus a bit per axis that is set if the axis goes to a negative direction.
+   */
+  std::uint8_t mindex;
+
+  explicit constexpr cube_symmetry_t(std::uint8_t idx);
+};
+
+} // namespace cubexx
+
+#include "cubexx/detail/cube_symmetry.inl.hpp"
+
+#endif // CORNER_CASES_CUBEXX_CUBE_SYMMETRY_HPP
@@ -36,6 +36,12 @@
 #include <cstddef>
 #include <iterator>
 #include <memory>
+#include <utility>
+#include <algorithm>
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
 
 
 namespace cubexx{
@@ -57,42 +63,104 @@ struct cube_t;
 
 namespace detail{
 CORNER_CASES_CUBEXX_INLINE
-bool lxor(const bool& a, const bool& b)
+constexpr bool lxor(const bool& a, const bool& b)
 {
   return !a != !b;
 }
 
 CORNER_CASES_CUBEXX_INLINE
-bool liff(const bool& a, const bool& b)
+constexpr bool liff(const bool& a, const bool& b)
 {
   return ( (a && b) || (!a && !b) );
 }
 
 
 CORNER_CASES_CUBEXX_INLINE
-bool lif(const bool& a, const bool& b)
+constexpr bool lif(const bool& a, const bool& b)
 {
   return (!a || b);
 }
 
 CORNER_CASES_CUBEXX_INLINE
-bool lnand(const bool& a, const bool& b)
+constexpr bool lnand(const bool& a, const bool& b)
 {
   return !(a && b);
 }
 
 
-template<std::size_t N>
+template<typename T>
+CORNER_CASES_CUBEXX_INLINE
+constexpr bool has_exactly_one_bit(const T& v)
+{
+  return v != 0 && (v & (v - 1)) == 0;
+}
+
+///The number of set bits in @p v.
+template<typename T>
+CORNER_CASES_CUBEXX_INLINE
+constexpr std::size_t popcount(T v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return std::size_t(__builtin_popcountll(static_cast<unsigned long long>(v)));
+#else
+  std::size_t result = 0;
+  for (; v != 0; v &= v - 1)
+    ++result;
+  return result;
+#endif
+}
+
+///The index of the lowest set bit in @p v; @p v must not be 0.
+template<typename T>
+CORNER_CASES_CUBEXX_INLINE
+constexpr std::size_t countr_zero(T v)
+{
+  assert(v != 0);
+#if defined(__GNUC__) || defined(__clang__)
+  return std::size_t(__builtin_ctzll(static_cast<unsigned long long>(v)));
+#else
+  std::size_t result = 0;
+  for (; (v & 1) == 0; v >>= 1)
+    ++result;
+  return result;
+#endif
+}
+
+///The number of bits needed to represent @p v, i.e. one past the index of the highest set bit; 0 for 0.
+template<typename T>
+CORNER_CASES_CUBEXX_INLINE
+constexpr std::size_t bit_width(T v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return v == 0 ? 0 : 64 - std::size_t(__builtin_clzll(static_cast<unsigned long long>(v)));
+#else
+  std::size_t result = 0;
+  for (; v != 0; v >>= 1)
+    ++result;
+  return result;
+#endif
+}
+
+///The index of the @p k-th (0-based, from the lowest) set bit in @p v; @p v must have
+/// more than @p k bits set. Uses BMI2's pdep when the target has it.
+template<typename T>
 CORNER_CASES_CUBEXX_INLINE
-bool has_exactly_one_bit(const std::bitset<N>& v)
+std::size_t select_bit(T v, std::size_t k)
 {
-  return v.count() == 1;
+  assert(k < popcount(v));
+#if defined(__BMI2__) && (defined(__x86_64__) || defined(_M_X64))
+  return countr_zero(_pdep_u64(std::uint64_t(1) << k, static_cast<std::uint64_t>(v)));
+#else
+  for (; k != 0; --k)
+    v &= v - 1;
+  return countr_zero(v);
+#endif
 }
 
 
 template<typename T>
 CORNER_CASES_CUBEXX_INLINE
-T clamp(const T& v, const T& a, const T& b)
+constexpr T clamp(const T& v, const T& a, const T& b)
 {
     return std::max(std::min(v, b), a);
 }
@@ -107,12 +175,55 @@ T safemod(const T& v, const T& modulo)
 
 template<typename T>
 CORNER_CASES_CUBEXX_INLINE
-T wrap_around_2(const T& v)
+constexpr T wrap_around_2(const T& v)
 {
     return v > 1 ? -1 : (v < -1 ? +1 : v);
 }
 
 
+///The smallest unsigned integer type with at least @p N bits.
+template<std::size_t N>
+struct uint_least_bits_t
+{
+  static_assert(N <= 64, "no unsigned integer type is wide enough");
+  typedef typename std::conditional<(N <= 8), std::uint8_t,
+            typename std::conditional<(N <= 16), std::uint16_t,
+              typename std::conditional<(N <= 32), std::uint32_t, std::uint64_t>::type
+            >::type
+          >::type type;
+};
+
+template<typename T, typename element_t>
+struct is_element_range
+{
+private:
+  template<typename U>
+  static auto test(int)
+    -> typename std::is_convertible<decltype(*std::begin(std::declval<const U&>())), const element_t&>::type;
+  template<typename U>
+  static std::false_type test(...);
+public:
+  typedef decltype(test<T>(0)) type;
+};
+
+///Is @p T something a set of @p element_t can be built from; either a single element,
+/// or a range of elements. Keeps the converting constructors of the sets from
+/// swallowing unrelated types (such as their own iterators).
+template<typename T, typename element_t>
+struct is_element_source
+  : std::integral_constant<bool,
+                           std::is_convertible<const T&, const element_t&>::value
+                           || is_element_range<T, element_t>::type::value>
+{};
+
+///Builds the precomputed topology tables at compile time; see topology_tables_t.
+struct topology_builder_t;
+
+///Holds the precomputed (constexpr) topology tables; a template only so that the
+/// static members can live in the header.
+template<typename T = void>
+struct topology_tables_t;
+
 } // namespace detail
 
 
@@ -128,26 +239,15 @@ T wrap_around_2(const T& v)
  *          The type of the set that this is an iterator for; as an example, for the iterator
  *          returned by corner_set_t::begin(), this would be of type corner_set_t.
  * 
- * Note that changing the underlying set can invalidate the iterator.
+ * The iterator holds a copy of the elements of the set that it has not yet visited, as a bit mask;
+ * it does not refer back to the set. Dereferencing takes the lowest set bit (count trailing zeros),
+ * and incrementing clears it. Changing the underlying set therefore does not invalidate the
+ * iterator, but the iterator will not see the change either.
  *
- * Note that there are few states an iterator can be in.
- * * Default constructed
- *   * Not associated with any container.
- *   * Only the assignment operation is valid.
- * * Valid
- *   * Associated with a container
- *   * In this state, an iterator is either also "dereferencable" or is the end() iterator
- * * Invalid
- *   * Associated with a container
- *   * Does not represent any item in the container, and cannot be used, it must be discarded. Using such
- *      an iterator (other than assignment operations) leads to undefined behaviour.
- *   * In this state, the iterator is certainly not "dereferencable".
- *   * Such an iterator can result from changing the underlying set after obtaining the iterator.
- * * Dereferencable
- *   * Associated with a container
- *   * Valid
- *   * The iterator is *not* equivalent to end().
- *   * In this state the iterator represents an item in the container, and the item may be retrieved.
+ * Two iterators are equal if they have the same elements left to visit; so every iterator that has
+ * run off the end of its set is equal to end(). Comparing iterators of different sets is otherwise
+ * meaningless. A default constructed iterator is not associated with any set, and is not equal to
+ * any iterator (not even itself); only assignment is valid on it.
  */
 template<typename value_type, typename set_type>
 struct const_element_set_iterator_t
@@ -160,65 +260,33 @@ private:
   template<typename V, typename S>
   friend struct const_element_set_iterator_t;
   
-  ///we will use this later for enable_if (google SFINAE), see below
-  struct enabler {};  // a private type avoids misuse
-    public:
+public:
+  ///Wide enough for one bit past the last element, which marks a default constructed iterator.
+  typedef typename detail::uint_least_bits_t<value_type::SIZE() + 1>::type mask_type;
 
   /**
    * @brief Default constructor; it is not a "valid" iterator, because it is not associated
    *        with a particular set.
    */
   CORNER_CASES_CUBEXX_INLINE
-  const_element_set_iterator_t()
-    : mset(NULL), mindex(value_type::SIZE())
+  constexpr const_element_set_iterator_t()
+    : mbits(singular())
   {
     
   }
   
   
   /**
-   * @brief Constructor, associates the iterator with a set; it finds the first
-   *            valid item in the set, and represents that item; otherwise it
-   *            represents set_type_t::end().
-   * @param set the set this iterator is to be associated with.
-   * @return A valid iterator, though not necessarily dereferencable if the
-   *        set is empty, as it will be equal to set_type_t::end().
+   * @brief Constructor, from the bits of the elements that remain to be visited; the iterator
+   *        represents the element with the lowest bit, or end() if @p bits is 0.
+   * @param bits the bit representation of the remaining elements (see set_base_t::mask()).
    */
   CORNER_CASES_CUBEXX_INLINE
-  const_element_set_iterator_t(set_type* set)
-    : mset(set), mindex(0)
+  explicit constexpr const_element_set_iterator_t(mask_type bits)
+    : mbits(bits)
   {
+    assert(bits != singular());
     
-    while (mindex < value_type::SIZE())
-    {
-      if (mset->contains(mindex))
-      {
-        break;
-      }
-      ++mindex;
-    }
-    
-    assert(valid());
-    assert(dereferencable() || mindex == value_type::SIZE());
-    
-  }
-
-  /**
-   * @brief Constructor, with explicit index; this allows the caller to
-   *        set the iterator to point to a specific bit in the underlying bitset representation
-   *        of the set. Alternatively, it can point to `SIZE` of the bitset, which indicates a
-   *        non-dereferencable iterator (end()). Note that if index != SIZE, this bit *must* be set;
-   *        in other words, the set *must* contain this item.
-   * @param set the set this iterator is to be associated with.
-   * @param index the specific bit in the underlying bitset representation that this iterator will represent,
-   *        or be equal to `SIZE`, the size of the underlying bitset, to represent and end() iterator.
-   * @return An iterator pointing at the item represented by index.
-   */
-  CORNER_CASES_CUBEXX_INLINE
-  const_element_set_iterator_t(set_type* set, std::size_t index)
-    : mset(set), mindex(index)
-  {
-    assert(valid());
   }
   
   /**
@@ -228,92 +296,54 @@ private:
    */
   template <class OtherValue, class OtherSet>
   CORNER_CASES_CUBEXX_INLINE
-  const_element_set_iterator_t(
+  constexpr const_element_set_iterator_t(
       const const_element_set_iterator_t<OtherValue, OtherSet>& other
     )
-    : mset(other.mset), mindex(other.mindex)
+    : mbits(other.mbits)
   {
     
-    static_assert( std::is_convertible< OtherValue*,value_type >::value
+    static_assert( std::is_convertible< OtherValue*,value_type* >::value
                 , "Converting iterator with non-convertible value type;"
                   " prolly trying to convert a const iterator with a const value type to a non-const iterator" );
-    static_assert( std::is_convertible< OtherSet*,set_type >::value
+    static_assert( std::is_convertible< OtherSet*,set_type* >::value
                 , "Converting iterator with non-convertible container type;"
                   " prolly trying to convert a const iterator with a const value type to a non-const iterator" );
     
   }
-  /*
-  template <class OtherValue, class OtherSet>
-  CORNER_CASES_CUBEXX_INLINE
-  const_element_set_iterator_t(
-      const const_element_set_iterator_t<OtherValue, OtherSet>& other
-    , typename std::enable_if< std::is_convertible<OtherValue*,value_type*>::value, enabler>::type = enabler()
-    )
-    : mset(other.mset), mindex(other.mindex)
-  {
-    
-    
-  }
-   */
 
   /**
-   * @brief Assignment.
-   * @param other the other iterator
-   * 
-   * After being assigned, this iterator will point to the same set, and the same item in the set as
-   * @p other.
-   */
-  template<typename T>
-  CORNER_CASES_CUBEXX_INLINE
-  const_element_set_iterator_t& operator=(const T& other)
-  {
-    assign(other);
-    return *this;
-  }
-
-  /**
-   * @brief Iterator dereference. Note, calling this on end() or an invalid iterator is an error (undefined behavior).
+   * @brief Iterator dereference. Note, calling this on end() is an error (undefined behavior).
    * @return The value represented.
    */
   CORNER_CASES_CUBEXX_INLINE
-  const value_type& operator*() const {
-    assert(valid());
-    assert(dereferencable());
-    return value_type::get(mindex);
+  constexpr const value_type& operator*() const {
+    assert(mbits != 0);
+    return value_type::get(index());
   }
   
   /**
-   * @brief Iterator dereference. Note, calling this on end() or an invalid iterator is an error (undefined behavior).
+   * @brief Iterator dereference. Note, calling this on end() is an error (undefined behavior).
    * @return The value represented.
    */
   CORNER_CASES_CUBEXX_INLINE
-  const value_type* operator->() const {
-    assert(valid());
-    assert(dereferencable());
-    return &value_type::get(mindex);
+  constexpr const value_type* operator->() const {
+    assert(mbits != 0);
+    return &value_type::get(index());
   }
   
   
   
   /**
-   * @brief Equality test; tests that the other iterator points to the same set, and the same item in the set
-   *            (or if they are both end() of the same set). Note that invalid iterators are never equal.
+   * @brief Equality test; tests that the iterators have the same elements left to visit.
+   *            Note that default constructed iterators are never equal.
    * @param other compare this to other.
    * @return true if they are equal.
    */
   template <class OtherValue, class OtherSet>
   CORNER_CASES_CUBEXX_INLINE
-  bool operator==(const const_element_set_iterator_t<OtherValue, OtherSet>& other) const
+  constexpr bool operator==(const const_element_set_iterator_t<OtherValue, OtherSet>& other) const
   {
-    return
-      ///Invalid iterators are never equal.
-      this->mset != nullptr
-      ///The two iterators are referring to the same set
-      && (this->mset == other.mset
-        ///Or one of them is a default constructed iterator
-        || ( this->mset == NULL || other.mset == NULL ))
-      ///And the indices are equal
-      && this->mindex == other.mindex;
+    return this->mbits == other.mbits && this->mbits != singular();
   }
   
   /**
@@ -324,7 +354,7 @@ private:
    */
   template <class OtherValue, class OtherSet>
   CORNER_CASES_CUBEXX_INLINE
-  bool operator!=(const const_element_set_iterator_t<OtherValue, OtherSet>& other) const
+  constexpr bool operator!=(const const_element_set_iterator_t<OtherValue, OtherSet>& other) const
   {
     return !(*this == other);
   }
@@ -332,89 +362,46 @@ private:
   /**
    * @brief Regular iterator pre-increment.
    */
-  const_element_set_iterator_t& operator++() {
-    increment();
+  CORNER_CASES_CUBEXX_INLINE
+  constexpr const_element_set_iterator_t& operator++() {
+    assert(mbits != 0);
+    assert(mbits != singular());
+    mbits &= mbits - 1;
     return *this;
   }
   
   /**
    * @brief Regular iterator post-increment.
    */
-  const_element_set_iterator_t operator++(int) {
+  CORNER_CASES_CUBEXX_INLINE
+  constexpr const_element_set_iterator_t operator++(int) {
     const_element_set_iterator_t result(*this);
-    increment();
+    ++*this;
     return result;
   }
   
 private:
   /**
-   * @brief internal self increment.
+   * @brief The index of the element represented; the lowest remaining bit.
    */
   CORNER_CASES_CUBEXX_INLINE
-  void increment() {
-    assert(valid());
-      assert(mset);
-      assert(mindex != value_type::SIZE());
-      assert(mset->contains(mindex));
-    assert(dereferencable());
-    
-    ++mindex;
-      
-    while (mindex < value_type::SIZE() && !dereferencable())
-      ++mindex;
-    
-    assert(valid());
+  constexpr std::size_t index() const{
+    assert(mbits != singular());
+    return detail::countr_zero(mbits);
   }
   
-private:
   /**
-   * @brief tests if an iterator is valid; an iterator is valid if it is associated with a set,
-   *        and {represents an item in the set, or represents the end() iterator}.
-   * @see dereferencable()
+   * @brief The bits of a default constructed iterator.
    */
   CORNER_CASES_CUBEXX_INLINE
-  bool valid() const{
-    return
-      mset != nullptr &&
-      mindex <= value_type::SIZE() &&
-      ///If not an end iterator, mset should be set, and mindex should be contained in it
-      (mindex == value_type::SIZE() || mset->contains(mindex));
+  static constexpr mask_type singular(){
+    return mask_type(mask_type(1) << value_type::SIZE());
   }
   
   /**
-   * @brief tests if an iterator is dereferencable; an iterator is dereferencable if
-   *        it is valid (see valid()) and does *NOT* represent end().
-   * @return 
-   * @see valid()
+   * The elements not yet visited, including the one currently represented.
    */
-  CORNER_CASES_CUBEXX_INLINE
-  bool dereferencable() const{
-    return valid() && mindex != value_type::SIZE() && mset->contains(mindex);
-  }
-  
-  /**
-   * @brief Internal assignment.
-   * @param other the iterator to assign from.
-   */
-  template <class OtherValue, class OtherSet>
-  CORNER_CASES_CUBEXX_INLINE
-  void
-  assign(const_element_set_iterator_t<OtherValue, OtherSet> const& other,
-            typename std::enable_if< std::is_convertible<OtherValue*,value_type*>::value, enabler >::type = enabler() )
-  {
-    mset = other.mset;
-    mindex = other.mindex;
-  }
-  
-  
-  /**
-   * Pointer to the representative set or nullptr if defaultconstructed.
-   */
-  set_type* mset;
-  /**
-   * Position of the iterator within the bitset/container.
-   */
-  std::size_t mindex;
+  mask_type mbits;
   
 };
 
@@ -432,6 +419,9 @@ private:
 template<typename derived_t, typename element_t, std::size_t N>
 struct set_base_t
 {
+  ///The unsigned integer type holding the bit representation of the set.
+  typedef typename detail::uint_least_bits_t<N>::type mask_type;
+  
   typedef element_t value_type;
   typedef value_type& reference;
   typedef const value_type& const_reference;
@@ -440,14 +430,15 @@ struct set_base_t
   typedef const_iterator iterator;
   
   ///Return an iterator to the first element in the set.
-  const_iterator begin() const;
-  ///Return an invalid iterator that points to one past the last element in the set.
-  const_iterator end() const;
+  constexpr const_iterator begin() const;
+  ///Return an iterator that points to one past the last element in the set.
+  constexpr const_iterator end() const;
   
   
-  ///Construct the set from any Sequence.
-  template<typename Sequence>
-  set_base_t(const Sequence& sequence);
+  ///Construct the set from any Sequence, or from a single element.
+  template<typename Sequence
+          , typename = typename std::enable_if< detail::is_element_source<Sequence, element_t>::value >::type>
+  constexpr set_base_t(const Sequence& sequence);
   ///Constructs the set from the range range [first, last).
   template<typename LeftIterator, typename RightIterator>
   set_base_t(LeftIterator first, RightIterator last);
@@ -457,91 +448,111 @@ struct set_base_t
   set_base_t(const derived_t& set);
   
   ///Default constructor.
-  set_base_t();
+  constexpr set_base_t();
   
   ///Assignment from any sequence.
   template<typename Sequence>
   derived_t& operator=(const Sequence& sequence);
   ///Assignment from a single element.
-  derived_t& operator=(const element_t& element);
+  constexpr derived_t& operator=(const element_t& element);
   ///Assignment from another set.
-  derived_t& operator=(const derived_t& set);
+  constexpr derived_t& operator=(const derived_t& set);
   
   ///Union with any sequence of elements.
   template<typename Sequence>
-  derived_t& operator|=(const Sequence& sequence);
+  constexpr derived_t& operator|=(const Sequence& sequence);
   ///Union with another set.
-  derived_t& operator|=(const derived_t& set);
+  constexpr derived_t& operator|=(const derived_t& set);
   ///Insertion of an element.
-  derived_t& operator|=(const element_t& element);
+  constexpr derived_t& operator|=(const element_t& element);
   
   ///Union with any sequence of elements (returns the modified set).
   template<typename Sequence>
-  derived_t operator|(const Sequence& sequence) const;
+  constexpr derived_t operator|(const Sequence& sequence) const;
   ///Union with another set (returns the modified set).
-  derived_t operator|(const derived_t& set) const;
+  constexpr derived_t operator|(const derived_t& set) const;
   ///Insertion of an element (returns the modified set).
-  derived_t operator|(const element_t& element) const;
+  constexpr derived_t operator|(const element_t& element) const;
   
   ///Set difference, with any sequence.
   template<typename Sequence>
-  derived_t& operator-=(const Sequence& sequence);
+  constexpr derived_t& operator-=(const Sequence& sequence);
   ///Set difference.
-  derived_t& operator-=(const derived_t& set);
+  constexpr derived_t& operator-=(const derived_t& set);
   ///Erasure of an element from a set.
-  derived_t& operator-=(const element_t& element);
+  constexpr derived_t& operator-=(const element_t& element);
   
   ///Set difference, with any sequence (returns the modified set).
   template<typename Sequence>
-  derived_t operator-(const Sequence& sequence) const;
+  constexpr derived_t operator-(const Sequence& sequence) const;
   ///Set difference (returns the modified set).
-  derived_t operator-(const derived_t& set) const;
+  constexpr derived_t operator-(const derived_t& set) const;
   ///Erasure of an element from a set (returns the modified set).
-  derived_t operator-(const element_t& element) const;
+  constexpr derived_t operator-(const element_t& element) const;
   
   ///Set intersection, with any sequence.
   template<typename Sequence>
-  derived_t& operator&=(const Sequence& sequence);
+  constexpr derived_t& operator&=(const Sequence& sequence);
   ///Set intersection.
-  derived_t& operator&=(const derived_t& set);
+  constexpr derived_t& operator&=(const derived_t& set);
   ///Set intersection with a single element).
-  derived_t& operator&=(const element_t& element);
+  constexpr derived_t& operator&=(const element_t& element);
   
   ///Set intersection, with any sequence (returns the modified set).
   template<typename Sequence>
-  derived_t operator&(const Sequence& sequence) const;
+  constexpr derived_t operator&(const Sequence& sequence) const;
   ///Set intersection (returns the modified set).
-  derived_t operator&(const derived_t& set) const;
+  constexpr derived_t operator&(const derived_t& set) const;
   ///Set intersection with a single element (returns the modified set).
-  derived_t operator&(const element_t& element) const;
+  constexpr derived_t operator&(const element_t& element) const;
+  
+  ///Set complement; every element that is not in this set.
+  constexpr derived_t operator~() const;
   
   
   ///Membership test.
-  bool contains(const element_t& element) const;
+  constexpr bool contains(const element_t& element) const;
   ///Membership test, by element index (within its type).
-  bool contains(const std::size_t& idx) const;
+  constexpr bool contains(const std::size_t& idx) const;
   
   ///Returns the size of the set.
-  std::size_t size() const;
+  constexpr std::size_t size() const;
+  ///Returns true if the set has no elements.
+  constexpr bool empty() const;
+  
+  ///Returns the element with the lowest index; the set must not be empty.
+  constexpr const element_t& first() const;
+  ///Returns the @p k-th element (0-based, in index order); @p k must be less than size().
+  const element_t& nth(std::size_t k) const;
   
   ///Clears the set.
-  void clear();
+  constexpr void clear();
   
   ///Comparison.
-  bool operator==(const derived_t& other) const;
+  constexpr bool operator==(const derived_t& other) const;
   ///Comparison.
-  bool operator!=(const derived_t& other) const;
+  constexpr bool operator!=(const derived_t& other) const;
   
   ///Return the bit representation of the set; the bit at each element's index will be set
   /// to 1 if the set contains the element, or 0 if the set does not contain the element.
-  const std::bitset<N>& bits() const;
+  constexpr std::bitset<N> bits() const;
+  ///Return the bit representation of the set as an integer; see bits().
+  constexpr mask_type mask() const;
+  ///Construct a set from its bit representation; see mask().
+  static constexpr derived_t from_mask(mask_type mask);
 private:
+  constexpr derived_t& self();
+  constexpr const derived_t& self() const;
   
+  static constexpr mask_type bit(std::size_t idx);
+  ///The bits of every element.
+  static constexpr mask_type full_mask();
   
-  derived_t& self();
-  const derived_t& self() const;
+  constexpr void insert(const element_t& element);
+  template<typename Sequence>
+  constexpr void insert(const Sequence& sequence);
   
-  std::bitset<N> mbits;
+  mask_type mbits;
 };
 
 struct corner_set_t : public set_base_t<corner_set_t, corner_t, 8>
@@ -549,9 +560,10 @@ struct corner_set_t : public set_base_t<corner_set_t, corner_t, 8>
   typedef corner_set_t self_t;
   typedef set_base_t<corner_set_t, corner_t, 8> base_t;
   
-  template<typename T>
-  corner_set_t(const T& v);
-  corner_set_t();
+  template<typename T
+          , typename = typename std::enable_if< detail::is_element_source<T, corner_t>::value >::type>
+  constexpr corner_set_t(const T& v);
+  constexpr corner_set_t();
   
 };
 
@@ -560,9 +572,10 @@ struct face_set_t : public set_base_t<face_set_t, face_t, 6>
   typedef face_set_t self_t;
   typedef set_base_t<face_set_t, face_t, 6> base_t;
   
-  template<typename T>
-  face_set_t(const T& v);
-  face_set_t();
+  template<typename T
+          , typename = typename std::enable_if< detail::is_element_source<T, face_t>::value >::type>
+  constexpr face_set_t(const T& v);
+  constexpr face_set_t();
   
 };
 
@@ -572,9 +585,10 @@ struct direction_set_t : public set_base_t<direction_set_t, direction_t, 6>
   typedef direction_set_t self_t;
   typedef set_base_t<direction_set_t, direction_t, 6> base_t;
   
-  template<typename T>
-  direction_set_t(const T& v);
-  direction_set_t();
+  template<typename T
+          , typename = typename std::enable_if< detail::is_element_source<T, direction_t>::value >::type>
+  constexpr direction_set_t(const T& v);
+  constexpr direction_set_t();
   
 };
 
@@ -586,9 +600,10 @@ struct edge_set_t : public set_base_t<edge_set_t, edge_t, 12>
   typedef edge_set_t self_t;
   typedef set_base_t<edge_set_t, edge_t, 12> base_t;
   
-  template<typename T>
-  edge_set_t(const T& v);
-  edge_set_t();
+  template<typename T
+          , typename = typename std::enable_if< detail::is_element_source<T, edge_t>::value >::type>
+  constexpr edge_set_t(const T& v);
+  constexpr edge_set_t();
   
 };
 
@@ -606,58 +621,58 @@ struct edge_set_t : public set_base_t<edge_set_t, edge_t, 12>
 struct direction_t
 {
   ///Default constructs a "null" direction_t.
-  direction_t();
+  constexpr direction_t();
   
   ///Returns the equivalent face
-  const face_t& face() const;
+  constexpr const face_t& face() const;
   ///Returns the opposite direction
-  const direction_t& opposite() const;
+  constexpr const direction_t& opposite() const;
   ///Returns the four adjacent directions
-  const std::array<direction_t, 4>& adjacents() const;
+  constexpr const std::array<direction_t, 4>& adjacents() const;
   ///Return a direction_set_t containing the 4 adjacent directions.
-  const direction_set_t& adjacent_set() const;
+  constexpr const direction_set_t& adjacent_set() const;
   
   ///Returns a direction from a vector of 3 integer components; two of them must be 0, the third must be positive or negative
   /// in the dimension of the direction. For example, (0,0,+1) means a direction on the z-axis pointing along
   /// the positive length of the axis. While (-1,0,0) means a direction on the (negative) x-axis pointing toward
   /// the negative asymptote of the x-axis.
   ///@see x(), y(), z(), axis(), positive()
-  static const direction_t& get(std::int_fast8_t x, std::int_fast8_t y, std::int_fast8_t z);
+  static constexpr const direction_t& get(std::int_fast8_t x, std::int_fast8_t y, std::int_fast8_t z);
   ///Returns a direction given a direction.
-  static const direction_t& get(const direction_t& direction);
+  static constexpr const direction_t& get(const direction_t& direction);
   ///Return the direction represented by an index.
   ///@see index()
-  static const direction_t& get(std::uint_fast8_t idx);
+  static constexpr const direction_t& get(std::uint_fast8_t idx);
   ///Return a list of all the directions on the cube.
-  static const std::array<direction_t, 6>& all();
+  static constexpr const std::array<direction_t, 6>& all();
   
   ///Return the x component of the direction vector. See
   /// get(std::int_fast8_t,std::int_fast8_t,std::int_fast8_t) for more information.
   ///@see get(std::int_fast8_t,std::int_fast8_t,std::int_fast8_t), xyz()
-  std::int_fast8_t x() const;
+  constexpr std::int_fast8_t x() const;
   ///Return the y component of the direction vector. See
   /// get(std::int_fast8_t,std::int_fast8_t,std::int_fast8_t) for more information.
   ///@see get(std::int_fast8_t,std::int_fast8_t,std::int_fast8_t), xyz()
-  std::int_fast8_t y() const;
+  constexpr std::int_fast8_t y() const;
   ///Return the z component of the direction vector. See
   /// get(std::int_fast8_t,std::int_fast8_t,std::int_fast8_t) for more information.
   ///@see get(std::int_fast8_t,std::int_fast8_t,std::int_fast8_t), xyz()
-  std::int_fast8_t z() const;
+  constexpr std::int_fast8_t z() const;
   ///Returns true if the direction vector is positive; false if it is negative. See
   /// get(std::int_fast8_t,std::int_fast8_t,std::int_fast8_t) for more information.
   ///@see get(std::int_fast8_t,std::int_fast8_t,std::int_fast8_t), xyz()
   ///@see axis(), x(), y(), z(), xyz()
-  bool positive() const;
+  constexpr bool positive() const;
   ///@brief Returns a number \f$\in \left\{0,1,2\right\}\f$ representing the axis of the direction. See
   /// get(std::int_fast8_t,std::int_fast8_t,std::int_fast8_t) for more information.
   ///@see get(std::int_fast8_t,std::int_fast8_t,std::int_fast8_t)
   ///@see positive(), x(), y(), z(), xyz()
-  uint_fast8_t axis() const;
+  constexpr uint_fast8_t axis() const;
 
   ///Return all three components of the direction vector. See
   /// get(std::int_fast8_t,std::int_fast8_t,std::int_fast8_t) for more information.
   ///@see get(std::int_fast8_t,std::int_fast8_t,std::int_fast8_t), x(), y(), z()
-  const std::array<std::int_fast8_t,3>& xyz() const;
+  constexpr const std::array<std::int_fast8_t,3>& xyz() const;
   
   
   
@@ -665,30 +680,32 @@ struct direction_t
   /// when storing in a container requiring comparison. The index will be less than SIZE(). The "null" direction
   /// has no index, and it is illegal to call index() on it.
   ///@see get(std::uint_fast8_t idx)
-  std::uint_fast8_t index() const;
+  constexpr std::uint_fast8_t index() const;
   ///Comparison
-  bool operator<(const direction_t& other) const;
+  constexpr bool operator<(const direction_t& other) const;
   ///Comparison
-  bool operator==(const direction_t& other) const;
+  constexpr bool operator==(const direction_t& other) const;
   ///Comparison
-  bool operator!=(const direction_t& other) const;
+  constexpr bool operator!=(const direction_t& other) const;
   
   
   ///Returns true if this direction is a null direction_t.
-  bool is_null() const;
+  constexpr bool is_null() const;
   
-  bool is_sane() const;
+  constexpr bool is_sane() const;
   
   ///Returns a null direction.
-  static const direction_t& null_direction();
+  static constexpr const direction_t& null_direction();
   
   ///Number of directions.
-  CORNER_CASES_CUBEXX_INLINE static std::size_t SIZE(){ return 6; }
+  CORNER_CASES_CUBEXX_INLINE static constexpr std::size_t SIZE(){ return 6; }
 private:
-  std::bitset<3> mbits;
+  friend struct detail::topology_builder_t;
   
+  std::uint8_t mbits;
   
-  direction_t(const std::bitset<3>& bits);
+  
+  explicit constexpr direction_t(std::uint8_t bits);
 };
 
 /**
@@ -700,77 +717,77 @@ private:
  */
 struct face_t{
   ///Default construct a "null" face.
-  face_t();
+  constexpr face_t();
   
   ///Return the direction that is equivalent to this face.
-  const direction_t& direction() const;
+  constexpr const direction_t& direction() const;
   ///Return the opposite face.
-  const face_t& opposite() const;
+  constexpr const face_t& opposite() const;
   ///Return the 4 adjacent faces
-  const std::array<face_t, 4>& adjacents() const;
+  constexpr const std::array<face_t, 4>& adjacents() const;
   ///Return a face_set_t containing the 4 adjacent faces
-  const face_set_t& adjacent_set() const;
+  constexpr const face_set_t& adjacent_set() const;
   ///Return the 4 corners on this face.
-  const std::array<corner_t, 4>& corners() const;
+  constexpr const std::array<corner_t, 4>& corners() const;
   ///Return a corner_set_t containing the 4 corners on this face.
-  const corner_set_t& corner_set() const;
+  constexpr const corner_set_t& corner_set() const;
   ///Return the 4 edges on this face
-  const std::array<edge_t, 4>& edges() const;
+  constexpr const std::array<edge_t, 4>& edges() const;
   ///Return the 4 edges on this face
-  const edge_set_t& edge_set() const;
+  constexpr const edge_set_t& edge_set() const;
   
   ///Return a face that shares a (specified) common edge.
-  const face_t& flip(const edge_t& edge) const;
+  constexpr const face_t& flip(const edge_t& edge) const;
   
   ///Return the 4 (perpendicular) edges touching this face, but not directly on the face.
-  const std::array<edge_t, 4>& perpendicular_edges() const;
+  constexpr const std::array<edge_t, 4>& perpendicular_edges() const;
   
   ///Returns true if @param corner is a corner adjacent to this face; otherwise returns false.
-  bool is_adjacent(const corner_t& corner) const;
+  constexpr bool is_adjacent(const corner_t& corner) const;
   ///Returns true if @param other is a face adjacent to this face; otherwise returns false.
   ///@note that this will NOT return true for (*this).is_adjacent(*this).
-  bool is_adjacent(const face_t& other) const;
+  constexpr bool is_adjacent(const face_t& other) const;
   ///Returns true if @param edge is an edge adjacent to this face; otherwise returns false.
-  bool is_adjacent(const edge_t& edge) const;
+  constexpr bool is_adjacent(const edge_t& edge) const;
   
   ///Return a list of all the faces on the cube.
-  static const std::array<face_t, 6>& all();
+  static constexpr const std::array<face_t, 6>& all();
   ///Return the face equivalent to a specified direction
-  static const face_t& get(const direction_t& direction);
+  static constexpr const face_t& get(const direction_t& direction);
   ///Return the face represented by an index.
   ///@see index()
-  static const face_t& get(const std::uint_fast8_t& idx);
+  static constexpr const face_t& get(const std::uint_fast8_t& idx);
   
   ///Retrieve a numeric 0-based index for the face, for use in indexing when storing in an array, or for comparison
   /// when storing in a container requiring comparison. The index will be less than SIZE(). The "null" face
   /// has no index, and it is illegal to call index() on it.
   ///@see get(std::uint_fast8_t idx)
-  std::uint_fast8_t index() const;
+  constexpr std::uint_fast8_t index() const;
   
   ///Comparison
-  bool operator<(const face_t& other) const;
+  constexpr bool operator<(const face_t& other) const;
   ///Comparison
-  bool operator==(const face_t& other) const;
+  constexpr bool operator==(const face_t& other) const;
   ///Comparison
-  bool operator!=(const face_t& other) const;
+  constexpr bool operator!=(const face_t& other) const;
   
   ///Returns true if this face is a null face_t.
-  bool is_null() const;
+  constexpr bool is_null() const;
   
-  bool is_sane() const;
+  constexpr bool is_sane() const;
   
   ///Returns a null direction.
-  static const face_t& null_face();
+  static constexpr const face_t& null_face();
   
   ///Number of faces.
-  CORNER_CASES_CUBEXX_INLINE static std::size_t SIZE(){ return 6; }
+  CORNER_CASES_CUBEXX_INLINE static constexpr std::size_t SIZE(){ return 6; }
   
 protected:
   direction_t mdirection;
 private:
-  face_t(const direction_t& direction);
+  friend struct detail::topology_builder_t;
   
-  std::array<corner_t, 4> calc_corners() const;
+  explicit constexpr face_t(const direction_t& direction);
 };
 
 /**
@@ -778,7 +795,7 @@ private:
  */
 struct corner_t{
   ///Default construct a "null" corner.
-  corner_t();
+  constexpr corner_t();
   
   /**
    * Returns a corner that is the next corner in the specified direction.
@@ -787,7 +804,7 @@ struct corner_t{
    *
    * @see adjacent(), move()
    */
-  const corner_t& push(const direction_t& direction) const;
+  constexpr const corner_t& push(const direction_t& direction) const;
   
   
   
@@ -798,7 +815,7 @@ struct corner_t{
    *
    * @see adjacent(), push()
    */
-  const corner_t& move(const direction_t& direction) const;
+  constexpr const corner_t& move(const direction_t& direction) const;
   
   
   /**
@@ -808,57 +825,57 @@ struct corner_t{
    *
    * @see push(), move(), adjacents(), adjacent_set()
    */
-  const corner_t& adjacent(const direction_t& direction) const;
+  constexpr const corner_t& adjacent(const direction_t& direction) const;
   
   ///Returns true if @param other is a corner adjacent to this corner; otherwise returns false.
   ///@note that this will NOT return true for (*this).is_adjacent(*this).
-  bool is_adjacent(const corner_t& other) const;
+  constexpr bool is_adjacent(const corner_t& other) const;
   ///Returns true if @param edge is an edge adjacent to this corner; otherwise returns false.
-  bool is_adjacent(const edge_t& edge) const;
+  constexpr bool is_adjacent(const edge_t& edge) const;
   ///Returns true if @param face is a face adjacent to this corner; otherwise returns false.
-  bool is_adjacent(const face_t& face) const;
+  constexpr bool is_adjacent(const face_t& face) const;
   
   
   ///Returns the direction between two adjacent corners.
-  const direction_t& get_adjacent_direction(const corner_t& other) const;
+  constexpr const direction_t& get_adjacent_direction(const corner_t& other) const;
   
   ///Returns a list of 3 adjacent corners to this corner.
   ///@see adjacent_set()
-  const std::array<corner_t, 3>& adjacents() const;
+  constexpr const std::array<corner_t, 3>& adjacents() const;
   ///Returns a set of 3 adjacent corners to this corner.
   ///@see adajcents()
-  const corner_set_t& adjacent_set() const;
+  constexpr const corner_set_t& adjacent_set() const;
   
   
   ///Returns the 3 adjacent faces to this corner.
   ///@see face_set()
-  const std::array<face_t, 3>& faces() const;
+  constexpr const std::array<face_t, 3>& faces() const;
   ///@brief Returns a set of the 3 adjacent faces to this corner.
   ///@see faces()
-  const face_set_t& face_set() const;
+  constexpr const face_set_t& face_set() const;
   
   ///Returns a set of the 3 adjacent edges to this corner.
   ///@see edge_set()
-  const std::array<edge_t, 3>& edges() const;
+  constexpr const std::array<edge_t, 3>& edges() const;
   ///Returns a set of the 3 adjacent edges to this corner.
   ///@see edge_set()
-  const edge_set_t& edge_set() const;
+  constexpr const edge_set_t& edge_set() const;
   
   
   ///Returns the edge between this corner and an adjacent corner, specified via the @param direction parameter.
   ///If the direction is pointing outside of the cube from this corner, it will return the edge between
   /// this corner and the corner in the opposite direction.
   ///@see edges, edge_set(), corner_t::edge(const corner_t&)
-  const edge_t& edge(const direction_t& direction) const;
+  constexpr const edge_t& edge(const direction_t& direction) const;
   ///Returns the edge between this corner and an adjacent corner, specified via the @param corner parameter.
   ///@see edges, edge_set(), corner_t::edge(const direction_t&)
-  const edge_t& edge(const corner_t& other) const;
+  constexpr const edge_t& edge(const corner_t& other) const;
   
   ///Returns the opposite corner across the cube.
-  const corner_t& opposite() const;
+  constexpr const corner_t& opposite() const;
   
   ///Returns a corner that is represented by the specified index, @param idx.
-  static const corner_t& get(std::uint_fast8_t idx);
+  static constexpr const corner_t& get(std::uint_fast8_t idx);
   /**
    * Returns a corner that is represented by a vector of 3 components.
    *
@@ -888,73 +905,74 @@ struct corner_t{
    *
    * @see cubelib_get_corner_by_int3()
    */
-  static const corner_t& get(std::int_fast8_t x, std::int_fast8_t y, std::int_fast8_t z);
+  static constexpr const corner_t& get(std::int_fast8_t x, std::int_fast8_t y, std::int_fast8_t z);
   ///Returns a corner, given a corner.
-  static const corner_t& get(const corner_t& corner);
+  static constexpr const corner_t& get(const corner_t& corner);
   
   ///Retrieve a numeric 0-based index for the corner, for use in indexing when storing in an array, or for comparison
   /// when storing in a container requiring comparison. The index will be less than SIZE(). The "null" corner
   /// has no index, and it is illegal to call index() on it.
   ///@see get(std::uint_fast8_t idx)
-  std::uint_fast8_t index() const;
+  constexpr std::uint_fast8_t index() const;
   ///Comparison
-  bool operator<(const corner_t& other) const;
+  constexpr bool operator<(const corner_t& other) const;
   ///Comparison
-  bool operator==(const corner_t& other) const;
+  constexpr bool operator==(const corner_t& other) const;
   ///Comparison
-  bool operator!=(const corner_t& other) const;
+  constexpr bool operator!=(const corner_t& other) const;
   
   
   ///Return a list of all the faces on the cube.
-  static const std::array<corner_t, 8>& all();
+  static constexpr const std::array<corner_t, 8>& all();
   
   ///Return an integer in {-1,1} depending if the corner is in the near side or the far side of the x, respectively
   ///@see get(std::int_fast8_t,std::int_fast8_t,std::int_fast8_t)
   ///@see x(), y(), z(), ux(), uy(), uz()
-  std::int_fast8_t x() const;
+  constexpr std::int_fast8_t x() const;
   ///Return an integer in {-1,1} depending if the corner is in the near side or the far side of the y, respectively
   ///@see get(std::int_fast8_t,std::int_fast8_t,std::int_fast8_t)
   ///@see x(), y(), z(), ux(), uy(), uz()
-  std::int_fast8_t y() const;
+  constexpr std::int_fast8_t y() const;
   ///Return an integer in {-1,1} depending if the corner is in the near side or the far side of the z, respectively
   ///@see get(std::int_fast8_t,std::int_fast8_t,std::int_fast8_t)
   ///@see x(), y(), z(), ux(), uy(), uz()
-  std::int_fast8_t z() const;
+  constexpr std::int_fast8_t z() const;
   
   ///Return an unsigned integer in {0,1} depending if the corner is in the near side or the far side of the x, respectively
   ///@see get(std::int_fast8_t,std::int_fast8_t,std::int_fast8_t)
   ///@see x(), y(), z(), ux(), uy(), uz()
-  std::uint_fast8_t ux() const;
+  constexpr std::uint_fast8_t ux() const;
   ///Return an unsigned integer in {0,1} depending if the corner is in the near side or the far side of the y, respectively
   ///@see get(std::int_fast8_t,std::int_fast8_t,std::int_fast8_t)
   ///@see x(), y(), z(), ux(), uy(), uz()
-  std::uint_fast8_t uy() const;
+  constexpr std::uint_fast8_t uy() const;
   ///Return an unsigned integer in {0,1} depending if the corner is in the near side or the far side of the z, respectively
   ///@see get(std::int_fast8_t,std::int_fast8_t,std::int_fast8_t)
   ///@see x(), y(), z(), ux(), uy(), uz()
-  std::uint_fast8_t uz() const;
+  constexpr std::uint_fast8_t uz() const;
   
   ///Return an array with all three components of the corner's vector
   ///@see x(), y(), z(), get(std::int_fast8_t,std::int_fast8_t,std::int_fast8_t)
-  const std::array<std::int_fast8_t,3>& xyz() const;
+  constexpr const std::array<std::int_fast8_t,3>& xyz() const;
   ///Return an array with all three unsigned components of the corner's unsigned representation vector
   ///@see ux(), uy(), uz(), get(std::int_fast8_t,std::int_fast8_t,std::int_fast8_t)
-  const std::array<std::uint_fast8_t,3>& uxyz() const;
+  constexpr const std::array<std::uint_fast8_t,3>& uxyz() const;
   
   ///Number of corners.
-  CORNER_CASES_CUBEXX_INLINE static std::size_t SIZE(){ return 8; }
+  CORNER_CASES_CUBEXX_INLINE static constexpr std::size_t SIZE(){ return 8; }
   
   ///Returns true if this corner is null; false otherwise.
-  bool is_null() const;
-  bool is_sane() const;
+  constexpr bool is_null() const;
+  constexpr bool is_sane() const;
   
   ///Retrieve the "null" corner.
-  static const corner_t& null_corner();
+  static constexpr const corner_t& null_corner();
 private:
-  corner_t(std::int_fast8_t x, std::int_fast8_t y, std::int_fast8_t z);
-  corner_t(const std::bitset<4>& bits);
+  friend struct detail::topology_builder_t;
+  
+  explicit constexpr corner_t(std::uint8_t bits);
   
-  std::bitset<4> mbits;
+  std::uint8_t mbits;
 };
 
 
@@ -964,26 +982,26 @@ private:
  */
 struct edge_t{
   ///Default construct a "null" edge.
-  edge_t();
+  constexpr edge_t();
   
   ///Get the lower corner of this edge. Note that "lower" here
   /// means the one closer to the origin.
   ///@see corner1(), corners(), corner_set()
-  const corner_t& corner0() const;
+  constexpr const corner_t& corner0() const;
   ///Get the upper corner of this edge. Note that "upper" here
   /// means the one farther from the origin.
   ///@see corner0(), corners(), corner_set()
-  const corner_t& corner1() const;
+  constexpr const corner_t& corner1() const;
   /**
    * Retrieve a list of (2) corners associated with this edge.
    * @see corner0(), corner1()
    */
-  const std::array<corner_t, 2>& corners() const;
+  constexpr const std::array<corner_t, 2>& corners() const;
   /**
    * Retrieve the set of (2) corners associated with this edge.
    * @see corner0(), corner1()
    */
-  const corner_set_t& corner_set() const;
+  constexpr const corner_set_t& corner_set() const;
   
   
   
@@ -1017,86 +1035,86 @@ struct edge_t{
    * Retrieve a list of (2) adjacent edges associated with a particular corner of the edge.
    * @see adjacent_set(), adjacents(), adjacent_set(const corner_t&)
    */
-  const std::array<edge_t, 2>& adjacent_edges(const corner_t& corner) const;
+  constexpr const std::array<edge_t, 2>& adjacent_edges(const corner_t& corner) const;
   
   /**
    * Retrieve a set of (2) edges that are adjacent with a particular corner of the edge.
    * @see adjacents(), adjacents(const corner_t&)
    */
-  const edge_set_t& adjacent_edge_set(const corner_t& corner) const;
+  constexpr const edge_set_t& adjacent_edge_set(const corner_t& corner) const;
   
   
   /**
    * Retrieve a list of (4) edges that are adjacent with this edge.
    *
    */
-  const std::array<edge_t, 4>& adjacent_edges() const;
+  constexpr const std::array<edge_t, 4>& adjacent_edges() const;
   /**
    * Retrieve a set of (4) edges that are adjacent with this edge.
    *
    */
-  const edge_set_t& adjacent_edge_set() const;
+  constexpr const edge_set_t& adjacent_edge_set() const;
   
   ///Retrieve a list of (2) faces that are adjacent with this edge.
-  const std::array<face_t, 2>& faces() const;
+  constexpr const std::array<face_t, 2>& faces() const;
   ///Retrieve a set of (2) faces that are adjacent with this edge.
-  const face_set_t& face_set() const;
+  constexpr const face_set_t& face_set() const;
   
   
   
   ///Retrieve a face that is not directly adjacent, but is perpendicular and
   ///touching with the specified end of this edge.
   ///@see end_faces(), end_face_set()
-  const face_t& end_face(const corner_t& corner) const;
+  constexpr const face_t& end_face(const corner_t& corner) const;
   ///Retrieve a list of (2) faces that are not directly adjacent, but are perpendicular and
   ///touching with the ends of this edge.
   ///@see end_face(), end_face_set()
-  const std::array<face_t, 2>& end_faces() const;
+  constexpr const std::array<face_t, 2>& end_faces() const;
   
   ///Retrieve a list of (2) faces that are not directly adjacent, but are perpendicular and
   ///touching with the ends of this edge.
   ///@see end_face(), end_faces()
-  const face_set_t& end_face_set() const;
+  constexpr const face_set_t& end_face_set() const;
   
 
   
   
   ///Retrieve a list of all (12) edges on the cube.
-  static const std::array<edge_t, 12>& all();
+  static constexpr const std::array<edge_t, 12>& all();
   
   
   
   ///Retrieve the edge on the opposite side of the cube.
-  const edge_t& opposite() const;
+  constexpr const edge_t& opposite() const;
   
   ///Retrieve the edge on the opposite side of the specified face.
-  const edge_t& opposite(const face_t& face) const;
+  constexpr const edge_t& opposite(const face_t& face) const;
   
 
   ///Returns true if @param other is an edge adjacent to this edge; otherwise returns false.
   ///@note that this will NOT return true for (*this).is_adjacent(*this).
-  bool is_adjacent(const edge_t& other) const;
+  constexpr bool is_adjacent(const edge_t& other) const;
   ///Returns true if @param face is a face adjacent to this edge; otherwise returns false.
-  bool is_adjacent(const face_t& face) const;
+  constexpr bool is_adjacent(const face_t& face) const;
   ///Returns true if @param corner is a corner adjacent to this edge; otherwise returns false.
-  bool is_adjacent(const corner_t& corner) const;
+  constexpr bool is_adjacent(const corner_t& corner) const;
   
   
   
   ///Test if an edge is a "null" edge.
-  bool is_null() const;
+  constexpr bool is_null() const;
   
-  bool is_sane() const;
+  constexpr bool is_sane() const;
   
   ///Retrieve the "null" edge.
-  static const edge_t& null_edge();
+  static constexpr const edge_t& null_edge();
   
   /**
    * Retrieve an edge by its index.
    * 
    * @see index()
    */
-  static const edge_t& get(std::uint_fast8_t idx);
+  static constexpr const edge_t& get(std::uint_fast8_t idx);
   
   /**
    * Retrieves an edge by the following descriptive logic:
@@ -1113,7 +1131,7 @@ struct edge_t{
    *
    * @see base_axis(), secondary_axis(), tertiary_axis(), project_secondary(), project_tertiary()
    */
-  static const edge_t& get(std::uint_fast8_t axis, bool project_secondary, bool project_tertiary);
+  static constexpr const edge_t& get(std::uint_fast8_t axis, bool project_secondary, bool project_tertiary);
   /**
    * Retrieves an edge via the two corners. Note, the corners specified here may be in any order
    * so long as they are adjacent; however the edge canonicalizes the order so that calls to 
@@ -1121,47 +1139,49 @@ struct edge_t{
    *
    * @see corner0(), corner1()
    */
-  static const edge_t& get(const corner_t& corner0, const corner_t& corner1);
+  static constexpr const edge_t& get(const corner_t& corner0, const corner_t& corner1);
   
   ///Returns the "base-axis" (in `{0,1,2}` for the `x,y,z` axis repsectively) that this edge is aligned with this edge.
   ///@see secondary_axis(), tertiary_axis(), get(std::uint_fast8_t,bool,bool)
-  std::uint_fast8_t base_axis() const;
+  constexpr std::uint_fast8_t base_axis() const;
   ///Returns the "secondary-axis" (in `{0,1,2}` for the `x,y,z` axis repsectively); the "secondary-axis" is the
   ///next axis (modular increment) from the "base-axis".
   ///@see base_axis(), tertiary_axis(), get(std::uint_fast8_t,bool,bool)
-  std::uint_fast8_t secondary_axis() const;
+  constexpr std::uint_fast8_t secondary_axis() const;
   ///Returns the "tertiary-axis" (in `{0,1,2}` for the `x,y,z` axis repsectively); the "tertiary-axis" is the
   ///next axis (modular increment) from the "secondary-axis".
   ///@see base_axis(), secondary_axis(), get(std::uint_fast8_t,bool,bool)
-  std::uint_fast8_t tertiary_axis() const;
+  constexpr std::uint_fast8_t tertiary_axis() const;
   
   ///Returns true if this edge is closer to or farther from the lower (-1,-1,-1) corner in the cube, specifically
   /// compared with the other parallel edge along the "secondary-axis".
   ///@see base_axis(), secondary_axis(), get(std::uint_fast8_t,bool,bool)
-  bool project_secondary() const;
+  constexpr bool project_secondary() const;
   ///Returns true if this edge is closer to or farther from the lower (-1,-1,-1) corner in the cube, specifically
   /// compared with the other parallel edge along the "tertiary-axis".
   ///@see base_axis(), tertiary_axis(), get(std::uint_fast8_t,bool,bool)
-  bool project_tertiary() const;
+  constexpr bool project_tertiary() const;
   
   ///Retrieve a numeric 0-based index for the edge, for use in indexing when storing in an array, or for comparison
   /// when storing in a container requiring comparison. The index will be less than SIZE(). The "null" edge
   /// has no index, and it is illegal to call index() on it.
   ///@see get(std::uint_fast8_t idx)
-  std::uint_fast8_t index() const;
+  constexpr std::uint_fast8_t index() const;
   ///A comparison operator for using the edge in an std::set-like container.
-  bool operator<(const edge_t& other) const;
+  constexpr bool operator<(const edge_t& other) const;
   
   ///Equality operator, can be used between null edge and non-null-edges etc. Two null edges are equal.
-  bool operator==(const edge_t& other) const;
+  constexpr bool operator==(const edge_t& other) const;
   ///Inequality operator, can be used between null edge and non-null-edges etc. Two null edges are equal.
-  bool operator!=(const edge_t& other) const;
+  constexpr bool operator!=(const edge_t& other) const;
   
   ///Number of edges.
-  CORNER_CASES_CUBEXX_INLINE static std::size_t SIZE() { return 12; }
+  CORNER_CASES_CUBEXX_INLINE static constexpr std::size_t SIZE() { return 12; }
 private:
+  friend struct detail::topology_builder_t;
+  
   ///internal ctor
-  edge_t(const std::bitset<4>& bits);
+  explicit constexpr edge_t(std::uint8_t bits);
   
   /**
    * Representation:
@@ -1187,18 +1207,33 @@ private:
    * Some examples: 0b0010, means the edge on the x-axis, projected along the z-axis (which is tertiary when the "base-axis" is x).
    
    */
-  std::bitset<4> mbits;
-  
-  
-  const corner_t& calc_corner0() const;
-  const corner_t& calc_corner1() const;
-  const edge_t& calc_opposite() const;
-  
-  const face_t& calc_face(uint_fast8_t idx) const;
+  std::uint8_t mbits;
 };
 
 
 
+///The elements and sets are meant to be stored densely (and copied around as raw bytes),
+/// by the million in octree metadata; keep them that way.
+static_assert(sizeof(direction_t) == 1, "direction_t should be a single byte");
+static_assert(sizeof(face_t) == 1, "face_t should be a single byte");
+static_assert(sizeof(corner_t) == 1, "corner_t should be a single byte");
+static_assert(sizeof(edge_t) == 1, "edge_t should be a single byte");
+static_assert(sizeof(direction_set_t) == 1, "direction_set_t should be a single byte");
+static_assert(sizeof(face_set_t) == 1, "face_set_t should be a single byte");
+static_assert(sizeof(corner_set_t) == 1, "corner_set_t should be a single byte");
+static_assert(sizeof(edge_set_t) == 2, "edge_set_t should be two bytes");
+
+static_assert(std::is_trivially_copyable<direction_t>::value, "direction_t should be trivially copyable");
+static_assert(std::is_trivially_copyable<face_t>::value, "face_t should be trivially copyable");
+static_assert(std::is_trivially_copyable<corner_t>::value, "corner_t should be trivially copyable");
+static_assert(std::is_trivially_copyable<edge_t>::value, "edge_t should be trivially copyable");
+static_assert(std::is_trivially_copyable<direction_set_t>::value, "direction_set_t should be trivially copyable");
+static_assert(std::is_trivially_copyable<face_set_t>::value, "face_set_t should be trivially copyable");
+static_assert(std::is_trivially_copyable<corner_set_t>::value, "corner_set_t should be trivially copyable");
+static_assert(std::is_trivially_copyable<edge_set_t>::value, "edge_set_t should be trivially copyable");
+
+
+
 } // namespace cubexx
 
 #include <cubexx/detail/cubexx.inl.hpp>
@@ -0,0 +1,130 @@
+/*
+    Copyright (c) 2012 Azriel Fasten azriel.fasten@gmail.com
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef CORNER_CASES_CUBEXX_CULLING_HPP
+#define CORNER_CASES_CUBEXX_CULLING_HPP
+
+#include "cubexx/cubexx.hpp"
+#include "cubexx/octree_traversal.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <vector>
+
+
+namespace cubexx{
+
+///A half-space; the points `p` with `dot(normal, p) + offset >= 0`. The normal need not be normalized.
+struct half_space_t
+{
+  std::array<float, 3> normal;
+  float offset;
+};
+
+/**
+ * @class culler_t
+ * @brief Tests axis aligned cubes (octree cells) against the intersection of up to 32 half-spaces, e.g. a frustum.
+ *
+ * For each plane, the p-vertex (the corner of a box farthest along the normal) and n-vertex (the nearest) are
+ * the corner_t whose signs match, and oppose, the signs of the normal; they are worked out once, when the
+ * culler is made. A box is outside a plane if its p-vertex is, and entirely inside if its n-vertex is.
+ *
+ * Tests take and return a plane_mask_t: the planes that the box still straddles. A child is within its parent,
+ * so the planes its parent was entirely inside are skipped; once the mask is empty, the whole subtree is inside.
+ */
+struct culler_t
+{
+  ///A bit per plane, by the plane's index.
+  typedef std::uint32_t plane_mask_t;
+
+  ///The most planes a culler can have.
+  CORNER_CASES_CUBEXX_INLINE static constexpr std::size_t MAX_PLANES(){ return 32; }
+
+  ///A culler with no planes; nothing is culled.
+  culler_t();
+  explicit culler_t(const std::vector<half_space_t>& planes);
+
+  /**
+   * @brief The 6 planes of the view frustum of the view-projection @p matrix (row-major, acting on column vectors),
+   *          with OpenGL clip space, `-w <= x, y, z <= w`.
+   *
+   * The planes are left, right, bottom, top, near and far, in that order.
+   */
+  static culler_t frustum(const std::array<float, 16>& matrix);
+
+  std::size_t size() const;
+  const half_space_t& plane(std::size_t i) const;
+  ///The p-vertex of plane @p i; the corner of any box farthest along its normal.
+  const corner_t& p_corner(std::size_t i) const;
+  ///The n-vertex of plane @p i; the corner of any box nearest along its normal.
+  const corner_t& n_corner(std::size_t i) const;
+  ///The mask of all the planes; what the root starts with.
+  plane_mask_t all() const;
+
+  /**
+   * @brief Whether the cube of side @p size at @p lower is not outside any of the planes in @p mask.
+   *
+   * If it is not, the planes that the cube is entirely inside are removed from @p mask.
+   */
+  bool test(const std::array<float, 3>& lower, float size, plane_mask_t& mask) const;
+
+  /**
+   * @brief The children of the cube of side @p size at @p lower that are not outside any of the planes in @p mask;
+   *          each visible child's mask goes to `child_masks[corner.index()]`.
+   *
+   * All 8 children are tested against a plane at once, with SSE (or AVX) when the target has it.
+   */
+  corner_set_t test_children(const std::array<float, 3>& lower, float size, plane_mask_t mask,
+                             plane_mask_t* child_masks) const;
+
+private:
+  struct entry_t
+  {
+    half_space_t plane;
+    corner_t p_corner, n_corner;
+    ///`dot(normal, corner)` for the unit cube's corners (see corner_t::uxyz()), by index
+    float corner_dots[8];
+  };
+
+  std::vector<entry_t> mentries;
+};
+
+/**
+ * @brief Calls `visitor(node, lower, size, inside)` for each leaf of @p tree that @p culler does not cull, in
+ *          Morton order; the root cell is the cube of side @p size with its lowest corner at @p lower.
+ *
+ * @p inside is set if the leaf is entirely inside every plane. Subtrees entirely inside are walked without tests.
+ *
+ * @see octree_traversal_t
+ */
+template<typename tree_t, typename visitor_t>
+void cull_visit(const tree_t& tree, const std::array<float, 3>& lower, float size, const culler_t& culler,
+                visitor_t&& visitor);
+
+} // namespace cubexx
+
+#include "cubexx/detail/culling.inl.hpp"
+
+#endif // CORNER_CASES_CUBEXX_CULLING_HPP
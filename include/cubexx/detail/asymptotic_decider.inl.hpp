@@ -0,0 +1,281 @@
+/*
+    Copyright (c) 2012 Azriel Fasten azriel.fasten@gmail.com
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "cubexx/asymptotic_decider.hpp"
+
+#include <cassert>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+namespace cubexx{
+
+namespace detail{
+
+///The two diagonals of face @p f, as 4 corner indices; the first two are one diagonal, the last two the other.
+constexpr std::array<std::uint8_t, 4> face_diagonals(std::size_t f)
+{
+  const face_t& face = face_t::get(std::uint_fast8_t(f));
+  const corner_t& a = face.corners()[0];
+  std::uint8_t result[4] = {std::uint8_t(a.index()), 0, 0, 0};
+  std::size_t others = 2;
+  for (std::size_t i = 1; i < 4; ++i)
+  {
+    const corner_t& b = face.corners()[i];
+    ///the corner differing from the first on both of the face's axes is across the diagonal
+    if (popcount(std::uint_fast8_t(a.index() ^ b.index())) == 2)
+      result[1] = std::uint8_t(b.index());
+    else
+      result[others++] = std::uint8_t(b.index());
+  }
+  return {{result[0], result[1], result[2], result[3]}};
+}
+
+constexpr std::uint_fast8_t ambiguous_faces(std::uint_fast8_t inside)
+{
+  std::uint_fast8_t result = 0;
+  for (std::size_t f = 0; f < 6; ++f)
+  {
+    const std::array<std::uint8_t, 4> d = face_diagonals(f);
+    bool first = ((inside >> d[0]) & 1) && ((inside >> d[1]) & 1) && !((inside >> d[2]) & 1) && !((inside >> d[3]) & 1);
+    bool second = !((inside >> d[0]) & 1) && !((inside >> d[1]) & 1) && ((inside >> d[2]) & 1) && ((inside >> d[3]) & 1);
+    if (first || second)
+      result = std::uint_fast8_t(result | (1 << f));
+  }
+  return result;
+}
+
+///The rank of the subset @p connected among the subsets of @p ambiguous; the bits of @p connected, compressed.
+constexpr std::size_t connected_rank(std::uint_fast8_t ambiguous, std::uint_fast8_t connected)
+{
+  std::size_t result = 0;
+  for (std::size_t f = 0; f < 6; ++f)
+    result |= std::size_t((connected >> f) & 1) << popcount(std::uint_fast8_t(ambiguous & ((1 << f) - 1)));
+  return result;
+}
+
+///The number of combinations of a case and its connected faces.
+constexpr std::size_t decided_case_count()
+{
+  std::size_t result = 0;
+  for (std::size_t inside = 0; inside < 256; ++inside)
+    result += std::size_t(1) << popcount(ambiguous_faces(std::uint_fast8_t(inside)));
+  return result;
+}
+
+///Visits every case and every subset of its ambiguous faces, in the order of the tables.
+template<typename F>
+constexpr void for_each_decided_case(F f)
+{
+  for (std::size_t inside = 0; inside < 256; ++inside)
+  {
+    std::uint_fast8_t ambiguous = ambiguous_faces(std::uint_fast8_t(inside));
+    ///the subsets of ambiguous, in order of rank
+    std::uint_fast8_t connected = 0;
+    do
+    {
+      f(std::uint_fast8_t(inside), connected);
+      connected = std::uint_fast8_t((connected - ambiguous) & ambiguous);
+    } while (connected != 0);
+  }
+}
+
+struct decider_table_t
+{
+  std::uint8_t ambiguous[256];
+  ///The index of each case's first entry; the entry for some connected faces is at the offset plus their rank.
+  std::uint16_t offsets[256];
+  std::array<std::uint8_t, 4> diagonals[6];
+  std::uint8_t triangle_counts[decided_case_count()];
+  ///The edges of the loop fanned around the vertex inside the cell, if any.
+  std::uint16_t centers[decided_case_count()];
+  ///A loop of k crossed edges is k-2 triangles, or k around the vertex inside the cell, and there are at most 12;
+  /// connecting all the faces of the checkerboard cases makes one loop of all 12.
+  std::uint8_t triangles[decided_case_count()][3 * 12];
+};
+
+struct fill_decided_t
+{
+  decider_table_t* table;
+  std::size_t* entry;
+  constexpr void operator()(std::uint_fast8_t inside, std::uint_fast8_t connected) const
+  {
+    std::uint8_t triangles[3 * 12] = {};
+    std::uint16_t center = 0;
+    std::size_t count = marching_cubes_triangulate(inside, triangles, connected, &center);
+    table->triangle_counts[*entry] = std::uint8_t(count);
+    table->centers[*entry] = center;
+    for (std::size_t i = 0; i < 3 * count; ++i)
+      table->triangles[*entry][i] = triangles[i];
+    ++*entry;
+  }
+};
+
+constexpr decider_table_t make_decider_table()
+{
+  decider_table_t table = {};
+  std::size_t offset = 0;
+  for (std::size_t inside = 0; inside < 256; ++inside)
+  {
+    table.ambiguous[inside] = std::uint8_t(ambiguous_faces(std::uint_fast8_t(inside)));
+    table.offsets[inside] = std::uint16_t(offset);
+    offset += std::size_t(1) << popcount(table.ambiguous[inside]);
+  }
+  for (std::size_t f = 0; f < 6; ++f)
+    table.diagonals[f] = face_diagonals(f);
+
+  std::size_t entry = 0;
+  for_each_decided_case(fill_decided_t{&table, &entry});
+  return table;
+}
+
+template<typename dummy_t = void>
+struct decider_tables_t
+{
+  static constexpr decider_table_t table = make_decider_table();
+};
+
+template<typename dummy_t>
+constexpr decider_table_t decider_tables_t<dummy_t>::table;
+
+constexpr std::size_t decided_entry(const corner_set_t& inside, const face_set_t& connected)
+{
+  return decider_tables_t<>::table.offsets[inside.mask()]
+       + connected_rank(decider_tables_t<>::table.ambiguous[inside.mask()], std::uint_fast8_t(connected.mask()));
+}
+
+///The edge with index @p e, or the null edge for the vertex inside the cell.
+constexpr const edge_t& decided_vertex(std::uint8_t e)
+{
+  return e == marching_cubes_center ? edge_t::null_edge() : edge_t::get(std::uint_fast8_t(e));
+}
+
+} // namespace detail
+
+//###################################################################
+//#### asymptotic decider
+//###################################################################
+
+constexpr face_set_t marching_cubes_ambiguous_faces(const corner_set_t& inside)
+{
+  return face_set_t::from_mask(face_set_t::mask_type(detail::decider_tables_t<>::table.ambiguous[inside.mask()]));
+}
+
+CORNER_CASES_CUBEXX_INLINE
+face_set_t asymptotic_decider(const corner_set_t& inside, const std::array<float, 8>& values, float isovalue)
+{
+  const detail::decider_table_t& table = detail::decider_tables_t<>::table;
+  std::uint_fast8_t result = 0;
+  for (std::size_t f = 0; f < 6; ++f)
+  {
+    const std::array<std::uint8_t, 4>& d = table.diagonals[f];
+    float products = (values[d[0]] - isovalue) * (values[d[1]] - isovalue)
+                   - (values[d[2]] - isovalue) * (values[d[3]] - isovalue);
+    ///the inside diagonal's product must be the greater
+    bool first_inside = ((inside.mask() >> d[0]) & 1) != 0;
+    bool connected = (first_inside & (products > 0)) | (!first_inside & (products < 0));
+    result = std::uint_fast8_t(result | (std::uint_fast8_t(connected) << f));
+  }
+  return face_set_t::from_mask(face_set_t::mask_type(result & table.ambiguous[inside.mask()]));
+}
+
+CORNER_CASES_CUBEXX_INLINE
+void asymptotic_decider_row(const float* const* rows, std::size_t n, float isovalue, const std::uint8_t* cases,
+                            std::uint8_t* connected)
+{
+  const detail::decider_table_t& table = detail::decider_tables_t<>::table;
+  std::size_t x = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+  const __m128 iso = _mm_set1_ps(isovalue);
+  const __m128 zero = _mm_setzero_ps();
+  for (; x + 4 <= n; x += 4)
+  {
+    ///the 4 cases, widened to a lane each
+    std::int32_t packed_cases = 0;
+    std::memcpy(&packed_cases, cases + x, 4);
+    __m128i lanes = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(packed_cases), _mm_setzero_si128()),
+                                       _mm_setzero_si128());
+
+    ///corner k of the cells is in row k >> 1, offset by k & 1
+    __m128 values[8];
+    for (std::size_t k = 0; k < 8; ++k)
+      values[k] = _mm_sub_ps(_mm_loadu_ps(rows[k >> 1] + x + (k & 1)), iso);
+
+    __m128i result = _mm_setzero_si128();
+    for (std::size_t f = 0; f < 6; ++f)
+    {
+      const std::array<std::uint8_t, 4>& d = table.diagonals[f];
+      __m128 products = _mm_sub_ps(_mm_mul_ps(values[d[0]], values[d[1]]), _mm_mul_ps(values[d[2]], values[d[3]]));
+      __m128i greater = _mm_castps_si128(_mm_cmpgt_ps(products, zero));
+      __m128i less = _mm_castps_si128(_mm_cmplt_ps(products, zero));
+      const __m128i bit = _mm_set1_epi32(1 << d[0]);
+      __m128i first_inside = _mm_cmpeq_epi32(_mm_and_si128(lanes, bit), bit);
+      __m128i decided = _mm_or_si128(_mm_and_si128(first_inside, greater), _mm_andnot_si128(first_inside, less));
+      result = _mm_or_si128(result, _mm_and_si128(decided, _mm_set1_epi32(1 << f)));
+    }
+
+    std::int32_t packed = _mm_cvtsi128_si32(_mm_packus_epi16(_mm_packs_epi32(result, result), _mm_setzero_si128()));
+    std::memcpy(connected + x, &packed, 4);
+    for (std::size_t i = 0; i < 4; ++i)
+      connected[x + i] = std::uint8_t(connected[x + i] & table.ambiguous[cases[x + i]]);
+  }
+#endif
+  for (; x < n; ++x)
+  {
+    std::array<float, 8> values = {};
+    for (std::size_t k = 0; k < 8; ++k)
+      values[k] = rows[k >> 1][x + (k & 1)];
+    corner_set_t inside = corner_set_t::from_mask(corner_set_t::mask_type(cases[x]));
+    connected[x] = std::uint8_t(asymptotic_decider(inside, values, isovalue).mask());
+  }
+}
+
+constexpr std::size_t marching_cubes_max_decided_triangles()
+{
+  return sizeof(detail::decider_table_t::triangles[0]) / 3;
+}
+
+constexpr std::size_t marching_cubes_triangle_count(const corner_set_t& inside, const face_set_t& connected)
+{
+  return detail::decider_tables_t<>::table.triangle_counts[detail::decided_entry(inside, connected)];
+}
+
+constexpr std::array<edge_t, 3> marching_cubes_triangle(const corner_set_t& inside, const face_set_t& connected,
+                                                        std::size_t i)
+{
+  const std::uint8_t* triangle = detail::decider_tables_t<>::table.triangles[detail::decided_entry(inside, connected)]
+                               + 3 * i;
+  return {{detail::decided_vertex(triangle[0]), detail::decided_vertex(triangle[1]),
+           detail::decided_vertex(triangle[2])}};
+}
+
+constexpr edge_set_t marching_cubes_center_edges(const corner_set_t& inside, const face_set_t& connected)
+{
+  return edge_set_t::from_mask(edge_set_t::mask_type(
+    detail::decider_tables_t<>::table.centers[detail::decided_entry(inside, connected)]));
+}
+
+} // namespace cubexx
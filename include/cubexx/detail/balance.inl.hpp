@@ -0,0 +1,230 @@
+/*
+    Copyright (c) 2012 Azriel Fasten azriel.fasten@gmail.com
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "cubexx/balance.hpp"
+#include "cubexx/octree_builder.hpp"
+
+#include <cassert>
+#include <algorithm>
+#include <utility>
+
+namespace cubexx{
+
+namespace detail{
+
+///The offsets to the neighbors of a cell by @p adjacency.
+CORNER_CASES_CUBEXX_INLINE
+offset_set_t balance_neighborhood(adjacency_t adjacency)
+{
+  return offset_set_t::neighborhood(adjacency == adjacency_t::face ? 6 : adjacency == adjacency_t::edge ? 18 : 26);
+}
+
+///Calls `fn(neighbor)` for each cell on the level of @p code that is its neighbor by @p adjacency, and is within
+/// the root.
+template<std::size_t MaxDepth, typename function_t>
+CORNER_CASES_CUBEXX_INLINE
+void for_each_adjacent(const morton_code_t<MaxDepth>& code, adjacency_t adjacency, function_t&& fn)
+{
+  for (const offset_t& offset : balance_neighborhood(adjacency))
+  {
+    auto result = neighbor(code, offset);
+    if (!result.outside)
+      fn(result.code);
+  }
+}
+
+///The index of the leaf in @p codes (sorted as in linear_octree_t) that contains @p code, or `n` if there is none.
+template<std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+std::size_t balance_containing(const morton_code_t<MaxDepth>* codes, std::size_t n, const morton_code_t<MaxDepth>& code)
+{
+  typedef linear_octree_t<char, MaxDepth> layout_t;
+  std::uint64_t key = layout_t::anchor(code);
+  ///the last leaf anchored at or before the code
+  const morton_code_t<MaxDepth>* next = std::upper_bound(codes, codes + n, key,
+    [](std::uint64_t key, const morton_code_t<MaxDepth>& leaf){ return key < layout_t::anchor(leaf); });
+  if (next == codes)
+    return n;
+  return next[-1].contains(code) ? std::size_t(next - 1 - codes) : n;
+}
+
+/**
+ * @brief Appends the leaves that @p cell is split into, in Morton order, so that each of @p seeds (sorted, all
+ *          on one level, all within @p cell) is a leaf.
+ */
+template<std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+void balance_split(const morton_code_t<MaxDepth>& cell, const std::uint64_t* first, const std::uint64_t* last,
+                   std::vector<morton_code_t<MaxDepth>>& leaves)
+{
+  typedef morton_code_t<MaxDepth> code_type;
+  if (first == last || code_type::from_bits(typename code_type::value_type(*first)).level() == cell.level())
+  {
+    leaves.push_back(cell);
+    return;
+  }
+
+  const std::size_t level = cell.level() + 1;
+  for (const corner_t& corner : corner_t::all())
+  {
+    const std::uint64_t* end = std::partition_point(first, last, [&](std::uint64_t seed){
+      return code_type::from_bits(typename code_type::value_type(seed)).corner_at(level).index() <= corner.index();
+    });
+    balance_split(cell.child(corner), first, end, leaves);
+    first = end;
+  }
+}
+
+} // namespace detail
+
+template<typename T, std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+linear_octree_t<T, MaxDepth> balance(const linear_octree_t<T, MaxDepth>& octree, adjacency_t adjacency,
+                                     thread_pool_t& pool)
+{
+  typedef morton_code_t<MaxDepth> code_type;
+  const std::size_t BLOCK_SIZE = 1 << 14;
+  const auto blocks_of = [&](std::size_t n){ return (n + BLOCK_SIZE - 1) / BLOCK_SIZE; };
+
+  ///the leaves, and the index of the original leaf each came from
+  std::vector<code_type> codes(octree.codes(), octree.codes() + octree.size());
+  std::vector<std::size_t> origins(codes.size());
+  for (std::size_t i = 0; i < origins.size(); ++i)
+    origins[i] = i;
+
+  for (std::size_t level = MaxDepth; level >= 2; --level)
+  {
+    ///the cells on level-1 that the leaves on level force; each must end up a leaf, or inside a finer one
+    std::vector<std::vector<std::uint64_t>> block_seeds(blocks_of(codes.size()));
+    pool.run(block_seeds.size(), [&](std::size_t block){
+      std::size_t last = std::min(codes.size(), (block + 1) * BLOCK_SIZE);
+      for (std::size_t i = block * BLOCK_SIZE; i < last; ++i)
+      {
+        if (codes[i].level() != level)
+          continue;
+        detail::for_each_adjacent(codes[i], adjacency, [&](const code_type& cell){
+          block_seeds[block].push_back(cell.parent().bits());
+        });
+      }
+    });
+
+    std::vector<std::uint64_t> seeds;
+    for (const auto& some : block_seeds)
+      seeds.insert(seeds.end(), some.begin(), some.end());
+    if (seeds.empty())
+      continue;
+
+    ///a Morton ordered bucket; the seeds are all on one level, so their bits sort in Morton order
+    detail::radix_sort(pool, seeds, 3 * MaxDepth + 1);
+    seeds.erase(std::unique(seeds.begin(), seeds.end()), seeds.end());
+
+    ///the leaf coarser than level-1 containing each seed, if there is one
+    std::vector<std::size_t> containing(seeds.size());
+    pool.run(blocks_of(seeds.size()), [&](std::size_t block){
+      std::size_t last = std::min(seeds.size(), (block + 1) * BLOCK_SIZE);
+      for (std::size_t i = block * BLOCK_SIZE; i < last; ++i)
+      {
+        code_type seed = code_type::from_bits(typename code_type::value_type(seeds[i]));
+        std::size_t leaf = detail::balance_containing(codes.data(), codes.size(), seed);
+        containing[i] = leaf != codes.size() && codes[leaf].level() + 1 < level ? leaf : codes.size();
+      }
+    });
+
+    ///group the seeds by leaf; both are in Morton order, so each leaf's seeds are a run
+    std::vector<std::pair<std::size_t, std::size_t>> groups;
+    std::vector<std::size_t> group_leaves;
+    for (std::size_t i = 0; i < seeds.size(); )
+    {
+      std::size_t j = i + 1;
+      while (j < seeds.size() && containing[j] == containing[i])
+        ++j;
+      if (containing[i] != codes.size())
+      {
+        groups.emplace_back(i, j);
+        group_leaves.push_back(containing[i]);
+      }
+      i = j;
+    }
+    if (groups.empty())
+      continue;
+
+    std::vector<std::vector<code_type>> replacements(groups.size());
+    pool.run(groups.size(), [&](std::size_t group){
+      detail::balance_split(codes[group_leaves[group]], seeds.data() + groups[group].first,
+                            seeds.data() + groups[group].second, replacements[group]);
+    });
+
+    ///splice the replacements in
+    std::vector<code_type> next_codes;
+    std::vector<std::size_t> next_origins;
+    std::size_t added = 0;
+    for (const auto& replacement : replacements)
+      added += replacement.size() - 1;
+    next_codes.reserve(codes.size() + added);
+    next_origins.reserve(codes.size() + added);
+
+    std::size_t group = 0;
+    for (std::size_t i = 0; i < codes.size(); ++i)
+    {
+      if (group < group_leaves.size() && group_leaves[group] == i)
+      {
+        next_codes.insert(next_codes.end(), replacements[group].begin(), replacements[group].end());
+        next_origins.insert(next_origins.end(), replacements[group].size(), origins[i]);
+        ++group;
+        continue;
+      }
+      next_codes.push_back(codes[i]);
+      next_origins.push_back(origins[i]);
+    }
+    codes.swap(next_codes);
+    origins.swap(next_origins);
+  }
+
+  std::vector<T> values;
+  values.reserve(origins.size());
+  for (std::size_t origin : origins)
+    values.push_back(octree.value(origin));
+  return linear_octree_t<T, MaxDepth>::from_sorted(std::move(codes), std::move(values));
+}
+
+template<typename T, std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+bool is_balanced(const linear_octree_t<T, MaxDepth>& octree, adjacency_t adjacency)
+{
+  ///from the finer side of each pair of neighbors, the coarser one contains a same-level neighbor
+  for (std::size_t i = 0; i < octree.size(); ++i)
+  {
+    const auto& leaf = octree.code(i);
+    bool balanced = true;
+    detail::for_each_adjacent(leaf, adjacency, [&](const morton_code_t<MaxDepth>& cell){
+      std::size_t other = octree.locate(cell);
+      balanced = balanced && (other == octree.size() || octree.code(other).level() + 1 >= leaf.level());
+    });
+    if (!balanced)
+      return false;
+  }
+  return true;
+}
+
+} // namespace cubexx
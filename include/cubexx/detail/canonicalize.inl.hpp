@@ -0,0 +1,115 @@
+/*
+    Copyright (c) 2012 Azriel Fasten azriel.fasten@gmail.com
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "cubexx/canonicalize.hpp"
+
+namespace cubexx{
+
+namespace detail{
+
+///The tables behind canonicalize(), indexed by group, then mask.
+struct canonical_table_t
+{
+  std::uint8_t corner_sets[2][256];
+  std::uint8_t corner_symmetries[2][256];
+  std::uint16_t edge_sets[2][4096];
+  std::uint8_t edge_symmetries[2][4096];
+  std::uint8_t face_sets[2][64];
+  std::uint8_t face_symmetries[2][64];
+};
+
+struct canonical_builder_t
+{
+  ///For each mask, the lowest image under the symmetries of the group, and the first symmetry giving it.
+  template<typename mask_t, std::size_t Size>
+  static constexpr void reduce(const mask_t (&images)[48][Size], bool reflections, mask_t (&sets)[Size],
+                               std::uint8_t (&symmetries)[Size])
+  {
+    for (std::size_t mask = 0; mask < Size; ++mask)
+    {
+      sets[mask] = mask_t(mask);
+      symmetries[mask] = 0;
+      for (std::uint8_t s = 1; s < 48; ++s)
+      {
+        if (!reflections && !cube_symmetry_t::get(s).is_rotation())
+          continue;
+        if (images[s][mask] < sets[mask])
+        {
+          sets[mask] = images[s][mask];
+          symmetries[mask] = s;
+        }
+      }
+    }
+  }
+
+  static constexpr canonical_table_t build()
+  {
+    canonical_table_t table = {};
+    for (std::size_t group = 0; group < 2; ++group)
+    {
+      const cube_symmetry_table_t& symmetries = cube_symmetry_tables_t<>::table;
+      reduce(symmetries.corner_sets, group != 0, table.corner_sets[group], table.corner_symmetries[group]);
+      reduce(symmetries.edge_sets, group != 0, table.edge_sets[group], table.edge_symmetries[group]);
+      reduce(symmetries.direction_sets, group != 0, table.face_sets[group], table.face_symmetries[group]);
+    }
+    return table;
+  }
+};
+
+template<typename T = void>
+struct canonical_tables_t
+{
+  static constexpr canonical_table_t table = canonical_builder_t::build();
+};
+
+template<typename T> constexpr canonical_table_t canonical_tables_t<T>::table;
+
+} // namespace detail
+
+//###################################################################
+//#### canonicalize
+//###################################################################
+
+constexpr canonical_form_t<corner_set_t> canonicalize(const corner_set_t& corners, cube_symmetry_group_t group)
+{
+  return {corner_set_t::from_mask(corner_set_t::mask_type(
+            detail::canonical_tables_t<>::table.corner_sets[std::size_t(group)][corners.mask()])),
+          cube_symmetry_t::get(detail::canonical_tables_t<>::table.corner_symmetries[std::size_t(group)][corners.mask()])};
+}
+
+constexpr canonical_form_t<edge_set_t> canonicalize(const edge_set_t& edges, cube_symmetry_group_t group)
+{
+  return {edge_set_t::from_mask(edge_set_t::mask_type(
+            detail::canonical_tables_t<>::table.edge_sets[std::size_t(group)][edges.mask()])),
+          cube_symmetry_t::get(detail::canonical_tables_t<>::table.edge_symmetries[std::size_t(group)][edges.mask()])};
+}
+
+constexpr canonical_form_t<face_set_t> canonicalize(const face_set_t& faces, cube_symmetry_group_t group)
+{
+  return {face_set_t::from_mask(face_set_t::mask_type(
+            detail::canonical_tables_t<>::table.face_sets[std::size_t(group)][faces.mask()])),
+          cube_symmetry_t::get(detail::canonical_tables_t<>::table.face_symmetries[std::size_t(group)][faces.mask()])};
+}
+
+} // namespace cubexx
@@ -0,0 +1,300 @@
+/*
+    Copyright (c) 2012 Azriel Fasten azriel.fasten@gmail.com
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "cubexx/cube_symmetry.hpp"
+
+#include <cassert>
+#include <utility>
+
+namespace cubexx{
+
+//###################################################################
+//#### cube_symmetry_t construction
+//###################################################################
+
+constexpr cube_symmetry_t::cube_symmetry_t()
+  : mindex(0)
+{
+
+}
+
+constexpr cube_symmetry_t::cube_symmetry_t(std::uint8_t idx)
+  : mindex(idx)
+{
+
+}
+
+namespace detail{
+
+///The tables behind cube_symmetry_t, one row per symmetry.
+struct cube_symmetry_table_t
+{
+  std::array<cube_symmetry_t, 48> all;
+  std::uint8_t corners[48][8];
+  std::uint8_t edges[48][12];
+  std::uint8_t directions[48][6];
+  std::uint8_t corner_sets[48][256];
+  std::uint16_t edge_sets[48][4096];
+  ///face_t and direction_t share their indices, so this serves face_set_t too.
+  std::uint8_t direction_sets[48][64];
+  std::uint8_t compose[48][48];
+  std::uint8_t inverse[48];
+};
+
+/**
+ * Computes the tables from the signed permutation that each symmetry is; see cube_symmetry_t::mindex.
+ */
+struct cube_symmetry_builder_t
+{
+  typedef std::uint_fast8_t raw_t;
+
+  ///The axis that axis @p j goes to, under the @p p-th permutation.
+  static constexpr raw_t permuted(raw_t p, raw_t j)
+  {
+    return raw_t((p == 0 ? 0x210 : p == 1 ? 0x120 : p == 2 ? 0x201 : p == 3 ? 0x021 : p == 4 ? 0x102 : 0x012)
+                 >> (4 * j) & 0xF);
+  }
+  ///The index of the permutation that takes x, y and z to @p a0, @p a1 and the remaining axis.
+  static constexpr raw_t permutation(raw_t a0, raw_t a1)
+  {
+    return raw_t(a0 == 0 ? (a1 == 1 ? 0 : 1) : a0 == 1 ? (a1 == 0 ? 2 : 3) : (a1 == 0 ? 4 : 5));
+  }
+  static constexpr raw_t axis(raw_t s, raw_t j) { return permuted(raw_t(s >> 3), j); }
+  static constexpr bool negative(raw_t s, raw_t j) { return ((s >> j) & 1) != 0; }
+  ///The symmetry taking x and y to @p a0 and @p a1 (and z to the remaining axis), negating those flagged.
+  static constexpr raw_t make(raw_t a0, raw_t a1, bool n0, bool n1, bool n2)
+  {
+    return raw_t(permutation(a0, a1) << 3 | (n0 ? 1 : 0) | (n1 ? 2 : 0) | (n2 ? 4 : 0));
+  }
+
+  static constexpr raw_t corner(raw_t s, raw_t c)
+  {
+    raw_t result = 0;
+    for (raw_t j = 0; j < 3; ++j)
+      result |= raw_t((((c >> j) & 1) ^ (negative(s, j) ? 1 : 0)) << axis(s, j));
+    return result;
+  }
+  static constexpr raw_t edge(raw_t s, raw_t e)
+  {
+    return edge_t::get(corner_t::get(corner(s, edge_t::get(e).corner0().index())),
+                       corner_t::get(corner(s, edge_t::get(e).corner1().index()))).index();
+  }
+  static constexpr raw_t direction(raw_t s, raw_t d)
+  {
+    const direction_t& direction = direction_t::get(d);
+    std::int_fast8_t xyz[3] = {0, 0, 0};
+    xyz[axis(s, direction.axis())] = direction.positive() != negative(s, direction.axis()) ? 1 : -1;
+    return direction_t::get(xyz[0], xyz[1], xyz[2]).index();
+  }
+  ///Applies @p b, then @p a.
+  static constexpr raw_t compose(raw_t a, raw_t b)
+  {
+    raw_t axes[3] = {0, 0, 0};
+    bool negatives[3] = {false, false, false};
+    for (raw_t j = 0; j < 3; ++j)
+    {
+      axes[j] = axis(a, axis(b, j));
+      negatives[j] = negative(b, j) != negative(a, axis(b, j));
+    }
+    return make(axes[0], axes[1], negatives[0], negatives[1], negatives[2]);
+  }
+  static constexpr raw_t inverse(raw_t s)
+  {
+    raw_t axes[3] = {0, 0, 0};
+    bool negatives[3] = {false, false, false};
+    for (raw_t j = 0; j < 3; ++j)
+    {
+      axes[axis(s, j)] = j;
+      negatives[axis(s, j)] = negative(s, j);
+    }
+    return make(axes[0], axes[1], negatives[0], negatives[1], negatives[2]);
+  }
+
+  ///Each set is the one without its lowest element, plus that element's image.
+  template<typename mask_t, std::size_t Size, std::size_t N>
+  static constexpr void sets(const std::uint8_t (&elements)[N], mask_t (&result)[Size])
+  {
+    result[0] = 0;
+    for (std::size_t mask = 1; mask < Size; ++mask)
+    {
+      std::size_t lowest = 0;
+      while (!((mask >> lowest) & 1))
+        ++lowest;
+      result[mask] = mask_t(result[mask & (mask - 1)] | (1U << elements[lowest]));
+    }
+  }
+
+  template<std::size_t... Indices>
+  static constexpr std::array<cube_symmetry_t, 48> all(std::index_sequence<Indices...>)
+  {
+    return {{cube_symmetry_t(std::uint8_t(Indices))...}};
+  }
+
+  static constexpr cube_symmetry_table_t build()
+  {
+    cube_symmetry_table_t table = {};
+    table.all = all(std::make_index_sequence<48>());
+    for (raw_t s = 0; s < 48; ++s)
+    {
+      for (raw_t c = 0; c < 8; ++c)
+        table.corners[s][c] = std::uint8_t(corner(s, c));
+      for (raw_t e = 0; e < 12; ++e)
+        table.edges[s][e] = std::uint8_t(edge(s, e));
+      for (raw_t d = 0; d < 6; ++d)
+        table.directions[s][d] = std::uint8_t(direction(s, d));
+      for (raw_t t = 0; t < 48; ++t)
+        table.compose[s][t] = std::uint8_t(compose(s, t));
+      table.inverse[s] = std::uint8_t(inverse(s));
+
+      sets(table.corners[s], table.corner_sets[s]);
+      sets(table.edges[s], table.edge_sets[s]);
+      sets(table.directions[s], table.direction_sets[s]);
+    }
+    return table;
+  }
+};
+
+template<typename T = void>
+struct cube_symmetry_tables_t
+{
+  static constexpr cube_symmetry_table_t table = cube_symmetry_builder_t::build();
+};
+
+template<typename T> constexpr cube_symmetry_table_t cube_symmetry_tables_t<T>::table;
+
+static_assert(sizeof(cube_symmetry_t) == 1, "cube_symmetry_t should be a single byte");
+
+} // namespace detail
+
+//###################################################################
+//#### cube_symmetry_t
+//###################################################################
+
+constexpr cube_symmetry_t cube_symmetry_t::get(const direction_t& x, const direction_t& y, const direction_t& z)
+{
+  assert(!x.is_null() && !y.is_null() && !z.is_null());
+  assert(x.axis() != y.axis() && y.axis() != z.axis() && z.axis() != x.axis());
+  return cube_symmetry_t(std::uint8_t(detail::cube_symmetry_builder_t::make(x.axis(), y.axis(), !x.positive(),
+                                                                            !y.positive(), !z.positive())));
+}
+
+constexpr cube_symmetry_t cube_symmetry_t::get(std::uint_fast8_t idx)
+{
+  assert(idx < SIZE());
+  return cube_symmetry_t(std::uint8_t(idx));
+}
+
+constexpr const std::array<cube_symmetry_t, 48>& cube_symmetry_t::all()
+{
+  return detail::cube_symmetry_tables_t<>::table.all;
+}
+
+constexpr cube_symmetry_t cube_symmetry_t::identity()
+{
+  return cube_symmetry_t();
+}
+
+constexpr bool cube_symmetry_t::is_rotation() const
+{
+  ///an even permutation (0, 3 and 4 are the cyclic ones) with an even number of reflected axes, or odd with odd
+  return ((mindex >> 3) == 0 || (mindex >> 3) == 3 || (mindex >> 3) == 4)
+      == (((mindex & 1) + ((mindex >> 1) & 1) + ((mindex >> 2) & 1)) % 2 == 0);
+}
+
+constexpr cube_symmetry_t cube_symmetry_t::inverse() const
+{
+  return cube_symmetry_t(detail::cube_symmetry_tables_t<>::table.inverse[mindex]);
+}
+
+constexpr cube_symmetry_t cube_symmetry_t::operator*(const cube_symmetry_t& other) const
+{
+  return cube_symmetry_t(detail::cube_symmetry_tables_t<>::table.compose[mindex][other.mindex]);
+}
+
+constexpr const corner_t& cube_symmetry_t::operator()(const corner_t& corner) const
+{
+  return corner_t::get(std::uint_fast8_t(detail::cube_symmetry_tables_t<>::table.corners[mindex][corner.index()]));
+}
+
+constexpr const edge_t& cube_symmetry_t::operator()(const edge_t& edge) const
+{
+  return edge_t::get(std::uint_fast8_t(detail::cube_symmetry_tables_t<>::table.edges[mindex][edge.index()]));
+}
+
+constexpr const face_t& cube_symmetry_t::operator()(const face_t& face) const
+{
+  return face_t::get(std::uint_fast8_t(detail::cube_symmetry_tables_t<>::table.directions[mindex][face.index()]));
+}
+
+constexpr const direction_t& cube_symmetry_t::operator()(const direction_t& direction) const
+{
+  return direction_t::get(
+    std::uint_fast8_t(detail::cube_symmetry_tables_t<>::table.directions[mindex][direction.index()]));
+}
+
+constexpr corner_set_t cube_symmetry_t::operator()(const corner_set_t& corners) const
+{
+  return corner_set_t::from_mask(
+    corner_set_t::mask_type(detail::cube_symmetry_tables_t<>::table.corner_sets[mindex][corners.mask()]));
+}
+
+constexpr edge_set_t cube_symmetry_t::operator()(const edge_set_t& edges) const
+{
+  return edge_set_t::from_mask(
+    edge_set_t::mask_type(detail::cube_symmetry_tables_t<>::table.edge_sets[mindex][edges.mask()]));
+}
+
+constexpr face_set_t cube_symmetry_t::operator()(const face_set_t& faces) const
+{
+  return face_set_t::from_mask(
+    face_set_t::mask_type(detail::cube_symmetry_tables_t<>::table.direction_sets[mindex][faces.mask()]));
+}
+
+constexpr direction_set_t cube_symmetry_t::operator()(const direction_set_t& directions) const
+{
+  return direction_set_t::from_mask(
+    direction_set_t::mask_type(detail::cube_symmetry_tables_t<>::table.direction_sets[mindex][directions.mask()]));
+}
+
+constexpr std::uint_fast8_t cube_symmetry_t::index() const
+{
+  return mindex;
+}
+
+constexpr bool cube_symmetry_t::operator<(const cube_symmetry_t& other) const
+{
+  return mindex < other.mindex;
+}
+
+constexpr bool cube_symmetry_t::operator==(const cube_symmetry_t& other) const
+{
+  return mindex == other.mindex;
+}
+
+constexpr bool cube_symmetry_t::operator!=(const cube_symmetry_t& other) const
+{
+  return mindex != other.mindex;
+}
+
+} // namespace cubexx
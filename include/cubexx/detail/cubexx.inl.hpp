@@ -36,6 +36,7 @@ namespace cubexx{
 //###################################################################
 
 CORNER_CASES_CUBEXX_INLINE
+constexpr
 face_t::
 face_t(const direction_t& direction)
   : mdirection(direction)
@@ -44,22 +45,23 @@ face_t(const direction_t& direction)
 }
 
 CORNER_CASES_CUBEXX_INLINE
+constexpr
 face_t::
 face_t()
-  : mdirection(direction_t::null_direction())
+  : mdirection()
 {
   assert(is_sane());
   assert(is_null());
 }
 
 CORNER_CASES_CUBEXX_INLINE
-bool
+constexpr bool
 face_t::is_sane() const
 {
   return mdirection.is_sane();
 }
 CORNER_CASES_CUBEXX_INLINE
-bool
+constexpr bool
 face_t::is_null() const
 {
   return mdirection.is_null();
@@ -67,3038 +69,2310 @@ face_t::is_null() const
 
 
 CORNER_CASES_CUBEXX_INLINE
-const face_t&
-face_t::null_face()
+constexpr std::uint_fast8_t
+face_t::index() const
 {
-  static const face_t internal = face_t();
-  return internal;
+  return mdirection.index();
 }
 
 
-
 CORNER_CASES_CUBEXX_INLINE
-std::uint_fast8_t
-face_t::index() const
+constexpr const direction_t& face_t::direction() const
 {
-  return mdirection.index();
+  return mdirection;
 }
 
 
 CORNER_CASES_CUBEXX_INLINE
-const std::array< face_t, 6 >&
-face_t::all()
+constexpr bool
+face_t::operator==(const face_t& other) const
 {
-  static const std::array<face_t, 6> faces =
-    {{
-      face_t(direction_t::get(0)),
-      face_t(direction_t::get(1)),
-      face_t(direction_t::get(2)),
-      face_t(direction_t::get(3)),
-      face_t(direction_t::get(4)),
-      face_t(direction_t::get(5))
-    }};
-
-  return faces;
+  return mdirection == other.mdirection;
 }
 
-
 CORNER_CASES_CUBEXX_INLINE
-const face_t&
-face_t::get(const direction_t& direction)
+constexpr bool
+face_t::operator!=(const face_t& other) const
 {
-  assert(direction.index() < all().size());
-  return all()[direction.index()];
+  return mdirection != other.mdirection;
 }
 
 CORNER_CASES_CUBEXX_INLINE
-const face_t&
-face_t::get(const std::uint_fast8_t& idx)
+constexpr bool
+face_t::operator<(const face_t& other) const
 {
-  assert(idx < all().size());
-  const face_t& result = all()[idx];
-  assert(result.is_sane());
-  assert(!result.is_null());
-  return result;
+  return mdirection < other.mdirection;
 }
 
 
+//###################################################################
+
+
+
+//###################################################################
+//#### direction_t
+//###################################################################
+
+
+
 CORNER_CASES_CUBEXX_INLINE
-const direction_t& face_t::direction() const
+constexpr
+direction_t::
+direction_t()
+  : mbits(6)
 {
-  return mdirection;
+  assert(is_null());
+  assert(is_sane());
 }
 
+
 CORNER_CASES_CUBEXX_INLINE
-const face_t& face_t::opposite() const
+constexpr
+direction_t::direction_t(std::uint8_t bits)
+  : mbits(bits)
 {
-  return face_t::get(mdirection.opposite());
+  assert(is_sane());
 }
 
+
+
+
 CORNER_CASES_CUBEXX_INLINE
-const std::array<face_t,4>&
-face_t::adjacents() const
+constexpr bool
+direction_t::
+is_null() const
 {
-  auto precompute = [](){
-    typedef std::array<face_t,4> result_type;
-    std::array<result_type, 6> internal_results;
-
-    for (auto face : face_t::all())
-    {
-      for (uint_fast8_t i = 0; i < 4; ++i)
-        internal_results[face.index()][i] = face.direction().adjacents()[i];
-    }
+    return mbits == 6;
+}
 
-    return internal_results;
-  };
+CORNER_CASES_CUBEXX_INLINE
+constexpr bool
+direction_t::
+is_sane() const
+{
+    return mbits <= 6;
+}
 
-  static const auto internal_results = precompute();
 
+CORNER_CASES_CUBEXX_INLINE
+constexpr std::int_fast8_t direction_t::x() const
+{
   assert(is_sane());
   assert(!is_null());
-
-  const auto& results = internal_results[index()];
-
-  for (auto adjacent : results)
-  {
-    assert((*this).is_adjacent(adjacent));
-    assert(adjacent.is_adjacent(*this));
-  }
-
-  return results;
+  return (positive() ? 1 : -1)  * (axis() == 0 ? 1 : 0);
 }
+
 CORNER_CASES_CUBEXX_INLINE
-const face_set_t&
-face_t::adjacent_set() const
+constexpr std::int_fast8_t direction_t::y() const
 {
-  auto precompute = [](){
-    std::array<face_set_t, 6> internal_results;
-
-    for (auto face : face_t::all())
-    {
-      internal_results[face.index()] = face_set_t(face.adjacents());
-    }
-
-    return internal_results;
-  };
-
-  static const auto internal_results = precompute();
-
   assert(is_sane());
   assert(!is_null());
-
-  const auto& results = internal_results[index()];
-
-  for (auto adjacent : results)
-  {
-    assert((*this).is_adjacent(adjacent));
-    assert(adjacent.is_adjacent(*this));
-  }
-
-  return results;
+  return (positive() ? 1 : -1)  * (axis() == 1 ? 1 : 0);
 }
 
 CORNER_CASES_CUBEXX_INLINE
-std::array<corner_t, 4>
-face_t::calc_corners() const
+constexpr std::int_fast8_t direction_t::z() const
 {
   assert(is_sane());
   assert(!is_null());
-
-  std::array<corner_t, 4> result;
-
-  auto dir = this->direction();
-
-  int xyz[] = {dir.x(), dir.y(), dir.z()};
-
-  auto axis = dir.axis();
-  auto axis2 = (axis + 1) % 3;
-  auto axis3 = (axis + 2) % 3;
-
-  assert(xyz[axis] != 0);
-  assert(xyz[axis2] == 0);
-  assert(xyz[axis3] == 0);
-
-  int i = 0;
-  for (auto u : {-1,+1})
-  for (auto v : {-1,+1})
-  {
-    xyz[axis2] = u;
-    xyz[axis3] = v;
-
-    corner_t corner = corner_t::get(xyz[0], xyz[1], xyz[2]);
-    result[i] = corner;
-
-    ++i;
-  }
-
-  return result;
+  return (positive() ? 1 : -1)  * (axis() == 2 ? 1 : 0);
 }
 
 
 CORNER_CASES_CUBEXX_INLINE
-const std::array<corner_t, 4>&
-face_t::corners() const
+constexpr std::uint_fast8_t direction_t::index() const
 {
-
-  static const std::array<corner_t, 4> internal_results[] = {
-      (face_t::get(0).calc_corners())
-    , (face_t::get(1).calc_corners())
-    , (face_t::get(2).calc_corners())
-    , (face_t::get(3).calc_corners())
-    , (face_t::get(4).calc_corners())
-    , (face_t::get(5).calc_corners())
-  };
-
-
-
-  assert(!is_null());
   assert(is_sane());
-  assert(index() < 6);
-
-  const std::array<corner_t, 4>& internal_result = internal_results[index()];
-
-
-  return internal_result;
-
+  assert(!is_null());
+  return mbits;
 }
 
 CORNER_CASES_CUBEXX_INLINE
-const corner_set_t&
-face_t::corner_set() const
+constexpr bool direction_t::
+operator<(const direction_t& other) const
 {
+  return mbits < other.mbits;
+}
 
-  static const corner_set_t internal_results[] = {
-      corner_set_t(face_t::get(0).corners())
-    , corner_set_t(face_t::get(1).corners())
-    , corner_set_t(face_t::get(2).corners())
-    , corner_set_t(face_t::get(3).corners())
-    , corner_set_t(face_t::get(4).corners())
-    , corner_set_t(face_t::get(5).corners())
-  };
+CORNER_CASES_CUBEXX_INLINE constexpr bool direction_t::operator==(const direction_t& other) const
+{
+  return mbits == other.mbits;
+}
 
+CORNER_CASES_CUBEXX_INLINE constexpr bool direction_t::operator!=(const direction_t& other) const
+{
+  return mbits != other.mbits;
+}
 
 
-  assert(!is_null());
+/**
+ * [2 bit number][1 bit indicating "direction is positive"]
+ *
+ * [1 bit indicating "direction is positive"]: If the direction is positive, this bit is set to 1.
+ *
+ * [2 bit number]: A number calculated as follows:
+ *
+ * direction is in z: 00
+ * direction is in y: 01
+ * direction is in x: 10
+ */
+CORNER_CASES_CUBEXX_INLINE
+constexpr uint_fast8_t
+direction_t::axis() const
+{
   assert(is_sane());
-  assert(index() < 6);
-
-  const corner_set_t& internal_result = internal_results[index()];
-
-
-  return internal_result;
-
+  assert(!is_null());
+  return 2 - (mbits >> 1);
 }
 
 CORNER_CASES_CUBEXX_INLINE
-const std::array<edge_t, 4>&
-face_t::edges() const
+constexpr bool direction_t::positive() const
 {
-  typedef std::array<edge_t, 4> result_type;
-  auto precompute = []()
-  {
-    std::array<result_type, 6> internal_results;
-
-    for (auto face : face_t::all())
-    {
-      auto direction = face.direction();
+  assert(is_sane());
+  assert(!is_null());
+  return (mbits & 1) != 0;
+}
 
-      int xyz[] = {0,0,0};
 
-      xyz[direction.axis()] = direction.positive() ? +1 : -1;
 
 
-      corner_t corners[] = {corner_t::null_corner(),corner_t::null_corner(),corner_t::null_corner(),corner_t::null_corner()};
+//###################################################################
 
 
-      xyz[(direction.axis() + 1) % 3] = -1;
-      xyz[(direction.axis() + 2) % 3] = -1;
-      corners[0] = corner_t::get(xyz[0], xyz[1], xyz[2]);
-      xyz[(direction.axis() + 1) % 3] = +1;
-      xyz[(direction.axis() + 2) % 3] = -1;
-      corners[1] = corner_t::get(xyz[0], xyz[1], xyz[2]);
-      xyz[(direction.axis() + 1) % 3] = +1;
-      xyz[(direction.axis() + 2) % 3] = +1;
-      corners[2] = corner_t::get(xyz[0], xyz[1], xyz[2]);
-      xyz[(direction.axis() + 1) % 3] = -1;
-      xyz[(direction.axis() + 2) % 3] = +1;
-      corners[3] = corner_t::get(xyz[0], xyz[1], xyz[2]);
 
 
-      internal_results[face.index()][0] = edge_t::get(corners[0], corners[1]);
-      internal_results[face.index()][1] = edge_t::get(corners[1], corners[2]);
-      internal_results[face.index()][2] = edge_t::get(corners[2], corners[3]);
-      internal_results[face.index()][3] = edge_t::get(corners[3], corners[0]);
-    }
 
-    return internal_results;
-  };
+//###################################################################
+//#### Corners
+//###################################################################
 
-  static const auto internal_results = precompute();
+CORNER_CASES_CUBEXX_INLINE
+constexpr
+corner_t::
+corner_t()
+    : mbits(0b1000)
+{
 
   assert(is_sane());
-  assert(!is_null());
-  assert(index() < 6);
-
-  const auto& result = internal_results[index()];
-
-  return result;
+  assert(is_null());
 }
 
 CORNER_CASES_CUBEXX_INLINE
-const edge_set_t&
-face_t::edge_set() const
+constexpr
+corner_t::
+corner_t(std::uint8_t bits)
+  : mbits(bits)
 {
-  auto precompute = []()
-  {
-    std::array<edge_set_t, 6> internal_results;
+  assert(is_sane());
+}
 
-    for (auto face : face_t::all())
-    {
-      internal_results[face.index()] = edge_set_t(face.edges());
-    }
 
-    return internal_results;
-  };
+CORNER_CASES_CUBEXX_INLINE
+constexpr bool
+corner_t::
+is_sane() const
+{
+  return mbits <= 8;
+}
 
-  static const auto internal_results = precompute();
+CORNER_CASES_CUBEXX_INLINE
+constexpr bool
+corner_t::
+is_null() const
+{
+  return (mbits & 0b1000) != 0;
+}
 
+CORNER_CASES_CUBEXX_INLINE
+constexpr std::uint_fast8_t
+corner_t::
+index() const
+{
   assert(is_sane());
   assert(!is_null());
-  assert(index() < 6);
-
-  const auto& result = internal_results[index()];
-
-  return result;
+  return mbits;
 }
 
 CORNER_CASES_CUBEXX_INLINE
-const std::array<edge_t, 4>&
-face_t::perpendicular_edges() const
+constexpr int_fast8_t
+corner_t::
+x() const
 {
-  auto precompute = [](){
-    typedef std::array<edge_t, 4> result_type;
-    std::array<result_type, 6> internal_results;
-
-    for (auto face : face_t::all())
-    {
-      auto opposite_direction = face.direction().opposite();
-      std::size_t i = 0;
-      for (auto corner : face.corners())
-      {
-        auto other_corner = corner.adjacent(opposite_direction);
-        auto edge = edge_t::get(corner, other_corner);
-
-        internal_results[face.index()][i++] = edge;
-
-        assert((edge.corner_set() & face.corner_set()).size() == 1);
-      }
-    }
-
-    return internal_results;
-  };
-
-  static const auto internal_results = precompute();
-
   assert(is_sane());
   assert(!is_null());
-
-  const auto& result = internal_results[index()];
-  for (auto edge : result){
-    assert((edge.corner_set() & corner_set()).size() == 1);
-  }
-
-  return result;
+  return (mbits & 1 ? 1 : -1);
 }
-
-
 CORNER_CASES_CUBEXX_INLINE
-const face_t&
-face_t::flip(const edge_t& edge) const
+constexpr int_fast8_t
+corner_t::
+y() const
 {
-  auto precompute = []()
-  {
-    std::array<std::array<face_t,12>, 6> internal_results;
-
-    for (auto face : face_t::all())
-    {
-      for (auto edge : edge_t::all())
-      {
-        if (!face.is_adjacent(edge))
-          continue;
-
-        assert(face.index() < internal_results.size());
-        assert(edge.index() < internal_results[face.index()].size());
-
-        auto neighbors = (face.adjacent_set() & edge.face_set());
-        assert(neighbors.size() == 1);
-        for (auto neighbor : neighbors)
-        {
-          internal_results[face.index()][edge.index()] = neighbor;
-        }
-      }
-    }
-
-    return internal_results;
-  };
-
-  static const auto internal_results = precompute();
-
   assert(is_sane());
   assert(!is_null());
-  assert(edge.is_sane());
-  assert(!edge.is_null());
-
-  assert(is_adjacent(edge));
-  assert(edge.is_adjacent(*this));
-
-  const auto& result = internal_results[index()][edge.index()];
-
-  assert(result.is_adjacent(*this));
-  assert(is_adjacent(result));
-  assert(edge_set_t(edge) == (result.edge_set() & edge_set()));
-
-
-  return result;
+  return (mbits & 2 ? 1 : -1);
 }
 
-
-
 CORNER_CASES_CUBEXX_INLINE
-bool
-face_t::is_adjacent(const face_t& other) const
+constexpr int_fast8_t
+corner_t::
+z() const
 {
   assert(is_sane());
   assert(!is_null());
-  assert(other.is_sane());
-  assert(!other.is_null());
-  return (other.corner_set() & this->corner_set()).size() == 2;
+  return (mbits & 4 ? 1 : -1);
 }
 
 CORNER_CASES_CUBEXX_INLINE
-bool
-face_t::is_adjacent(const edge_t& edge) const
+constexpr uint_fast8_t
+corner_t::
+ux() const
 {
-
   assert(is_sane());
   assert(!is_null());
-  assert(edge.is_sane());
-  assert(!edge.is_null());
-  
-  
-  const auto& corner0 = edge.corner0();
-  
-  int corner0_xyz[] = {corner0.x(), corner0.y(), corner0.z()};
-  int direction_xyz[] = {direction().x(), direction().y(), direction().z()};
-  
-  ///the edge and face/direction are not parallel and
-  return edge.base_axis() != direction().axis()
-          ///the significant dimension component of any edge's corner is the same as the direction
-          && corner0_xyz[direction().axis()] == direction_xyz[direction().axis()];
-  
+  return (mbits >> 0) & 1;
 }
-
 CORNER_CASES_CUBEXX_INLINE
-bool
-face_t::is_adjacent(const corner_t& corner) const
+constexpr uint_fast8_t
+corner_t::
+uy() const
 {
-
   assert(is_sane());
   assert(!is_null());
-  assert(corner.is_sane());
-  assert(!corner.is_null());
-  
-
-  uint_fast8_t axis = direction().axis();
-  auto direction_xyz = direction().xyz();
-  auto corner_xyz = corner.xyz();
-
-  return corner_xyz[axis] == direction_xyz[axis];
+  return (mbits >> 1) & 1;
 }
 
-
 CORNER_CASES_CUBEXX_INLINE
-bool
-face_t::operator==(const face_t& other) const
+constexpr uint_fast8_t
+corner_t::
+uz() const
 {
-  return mdirection == other.mdirection;
+  assert(is_sane());
+  assert(!is_null());
+  return (mbits >> 2) & 1;
 }
 
+
 CORNER_CASES_CUBEXX_INLINE
-bool
-face_t::operator!=(const face_t& other) const
+constexpr bool corner_t::operator<(const corner_t& other) const
 {
-  return mdirection != other.mdirection;
+  assert(is_sane());
+  assert(!is_null());
+  assert(other.is_sane());
+  assert(!other.is_null());
+  return mbits < other.mbits;
 }
 
 CORNER_CASES_CUBEXX_INLINE
-bool
-face_t::operator<(const face_t& other) const
+constexpr bool corner_t::operator!=(const corner_t& other) const
 {
-  return mdirection < other.mdirection;
+  assert(is_sane());
+  return mbits != other.mbits;
+}
+
+CORNER_CASES_CUBEXX_INLINE
+constexpr bool corner_t::operator==(const corner_t& other) const
+{
+  assert(is_sane());
+  return mbits == other.mbits;
 }
 
+CORNER_CASES_CUBEXX_INLINE
+constexpr bool
+corner_t::is_adjacent(const corner_t& other) const
+{
+  assert(is_sane());
+  assert(!is_null());
+  assert(other.is_sane());
+  assert(!other.is_null());
+  return detail::has_exactly_one_bit(mbits ^ other.mbits);
+}
 
 //###################################################################
 
 
 
+
 //###################################################################
-//#### direction_t
+//#### edge_t
 //###################################################################
 
 
-
 CORNER_CASES_CUBEXX_INLINE
-direction_t::
-direction_t()
-  : mbits(6)
+constexpr
+edge_t::
+edge_t()
+  : mbits(0b1100)
 {
-  assert(is_null());
   assert(is_sane());
+  assert(is_null());
 }
-
-
 CORNER_CASES_CUBEXX_INLINE
-direction_t::direction_t(const std::bitset< 3 >& bits)
+constexpr
+edge_t::
+edge_t(std::uint8_t bits)
   : mbits(bits)
 {
   assert(is_sane());
 }
 
 
-
-
 CORNER_CASES_CUBEXX_INLINE
-bool
-direction_t::
+constexpr bool
+edge_t::
 is_null() const
 {
-    return mbits == 6;
+  return mbits == 0b1100;
 }
 
 CORNER_CASES_CUBEXX_INLINE
-bool
-direction_t::
+constexpr bool
+edge_t::
 is_sane() const
 {
-    return mbits.to_ulong() <= 6;
+  return mbits <= 0b1100;
 }
+
+
 CORNER_CASES_CUBEXX_INLINE
-const direction_t&
-direction_t::
-null_direction()
+constexpr std::uint_fast8_t
+edge_t::
+base_axis() const
 {
-    static const direction_t internal_null = direction_t();
-    assert(internal_null.is_null());
-    return internal_null;
+  assert(!is_null());
+  assert(is_sane());
+  return mbits >> 2;
 }
 
-
-
 CORNER_CASES_CUBEXX_INLINE
-const direction_t&
-direction_t::
-get(std::int_fast8_t x, std::int_fast8_t y, std::int_fast8_t z)
+constexpr std::uint_fast8_t
+edge_t::
+secondary_axis() const
 {
+  return (base_axis() + 1) % 3;
+}
 
-  assert(detail::lxor(detail::lxor(x != 0, y != 0), z != 0) && "direction must have one non-zero component");
-
-
-
-  /**
-   * [2 bit number][1 bit indicating "direction is positive"]
-   *
-   * [1 bit indicating "direction is positive"]: If the direction is positive, this bit is set to 1.
-   *
-   * [2 bit number]: A number calculated as follows:
-   *
-   * direction is in z: 00
-   * direction is in y: 01
-   * direction is in x: 10
-   */
-
-  direction_t direction(std::bitset<3>(0));
-
-  std::bitset<3>& bits = direction.mbits;
-  if ( x != 0 )
-  {
-    bits.set(2);
-  } else if ( y != 0 ) {
-    bits.set(1);
-  } else if ( z != 0 ) {
-
-  }
-
-  if (x + y + z > 0)
-  {
-    bits.set(0);
-  }
 
-  return direction_t::get( direction );
+CORNER_CASES_CUBEXX_INLINE
+constexpr std::uint_fast8_t
+edge_t::
+tertiary_axis() const
+{
+  return (base_axis() + 2) % 3;
 }
 
+
 CORNER_CASES_CUBEXX_INLINE
-const direction_t&
-direction_t::
-get(const direction_t& direction)
+constexpr bool
+edge_t::
+project_secondary() const
 {
-  assert(!direction.is_null());
-  assert(direction.is_sane());
-  assert(direction.mbits.to_ulong() < SIZE());
-  return all()[direction.mbits.to_ulong()];
+  assert(!is_null());
+  assert(is_sane());
+  return (mbits & 1) != 0;
 }
 
 CORNER_CASES_CUBEXX_INLINE
-const std::array< direction_t, 6 >&
-direction_t::
-all()
+constexpr bool
+edge_t::
+project_tertiary() const
 {
-  static const std::array<direction_t, 6> directions =
-    {{
-      direction_t(std::bitset<3>(0)),
-      direction_t(std::bitset<3>(1)),
-      direction_t(std::bitset<3>(2)),
-      direction_t(std::bitset<3>(3)),
-      direction_t(std::bitset<3>(4)),
-      direction_t(std::bitset<3>(5))
-    }};
-  return directions;
+  assert(!is_null());
+  assert(is_sane());
+  return (mbits & 2) != 0;
 }
 
+
 CORNER_CASES_CUBEXX_INLINE
-std::int_fast8_t direction_t::x() const
+constexpr std::uint_fast8_t
+edge_t::
+index() const
 {
-  assert(is_sane());
   assert(!is_null());
-  return (mbits[0] ? 1 : -1)  * (mbits[2] && !mbits[1] ? 1 : 0);
+  assert(is_sane());
+  return mbits;
 }
 
+
 CORNER_CASES_CUBEXX_INLINE
-std::int_fast8_t direction_t::y() const
+constexpr bool
+edge_t::
+operator==(const edge_t& other) const
 {
   assert(is_sane());
-  assert(!is_null());
-  return (mbits[0] ? 1 : -1)  * (!mbits[2] && mbits[1] ? 1 : 0);
+  assert(other.is_sane());
+  return mbits == other.mbits;
 }
 
 CORNER_CASES_CUBEXX_INLINE
-std::int_fast8_t direction_t::z() const
+constexpr bool
+edge_t::
+operator!=(const edge_t& other) const
 {
   assert(is_sane());
-  assert(!is_null());
-  return (mbits[0] ? 1 : -1)  * (!mbits[2] && !mbits[1] ? 1 : 0);
+  assert(other.is_sane());
+  return mbits != other.mbits;
 }
 
 CORNER_CASES_CUBEXX_INLINE
-const std::array<std::int_fast8_t,3>& direction_t::xyz() const
+constexpr bool
+edge_t::
+operator<(const edge_t& other) const
 {
-  auto precompute = [](){
-    typedef std::array<std::int_fast8_t,3> result_type;
-    std::array<result_type, 6> internal_results;
-    for (auto direction : direction_t::all())
-    {
-      internal_results[direction.index()] = {direction.x(), direction.y(), direction.z()};
-    }
-
-    return internal_results;
-  };
-
   assert(is_sane());
   assert(!is_null());
+  assert(other.is_sane());
+  assert(!other.is_null());
+  return index() < other.index();
+}
+
+//###################################################################
 
 
-  static const auto internal_results = precompute();
 
-  const auto& result = internal_results[index()];
-  assert(result[0] == x());
-  assert(result[1] == y());
-  assert(result[2] == z());
 
-  return result;
-}
 
+//###################################################################
+//#### set_base_t
+//###################################################################
 
+template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-std::uint_fast8_t direction_t::index() const
+constexpr
+set_base_t<derived_t, element_t, N>::
+set_base_t()
+  : mbits(0)
 {
-  assert(is_sane());
-  assert(!is_null());
-  return mbits.to_ulong();
+
 }
 
+
+template<typename derived_t, typename element_t, std::size_t N>
+template<typename Sequence, typename>
 CORNER_CASES_CUBEXX_INLINE
-const direction_t&
-direction_t::get(std::uint_fast8_t idx)
+constexpr
+set_base_t<derived_t, element_t, N>::
+set_base_t(const Sequence& sequence)
+  : mbits(0)
 {
-  assert(idx < SIZE());
-  return all()[idx];
+  insert(sequence);
 }
 
+template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-bool direction_t::
-operator<(const direction_t& other) const
+constexpr typename set_base_t<derived_t, element_t, N>::mask_type
+set_base_t<derived_t, element_t, N>::
+bit(std::size_t idx)
 {
-  return mbits.to_ulong() < other.mbits.to_ulong();
+  assert(idx < N);
+  return mask_type(1) << idx;
 }
 
-CORNER_CASES_CUBEXX_INLINE bool direction_t::operator==(const direction_t& other) const
+template<typename derived_t, typename element_t, std::size_t N>
+CORNER_CASES_CUBEXX_INLINE
+constexpr typename set_base_t<derived_t, element_t, N>::mask_type
+set_base_t<derived_t, element_t, N>::
+full_mask()
 {
-  return mbits == other.mbits;
+  return mask_type((std::uint64_t(1) << N) - 1);
 }
 
-CORNER_CASES_CUBEXX_INLINE bool direction_t::operator!=(const direction_t& other) const
+template<typename derived_t, typename element_t, std::size_t N>
+CORNER_CASES_CUBEXX_INLINE
+constexpr void
+set_base_t<derived_t, element_t, N>::
+insert(const element_t& element)
 {
-  return mbits != other.mbits;
+  mbits |= bit(element.index());
 }
 
-
-
-
-
-
-
-
+template<typename derived_t, typename element_t, std::size_t N>
+template<typename Sequence>
 CORNER_CASES_CUBEXX_INLINE
-const face_t& direction_t::face() const
+constexpr void
+set_base_t<derived_t, element_t, N>::
+insert(const Sequence& sequence)
 {
-  assert(is_sane());
-  assert(!is_null());
-
-  return face_t::get(*this);
+  for(const element_t& element : sequence)
+  {
+    insert(element);
+  }
 }
 
+template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-const direction_t& direction_t::opposite() const
+constexpr bool
+set_base_t<derived_t, element_t, N>::
+contains(const element_t& element) const
 {
-  assert(is_sane());
-  assert(!is_null());
-
-  std::bitset<3> result_bits = mbits;
-  result_bits.flip(0);
-
-  assert(result_bits.to_ulong() < SIZE());
-  return all()[ result_bits.to_ulong() ];
+  assert(element.index() < N);
+  return (mbits & bit(element.index())) != 0;
 }
 
 
+template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-uint_fast8_t
-direction_t::axis() const
+constexpr derived_t&
+set_base_t<derived_t, element_t, N>::
+operator=(const element_t& element)
 {
-  auto precompute = [](){
-    std::array<uint8_t, 6> internal_results;
-    for (auto direction : direction_t::all())
-    {
-      uint8_t axis = direction.x() != 0 ? 0
-                   : (direction.y() != 0 ? 1
-                      : 2);
+  assert(element.index() < N);
 
-      int xyz[] = {direction.x(), direction.y(), direction.z()};
-      assert(xyz[axis] != 0);
-      internal_results[direction.index()] = axis;
-    }
+  mbits = bit(element.index());
+  return self();
+}
 
-    return internal_results;
-  };
 
-  static const auto& internal_results = precompute();
 
+template<typename derived_t, typename element_t, std::size_t N>
+CORNER_CASES_CUBEXX_INLINE
+constexpr derived_t&
+set_base_t<derived_t, element_t, N>::
+operator=(const derived_t& set)
+{
+  mbits = set.mbits;
+  return self();
+}
 
-  assert(is_sane());
-  assert(!is_null());
 
 
-  assert(index() < 6);
-  auto result = internal_results[index()];
+template<typename derived_t, typename element_t, std::size_t N>
+CORNER_CASES_CUBEXX_INLINE
+constexpr derived_t
+set_base_t<derived_t, element_t, N>::
+operator|(const derived_t& set) const
+{
+  return derived_t(self()) |= set;
+}
 
-  int xyz[] = {x(), y(), z()};
-  assert(xyz[result] != 0);
 
-  return result;
+template<typename derived_t, typename element_t, std::size_t N>
+CORNER_CASES_CUBEXX_INLINE
+constexpr derived_t
+set_base_t<derived_t, element_t, N>::
+operator|(const element_t& element) const
+{
+  return derived_t(self()) |= element;
 }
 
+template<typename derived_t, typename element_t, std::size_t N>
+template<typename Sequence>
 CORNER_CASES_CUBEXX_INLINE
-bool direction_t::positive() const
+constexpr derived_t
+set_base_t<derived_t, element_t, N>::
+operator|(const Sequence& sequence) const
 {
-  assert(is_sane());
-  assert(!is_null());
-  return mbits.test(0);
+  return derived_t(self()) |= sequence;
 }
 
+template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-const std::array<direction_t, 4>&
-direction_t::adjacents() const
+constexpr derived_t&
+set_base_t<derived_t, element_t, N>::
+operator|=(const derived_t& set)
 {
-  auto precompute = [](){
-    typedef std::array<direction_t, 4> result_type;
-    std::array<result_type,6> internal_results;
-
-    for (auto direction : direction_t::all())
-    {
-      uint_fast8_t i = 0;
-      for (uint_fast8_t next_dir_index = 0; next_dir_index < direction_t::SIZE(); ++next_dir_index)
-      {
-        auto adjacent = direction_t::get((direction.index() + next_dir_index) % direction_t::SIZE());
-        if (direction.face().is_adjacent(adjacent.face())){
-          assert(i < 4);
-          internal_results[direction.index()][i++] = adjacent;
-        }
-      }
-      assert(i == 4);
-    }
+  mbits |= set.mbits;
 
-    return internal_results;
-  };
+  return self();
+}
 
-  static const auto internal_results = precompute();
+template<typename derived_t, typename element_t, std::size_t N>
+CORNER_CASES_CUBEXX_INLINE
+constexpr derived_t&
+set_base_t<derived_t, element_t, N>::
+operator|=(const element_t& element)
+{
+  assert(element.index() < N);
+  insert(element);
+  return self();
+}
 
-  assert(is_sane());
-  assert(!is_null());
 
-  const auto& result = internal_results[index()];
 
-  for (const direction_t& other : result){
-    assert(face().is_adjacent(other.face()));
-    assert(other.face().is_adjacent(face()));
-  }
+template<typename derived_t, typename element_t, std::size_t N>
+template<typename Sequence>
+CORNER_CASES_CUBEXX_INLINE
+constexpr derived_t&
+set_base_t<derived_t, element_t, N>::
+operator|=(const Sequence& sequence)
+{
+  insert(sequence);
 
-  return result;
+  return self();
 }
 
 
 
+template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-const direction_set_t&
-direction_t::adjacent_set() const
+constexpr derived_t&
+set_base_t<derived_t, element_t, N>::
+operator-=(const derived_t& set)
 {
+  mbits &= ~set.mbits;
 
-  auto precompute = [](){
-    std::array<direction_set_t,6> internal_results;
-
-    for (auto direction : direction_t::all())
-    {
-      internal_results[direction.index()] = direction_set_t(direction.adjacents());
-    }
-    return internal_results;
-  };
-
-  static const auto internal_results = precompute();
+  return self();
+}
 
-  assert(is_sane());
-  assert(!is_null());
-
-  const auto& result = internal_results[index()];
-
-  for (const direction_t& other : result){
-    assert(face().is_adjacent(other.face()));
-    assert(other.face().is_adjacent(face()));
-  }
-
-  return result;
+template<typename derived_t, typename element_t, std::size_t N>
+CORNER_CASES_CUBEXX_INLINE
+constexpr derived_t&
+set_base_t<derived_t, element_t, N>::
+operator-=(const element_t& element)
+{
+  assert(element.index() < N);
+  mbits &= ~bit(element.index());
+  return self();
 }
 
 
 
+template<typename derived_t, typename element_t, std::size_t N>
+template<typename Sequence>
+CORNER_CASES_CUBEXX_INLINE
+constexpr derived_t&
+set_base_t<derived_t, element_t, N>::
+operator-=(const Sequence& sequence)
+{
 
+  for(const element_t& element : sequence)
+  {
+    self() -= element;
+  }
 
-
-
-//###################################################################
-
+  return self();
+}
 
 
 
 
-//###################################################################
-//#### Corners
-//###################################################################
 
+template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-corner_t::
-corner_t()
-    : mbits(0b1000)
+constexpr derived_t
+set_base_t<derived_t, element_t, N>::
+operator-(const derived_t& set) const
 {
-
-  assert(is_sane());
-  assert(is_null());
+  return derived_t(self()) -= set;
 }
 
+
+template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-corner_t::
-corner_t(const std::bitset< 4 >& bits)
-  : mbits(bits)
+constexpr derived_t
+set_base_t<derived_t, element_t, N>::
+operator-(const element_t& element) const
 {
-  assert(is_sane());
+  return derived_t(self()) -= element;
 }
 
+template<typename derived_t, typename element_t, std::size_t N>
+template<typename Sequence>
 CORNER_CASES_CUBEXX_INLINE
-corner_t::
-corner_t(std::int_fast8_t x, std::int_fast8_t y, std::int_fast8_t z)
-  : mbits( (x > 0 ? 1 : 0) | (y > 0 ? 2 : 0) | (z > 0 ? 4 : 0))
+constexpr derived_t
+set_base_t<derived_t, element_t, N>::
+operator-(const Sequence& sequence) const
 {
-  assert(is_sane());
-  assert(!is_null());
+  return derived_t(self()) -= sequence;
 }
 
 
-CORNER_CASES_CUBEXX_INLINE
-bool
-corner_t::
-is_sane() const
-{
-  return mbits.to_ulong() <= 8;
-}
 
+
+template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-bool
-corner_t::
-is_null() const
+constexpr derived_t&
+set_base_t<derived_t, element_t, N>::
+operator&=(const derived_t& set)
 {
-  return mbits.test(3);
+  mbits &= set.mbits;
+
+  return self();
 }
 
+template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-const corner_t&
-corner_t::
-null_corner()
+constexpr derived_t&
+set_base_t<derived_t, element_t, N>::
+operator&=(const element_t& element)
 {
-  static corner_t internal_null = corner_t();
-  assert(internal_null.is_sane());
-  assert(internal_null.is_null());
-  return internal_null;
+  assert(element.index() < N);
+  mbits &= bit(element.index());
+  return self();
 }
 
+
+
+template<typename derived_t, typename element_t, std::size_t N>
+template<typename Sequence>
 CORNER_CASES_CUBEXX_INLINE
-const corner_t&
-corner_t::
-get(std::int_fast8_t x, std::int_fast8_t y, std::int_fast8_t z)
+constexpr derived_t&
+set_base_t<derived_t, element_t, N>::
+operator&=(const Sequence& sequence)
 {
-  std::bitset<4> bits;
-  bits.set(0,x > 0);
-  bits.set(1,y > 0);
-  bits.set(2,z > 0);
-  const corner_t& result = all()[bits.to_ulong()];
 
-  assert(result.is_sane());
-  assert(!result.is_null());
-  return result;
+
+  self() &= derived_t(sequence);
+
+  return self();
 }
 
 
+
+
+
+template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-const std::array< corner_t, 8 >&
-corner_t::
-all()
+constexpr derived_t
+set_base_t<derived_t, element_t, N>::
+operator&(const derived_t& set) const
 {
-  static const std::array<corner_t, 8> corners =
-    {{
-      corner_t(std::bitset<4>(0)),
-      corner_t(std::bitset<4>(1)),
-      corner_t(std::bitset<4>(2)),
-      corner_t(std::bitset<4>(3)),
-      corner_t(std::bitset<4>(4)),
-      corner_t(std::bitset<4>(5)),
-      corner_t(std::bitset<4>(6)),
-      corner_t(std::bitset<4>(7))
-    }};
-  return corners;
+  return derived_t(self()) &= set;
 }
 
+
+template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-std::uint_fast8_t
-corner_t::
-index() const
+constexpr derived_t
+set_base_t<derived_t, element_t, N>::
+operator&(const element_t& element) const
 {
-  assert(is_sane());
-  assert(!is_null());
-  return mbits.to_ulong();
+  return derived_t(self()) &= element;
 }
 
+template<typename derived_t, typename element_t, std::size_t N>
+template<typename Sequence>
 CORNER_CASES_CUBEXX_INLINE
-const corner_t&
-corner_t::
-get(std::uint_fast8_t i)
+constexpr derived_t
+set_base_t<derived_t, element_t, N>::
+operator&(const Sequence& sequence) const
 {
-  assert(i < SIZE());
-  const corner_t& result = all()[i];
-
-  assert(result.is_sane());
-  assert(!result.is_null());
-  return result;
+  return derived_t(self()) &= sequence;
 }
 
+
+template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-const std::array< corner_t, 3 >&
-corner_t::
-adjacents() const
+constexpr derived_t
+set_base_t<derived_t, element_t, N>::
+operator~() const
 {
+  return from_mask(mask_type(~mbits & full_mask()));
+}
 
-  auto precompute = [](){
-    typedef std::array<corner_t,3> result_type;
-    std::array<result_type, 12> internal_results;
-
-    for (auto corner: all())
-    {
-      internal_results[corner.index()] = {{
-        corner_t(-corner.x(), corner.y(), corner.z() ),
-        corner_t( corner.x(),-corner.y(), corner.z() ),
-        corner_t( corner.x(), corner.y(),-corner.z() )
-      }};
-    }
-    return internal_results;
-  };
-
-  static const auto internal_results = precompute();
-
-  assert(is_sane());
-  assert(!is_null());
-  assert(index() < internal_results.size());
-
-  const auto& result = internal_results[index()];
 
-  assert(!corner_set_t(result).contains(*this));
-  for (auto other : result)
-  {
-    assert(other.is_adjacent(*this));
-    assert(is_adjacent(other));
-  }
 
-  return result;
-}
 
+template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-const corner_set_t&
-corner_t::adjacent_set() const
+constexpr derived_t&
+set_base_t<derived_t, element_t, N>::
+self()
 {
-  auto precompute = [](){
-    std::array<corner_set_t, 12> internal_results;
-
-    for (auto corner: all())
-    {
-      internal_results[corner.index()] = corner_set_t(corner.adjacents());
-    }
-    return internal_results;
-  };
-
-  static const auto internal_results = precompute();
-
-  assert(is_sane());
-  assert(!is_null());
-  assert(index() < internal_results.size());
-
-  const auto& result = internal_results[index()];
-
-  assert(result.contains(*this));
-  for (auto other : result)
-  {
-    assert(other.is_adjacent(*this));
-    assert(is_adjacent(other));
-  }
-
-  return result;
+  static_assert( std::is_base_of< set_base_t<derived_t, element_t, N>, derived_t >::value
+                , "Something's really wrong with our CRTP" );
+  return static_cast<derived_t&>(*this);
 }
 
+template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-int_fast8_t
-corner_t::
-x() const
+constexpr const derived_t&
+set_base_t<derived_t, element_t, N>::
+self() const
 {
-  assert(is_sane());
-  assert(!is_null());
-  return (mbits[0] ? 1 : -1);
+  static_assert( std::is_base_of< set_base_t<derived_t, element_t, N>, derived_t >::value
+                , "Something's really wrong with our CRTP" );
+  return static_cast<const derived_t&>(*this);
 }
+
+
+template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-int_fast8_t
-corner_t::
-y() const
+constexpr typename set_base_t<derived_t, element_t, N>::const_iterator
+set_base_t<derived_t, element_t, N>::
+begin() const
 {
-  assert(is_sane());
-  assert(!is_null());
-  return (mbits[1] ? 1 : -1);
+  return const_iterator(mbits);
 }
 
+template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-int_fast8_t
-corner_t::
-z() const
+constexpr typename set_base_t<derived_t, element_t, N>::const_iterator
+set_base_t<derived_t, element_t, N>::
+end() const
 {
-  assert(is_sane());
-  assert(!is_null());
-  return (mbits[2] ? 1 : -1);
+  return const_iterator(0);
 }
 
+
+template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-uint_fast8_t
-corner_t::
-ux() const
+constexpr std::size_t
+set_base_t<derived_t, element_t, N>::
+size() const
 {
-  assert(is_sane());
-  assert(!is_null());
-  return mbits[0];
+  return detail::popcount(mbits);
 }
+
+template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-uint_fast8_t
-corner_t::
-uy() const
+constexpr bool
+set_base_t<derived_t, element_t, N>::
+empty() const
 {
-  assert(is_sane());
-  assert(!is_null());
-  return mbits[1];
+  return mbits == 0;
 }
 
+template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-uint_fast8_t
-corner_t::
-uz() const
+constexpr const element_t&
+set_base_t<derived_t, element_t, N>::
+first() const
 {
-  assert(is_sane());
-  assert(!is_null());
-  return mbits[2];
+  assert(!empty());
+  return element_t::get(detail::countr_zero(mbits));
 }
 
-
-
+template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-const std::array<int_fast8_t,3>&
-corner_t::
-xyz() const
+const element_t&
+set_base_t<derived_t, element_t, N>::
+nth(std::size_t k) const
 {
-  typedef std::array<int_fast8_t,3> result_type;
-  auto precompute = [](){
-    std::array<result_type, 8> internal_results;
-    
-    
-    for (auto corner : cubexx::corner_t::all())
-    {
-      internal_results[corner.index()] = result_type{corner.x(), corner.y(),corner.z()};
-    }
-    return internal_results;
-  };
-  
-  static const auto internal_results = precompute();
-  
-  assert(is_sane());
-  assert(!is_null());
-  
-  const auto& result = internal_results[index()];
-  
-  assert(result[0] == x());
-  assert(result[1] == y());
-  assert(result[2] == z());
-  
-  return result;
-  
+  assert(k < size());
+  return element_t::get(detail::select_bit(mbits, k));
 }
 
+template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-const std::array<uint_fast8_t,3>&
-corner_t::
-uxyz() const
+constexpr void
+set_base_t<derived_t, element_t, N>::
+clear()
 {
-  typedef std::array<uint_fast8_t,3> result_type;
-  auto precompute = [](){
-    std::array<result_type, 8> internal_results;
-    
-    
-    for (auto corner : cubexx::corner_t::all())
-    {
-      internal_results[corner.index()] = result_type{corner.ux(), corner.uy(),corner.uz()};
-    }
-    return internal_results;
-  };
-  
-  static const auto internal_results = precompute();
-  
-  assert(is_sane());
-  assert(!is_null());
-  
-  const auto& result = internal_results[index()];
-  
-  assert(result[0] == ux());
-  assert(result[1] == uy());
-  assert(result[2] == uz());
-  
-  return result;
-  
+  mbits = 0;
 }
 
 
-
+template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-bool corner_t::operator<(const corner_t& other) const
+constexpr bool
+set_base_t<derived_t, element_t, N>::
+operator==(const derived_t& other) const
 {
-  assert(is_sane());
-  assert(!is_null());
-  assert(other.is_sane());
-  assert(!other.is_null());
-  return mbits.to_ulong() < other.mbits.to_ulong();
+  return mbits == other.mbits;
 }
 
+template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-const std::array< face_t, 3 >&
-corner_t::faces() const
+constexpr bool
+set_base_t<derived_t, element_t, N>::
+operator!=(const derived_t& other) const
 {
-  typedef std::array< face_t, 3 > result_type;
-  auto precompute = [](){
-    std::array<result_type, 12> internal_results;
-    for (auto corner : all())
-    {
-      internal_results[corner.index()] = {{
-        direction_t::get( corner.x() > 0 ? 1 : -1, 0, 0).face(),
-        direction_t::get( 0, corner.y() > 0 ? 1 : -1, 0).face(),
-        direction_t::get( 0, 0, corner.z() > 0 ? 1 : -1).face()
-      }};
-    }
-    return internal_results;
-  };
+  return mbits != other.mbits;
+}
 
-  static const auto internal_results = precompute();
 
-  assert(is_sane());
-  assert(!is_null());
-  assert(index() < internal_results.size());
 
-  const auto& result = internal_results[index()];
-
-
-  return result;
-}
 
 
+template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-const face_set_t&
-corner_t::face_set() const
+constexpr bool
+set_base_t<derived_t, element_t, N>::
+contains(const std::size_t& idx) const
 {
-  auto precompute = [](){
-    std::array<face_set_t, 12> internal_results;
-    for (auto corner : all())
-    {
-      internal_results[corner.index()] = face_set_t(corner.faces());
-    }
-    return internal_results;
-  };
-
-  static const auto internal_results = precompute();
-
-  assert(is_sane());
-  assert(!is_null());
-  assert(index() < internal_results.size());
+  assert(idx < N);
+  return (mbits & bit(idx)) != 0;
+}
 
-  const auto& result = internal_results[index()];
 
 
-  return result;
+template<typename derived_t, typename element_t, std::size_t N>
+CORNER_CASES_CUBEXX_INLINE
+constexpr std::bitset<N>
+set_base_t<derived_t, element_t, N>::
+bits() const
+{
+  return std::bitset<N>(static_cast<unsigned long long>(mbits));
 }
 
+template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-const corner_t&
-corner_t::get(const corner_t& corner)
+constexpr typename set_base_t<derived_t, element_t, N>::mask_type
+set_base_t<derived_t, element_t, N>::
+mask() const
 {
-  assert(corner.is_sane());
-  assert(!corner.is_null());
-  assert(corner.index() < SIZE());
-  const corner_t& result = all()[corner.index()];
-  assert(result.is_sane());
-  assert(!result.is_null());
-  return result;
+  return mbits;
 }
 
+template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-const corner_t&
-corner_t::opposite() const
+constexpr derived_t
+set_base_t<derived_t, element_t, N>::
+from_mask(mask_type mask)
 {
-  assert(is_sane());
-  assert(!is_null());
-  std::size_t idx =  (std::bitset<4>(mbits) ^ std::bitset<4>(0b0111)).to_ulong();
-  assert(idx < SIZE());
-  const corner_t& result = all()[idx];
-  assert(result.is_sane());
-  assert(!result.is_null());
+  assert((mask & ~full_mask()) == 0);
+  derived_t result;
+  result.mbits = mask;
   return result;
 }
 
+
+
+
+
+
+
 CORNER_CASES_CUBEXX_INLINE
-bool corner_t::operator!=(const corner_t& other) const
+constexpr direction_set_t::direction_set_t()
+  : base_t()
 {
-  assert(is_sane());
-  return mbits != other.mbits;
+
 }
 
+template<typename T, typename>
 CORNER_CASES_CUBEXX_INLINE
-bool corner_t::operator==(const corner_t& other) const
+constexpr direction_set_t::direction_set_t(const T& v)
+  : base_t(v)
 {
-  assert(is_sane());
-  return mbits == other.mbits;
+
 }
 
+
 CORNER_CASES_CUBEXX_INLINE
-const corner_t&
-corner_t::
-adjacent(const direction_t& direction) const
+constexpr face_set_t::face_set_t()
+  : base_t()
 {
-  assert(is_sane());
-  assert(!is_null());
-  return corner_t::get(detail::wrap_around_2(x() + 2*direction.x()),
-                       detail::wrap_around_2(y() + 2*direction.y()),
-                       detail::wrap_around_2(z() + 2*direction.z()));
+
 }
+
+template<typename T, typename>
 CORNER_CASES_CUBEXX_INLINE
-const corner_t&
-corner_t::
-push(const direction_t& direction) const
+constexpr face_set_t::face_set_t(const T& v)
+  : base_t(v)
 {
-  assert(is_sane());
-  assert(!is_null());
-  return corner_t::get(detail::clamp(x() + direction.x()*2, -1, +1),
-                       detail::clamp(y() + direction.y()*2, -1, +1),
-                       detail::clamp(z() + direction.z()*2, -1, +1));
-}
 
+}
 
-CORNER_CASES_CUBEXX_INLINE
-const corner_t&
-corner_t::
-move(const direction_t& direction) const
-{
-  assert(is_sane());
-  assert(!is_null());
 
 
-  const auto& result = push(direction);
-  if (*this == result)
-    return null_corner();
-  return result;
-}
 
 
 CORNER_CASES_CUBEXX_INLINE
-const edge_t&
-corner_t::
-edge(const direction_t& direction) const
+constexpr corner_set_t::corner_set_t()
+  : base_t()
 {
-  auto precompute = []()
-  {
-    std::array< std::array<edge_t, 12>, 3> internal_results;
-    for (auto corner : corner_t::all())
-    {
-      for (auto direction : direction_t::all())
-      {
-        uint_fast8_t base_axis = direction.axis();
-        uint_fast8_t secondary_axis = (base_axis + 1) % 3;
-        uint_fast8_t tertiary_axis = (base_axis + 2) % 3;
 
-        int xyz[] = {corner.ux(), corner.uy(), corner.uz()};
-
-        bool projected_secondary = xyz[secondary_axis] > 0;
-        bool projected_tertiary = xyz[tertiary_axis] > 0;
+}
 
-        edge_t result = edge_t::get(base_axis, projected_secondary, projected_tertiary);
+template<typename T, typename>
+CORNER_CASES_CUBEXX_INLINE
+constexpr corner_set_t::corner_set_t(const T& v)
+  : base_t(v)
+{
 
-        assert(result.corner_set().contains(corner));
-        assert(result.base_axis() == direction.axis());
+}
 
-        internal_results[base_axis][corner.index()] = result;
-      }
-    }
-    return internal_results;
-  };
 
-  static const auto internal_results = precompute();
+CORNER_CASES_CUBEXX_INLINE
+constexpr edge_set_t::edge_set_t()
+  : base_t()
+{
 
-  assert(is_sane());
-  assert(!is_null());
-  assert(direction.is_sane());
-  assert(!direction.is_null());
+}
 
+template<typename T, typename>
+CORNER_CASES_CUBEXX_INLINE
+constexpr edge_set_t::edge_set_t(const T& v)
+  : base_t(v)
+{
 
-  uint_fast8_t base_axis = direction.axis();
+}
 
-  assert(base_axis < 3);
-  assert(index() < 12);
 
-  const edge_t& result = internal_results[base_axis][index()];
+//###################################################################
 
-  assert(result.corner_set().contains(*this));
 
-  return result;
-}
 
 
-CORNER_CASES_CUBEXX_INLINE
-const edge_t&
-corner_t::
-edge(const corner_t& other) const
-{
-  assert(is_sane());
-  assert(!is_null());
-  assert(other.is_sane());
-  assert(!other.is_null());
 
-  assert(is_adjacent(other));
-  assert(other.is_adjacent(*this));
 
-  return this->edge(this->get_adjacent_direction(other));
-}
+//###################################################################
+//#### topology tables
+//###################################################################
 
+namespace detail{
 
-CORNER_CASES_CUBEXX_INLINE
-const std::array<edge_t,3 >&
-corner_t::
-edges() const
-{
-  typedef std::array<edge_t,3 > result_type;
-  auto precompute = [](){
-    std::array<result_type, 8> internal_results;
-    
-    
-    for (auto corner : corner_t::all())
-    {
-      for (auto axis : {0U, 1U, 2U})
-      {
-        auto corner_xyz = corner.xyz();
-        
-        ///flip one component
-        corner_xyz[axis] = -corner_xyz[axis];
-        
-        corner_t other_corner = corner_t::get(corner_xyz[0],corner_xyz[1],corner_xyz[2]);
-        
-        assert(corner.is_adjacent(other_corner));
-        assert(other_corner.is_adjacent(corner));
-        internal_results[corner.index()][axis] = corner.edge(other_corner);
-      }
-    }
-    
-    return internal_results;
-  };
+/**
+ * Every relation between the cube elements, in one cache-line-aligned block.
+ *
+ * Relations that can be recovered from another table with a little arithmetic
+ * are not stored (face_t::flip(), edge_t::opposite(const face_t&) and friends).
+ * Fields are grouped by the element they are looked up by, so that a traversal
+ * over, say, edges stays within a couple of cache lines.
+ */
+struct alignas(64) topology_t
+{
+  std::array<direction_t, 6> directions;
+  std::array<face_t, 6> faces;
+  std::array<corner_t, 8> corners;
+  std::array<edge_t, 12> edges;
+  direction_t null_direction;
+  face_t null_face;
+  corner_t null_corner;
+  edge_t null_edge;
   
+  std::array<std::array<corner_t,2>, 12> edge_corners;
+  std::array<std::array<face_t,2>, 12> edge_faces;
+  std::array<std::array<edge_t,4>, 12> edge_adjacent_edges;
+  ///Indexed by edge, then by end (the corner's bit along the edge's base axis).
+  std::array<std::array<std::array<edge_t,2>,2>, 12> edge_end_adjacent_edges;
+  std::array<corner_set_t, 12> edge_corner_sets;
+  std::array<face_set_t, 12> edge_face_sets;
+  std::array<edge_set_t, 12> edge_adjacent_edge_sets;
+  std::array<std::array<edge_set_t,2>, 12> edge_end_adjacent_edge_sets;
+  ///Indexed by axis; parallel edges share their end faces.
+  std::array<std::array<face_t,2>, 3> axis_end_faces;
+  std::array<face_set_t, 3> axis_end_face_sets;
   
-  static const auto internal_results = precompute();
+  std::array<std::array<corner_t,3>, 8> corner_adjacents;
+  std::array<std::array<edge_t,3>, 8> corner_edges;
+  std::array<std::array<face_t,3>, 8> corner_faces;
+  std::array<corner_set_t, 8> corner_adjacent_sets;
+  std::array<edge_set_t, 8> corner_edge_sets;
+  std::array<face_set_t, 8> corner_face_sets;
+  ///Indexed by `corner * 8 + corner`; the null edge for corners that are not adjacent.
+  std::array<edge_t, 64> corner_pair_edges;
+  std::array<std::array<std::int_fast8_t,3>, 8> corner_xyz;
+  std::array<std::array<std::uint_fast8_t,3>, 8> corner_uxyz;
   
-  assert(is_sane());
-  assert(!is_null());
+  std::array<std::array<corner_t,4>, 6> face_corners;
+  std::array<std::array<edge_t,4>, 6> face_edges;
+  std::array<std::array<face_t,4>, 6> face_adjacents;
+  std::array<std::array<edge_t,4>, 6> face_perpendicular_edges;
+  std::array<corner_set_t, 6> face_corner_sets;
+  std::array<edge_set_t, 6> face_edge_sets;
+  std::array<face_set_t, 6> face_adjacent_sets;
+  
+  std::array<std::array<direction_t,4>, 6> direction_adjacents;
+  std::array<direction_set_t, 6> direction_adjacent_sets;
+  std::array<std::array<std::int_fast8_t,3>, 6> direction_xyz;
+};
+
+/**
+ * Computes every relation between the cube elements from the raw bit
+ * representations alone, so that topology_t can be built by the compiler.
+ * Nothing in here may go through the table-backed accessors (they are not yet
+ * usable while the table is being initialized).
+ */
+struct topology_builder_t
+{
+  typedef std::uint_fast8_t raw_t;
   
-  const result_type& result = internal_results[index()];
   
-  for (const edge_t& edge : result)
+  static constexpr raw_t direction_axis(raw_t d) { return raw_t(2 - (d >> 1)); }
+  static constexpr bool direction_positive(raw_t d) { return (d & 1) != 0; }
+  static constexpr raw_t make_direction(raw_t axis, bool positive)
   {
-    assert(edge.is_sane());
-    assert(!edge.is_null());
-    assert(edge.corner_set().contains(*this));
-    assert(edge.is_adjacent(*this));
-    assert(is_adjacent(edge));
+    return raw_t(((2 - axis) << 1) | (positive ? 1 : 0));
   }
   
-  return result;
-}
-
-
-
-CORNER_CASES_CUBEXX_INLINE
-const edge_set_t&
-corner_t::
-edge_set() const
-{
+  static constexpr raw_t corner_bit(raw_t c, raw_t axis) { return raw_t((c >> axis) & 1); }
+  
+  static constexpr raw_t make_edge(raw_t base_axis, bool project_secondary, bool project_tertiary)
+  {
+    return raw_t((base_axis << 2) | (project_secondary ? 1 : 0) | (project_tertiary ? 2 : 0));
+  }
+  static constexpr raw_t edge_base(raw_t e) { return raw_t(e >> 2); }
+  static constexpr raw_t edge_secondary(raw_t e) { return raw_t((edge_base(e) + 1) % 3); }
+  static constexpr raw_t edge_tertiary(raw_t e) { return raw_t((edge_base(e) + 2) % 3); }
+  static constexpr raw_t edge_corner0(raw_t e)
+  {
+    return raw_t(((e & 1) << edge_secondary(e)) | (((e >> 1) & 1) << edge_tertiary(e)));
+  }
+  static constexpr raw_t edge_corner1(raw_t e) { return raw_t(edge_corner0(e) | (1 << edge_base(e))); }
+  ///The edge running along @p axis that touches corner @p c.
+  static constexpr raw_t corner_edge(raw_t c, raw_t axis)
+  {
+    return make_edge(axis, corner_bit(c, (axis + 1) % 3) != 0, corner_bit(c, (axis + 2) % 3) != 0);
+  }
+  ///The edge between two adjacent corners.
+  static constexpr raw_t edge_by_corners(raw_t a, raw_t b)
+  {
+    return corner_edge(a, raw_t((a ^ b) == 1 ? 0 : ((a ^ b) == 2 ? 1 : 2)));
+  }
+  ///The i-th face of an edge; the face along the secondary axis, then the one along the tertiary axis.
+  static constexpr raw_t edge_face(raw_t e, raw_t i)
+  {
+    return i == 0 ? make_direction(edge_secondary(e), (e & 1) != 0)
+                  : make_direction(edge_tertiary(e), (e & 2) != 0);
+  }
   
-  auto precompute = [](){
-    std::array<edge_set_t, 8> internal_results;
-    
-    
-    for (auto corner : corner_t::all())
+  ///The i-th corner of a face, iterating the two remaining axes (in modular order) from low to high.
+  static constexpr raw_t face_corner(raw_t f, raw_t i)
+  {
+    return raw_t( ((direction_positive(f) ? 1 : 0) << direction_axis(f))
+                | (((i >> 1) & 1) << ((direction_axis(f) + 1) % 3))
+                | ((i & 1) << ((direction_axis(f) + 2) % 3)));
+  }
+  ///The i-th corner of a face, winding around the face.
+  static constexpr raw_t face_winding_corner(raw_t f, raw_t i)
+  {
+    return face_corner(f, raw_t(((i == 1 || i == 2) ? 2 : 0) | (i >= 2 ? 1 : 0)));
+  }
+  ///The i-th adjacent direction, in index order starting after @p d.
+  static constexpr raw_t direction_adjacent(raw_t d, raw_t i)
+  {
+    for (raw_t k = 1; k < 6; ++k)
     {
-      internal_results[corner.index()] = edge_set_t(corner.edges());
+      raw_t n = raw_t((d + k) % 6);
+      if (direction_axis(n) == direction_axis(d))
+        continue;
+      if (i == 0)
+        return n;
+      --i;
     }
-    
-    return internal_results;
-  };
+    return 6;
+  }
   
   
-  static const auto internal_results = precompute();
   
-  assert(is_sane());
-  assert(!is_null());
+  static constexpr direction_t direction(std::size_t i) { return direction_t(raw_t(i)); }
+  static constexpr face_t face(std::size_t i) { return face_t(direction(i)); }
+  static constexpr corner_t corner(std::size_t i) { return corner_t(raw_t(i)); }
+  static constexpr edge_t edge(std::size_t i) { return edge_t(raw_t(i)); }
+  
+  ///Build an array by applying @p f to each index in the sequence.
+  template<typename F, std::size_t... I>
+  static constexpr auto tabulate(F f, std::index_sequence<I...>)
+    -> std::array<decltype(f(0)), sizeof...(I)>
+  {
+    return {{ f(I)... }};
+  }
+  
+  
+  
+  static constexpr std::array<std::int_fast8_t,3> direction_xyz(std::size_t d)
+  {
+    return {{ std::int_fast8_t(direction_axis(d) == 0 ? (direction_positive(d) ? 1 : -1) : 0)
+            , std::int_fast8_t(direction_axis(d) == 1 ? (direction_positive(d) ? 1 : -1) : 0)
+            , std::int_fast8_t(direction_axis(d) == 2 ? (direction_positive(d) ? 1 : -1) : 0) }};
+  }
+  static constexpr std::array<direction_t,4> direction_adjacents(std::size_t d)
+  {
+    return {{ direction(direction_adjacent(d, 0)), direction(direction_adjacent(d, 1))
+            , direction(direction_adjacent(d, 2)), direction(direction_adjacent(d, 3)) }};
+  }
+  static constexpr direction_set_t direction_adjacent_set(std::size_t d)
+  {
+    direction_set_t result;
+    for (raw_t i = 0; i < 4; ++i)
+      result |= direction(direction_adjacent(d, i));
+    return result;
+  }
   
-  const edge_set_t& result = internal_results[index()];
   
-  for (const edge_t& edge : result)
+  static constexpr std::array<face_t,4> face_adjacents(std::size_t f)
+  {
+    return {{ face(direction_adjacent(f, 0)), face(direction_adjacent(f, 1))
+            , face(direction_adjacent(f, 2)), face(direction_adjacent(f, 3)) }};
+  }
+  static constexpr face_set_t face_adjacent_set(std::size_t f)
+  {
+    face_set_t result;
+    for (raw_t i = 0; i < 4; ++i)
+      result |= face(direction_adjacent(f, i));
+    return result;
+  }
+  static constexpr std::array<corner_t,4> face_corners(std::size_t f)
+  {
+    return {{ corner(face_corner(f, 0)), corner(face_corner(f, 1))
+            , corner(face_corner(f, 2)), corner(face_corner(f, 3)) }};
+  }
+  static constexpr corner_set_t face_corner_set(std::size_t f)
+  {
+    corner_set_t result;
+    for (raw_t i = 0; i < 4; ++i)
+      result |= corner(face_corner(f, i));
+    return result;
+  }
+  static constexpr raw_t face_edge(raw_t f, raw_t i)
+  {
+    return edge_by_corners(face_winding_corner(f, i), face_winding_corner(f, raw_t((i + 1) % 4)));
+  }
+  static constexpr std::array<edge_t,4> face_edges(std::size_t f)
+  {
+    return {{ edge(face_edge(f, 0)), edge(face_edge(f, 1))
+            , edge(face_edge(f, 2)), edge(face_edge(f, 3)) }};
+  }
+  static constexpr edge_set_t face_edge_set(std::size_t f)
+  {
+    edge_set_t result;
+    for (raw_t i = 0; i < 4; ++i)
+      result |= edge(face_edge(f, i));
+    return result;
+  }
+  static constexpr std::array<edge_t,4> face_perpendicular_edges(std::size_t f)
   {
-    assert(edge.is_sane());
-    assert(!edge.is_null());
-    assert(edge.corner_set().contains(*this));
-    assert(edge.is_adjacent(*this));
-    assert(is_adjacent(edge));
+    return {{ edge(corner_edge(face_corner(f, 0), direction_axis(f)))
+            , edge(corner_edge(face_corner(f, 1), direction_axis(f)))
+            , edge(corner_edge(face_corner(f, 2), direction_axis(f)))
+            , edge(corner_edge(face_corner(f, 3), direction_axis(f))) }};
   }
   
-  return result;
-}
+  
+  static constexpr std::array<corner_t,3> corner_adjacents(std::size_t c)
+  {
+    return {{ corner(c ^ 1), corner(c ^ 2), corner(c ^ 4) }};
+  }
+  static constexpr corner_set_t corner_adjacent_set(std::size_t c)
+  {
+    return corner_set_t(corner(c ^ 1)) | corner(c ^ 2) | corner(c ^ 4);
+  }
+  static constexpr std::array<face_t,3> corner_faces(std::size_t c)
+  {
+    return {{ face(make_direction(0, corner_bit(c, 0) != 0))
+            , face(make_direction(1, corner_bit(c, 1) != 0))
+            , face(make_direction(2, corner_bit(c, 2) != 0)) }};
+  }
+  static constexpr face_set_t corner_face_set(std::size_t c)
+  {
+    return face_set_t(face(make_direction(0, corner_bit(c, 0) != 0)))
+         | face(make_direction(1, corner_bit(c, 1) != 0))
+         | face(make_direction(2, corner_bit(c, 2) != 0));
+  }
+  static constexpr std::array<edge_t,3> corner_edges(std::size_t c)
+  {
+    return {{ edge(corner_edge(c, 0)), edge(corner_edge(c, 1)), edge(corner_edge(c, 2)) }};
+  }
+  static constexpr edge_set_t corner_edge_set(std::size_t c)
+  {
+    return edge_set_t(edge(corner_edge(c, 0))) | edge(corner_edge(c, 1)) | edge(corner_edge(c, 2));
+  }
+  static constexpr std::array<std::int_fast8_t,3> corner_xyz(std::size_t c)
+  {
+    return {{ std::int_fast8_t(corner_bit(c, 0) ? 1 : -1)
+            , std::int_fast8_t(corner_bit(c, 1) ? 1 : -1)
+            , std::int_fast8_t(corner_bit(c, 2) ? 1 : -1) }};
+  }
+  static constexpr std::array<std::uint_fast8_t,3> corner_uxyz(std::size_t c)
+  {
+    return {{ corner_bit(c, 0), corner_bit(c, 1), corner_bit(c, 2) }};
+  }
+  
+  
+  static constexpr std::array<corner_t,2> edge_corners(std::size_t e)
+  {
+    return {{ corner(edge_corner0(e)), corner(edge_corner1(e)) }};
+  }
+  static constexpr corner_set_t edge_corner_set(std::size_t e)
+  {
+    return corner_set_t(corner(edge_corner0(e))) | corner(edge_corner1(e));
+  }
+  static constexpr std::array<face_t,2> edge_faces(std::size_t e)
+  {
+    return {{ face(edge_face(e, 0)), face(edge_face(e, 1)) }};
+  }
+  static constexpr face_set_t edge_face_set(std::size_t e)
+  {
+    return face_set_t(face(edge_face(e, 0))) | face(edge_face(e, 1));
+  }
+  ///The i-th edge touching corner @p c, other than @p e itself; the edges along the
+  /// remaining axes, from the highest axis down.
+  static constexpr raw_t edge_adjacent_edge(raw_t e, raw_t c, raw_t i)
+  {
+    return i == 0 ? corner_edge(c, edge_base(e) == 2 ? 1 : 2)
+                  : corner_edge(c, edge_base(e) == 0 ? 1 : 0);
+  }
+  static constexpr std::array<edge_t,4> edge_adjacent_edges(std::size_t e)
+  {
+    return {{ edge(edge_adjacent_edge(e, edge_corner0(e), 0)), edge(edge_adjacent_edge(e, edge_corner0(e), 1))
+            , edge(edge_adjacent_edge(e, edge_corner1(e), 0)), edge(edge_adjacent_edge(e, edge_corner1(e), 1)) }};
+  }
+  static constexpr edge_set_t edge_adjacent_edge_set(std::size_t e)
+  {
+    return edge_set_t(edge(edge_adjacent_edge(e, edge_corner0(e), 0)))
+         | edge(edge_adjacent_edge(e, edge_corner0(e), 1))
+         | edge(edge_adjacent_edge(e, edge_corner1(e), 0))
+         | edge(edge_adjacent_edge(e, edge_corner1(e), 1));
+  }
+  ///The corner at end @p end of edge @p e; corner0 for 0 and corner1 for 1.
+  static constexpr raw_t edge_end_corner(raw_t e, raw_t end)
+  {
+    return end ? edge_corner1(e) : edge_corner0(e);
+  }
+  static constexpr std::array<edge_t,2> edge_end_adjacent_edges_at(raw_t e, raw_t end)
+  {
+    return {{ edge(edge_adjacent_edge(e, edge_end_corner(e, end), 0))
+            , edge(edge_adjacent_edge(e, edge_end_corner(e, end), 1)) }};
+  }
+  static constexpr edge_set_t edge_end_adjacent_edge_set_at(raw_t e, raw_t end)
+  {
+    return edge_set_t(edge(edge_adjacent_edge(e, edge_end_corner(e, end), 0)))
+         | edge(edge_adjacent_edge(e, edge_end_corner(e, end), 1));
+  }
+  static constexpr std::array<std::array<edge_t,2>,2> edge_end_adjacent_edges(std::size_t e)
+  {
+    return {{ edge_end_adjacent_edges_at(raw_t(e), 0), edge_end_adjacent_edges_at(raw_t(e), 1) }};
+  }
+  static constexpr std::array<edge_set_t,2> edge_end_adjacent_edge_sets(std::size_t e)
+  {
+    return {{ edge_end_adjacent_edge_set_at(raw_t(e), 0), edge_end_adjacent_edge_set_at(raw_t(e), 1) }};
+  }
+  static constexpr std::array<face_t,2> axis_end_faces(std::size_t axis)
+  {
+    return {{ face(make_direction(axis, false)), face(make_direction(axis, true)) }};
+  }
+  static constexpr face_set_t axis_end_face_set(std::size_t axis)
+  {
+    return face_set_t(face(make_direction(axis, false))) | face(make_direction(axis, true));
+  }
+  ///@p ab is `a * corner_t::SIZE() + b`; the null edge if the corners are not adjacent.
+  static constexpr edge_t corner_pair_edge(std::size_t ab)
+  {
+    return has_exactly_one_bit(ab / 8 ^ ab % 8)
+         ? edge(edge_by_corners(ab / 8, ab % 8))
+         : edge_t();
+  }
+  
+  
+  
+  static constexpr topology_t build()
+  {
+    return topology_t{
+        tabulate(&direction, std::make_index_sequence<6>())
+      , tabulate(&face, std::make_index_sequence<6>())
+      , tabulate(&corner, std::make_index_sequence<8>())
+      , tabulate(&edge, std::make_index_sequence<12>())
+      , direction_t()
+      , face_t()
+      , corner_t()
+      , edge_t()
+      
+      , tabulate(&edge_corners, std::make_index_sequence<12>())
+      , tabulate(&edge_faces, std::make_index_sequence<12>())
+      , tabulate(&edge_adjacent_edges, std::make_index_sequence<12>())
+      , tabulate(&edge_end_adjacent_edges, std::make_index_sequence<12>())
+      , tabulate(&edge_corner_set, std::make_index_sequence<12>())
+      , tabulate(&edge_face_set, std::make_index_sequence<12>())
+      , tabulate(&edge_adjacent_edge_set, std::make_index_sequence<12>())
+      , tabulate(&edge_end_adjacent_edge_sets, std::make_index_sequence<12>())
+      , tabulate(&axis_end_faces, std::make_index_sequence<3>())
+      , tabulate(&axis_end_face_set, std::make_index_sequence<3>())
+      
+      , tabulate(&corner_adjacents, std::make_index_sequence<8>())
+      , tabulate(&corner_edges, std::make_index_sequence<8>())
+      , tabulate(&corner_faces, std::make_index_sequence<8>())
+      , tabulate(&corner_adjacent_set, std::make_index_sequence<8>())
+      , tabulate(&corner_edge_set, std::make_index_sequence<8>())
+      , tabulate(&corner_face_set, std::make_index_sequence<8>())
+      , tabulate(&corner_pair_edge, std::make_index_sequence<64>())
+      , tabulate(&corner_xyz, std::make_index_sequence<8>())
+      , tabulate(&corner_uxyz, std::make_index_sequence<8>())
+      
+      , tabulate(&face_corners, std::make_index_sequence<6>())
+      , tabulate(&face_edges, std::make_index_sequence<6>())
+      , tabulate(&face_adjacents, std::make_index_sequence<6>())
+      , tabulate(&face_perpendicular_edges, std::make_index_sequence<6>())
+      , tabulate(&face_corner_set, std::make_index_sequence<6>())
+      , tabulate(&face_edge_set, std::make_index_sequence<6>())
+      , tabulate(&face_adjacent_set, std::make_index_sequence<6>())
+      
+      , tabulate(&direction_adjacents, std::make_index_sequence<6>())
+      , tabulate(&direction_adjacent_set, std::make_index_sequence<6>())
+      , tabulate(&direction_xyz, std::make_index_sequence<6>())
+    };
+  }
+};
 
-CORNER_CASES_CUBEXX_INLINE
-const direction_t&
-corner_t::get_adjacent_direction(const corner_t& other) const
+
+
+template<typename T>
+struct topology_tables_t
 {
-  assert(is_sane());
-  assert(!is_null());
-  assert(other.is_sane());
-  assert(!other.is_null());
-  assert(is_adjacent(other));
-  assert(other.is_adjacent(*this));
+  static constexpr topology_t topology = topology_builder_t::build();
+};
 
-  int xyz[] = {other.x() - x(), other.y() - y(), other.z() - z()};
+template<typename T> constexpr topology_t topology_tables_t<T>::topology;
 
-  return direction_t::get(xyz[0], xyz[1], xyz[2]);
-}
+static_assert(alignof(topology_t) == 64, "topology_t should start on a cache line");
+static_assert(sizeof(topology_t) <= 12 * 64, "topology_t should fit in a dozen cache lines");
 
+///The one and only topology table.
 CORNER_CASES_CUBEXX_INLINE
-bool
-corner_t::is_adjacent(const corner_t& other) const
+constexpr const topology_t& topology()
 {
-  assert(is_sane());
-  assert(!is_null());
-  assert(other.is_sane());
-  assert(!other.is_null());
-  return detail::has_exactly_one_bit(mbits ^ other.mbits);
+  return topology_tables_t<>::topology;
 }
 
-CORNER_CASES_CUBEXX_INLINE
-bool
-corner_t::is_adjacent(const edge_t& edge) const
-{
-  assert(is_sane());
-  assert(!is_null());
-  assert(edge.is_sane());
-  assert(!edge.is_null());
-  
-  
-  return edge.corner0() == *this || edge.corner1() == *this;
-}
-
-CORNER_CASES_CUBEXX_INLINE
-bool
-corner_t::is_adjacent(const face_t& face) const
-{
-
-  assert(is_sane());
-  assert(!is_null());
-  assert(face.is_sane());
-  assert(!face.is_null());
-  
-
-  uint_fast8_t axis = face.direction().axis();
-  auto direction_xyz = face.direction().xyz();
-  auto corner_xyz = this->xyz();
+} // namespace detail
 
-  return corner_xyz[axis] == direction_xyz[axis];
-}
 //###################################################################
 
 
 
 
+
 //###################################################################
-//#### edge_t
+//#### face_t
 //###################################################################
 
 
-namespace detail{
-  CORNER_CASES_CUBEXX_INLINE
-  std::array<corner_t, 2>
-  make_edge_corners(const corner_t& a, const corner_t& b)
-  {
-    std::array<corner_t, 2> result =
-    {{
-      (a.index() < b.index() ? a : b),
-      (a.index() < b.index() ? b : a)
-    }};
-    return result;
-  }
-} // namespace detail
-
-CORNER_CASES_CUBEXX_INLINE
-edge_t::
-edge_t()
-  : mbits(0b1100)
-{
-  assert(is_sane());
-  assert(is_null());
-}
-CORNER_CASES_CUBEXX_INLINE
-edge_t::
-edge_t(const std::bitset<4>& bits)
-  : mbits(bits)
-{
-  assert(is_sane());
-}
-
-
-CORNER_CASES_CUBEXX_INLINE
-bool
-edge_t::
-is_null() const
-{
-  return mbits == std::bitset<4>(0b1100);
-}
-
-CORNER_CASES_CUBEXX_INLINE
-bool
-edge_t::
-is_sane() const
-{
-  return mbits.to_ulong() <= 0b1100;
-}
-
-CORNER_CASES_CUBEXX_INLINE
-const edge_t&
-edge_t::
-null_edge()
-{
-  static const auto internal_result = edge_t();
-  return internal_result;
-}
-
-
-CORNER_CASES_CUBEXX_INLINE
-std::uint_fast8_t
-edge_t::
-base_axis() const
-{
-  auto calc = [](const std::bitset<4>& bits){
-    auto base_axis = std::uint_fast8_t((bits >> 2).to_ulong());
-    assert(base_axis < 3);
-    return std::uint_fast8_t(base_axis);
-  };
-
-  static const std::uint_fast8_t internal_result[] = {
-      calc(edge_t::get(0).mbits)
-    , calc(edge_t::get(1).mbits)
-    , calc(edge_t::get(2).mbits)
-    , calc(edge_t::get(3).mbits)
-    , calc(edge_t::get(4).mbits)
-    , calc(edge_t::get(5).mbits)
-    , calc(edge_t::get(6).mbits)
-    , calc(edge_t::get(7).mbits)
-    , calc(edge_t::get(8).mbits)
-    , calc(edge_t::get(9).mbits)
-    , calc(edge_t::get(10).mbits)
-    , calc(edge_t::get(11).mbits)
-  };
-  assert(!is_null());
-  assert(is_sane());
-  assert(index() < 12);
-
-
-  return internal_result[index()];
-}
-
-CORNER_CASES_CUBEXX_INLINE
-std::uint_fast8_t
-edge_t::
-secondary_axis() const
-{
-  auto calc = [](const std::bitset<4>& bits){
-    auto base_axis = std::uint_fast8_t((bits >> 2).to_ulong());
-    assert(base_axis < 3);
-
-    return std::uint_fast8_t((base_axis + 1) % 3);
-  };
-
-  static const std::uint_fast8_t internal_result[] = {
-      calc(edge_t::get(0).mbits)
-    , calc(edge_t::get(1).mbits)
-    , calc(edge_t::get(2).mbits)
-    , calc(edge_t::get(3).mbits)
-    , calc(edge_t::get(4).mbits)
-    , calc(edge_t::get(5).mbits)
-    , calc(edge_t::get(6).mbits)
-    , calc(edge_t::get(7).mbits)
-    , calc(edge_t::get(8).mbits)
-    , calc(edge_t::get(9).mbits)
-    , calc(edge_t::get(10).mbits)
-    , calc(edge_t::get(11).mbits)
-  };
-  assert(!is_null());
-  assert(is_sane());
-  assert(index() < 12);
-
-
-  return internal_result[index()];
-}
-
-
-CORNER_CASES_CUBEXX_INLINE
-std::uint_fast8_t
-edge_t::
-tertiary_axis() const
-{
-  auto precompute = [](const std::bitset<4>& bits){
-    auto base_axis = std::uint_fast8_t((bits >> 2).to_ulong());
-    assert(base_axis < 3);
-
-    return std::uint_fast8_t((base_axis + 2) % 3);
-  };
-
-  static const std::uint_fast8_t internal_result[] = {
-      precompute(edge_t::get(0).mbits)
-    , precompute(edge_t::get(1).mbits)
-    , precompute(edge_t::get(2).mbits)
-    , precompute(edge_t::get(3).mbits)
-    , precompute(edge_t::get(4).mbits)
-    , precompute(edge_t::get(5).mbits)
-    , precompute(edge_t::get(6).mbits)
-    , precompute(edge_t::get(7).mbits)
-    , precompute(edge_t::get(8).mbits)
-    , precompute(edge_t::get(9).mbits)
-    , precompute(edge_t::get(10).mbits)
-    , precompute(edge_t::get(11).mbits)
-  };
-  assert(!is_null());
-  assert(is_sane());
-  assert(index() < 12);
-
-
-  return internal_result[index()];
-}
-
-
-CORNER_CASES_CUBEXX_INLINE
-bool
-edge_t::
-project_secondary() const
-{
-  assert(!is_null());
-  assert(is_sane());
-  return mbits.test(0);
-}
-
-CORNER_CASES_CUBEXX_INLINE
-bool
-edge_t::
-project_tertiary() const
-{
-  assert(!is_null());
-  assert(is_sane());
-  return mbits.test(1);
-}
-
-CORNER_CASES_CUBEXX_INLINE
-bool
-edge_t::
-is_adjacent(const edge_t& other) const
-{
-  assert(is_sane());
-  assert(!is_null());
-  assert(other.is_sane());
-  assert(!other.is_null());
-
-  return (other.corner_set() & this->corner_set()).size() == 1;
-}
-
-CORNER_CASES_CUBEXX_INLINE
-bool
-edge_t::
-is_adjacent(const face_t& face) const
-{
-  assert(is_sane());
-  assert(!is_null());
-  assert(face.is_sane());
-  assert(!face.is_null());
-
-  return (face.corner_set() & this->corner_set()).size() == 2;
-}
-
-CORNER_CASES_CUBEXX_INLINE
-bool
-edge_t::
-is_adjacent(const corner_t& corner) const
-{
-  assert(is_sane());
-  assert(!is_null());
-  assert(corner.is_sane());
-  assert(!corner.is_null());
-
-  return this->corner_set().contains(corner);
-}
-
-
-
-
-
-
-
-
-CORNER_CASES_CUBEXX_INLINE
-const edge_t&
-edge_t::
-get(std::uint_fast8_t base_axis, bool project_secondary, bool project_tertiary)
-{
-  assert(base_axis < 3);
-
-
-  std::uint_fast8_t bits = base_axis << 2;
-
-  bits |= (project_secondary ? 1 : 0) << 0;
-  bits |= (project_tertiary ? 1 : 0) << 1;
-
-  assert(bits < 12);
-
-  const edge_t& result = edge_t::get(bits);
-
-  assert(result.base_axis() == base_axis);
-  assert(result.project_secondary() == project_secondary);
-  assert(result.project_tertiary() == project_tertiary);
-
-  return result;
-}
-
-CORNER_CASES_CUBEXX_INLINE
-const edge_t&
-edge_t::
-get(const corner_t& lhs, const corner_t& rhs)
-{
-    auto precompute = [](){
-        std::array<edge_t, 144> internal_results;
-
-        for (auto lhs : corner_t::all())
-        {
-            for (auto direction : direction_t::all())
-            {
-                auto rhs = lhs.adjacent(direction);
-
-                size_t idx = lhs.index() + rhs.index()*corner_t::SIZE();
-
-                assert(idx < 144);
-
-                internal_results[idx] = lhs.edge(rhs);
-            }
-        }
-
-        return internal_results;
-    };
-
-    assert(lhs.is_sane());
-    assert(!lhs.is_null());
-    assert(rhs.is_sane());
-    assert(!rhs.is_null());
-    assert(lhs != rhs);
-    assert(lhs.is_adjacent(rhs));
-
-    static const std::array<edge_t, 144> internal_results = precompute();
-
-    size_t idx = lhs.index() + rhs.index()*corner_t::SIZE();
-
-    assert(idx < 144);
-
-    const edge_t& internal_result = internal_results[idx];
-    assert(internal_result.is_sane());
-    assert(!internal_result.is_null());
-    assert(internal_result.corner_set().contains(lhs));
-    assert(internal_result.corner_set().contains(rhs));
-
-    return internal_result;
-}
-
-
-CORNER_CASES_CUBEXX_INLINE
-const edge_t&
-edge_t::
-get(std::uint_fast8_t idx)
-{
-  assert(idx < 12);
-  const auto& result = all()[idx];
-
-  assert(!result.is_null());
-  assert(result.is_sane());
-
-  return result;
-}
-
-CORNER_CASES_CUBEXX_INLINE
-std::uint_fast8_t
-edge_t::
-index() const
-{
-  assert(!is_null());
-  assert(is_sane());
-
-  std::uint_fast8_t result = mbits.to_ulong();
-  assert(result < SIZE());
-  return result;
-}
-
-
-
-
-CORNER_CASES_CUBEXX_INLINE
-const corner_t&
-edge_t::
-calc_corner0() const
-{
-  assert(!is_null());
-  assert(is_sane());
-  assert(index() < 12);
-
-  int xyz[] = {-1, -1, -1};
-
-  xyz[secondary_axis()] += project_secondary() ? 2 : 0;
-  xyz[tertiary_axis()] += project_tertiary() ? 2 : 0;
-  return corner_t::get( xyz[0], xyz[1], xyz[2] );
-}
-
-CORNER_CASES_CUBEXX_INLINE
-const corner_t&
-edge_t::
-calc_corner1() const
-{
-  assert(!is_null());
-  assert(is_sane());
-  assert(index() < 12);
-
-  int xyz[] = {-1, -1, -1};
-
-  xyz[secondary_axis()] += project_secondary() ? 2 : 0;
-  xyz[tertiary_axis()] += project_tertiary() ? 2 : 0;
-  xyz[base_axis()] += 2;
-  return corner_t::get( xyz[0], xyz[1], xyz[2] );
-}
-
-CORNER_CASES_CUBEXX_INLINE
-const corner_t&
-edge_t::
-corner0() const
-{
-  static const corner_t internal_results[] = {
-      edge_t::get(0).calc_corner0()
-    , edge_t::get(1).calc_corner0()
-    , edge_t::get(2).calc_corner0()
-    , edge_t::get(3).calc_corner0()
-    , edge_t::get(4).calc_corner0()
-    , edge_t::get(5).calc_corner0()
-    , edge_t::get(6).calc_corner0()
-    , edge_t::get(7).calc_corner0()
-    , edge_t::get(8).calc_corner0()
-    , edge_t::get(9).calc_corner0()
-    , edge_t::get(10).calc_corner0()
-    , edge_t::get(11).calc_corner0()
-  };
-  assert(!is_null());
-  assert(is_sane());
-  assert(index() < 12);
-
-  return internal_results[index()];
-}
-
-
-CORNER_CASES_CUBEXX_INLINE
-const corner_t&
-edge_t::
-corner1() const
-{
-  static const corner_t internal_results[] = {
-      edge_t::get(0).calc_corner1()
-    , edge_t::get(1).calc_corner1()
-    , edge_t::get(2).calc_corner1()
-    , edge_t::get(3).calc_corner1()
-    , edge_t::get(4).calc_corner1()
-    , edge_t::get(5).calc_corner1()
-    , edge_t::get(6).calc_corner1()
-    , edge_t::get(7).calc_corner1()
-    , edge_t::get(8).calc_corner1()
-    , edge_t::get(9).calc_corner1()
-    , edge_t::get(10).calc_corner1()
-    , edge_t::get(11).calc_corner1()
-  };
-  assert(!is_null());
-  assert(is_sane());
-  assert(index() < 12);
-
-  return internal_results[index()];
-}
-
-
-CORNER_CASES_CUBEXX_INLINE
-const edge_t&
-edge_t::
-calc_opposite() const
-{
-  assert(!is_null());
-  assert(is_sane());
-
-  return edge_t::get(base_axis(), !project_secondary(), !project_tertiary());
-}
-
-CORNER_CASES_CUBEXX_INLINE
-const edge_t&
-edge_t::
-opposite() const
-{
-
-  static const edge_t internal_results[] = {
-      edge_t::get(0).calc_opposite()
-    , edge_t::get(1).calc_opposite()
-    , edge_t::get(2).calc_opposite()
-    , edge_t::get(3).calc_opposite()
-    , edge_t::get(4).calc_opposite()
-    , edge_t::get(5).calc_opposite()
-    , edge_t::get(6).calc_opposite()
-    , edge_t::get(7).calc_opposite()
-    , edge_t::get(8).calc_opposite()
-    , edge_t::get(9).calc_opposite()
-    , edge_t::get(10).calc_opposite()
-    , edge_t::get(11).calc_opposite()
-  };
-  assert(!is_null());
-  assert(is_sane());
-  assert(index() < 12);
-
-  return internal_results[index()];
-}
-
-
-
-CORNER_CASES_CUBEXX_INLINE
-const edge_t&
-edge_t::
-opposite(const face_t& face) const
-{
-    auto precompute = [](){
-        std::array< std::array<edge_t, 6>, 12> internal_results;
-
-        for (auto edge : edge_t::all())
-        {
-            corner_t lhs = edge.corner0();
-            corner_t rhs = edge.corner1();
-
-            for (auto face : edge.faces())
-            {
-                auto other_corners = face.corner_set() - lhs - rhs;
-
-                std::vector<corner_t> opposite_corners(other_corners.begin(),other_corners.end());
-
-                auto opposite_edge = edge_t::get(opposite_corners[0], opposite_corners[1]);
-                internal_results[edge.index()][face.index()] = opposite_edge;
-            }
-        }
-
-        return internal_results;
-    };
-
-    static const auto internal_results = precompute();
-
-    assert(is_sane());
-    assert(!is_null());
-    assert(is_adjacent(face));
-    assert(face.is_adjacent(*this));
-
-    const auto& result = internal_results[index()][face.index()];
-
-    assert(result.is_sane());
-    assert(!result.is_null());
-
-    return result;
-}
-
-
-
-CORNER_CASES_CUBEXX_INLINE
-bool
-edge_t::
-operator==(const edge_t& other) const
-{
-  assert(is_sane());
-  assert(other.is_sane());
-  return mbits == other.mbits;
-}
-
 CORNER_CASES_CUBEXX_INLINE
-bool
-edge_t::
-operator!=(const edge_t& other) const
+constexpr const face_t&
+face_t::null_face()
 {
-  assert(is_sane());
-  assert(other.is_sane());
-  return mbits != other.mbits;
+  return detail::topology().null_face;
 }
 
-CORNER_CASES_CUBEXX_INLINE
-bool
-edge_t::
-operator<(const edge_t& other) const
-{
-  assert(is_sane());
-  assert(!is_null());
-  assert(other.is_sane());
-  assert(!other.is_null());
-  return index() < other.index();
-}
 
 CORNER_CASES_CUBEXX_INLINE
-const std::array<corner_t, 2>&
-edge_t::
-corners() const
+constexpr const std::array< face_t, 6 >&
+face_t::all()
 {
-  static const std::array<corner_t, 2> internal_results[] = {
-      std::array<corner_t, 2>{edge_t::get(0).calc_corner0(), edge_t::get(0).calc_corner1()}
-    , std::array<corner_t, 2>{edge_t::get(1).calc_corner0(), edge_t::get(1).calc_corner1()}
-    , std::array<corner_t, 2>{edge_t::get(2).calc_corner0(), edge_t::get(2).calc_corner1()}
-    , std::array<corner_t, 2>{edge_t::get(3).calc_corner0(), edge_t::get(3).calc_corner1()}
-    , std::array<corner_t, 2>{edge_t::get(4).calc_corner0(), edge_t::get(4).calc_corner1()}
-    , std::array<corner_t, 2>{edge_t::get(5).calc_corner0(), edge_t::get(5).calc_corner1()}
-    , std::array<corner_t, 2>{edge_t::get(6).calc_corner0(), edge_t::get(6).calc_corner1()}
-    , std::array<corner_t, 2>{edge_t::get(7).calc_corner0(), edge_t::get(7).calc_corner1()}
-    , std::array<corner_t, 2>{edge_t::get(8).calc_corner0(), edge_t::get(8).calc_corner1()}
-    , std::array<corner_t, 2>{edge_t::get(9).calc_corner0(), edge_t::get(9).calc_corner1()}
-    , std::array<corner_t, 2>{edge_t::get(10).calc_corner0(), edge_t::get(10).calc_corner1()}
-    , std::array<corner_t, 2>{edge_t::get(11).calc_corner0(), edge_t::get(11).calc_corner1()}
-  };
-  assert(!is_null());
-  assert(is_sane());
-  assert(index() < 12);
-
-  return internal_results[ index() ];
+  return detail::topology().faces;
 }
 
+
 CORNER_CASES_CUBEXX_INLINE
-const corner_set_t&
-edge_t::
-corner_set() const
+constexpr const face_t&
+face_t::get(const direction_t& direction)
 {
-  static const corner_set_t internal_results[] = {
-      corner_set_t(edge_t::get(0).corners())
-    , corner_set_t(edge_t::get(1).corners())
-    , corner_set_t(edge_t::get(2).corners())
-    , corner_set_t(edge_t::get(3).corners())
-    , corner_set_t(edge_t::get(4).corners())
-    , corner_set_t(edge_t::get(5).corners())
-    , corner_set_t(edge_t::get(6).corners())
-    , corner_set_t(edge_t::get(7).corners())
-    , corner_set_t(edge_t::get(8).corners())
-    , corner_set_t(edge_t::get(9).corners())
-    , corner_set_t(edge_t::get(10).corners())
-    , corner_set_t(edge_t::get(11).corners())
-  };
-  assert(!is_null());
-  assert(is_sane());
-  assert(index() < 12);
-
-  return internal_results[ index() ];
+  assert(direction.index() < all().size());
+  return all()[direction.index()];
 }
 
-
 CORNER_CASES_CUBEXX_INLINE
-const std::array<edge_t,4>&
-edge_t::
-adjacent_edges() const
+constexpr const face_t&
+face_t::get(const std::uint_fast8_t& idx)
 {
-  
-  typedef std::array<edge_t,4> result_type;
-  auto precompute = [](){
-    std::array< result_type, 12> internal_results;
-    
-    for (auto edge : edge_t::all())
-    {
-      std::size_t i = 0;
-      for (auto corner : edge.corners())
-      {
-        assert(edge.is_adjacent(corner));
-        assert(corner.is_adjacent(edge));
-        
-        for (auto direction : direction_t::all())
-        {
-          if (direction.axis() == edge.base_axis() || !direction.positive())
-            continue;
-          
-          auto adjacent_edge = corner.edge(direction);
-          
-          assert(i < 4);
-          internal_results[edge.index()][i++] = adjacent_edge;
-        }
-        
-      }
-      assert(i == 4);
-    }
-    
-    return internal_results;
-  };
-  
-  static const auto internal_results = precompute();
-  
-  assert(is_sane());
-  assert(!is_null());
-  
-  
-  
-  
-  const auto& result = internal_results[index()];
-  for (auto edge : result)
-  {
-    assert(edge.is_sane());
-    assert(!edge.is_null());
-    assert(edge.is_adjacent(*this));
-    assert((*this).is_adjacent(edge));
-  }
-  return result;
+  assert(idx < all().size());
+  return all()[idx];
 }
 
 
 CORNER_CASES_CUBEXX_INLINE
-const std::array<edge_t,2>&
-edge_t::
-adjacent_edges(const corner_t& corner) const
+constexpr const face_t& face_t::opposite() const
 {
-  typedef std::array<edge_t,2> result_type;
-  auto precompute = [](){
-    std::array< std::array<result_type, 8>, 12> internal_results;
-    
-    for (auto edge : edge_t::all())
-    {
-      for (auto corner : edge.corners())
-      {
-        assert(edge.is_adjacent(corner));
-        assert(corner.is_adjacent(edge));
-        
-        std::size_t i = 0;
-        for (auto direction : direction_t::all())
-        {
-          if (direction.axis() == edge.base_axis() || !direction.positive())
-            continue;
-          
-          auto adjacent_edge = corner.edge(direction);
-          
-          assert(i < 2);
-          internal_results[edge.index()][corner.index()][i++] = adjacent_edge;
-        }
-        
-        assert(i == 2);
-      }
-    }
-    
-    return internal_results;
-  };
-  
-  static const auto internal_results = precompute();
-  
-  assert(is_sane());
-  assert(!is_null());
-  assert(corner.is_sane());
-  assert(!corner.is_null());
-  
-  
-  assert(is_adjacent(corner));
-  assert(corner.is_adjacent(*this));
-  
-  
-  const auto& result = internal_results[index()][corner.index()];
-  for (auto edge : result)
-  {
-    assert(edge.is_sane());
-    assert(!edge.is_null());
-    assert(edge.is_adjacent(*this));
-    assert((*this).is_adjacent(edge));
-    assert(edge.is_adjacent(corner));
-    assert(corner.is_adjacent(edge));
-  }
-  return result;
+  return face_t::get(mdirection.opposite());
 }
 
-
 CORNER_CASES_CUBEXX_INLINE
-const edge_set_t&
-edge_t::
-adjacent_edge_set() const
+constexpr const std::array<face_t,4>&
+face_t::adjacents() const
 {
-  auto precompute = [](){
-    std::array<edge_set_t, 12> internal_results;
-    for (auto edge : edge_t::all())
-    {
-      internal_results[edge.index()] = edge_set_t(edge.adjacent_edges());
-    }
-    return internal_results;
-  };
-  static const auto internal_results = precompute();
-  
   assert(is_sane());
   assert(!is_null());
-  
-  
-  const auto& result = internal_results[index()];
-  for (auto edge : result)
-  {
-    assert(edge.is_sane());
-    assert(!edge.is_null());
-    assert(edge.is_adjacent(*this));
-    assert((*this).is_adjacent(edge));
-  }
-  return result;
-}
-
 
+  return detail::topology().face_adjacents[index()];
+}
 CORNER_CASES_CUBEXX_INLINE
-const edge_set_t&
-edge_t::
-adjacent_edge_set(const corner_t& corner) const
+constexpr const face_set_t&
+face_t::adjacent_set() const
 {
-  auto precompute = [](){
-    std::array<std::array<edge_set_t, 8>, 12> internal_results;
-    for (auto edge : edge_t::all())
-    {
-      for (auto corner : edge.corners())
-      {
-        assert(corner.is_adjacent(edge));
-        assert(edge.is_adjacent(corner));
-        internal_results[edge.index()][corner.index()] = edge_set_t(edge.adjacent_edges(corner));
-      }
-    }
-    return internal_results;
-  };
-  static const auto internal_results = precompute();
-  
   assert(is_sane());
   assert(!is_null());
-  assert(corner.is_sane());
-  assert(!corner.is_null());
-  
-  assert(corner.is_adjacent(*this));
-  assert((*this).is_adjacent(corner));
 
-  const auto& result = internal_results[index()][corner.index()];
-  for (auto edge : result)
-  {
-    assert(edge.is_sane());
-    assert(!edge.is_null());
-    assert(edge.is_adjacent(*this));
-    assert((*this).is_adjacent(edge));
-  }
-  return result;
+  return detail::topology().face_adjacent_sets[index()];
 }
 
 
 CORNER_CASES_CUBEXX_INLINE
-const face_t&
-edge_t::
-calc_face(uint_fast8_t idx) const
+constexpr const std::array<corner_t, 4>&
+face_t::corners() const
 {
-    assert(idx < 2);
-
-
-    int xyz[2][3] = {{0,0,0}, {0,0,0}};
-
-    xyz[0][secondary_axis()] = project_secondary() ? +1 : -1;
-    xyz[1][tertiary_axis()] = project_tertiary() ? +1 : -1;
-
-    const face_t& result = face_t::get(direction_t::get(xyz[idx][0],xyz[idx][1],xyz[idx][2]));
+  assert(!is_null());
+  assert(is_sane());
+  assert(index() < 6);
 
-    assert(result.is_sane());
-    assert(!result.is_null());
-    return result;
+  return detail::topology().face_corners[index()];
 }
 
 CORNER_CASES_CUBEXX_INLINE
-const face_t&
-edge_t::
-end_face(const corner_t& corner) const
+constexpr const corner_set_t&
+face_t::corner_set() const
 {
-  auto precompute = [](){
-    std::array<std::array<face_t,2>, 12> internal_results;
-    for (auto edge : edge_t::all())
-    {
-      int xyz0[] = {0,0,0};
-      int xyz1[] = {0,0,0};
-
-      xyz0[edge.base_axis()] = -1;
-      xyz1[edge.base_axis()] = +1;
-
-      internal_results[edge.index()][0] = direction_t::get(xyz0[0],xyz0[1],xyz0[2]).face();
-      internal_results[edge.index()][1] = direction_t::get(xyz1[0],xyz1[1],xyz1[2]).face();
-    }
-    return internal_results;
-  };
-
-  static const auto internal_results = precompute();
-
-
-
   assert(!is_null());
   assert(is_sane());
-  assert(index() < 12);
-  assert(corner.is_adjacent(*this));
-  assert((*this).is_adjacent(corner));
-
-  ///either 0 or 1 if this corner is the positive or negative corner of this edge
-  uint_fast8_t corner_id = corner.uxyz()[(*this).base_axis()];
-
-  assert(corner_id == 0 || corner_id == 1);
-
-  const auto& result = internal_results[ index() ][ corner_id];
-
-  assert(corner_set_t(corner) == (result.corner_set() & (*this).corner_set()));
+  assert(index() < 6);
 
-  return result;
+  return detail::topology().face_corner_sets[index()];
 }
 
 CORNER_CASES_CUBEXX_INLINE
-const std::array<face_t, 2>&
-edge_t::
-end_faces() const
+constexpr const std::array<edge_t, 4>&
+face_t::edges() const
 {
-  auto precompute = [](){
-    typedef std::array<face_t,2> result_type;
-    std::array<result_type, 12> internal_results;
-    for (auto edge : edge_t::all())
-    {
-      int xyz0[] = {0,0,0};
-      int xyz1[] = {0,0,0};
-
-      xyz0[edge.base_axis()] = -1;
-      xyz1[edge.base_axis()] = +1;
-
-      internal_results[edge.index()] = {direction_t::get(xyz0[0],xyz0[1],xyz0[2]).face(), direction_t::get(xyz1[0], xyz1[1], xyz1[2]).face()};
-    }
-    return internal_results;
-  };
-
-  static const auto internal_results = precompute();
-
-
-
-  assert(!is_null());
   assert(is_sane());
-  assert(index() < 12);
+  assert(!is_null());
+  assert(index() < 6);
 
-  return internal_results[ index() ];
+  return detail::topology().face_edges[index()];
 }
 
 CORNER_CASES_CUBEXX_INLINE
-const face_set_t&
-edge_t::
-end_face_set() const
+constexpr const edge_set_t&
+face_t::edge_set() const
 {
-  auto precompute = []()
-  {
-    typedef face_set_t result_type;
-
-    std::array<result_type, 12> internal_results;
-
-    for (auto edge : edge_t::all())
-    {
-      internal_results[edge.index()] = face_set_t(edge.end_faces());
-    }
-
-    return internal_results;
-  };
-
-  static const auto internal_results = precompute();
-
-  assert(!is_null());
   assert(is_sane());
-  assert(index() < 12);
+  assert(!is_null());
+  assert(index() < 6);
 
-  return internal_results[ index() ];
+  return detail::topology().face_edge_sets[index()];
 }
 
 CORNER_CASES_CUBEXX_INLINE
-const std::array<face_t, 2>&
-edge_t::
-faces() const
+constexpr const std::array<edge_t, 4>&
+face_t::perpendicular_edges() const
 {
-  static const std::array<face_t, 2> internal_results[] = {
-      std::array<face_t, 2>{edge_t::get(0).calc_face(0), edge_t::get(0).calc_face(1)}
-    , std::array<face_t, 2>{edge_t::get(1).calc_face(0), edge_t::get(1).calc_face(1)}
-    , std::array<face_t, 2>{edge_t::get(2).calc_face(0), edge_t::get(2).calc_face(1)}
-    , std::array<face_t, 2>{edge_t::get(3).calc_face(0), edge_t::get(3).calc_face(1)}
-    , std::array<face_t, 2>{edge_t::get(4).calc_face(0), edge_t::get(4).calc_face(1)}
-    , std::array<face_t, 2>{edge_t::get(5).calc_face(0), edge_t::get(5).calc_face(1)}
-    , std::array<face_t, 2>{edge_t::get(6).calc_face(0), edge_t::get(6).calc_face(1)}
-    , std::array<face_t, 2>{edge_t::get(7).calc_face(0), edge_t::get(7).calc_face(1)}
-    , std::array<face_t, 2>{edge_t::get(8).calc_face(0), edge_t::get(8).calc_face(1)}
-    , std::array<face_t, 2>{edge_t::get(9).calc_face(0), edge_t::get(9).calc_face(1)}
-    , std::array<face_t, 2>{edge_t::get(10).calc_face(0), edge_t::get(10).calc_face(1)}
-    , std::array<face_t, 2>{edge_t::get(11).calc_face(0), edge_t::get(11).calc_face(1)}
-  };
-  assert(!is_null());
   assert(is_sane());
-  assert(index() < 12);
+  assert(!is_null());
 
-  return internal_results[ index() ];
+  return detail::topology().face_perpendicular_edges[index()];
 }
+
+
 CORNER_CASES_CUBEXX_INLINE
-const face_set_t&
-edge_t::
-face_set() const
+constexpr const face_t&
+face_t::flip(const edge_t& edge) const
 {
-  auto precompute = []()
-  {
-    typedef face_set_t result_type;
+  assert(is_sane());
+  assert(!is_null());
+  assert(edge.is_sane());
+  assert(!edge.is_null());
 
-    std::array<result_type, 12> internal_results;
+  assert(is_adjacent(edge));
+  assert(edge.is_adjacent(*this));
 
-    for (auto edge : edge_t::all())
-    {
-      internal_results[edge.index()] = face_set_t(edge.faces());
-    }
+  return edge.faces()[edge.faces()[0] == *this ? 1 : 0];
+}
 
-    return internal_results;
-  };
 
-  static const auto internal_results = precompute();
 
-  assert(!is_null());
+CORNER_CASES_CUBEXX_INLINE
+constexpr bool
+face_t::is_adjacent(const face_t& other) const
+{
   assert(is_sane());
-  assert(index() < 12);
-
-  return internal_results[ index() ];
+  assert(!is_null());
+  assert(other.is_sane());
+  assert(!other.is_null());
+  return mdirection.axis() != other.mdirection.axis();
 }
 
 CORNER_CASES_CUBEXX_INLINE
-const std::array<edge_t, 12>&
-edge_t::
-all()
+constexpr bool
+face_t::is_adjacent(const edge_t& edge) const
 {
 
-
-
-
-  static const std::array<edge_t, 12> result =
-  {{
-    //x-based edge, no projection
-    edge_t(std::bitset<4>(0b0000)),
-    //x-based edge, y-projected
-    edge_t(std::bitset<4>(0b0001)),
-    //x-based edge, z-projected
-    edge_t(std::bitset<4>(0b0010)),
-    //x-based edge, yz-projected
-    edge_t(std::bitset<4>(0b0011)),
-
-    //y-based edge, no projection
-    edge_t(std::bitset<4>(0b0100)),
-    //y-based edge, x-projected
-    edge_t(std::bitset<4>(0b0101)),
-    //y-based edge, z-projected
-    edge_t(std::bitset<4>(0b0110)),
-    //y-based edge, xz-projected
-    edge_t(std::bitset<4>(0b0111)),
-
-
-    //z-based edge, no projection
-    edge_t(std::bitset<4>(0b1000)),
-    //z-based edge, x-projected
-    edge_t(std::bitset<4>(0b1001)),
-    //z-based edge, y-projected
-    edge_t(std::bitset<4>(0b1010)),
-    //z-based edge, xy-projected
-    edge_t(std::bitset<4>(0b1011)),
-
-  }};
-
-  return result;
+  assert(is_sane());
+  assert(!is_null());
+  assert(edge.is_sane());
+  assert(!edge.is_null());
+  
+  ///the edge and face/direction are not parallel and
+  return edge.base_axis() != direction().axis()
+          ///the significant dimension component of any edge's corner is the same as the direction
+          && is_adjacent(edge.corner0());
+  
 }
 
-//###################################################################
-
-
-
-
-
-
+CORNER_CASES_CUBEXX_INLINE
+constexpr bool
+face_t::is_adjacent(const corner_t& corner) const
+{
 
+  assert(is_sane());
+  assert(!is_null());
+  assert(corner.is_sane());
+  assert(!corner.is_null());
+  
+  uint_fast8_t axis = direction().axis();
 
+  return corner.uxyz()[axis] == (direction().positive() ? 1 : 0);
+}
 
 
+//###################################################################
 
 
 
+//###################################################################
+//#### direction_t
+//###################################################################
 
 
 
+CORNER_CASES_CUBEXX_INLINE
+constexpr const direction_t&
+direction_t::
+null_direction()
+{
+    return detail::topology().null_direction;
+}
 
 
 
+CORNER_CASES_CUBEXX_INLINE
+constexpr const direction_t&
+direction_t::
+get(std::int_fast8_t x, std::int_fast8_t y, std::int_fast8_t z)
+{
 
+  assert(detail::lxor(detail::lxor(x != 0, y != 0), z != 0) && "direction must have one non-zero component");
 
+  std::uint_fast8_t bits = 0;
+  if ( x != 0 )
+  {
+    bits |= 0b100;
+  } else if ( y != 0 ) {
+    bits |= 0b010;
+  }
 
+  if (x + y + z > 0)
+  {
+    bits |= 0b001;
+  }
 
+  return direction_t::get( bits );
+}
 
+CORNER_CASES_CUBEXX_INLINE
+constexpr const direction_t&
+direction_t::
+get(const direction_t& direction)
+{
+  assert(!direction.is_null());
+  assert(direction.is_sane());
+  assert(direction.mbits < SIZE());
+  return all()[direction.mbits];
+}
 
+CORNER_CASES_CUBEXX_INLINE
+constexpr const std::array< direction_t, 6 >&
+direction_t::
+all()
+{
+  return detail::topology().directions;
+}
 
+CORNER_CASES_CUBEXX_INLINE
+constexpr const std::array<std::int_fast8_t,3>& direction_t::xyz() const
+{
+  assert(is_sane());
+  assert(!is_null());
 
+  return detail::topology().direction_xyz[index()];
+}
 
-//###################################################################
-//#### set_base_t
-//###################################################################
 
-template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-set_base_t<derived_t, element_t, N>::
-set_base_t()
-  : mbits(0)
+constexpr const direction_t&
+direction_t::get(std::uint_fast8_t idx)
 {
-
+  assert(idx < SIZE());
+  return all()[idx];
 }
 
 
-template<typename derived_t, typename element_t, std::size_t N>
-template<typename Sequence>
 CORNER_CASES_CUBEXX_INLINE
-set_base_t<derived_t, element_t, N>::
-set_base_t(const Sequence& sequence)
-  : mbits(0)
+constexpr const face_t& direction_t::face() const
 {
-  self() |= sequence;
+  assert(is_sane());
+  assert(!is_null());
+
+  return face_t::get(*this);
 }
 
-template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-bool
-set_base_t<derived_t, element_t, N>::
-contains(const element_t& element) const
+constexpr const direction_t& direction_t::opposite() const
 {
-  assert(element.index() < N);
-  return mbits.test(element.index());
+  assert(is_sane());
+  assert(!is_null());
+
+  return all()[ mbits ^ 1 ];
 }
 
 
-template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-derived_t&
-set_base_t<derived_t, element_t, N>::
-operator=(const element_t& element)
+constexpr const std::array<direction_t, 4>&
+direction_t::adjacents() const
 {
-  assert(element.index() < N);
+  assert(is_sane());
+  assert(!is_null());
 
-  mbits.reset();
-  mbits.set(element.index(), true);
-  return self();
+  return detail::topology().direction_adjacents[index()];
 }
 
 
 
-template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-derived_t&
-set_base_t<derived_t, element_t, N>::
-operator=(const derived_t& set)
+constexpr const direction_set_t&
+direction_t::adjacent_set() const
 {
-  mbits = set.mbits;
-  return self();
+  assert(is_sane());
+  assert(!is_null());
+
+  return detail::topology().direction_adjacent_sets[index()];
 }
 
 
 
-template<typename derived_t, typename element_t, std::size_t N>
+//###################################################################
+
+
+
+
+
+//###################################################################
+//#### Corners
+//###################################################################
+
 CORNER_CASES_CUBEXX_INLINE
-derived_t
-set_base_t<derived_t, element_t, N>::
-operator|(const derived_t& set) const
+constexpr const corner_t&
+corner_t::
+null_corner()
 {
-  return derived_t(self()) |= set;
+  return detail::topology().null_corner;
 }
 
-
-template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-derived_t
-set_base_t<derived_t, element_t, N>::
-operator|(const element_t& element) const
+constexpr const corner_t&
+corner_t::
+get(std::int_fast8_t x, std::int_fast8_t y, std::int_fast8_t z)
 {
-  return derived_t(self()) | element;
+  return all()[(x > 0 ? 1 : 0) | (y > 0 ? 2 : 0) | (z > 0 ? 4 : 0)];
 }
 
-template<typename derived_t, typename element_t, std::size_t N>
-template<typename Sequence>
+
 CORNER_CASES_CUBEXX_INLINE
-derived_t
-set_base_t<derived_t, element_t, N>::
-operator|(const Sequence& sequence) const
+constexpr const std::array< corner_t, 8 >&
+corner_t::
+all()
 {
-  return derived_t(self()) | sequence;
+  return detail::topology().corners;
 }
 
-template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-derived_t&
-set_base_t<derived_t, element_t, N>::
-operator|=(const derived_t& set)
+constexpr const corner_t&
+corner_t::
+get(std::uint_fast8_t i)
 {
-  mbits |= set.mbits;
-
-  return self();
+  assert(i < SIZE());
+  return all()[i];
 }
 
-template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-derived_t&
-set_base_t<derived_t, element_t, N>::
-operator|=(const element_t& element)
+constexpr const corner_t&
+corner_t::get(const corner_t& corner)
 {
-  assert(element.index() < N);
-  mbits.set(element.index(), true);
-  return self();
+  assert(corner.is_sane());
+  assert(!corner.is_null());
+  return all()[corner.index()];
 }
 
+CORNER_CASES_CUBEXX_INLINE
+constexpr const std::array< corner_t, 3 >&
+corner_t::
+adjacents() const
+{
+  assert(is_sane());
+  assert(!is_null());
 
+  return detail::topology().corner_adjacents[index()];
+}
 
-template<typename derived_t, typename element_t, std::size_t N>
-template<typename Sequence>
 CORNER_CASES_CUBEXX_INLINE
-derived_t&
-set_base_t<derived_t, element_t, N>::
-operator|=(const Sequence& sequence)
+constexpr const corner_set_t&
+corner_t::adjacent_set() const
 {
+  assert(is_sane());
+  assert(!is_null());
 
-  for(const element_t& element : sequence)
-  {
-    self() |= element;
-  }
-
-  return self();
+  return detail::topology().corner_adjacent_sets[index()];
 }
 
 
-
-template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-derived_t&
-set_base_t<derived_t, element_t, N>::
-operator-=(const derived_t& set)
+constexpr const std::array<int_fast8_t,3>&
+corner_t::
+xyz() const
 {
-  mbits &= ~set.mbits;
-
-  return self();
+  assert(is_sane());
+  assert(!is_null());
+  
+  return detail::topology().corner_xyz[index()];
 }
 
-template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-derived_t&
-set_base_t<derived_t, element_t, N>::
-operator-=(const element_t& element)
+constexpr const std::array<uint_fast8_t,3>&
+corner_t::
+uxyz() const
 {
-  assert(element.index() < N);
-  mbits.set(element.index(), false);
-  return self();
+  assert(is_sane());
+  assert(!is_null());
+  
+  return detail::topology().corner_uxyz[index()];
 }
 
 
-
-template<typename derived_t, typename element_t, std::size_t N>
-template<typename Sequence>
 CORNER_CASES_CUBEXX_INLINE
-derived_t&
-set_base_t<derived_t, element_t, N>::
-operator-=(const Sequence& sequence)
+constexpr const std::array< face_t, 3 >&
+corner_t::faces() const
 {
+  assert(is_sane());
+  assert(!is_null());
 
-  for(const element_t& element : sequence)
-  {
-    self() -= element;
-  }
-
-  return self();
+  return detail::topology().corner_faces[index()];
 }
 
 
+CORNER_CASES_CUBEXX_INLINE
+constexpr const face_set_t&
+corner_t::face_set() const
+{
+  assert(is_sane());
+  assert(!is_null());
 
+  return detail::topology().corner_face_sets[index()];
+}
 
-
-template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-derived_t
-set_base_t<derived_t, element_t, N>::
-operator-(const derived_t& set) const
+constexpr const corner_t&
+corner_t::opposite() const
 {
-  return derived_t(self()) -= set;
+  assert(is_sane());
+  assert(!is_null());
+  return all()[mbits ^ 0b0111];
 }
 
-
-template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-derived_t
-set_base_t<derived_t, element_t, N>::
-operator-(const element_t& element) const
+constexpr const corner_t&
+corner_t::
+adjacent(const direction_t& direction) const
 {
-  return derived_t(self()) -= element;
+  assert(is_sane());
+  assert(!is_null());
+  return all()[mbits ^ (1 << direction.axis())];
 }
-
-template<typename derived_t, typename element_t, std::size_t N>
-template<typename Sequence>
 CORNER_CASES_CUBEXX_INLINE
-derived_t
-set_base_t<derived_t, element_t, N>::
-operator-(const Sequence& sequence) const
+constexpr const corner_t&
+corner_t::
+push(const direction_t& direction) const
 {
-  return derived_t(self()) -= sequence;
+  assert(is_sane());
+  assert(!is_null());
+  return direction.positive() ? all()[mbits | (1 << direction.axis())]
+                              : all()[mbits & ~(1 << direction.axis())];
 }
 
 
+CORNER_CASES_CUBEXX_INLINE
+constexpr const corner_t&
+corner_t::
+move(const direction_t& direction) const
+{
+  assert(is_sane());
+  assert(!is_null());
 
 
+  const corner_t& result = push(direction);
+  if (*this == result)
+    return null_corner();
+  return result;
+}
 
 
+CORNER_CASES_CUBEXX_INLINE
+constexpr const edge_t&
+corner_t::
+edge(const direction_t& direction) const
+{
+  assert(is_sane());
+  assert(!is_null());
+  assert(direction.is_sane());
+  assert(!direction.is_null());
 
+  return edges()[direction.axis()];
+}
 
 
+CORNER_CASES_CUBEXX_INLINE
+constexpr const edge_t&
+corner_t::
+edge(const corner_t& other) const
+{
+  assert(is_sane());
+  assert(!is_null());
+  assert(other.is_sane());
+  assert(!other.is_null());
 
+  assert(is_adjacent(other));
+  assert(other.is_adjacent(*this));
 
+  return this->edge(this->get_adjacent_direction(other));
+}
 
 
+CORNER_CASES_CUBEXX_INLINE
+constexpr const std::array<edge_t,3 >&
+corner_t::
+edges() const
+{
+  assert(is_sane());
+  assert(!is_null());
+  
+  return detail::topology().corner_edges[index()];
+}
 
 
 
-
-template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-derived_t&
-set_base_t<derived_t, element_t, N>::
-operator&=(const derived_t& set)
+constexpr const edge_set_t&
+corner_t::
+edge_set() const
 {
-  mbits &= set.mbits;
-
-  return self();
+  assert(is_sane());
+  assert(!is_null());
+  
+  return detail::topology().corner_edge_sets[index()];
 }
 
-template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-derived_t&
-set_base_t<derived_t, element_t, N>::
-operator&=(const element_t& element)
+constexpr const direction_t&
+corner_t::get_adjacent_direction(const corner_t& other) const
 {
-  assert(element.index() < N);
-  self() &= derived_t(element);
-  return self();
-}
-
+  assert(is_sane());
+  assert(!is_null());
+  assert(other.is_sane());
+  assert(!other.is_null());
+  assert(is_adjacent(other));
+  assert(other.is_adjacent(*this));
 
+  return direction_t::get(std::int_fast8_t(other.x() - x()),
+                          std::int_fast8_t(other.y() - y()),
+                          std::int_fast8_t(other.z() - z()));
+}
 
-template<typename derived_t, typename element_t, std::size_t N>
-template<typename Sequence>
 CORNER_CASES_CUBEXX_INLINE
-derived_t&
-set_base_t<derived_t, element_t, N>::
-operator&=(const Sequence& sequence)
+constexpr bool
+corner_t::is_adjacent(const edge_t& edge) const
 {
+  assert(is_sane());
+  assert(!is_null());
+  assert(edge.is_sane());
+  assert(!edge.is_null());
+  
+  
+  return edge.corner0() == *this || edge.corner1() == *this;
+}
 
+CORNER_CASES_CUBEXX_INLINE
+constexpr bool
+corner_t::is_adjacent(const face_t& face) const
+{
 
-  self() &= derived_t(sequence);
-
-  return self();
+  assert(is_sane());
+  assert(!is_null());
+  assert(face.is_sane());
+  assert(!face.is_null());
+  
+  return face.is_adjacent(*this);
 }
+//###################################################################
+
 
 
 
+//###################################################################
+//#### edge_t
+//###################################################################
 
 
-template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-derived_t
-set_base_t<derived_t, element_t, N>::
-operator&(const derived_t& set) const
+constexpr const edge_t&
+edge_t::
+null_edge()
 {
-  return derived_t(self()) &= set;
+  return detail::topology().null_edge;
 }
 
 
-template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-derived_t
-set_base_t<derived_t, element_t, N>::
-operator&(const element_t& element) const
+constexpr bool
+edge_t::
+is_adjacent(const edge_t& other) const
 {
-  return derived_t(self()) &= element;
+  assert(is_sane());
+  assert(!is_null());
+  assert(other.is_sane());
+  assert(!other.is_null());
+
+  return (other.corner_set() & this->corner_set()).size() == 1;
 }
 
-template<typename derived_t, typename element_t, std::size_t N>
-template<typename Sequence>
 CORNER_CASES_CUBEXX_INLINE
-derived_t
-set_base_t<derived_t, element_t, N>::
-operator&(const Sequence& sequence) const
+constexpr bool
+edge_t::
+is_adjacent(const face_t& face) const
 {
-  return derived_t(self()) &= sequence;
+  assert(is_sane());
+  assert(!is_null());
+  assert(face.is_sane());
+  assert(!face.is_null());
+
+  return face.is_adjacent(*this);
 }
 
+CORNER_CASES_CUBEXX_INLINE
+constexpr bool
+edge_t::
+is_adjacent(const corner_t& corner) const
+{
+  assert(is_sane());
+  assert(!is_null());
+  assert(corner.is_sane());
+  assert(!corner.is_null());
 
+  return this->corner_set().contains(corner);
+}
 
 
-template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-derived_t&
-set_base_t<derived_t, element_t, N>::
-self()
+constexpr const edge_t&
+edge_t::
+get(std::uint_fast8_t base_axis, bool project_secondary, bool project_tertiary)
 {
-  static_assert( std::is_base_of< set_base_t<derived_t, element_t, N>, derived_t >::value
-                , "Something's really wrong with our CRTP" );
-  return static_cast<derived_t&>(*this);
+  assert(base_axis < 3);
+
+  return edge_t::get(std::uint_fast8_t( (base_axis << 2)
+                                      | ((project_secondary ? 1 : 0) << 0)
+                                      | ((project_tertiary ? 1 : 0) << 1)));
 }
 
-template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-const derived_t&
-set_base_t<derived_t, element_t, N>::
-self() const
+constexpr const edge_t&
+edge_t::
+get(const corner_t& lhs, const corner_t& rhs)
 {
-  static_assert( std::is_base_of< set_base_t<derived_t, element_t, N>, derived_t >::value
-                , "Something's really wrong with our CRTP" );
-  return *static_cast<const derived_t*>(this);
+    assert(lhs.is_sane());
+    assert(!lhs.is_null());
+    assert(rhs.is_sane());
+    assert(!rhs.is_null());
+    assert(lhs != rhs);
+    assert(lhs.is_adjacent(rhs));
+
+    return detail::topology().corner_pair_edges[lhs.index() * corner_t::SIZE() + rhs.index()];
 }
 
 
-template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-typename set_base_t<derived_t, element_t, N>::const_iterator
-set_base_t<derived_t, element_t, N>::
-begin() const
+constexpr const edge_t&
+edge_t::
+get(std::uint_fast8_t idx)
 {
-  return const_iterator(&self());
+  assert(idx < 12);
+  return all()[idx];
 }
 
-template<typename derived_t, typename element_t, std::size_t N>
+
 CORNER_CASES_CUBEXX_INLINE
-typename set_base_t<derived_t, element_t, N>::const_iterator
-set_base_t<derived_t, element_t, N>::
-end() const
+constexpr const corner_t&
+edge_t::
+corner0() const
 {
-  return const_iterator(&self(), N);
+  return corners()[0];
 }
 
 
-template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-std::size_t
-set_base_t<derived_t, element_t, N>::
-size() const
+constexpr const corner_t&
+edge_t::
+corner1() const
 {
-  return mbits.count();
+  return corners()[1];
 }
 
-template<typename derived_t, typename element_t, std::size_t N>
+
 CORNER_CASES_CUBEXX_INLINE
-void
-set_base_t<derived_t, element_t, N>::
-clear()
+constexpr const edge_t&
+edge_t::
+opposite() const
 {
-  mbits.reset();
+  assert(!is_null());
+  assert(is_sane());
+
+  return all()[mbits ^ 0b0011];
 }
 
 
-template<typename derived_t, typename element_t, std::size_t N>
+
 CORNER_CASES_CUBEXX_INLINE
-bool
-set_base_t<derived_t, element_t, N>::
-operator==(const derived_t& other) const
+constexpr const edge_t&
+edge_t::
+opposite(const face_t& face) const
 {
-  return mbits == other.mbits;
+    assert(is_sane());
+    assert(!is_null());
+    assert(is_adjacent(face));
+    assert(face.is_adjacent(*this));
+
+    return all()[mbits ^ (faces()[0] == face ? 0b0010 : 0b0001)];
 }
 
-template<typename derived_t, typename element_t, std::size_t N>
+
 CORNER_CASES_CUBEXX_INLINE
-bool
-set_base_t<derived_t, element_t, N>::
-operator!=(const derived_t& other) const
+constexpr const std::array<corner_t, 2>&
+edge_t::
+corners() const
 {
-  return mbits != other.mbits;
-}
+  assert(!is_null());
+  assert(is_sane());
+  assert(index() < 12);
 
+  return detail::topology().edge_corners[ index() ];
+}
 
+CORNER_CASES_CUBEXX_INLINE
+constexpr const corner_set_t&
+edge_t::
+corner_set() const
+{
+  assert(!is_null());
+  assert(is_sane());
+  assert(index() < 12);
 
+  return detail::topology().edge_corner_sets[ index() ];
+}
 
 
-template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-bool
-set_base_t<derived_t, element_t, N>::
-contains(const std::size_t& idx) const
+constexpr const std::array<edge_t,4>&
+edge_t::
+adjacent_edges() const
 {
-  assert(idx < N);
-  return mbits.test(idx);
+  assert(is_sane());
+  assert(!is_null());
+  
+  return detail::topology().edge_adjacent_edges[index()];
 }
 
 
-
-template<typename derived_t, typename element_t, std::size_t N>
 CORNER_CASES_CUBEXX_INLINE
-const std::bitset<N>&
-set_base_t<derived_t, element_t, N>::
-bits() const
+constexpr const std::array<edge_t,2>&
+edge_t::
+adjacent_edges(const corner_t& corner) const
 {
-  return mbits;
+  assert(is_sane());
+  assert(!is_null());
+  assert(corner.is_sane());
+  assert(!corner.is_null());
+  
+  assert(is_adjacent(corner));
+  assert(corner.is_adjacent(*this));
+  
+  return detail::topology().edge_end_adjacent_edges[index()][(corner.index() >> base_axis()) & 1];
 }
 
 
-
-
-
-
-
 CORNER_CASES_CUBEXX_INLINE
-direction_set_t::direction_set_t()
-  : base_t()
+constexpr const edge_set_t&
+edge_t::
+adjacent_edge_set() const
 {
-
+  assert(is_sane());
+  assert(!is_null());
+  
+  return detail::topology().edge_adjacent_edge_sets[index()];
 }
 
-template<typename T>
+
 CORNER_CASES_CUBEXX_INLINE
-direction_set_t::direction_set_t(const T& v)
-  : base_t(v)
+constexpr const edge_set_t&
+edge_t::
+adjacent_edge_set(const corner_t& corner) const
 {
+  assert(is_sane());
+  assert(!is_null());
+  assert(corner.is_sane());
+  assert(!corner.is_null());
+  
+  assert(corner.is_adjacent(*this));
+  assert((*this).is_adjacent(corner));
 
+  return detail::topology().edge_end_adjacent_edge_sets[index()][(corner.index() >> base_axis()) & 1];
 }
 
 
 CORNER_CASES_CUBEXX_INLINE
-face_set_t::face_set_t()
-  : base_t()
+constexpr const face_t&
+edge_t::
+end_face(const corner_t& corner) const
 {
+  assert(!is_null());
+  assert(is_sane());
+  assert(index() < 12);
+  assert(corner.is_adjacent(*this));
+  assert((*this).is_adjacent(corner));
 
+  ///either 0 or 1 if this corner is the positive or negative corner of this edge
+  return end_faces()[ corner.uxyz()[(*this).base_axis()] ];
 }
 
-template<typename T>
 CORNER_CASES_CUBEXX_INLINE
-face_set_t::face_set_t(const T& v)
-  : base_t(v)
+constexpr const std::array<face_t, 2>&
+edge_t::
+end_faces() const
 {
+  assert(!is_null());
+  assert(is_sane());
+  assert(index() < 12);
 
+  return detail::topology().axis_end_faces[ base_axis() ];
 }
 
-
-
-
-
 CORNER_CASES_CUBEXX_INLINE
-corner_set_t::corner_set_t()
-  : base_t()
+constexpr const face_set_t&
+edge_t::
+end_face_set() const
 {
+  assert(!is_null());
+  assert(is_sane());
+  assert(index() < 12);
 
+  return detail::topology().axis_end_face_sets[ base_axis() ];
 }
 
-template<typename T>
 CORNER_CASES_CUBEXX_INLINE
-corner_set_t::corner_set_t(const T& v)
-  : base_t(v)
+constexpr const std::array<face_t, 2>&
+edge_t::
+faces() const
 {
+  assert(!is_null());
+  assert(is_sane());
+  assert(index() < 12);
 
+  return detail::topology().edge_faces[ index() ];
 }
-
-
 CORNER_CASES_CUBEXX_INLINE
-edge_set_t::edge_set_t()
-  : base_t()
+constexpr const face_set_t&
+edge_t::
+face_set() const
 {
+  assert(!is_null());
+  assert(is_sane());
+  assert(index() < 12);
 
+  return detail::topology().edge_face_sets[ index() ];
 }
 
-template<typename T>
 CORNER_CASES_CUBEXX_INLINE
-edge_set_t::edge_set_t(const T& v)
-  : base_t(v)
+constexpr const std::array<edge_t, 12>&
+edge_t::
+all()
 {
-
+  return detail::topology().edges;
 }
 
-
-
-
-
-
-
-
-
 //###################################################################
 
 
@@ -0,0 +1,242 @@
+/*
+    Copyright (c) 2012 Azriel Fasten azriel.fasten@gmail.com
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "cubexx/culling.hpp"
+
+#include <cassert>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+namespace cubexx{
+
+//###################################################################
+//#### culler_t
+//###################################################################
+
+CORNER_CASES_CUBEXX_INLINE
+culler_t::culler_t()
+{}
+
+CORNER_CASES_CUBEXX_INLINE
+culler_t::culler_t(const std::vector<half_space_t>& planes)
+{
+  assert(planes.size() <= MAX_PLANES());
+
+  mentries.reserve(planes.size());
+  for (const half_space_t& plane : planes)
+  {
+    entry_t entry;
+    entry.plane = plane;
+    entry.p_corner = corner_t::get(std::int_fast8_t(plane.normal[0] > 0 ? 1 : -1),
+                                   std::int_fast8_t(plane.normal[1] > 0 ? 1 : -1),
+                                   std::int_fast8_t(plane.normal[2] > 0 ? 1 : -1));
+    entry.n_corner = entry.p_corner.opposite();
+    for (const corner_t& corner : corner_t::all())
+    {
+      entry.corner_dots[corner.index()] = plane.normal[0] * corner.ux()
+                                        + plane.normal[1] * corner.uy()
+                                        + plane.normal[2] * corner.uz();
+    }
+    mentries.push_back(entry);
+  }
+}
+
+CORNER_CASES_CUBEXX_INLINE
+culler_t culler_t::frustum(const std::array<float, 16>& matrix)
+{
+  ///Gribb & Hartmann: each plane is the w row plus or minus the x, y or z row
+  std::vector<half_space_t> planes;
+  for (std::size_t row = 0; row < 3; ++row)
+  {
+    for (float sign : {1.0f, -1.0f})
+    {
+      half_space_t plane;
+      for (std::size_t column = 0; column < 3; ++column)
+        plane.normal[column] = matrix[12 + column] + sign * matrix[row * 4 + column];
+      plane.offset = matrix[15] + sign * matrix[row * 4 + 3];
+      planes.push_back(plane);
+    }
+  }
+  return culler_t(planes);
+}
+
+CORNER_CASES_CUBEXX_INLINE
+std::size_t culler_t::size() const
+{
+  return mentries.size();
+}
+
+CORNER_CASES_CUBEXX_INLINE
+const half_space_t& culler_t::plane(std::size_t i) const
+{
+  assert(i < mentries.size());
+  return mentries[i].plane;
+}
+
+CORNER_CASES_CUBEXX_INLINE
+const corner_t& culler_t::p_corner(std::size_t i) const
+{
+  assert(i < mentries.size());
+  return mentries[i].p_corner;
+}
+
+CORNER_CASES_CUBEXX_INLINE
+const corner_t& culler_t::n_corner(std::size_t i) const
+{
+  assert(i < mentries.size());
+  return mentries[i].n_corner;
+}
+
+CORNER_CASES_CUBEXX_INLINE
+culler_t::plane_mask_t culler_t::all() const
+{
+  return mentries.size() == 32 ? ~plane_mask_t(0) : (plane_mask_t(1) << mentries.size()) - 1;
+}
+
+CORNER_CASES_CUBEXX_INLINE
+bool culler_t::test(const std::array<float, 3>& lower, float size, plane_mask_t& mask) const
+{
+  for (plane_mask_t planes = mask; planes != 0; planes &= planes - 1)
+  {
+    std::size_t i = detail::countr_zero(planes);
+    const entry_t& entry = mentries[i];
+    float base = entry.plane.normal[0] * lower[0] + entry.plane.normal[1] * lower[1]
+               + entry.plane.normal[2] * lower[2] + entry.plane.offset;
+
+    if (base + size * entry.corner_dots[entry.p_corner.index()] < 0)
+      return false;
+    if (base + size * entry.corner_dots[entry.n_corner.index()] >= 0)
+      mask &= ~(plane_mask_t(1) << i);
+  }
+  return true;
+}
+
+CORNER_CASES_CUBEXX_INLINE
+corner_set_t culler_t::test_children(const std::array<float, 3>& lower, float size, plane_mask_t mask,
+                                     plane_mask_t* child_masks) const
+{
+  const float half = size / 2;
+  ///a bit per child, by corner index
+  std::uint_fast32_t visible = 0xFF;
+  for (std::size_t c = 0; c < 8; ++c)
+    child_masks[c] = mask;
+
+  for (plane_mask_t planes = mask; planes != 0 && visible != 0; planes &= planes - 1)
+  {
+    std::size_t i = detail::countr_zero(planes);
+    const entry_t& entry = mentries[i];
+    float base = entry.plane.normal[0] * lower[0] + entry.plane.normal[1] * lower[1]
+               + entry.plane.normal[2] * lower[2] + entry.plane.offset;
+    ///child `c` is at `lower + half*c`, so its p-vertex is at `lower + half*(c + p)`
+    float p = entry.corner_dots[entry.p_corner.index()];
+    float n = entry.corner_dots[entry.n_corner.index()];
+
+    ///bits of the children outside the plane, and of those entirely inside it
+    std::uint_fast32_t outside, inside;
+#if defined(__AVX__)
+    __m256 dots = _mm256_loadu_ps(entry.corner_dots);
+    __m256 vbase = _mm256_set1_ps(base), vhalf = _mm256_set1_ps(half), zero = _mm256_setzero_ps();
+    __m256 pv = _mm256_add_ps(vbase, _mm256_mul_ps(vhalf, _mm256_add_ps(dots, _mm256_set1_ps(p))));
+    __m256 nv = _mm256_add_ps(vbase, _mm256_mul_ps(vhalf, _mm256_add_ps(dots, _mm256_set1_ps(n))));
+    outside = std::uint_fast32_t(_mm256_movemask_ps(_mm256_cmp_ps(pv, zero, _CMP_LT_OQ)));
+    inside = std::uint_fast32_t(_mm256_movemask_ps(_mm256_cmp_ps(nv, zero, _CMP_GE_OQ)));
+#elif defined(__SSE2__) || defined(_M_X64)
+    __m128 vbase = _mm_set1_ps(base), vhalf = _mm_set1_ps(half), zero = _mm_setzero_ps();
+    __m128 vp = _mm_set1_ps(p), vn = _mm_set1_ps(n);
+    __m128 dots0 = _mm_loadu_ps(entry.corner_dots), dots1 = _mm_loadu_ps(entry.corner_dots + 4);
+    __m128 pv0 = _mm_add_ps(vbase, _mm_mul_ps(vhalf, _mm_add_ps(dots0, vp)));
+    __m128 pv1 = _mm_add_ps(vbase, _mm_mul_ps(vhalf, _mm_add_ps(dots1, vp)));
+    __m128 nv0 = _mm_add_ps(vbase, _mm_mul_ps(vhalf, _mm_add_ps(dots0, vn)));
+    __m128 nv1 = _mm_add_ps(vbase, _mm_mul_ps(vhalf, _mm_add_ps(dots1, vn)));
+    outside = std::uint_fast32_t(_mm_movemask_ps(_mm_cmplt_ps(pv0, zero)))
+            | std::uint_fast32_t(_mm_movemask_ps(_mm_cmplt_ps(pv1, zero))) << 4;
+    inside = std::uint_fast32_t(_mm_movemask_ps(_mm_cmpge_ps(nv0, zero)))
+           | std::uint_fast32_t(_mm_movemask_ps(_mm_cmpge_ps(nv1, zero))) << 4;
+#else
+    outside = inside = 0;
+    for (std::size_t c = 0; c < 8; ++c)
+    {
+      outside |= std::uint_fast32_t(base + half * (entry.corner_dots[c] + p) < 0) << c;
+      inside |= std::uint_fast32_t(base + half * (entry.corner_dots[c] + n) >= 0) << c;
+    }
+#endif
+
+    visible &= ~outside;
+    for (std::uint_fast32_t children = visible & inside; children != 0; children &= children - 1)
+      child_masks[detail::countr_zero(children)] &= ~(plane_mask_t(1) << i);
+  }
+  return corner_set_t::from_mask(corner_set_t::mask_type(visible));
+}
+
+namespace detail{
+
+template<typename tree_t, typename visitor_t>
+CORNER_CASES_CUBEXX_INLINE
+void cull_node(const tree_t& tree, const typename octree_traversal_t<tree_t>::node_type& node,
+               const std::array<float, 3>& lower, float size, const culler_t& culler,
+               culler_t::plane_mask_t mask, visitor_t& visitor)
+{
+  typedef octree_traversal_t<tree_t> traversal;
+
+  corner_set_t children = traversal::children(tree, node);
+  if (children.empty())
+  {
+    visitor(node, lower, size, mask == 0);
+    return;
+  }
+
+  culler_t::plane_mask_t child_masks[8];
+  corner_set_t visible = mask == 0 ? children : culler.test_children(lower, size, mask, child_masks) & children;
+  const float half = size / 2;
+  for (const corner_t& corner : visible)
+  {
+    std::array<float, 3> child_lower = {{lower[0] + half * corner.ux(), lower[1] + half * corner.uy(),
+                                         lower[2] + half * corner.uz()}};
+    cull_node(tree, traversal::child(tree, node, corner), child_lower, half, culler,
+              mask == 0 ? mask : child_masks[corner.index()], visitor);
+  }
+}
+
+} // namespace detail
+
+template<typename tree_t, typename visitor_t>
+CORNER_CASES_CUBEXX_INLINE
+void cull_visit(const tree_t& tree, const std::array<float, 3>& lower, float size, const culler_t& culler,
+                visitor_t&& visitor)
+{
+  typedef octree_traversal_t<tree_t> traversal;
+  if (traversal::empty(tree))
+    return;
+
+  culler_t::plane_mask_t mask = culler.all();
+  if (!culler.test(lower, size, mask))
+    return;
+  detail::cull_node(tree, traversal::root(tree), lower, size, culler, mask, visitor);
+}
+
+} // namespace cubexx
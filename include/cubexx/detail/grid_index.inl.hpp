@@ -0,0 +1,187 @@
+/*
+    Copyright (c) 2012 Azriel Fasten azriel.fasten@gmail.com
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "cubexx/grid_index.hpp"
+
+#include <cassert>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+namespace cubexx{
+
+namespace detail{
+
+///Writes @p n consecutive ids from @p first to @p ids.
+CORNER_CASES_CUBEXX_INLINE
+void grid_iota(std::uint64_t first, std::size_t n, std::uint64_t* ids)
+{
+  std::size_t i = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+  ///two ids to a register, so two registers make 4 at a time
+  __m128i low = _mm_add_epi64(_mm_set1_epi64x(std::int64_t(first)), _mm_set_epi64x(1, 0));
+  __m128i high = _mm_add_epi64(low, _mm_set1_epi64x(2));
+  const __m128i step = _mm_set1_epi64x(4);
+  for (; i + 4 <= n; i += 4)
+  {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(ids + i), low);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(ids + i + 2), high);
+    low = _mm_add_epi64(low, step);
+    high = _mm_add_epi64(high, step);
+  }
+#endif
+  for (; i < n; ++i)
+    ids[i] = first + i;
+}
+
+} // namespace detail
+
+//###################################################################
+//#### grid_index_t
+//###################################################################
+
+CORNER_CASES_CUBEXX_INLINE
+grid_index_t::grid_index_t(std::size_t nx, std::size_t ny, std::size_t nz)
+  : msize{{nx, ny, nz}}
+  , mcorner_dimensions{{nx + 1, ny + 1, nz + 1}}
+{
+  std::uint64_t edge_total = 0, face_total = 0;
+  for (std::size_t axis = 0; axis < 3; ++axis)
+  {
+    medge_dimensions[axis] = mcorner_dimensions;
+    medge_dimensions[axis][axis] = msize[axis];
+    mface_dimensions[axis] = msize;
+    mface_dimensions[axis][axis] = mcorner_dimensions[axis];
+
+    medge_offsets[axis] = edge_total;
+    mface_offsets[axis] = face_total;
+    edge_total += id_type(medge_dimensions[axis][0]) * medge_dimensions[axis][1] * medge_dimensions[axis][2];
+    face_total += id_type(mface_dimensions[axis][0]) * mface_dimensions[axis][1] * mface_dimensions[axis][2];
+  }
+  medge_offsets[3] = edge_total;
+  mface_offsets[3] = face_total;
+}
+
+CORNER_CASES_CUBEXX_INLINE
+const std::array<std::size_t, 3>& grid_index_t::size() const
+{
+  return msize;
+}
+
+CORNER_CASES_CUBEXX_INLINE
+grid_index_t::id_type grid_index_t::cell_count() const
+{
+  return id_type(msize[0]) * msize[1] * msize[2];
+}
+
+CORNER_CASES_CUBEXX_INLINE
+grid_index_t::id_type grid_index_t::corner_count() const
+{
+  return id_type(mcorner_dimensions[0]) * mcorner_dimensions[1] * mcorner_dimensions[2];
+}
+
+CORNER_CASES_CUBEXX_INLINE
+grid_index_t::id_type grid_index_t::edge_count() const
+{
+  return medge_offsets[3];
+}
+
+CORNER_CASES_CUBEXX_INLINE
+grid_index_t::id_type grid_index_t::face_count() const
+{
+  return mface_offsets[3];
+}
+
+CORNER_CASES_CUBEXX_INLINE
+grid_index_t::id_type grid_index_t::linear(id_type first, const std::array<std::size_t, 3>& dimensions,
+                                           const std::array<std::size_t, 3>& point)
+{
+  assert(point[0] < dimensions[0] && point[1] < dimensions[1] && point[2] < dimensions[2]);
+  return first + point[0] + dimensions[0] * (point[1] + id_type(dimensions[1]) * point[2]);
+}
+
+CORNER_CASES_CUBEXX_INLINE
+grid_index_t::id_type grid_index_t::cell_id(std::size_t x, std::size_t y, std::size_t z) const
+{
+  return linear(0, msize, {{x, y, z}});
+}
+
+CORNER_CASES_CUBEXX_INLINE
+grid_index_t::id_type grid_index_t::corner_id(std::size_t x, std::size_t y, std::size_t z, const corner_t& corner) const
+{
+  assert(x < msize[0] && y < msize[1] && z < msize[2]);
+  return linear(0, mcorner_dimensions, {{x + corner.ux(), y + corner.uy(), z + corner.uz()}});
+}
+
+CORNER_CASES_CUBEXX_INLINE
+grid_index_t::id_type grid_index_t::edge_id(std::size_t x, std::size_t y, std::size_t z, const edge_t& edge) const
+{
+  assert(x < msize[0] && y < msize[1] && z < msize[2]);
+  ///owned at its lower end, corner0()
+  const corner_t& corner = edge.corner0();
+  std::uint_fast8_t axis = edge.base_axis();
+  return linear(medge_offsets[axis], medge_dimensions[axis], {{x + corner.ux(), y + corner.uy(), z + corner.uz()}});
+}
+
+CORNER_CASES_CUBEXX_INLINE
+grid_index_t::id_type grid_index_t::face_id(std::size_t x, std::size_t y, std::size_t z, const face_t& face) const
+{
+  assert(x < msize[0] && y < msize[1] && z < msize[2]);
+  ///the positive face is the negative face of the next cell along its axis
+  const direction_t& direction = face.direction();
+  std::uint_fast8_t axis = direction.axis();
+  std::array<std::size_t, 3> owner = {{x, y, z}};
+  owner[axis] += direction.positive() ? 1 : 0;
+  return linear(mface_offsets[axis], mface_dimensions[axis], owner);
+}
+
+CORNER_CASES_CUBEXX_INLINE
+void grid_index_t::corner_ids(std::size_t x, std::size_t y, std::size_t z, std::size_t n, const corner_t& corner,
+                              id_type* ids) const
+{
+  assert(x + n <= msize[0]);
+  if (n > 0)
+    detail::grid_iota(corner_id(x, y, z, corner), n, ids);
+}
+
+CORNER_CASES_CUBEXX_INLINE
+void grid_index_t::edge_ids(std::size_t x, std::size_t y, std::size_t z, std::size_t n, const edge_t& edge,
+                            id_type* ids) const
+{
+  assert(x + n <= msize[0]);
+  if (n > 0)
+    detail::grid_iota(edge_id(x, y, z, edge), n, ids);
+}
+
+CORNER_CASES_CUBEXX_INLINE
+void grid_index_t::face_ids(std::size_t x, std::size_t y, std::size_t z, std::size_t n, const face_t& face,
+                            id_type* ids) const
+{
+  assert(x + n <= msize[0]);
+  if (n > 0)
+    detail::grid_iota(face_id(x, y, z, face), n, ids);
+}
+
+} // namespace cubexx
@@ -0,0 +1,131 @@
+/*
+    Copyright (c) 2012 Azriel Fasten azriel.fasten@gmail.com
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "cubexx/isosurface.hpp"
+
+#include <cassert>
+#include <algorithm>
+
+namespace cubexx{
+
+//###################################################################
+//#### isosurface_extractor_t
+//###################################################################
+
+CORNER_CASES_CUBEXX_INLINE
+isosurface_extractor_t::isosurface_extractor_t(std::size_t nx, std::size_t ny, std::size_t nz, float isovalue)
+  : mnx(nx), mny(ny), mnz(nz)
+  , misovalue(isovalue)
+  , mgrid(nx - 1, ny - 1, nz - 1)
+  , mslices(0)
+{
+  assert(nx >= 2 && ny >= 2 && nz >= 2);
+
+  mz_done.assign(nx * ny, 0);
+  mcases.resize(nx - 1);
+  for (std::size_t dz = 0; dz < 2; ++dz)
+  {
+    msamples[dz].resize(nx * ny);
+    for (std::size_t axis = 0; axis < 2; ++axis)
+      mplane_done[dz][axis].assign(nx * ny, 0);
+  }
+}
+
+CORNER_CASES_CUBEXX_INLINE
+const grid_index_t& isosurface_extractor_t::grid() const
+{
+  return mgrid;
+}
+
+CORNER_CASES_CUBEXX_INLINE
+std::size_t isosurface_extractor_t::slices() const
+{
+  return mslices;
+}
+
+template<typename sink_t>
+void isosurface_extractor_t::push(const float* slice, sink_t&& sink)
+{
+  assert(mslices < mnz);
+
+  ///the upper slice, and its flags, become the lower
+  std::swap(msamples[0], msamples[1]);
+  std::swap(mplane_done[0], mplane_done[1]);
+  std::copy(slice, slice + mnx * mny, msamples[1].begin());
+  for (std::size_t axis = 0; axis < 2; ++axis)
+    std::fill(mplane_done[1][axis].begin(), mplane_done[1][axis].end(), std::uint8_t(0));
+  std::fill(mz_done.begin(), mz_done.end(), std::uint8_t(0));
+
+  if (++mslices < 2)
+    return;
+
+  for (std::size_t y = 0; y + 1 < mny; ++y)
+  {
+    const float* rows[4] = {&msamples[0][y * mnx], &msamples[0][(y + 1) * mnx],
+                            &msamples[1][y * mnx], &msamples[1][(y + 1) * mnx]};
+    marching_cubes_classify_row(rows, mnx - 1, misovalue, mcases.data());
+
+    for (std::size_t x = 0; x + 1 < mnx; ++x)
+    {
+      corner_set_t inside = corner_set_t::from_mask(corner_set_t::mask_type(mcases[x]));
+      for (std::size_t i = 0; i < marching_cubes_triangle_count(inside); ++i)
+      {
+        std::array<edge_t, 3> triangle = marching_cubes_triangle(inside, i);
+        id_type ids[3] = {vertex(x, y, triangle[0], sink), vertex(x, y, triangle[1], sink),
+                          vertex(x, y, triangle[2], sink)};
+        sink.triangle(ids[0], ids[1], ids[2]);
+      }
+    }
+  }
+}
+
+template<typename sink_t>
+isosurface_extractor_t::id_type isosurface_extractor_t::vertex(std::size_t x, std::size_t y, const edge_t& edge,
+                                                               sink_t& sink)
+{
+  const corner_t& corner0 = edge.corner0();
+  const corner_t& corner1 = edge.corner1();
+  std::size_t point0 = (y + corner0.uy()) * mnx + x + corner0.ux();
+
+  std::uint_fast8_t axis = edge.base_axis();
+  std::uint8_t& done = axis == 2 ? mz_done[point0] : mplane_done[corner0.uz()][axis][point0];
+  id_type id = mgrid.edge_id(x, y, mslices - 2, edge);
+  if (done)
+    return id;
+  done = 1;
+
+  std::size_t point1 = (y + corner1.uy()) * mnx + x + corner1.ux();
+  float value0 = msamples[corner0.uz()][point0];
+  float value1 = msamples[corner1.uz()][point1];
+  ///one is inside and the other not, so they differ
+  float t = (misovalue - value0) / (value1 - value0);
+
+  std::array<float, 3> position = {{float(x + corner0.ux()), float(y + corner0.uy()),
+                                    float(mslices - 2 + corner0.uz())}};
+  position[axis] += t;
+  sink.vertex(id, position);
+  return id;
+}
+
+} // namespace cubexx
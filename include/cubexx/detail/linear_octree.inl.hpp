@@ -0,0 +1,272 @@
+/*
+    Copyright (c) 2012 Azriel Fasten azriel.fasten@gmail.com
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "cubexx/linear_octree.hpp"
+
+#include <cassert>
+#include <algorithm>
+#include <utility>
+
+namespace cubexx{
+
+//###################################################################
+//#### linear_octree_t
+//###################################################################
+
+template<typename T, std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+std::uint64_t linear_octree_t<T, MaxDepth>::anchor(const code_type& code)
+{
+  return std::uint64_t(code.path()) << (3 * (MaxDepth - code.level()));
+}
+
+template<typename T, std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+std::uint64_t linear_octree_t<T, MaxDepth>::span(const code_type& code)
+{
+  return std::uint64_t(1) << (3 * (MaxDepth - code.level()));
+}
+
+template<typename T, std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+linear_octree_t<T, MaxDepth>::linear_octree_t()
+{}
+
+template<typename T, std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+linear_octree_t<T, MaxDepth>::linear_octree_t(std::vector<code_type> codes, std::vector<T> values)
+{
+  assert(codes.size() == values.size());
+
+  ///sort (anchor, original index) pairs, so each anchor is only worked out once, then gather
+  std::vector<std::pair<std::uint64_t, std::size_t>> order;
+  order.reserve(codes.size());
+  for (std::size_t i = 0; i < codes.size(); ++i)
+    order.emplace_back(anchor(codes[i]), i);
+  std::sort(order.begin(), order.end());
+
+  mcodes.reserve(codes.size());
+  mvalues.reserve(values.size());
+  for (const auto& entry : order)
+  {
+    mcodes.push_back(codes[entry.second]);
+    mvalues.push_back(std::move(values[entry.second]));
+  }
+
+  check();
+}
+
+template<typename T, std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+linear_octree_t<T, MaxDepth> linear_octree_t<T, MaxDepth>::from_sorted(std::vector<code_type> codes,
+                                                                      std::vector<T> values)
+{
+  assert(codes.size() == values.size());
+
+  linear_octree_t result;
+  result.mcodes = std::move(codes);
+  result.mvalues = std::move(values);
+  result.check();
+  return result;
+}
+
+template<typename T, std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+void linear_octree_t<T, MaxDepth>::check() const
+{
+#ifndef NDEBUG
+  ///each leaf must end before the next one starts
+  for (std::size_t i = 1; i < mcodes.size(); ++i)
+    assert(anchor(mcodes[i - 1]) + span(mcodes[i - 1]) <= anchor(mcodes[i]));
+#endif
+}
+
+template<typename T, std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+std::size_t linear_octree_t<T, MaxDepth>::size() const
+{
+  return mcodes.size();
+}
+
+template<typename T, std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+bool linear_octree_t<T, MaxDepth>::empty() const
+{
+  return mcodes.empty();
+}
+
+template<typename T, std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+const typename linear_octree_t<T, MaxDepth>::code_type& linear_octree_t<T, MaxDepth>::code(std::size_t i) const
+{
+  assert(i < mcodes.size());
+  return mcodes[i];
+}
+
+template<typename T, std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+const T& linear_octree_t<T, MaxDepth>::value(std::size_t i) const
+{
+  assert(i < mvalues.size());
+  return mvalues[i];
+}
+
+template<typename T, std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+T& linear_octree_t<T, MaxDepth>::value(std::size_t i)
+{
+  assert(i < mvalues.size());
+  return mvalues[i];
+}
+
+template<typename T, std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+const typename linear_octree_t<T, MaxDepth>::code_type* linear_octree_t<T, MaxDepth>::codes() const
+{
+  return mcodes.data();
+}
+
+template<typename T, std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+const T* linear_octree_t<T, MaxDepth>::values() const
+{
+  return mvalues.data();
+}
+
+template<typename T, std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+std::size_t linear_octree_t<T, MaxDepth>::lower_bound(std::uint64_t key) const
+{
+  return std::size_t(std::lower_bound(mcodes.begin(), mcodes.end(), key,
+                                      [](const code_type& code, std::uint64_t key){ return anchor(code) < key; })
+                     - mcodes.begin());
+}
+
+template<typename T, std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+std::size_t linear_octree_t<T, MaxDepth>::locate(const code_type& code) const
+{
+  const std::uint64_t key = anchor(code);
+  if (mcodes.empty() || anchor(mcodes.front()) > key)
+    return size();
+
+  ///invariant: the anchor at lo is <= key, and the one at hi (if any) is > key; the answer is lo once
+  /// they are adjacent
+  std::size_t lo = 0, hi = mcodes.size();
+  for (bool interpolate = true; hi - lo > 1; interpolate = !interpolate)
+  {
+    std::size_t probe = lo + (hi - lo) / 2;
+    if (interpolate)
+    {
+      std::uint64_t lo_key = anchor(mcodes[lo]);
+      std::uint64_t hi_key = anchor(mcodes[hi - 1]);
+      if (key >= hi_key)
+      {
+        lo = hi - 1;
+        break;
+      }
+      ///where key would be if the anchors were evenly spread over [lo_key, hi_key]
+      double fraction = double(key - lo_key) / double(hi_key - lo_key);
+      probe = lo + 1 + std::size_t(fraction * double(hi - lo - 2));
+      probe = std::min(std::max(probe, lo + 1), hi - 1);
+    }
+
+    if (anchor(mcodes[probe]) <= key)
+      lo = probe;
+    else
+      hi = probe;
+  }
+  return mcodes[lo].contains(code) ? lo : size();
+}
+
+template<typename T, std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+std::size_t linear_octree_t<T, MaxDepth>::locate_binary(const code_type& code) const
+{
+  ///the last leaf anchored at or before the code is the only one that can contain it
+  const std::uint64_t key = anchor(code);
+  std::size_t i = std::size_t(std::upper_bound(mcodes.begin(), mcodes.end(), key,
+                                               [](std::uint64_t key, const code_type& leaf){ return key < anchor(leaf); })
+                              - mcodes.begin());
+  if (i == 0 || !mcodes[i - 1].contains(code))
+    return size();
+  return i - 1;
+}
+
+template<typename T, std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+corner_set_t linear_octree_t<T, MaxDepth>::children(const code_type& node) const
+{
+  corner_set_t result;
+  if (node.level() == MaxDepth)
+    return result;
+
+  const std::uint64_t end = anchor(node) + span(node);
+  std::size_t i = lower_bound(anchor(node));
+  ///the leaves within the node are in child order; note each child that has one, then skip to the next child
+  while (i < mcodes.size() && anchor(mcodes[i]) < end)
+  {
+    if (mcodes[i].level() <= node.level())
+      ///the node is itself a leaf
+      return corner_set_t();
+    const corner_t& corner = mcodes[i].corner_at(node.level() + 1);
+    result |= corner;
+    code_type child = node.child(corner);
+    i = lower_bound(anchor(child) + span(child));
+  }
+  return result;
+}
+
+template<typename T, std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+typename linear_octree_t<T, MaxDepth>::range_t linear_octree_t<T, MaxDepth>::leaves(const code_type& node) const
+{
+  std::size_t first = lower_bound(anchor(node));
+  std::size_t last = lower_bound(anchor(node) + span(node));
+  ///the node might instead be within a leaf that starts before it
+  if (first == last && first > 0 && mcodes[first - 1].contains(node))
+    --first;
+  else if (first < last && !node.contains(mcodes[first]))
+    ///a leaf anchored at the node, but shallower; i.e. the node is within it
+    last = first + 1;
+  return range_t(const_iterator(this, first), const_iterator(this, last));
+}
+
+template<typename T, std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+typename linear_octree_t<T, MaxDepth>::const_iterator linear_octree_t<T, MaxDepth>::begin() const
+{
+  return const_iterator(this, 0);
+}
+
+template<typename T, std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+typename linear_octree_t<T, MaxDepth>::const_iterator linear_octree_t<T, MaxDepth>::end() const
+{
+  return const_iterator(this, size());
+}
+
+} // namespace cubexx
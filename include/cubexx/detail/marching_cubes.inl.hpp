@@ -0,0 +1,394 @@
+/*
+    Copyright (c) 2012 Azriel Fasten azriel.fasten@gmail.com
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "cubexx/marching_cubes.hpp"
+
+#include <cassert>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+namespace cubexx{
+
+namespace detail{
+
+///The vertex inside the cell that a loop may be fanned around, in place of an edge index.
+constexpr std::uint8_t marching_cubes_center = 12;
+
+///Whether the edges @p a and @p b (by index) are on one face of the cell; a side between them would cross it.
+constexpr bool marching_cubes_chord(std::uint8_t a, std::uint8_t b)
+{
+  bool chord = false;
+  for (std::size_t f = 0; f < 6; ++f)
+  {
+    const edge_set_t& on = face_t::all()[f].edge_set();
+    chord = chord || (on.contains(edge_t::get(a)) && on.contains(edge_t::get(b)));
+  }
+  return chord;
+}
+
+/**
+ * @brief Splits a loop of edges into triangles, with no side across a face of the cell (see marching_cubes_chord())
+ *          but the loop's own segments; so none is flat on a face either, where it could overlap the neighbor's.
+ *
+ * The interval of the loop from `i` to `j` is closed by the triangle `(i, m, j)`, with the intervals `[i, m]` and
+ * `[m, j]` split likewise; `m` is tried from `j - 1` down, so a fan from the loop's first edge is taken if it will do.
+ * Some loops around a tunnel cannot be split at all; see split().
+ */
+struct marching_cubes_split_t
+{
+  constexpr marching_cubes_split_t(const std::uint8_t* edges, std::size_t length)
+    : loop(), splits(), length(length)
+  {
+    for (std::size_t i = 0; i < length; ++i)
+      loop[i] = edges[i];
+    for (std::size_t span = 2; span < length; ++span)
+    {
+      for (std::size_t i = 0; i + span < length; ++i)
+      {
+        std::size_t j = i + span;
+        ///the side closing the interval is a segment of the loop only for the whole loop
+        if (span + 1 < length && marching_cubes_chord(loop[i], loop[j]))
+          continue;
+        for (std::size_t m = j - 1; m > i && splits[i][j] == 0; --m)
+        {
+          bool left = m - i == 1 || splits[i][m] != 0;
+          bool right = j - m == 1 || splits[m][j] != 0;
+          if (left && right)
+            splits[i][j] = std::uint8_t(m);
+        }
+      }
+    }
+  }
+
+  ///Whether the loop can be split into triangles; if not, it is fanned around marching_cubes_center.
+  constexpr bool split() const
+  {
+    return length < 3 || splits[0][length - 1] != 0;
+  }
+
+  ///Writes the triangles of the interval from @p i to @p j, in loop order, after the first @p count of them.
+  constexpr std::size_t emit(std::size_t i, std::size_t j, bool reverse, std::uint8_t* triangles,
+                             std::size_t count) const
+  {
+    if (j - i < 2)
+      return count;
+    std::size_t m = splits[i][j];
+    count = emit(i, m, reverse, triangles, count);
+    triangles[3 * count + 0] = loop[i];
+    triangles[3 * count + 1] = reverse ? loop[j] : loop[m];
+    triangles[3 * count + 2] = reverse ? loop[m] : loop[j];
+    return emit(m, j, reverse, triangles, count + 1);
+  }
+
+  ///Writes a triangle from marching_cubes_center to each segment of the loop, after the first @p count of them.
+  constexpr std::size_t emit_center(bool reverse, std::uint8_t* triangles, std::size_t count) const
+  {
+    for (std::size_t i = 0; i < length; ++i, ++count)
+    {
+      triangles[3 * count + 0] = marching_cubes_center;
+      triangles[3 * count + 1] = loop[reverse ? (i + 1) % length : i];
+      triangles[3 * count + 2] = loop[reverse ? i : (i + 1) % length];
+    }
+    return count;
+  }
+
+  std::uint8_t loop[12];
+  ///The `m` closing each interval; 0 if it cannot be split.
+  std::uint8_t splits[12][12];
+  std::size_t length;
+};
+
+/**
+ * @brief Triangulates case @p inside (as a mask) into @p triangles, 3 edge indices per triangle; returns the number
+ *          of triangles.
+ *
+ * See marching_cubes_triangle() for the rules. On the ambiguous faces in @p connected (a bit per face_t::index()),
+ * the rule is reversed: the edges meeting at an outside corner are joined, connecting the inside corners. A loop that
+ * cannot be split (see marching_cubes_split_t) is fanned around marching_cubes_center instead, and its edges are
+ * written to @p center as a mask; there is at most one such loop.
+ */
+constexpr std::size_t marching_cubes_triangulate(std::uint_fast8_t inside, std::uint8_t* triangles,
+                                                 std::uint_fast8_t connected = 0, std::uint16_t* center = nullptr)
+{
+  const std::uint8_t NONE = 12;
+
+  ///the edges that straddle the case
+  std::uint_fast16_t crossing = 0;
+  for (std::uint_fast8_t e = 0; e < 12; ++e)
+  {
+    const edge_t& edge = edge_t::get(e);
+    if (((inside >> edge.corner0().index()) & 1) != ((inside >> edge.corner1().index()) & 1))
+      crossing |= std::uint_fast16_t(1) << e;
+  }
+
+  ///the two edges each crossed edge is joined to, by a segment on each of its two faces
+  std::uint8_t partners[12][2] = {};
+  std::uint8_t degree[12] = {};
+  for (std::size_t f = 0; f < 6; ++f)
+  {
+    const face_t& face = face_t::all()[f];
+    std::uint8_t on[4] = {};
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < 4; ++i)
+      if ((crossing >> face.edges()[i].index()) & 1)
+        on[count++] = std::uint8_t(face.edges()[i].index());
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      for (std::size_t j = i + 1; j < count; ++j)
+      {
+        ///on the ambiguous face, only the edges meeting at an inside corner (or an outside one, if connected)
+        const edge_t& a = edge_t::get(on[i]);
+        const edge_t& b = edge_t::get(on[j]);
+        bool meeting_inside = ((connected >> face.index()) & 1) == 0;
+        bool joined = count == 2;
+        for (const corner_t& corner : {a.corner0(), a.corner1()})
+          joined = joined || ((corner == b.corner0() || corner == b.corner1())
+                              && (((inside >> corner.index()) & 1) != 0) == meeting_inside);
+        if (!joined)
+          continue;
+        partners[on[i]][degree[on[i]]++] = on[j];
+        partners[on[j]][degree[on[j]]++] = on[i];
+      }
+    }
+  }
+
+  std::size_t triangle_count = 0;
+  std::uint_fast16_t visited = 0;
+  for (std::uint8_t start = 0; start < 12; ++start)
+  {
+    if (!((crossing >> start) & 1) || ((visited >> start) & 1))
+      continue;
+
+    ///walk the loop
+    std::uint8_t loop[12] = {};
+    std::size_t length = 0;
+    std::uint8_t previous = NONE, current = start;
+    do
+    {
+      loop[length++] = current;
+      visited |= std::uint_fast16_t(1) << current;
+      std::uint8_t next = partners[current][0] != previous ? partners[current][0] : partners[current][1];
+      previous = current;
+      current = next;
+    } while (current != start);
+
+    ///orient the loop by its first segment, which lies on a face: seen from outside, the surface (inside the cell)
+    /// is to the left of it, so it runs along the cross product of the direction from the inside corners to the
+    /// outside ones and the face's outward normal; a neighbor sees the face's normal reversed, and so runs the
+    /// segment the other way, as a closed surface needs
+    int along[3] = {0, 0, 0}, outward[3] = {0, 0, 0}, normal[3] = {0, 0, 0};
+    for (std::size_t i = 0; i < 2; ++i)
+    {
+      const edge_t& edge = edge_t::get(loop[i]);
+      int sign = i == 0 ? -1 : 1;
+      along[0] += sign * (edge.corner0().ux() + edge.corner1().ux());
+      along[1] += sign * (edge.corner0().uy() + edge.corner1().uy());
+      along[2] += sign * (edge.corner0().uz() + edge.corner1().uz());
+
+      ///corner1 - corner0, flipped if corner1 is the inside one
+      int flip = (inside >> edge.corner1().index()) & 1 ? -1 : 1;
+      outward[0] += flip * (edge.corner1().ux() - edge.corner0().ux());
+      outward[1] += flip * (edge.corner1().uy() - edge.corner0().uy());
+      outward[2] += flip * (edge.corner1().uz() - edge.corner0().uz());
+    }
+    for (std::size_t f = 0; f < 6; ++f)
+    {
+      const face_t& face = face_t::all()[f];
+      if (face.edge_set().contains(edge_t::get(loop[0])) && face.edge_set().contains(edge_t::get(loop[1])))
+      {
+        normal[0] = face.direction().x();
+        normal[1] = face.direction().y();
+        normal[2] = face.direction().z();
+      }
+    }
+    int left[3] = {outward[1] * normal[2] - outward[2] * normal[1], outward[2] * normal[0] - outward[0] * normal[2],
+                   outward[0] * normal[1] - outward[1] * normal[0]};
+    bool reverse = along[0] * left[0] + along[1] * left[1] + along[2] * left[2] < 0;
+
+    ///fan from an edge that shares no face with any edge it is fanned to but its neighbors in the loop, so no side
+    /// crosses a face of the cell (where it could cross the neighbor's)
+    std::size_t apex = 0;
+    for (std::size_t candidate = 0; candidate < length; ++candidate)
+    {
+      bool chord = false;
+      for (std::size_t i = 2; i + 1 < length; ++i)
+        chord = chord || marching_cubes_chord(loop[candidate], loop[(candidate + i) % length]);
+      if (!chord)
+      {
+        apex = candidate;
+        break;
+      }
+    }
+
+    ///some of the long loops around a tunnel have no such edge; those are split up by intervals instead (see
+    /// marching_cubes_split_t), which gives the fan whenever there is one, and the rest are fanned around a vertex
+    /// inside the cell, as in MC33
+    std::uint8_t rotated[12] = {};
+    for (std::size_t i = 0; i < length; ++i)
+      rotated[i] = loop[(apex + i) % length];
+    marching_cubes_split_t split(rotated, length);
+    if (split.split())
+    {
+      triangle_count = split.emit(0, length - 1, reverse, triangles, triangle_count);
+      continue;
+    }
+    assert(center != nullptr && *center == 0);
+    for (std::size_t i = 0; i < length; ++i)
+      *center = std::uint16_t(*center | (1 << loop[i]));
+    triangle_count = split.emit_center(reverse, triangles, triangle_count);
+  }
+  return triangle_count;
+}
+
+constexpr std::size_t marching_cubes_compute_max_triangles()
+{
+  std::size_t result = 0;
+  for (std::size_t inside = 0; inside < 256; ++inside)
+  {
+    ///a surface crossing all 12 edges in one loop would have 10 triangles; none does, but there is room
+    std::uint8_t triangles[3 * 12] = {};
+    std::size_t count = marching_cubes_triangulate(std::uint_fast8_t(inside), triangles);
+    result = count > result ? count : result;
+  }
+  return result;
+}
+
+///The generated tables.
+struct marching_cubes_table_t
+{
+  std::uint16_t edges[256];
+  std::uint8_t triangle_counts[256];
+  std::uint8_t triangles[256][3 * marching_cubes_compute_max_triangles()];
+};
+
+constexpr marching_cubes_table_t marching_cubes_make_table()
+{
+  marching_cubes_table_t table = {};
+  for (std::size_t inside = 0; inside < 256; ++inside)
+  {
+    std::uint8_t triangles[3 * 12] = {};
+    std::size_t count = marching_cubes_triangulate(std::uint_fast8_t(inside), triangles);
+    table.triangle_counts[inside] = std::uint8_t(count);
+    for (std::size_t i = 0; i < 3 * count; ++i)
+      table.triangles[inside][i] = triangles[i];
+
+    for (std::uint_fast8_t e = 0; e < 12; ++e)
+    {
+      const edge_t& edge = edge_t::get(e);
+      if (((inside >> edge.corner0().index()) & 1) != ((inside >> edge.corner1().index()) & 1))
+        table.edges[inside] |= std::uint16_t(1 << e);
+    }
+  }
+  return table;
+}
+
+///A class template, so that the table has a single definition across translation units.
+template<typename dummy_t = void>
+struct marching_cubes_tables_t
+{
+  static constexpr marching_cubes_table_t table = marching_cubes_make_table();
+};
+
+template<typename dummy_t>
+constexpr marching_cubes_table_t marching_cubes_tables_t<dummy_t>::table;
+
+///marching_cubes_classify_row(), one cell at a time.
+CORNER_CASES_CUBEXX_INLINE
+void marching_cubes_classify_row_scalar(const float* const* rows, std::size_t n, float isovalue, std::uint8_t* cases)
+{
+  for (std::size_t x = 0; x < n; ++x)
+  {
+    std::uint_fast8_t result = 0;
+    for (std::size_t r = 0; r < 4; ++r)
+    {
+      ///row r is at dy = r&1, dz = r>>1; the corner at x has index 2*r, the one at x+1 has 2*r+1
+      result |= std::uint_fast8_t(rows[r][x] < isovalue) << (2 * r);
+      result |= std::uint_fast8_t(rows[r][x + 1] < isovalue) << (2 * r + 1);
+    }
+    cases[x] = std::uint8_t(result);
+  }
+}
+
+} // namespace detail
+
+//###################################################################
+//#### marching cubes
+//###################################################################
+
+constexpr std::size_t marching_cubes_max_triangles()
+{
+  return sizeof(detail::marching_cubes_table_t::triangles[0]) / 3;
+}
+
+constexpr edge_set_t marching_cubes_edges(const corner_set_t& inside)
+{
+  return edge_set_t::from_mask(edge_set_t::mask_type(detail::marching_cubes_tables_t<>::table.edges[inside.mask()]));
+}
+
+constexpr std::size_t marching_cubes_triangle_count(const corner_set_t& inside)
+{
+  return detail::marching_cubes_tables_t<>::table.triangle_counts[inside.mask()];
+}
+
+constexpr std::array<edge_t, 3> marching_cubes_triangle(const corner_set_t& inside, std::size_t i)
+{
+  return {{edge_t::get(std::uint_fast8_t(detail::marching_cubes_tables_t<>::table.triangles[inside.mask()][3 * i + 0])),
+           edge_t::get(std::uint_fast8_t(detail::marching_cubes_tables_t<>::table.triangles[inside.mask()][3 * i + 1])),
+           edge_t::get(std::uint_fast8_t(detail::marching_cubes_tables_t<>::table.triangles[inside.mask()][3 * i + 2]))}};
+}
+
+CORNER_CASES_CUBEXX_INLINE
+void marching_cubes_classify_row(const float* const* rows, std::size_t n, float isovalue, std::uint8_t* cases)
+{
+  std::size_t x = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+  const __m128 iso = _mm_set1_ps(isovalue);
+  for (; x + 16 <= n; x += 16)
+  {
+    __m128i result = _mm_setzero_si128();
+    for (std::size_t r = 0; r < 4; ++r)
+    {
+      for (std::size_t dx = 0; dx < 2; ++dx)
+      {
+        ///16 comparisons (all ones where inside), packed down to a byte each
+        const float* values = rows[r] + x + dx;
+        __m128i c0 = _mm_castps_si128(_mm_cmplt_ps(_mm_loadu_ps(values + 0), iso));
+        __m128i c1 = _mm_castps_si128(_mm_cmplt_ps(_mm_loadu_ps(values + 4), iso));
+        __m128i c2 = _mm_castps_si128(_mm_cmplt_ps(_mm_loadu_ps(values + 8), iso));
+        __m128i c3 = _mm_castps_si128(_mm_cmplt_ps(_mm_loadu_ps(values + 12), iso));
+        __m128i inside = _mm_packs_epi16(_mm_packs_epi32(c0, c1), _mm_packs_epi32(c2, c3));
+        result = _mm_or_si128(result, _mm_and_si128(inside, _mm_set1_epi8(char(1 << (2 * r + dx)))));
+      }
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(cases + x), result);
+  }
+#endif
+  const float* tails[4] = {rows[0] + x, rows[1] + x, rows[2] + x, rows[3] + x};
+  detail::marching_cubes_classify_row_scalar(tails, n - x, isovalue, cases + x);
+}
+
+} // namespace cubexx
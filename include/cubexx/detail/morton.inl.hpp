@@ -0,0 +1,382 @@
+/*
+    Copyright (c) 2012 Azriel Fasten azriel.fasten@gmail.com
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "cubexx/morton.hpp"
+
+#include <cassert>
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+namespace cubexx{
+
+namespace detail{
+
+CORNER_CASES_CUBEXX_INLINE
+std::uint64_t morton_dilate3(std::uint64_t v)
+{
+#if defined(__BMI2__) && (defined(__x86_64__) || defined(_M_X64))
+  return _pdep_u64(v, 0x1249249249249249);
+#else
+  v &= 0x1FFFFF;
+  v = (v | (v << 32)) & 0x001F00000000FFFF;
+  v = (v | (v << 16)) & 0x001F0000FF0000FF;
+  v = (v | (v << 8))  & 0x100F00F00F00F00F;
+  v = (v | (v << 4))  & 0x10C30C30C30C30C3;
+  v = (v | (v << 2))  & 0x1249249249249249;
+  return v;
+#endif
+}
+
+CORNER_CASES_CUBEXX_INLINE
+std::uint64_t morton_compact3(std::uint64_t v)
+{
+#if defined(__BMI2__) && (defined(__x86_64__) || defined(_M_X64))
+  return _pext_u64(v, 0x1249249249249249);
+#else
+  v &= 0x1249249249249249;
+  v = (v ^ (v >> 2))  & 0x10C30C30C30C30C3;
+  v = (v ^ (v >> 4))  & 0x100F00F00F00F00F;
+  v = (v ^ (v >> 8))  & 0x001F0000FF0000FF;
+  v = (v ^ (v >> 16)) & 0x001F00000000FFFF;
+  v = (v ^ (v >> 32)) & 0x1FFFFF;
+  return v;
+#endif
+}
+
+} // namespace detail
+
+
+//###################################################################
+//#### morton_code_t
+//###################################################################
+
+template<std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+constexpr morton_code_t<MaxDepth>::morton_code_t()
+  : mbits(1)
+{}
+
+template<std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+constexpr morton_code_t<MaxDepth>::morton_code_t(value_type bits)
+  : mbits(bits)
+{}
+
+template<std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+constexpr morton_code_t<MaxDepth> morton_code_t<MaxDepth>::root()
+{
+  return morton_code_t();
+}
+
+template<std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+constexpr morton_code_t<MaxDepth> morton_code_t<MaxDepth>::from_bits(value_type bits)
+{
+  ///the sentinel must be on a level boundary
+  assert(bits != 0);
+  assert((detail::bit_width(bits) - 1) % 3 == 0);
+  assert((detail::bit_width(bits) - 1) / 3 <= MaxDepth);
+  return morton_code_t(bits);
+}
+
+template<std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+morton_code_t<MaxDepth>
+morton_code_t<MaxDepth>::encode(std::uint_fast32_t x, std::uint_fast32_t y, std::uint_fast32_t z, std::size_t level)
+{
+  assert(level <= MaxDepth);
+  assert(x >> level == 0 && y >> level == 0 && z >> level == 0);
+  std::uint64_t path = detail::morton_dilate3(x)
+                     | (detail::morton_dilate3(y) << 1)
+                     | (detail::morton_dilate3(z) << 2);
+  return morton_code_t(value_type((std::uint64_t(1) << (3 * level)) | path));
+}
+
+template<std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+void morton_code_t<MaxDepth>::encode_n(const std::uint32_t* xs, const std::uint32_t* ys, const std::uint32_t* zs,
+                                       std::size_t level, morton_code_t* codes, std::size_t n)
+{
+  assert(level <= MaxDepth);
+  ///the sentinel is hoisted, and the loop has no dependencies between iterations, so the shift-and-mask
+  /// fallback vectorizes
+  const std::uint64_t sentinel = std::uint64_t(1) << (3 * level);
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    assert(xs[i] >> level == 0 && ys[i] >> level == 0 && zs[i] >> level == 0);
+    std::uint64_t path = detail::morton_dilate3(xs[i])
+                       | (detail::morton_dilate3(ys[i]) << 1)
+                       | (detail::morton_dilate3(zs[i]) << 2);
+    codes[i] = morton_code_t(value_type(sentinel | path));
+  }
+}
+
+template<std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+void morton_code_t<MaxDepth>::decode_n(const morton_code_t* codes,
+                                       std::uint32_t* xs, std::uint32_t* ys, std::uint32_t* zs, std::size_t n)
+{
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    std::uint64_t path = codes[i].path();
+    xs[i] = std::uint32_t(detail::morton_compact3(path));
+    ys[i] = std::uint32_t(detail::morton_compact3(path >> 1));
+    zs[i] = std::uint32_t(detail::morton_compact3(path >> 2));
+  }
+}
+
+template<std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+constexpr typename morton_code_t<MaxDepth>::value_type morton_code_t<MaxDepth>::bits() const
+{
+  return mbits;
+}
+
+template<std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+constexpr typename morton_code_t<MaxDepth>::value_type morton_code_t<MaxDepth>::path() const
+{
+  return value_type(mbits ^ (std::uint64_t(1) << (3 * level())));
+}
+
+template<std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+constexpr std::size_t morton_code_t<MaxDepth>::level() const
+{
+  return (detail::bit_width(mbits) - 1) / 3;
+}
+
+template<std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+constexpr bool morton_code_t<MaxDepth>::is_root() const
+{
+  return mbits == 1;
+}
+
+template<std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+constexpr morton_code_t<MaxDepth> morton_code_t<MaxDepth>::child(const corner_t& corner) const
+{
+  assert(level() < MaxDepth);
+  return morton_code_t(value_type((mbits << 3) | corner.index()));
+}
+
+template<std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+constexpr morton_code_t<MaxDepth> morton_code_t<MaxDepth>::parent() const
+{
+  assert(!is_root());
+  return morton_code_t(value_type(mbits >> 3));
+}
+
+template<std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+constexpr morton_code_t<MaxDepth> morton_code_t<MaxDepth>::ancestor(std::size_t level) const
+{
+  assert(level <= this->level());
+  return morton_code_t(value_type(mbits >> (3 * (this->level() - level))));
+}
+
+template<std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+constexpr const corner_t& morton_code_t<MaxDepth>::corner_at(std::size_t level) const
+{
+  assert(level >= 1 && level <= this->level());
+  return corner_t::get(std::uint_fast8_t((mbits >> (3 * (this->level() - level))) & 7));
+}
+
+template<std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+constexpr const corner_t& morton_code_t<MaxDepth>::corner() const
+{
+  assert(!is_root());
+  return corner_t::get(std::uint_fast8_t(mbits & 7));
+}
+
+template<std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+constexpr bool morton_code_t<MaxDepth>::contains(const morton_code_t& other) const
+{
+  return level() <= other.level() && (other.mbits >> (3 * (other.level() - level()))) == mbits;
+}
+
+template<std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+std::array<std::uint_fast32_t, 3> morton_code_t<MaxDepth>::decode() const
+{
+  std::uint64_t path = this->path();
+  return {{std::uint_fast32_t(detail::morton_compact3(path)),
+           std::uint_fast32_t(detail::morton_compact3(path >> 1)),
+           std::uint_fast32_t(detail::morton_compact3(path >> 2))}};
+}
+
+template<std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+constexpr bool morton_code_t<MaxDepth>::operator==(const morton_code_t& other) const
+{
+  return mbits == other.mbits;
+}
+
+template<std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+constexpr bool morton_code_t<MaxDepth>::operator!=(const morton_code_t& other) const
+{
+  return mbits != other.mbits;
+}
+
+template<std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+constexpr bool morton_code_t<MaxDepth>::operator<(const morton_code_t& other) const
+{
+  return mbits < other.mbits;
+}
+
+
+
+//###################################################################
+//#### neighbor
+//###################################################################
+
+namespace detail{
+
+///The cell offset by @p dx, @p dy, @p dz (each in `{-1, 0, +1}`) from @p code, on the same level.
+template<std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+morton_neighbor_t<MaxDepth> morton_offset(const morton_code_t<MaxDepth>& code, int dx, int dy, int dz)
+{
+  const std::uint64_t sentinel = std::uint64_t(1) << (3 * code.level());
+  const std::uint64_t path = code.path();
+  const int offsets[3] = {dx, dy, dz};
+
+  std::uint64_t result = 0;
+  bool outside = false;
+  for (std::size_t axis = 0; axis < 3; ++axis)
+  {
+    ///the bits of this axis, below the sentinel
+    const std::uint64_t mask = (std::uint64_t(0x1249249249249249) << axis) & (sentinel - 1);
+    std::uint64_t bits = path & mask;
+    if (offsets[axis] > 0)
+    {
+      ///filling the other axes' bits with ones makes the carries ripple through them
+      outside |= bits == mask;
+      bits = ((bits | ~mask) + 1) & mask;
+    }
+    else if (offsets[axis] < 0)
+    {
+      ///and the borrows ripple through zeros
+      outside |= bits == 0;
+      bits = (bits - 1) & mask;
+    }
+    result |= bits;
+  }
+  return {morton_code_t<MaxDepth>::from_bits(typename morton_code_t<MaxDepth>::value_type(sentinel | result)), outside};
+}
+
+///The components of the offset_t across @p element (a direction_t, edge_t or corner_t).
+template<typename element_t>
+CORNER_CASES_CUBEXX_INLINE
+std::array<int, 3> morton_offset_of(const element_t& element)
+{
+  const offset_t& offset = offset_t::get(element);
+  return {{offset.dx(), offset.dy(), offset.dz()}};
+}
+
+} // namespace detail
+
+template<std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+morton_neighbor_t<MaxDepth> neighbor(const morton_code_t<MaxDepth>& code, const direction_t& direction)
+{
+  assert(!direction.is_null());
+  auto offset = detail::morton_offset_of(direction);
+  return detail::morton_offset(code, offset[0], offset[1], offset[2]);
+}
+
+template<std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+morton_neighbor_t<MaxDepth> neighbor(const morton_code_t<MaxDepth>& code, const edge_t& edge)
+{
+  assert(!edge.is_null());
+  auto offset = detail::morton_offset_of(edge);
+  return detail::morton_offset(code, offset[0], offset[1], offset[2]);
+}
+
+template<std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+morton_neighbor_t<MaxDepth> neighbor(const morton_code_t<MaxDepth>& code, const corner_t& corner)
+{
+  assert(!corner.is_null());
+  auto offset = detail::morton_offset_of(corner);
+  return detail::morton_offset(code, offset[0], offset[1], offset[2]);
+}
+
+template<std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+morton_neighbor_t<MaxDepth> neighbor(const morton_code_t<MaxDepth>& code, const offset_t& offset)
+{
+  return detail::morton_offset(code, offset.dx(), offset.dy(), offset.dz());
+}
+
+template<std::size_t MaxDepth, typename element_t>
+CORNER_CASES_CUBEXX_INLINE
+void neighbor_n(const morton_code_t<MaxDepth>* codes, std::size_t n, const element_t& element,
+                morton_code_t<MaxDepth>* neighbors, bool* outside)
+{
+  assert(!element.is_null());
+  ///the offset is the same for every code, so the branches on its signs are taken once, here: per axis, the bits
+  /// to fill (ones for a carry to ripple through the other axes) and the amount to add (+1, -1 or 0) then step
+  /// every code without a branch
+  auto offset = detail::morton_offset_of(element);
+  std::uint64_t fill[3], add[3], moves[3];
+  for (std::size_t axis = 0; axis < 3; ++axis)
+  {
+    fill[axis] = offset[axis] > 0 ? ~std::uint64_t(0) : 0;
+    add[axis] = offset[axis] > 0 ? 1 : offset[axis] < 0 ? ~std::uint64_t(0) : 0;
+    moves[axis] = offset[axis] != 0 ? ~std::uint64_t(0) : 0;
+  }
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    const std::uint64_t sentinel = std::uint64_t(1) << (3 * codes[i].level());
+    const std::uint64_t path = codes[i].path();
+    std::uint64_t result = 0, overflows = 0;
+    for (std::size_t axis = 0; axis < 3; ++axis)
+    {
+      const std::uint64_t mask = (std::uint64_t(0x1249249249249249) << axis) & (sentinel - 1);
+      std::uint64_t bits = path & mask;
+      ///stepping out of the root: up from all ones, or down from all zeros
+      overflows |= moves[axis] & (0 - std::uint64_t(bits == (mask & fill[axis])));
+      result |= ((bits | (~mask & fill[axis])) + add[axis]) & mask;
+    }
+    neighbors[i] = morton_code_t<MaxDepth>::from_bits(typename morton_code_t<MaxDepth>::value_type(sentinel | result));
+    if (outside)
+      outside[i] = overflows != 0;
+  }
+}
+
+} // namespace cubexx
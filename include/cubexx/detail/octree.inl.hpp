@@ -0,0 +1,338 @@
+/*
+    Copyright (c) 2012 Azriel Fasten azriel.fasten@gmail.com
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "cubexx/octree.hpp"
+
+#include <cassert>
+#include <new>
+#include <utility>
+
+namespace cubexx{
+
+//###################################################################
+//#### octree_t
+//###################################################################
+
+template<typename T, std::size_t BlocksPerSlab>
+CORNER_CASES_CUBEXX_INLINE
+octree_t<T, BlocksPerSlab>::octree_t()
+  : octree_t(0)
+{}
+
+template<typename T, std::size_t BlocksPerSlab>
+CORNER_CASES_CUBEXX_INLINE
+octree_t<T, BlocksPerSlab>::octree_t(std::size_t blocks)
+  : mfree(null_node()), mblocks(0), mnodes(1)
+{
+  ///block 0 holds the root (in its first node), and is never freed
+  std::uint32_t root_block = allocate_block();
+  assert(root_block == 0);
+  (void)root_block;
+  reserve(blocks);
+}
+
+template<typename T, std::size_t BlocksPerSlab>
+CORNER_CASES_CUBEXX_INLINE
+octree_t<T, BlocksPerSlab>::~octree_t()
+{
+  for (block_t* slab : mslabs)
+    for (std::size_t i = 0; i < BlocksPerSlab; ++i)
+      slab[i].~block_t();
+}
+
+template<typename T, std::size_t BlocksPerSlab>
+CORNER_CASES_CUBEXX_INLINE
+octree_t<T, BlocksPerSlab>& octree_t<T, BlocksPerSlab>::operator=(octree_t&& other)
+{
+  mslab_memory.swap(other.mslab_memory);
+  mslabs.swap(other.mslabs);
+  std::swap(mfree, other.mfree);
+  std::swap(mblocks, other.mblocks);
+  std::swap(mnodes, other.mnodes);
+  return *this;
+}
+
+template<typename T, std::size_t BlocksPerSlab>
+CORNER_CASES_CUBEXX_INLINE
+constexpr typename octree_t<T, BlocksPerSlab>::node_id octree_t<T, BlocksPerSlab>::root()
+{
+  return 0;
+}
+
+template<typename T, std::size_t BlocksPerSlab>
+CORNER_CASES_CUBEXX_INLINE
+std::size_t octree_t<T, BlocksPerSlab>::size() const
+{
+  return mnodes;
+}
+
+template<typename T, std::size_t BlocksPerSlab>
+CORNER_CASES_CUBEXX_INLINE
+std::size_t octree_t<T, BlocksPerSlab>::block_count() const
+{
+  return mblocks - 1;
+}
+
+template<typename T, std::size_t BlocksPerSlab>
+CORNER_CASES_CUBEXX_INLINE
+std::size_t octree_t<T, BlocksPerSlab>::capacity() const
+{
+  return mslabs.size() * BlocksPerSlab - 1;
+}
+
+template<typename T, std::size_t BlocksPerSlab>
+CORNER_CASES_CUBEXX_INLINE
+void octree_t<T, BlocksPerSlab>::reserve(std::size_t blocks)
+{
+  ///one more for the root's block
+  while (mslabs.size() * BlocksPerSlab < blocks + 1)
+    add_slab();
+}
+
+template<typename T, std::size_t BlocksPerSlab>
+CORNER_CASES_CUBEXX_INLINE
+void octree_t<T, BlocksPerSlab>::add_slab()
+{
+  assert((mslabs.size() + 1) * BlocksPerSlab * 8 <= std::size_t(null_node()));
+
+  ///over-allocate, so the blocks can start on a cache line
+  const std::size_t alignment = 64;
+  std::unique_ptr<unsigned char[]> memory(new unsigned char[sizeof(block_t) * BlocksPerSlab + alignment]);
+  std::uintptr_t address = reinterpret_cast<std::uintptr_t>(memory.get());
+  address = (address + alignment - 1) & ~std::uintptr_t(alignment - 1);
+  block_t* slab = reinterpret_cast<block_t*>(address);
+  for (std::size_t i = 0; i < BlocksPerSlab; ++i)
+    new (&slab[i]) block_t();
+
+  const std::uint32_t first = std::uint32_t(mslabs.size() * BlocksPerSlab);
+  mslab_memory.push_back(std::move(memory));
+  mslabs.push_back(slab);
+
+  ///push in reverse, so the blocks are handed out in order
+  for (std::size_t i = BlocksPerSlab; i-- > 0;)
+  {
+    slab[i].nodes[0].block = mfree;
+    mfree = first + std::uint32_t(i);
+  }
+}
+
+template<typename T, std::size_t BlocksPerSlab>
+CORNER_CASES_CUBEXX_INLINE
+std::uint32_t octree_t<T, BlocksPerSlab>::allocate_block()
+{
+  if (mfree == null_node())
+    add_slab();
+  std::uint32_t block = mfree;
+  block_t& nodes = get_block(block);
+  mfree = nodes.nodes[0].block;
+  for (auto& node : nodes.nodes)
+  {
+    node.block = null_node();
+    node.child_mask = corner_set_t();
+  }
+  ++mblocks;
+  return block;
+}
+
+template<typename T, std::size_t BlocksPerSlab>
+CORNER_CASES_CUBEXX_INLINE
+void octree_t<T, BlocksPerSlab>::free_block(std::uint32_t block)
+{
+  assert(block != 0);
+  block_t& nodes = get_block(block);
+  for (auto& node : nodes.nodes)
+    node.value = T();
+  nodes.nodes[0].block = mfree;
+  mfree = block;
+  --mblocks;
+}
+
+template<typename T, std::size_t BlocksPerSlab>
+CORNER_CASES_CUBEXX_INLINE
+typename octree_t<T, BlocksPerSlab>::block_t& octree_t<T, BlocksPerSlab>::get_block(std::uint32_t block)
+{
+  assert(block / BlocksPerSlab < mslabs.size());
+  return mslabs[block / BlocksPerSlab][block % BlocksPerSlab];
+}
+
+template<typename T, std::size_t BlocksPerSlab>
+CORNER_CASES_CUBEXX_INLINE
+typename octree_t<T, BlocksPerSlab>::node_t& octree_t<T, BlocksPerSlab>::get(node_id node)
+{
+  assert(node != null_node());
+  return get_block(node >> 3).nodes[node & 7];
+}
+
+template<typename T, std::size_t BlocksPerSlab>
+CORNER_CASES_CUBEXX_INLINE
+const typename octree_t<T, BlocksPerSlab>::node_t& octree_t<T, BlocksPerSlab>::get(node_id node) const
+{
+  return const_cast<octree_t*>(this)->get(node);
+}
+
+template<typename T, std::size_t BlocksPerSlab>
+CORNER_CASES_CUBEXX_INLINE
+T& octree_t<T, BlocksPerSlab>::value(node_id node)
+{
+  return get(node).value;
+}
+
+template<typename T, std::size_t BlocksPerSlab>
+CORNER_CASES_CUBEXX_INLINE
+const T& octree_t<T, BlocksPerSlab>::value(node_id node) const
+{
+  return get(node).value;
+}
+
+template<typename T, std::size_t BlocksPerSlab>
+CORNER_CASES_CUBEXX_INLINE
+corner_set_t octree_t<T, BlocksPerSlab>::children(node_id node) const
+{
+  return get(node).child_mask;
+}
+
+template<typename T, std::size_t BlocksPerSlab>
+CORNER_CASES_CUBEXX_INLINE
+bool octree_t<T, BlocksPerSlab>::is_leaf(node_id node) const
+{
+  return get(node).child_mask.empty();
+}
+
+template<typename T, std::size_t BlocksPerSlab>
+CORNER_CASES_CUBEXX_INLINE
+typename octree_t<T, BlocksPerSlab>::node_id
+octree_t<T, BlocksPerSlab>::child(node_id node, const corner_t& corner) const
+{
+  const node_t& parent = get(node);
+  if (!parent.child_mask.contains(corner))
+    return null_node();
+  return (parent.block << 3) | corner.index();
+}
+
+template<typename T, std::size_t BlocksPerSlab>
+CORNER_CASES_CUBEXX_INLINE
+const corner_t& octree_t<T, BlocksPerSlab>::corner(node_id node)
+{
+  assert(node != root());
+  return corner_t::get(std::uint_fast8_t(node & 7));
+}
+
+template<typename T, std::size_t BlocksPerSlab>
+CORNER_CASES_CUBEXX_INLINE
+typename octree_t<T, BlocksPerSlab>::node_id
+octree_t<T, BlocksPerSlab>::insert_child(node_id node, const corner_t& corner, const T& value)
+{
+  ///slabs never move, so the reference stays good even if allocating adds one
+  node_t& parent = get(node);
+  if (parent.child_mask.empty())
+    parent.block = allocate_block();
+  node_id result = (parent.block << 3) | corner.index();
+  if (!parent.child_mask.contains(corner))
+  {
+    parent.child_mask |= corner;
+    get(result).value = value;
+    ++mnodes;
+  }
+  return result;
+}
+
+template<typename T, std::size_t BlocksPerSlab>
+CORNER_CASES_CUBEXX_INLINE
+void octree_t<T, BlocksPerSlab>::subdivide(node_id node, const T& value)
+{
+  for (const auto& corner : corner_t::all())
+    if (!get(node).child_mask.contains(corner))
+      insert_child(node, corner, value);
+}
+
+template<typename T, std::size_t BlocksPerSlab>
+CORNER_CASES_CUBEXX_INLINE
+void octree_t<T, BlocksPerSlab>::erase_below(node_id node)
+{
+  node_t& parent = get(node);
+  for (const corner_t& corner : parent.child_mask)
+  {
+    erase_below((parent.block << 3) | corner.index());
+    --mnodes;
+  }
+  if (!parent.child_mask.empty())
+    free_block(parent.block);
+  parent.child_mask = corner_set_t();
+  parent.block = null_node();
+}
+
+template<typename T, std::size_t BlocksPerSlab>
+CORNER_CASES_CUBEXX_INLINE
+void octree_t<T, BlocksPerSlab>::erase_child(node_id node, const corner_t& corner)
+{
+  node_id removed = child(node, corner);
+  if (removed == null_node())
+    return;
+  erase_below(removed);
+  get(removed).value = T();
+  --mnodes;
+
+  node_t& parent = get(node);
+  parent.child_mask -= corner;
+  if (parent.child_mask.empty())
+  {
+    free_block(parent.block);
+    parent.block = null_node();
+  }
+}
+
+template<typename T, std::size_t BlocksPerSlab>
+CORNER_CASES_CUBEXX_INLINE
+void octree_t<T, BlocksPerSlab>::erase_children(node_id node)
+{
+  erase_below(node);
+}
+
+template<typename T, std::size_t BlocksPerSlab>
+template<std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+typename octree_t<T, BlocksPerSlab>::node_id
+octree_t<T, BlocksPerSlab>::find(const morton_code_t<MaxDepth>& code) const
+{
+  node_id node = root();
+  for (std::size_t level = 1; level <= code.level() && node != null_node(); ++level)
+    node = child(node, code.corner_at(level));
+  return node;
+}
+
+template<typename T, std::size_t BlocksPerSlab>
+template<std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+typename octree_t<T, BlocksPerSlab>::node_id
+octree_t<T, BlocksPerSlab>::insert(const morton_code_t<MaxDepth>& code, const T& value)
+{
+  node_id node = root();
+  for (std::size_t level = 1; level <= code.level(); ++level)
+    node = insert_child(node, code.corner_at(level), value);
+  return node;
+}
+
+} // namespace cubexx
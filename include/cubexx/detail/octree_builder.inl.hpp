@@ -0,0 +1,327 @@
+/*
+    Copyright (c) 2012 Azriel Fasten azriel.fasten@gmail.com
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "cubexx/octree_builder.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace cubexx{
+
+namespace detail{
+
+CORNER_CASES_CUBEXX_INLINE
+void quantize_n(const float* vs, std::uint32_t* qs, std::size_t n, float lower, float scale, std::uint32_t cells)
+{
+  ///ceil(t) - 1 rather than floor(t), so that a coordinate on a boundary goes to the cell below it
+  const float highest = float(cells - 1);
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    float t = std::ceil((vs[i] - lower) * scale) - 1.0f;
+    t = t < 0.0f ? 0.0f : t;
+    t = t > highest ? highest : t;
+    qs[i] = std::uint32_t(t);
+  }
+}
+
+///radix_sort(), with @p values optional (null for none).
+CORNER_CASES_CUBEXX_INLINE
+void radix_sort_impl(thread_pool_t& pool, std::vector<std::uint64_t>& keys, std::vector<std::uint32_t>* values,
+                     std::size_t bits)
+{
+  assert(!values || keys.size() == values->size());
+  assert(bits <= 64);
+
+  const std::size_t DIGIT_BITS = 11;
+  const std::size_t RADIX = std::size_t(1) << DIGIT_BITS;
+  const std::size_t n = keys.size();
+  if (n < 2)
+    return;
+
+  ///a few blocks per thread, but none so small that its histogram costs more than its keys
+  const std::size_t blocks = std::max<std::size_t>(1, std::min(pool.size() * 4, n / (RADIX * 4)));
+  const std::size_t block_size = (n + blocks - 1) / blocks;
+
+  std::vector<std::uint64_t> key_buffer(n);
+  std::vector<std::uint32_t> value_buffer(values ? n : 0);
+  ///digit-major within each block: `histograms[block*RADIX + digit]`
+  std::vector<std::size_t> histograms(blocks * RADIX);
+
+  for (std::size_t shift = 0; shift < bits; shift += DIGIT_BITS)
+  {
+    const std::uint64_t* source = keys.data();
+    pool.run(blocks, [&](std::size_t block){
+      std::size_t* histogram = histograms.data() + block * RADIX;
+      std::fill(histogram, histogram + RADIX, std::size_t(0));
+      std::size_t first = block * block_size, last = std::min(n, first + block_size);
+      for (std::size_t i = first; i < last; ++i)
+        ++histogram[(source[i] >> shift) & (RADIX - 1)];
+    });
+
+    ///turn the counts into where each block puts each digit; every block's 0s, then every block's 1s, ...
+    std::size_t offset = 0;
+    bool shared = false;
+    for (std::size_t digit = 0; digit < RADIX && !shared; ++digit)
+    {
+      std::size_t digit_first = offset;
+      for (std::size_t block = 0; block < blocks; ++block)
+      {
+        std::size_t count = histograms[block * RADIX + digit];
+        histograms[block * RADIX + digit] = offset;
+        offset += count;
+      }
+      shared = offset - digit_first == n;
+    }
+    ///every key has the same digit; the pass would not move anything
+    if (shared)
+      continue;
+
+    pool.run(blocks, [&](std::size_t block){
+      std::size_t* offsets = histograms.data() + block * RADIX;
+      std::size_t first = block * block_size, last = std::min(n, first + block_size);
+      for (std::size_t i = first; i < last; ++i)
+      {
+        std::size_t j = offsets[(keys[i] >> shift) & (RADIX - 1)]++;
+        key_buffer[j] = keys[i];
+        if (values)
+          value_buffer[j] = (*values)[i];
+      }
+    });
+    keys.swap(key_buffer);
+    if (values)
+      values->swap(value_buffer);
+  }
+}
+
+CORNER_CASES_CUBEXX_INLINE
+void radix_sort(thread_pool_t& pool, std::vector<std::uint64_t>& keys, std::vector<std::uint32_t>& values,
+                std::size_t bits)
+{
+  radix_sort_impl(pool, keys, &values, bits);
+}
+
+CORNER_CASES_CUBEXX_INLINE
+void radix_sort(thread_pool_t& pool, std::vector<std::uint64_t>& keys, std::size_t bits)
+{
+  radix_sort_impl(pool, keys, nullptr, bits);
+}
+
+} // namespace detail
+
+//###################################################################
+//#### point_octree_t
+//###################################################################
+
+template<std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+octree_t<typename point_octree_t<MaxDepth>::points_t> point_octree_t<MaxDepth>::pooled() const
+{
+  ///one block for the children of each internal node, and the root's
+  octree_t<points_t> result(nodes.size() + 1);
+  for (std::size_t i = 0; i < leaves.size(); ++i)
+    result.value(result.insert(leaves.code(i), points_t())) = leaves.value(i);
+  return result;
+}
+
+//###################################################################
+//#### octree_builder_t
+//###################################################################
+
+template<std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+octree_builder_t<MaxDepth>::octree_builder_t(thread_pool_t& pool, std::size_t leaf_capacity)
+  : mpool(pool), mleaf_capacity(leaf_capacity)
+{
+  assert(leaf_capacity > 0);
+}
+
+template<std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+std::size_t octree_builder_t<MaxDepth>::leaf_capacity() const
+{
+  return mleaf_capacity;
+}
+
+template<std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+typename octree_builder_t<MaxDepth>::result_type
+octree_builder_t<MaxDepth>::build(const float* xs, const float* ys, const float* zs, std::size_t n,
+                                  const std::array<float, 3>& lower, float size) const
+{
+  assert(size > 0);
+  const std::uint32_t cells = std::uint32_t(1) << MaxDepth;
+  const float scale = float(cells) / size;
+
+  std::vector<std::uint64_t> keys(n);
+  mpool.run((n + BLOCK_SIZE() - 1) / BLOCK_SIZE(), [&](std::size_t block){
+    ///quantize a chunk at a time into the stack, then interleave
+    const std::size_t CHUNK_SIZE = 256;
+    std::uint32_t qx[CHUNK_SIZE], qy[CHUNK_SIZE], qz[CHUNK_SIZE];
+
+    std::size_t last = std::min(n, (block + 1) * BLOCK_SIZE());
+    for (std::size_t first = block * BLOCK_SIZE(); first < last; first += CHUNK_SIZE)
+    {
+      std::size_t count = std::min(CHUNK_SIZE, last - first);
+      detail::quantize_n(xs + first, qx, count, lower[0], scale, cells);
+      detail::quantize_n(ys + first, qy, count, lower[1], scale, cells);
+      detail::quantize_n(zs + first, qz, count, lower[2], scale, cells);
+      for (std::size_t i = 0; i < count; ++i)
+        keys[first + i] = detail::morton_dilate3(qx[i])
+                        | (detail::morton_dilate3(qy[i]) << 1)
+                        | (detail::morton_dilate3(qz[i]) << 2);
+    }
+  });
+  return build(keys);
+}
+
+template<std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+typename octree_builder_t<MaxDepth>::result_type
+octree_builder_t<MaxDepth>::build(const std::uint32_t* xs, const std::uint32_t* ys, const std::uint32_t* zs,
+                                  std::size_t n) const
+{
+  std::vector<std::uint64_t> keys(n);
+  mpool.run((n + BLOCK_SIZE() - 1) / BLOCK_SIZE(), [&](std::size_t block){
+    std::size_t last = std::min(n, (block + 1) * BLOCK_SIZE());
+    for (std::size_t i = block * BLOCK_SIZE(); i < last; ++i)
+    {
+      assert(xs[i] >> MaxDepth == 0 && ys[i] >> MaxDepth == 0 && zs[i] >> MaxDepth == 0);
+      keys[i] = detail::morton_dilate3(xs[i])
+              | (detail::morton_dilate3(ys[i]) << 1)
+              | (detail::morton_dilate3(zs[i]) << 2);
+    }
+  });
+  return build(keys);
+}
+
+template<std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+typename octree_builder_t<MaxDepth>::result_type
+octree_builder_t<MaxDepth>::build(std::vector<std::uint64_t>& keys) const
+{
+  const std::size_t n = keys.size();
+  assert(n <= std::numeric_limits<std::uint32_t>::max());
+
+  result_type result;
+  if (n == 0)
+    return result;
+
+  result.order.resize(n);
+  mpool.run((n + BLOCK_SIZE() - 1) / BLOCK_SIZE(), [&](std::size_t block){
+    std::size_t last = std::min(n, (block + 1) * BLOCK_SIZE());
+    for (std::size_t i = block * BLOCK_SIZE(); i < last; ++i)
+      result.order[i] = std::uint32_t(i);
+  });
+  detail::radix_sort(mpool, keys, result.order, 3 * MaxDepth);
+
+  ///split the top of the tree here, into enough pieces to keep the pool busy
+  std::vector<cell_t> pieces;
+  std::vector<bool> done;
+  split(keys.data(), cell_t{code_type::root(), 0, n}, std::max(mleaf_capacity, n / (mpool.size() * 8)),
+        pieces, done);
+
+  std::vector<std::vector<cell_t>> piece_leaves(pieces.size());
+  mpool.run(pieces.size(), [&](std::size_t i){
+    std::vector<bool> piece_done;
+    if (done[i])
+      piece_leaves[i].push_back(pieces[i]);
+    else
+      split(keys.data(), pieces[i], mleaf_capacity, piece_leaves[i], piece_done);
+  });
+
+  std::vector<code_type> codes;
+  std::vector<points_t> points;
+  for (const auto& leaves : piece_leaves)
+  {
+    for (const cell_t& leaf : leaves)
+    {
+      codes.push_back(leaf.code);
+      points.push_back(points_t{std::uint32_t(leaf.first), std::uint32_t(leaf.last - leaf.first)});
+    }
+  }
+
+  ///bottom-up: walk up from each leaf, stopping at the first ancestor already seen; since the leaves are in
+  /// Morton order, an ancestor already seen is the last one on its level
+  std::vector<std::vector<typename result_type::node_t>> levels(MaxDepth);
+  for (const code_type& leaf : codes)
+  {
+    code_type cell = leaf;
+    while (!cell.is_root())
+    {
+      code_type parent = cell.parent();
+      auto& level = levels[parent.level()];
+      bool seen = !level.empty() && level.back().code == parent;
+      if (!seen)
+        level.push_back(typename result_type::node_t{parent, corner_set_t()});
+      level.back().children |= cell.corner();
+      if (seen)
+        break;
+      cell = parent;
+    }
+  }
+  for (std::size_t level = MaxDepth; level-- > 0; )
+    result.nodes.insert(result.nodes.end(), levels[level].begin(), levels[level].end());
+
+  result.leaves = linear_octree_t<points_t, MaxDepth>::from_sorted(std::move(codes), std::move(points));
+  return result;
+}
+
+template<std::size_t MaxDepth>
+CORNER_CASES_CUBEXX_INLINE
+void octree_builder_t<MaxDepth>::split(const std::uint64_t* keys, const cell_t& cell, std::size_t grain,
+                                       std::vector<cell_t>& pieces, std::vector<bool>& done) const
+{
+  std::size_t count = cell.last - cell.first;
+  if (count <= mleaf_capacity || cell.code.level() == MaxDepth)
+  {
+    pieces.push_back(cell);
+    done.push_back(true);
+    return;
+  }
+  if (count <= grain)
+  {
+    pieces.push_back(cell);
+    done.push_back(false);
+    return;
+  }
+
+  ///the keys within the cell all share its path, and are sorted on the next 3 bits: the child's corner
+  const std::size_t shift = 3 * (MaxDepth - cell.code.level() - 1);
+  std::size_t first = cell.first;
+  for (const corner_t& corner : corner_t::all())
+  {
+    std::uint64_t index = corner.index();
+    std::size_t last = std::size_t(std::partition_point(keys + first, keys + cell.last, [&](std::uint64_t key){
+      return ((key >> shift) & 7) <= index;
+    }) - keys);
+    if (last != first)
+      split(keys, cell_t{cell.code.child(corner), first, last}, grain, pieces, done);
+    first = last;
+  }
+}
+
+} // namespace cubexx
@@ -0,0 +1,335 @@
+/*
+    Copyright (c) 2012 Azriel Fasten azriel.fasten@gmail.com
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "cubexx/offset.hpp"
+
+#include <cassert>
+#include <utility>
+
+namespace cubexx{
+
+//###################################################################
+//#### offset_t construction
+//###################################################################
+
+constexpr offset_t::offset_t()
+  : mindex(13)
+{
+
+}
+
+constexpr offset_t::offset_t(std::uint8_t idx)
+  : mindex(idx)
+{
+
+}
+
+namespace detail{
+
+///The tables behind offset_t.
+struct offset_table_t
+{
+  std::array<offset_t, 27> all;
+  std::array<std::int_fast8_t, 3> xyz[27];
+  ///The offset of each element, by its index.
+  std::uint8_t directions[6];
+  std::uint8_t edges[12];
+  std::uint8_t corners[8];
+  ///The index of the direction_t, edge_t or corner_t each offset goes through; 0 for the center.
+  std::uint8_t elements[27];
+  ///The offsets with 0, 1, 2 and 3 non-zero components, as offset_set_t masks.
+  std::uint32_t kinds[4];
+};
+
+struct offset_builder_t
+{
+  static constexpr std::uint8_t index(int dx, int dy, int dz)
+  {
+    return std::uint8_t((dx + 1) + 3 * (dy + 1) + 9 * (dz + 1));
+  }
+
+  template<std::size_t... Indices>
+  static constexpr std::array<offset_t, 27> all(std::index_sequence<Indices...>)
+  {
+    return {{offset_t(std::uint8_t(Indices))...}};
+  }
+
+  static constexpr offset_table_t build()
+  {
+    offset_table_t table = {};
+    table.all = all(std::make_index_sequence<27>());
+    for (int i = 0; i < 27; ++i)
+    {
+      int dx = i % 3 - 1, dy = i / 3 % 3 - 1, dz = i / 9 - 1;
+      table.xyz[i] = std::array<std::int_fast8_t, 3>{{std::int_fast8_t(dx), std::int_fast8_t(dy),
+                                                      std::int_fast8_t(dz)}};
+      table.kinds[(dx != 0) + (dy != 0) + (dz != 0)] |= std::uint32_t(1) << i;
+    }
+    for (std::uint_fast8_t d = 0; d < 6; ++d)
+    {
+      const direction_t& direction = direction_t::get(d);
+      table.directions[d] = index(direction.x(), direction.y(), direction.z());
+      table.elements[table.directions[d]] = std::uint8_t(d);
+    }
+    for (std::uint_fast8_t e = 0; e < 12; ++e)
+    {
+      ///the corners agree on the two axes the edge is not on, and cancel out on the one it is on
+      const edge_t& edge = edge_t::get(e);
+      table.edges[e] = index((edge.corner0().x() + edge.corner1().x()) / 2,
+                             (edge.corner0().y() + edge.corner1().y()) / 2,
+                             (edge.corner0().z() + edge.corner1().z()) / 2);
+      table.elements[table.edges[e]] = std::uint8_t(e);
+    }
+    for (std::uint_fast8_t c = 0; c < 8; ++c)
+    {
+      const corner_t& corner = corner_t::get(c);
+      table.corners[c] = index(corner.x(), corner.y(), corner.z());
+      table.elements[table.corners[c]] = std::uint8_t(c);
+    }
+    return table;
+  }
+};
+
+template<typename T = void>
+struct offset_tables_t
+{
+  static constexpr offset_table_t table = offset_builder_t::build();
+};
+
+template<typename T> constexpr offset_table_t offset_tables_t<T>::table;
+
+static_assert(sizeof(offset_t) == 1, "offset_t should be a single byte");
+
+} // namespace detail
+
+//###################################################################
+//#### offset_t
+//###################################################################
+
+constexpr const offset_t& offset_t::get(std::int_fast8_t dx, std::int_fast8_t dy, std::int_fast8_t dz)
+{
+  assert(dx >= -1 && dx <= 1 && dy >= -1 && dy <= 1 && dz >= -1 && dz <= 1);
+  return all()[detail::offset_builder_t::index(dx, dy, dz)];
+}
+
+constexpr const offset_t& offset_t::get(std::uint_fast8_t idx)
+{
+  assert(idx < SIZE());
+  return all()[idx];
+}
+
+constexpr const offset_t& offset_t::get(const offset_t& offset)
+{
+  return all()[offset.mindex];
+}
+
+constexpr const offset_t& offset_t::get(const direction_t& direction)
+{
+  assert(!direction.is_null());
+  return all()[detail::offset_tables_t<>::table.directions[direction.index()]];
+}
+
+constexpr const offset_t& offset_t::get(const face_t& face)
+{
+  assert(!face.is_null());
+  return all()[detail::offset_tables_t<>::table.directions[face.index()]];
+}
+
+constexpr const offset_t& offset_t::get(const edge_t& edge)
+{
+  assert(!edge.is_null());
+  return all()[detail::offset_tables_t<>::table.edges[edge.index()]];
+}
+
+constexpr const offset_t& offset_t::get(const corner_t& corner)
+{
+  assert(!corner.is_null());
+  return all()[detail::offset_tables_t<>::table.corners[corner.index()]];
+}
+
+constexpr const offset_t& offset_t::center()
+{
+  return all()[13];
+}
+
+constexpr const std::array<offset_t, 27>& offset_t::all()
+{
+  return detail::offset_tables_t<>::table.all;
+}
+
+constexpr std::int_fast8_t offset_t::dx() const
+{
+  return xyz()[0];
+}
+
+constexpr std::int_fast8_t offset_t::dy() const
+{
+  return xyz()[1];
+}
+
+constexpr std::int_fast8_t offset_t::dz() const
+{
+  return xyz()[2];
+}
+
+constexpr const std::array<std::int_fast8_t, 3>& offset_t::xyz() const
+{
+  return detail::offset_tables_t<>::table.xyz[mindex];
+}
+
+constexpr const offset_t& offset_t::opposite() const
+{
+  return all()[26 - mindex];
+}
+
+constexpr bool offset_t::is_center() const
+{
+  return mindex == 13;
+}
+
+constexpr bool offset_t::is_face() const
+{
+  return ((detail::offset_tables_t<>::table.kinds[1] >> mindex) & 1) != 0;
+}
+
+constexpr bool offset_t::is_edge() const
+{
+  return ((detail::offset_tables_t<>::table.kinds[2] >> mindex) & 1) != 0;
+}
+
+constexpr bool offset_t::is_corner() const
+{
+  return ((detail::offset_tables_t<>::table.kinds[3] >> mindex) & 1) != 0;
+}
+
+constexpr const direction_t& offset_t::direction() const
+{
+  assert(is_face());
+  return direction_t::get(std::uint_fast8_t(detail::offset_tables_t<>::table.elements[mindex]));
+}
+
+constexpr const face_t& offset_t::face() const
+{
+  assert(is_face());
+  return face_t::get(std::uint_fast8_t(detail::offset_tables_t<>::table.elements[mindex]));
+}
+
+constexpr const edge_t& offset_t::edge() const
+{
+  assert(is_edge());
+  return edge_t::get(std::uint_fast8_t(detail::offset_tables_t<>::table.elements[mindex]));
+}
+
+constexpr const corner_t& offset_t::corner() const
+{
+  assert(is_corner());
+  return corner_t::get(std::uint_fast8_t(detail::offset_tables_t<>::table.elements[mindex]));
+}
+
+constexpr std::ptrdiff_t offset_t::delta(std::ptrdiff_t stride_x, std::ptrdiff_t stride_y,
+                                         std::ptrdiff_t stride_z) const
+{
+  return dx() * stride_x + dy() * stride_y + dz() * stride_z;
+}
+
+constexpr std::uint_fast8_t offset_t::index() const
+{
+  return mindex;
+}
+
+constexpr bool offset_t::operator<(const offset_t& other) const
+{
+  return mindex < other.mindex;
+}
+
+constexpr bool offset_t::operator==(const offset_t& other) const
+{
+  return mindex == other.mindex;
+}
+
+constexpr bool offset_t::operator!=(const offset_t& other) const
+{
+  return mindex != other.mindex;
+}
+
+//###################################################################
+//#### offset_set_t
+//###################################################################
+
+constexpr offset_set_t::offset_set_t()
+  : base_t()
+{
+
+}
+
+template<typename T, typename>
+constexpr offset_set_t::offset_set_t(const T& v)
+  : base_t(v)
+{
+
+}
+
+constexpr offset_set_t offset_set_t::faces()
+{
+  return from_mask(detail::offset_tables_t<>::table.kinds[1]);
+}
+
+constexpr offset_set_t offset_set_t::edges()
+{
+  return from_mask(detail::offset_tables_t<>::table.kinds[2]);
+}
+
+constexpr offset_set_t offset_set_t::corners()
+{
+  return from_mask(detail::offset_tables_t<>::table.kinds[3]);
+}
+
+constexpr offset_set_t offset_set_t::neighborhood(std::uint_fast8_t connectivity)
+{
+  assert(connectivity == 6 || connectivity == 18 || connectivity == 26);
+  return connectivity == 6 ? faces() : connectivity == 18 ? faces() | edges() : faces() | edges() | corners();
+}
+
+//###################################################################
+//#### offset_deltas_t
+//###################################################################
+
+constexpr offset_deltas_t::offset_deltas_t(std::ptrdiff_t stride_x, std::ptrdiff_t stride_y, std::ptrdiff_t stride_z)
+  : mdeltas()
+{
+  for (std::uint_fast8_t i = 0; i < 27; ++i)
+    mdeltas[i] = offset_t::get(i).delta(stride_x, stride_y, stride_z);
+}
+
+constexpr std::ptrdiff_t offset_deltas_t::operator[](const offset_t& offset) const
+{
+  return mdeltas[offset.index()];
+}
+
+constexpr const std::ptrdiff_t* offset_deltas_t::data() const
+{
+  return mdeltas;
+}
+
+} // namespace cubexx
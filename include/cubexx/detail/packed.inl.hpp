@@ -0,0 +1,402 @@
+/*
+    Copyright (c) 2012 Azriel Fasten azriel.fasten@gmail.com
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "cubexx/packed.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+namespace cubexx{
+
+namespace detail{
+
+CORNER_CASES_CUBEXX_INLINE
+std::uint_fast8_t packed4_get(const std::uint8_t* bytes, std::size_t i)
+{
+  return (bytes[i >> 1] >> ((i & 1) << 2)) & 0x0F;
+}
+
+CORNER_CASES_CUBEXX_INLINE
+void packed4_set(std::uint8_t* bytes, std::size_t i, std::uint_fast8_t index)
+{
+  assert(index < 16);
+  unsigned shift = unsigned(i & 1) << 2;
+  std::uint8_t& byte = bytes[i >> 1];
+  byte = std::uint8_t((byte & ~(0x0Fu << shift)) | (unsigned(index) << shift));
+}
+
+CORNER_CASES_CUBEXX_INLINE
+std::uint_fast8_t packed3_get(const std::uint8_t* bytes, std::size_t i)
+{
+  const std::uint8_t* group = bytes + (i >> 3) * 3;
+  std::uint_fast32_t word = std::uint_fast32_t(group[0])
+                          | (std::uint_fast32_t(group[1]) << 8)
+                          | (std::uint_fast32_t(group[2]) << 16);
+  return (word >> ((i & 7) * 3)) & 0x07;
+}
+
+CORNER_CASES_CUBEXX_INLINE
+void packed3_set(std::uint8_t* bytes, std::size_t i, std::uint_fast8_t index)
+{
+  assert(index < 8);
+  std::uint8_t* group = bytes + (i >> 3) * 3;
+  std::uint_fast32_t word = std::uint_fast32_t(group[0])
+                          | (std::uint_fast32_t(group[1]) << 8)
+                          | (std::uint_fast32_t(group[2]) << 16);
+  unsigned shift = unsigned(i & 7) * 3;
+  word = (word & ~(std::uint_fast32_t(0x07) << shift)) | (std::uint_fast32_t(index) << shift);
+  group[0] = std::uint8_t(word);
+  group[1] = std::uint8_t(word >> 8);
+  group[2] = std::uint8_t(word >> 16);
+}
+
+CORNER_CASES_CUBEXX_INLINE
+void packed4_pack_n(const std::uint8_t* indices, std::uint8_t* bytes, std::size_t n)
+{
+  std::size_t i = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+  ///32 indices to 16 bytes: in each 16 bit lane, merge the odd byte into the high nibble of the
+  /// even one, then narrow the lanes back down to bytes
+  const __m128i low_bytes = _mm_set1_epi16(0x00FF);
+  for (; i + 32 <= n; i += 32)
+  {
+    __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + i));
+    __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + i + 16));
+    v0 = _mm_or_si128(_mm_and_si128(v0, low_bytes), _mm_slli_epi16(_mm_srli_epi16(v0, 8), 4));
+    v1 = _mm_or_si128(_mm_and_si128(v1, low_bytes), _mm_slli_epi16(_mm_srli_epi16(v1, 8), 4));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(bytes + (i >> 1)), _mm_packus_epi16(v0, v1));
+  }
+#endif
+  for (; i + 2 <= n; i += 2)
+  {
+    assert(indices[i] < 16 && indices[i + 1] < 16);
+    bytes[i >> 1] = std::uint8_t(indices[i] | (indices[i + 1] << 4));
+  }
+  if (i < n)
+  {
+    assert(indices[i] < 16);
+    bytes[i >> 1] = indices[i];
+  }
+}
+
+CORNER_CASES_CUBEXX_INLINE
+void packed4_unpack_n(const std::uint8_t* bytes, std::uint8_t* indices, std::size_t n)
+{
+  std::size_t i = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+  ///16 bytes to 32 indices: split off the nibbles, then interleave them back into element order
+  const __m128i low_nibbles = _mm_set1_epi8(0x0F);
+  for (; i + 32 <= n; i += 32)
+  {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + (i >> 1)));
+    __m128i lo = _mm_and_si128(v, low_nibbles);
+    __m128i hi = _mm_and_si128(_mm_srli_epi16(v, 4), low_nibbles);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(indices + i), _mm_unpacklo_epi8(lo, hi));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(indices + i + 16), _mm_unpackhi_epi8(lo, hi));
+  }
+#endif
+  for (; i + 2 <= n; i += 2)
+  {
+    std::uint8_t byte = bytes[i >> 1];
+    indices[i] = byte & 0x0F;
+    indices[i + 1] = byte >> 4;
+  }
+  if (i < n)
+    indices[i] = bytes[i >> 1] & 0x0F;
+}
+
+CORNER_CASES_CUBEXX_INLINE
+void packed3_pack_n(const std::uint8_t* indices, std::uint8_t* bytes, std::size_t n)
+{
+  for (std::size_t i = 0; i < n; i += 8)
+  {
+    std::uint_fast32_t word = 0;
+#if defined(__BMI2__) && (defined(__x86_64__) || defined(_M_X64))
+    if (i + 8 <= n)
+    {
+      ///gather the low 3 bits of each of the 8 bytes into the 24 bit group
+      std::uint64_t eight;
+      std::memcpy(&eight, indices + i, 8);
+      assert((eight & ~std::uint64_t(0x0707070707070707)) == 0);
+      word = std::uint_fast32_t(_pext_u64(eight, 0x0707070707070707));
+    }
+    else
+#endif
+    {
+      ///the unused elements of a partial last group are zero
+      std::size_t count = std::min<std::size_t>(8, n - i);
+      for (std::size_t k = 0; k < count; ++k)
+      {
+        assert(indices[i + k] < 8);
+        word |= std::uint_fast32_t(indices[i + k]) << (k * 3);
+      }
+    }
+    std::uint8_t* group = bytes + (i >> 3) * 3;
+    group[0] = std::uint8_t(word);
+    group[1] = std::uint8_t(word >> 8);
+    group[2] = std::uint8_t(word >> 16);
+  }
+}
+
+CORNER_CASES_CUBEXX_INLINE
+void packed3_unpack_n(const std::uint8_t* bytes, std::uint8_t* indices, std::size_t n)
+{
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8)
+  {
+    const std::uint8_t* group = bytes + (i >> 3) * 3;
+    std::uint_fast32_t word = std::uint_fast32_t(group[0])
+                            | (std::uint_fast32_t(group[1]) << 8)
+                            | (std::uint_fast32_t(group[2]) << 16);
+#if defined(__BMI2__) && (defined(__x86_64__) || defined(_M_X64))
+    ///scatter the 24 bit group into the low 3 bits of 8 bytes
+    std::uint64_t eight = _pdep_u64(word, 0x0707070707070707);
+    std::memcpy(indices + i, &eight, 8);
+#else
+    for (std::size_t k = 0; k < 8; ++k)
+      indices[i + k] = (word >> (k * 3)) & 0x07;
+#endif
+  }
+  for (; i < n; ++i)
+    indices[i] = packed3_get(bytes, i);
+}
+
+} // namespace detail
+
+
+//###################################################################
+//#### packed_array_t
+//###################################################################
+
+template<typename element_t, std::size_t BITS>
+CORNER_CASES_CUBEXX_INLINE
+constexpr std::size_t packed_array_t<element_t, BITS>::byte_count(std::size_t n)
+{
+  return BITS == 3 ? ((n + 7) / 8) * 3 : (n + 1) / 2;
+}
+
+template<typename element_t, std::size_t BITS>
+CORNER_CASES_CUBEXX_INLINE
+packed_array_t<element_t, BITS>::packed_array_t()
+  : msize(0)
+{}
+
+template<typename element_t, std::size_t BITS>
+CORNER_CASES_CUBEXX_INLINE
+packed_array_t<element_t, BITS>::packed_array_t(std::size_t size, const element_t& value)
+  : msize(0)
+{
+  resize(size, value);
+}
+
+template<typename element_t, std::size_t BITS>
+CORNER_CASES_CUBEXX_INLINE
+packed_array_t<element_t, BITS>::packed_array_t(const element_t* elements, std::size_t size)
+  : msize(0)
+{
+  assign(elements, size);
+}
+
+template<typename element_t, std::size_t BITS>
+CORNER_CASES_CUBEXX_INLINE
+std::size_t packed_array_t<element_t, BITS>::size() const
+{
+  return msize;
+}
+
+template<typename element_t, std::size_t BITS>
+CORNER_CASES_CUBEXX_INLINE
+bool packed_array_t<element_t, BITS>::empty() const
+{
+  return msize == 0;
+}
+
+template<typename element_t, std::size_t BITS>
+CORNER_CASES_CUBEXX_INLINE
+void packed_array_t<element_t, BITS>::clear()
+{
+  msize = 0;
+  mbytes.clear();
+}
+
+template<typename element_t, std::size_t BITS>
+CORNER_CASES_CUBEXX_INLINE
+void packed_array_t<element_t, BITS>::resize(std::size_t size, const element_t& value)
+{
+  assert(!value.is_null());
+  std::size_t old_size = msize;
+  ///the bits past the end are kept zero, so that equal arrays have equal bytes
+  if (size < old_size)
+  {
+    for (std::size_t i = size; i < std::min(old_size, byte_count(size) * 8 / BITS); ++i)
+      BITS == 3 ? detail::packed3_set(mbytes.data(), i, 0) : detail::packed4_set(mbytes.data(), i, 0);
+  }
+  mbytes.resize(byte_count(size), 0);
+  msize = size;
+  for (std::size_t i = old_size; i < size; ++i)
+    set(i, value);
+}
+
+template<typename element_t, std::size_t BITS>
+CORNER_CASES_CUBEXX_INLINE
+void packed_array_t<element_t, BITS>::push_back(const element_t& element)
+{
+  if (byte_count(msize + 1) != mbytes.size())
+    mbytes.resize(byte_count(msize + 1), 0);
+  ++msize;
+  set(msize - 1, element);
+}
+
+template<typename element_t, std::size_t BITS>
+CORNER_CASES_CUBEXX_INLINE
+element_t packed_array_t<element_t, BITS>::get(std::size_t i) const
+{
+  assert(i < msize);
+  return element_t::get(BITS == 3 ? detail::packed3_get(mbytes.data(), i) : detail::packed4_get(mbytes.data(), i));
+}
+
+template<typename element_t, std::size_t BITS>
+CORNER_CASES_CUBEXX_INLINE
+void packed_array_t<element_t, BITS>::set(std::size_t i, const element_t& element)
+{
+  assert(i < msize);
+  assert(!element.is_null());
+  if (BITS == 3)
+    detail::packed3_set(mbytes.data(), i, element.index());
+  else
+    detail::packed4_set(mbytes.data(), i, element.index());
+}
+
+template<typename element_t, std::size_t BITS>
+CORNER_CASES_CUBEXX_INLINE
+element_t packed_array_t<element_t, BITS>::operator[](std::size_t i) const
+{
+  return get(i);
+}
+
+template<typename element_t, std::size_t BITS>
+CORNER_CASES_CUBEXX_INLINE
+typename packed_array_t<element_t, BITS>::reference
+packed_array_t<element_t, BITS>::operator[](std::size_t i)
+{
+  return reference(*this, i);
+}
+
+template<typename element_t, std::size_t BITS>
+CORNER_CASES_CUBEXX_INLINE
+typename packed_array_t<element_t, BITS>::const_iterator
+packed_array_t<element_t, BITS>::begin() const
+{
+  return const_iterator(this, 0);
+}
+
+template<typename element_t, std::size_t BITS>
+CORNER_CASES_CUBEXX_INLINE
+typename packed_array_t<element_t, BITS>::const_iterator
+packed_array_t<element_t, BITS>::end() const
+{
+  return const_iterator(this, msize);
+}
+
+template<typename element_t, std::size_t BITS>
+CORNER_CASES_CUBEXX_INLINE
+typename packed_array_t<element_t, BITS>::const_iterator
+packed_array_t<element_t, BITS>::cbegin() const
+{
+  return begin();
+}
+
+template<typename element_t, std::size_t BITS>
+CORNER_CASES_CUBEXX_INLINE
+typename packed_array_t<element_t, BITS>::const_iterator
+packed_array_t<element_t, BITS>::cend() const
+{
+  return end();
+}
+
+template<typename element_t, std::size_t BITS>
+CORNER_CASES_CUBEXX_INLINE
+void packed_array_t<element_t, BITS>::assign(const element_t* elements, std::size_t size)
+{
+  ///each element is a single byte holding its index (see the static_asserts in cubexx.hpp), so the
+  /// elements can be handed to the kernels as they are
+  const std::uint8_t* indices = reinterpret_cast<const std::uint8_t*>(elements);
+  mbytes.assign(byte_count(size), 0);
+  msize = size;
+  if (BITS == 3)
+    detail::packed3_pack_n(indices, mbytes.data(), size);
+  else
+    detail::packed4_pack_n(indices, mbytes.data(), size);
+}
+
+template<typename element_t, std::size_t BITS>
+CORNER_CASES_CUBEXX_INLINE
+void packed_array_t<element_t, BITS>::unpack(element_t* elements) const
+{
+  std::uint8_t* indices = reinterpret_cast<std::uint8_t*>(elements);
+  if (BITS == 3)
+    detail::packed3_unpack_n(mbytes.data(), indices, msize);
+  else
+    detail::packed4_unpack_n(mbytes.data(), indices, msize);
+}
+
+template<typename element_t, std::size_t BITS>
+CORNER_CASES_CUBEXX_INLINE
+const std::uint8_t* packed_array_t<element_t, BITS>::data() const
+{
+  return mbytes.data();
+}
+
+template<typename element_t, std::size_t BITS>
+CORNER_CASES_CUBEXX_INLINE
+std::uint8_t* packed_array_t<element_t, BITS>::data()
+{
+  return mbytes.data();
+}
+
+template<typename element_t, std::size_t BITS>
+CORNER_CASES_CUBEXX_INLINE
+bool packed_array_t<element_t, BITS>::operator==(const packed_array_t& other) const
+{
+  return msize == other.msize && mbytes == other.mbytes;
+}
+
+template<typename element_t, std::size_t BITS>
+CORNER_CASES_CUBEXX_INLINE
+bool packed_array_t<element_t, BITS>::operator!=(const packed_array_t& other) const
+{
+  return !(*this == other);
+}
+
+} // namespace cubexx
@@ -0,0 +1,432 @@
+/*
+    Copyright (c) 2012 Azriel Fasten azriel.fasten@gmail.com
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "cubexx/raycast.hpp"
+
+#include <cassert>
+#include <algorithm>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+namespace cubexx{
+
+namespace detail{
+
+/**
+ * @brief The parameters where @p ray crosses the lower and upper planes of the root on each axis, with the ray
+ *          mirrored to go up every axis; returns the mirror mask (bit `k` set if axis `k` was mirrored).
+ */
+CORNER_CASES_CUBEXX_INLINE
+std::uint_fast8_t ray_setup(const std::array<float, 3>& lower, float size, const ray_t& ray, float* t0, float* t1)
+{
+  std::uint_fast8_t mirror = 0;
+  for (std::size_t k = 0; k < 3; ++k)
+  {
+    float origin = ray.origin[k], direction = ray.direction[k];
+    ///mirror the ray through the center of the root
+    if (direction < 0)
+    {
+      origin = 2 * lower[k] + size - origin;
+      direction = -direction;
+      mirror |= std::uint_fast8_t(1 << k);
+    }
+    ///on an axis the ray is parallel to, a huge but finite inverse keeps a zero distance at 0, rather than NaN
+    float inverse = 1.0f / std::max(direction, 1e-20f);
+    t0[k] = (lower[k] - origin) * inverse;
+    t1[k] = (lower[k] + size - origin) * inverse;
+  }
+  return mirror;
+}
+
+///The axis of the plane the ray enters through last, i.e. of the largest entry parameter.
+CORNER_CASES_CUBEXX_INLINE
+std::size_t ray_entry_axis(float t0x, float t0y, float t0z)
+{
+  return t0x >= t0y ? (t0x >= t0z ? 0 : 2) : (t0y >= t0z ? 1 : 2);
+}
+
+///The face entered through on @p axis; the upper face of a mirrored axis, since the ray goes down it.
+CORNER_CASES_CUBEXX_INLINE
+const face_t& ray_entry_face(std::size_t axis, std::uint_fast8_t mirror)
+{
+  std::int_fast8_t sign = (mirror >> axis) & 1 ? 1 : -1;
+  return face_t::get(direction_t::get(std::int_fast8_t(axis == 0 ? sign : 0),
+                                      std::int_fast8_t(axis == 1 ? sign : 0),
+                                      std::int_fast8_t(axis == 2 ? sign : 0)));
+}
+
+///Visits the leaves below @p node; returns true once @p visitor asks to stop.
+template<typename tree_t, typename visitor_t>
+CORNER_CASES_CUBEXX_INLINE
+bool raycast_node(const tree_t& tree, const typename octree_traversal_t<tree_t>::node_type& node,
+                  const float* t0, const float* t1, std::uint_fast8_t mirror, visitor_t& visitor)
+{
+  typedef octree_traversal_t<tree_t> traversal;
+
+  float t_entry = std::max(std::max(t0[0], t0[1]), t0[2]);
+  float t_exit = std::min(std::min(t1[0], t1[1]), t1[2]);
+  if (t_exit < 0 || !(t_entry < t_exit))
+    return false;
+
+  std::size_t entry_axis = ray_entry_axis(t0[0], t0[1], t0[2]);
+  corner_set_t children = traversal::children(tree, node);
+  if (children.empty())
+  {
+    return visitor(node, std::max(t_entry, 0.0f), t_exit,
+                   t_entry < 0 ? face_t::null_face() : ray_entry_face(entry_axis, mirror));
+  }
+
+  float tm[3] = {(t0[0] + t1[0]) / 2, (t0[1] + t1[1]) / 2, (t0[2] + t1[2]) / 2};
+
+  ///the first child is in the upper half on each of the other axes whose middle plane was crossed before entering
+  std::uint_fast8_t current = 0;
+  for (std::size_t k = 0; k < 3; ++k)
+    if (k != entry_axis && tm[k] < t_entry)
+      current |= std::uint_fast8_t(1 << k);
+
+  while (true)
+  {
+    float c0[3], c1[3];
+    for (std::size_t k = 0; k < 3; ++k)
+    {
+      bool upper = (current >> k) & 1;
+      c0[k] = upper ? tm[k] : t0[k];
+      c1[k] = upper ? t1[k] : tm[k];
+    }
+
+    const corner_t& corner = corner_t::get(std::uint_fast8_t(current ^ mirror));
+    if (children.contains(corner)
+        && raycast_node(tree, traversal::child(tree, node, corner), c0, c1, mirror, visitor))
+      return true;
+
+    ///step across the plane the ray leaves the child through; across an upper plane, it leaves the node
+    std::size_t exit_axis = c1[0] <= c1[1] ? (c1[0] <= c1[2] ? 0 : 2) : (c1[1] <= c1[2] ? 1 : 2);
+    if ((current >> exit_axis) & 1)
+      return false;
+    current |= std::uint_fast8_t(1 << exit_axis);
+  }
+}
+
+///@name Ray packet lanes
+/**
+ * One float per ray of a packet, with the few operations the packet traversal needs: SSE for each 4 rays (AVX for
+ * 8, when the target has it), or plain loops without either.
+ */
+///@{
+#if defined(__SSE2__) || defined(_M_X64)
+template<std::size_t Width>
+struct ray_floats_t
+{
+  static_assert(Width % 4 == 0, "packets come in whole SSE registers");
+  __m128 v[Width / 4];
+
+  static ray_floats_t load(const float* p)
+  {
+    ray_floats_t result;
+    for (std::size_t g = 0; g < Width / 4; ++g)
+      result.v[g] = _mm_loadu_ps(p + 4 * g);
+    return result;
+  }
+  void store(float* p) const
+  {
+    for (std::size_t g = 0; g < Width / 4; ++g)
+      _mm_storeu_ps(p + 4 * g, v[g]);
+  }
+  static ray_floats_t min(const ray_floats_t& a, const ray_floats_t& b)
+  {
+    ray_floats_t result;
+    for (std::size_t g = 0; g < Width / 4; ++g)
+      result.v[g] = _mm_min_ps(a.v[g], b.v[g]);
+    return result;
+  }
+  static ray_floats_t max(const ray_floats_t& a, const ray_floats_t& b)
+  {
+    ray_floats_t result;
+    for (std::size_t g = 0; g < Width / 4; ++g)
+      result.v[g] = _mm_max_ps(a.v[g], b.v[g]);
+    return result;
+  }
+  static ray_floats_t middle(const ray_floats_t& a, const ray_floats_t& b)
+  {
+    ray_floats_t result;
+    for (std::size_t g = 0; g < Width / 4; ++g)
+      result.v[g] = _mm_mul_ps(_mm_add_ps(a.v[g], b.v[g]), _mm_set1_ps(0.5f));
+    return result;
+  }
+  ///A bit per lane, set where the ray passes through: `exit >= 0 && entry < exit`.
+  static std::uint32_t passing(const ray_floats_t& entry, const ray_floats_t& exit)
+  {
+    std::uint32_t result = 0;
+    for (std::size_t g = 0; g < Width / 4; ++g)
+    {
+      __m128 forward = _mm_cmpge_ps(exit.v[g], _mm_setzero_ps());
+      result |= std::uint32_t(_mm_movemask_ps(_mm_and_ps(forward, _mm_cmplt_ps(entry.v[g], exit.v[g])))) << (4 * g);
+    }
+    return result;
+  }
+};
+#else
+template<std::size_t Width>
+struct ray_floats_t
+{
+  float v[Width];
+
+  static ray_floats_t load(const float* p)
+  {
+    ray_floats_t result;
+    std::copy(p, p + Width, result.v);
+    return result;
+  }
+  void store(float* p) const { std::copy(v, v + Width, p); }
+  static ray_floats_t min(const ray_floats_t& a, const ray_floats_t& b)
+  {
+    ray_floats_t result;
+    for (std::size_t i = 0; i < Width; ++i)
+      result.v[i] = std::min(a.v[i], b.v[i]);
+    return result;
+  }
+  static ray_floats_t max(const ray_floats_t& a, const ray_floats_t& b)
+  {
+    ray_floats_t result;
+    for (std::size_t i = 0; i < Width; ++i)
+      result.v[i] = std::max(a.v[i], b.v[i]);
+    return result;
+  }
+  static ray_floats_t middle(const ray_floats_t& a, const ray_floats_t& b)
+  {
+    ray_floats_t result;
+    for (std::size_t i = 0; i < Width; ++i)
+      result.v[i] = (a.v[i] + b.v[i]) * 0.5f;
+    return result;
+  }
+  static std::uint32_t passing(const ray_floats_t& entry, const ray_floats_t& exit)
+  {
+    std::uint32_t result = 0;
+    for (std::size_t i = 0; i < Width; ++i)
+      result |= std::uint32_t(exit.v[i] >= 0 && entry.v[i] < exit.v[i]) << i;
+    return result;
+  }
+};
+#endif
+
+#if defined(__AVX__)
+template<>
+struct ray_floats_t<8>
+{
+  __m256 v;
+
+  static ray_floats_t load(const float* p) { return {_mm256_loadu_ps(p)}; }
+  void store(float* p) const { _mm256_storeu_ps(p, v); }
+  static ray_floats_t min(const ray_floats_t& a, const ray_floats_t& b) { return {_mm256_min_ps(a.v, b.v)}; }
+  static ray_floats_t max(const ray_floats_t& a, const ray_floats_t& b) { return {_mm256_max_ps(a.v, b.v)}; }
+  static ray_floats_t middle(const ray_floats_t& a, const ray_floats_t& b)
+  {
+    return {_mm256_mul_ps(_mm256_add_ps(a.v, b.v), _mm256_set1_ps(0.5f))};
+  }
+  static std::uint32_t passing(const ray_floats_t& entry, const ray_floats_t& exit)
+  {
+    __m256 forward = _mm256_cmp_ps(exit.v, _mm256_setzero_ps(), _CMP_GE_OQ);
+    return std::uint32_t(_mm256_movemask_ps(_mm256_and_ps(forward, _mm256_cmp_ps(entry.v, exit.v, _CMP_LT_OQ))));
+  }
+};
+#endif
+///@}
+
+///The entry and exit parameters of each ray of a packet, on each axis.
+template<std::size_t Width>
+struct ray_lanes_t
+{
+  ray_floats_t<Width> t0[3];
+  ray_floats_t<Width> t1[3];
+};
+
+/**
+ * @brief Traces the rays in @p alive (each of which passes through @p node) below @p node, recording hits and
+ *          clearing their bits in @p pending.
+ *
+ * Children are visited in the order `0..7` of their mirrored index; a ray going up every axis only ever sets
+ * index bits as it crosses middle planes, so this is front to back for every ray of the packet. The intervals of
+ * a child are tested for all the rays at once, and a child that none of the pending rays pass through is skipped
+ * without descending into it.
+ */
+template<std::size_t Width, typename tree_t>
+CORNER_CASES_CUBEXX_INLINE
+void raycast_packet_node(const tree_t& tree, const typename octree_traversal_t<tree_t>::node_type& node,
+                         const ray_lanes_t<Width>& lanes, std::uint_fast8_t mirror, std::uint32_t alive,
+                         std::uint32_t& pending, ray_hit_t<tree_t>* hits)
+{
+  typedef octree_traversal_t<tree_t> traversal;
+  typedef ray_floats_t<Width> floats_t;
+
+  corner_set_t children = traversal::children(tree, node);
+  if (children.empty())
+  {
+    float t0[3][Width], t1[3][Width];
+    for (std::size_t k = 0; k < 3; ++k)
+    {
+      lanes.t0[k].store(t0[k]);
+      lanes.t1[k].store(t1[k]);
+    }
+    for (std::uint32_t rays = alive; rays != 0; rays &= rays - 1)
+    {
+      std::size_t i = detail::countr_zero(rays);
+      float t_entry = std::max(std::max(t0[0][i], t0[1][i]), t0[2][i]);
+      hits[i].hit = true;
+      hits[i].node = node;
+      hits[i].t_entry = std::max(t_entry, 0.0f);
+      hits[i].t_exit = std::min(std::min(t1[0][i], t1[1][i]), t1[2][i]);
+      hits[i].face = t_entry < 0 ? face_t::null_face()
+                                 : ray_entry_face(ray_entry_axis(t0[0][i], t0[1][i], t0[2][i]), mirror);
+    }
+    pending &= ~alive;
+    return;
+  }
+
+  floats_t tm[3];
+  for (std::size_t k = 0; k < 3; ++k)
+    tm[k] = floats_t::middle(lanes.t0[k], lanes.t1[k]);
+
+  ray_lanes_t<Width> child;
+  for (std::uint_fast8_t index = 0; index < 8; ++index)
+  {
+    const corner_t& corner = corner_t::get(std::uint_fast8_t(index ^ mirror));
+    if (!children.contains(corner))
+      continue;
+
+    for (std::size_t k = 0; k < 3; ++k)
+    {
+      bool upper = (index >> k) & 1;
+      child.t0[k] = upper ? tm[k] : lanes.t0[k];
+      child.t1[k] = upper ? lanes.t1[k] : tm[k];
+    }
+    floats_t t_entry = floats_t::max(floats_t::max(child.t0[0], child.t0[1]), child.t0[2]);
+    floats_t t_exit = floats_t::min(floats_t::min(child.t1[0], child.t1[1]), child.t1[2]);
+    std::uint32_t passing = floats_t::passing(t_entry, t_exit) & alive & pending;
+    if (passing == 0)
+      continue;
+
+    raycast_packet_node(tree, traversal::child(tree, node, corner), child, mirror, passing, pending, hits);
+    if ((alive & pending) == 0)
+      return;
+  }
+}
+
+} // namespace detail
+
+//###################################################################
+//#### raycasting
+//###################################################################
+
+template<typename tree_t, typename visitor_t>
+CORNER_CASES_CUBEXX_INLINE
+void raycast_visit(const tree_t& tree, const std::array<float, 3>& lower, float size, const ray_t& ray,
+                   visitor_t&& visitor)
+{
+  typedef octree_traversal_t<tree_t> traversal;
+  if (traversal::empty(tree))
+    return;
+
+  float t0[3], t1[3];
+  std::uint_fast8_t mirror = detail::ray_setup(lower, size, ray, t0, t1);
+  detail::raycast_node(tree, traversal::root(tree), t0, t1, mirror, visitor);
+}
+
+template<typename tree_t>
+CORNER_CASES_CUBEXX_INLINE
+ray_hit_t<tree_t> raycast(const tree_t& tree, const std::array<float, 3>& lower, float size, const ray_t& ray)
+{
+  typedef typename ray_hit_t<tree_t>::node_type node_type;
+
+  ray_hit_t<tree_t> result = {false, node_type(), 0, 0, face_t::null_face()};
+  raycast_visit(tree, lower, size, ray, [&](const node_type& node, float t_entry, float t_exit, const face_t& face){
+    result.hit = true;
+    result.node = node;
+    result.t_entry = t_entry;
+    result.t_exit = t_exit;
+    result.face = face;
+    return true;
+  });
+  return result;
+}
+
+template<std::size_t Width, typename tree_t>
+CORNER_CASES_CUBEXX_INLINE
+void raycast_packet(const tree_t& tree, const std::array<float, 3>& lower, float size, const ray_t* rays,
+                    ray_hit_t<tree_t>* hits)
+{
+  static_assert(Width == 4 || Width == 8, "a packet has 4 or 8 rays");
+  typedef octree_traversal_t<tree_t> traversal;
+  typedef typename ray_hit_t<tree_t>::node_type node_type;
+  typedef detail::ray_floats_t<Width> floats_t;
+
+  float t0[3][Width], t1[3][Width];
+  std::uint_fast8_t mirrors[Width];
+  for (std::size_t i = 0; i < Width; ++i)
+  {
+    float r0[3], r1[3];
+    mirrors[i] = detail::ray_setup(lower, size, rays[i], r0, r1);
+    for (std::size_t k = 0; k < 3; ++k)
+    {
+      t0[k][i] = r0[k];
+      t1[k][i] = r1[k];
+    }
+    hits[i] = ray_hit_t<tree_t>{false, node_type(), 0, 0, face_t::null_face()};
+  }
+  if (traversal::empty(tree))
+    return;
+
+  detail::ray_lanes_t<Width> lanes;
+  for (std::size_t k = 0; k < 3; ++k)
+  {
+    lanes.t0[k] = floats_t::load(t0[k]);
+    lanes.t1[k] = floats_t::load(t1[k]);
+  }
+  floats_t t_entry = floats_t::max(floats_t::max(lanes.t0[0], lanes.t0[1]), lanes.t0[2]);
+  floats_t t_exit = floats_t::min(floats_t::min(lanes.t1[0], lanes.t1[1]), lanes.t1[2]);
+  std::uint32_t passing = floats_t::passing(t_entry, t_exit);
+
+  ///the rays sharing the first ray's mirror mask go down together; the rest, which are going some other way (and
+  /// are few in a coherent packet), go one at a time
+  std::uint_fast8_t mirror = mirrors[0];
+  std::uint32_t group = 0;
+  for (std::size_t i = 0; i < Width; ++i)
+    group |= std::uint32_t(mirrors[i] == mirror) << i;
+
+  std::uint32_t pending = group & passing;
+  if (pending != 0)
+    detail::raycast_packet_node(tree, traversal::root(tree), lanes, mirror, pending, pending, hits);
+
+  for (std::uint32_t others = ~group & passing & std::uint32_t((std::uint64_t(1) << Width) - 1); others != 0;
+       others &= others - 1)
+  {
+    std::size_t i = detail::countr_zero(others);
+    hits[i] = raycast(tree, lower, size, rays[i]);
+  }
+}
+
+} // namespace cubexx
@@ -0,0 +1,328 @@
+/*
+    Copyright (c) 2012 Azriel Fasten azriel.fasten@gmail.com
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "cubexx/tetrahedra.hpp"
+
+#include <cassert>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+namespace cubexx{
+
+namespace detail{
+
+///The tables behind the decompositions and marching tetrahedra, as raw indices.
+struct tetrahedra_table_t
+{
+  ///By the corner the diagonal starts from.
+  std::uint8_t six[8][6][4];
+  ///By parity.
+  std::uint8_t five[2][5][4];
+  std::uint8_t edges[16];
+  std::uint8_t triangle_counts[16];
+  std::uint8_t triangles[16][6];
+};
+
+struct tetrahedra_builder_t
+{
+  typedef std::uint_fast8_t raw_t;
+
+  static constexpr raw_t edge_corner(raw_t e, raw_t end)
+  {
+    ///(0,1), (0,2), (0,3), (1,2), (1,3), (2,3)
+    return raw_t(end == 0 ? (e < 3 ? 0 : e < 5 ? 1 : 2) : (e < 3 ? e + 1 : e < 5 ? e - 1 : 3));
+  }
+
+  ///Six times the signed volume of the tetrahedron on the cube corners @p t.
+  static constexpr int volume(const std::uint8_t (&t)[4])
+  {
+    int d[3][3] = {};
+    for (raw_t i = 0; i < 3; ++i)
+      for (raw_t axis = 0; axis < 3; ++axis)
+        d[i][axis] = int((t[i + 1] >> axis) & 1) - int((t[0] >> axis) & 1);
+    return d[0][0] * (d[1][1] * d[2][2] - d[1][2] * d[2][1]) - d[0][1] * (d[1][0] * d[2][2] - d[1][2] * d[2][0])
+         + d[0][2] * (d[1][0] * d[2][1] - d[1][1] * d[2][0]);
+  }
+
+  ///Swaps the last two corners of @p t if it is negatively oriented.
+  static constexpr void orient(std::uint8_t (&t)[4])
+  {
+    if (volume(t) < 0)
+    {
+      std::uint8_t swap = t[2];
+      t[2] = t[3];
+      t[3] = swap;
+    }
+  }
+
+  static constexpr raw_t parity(raw_t c)
+  {
+    return raw_t(((c >> 0) ^ (c >> 1) ^ (c >> 2)) & 1);
+  }
+
+  static constexpr void six(raw_t c, std::uint8_t (&result)[6][4])
+  {
+    ///the axes in the order the path follows them, for each of the 6 paths
+    const raw_t orders[6][2] = {{0, 1}, {0, 2}, {1, 0}, {1, 2}, {2, 0}, {2, 1}};
+    for (raw_t p = 0; p < 6; ++p)
+    {
+      result[p][0] = std::uint8_t(c);
+      result[p][1] = std::uint8_t(c ^ (1 << orders[p][0]));
+      result[p][2] = std::uint8_t(c ^ (1 << orders[p][0]) ^ (1 << orders[p][1]));
+      result[p][3] = std::uint8_t(c ^ 7);
+      orient(result[p]);
+    }
+  }
+
+  static constexpr void five(bool odd, std::uint8_t (&result)[5][4])
+  {
+    raw_t central = 0, t = 1;
+    for (raw_t c = 0; c < 8; ++c)
+    {
+      if ((parity(c) != 0) == odd)
+        result[0][central++] = std::uint8_t(c);
+      else
+      {
+        result[t][0] = std::uint8_t(c);
+        result[t][1] = std::uint8_t(c ^ 1);
+        result[t][2] = std::uint8_t(c ^ 2);
+        result[t][3] = std::uint8_t(c ^ 4);
+        orient(result[t]);
+        ++t;
+      }
+    }
+    orient(result[0]);
+  }
+
+  /**
+   * Triangulates case @p inside; as marching_cubes_triangulate(), but the faces are triangles with 0 or 2 crossed
+   * edges each, so every loop has 3 or 4 edges. The orientation is worked out on the tetrahedron (0,0,0), (1,0,0),
+   * (0,1,0), (0,0,1); any positively oriented one is an affine image of it that keeps the orientation.
+   */
+  static constexpr std::size_t triangulate(raw_t inside, std::uint8_t* triangles)
+  {
+    const int positions[4][3] = {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+
+    raw_t crossing = 0;
+    for (raw_t e = 0; e < 6; ++e)
+      if (((inside >> edge_corner(e, 0)) & 1) != ((inside >> edge_corner(e, 1)) & 1))
+        crossing = raw_t(crossing | (1 << e));
+    if (!crossing)
+      return 0;
+
+    ///the two crossed edges on each face (the face opposite corner f) are joined
+    std::uint8_t partners[6][2] = {};
+    std::uint8_t degree[6] = {};
+    for (raw_t f = 0; f < 4; ++f)
+    {
+      std::uint8_t on[2] = {};
+      raw_t count = 0;
+      for (raw_t e = 0; e < 6; ++e)
+        if (((crossing >> e) & 1) && edge_corner(e, 0) != f && edge_corner(e, 1) != f)
+          on[count++] = std::uint8_t(e);
+      if (count == 2)
+      {
+        partners[on[0]][degree[on[0]]++] = on[1];
+        partners[on[1]][degree[on[1]]++] = on[0];
+      }
+    }
+
+    ///there is one loop
+    std::uint8_t loop[4] = {};
+    std::size_t length = 0;
+    std::uint8_t start = 0;
+    while (!((crossing >> start) & 1))
+      ++start;
+    std::uint8_t previous = 6, current = start;
+    do
+    {
+      loop[length++] = current;
+      std::uint8_t next = partners[current][0] != previous ? partners[current][0] : partners[current][1];
+      previous = current;
+      current = next;
+    } while (current != start);
+
+    int normal[3] = {0, 0, 0}, gradient[3] = {0, 0, 0};
+    for (std::size_t i = 0; i < length; ++i)
+    {
+      raw_t a0 = edge_corner(loop[i], 0), a1 = edge_corner(loop[i], 1);
+      raw_t b0 = edge_corner(loop[(i + 1) % length], 0), b1 = edge_corner(loop[(i + 1) % length], 1);
+      int v[3] = {}, w[3] = {};
+      for (raw_t axis = 0; axis < 3; ++axis)
+      {
+        v[axis] = positions[a0][axis] + positions[a1][axis];
+        w[axis] = positions[b0][axis] + positions[b1][axis];
+        int sign = (inside >> a1) & 1 ? -1 : 1;
+        gradient[axis] += sign * (positions[a1][axis] - positions[a0][axis]);
+      }
+      normal[0] += v[1] * w[2] - v[2] * w[1];
+      normal[1] += v[2] * w[0] - v[0] * w[2];
+      normal[2] += v[0] * w[1] - v[1] * w[0];
+    }
+    bool reverse = normal[0] * gradient[0] + normal[1] * gradient[1] + normal[2] * gradient[2] < 0;
+
+    std::size_t triangle_count = 0;
+    for (std::size_t i = 1; i + 1 < length; ++i)
+    {
+      triangles[3 * triangle_count + 0] = loop[0];
+      triangles[3 * triangle_count + 1] = reverse ? loop[i + 1] : loop[i];
+      triangles[3 * triangle_count + 2] = reverse ? loop[i] : loop[i + 1];
+      ++triangle_count;
+    }
+    return triangle_count;
+  }
+
+  static constexpr tetrahedra_table_t build()
+  {
+    tetrahedra_table_t table = {};
+    for (raw_t c = 0; c < 8; ++c)
+      six(c, table.six[c]);
+    five(false, table.five[0]);
+    five(true, table.five[1]);
+    for (raw_t inside = 0; inside < 16; ++inside)
+    {
+      for (raw_t e = 0; e < 6; ++e)
+        if (((inside >> edge_corner(e, 0)) & 1) != ((inside >> edge_corner(e, 1)) & 1))
+          table.edges[inside] = std::uint8_t(table.edges[inside] | (1 << e));
+      table.triangle_counts[inside] = std::uint8_t(triangulate(inside, table.triangles[inside]));
+    }
+    return table;
+  }
+
+  static constexpr tetrahedron_t make(const std::uint8_t (&t)[4])
+  {
+    return {{corner_t::get(std::uint_fast8_t(t[0])), corner_t::get(std::uint_fast8_t(t[1])),
+             corner_t::get(std::uint_fast8_t(t[2])), corner_t::get(std::uint_fast8_t(t[3]))}};
+  }
+};
+
+template<typename T = void>
+struct tetrahedra_tables_t
+{
+  static constexpr tetrahedra_table_t table = tetrahedra_builder_t::build();
+};
+
+template<typename T> constexpr tetrahedra_table_t tetrahedra_tables_t<T>::table;
+
+///marching_tetrahedra_classify_row(), one cell at a time.
+template<std::size_t N>
+void marching_tetrahedra_classify_row_scalar(const std::uint8_t* cases, std::size_t n,
+                                             const std::array<tetrahedron_t, N>& tetrahedra,
+                                             std::uint8_t* tetrahedron_cases, std::size_t stride)
+{
+  for (std::size_t t = 0; t < N; ++t)
+    for (std::size_t x = 0; x < n; ++x)
+      tetrahedron_cases[t * stride + x] = std::uint8_t(
+        tetrahedron_case(tetrahedra[t], corner_set_t::from_mask(corner_set_t::mask_type(cases[x]))));
+}
+
+} // namespace detail
+
+//###################################################################
+//#### decompositions
+//###################################################################
+
+constexpr std::array<tetrahedron_t, 6> six_tetrahedra(const corner_t& corner)
+{
+  typedef detail::tetrahedra_builder_t builder_t;
+  return {{builder_t::make(detail::tetrahedra_tables_t<>::table.six[corner.index()][0]),
+           builder_t::make(detail::tetrahedra_tables_t<>::table.six[corner.index()][1]),
+           builder_t::make(detail::tetrahedra_tables_t<>::table.six[corner.index()][2]),
+           builder_t::make(detail::tetrahedra_tables_t<>::table.six[corner.index()][3]),
+           builder_t::make(detail::tetrahedra_tables_t<>::table.six[corner.index()][4]),
+           builder_t::make(detail::tetrahedra_tables_t<>::table.six[corner.index()][5])}};
+}
+
+constexpr std::array<tetrahedron_t, 5> five_tetrahedra(bool odd)
+{
+  typedef detail::tetrahedra_builder_t builder_t;
+  return {{builder_t::make(detail::tetrahedra_tables_t<>::table.five[odd ? 1 : 0][0]),
+           builder_t::make(detail::tetrahedra_tables_t<>::table.five[odd ? 1 : 0][1]),
+           builder_t::make(detail::tetrahedra_tables_t<>::table.five[odd ? 1 : 0][2]),
+           builder_t::make(detail::tetrahedra_tables_t<>::table.five[odd ? 1 : 0][3]),
+           builder_t::make(detail::tetrahedra_tables_t<>::table.five[odd ? 1 : 0][4])}};
+}
+
+//###################################################################
+//#### marching tetrahedra
+//###################################################################
+
+constexpr std::array<std::uint8_t, 2> tetrahedron_edge(std::size_t i)
+{
+  return {{std::uint8_t(detail::tetrahedra_builder_t::edge_corner(std::uint_fast8_t(i), 0)),
+           std::uint8_t(detail::tetrahedra_builder_t::edge_corner(std::uint_fast8_t(i), 1))}};
+}
+
+constexpr std::uint_fast8_t tetrahedron_case(const tetrahedron_t& tetrahedron, const corner_set_t& inside)
+{
+  return std::uint_fast8_t((inside.contains(tetrahedron[0]) ? 1 : 0) | (inside.contains(tetrahedron[1]) ? 2 : 0)
+                         | (inside.contains(tetrahedron[2]) ? 4 : 0) | (inside.contains(tetrahedron[3]) ? 8 : 0));
+}
+
+constexpr std::uint_fast8_t marching_tetrahedra_edges(std::uint_fast8_t inside)
+{
+  return detail::tetrahedra_tables_t<>::table.edges[inside];
+}
+
+constexpr std::size_t marching_tetrahedra_triangle_count(std::uint_fast8_t inside)
+{
+  return detail::tetrahedra_tables_t<>::table.triangle_counts[inside];
+}
+
+constexpr std::array<std::uint8_t, 3> marching_tetrahedra_triangle(std::uint_fast8_t inside, std::size_t i)
+{
+  return {{detail::tetrahedra_tables_t<>::table.triangles[inside][3 * i + 0],
+           detail::tetrahedra_tables_t<>::table.triangles[inside][3 * i + 1],
+           detail::tetrahedra_tables_t<>::table.triangles[inside][3 * i + 2]}};
+}
+
+template<std::size_t N>
+void marching_tetrahedra_classify_row(const std::uint8_t* cases, std::size_t n,
+                                      const std::array<tetrahedron_t, N>& tetrahedra, std::uint8_t* tetrahedron_cases)
+{
+  std::size_t x = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+  for (; x + 16 <= n; x += 16)
+  {
+    const __m128i cube = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cases + x));
+    for (std::size_t t = 0; t < N; ++t)
+    {
+      __m128i result = _mm_setzero_si128();
+      for (std::size_t v = 0; v < 4; ++v)
+      {
+        ///all ones in the cells where the corner is inside
+        const __m128i bit = _mm_set1_epi8(char(1 << tetrahedra[t][v].index()));
+        __m128i inside = _mm_cmpeq_epi8(_mm_and_si128(cube, bit), bit);
+        result = _mm_or_si128(result, _mm_and_si128(inside, _mm_set1_epi8(char(1 << v))));
+      }
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(tetrahedron_cases + t * n + x), result);
+    }
+  }
+#endif
+  detail::marching_tetrahedra_classify_row_scalar(cases + x, n - x, tetrahedra, tetrahedron_cases + x, n);
+}
+
+} // namespace cubexx
@@ -0,0 +1,140 @@
+/*
+    Copyright (c) 2012 Azriel Fasten azriel.fasten@gmail.com
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "cubexx/thread_pool.hpp"
+
+#include <cassert>
+
+namespace cubexx{
+
+//###################################################################
+//#### thread_pool_t
+//###################################################################
+
+CORNER_CASES_CUBEXX_INLINE
+thread_pool_t::thread_pool_t(std::size_t threads)
+  : minvoke(nullptr), mtask(nullptr), msize(0), mgeneration(0), mactive(0), mstop(false), mnext(0)
+{
+  if (threads == 0)
+    threads = std::thread::hardware_concurrency();
+  if (threads == 0)
+    threads = 1;
+
+  ///the calling thread is the last one
+  mthreads.reserve(threads - 1);
+  for (std::size_t i = 0; i + 1 < threads; ++i)
+    mthreads.emplace_back([this]{ work(); });
+}
+
+CORNER_CASES_CUBEXX_INLINE
+thread_pool_t::~thread_pool_t()
+{
+  {
+    std::lock_guard<std::mutex> lock(mmutex);
+    mstop = true;
+  }
+  mstart.notify_all();
+  for (auto& thread : mthreads)
+    thread.join();
+}
+
+CORNER_CASES_CUBEXX_INLINE
+std::size_t thread_pool_t::size() const
+{
+  return mthreads.size() + 1;
+}
+
+template<typename function_t>
+CORNER_CASES_CUBEXX_INLINE
+void thread_pool_t::run(std::size_t n, const function_t& task)
+{
+  void (*invoke)(const void*, std::size_t) = [](const void* task, std::size_t i){
+    (*static_cast<const function_t*>(task))(i);
+  };
+
+  if (n == 0)
+    return;
+  ///not worth waking anyone up
+  if (n == 1 || mthreads.empty())
+  {
+    for (std::size_t i = 0; i < n; ++i)
+      task(i);
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mmutex);
+    assert(minvoke == nullptr && "thread_pool_t::run() is not reentrant");
+    minvoke = invoke;
+    mtask = &task;
+    msize = n;
+    mnext.store(0, std::memory_order_relaxed);
+    ++mgeneration;
+  }
+  mstart.notify_all();
+
+  drain(invoke, &task, n);
+
+  ///every task has been handed out; wait for the workers still running theirs
+  std::unique_lock<std::mutex> lock(mmutex);
+  mfinish.wait(lock, [this]{ return mactive == 0; });
+  minvoke = nullptr;
+  mtask = nullptr;
+}
+
+CORNER_CASES_CUBEXX_INLINE
+void thread_pool_t::drain(void (*invoke)(const void*, std::size_t), const void* task, std::size_t n)
+{
+  for (std::size_t i = mnext.fetch_add(1, std::memory_order_relaxed); i < n;
+       i = mnext.fetch_add(1, std::memory_order_relaxed))
+    invoke(task, i);
+}
+
+CORNER_CASES_CUBEXX_INLINE
+void thread_pool_t::work()
+{
+  std::size_t generation = 0;
+  std::unique_lock<std::mutex> lock(mmutex);
+  while (true)
+  {
+    mstart.wait(lock, [&]{ return mstop || (minvoke != nullptr && mgeneration != generation); });
+    if (mstop)
+      return;
+
+    generation = mgeneration;
+    auto invoke = minvoke;
+    auto task = mtask;
+    auto n = msize;
+    ++mactive;
+    lock.unlock();
+
+    drain(invoke, task, n);
+
+    lock.lock();
+    if (--mactive == 0)
+      mfinish.notify_one();
+  }
+}
+
+} // namespace cubexx
@@ -0,0 +1,108 @@
+/*
+    Copyright (c) 2012 Azriel Fasten azriel.fasten@gmail.com
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef CORNER_CASES_CUBEXX_GRID_INDEX_HPP
+#define CORNER_CASES_CUBEXX_GRID_INDEX_HPP
+
+#include "cubexx/cubexx.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+
+namespace cubexx{
+
+/**
+ * @class grid_index_t
+ * @brief Numbers the grid points, edges and faces of a grid of cells, so that the element a cell shares with its
+ *          neighbors gets the same id from each of them; with arithmetic, no hashing.
+ *
+ * Every element is owned by the cell whose lower corner is the element's lowest grid point: an edge by that cell's
+ * edge along the same axis through its corner 0, a face by that cell's negative face on the same axis. The owner
+ * may be one past the last cell on an axis (for the elements on the upper boundary), so each kind of element is
+ * numbered over a box one larger on the axes it does not span:
+ *  * grid points over `(nx+1)*(ny+1)*(nz+1)`;
+ *  * edges along axis `a`, one block per axis in the order x, y, z, over the grid points less the last along `a`;
+ *  * faces across axis `a`, one block per axis, over the grid points less the last along the other two.
+ *
+ * Within each block, x varies fastest; so a row of cells along x has consecutive ids for any one of its elements,
+ * which is what the row functions (corner_ids() and so on) exploit.
+ *
+ * Ids are 64-bit: a grid of 1300 cells a side already has more than 2^32 edges.
+ */
+struct grid_index_t
+{
+  typedef std::uint64_t id_type;
+
+  ///A grid of @p nx by @p ny by @p nz cells.
+  grid_index_t(std::size_t nx, std::size_t ny, std::size_t nz);
+
+  ///The number of cells along each axis.
+  const std::array<std::size_t, 3>& size() const;
+
+  id_type cell_count() const;
+  ///The number of grid points.
+  id_type corner_count() const;
+  id_type edge_count() const;
+  id_type face_count() const;
+
+  ///@name Ids
+  ///The ids of cell `(x, y, z)` and of its elements.
+  ///@{
+  id_type cell_id(std::size_t x, std::size_t y, std::size_t z) const;
+  id_type corner_id(std::size_t x, std::size_t y, std::size_t z, const corner_t& corner) const;
+  id_type edge_id(std::size_t x, std::size_t y, std::size_t z, const edge_t& edge) const;
+  id_type face_id(std::size_t x, std::size_t y, std::size_t z, const face_t& face) const;
+  ///@}
+
+  ///@name Rows
+  /**
+   * The ids of an element of each of @p n cells along x, from `(x, y, z)`, written to @p ids; the ids are
+   * consecutive, and are written 4 at a time with SSE2.
+   */
+  ///@{
+  void corner_ids(std::size_t x, std::size_t y, std::size_t z, std::size_t n, const corner_t& corner, id_type* ids) const;
+  void edge_ids(std::size_t x, std::size_t y, std::size_t z, std::size_t n, const edge_t& edge, id_type* ids) const;
+  void face_ids(std::size_t x, std::size_t y, std::size_t z, std::size_t n, const face_t& face, id_type* ids) const;
+  ///@}
+
+private:
+  ///The id of the grid point @p point within a box of @p dimensions, starting at @p first.
+  static id_type linear(id_type first, const std::array<std::size_t, 3>& dimensions,
+                        const std::array<std::size_t, 3>& point);
+
+  std::array<std::size_t, 3> msize;
+  ///The dimensions of the boxes of grid points, and edges and faces along/across each axis.
+  std::array<std::size_t, 3> mcorner_dimensions;
+  std::array<std::array<std::size_t, 3>, 3> medge_dimensions, mface_dimensions;
+  ///The first id of the block of edges and faces of each axis; the last is the total.
+  std::array<id_type, 4> medge_offsets, mface_offsets;
+};
+
+} // namespace cubexx
+
+#include "cubexx/detail/grid_index.inl.hpp"
+
+#endif // CORNER_CASES_CUBEXX_GRID_INDEX_HPP
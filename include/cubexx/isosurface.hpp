@@ -0,0 +1,106 @@
+/*
+    Copyright (c) 2012 Azriel Fasten azriel.fasten@gmail.com
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef CORNER_CASES_CUBEXX_ISOSURFACE_HPP
+#define CORNER_CASES_CUBEXX_ISOSURFACE_HPP
+
+#include "cubexx/cubexx.hpp"
+#include "cubexx/marching_cubes.hpp"
+#include "cubexx/grid_index.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <vector>
+
+
+namespace cubexx{
+
+/**
+ * @class isosurface_extractor_t
+ * @brief Extracts an isosurface with marching cubes from a volume streamed in a z-slice at a time, holding no more
+ *          than two slices.
+ *
+ * Slices of `nx*ny` samples (x varying fastest) are pushed in order of z; each one after the first completes a
+ * slab of cells, which is classified a row at a time (marching_cubes_classify_row()) and triangulated
+ * (marching_cubes_triangle()) straight out of the two slices; each sample is read in place by the 8 cells
+ * around it, through their corner_t.
+ *
+ * A vertex is where the surface crosses a grid edge, and its id is the edge's grid_index_t::edge_id() in the grid
+ * of `nx-1` by `ny-1` by `nz-1` cells; so the cells sharing an edge agree on its vertex without any lookup. The ids
+ * are 64-bit, since a volume of 1300 samples a side already has more than 2^32 edges. Each vertex is interpolated
+ * and handed to the sink once: the extractor keeps a flag per edge of the two slices and between them, and the
+ * flags of the upper slice carry over to the next slab.
+ *
+ * The sink is any object with:
+ *  * `sink.vertex(id, position)`: a new vertex, with its position a `std::array<float, 3>` in sample units;
+ *  * `sink.triangle(id0, id1, id2)`: a triangle, counter-clockwise seen from the higher values, whose vertices
+ *      have all been given already.
+ */
+struct isosurface_extractor_t
+{
+  ///64-bit, as grid_index_t::id_type.
+  typedef grid_index_t::id_type id_type;
+
+  ///A volume of @p nx by @p ny by @p nz samples (each at least 2), to be cut at @p isovalue.
+  isosurface_extractor_t(std::size_t nx, std::size_t ny, std::size_t nz, float isovalue);
+
+  ///The grid of cells; the vertex ids are its edge ids.
+  const grid_index_t& grid() const;
+  ///The number of slices pushed so far.
+  std::size_t slices() const;
+
+  /**
+   * @brief Copies in the next slice of `nx*ny` samples, and extracts the slab it completes into @p sink.
+   *
+   * At most `nz` slices may be pushed.
+   */
+  template<typename sink_t>
+  void push(const float* slice, sink_t&& sink);
+
+private:
+  ///The vertex on @p edge of cell `(x, y)` of the slab, given to @p sink if it is new.
+  template<typename sink_t>
+  id_type vertex(std::size_t x, std::size_t y, const edge_t& edge, sink_t& sink);
+
+  std::size_t mnx, mny, mnz;
+  float misovalue;
+  grid_index_t mgrid;
+  std::size_t mslices;
+
+  ///The lower and upper slices of the current slab, by the z of corner_t::uz().
+  std::array<std::vector<float>, 2> msamples;
+  ///Whether each edge's vertex has been given; the x and y edges of each slice, by the grid point at their lower
+  /// end, and the z edges between them.
+  std::array<std::array<std::vector<std::uint8_t>, 2>, 2> mplane_done;
+  std::vector<std::uint8_t> mz_done;
+  ///The cases of a row of cells.
+  std::vector<std::uint8_t> mcases;
+};
+
+} // namespace cubexx
+
+#include "cubexx/detail/isosurface.inl.hpp"
+
+#endif // CORNER_CASES_CUBEXX_ISOSURFACE_HPP
@@ -0,0 +1,193 @@
+/*
+    Copyright (c) 2012 Azriel Fasten azriel.fasten@gmail.com
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef CORNER_CASES_CUBEXX_LINEAR_OCTREE_HPP
+#define CORNER_CASES_CUBEXX_LINEAR_OCTREE_HPP
+
+#include "cubexx/cubexx.hpp"
+#include "cubexx/morton.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+
+namespace cubexx{
+
+/**
+ * @class linear_octree_t
+ * @brief A pointerless octree; the leaves, and a @p T for each, in two contiguous arrays sorted in Morton
+ *          (depth-first) order.
+ *
+ * @param T
+ *          The value stored with each leaf.
+ * @param MaxDepth
+ *          The depth of the morton_code_t used as the leaves' keys.
+ *
+ * A leaf is a morton_code_t, i.e. the path of corner_t child indices from the root. Leaves are ordered by
+ * their "anchor": the path left-aligned to MaxDepth, i.e. the first of their deepest descendants. The
+ * leaves must not overlap (no leaf may contain another), but need not cover the whole root cell.
+ *
+ * The subtree of any cell is a contiguous run of leaves (see leaves()), which is what makes the layout
+ * pointerless; and since the arrays are all there is, they can be written out and mapped back in as they are.
+ */
+template<typename T, std::size_t MaxDepth = 21>
+struct linear_octree_t
+{
+  typedef morton_code_t<MaxDepth> code_type;
+  typedef T value_type;
+
+  ///Iterates over leaves in Morton order; dereferences to a (code, value) pair.
+  struct const_iterator;
+  ///A run of leaves, as returned by leaves().
+  struct range_t;
+
+  ///An empty octree.
+  linear_octree_t();
+  /**
+   * @brief Builds the octree from the leaves @p codes, in any order, and the corresponding @p values.
+   *
+   * The leaves must not overlap; this is checked with asserts.
+   */
+  linear_octree_t(std::vector<code_type> codes, std::vector<T> values);
+  /**
+   * @brief Builds the octree from the leaves @p codes, already in Morton order, and the corresponding @p values;
+   *          no sorting.
+   *
+   * The leaves must be sorted and must not overlap; this is checked with asserts.
+   */
+  static linear_octree_t from_sorted(std::vector<code_type> codes, std::vector<T> values);
+
+  ///The number of leaves.
+  std::size_t size() const;
+  bool empty() const;
+
+  ///The @p i-th leaf in Morton order.
+  const code_type& code(std::size_t i) const;
+  const T& value(std::size_t i) const;
+  T& value(std::size_t i);
+  ///The contiguous, sorted array of leaves.
+  const code_type* codes() const;
+  ///The contiguous array of values, in the order of codes().
+  const T* values() const;
+
+  /**
+   * @brief The index of the leaf containing @p code (which may be a leaf, or any cell below one), or
+   *          size() if no leaf contains it.
+   *
+   * Interpolation search on the anchors, alternating with bisection so that badly distributed leaves
+   * still take logarithmic time.
+   *
+   * @see locate_binary()
+   */
+  std::size_t locate(const code_type& code) const;
+  ///locate(), with plain binary search.
+  std::size_t locate_binary(const code_type& code) const;
+
+  ///The children of @p node that have leaves below them; empty if @p node is a leaf, or within one.
+  corner_set_t children(const code_type& node) const;
+  ///The run of leaves within @p node, in Morton order; if @p node is a leaf, or is within one, just that leaf.
+  range_t leaves(const code_type& node) const;
+
+  const_iterator begin() const;
+  const_iterator end() const;
+
+  ///The anchor of @p code; the path, left-aligned to MaxDepth.
+  static std::uint64_t anchor(const code_type& code);
+  ///The number of MaxDepth cells in @p code.
+  static std::uint64_t span(const code_type& code);
+
+private:
+  ///The first leaf whose anchor is at least @p key.
+  std::size_t lower_bound(std::uint64_t key) const;
+  ///Asserts that the leaves are sorted and do not overlap.
+  void check() const;
+
+  std::vector<code_type> mcodes;
+  std::vector<T> mvalues;
+};
+
+template<typename T, std::size_t MaxDepth>
+struct linear_octree_t<T, MaxDepth>::const_iterator
+{
+  typedef std::random_access_iterator_tag iterator_category;
+  typedef std::pair<code_type, const T&> value_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef const value_type* pointer;
+  ///Dereferencing returns by value.
+  typedef value_type reference;
+
+  const_iterator() : moctree(nullptr), mi(0) {}
+  const_iterator(const linear_octree_t* octree, std::size_t i) : moctree(octree), mi(i) {}
+
+  value_type operator*() const { return value_type(moctree->code(mi), moctree->value(mi)); }
+  value_type operator[](difference_type n) const { return *(*this + n); }
+  ///The index of the leaf in the octree.
+  std::size_t index() const { return mi; }
+
+  const_iterator& operator++() { ++mi; return *this; }
+  const_iterator operator++(int) { const_iterator result = *this; ++mi; return result; }
+  const_iterator& operator--() { --mi; return *this; }
+  const_iterator operator--(int) { const_iterator result = *this; --mi; return result; }
+  const_iterator& operator+=(difference_type n) { mi += n; return *this; }
+  const_iterator& operator-=(difference_type n) { mi -= n; return *this; }
+  const_iterator operator+(difference_type n) const { return const_iterator(moctree, mi + n); }
+  const_iterator operator-(difference_type n) const { return const_iterator(moctree, mi - n); }
+  difference_type operator-(const const_iterator& other) const { return difference_type(mi) - difference_type(other.mi); }
+
+  bool operator==(const const_iterator& other) const { return mi == other.mi; }
+  bool operator!=(const const_iterator& other) const { return mi != other.mi; }
+  bool operator<(const const_iterator& other) const { return mi < other.mi; }
+  bool operator>(const const_iterator& other) const { return mi > other.mi; }
+  bool operator<=(const const_iterator& other) const { return mi <= other.mi; }
+  bool operator>=(const const_iterator& other) const { return mi >= other.mi; }
+  friend const_iterator operator+(difference_type n, const const_iterator& it) { return it + n; }
+
+private:
+  const linear_octree_t* moctree;
+  std::size_t mi;
+};
+
+template<typename T, std::size_t MaxDepth>
+struct linear_octree_t<T, MaxDepth>::range_t
+{
+  range_t(const_iterator first, const_iterator last) : mfirst(first), mlast(last) {}
+
+  const_iterator begin() const { return mfirst; }
+  const_iterator end() const { return mlast; }
+  std::size_t size() const { return std::size_t(mlast - mfirst); }
+  bool empty() const { return mfirst == mlast; }
+
+private:
+  const_iterator mfirst, mlast;
+};
+
+} // namespace cubexx
+
+#include "cubexx/detail/linear_octree.inl.hpp"
+
+#endif // CORNER_CASES_CUBEXX_LINEAR_OCTREE_HPP
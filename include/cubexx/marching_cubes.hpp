@@ -0,0 +1,83 @@
+/*
+    Copyright (c) 2012 Azriel Fasten azriel.fasten@gmail.com
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef CORNER_CASES_CUBEXX_MARCHING_CUBES_HPP
+#define CORNER_CASES_CUBEXX_MARCHING_CUBES_HPP
+
+#include "cubexx/cubexx.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+
+namespace cubexx{
+
+///@name Marching cubes
+/**
+ * A marching cubes case is a corner_set_t: the corners of the cell that are inside, i.e. whose value is below
+ * the isovalue. Its mask() is the usual 8 bit case index, since corner_t::index() is bit-per-axis.
+ *
+ * The tables are generated at compile time from the cubexx topology, not pasted in:
+ *  * The intersected edges are those whose two corners straddle the case.
+ *  * On each face, the intersected edges are joined in pairs by a segment of the surface; 2 edges are joined to
+ *      each other, and on a face with 4 (inside corners on a diagonal, the ambiguous face) each edge is joined to
+ *      the one sharing its inside corner, separating the inside corners. The rule depends only on the face, so
+ *      two cells sharing a face agree on it, and the surface is watertight.
+ *  * The segments form closed loops around the cell; each loop is oriented so that it winds counter-clockwise
+ *      seen from outside (its normal points toward the higher values), and is fanned into triangles, from an
+ *      edge chosen so that no triangle side crosses a face of the cell (and so none lies flat on one).
+ *
+ * A triangle is 3 edges; its vertices are where the surface crosses them.
+ */
+///@{
+
+///The most triangles any case has.
+constexpr std::size_t marching_cubes_max_triangles();
+
+///The edges that the surface crosses in case @p inside.
+constexpr edge_set_t marching_cubes_edges(const corner_set_t& inside);
+///The number of triangles in case @p inside.
+constexpr std::size_t marching_cubes_triangle_count(const corner_set_t& inside);
+///The @p i-th triangle of case @p inside, as 3 edges, counter-clockwise seen from outside.
+constexpr std::array<edge_t, 3> marching_cubes_triangle(const corner_set_t& inside, std::size_t i);
+
+/**
+ * @brief The case of each of @p n cells in a row along x, from the values at the grid points around them.
+ *
+ * @p rows are the 4 rows of `n+1` values at `(y+dy, z+dz)`, as `rows[dy + 2*dz]`; cell `x` has the points
+ * `x` and `x+1` of each. The case is written as its mask() to `cases[x]`.
+ *
+ * With SSE2, 16 cells at a time: each row is compared against @p isovalue 4 values at a time, and the comparisons
+ * packed down to a byte per cell, which is masked by the corner's bit.
+ */
+CORNER_CASES_CUBEXX_INLINE void marching_cubes_classify_row(const float* const* rows, std::size_t n, float isovalue,
+                                                            std::uint8_t* cases);
+///@}
+
+} // namespace cubexx
+
+#include "cubexx/detail/marching_cubes.inl.hpp"
+
+#endif // CORNER_CASES_CUBEXX_MARCHING_CUBES_HPP
@@ -0,0 +1,184 @@
+/*
+    Copyright (c) 2012 Azriel Fasten azriel.fasten@gmail.com
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef CORNER_CASES_CUBEXX_MORTON_HPP
+#define CORNER_CASES_CUBEXX_MORTON_HPP
+
+#include "cubexx/cubexx.hpp"
+#include "cubexx/offset.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+#include <array>
+
+
+namespace cubexx{
+
+namespace detail{
+
+///Spreads the low 21 bits of @p v out to every third bit (bit `i` goes to bit `3*i`).
+///Uses BMI2's pdep when the target has it, and the usual shift-and-mask sequence otherwise.
+CORNER_CASES_CUBEXX_INLINE std::uint64_t morton_dilate3(std::uint64_t v);
+///The inverse of morton_dilate3(); gathers every third bit (bit `3*i` goes to bit `i`).
+CORNER_CASES_CUBEXX_INLINE std::uint64_t morton_compact3(std::uint64_t v);
+
+} // namespace detail
+
+
+/**
+ * @class morton_code_t
+ * @brief An octree locational code; the path of corners from the root cell down to a cell, at most
+ *          @p MaxDepth levels deep.
+ *
+ * corner_t::index() is already the Morton order of the corners within the cube (x is bit 0, y is bit 1,
+ * z is bit 2), so a path of corner indices, 3 bits per level, is also the Morton code (the bit-interleaved
+ * x, y, z coordinates) of the cell within its level.
+ *
+ * The code is kept with a sentinel bit above the path: the root is `1`, and each level appends 3 bits
+ * below. The level is thus implicit (see level()), and codes of different levels never collide.
+ *
+ * Ordering (operator<) compares the raw bits; for codes of the same level this is Morton order.
+ *
+ * @param MaxDepth
+ *          The deepest level that can be represented; the code takes `3*MaxDepth+1` bits, so at most 21.
+ *
+ * @see morton_code32_t, morton_code64_t
+ */
+template<std::size_t MaxDepth>
+struct morton_code_t
+{
+  static_assert(MaxDepth >= 1 && 3 * MaxDepth + 1 <= 64, "morton_code_t supports depths 1 through 21");
+
+  ///The integer the code is stored in.
+  typedef typename detail::uint_least_bits_t<3 * MaxDepth + 1>::type value_type;
+
+  ///The deepest level representable.
+  CORNER_CASES_CUBEXX_INLINE static constexpr std::size_t MAX_DEPTH(){ return MaxDepth; }
+
+  ///The root cell; level 0.
+  constexpr morton_code_t();
+
+  ///The root cell; level 0.
+  static constexpr morton_code_t root();
+  ///Wraps the raw (sentinel-bit encoded) @p bits, as returned by bits().
+  static constexpr morton_code_t from_bits(value_type bits);
+  ///The cell at integer coordinates @p x, @p y, @p z on @p level; each coordinate must be less than `2^level`.
+  static morton_code_t encode(std::uint_fast32_t x, std::uint_fast32_t y, std::uint_fast32_t z,
+                              std::size_t level = MaxDepth);
+  ///encode() for @p n cells given as a structure of arrays, all on @p level.
+  static void encode_n(const std::uint32_t* xs, const std::uint32_t* ys, const std::uint32_t* zs,
+                       std::size_t level, morton_code_t* codes, std::size_t n);
+  ///decode() for @p n codes, into a structure of arrays.
+  static void decode_n(const morton_code_t* codes,
+                       std::uint32_t* xs, std::uint32_t* ys, std::uint32_t* zs, std::size_t n);
+
+  ///The raw, sentinel-bit encoded code.
+  constexpr value_type bits() const;
+  ///The bits below the sentinel; the interleaved coordinates of the cell within its level.
+  constexpr value_type path() const;
+  ///The depth of the cell; 0 for the root.
+  constexpr std::size_t level() const;
+  constexpr bool is_root() const;
+
+  ///The child of this cell at @p corner; this cell must be shallower than MaxDepth.
+  constexpr morton_code_t child(const corner_t& corner) const;
+  ///The parent of this cell; this cell must not be the root.
+  constexpr morton_code_t parent() const;
+  ///The ancestor of this cell on @p level, which must be at most level().
+  constexpr morton_code_t ancestor(std::size_t level) const;
+  ///The corner that the path takes on @p level (from 1, the root's child, through level()).
+  constexpr const corner_t& corner_at(std::size_t level) const;
+  ///The corner of its parent that this cell is at; corner_at(level()). This cell must not be the root.
+  constexpr const corner_t& corner() const;
+
+  ///Whether @p other is this cell or one of its descendants.
+  constexpr bool contains(const morton_code_t& other) const;
+
+  ///The integer coordinates of the cell within its level, each in `[0, 2^level())`.
+  std::array<std::uint_fast32_t, 3> decode() const;
+
+  constexpr bool operator==(const morton_code_t& other) const;
+  constexpr bool operator!=(const morton_code_t& other) const;
+  constexpr bool operator<(const morton_code_t& other) const;
+
+private:
+  explicit constexpr morton_code_t(value_type bits);
+
+  value_type mbits;
+};
+
+///A morton code fitting in 32 bits; 10 levels deep.
+typedef morton_code_t<10> morton_code32_t;
+///A morton code fitting in 64 bits; 21 levels deep.
+typedef morton_code_t<21> morton_code64_t;
+
+static_assert(sizeof(morton_code32_t) == 4, "morton_code32_t should be 32 bits");
+static_assert(sizeof(morton_code64_t) == 8, "morton_code64_t should be 64 bits");
+
+
+/**
+ * @brief A neighboring cell, as returned by neighbor().
+ *
+ * If the neighbor would be outside of the root cell, @p outside is set, and @p code is the cell on the far
+ * side of the root instead (the coordinates wrap around), which is the neighbor in a periodic domain.
+ */
+template<std::size_t MaxDepth>
+struct morton_neighbor_t
+{
+  morton_code_t<MaxDepth> code;
+  bool outside;
+};
+
+///@name Neighbor finding
+///The neighbor of a cell on the same level, found with dilated integer arithmetic on the code (adding or
+/// subtracting 1 on the bits of each axis, with the carries skipping over the other axes), in constant time;
+/// there is no walk up to the common ancestor.
+///@{
+
+///The cell sharing the face in @p direction.
+template<std::size_t MaxDepth>
+morton_neighbor_t<MaxDepth> neighbor(const morton_code_t<MaxDepth>& code, const direction_t& direction);
+///The cell sharing only @p edge (diagonally across it); the cell is offset along both axes that @p edge is not on.
+template<std::size_t MaxDepth>
+morton_neighbor_t<MaxDepth> neighbor(const morton_code_t<MaxDepth>& code, const edge_t& edge);
+///The cell sharing only @p corner (diagonally across it); the cell is offset along all three axes.
+template<std::size_t MaxDepth>
+morton_neighbor_t<MaxDepth> neighbor(const morton_code_t<MaxDepth>& code, const corner_t& corner);
+///The cell at @p offset; any of the above, or the cell itself for the center.
+template<std::size_t MaxDepth>
+morton_neighbor_t<MaxDepth> neighbor(const morton_code_t<MaxDepth>& code, const offset_t& offset);
+
+///neighbor() for each of @p n codes, across the same @p element (a direction_t, edge_t or corner_t).
+///@p outside may be null if the caller does not care.
+template<std::size_t MaxDepth, typename element_t>
+void neighbor_n(const morton_code_t<MaxDepth>* codes, std::size_t n, const element_t& element,
+                morton_code_t<MaxDepth>* neighbors, bool* outside);
+///@}
+
+} // namespace cubexx
+
+#include "cubexx/detail/morton.inl.hpp"
+
+#endif // CORNER_CASES_CUBEXX_MORTON_HPP
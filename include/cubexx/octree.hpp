@@ -0,0 +1,176 @@
+/*
+    Copyright (c) 2012 Azriel Fasten azriel.fasten@gmail.com
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef CORNER_CASES_CUBEXX_OCTREE_HPP
+#define CORNER_CASES_CUBEXX_OCTREE_HPP
+
+#include "cubexx/cubexx.hpp"
+#include "cubexx/morton.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+#include <memory>
+#include <vector>
+
+
+namespace cubexx{
+
+namespace detail{
+
+///The smallest power of two that is at least @p n.
+CORNER_CASES_CUBEXX_INLINE
+constexpr std::size_t ceil_pow2(std::size_t n)
+{
+  return n <= 1 ? 1 : std::size_t(1) << bit_width(n - 1);
+}
+
+} // namespace detail
+
+
+/**
+ * @class octree_t
+ * @brief A pointer octree for dynamic workloads, with the nodes pooled in blocks of 8 siblings.
+ *
+ * @param T
+ *          The value stored in every node; default constructible and assignable.
+ * @param BlocksPerSlab
+ *          How many blocks the pool allocates at a time.
+ *
+ * All 8 children of a node are allocated together, as a block indexed by corner_t::index(); a node only keeps
+ * the (32 bit) index of its children's block in the pool, and a corner_set_t of which children are present.
+ * A node is thus identified by a 32 bit node_id: its block index times 8, plus its corner's index. The root
+ * has its own block, 0.
+ *
+ * Each node is padded to a power of two no larger than a cache line, so it never straddles one.
+ *
+ * Blocks come from slabs of @p BlocksPerSlab blocks, and freed blocks go onto an intrusive free list. Inserting
+ * and erasing only touch the global heap when the pool runs out; reserve() up front to avoid that altogether.
+ */
+template<typename T, std::size_t BlocksPerSlab = 1024>
+struct octree_t
+{
+  static_assert(detail::has_exactly_one_bit(BlocksPerSlab), "BlocksPerSlab should be a power of two");
+
+  typedef T value_type;
+  ///Identifies a node; stable until the node is erased.
+  typedef std::uint32_t node_id;
+
+  ///Not any node.
+  CORNER_CASES_CUBEXX_INLINE static constexpr node_id null_node(){ return ~node_id(0); }
+
+  ///An octree with just a root, holding a default constructed @p T.
+  octree_t();
+  ///An octree with just a root, and room for @p blocks blocks of children before any further allocation.
+  explicit octree_t(std::size_t blocks);
+
+  ~octree_t();
+  octree_t(const octree_t&) = delete;
+  octree_t& operator=(const octree_t&) = delete;
+  octree_t(octree_t&&) = default;
+  ///Swaps with @p other, whose destructor then destroys this octree's nodes.
+  octree_t& operator=(octree_t&& other);
+
+  ///The root node.
+  static constexpr node_id root();
+
+  ///The number of nodes, including the root.
+  std::size_t size() const;
+  ///The number of blocks in use, not counting the root's.
+  std::size_t block_count() const;
+  ///The number of blocks that can be in use before the pool allocates another slab.
+  std::size_t capacity() const;
+  ///Makes room for @p blocks blocks in total.
+  void reserve(std::size_t blocks);
+
+  T& value(node_id node);
+  const T& value(node_id node) const;
+
+  ///Which children of @p node are present.
+  corner_set_t children(node_id node) const;
+  bool is_leaf(node_id node) const;
+  ///The child of @p node at @p corner, or null_node() if it is not present.
+  node_id child(node_id node, const corner_t& corner) const;
+  ///The corner of its parent that @p node is at; @p node must not be the root.
+  static const corner_t& corner(node_id node);
+
+  ///Adds the child of @p node at @p corner (if it is not present), holding @p value; returns the child.
+  node_id insert_child(node_id node, const corner_t& corner, const T& value = T());
+  ///Adds all the missing children of @p node, each holding @p value.
+  void subdivide(node_id node, const T& value = T());
+  ///Removes the child of @p node at @p corner, and everything below it.
+  void erase_child(node_id node, const corner_t& corner);
+  ///Removes all the children of @p node, and everything below them.
+  void erase_children(node_id node);
+
+  ///The node at @p code, or null_node() if it is not in the tree.
+  template<std::size_t MaxDepth>
+  node_id find(const morton_code_t<MaxDepth>& code) const;
+  ///The node at @p code, adding it and any missing ancestors (holding @p value) if need be.
+  template<std::size_t MaxDepth>
+  node_id insert(const morton_code_t<MaxDepth>& code, const T& value = T());
+
+private:
+  struct node_t
+  {
+    T value;
+    ///The children's block; for a free block, the first node's is the next free block instead.
+    std::uint32_t block;
+    corner_set_t child_mask;
+  };
+
+  ///node_t, padded (by alignment) to a power of two, so that a block of them never puts one across a cache line.
+  struct alignas(detail::ceil_pow2(sizeof(node_t))) padded_node_t : node_t {};
+  static_assert(sizeof(padded_node_t) <= 64, "T is too large for a node to fit in a cache line");
+
+  struct block_t
+  {
+    padded_node_t nodes[8];
+  };
+
+  node_t& get(node_id node);
+  const node_t& get(node_id node) const;
+  block_t& get_block(std::uint32_t block);
+
+  std::uint32_t allocate_block();
+  void free_block(std::uint32_t block);
+  void add_slab();
+
+  ///Frees the blocks below @p node; leaves @p node itself alone.
+  void erase_below(node_id node);
+
+  ///The raw memory of each slab, and the (cache line aligned) blocks within it.
+  std::vector<std::unique_ptr<unsigned char[]>> mslab_memory;
+  std::vector<block_t*> mslabs;
+  ///The head of the free list, or null_node() if it is empty.
+  std::uint32_t mfree;
+  std::size_t mblocks;
+  std::size_t mnodes;
+};
+
+} // namespace cubexx
+
+#include "cubexx/detail/octree.inl.hpp"
+
+#endif // CORNER_CASES_CUBEXX_OCTREE_HPP
@@ -0,0 +1,179 @@
+/*
+    Copyright (c) 2012 Azriel Fasten azriel.fasten@gmail.com
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef CORNER_CASES_CUBEXX_OCTREE_BUILDER_HPP
+#define CORNER_CASES_CUBEXX_OCTREE_BUILDER_HPP
+
+#include "cubexx/cubexx.hpp"
+#include "cubexx/morton.hpp"
+#include "cubexx/linear_octree.hpp"
+#include "cubexx/octree.hpp"
+#include "cubexx/thread_pool.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <vector>
+
+
+namespace cubexx{
+
+namespace detail{
+
+/**
+ * @brief Quantizes @p n coordinates to the cells of a grid of @p cells cells starting at @p lower, each
+ *          `1/scale` wide.
+ *
+ * A coordinate exactly on the boundary between two cells goes to the lower one, which is the rule of
+ * corner_t::get() and `cubelib_get_corner_by_float3()` (zero is on the lower side) applied at every level
+ * at once. Coordinates outside the grid are clamped into it. The loop is branch free, so it vectorizes.
+ */
+CORNER_CASES_CUBEXX_INLINE void quantize_n(const float* vs, std::uint32_t* qs, std::size_t n,
+                                           float lower, float scale, std::uint32_t cells);
+
+/**
+ * @brief Sorts @p keys, and @p values along with them, on their low @p bits bits, with a parallel least
+ *          significant digit radix sort; stable.
+ *
+ * Each pass histograms the digit per block of the input in parallel, and then scatters each block to its
+ * own precomputed offsets in parallel. Passes on a digit that every key shares are skipped.
+ */
+CORNER_CASES_CUBEXX_INLINE void radix_sort(thread_pool_t& pool, std::vector<std::uint64_t>& keys,
+                                           std::vector<std::uint32_t>& values, std::size_t bits);
+///radix_sort() of @p keys alone.
+CORNER_CASES_CUBEXX_INLINE void radix_sort(thread_pool_t& pool, std::vector<std::uint64_t>& keys, std::size_t bits);
+
+} // namespace detail
+
+
+/**
+ * @class point_octree_t
+ * @brief An octree over a point cloud, as built by octree_builder_t.
+ *
+ * The points are referred to by their index in the input; @p order holds them in Morton order, and each leaf
+ * holds the run of @p order within it.
+ */
+template<std::size_t MaxDepth = 21>
+struct point_octree_t
+{
+  typedef morton_code_t<MaxDepth> code_type;
+
+  ///A run of points, `order[first .. first+count)`.
+  struct points_t
+  {
+    std::uint32_t first;
+    std::uint32_t count;
+  };
+
+  ///An internal node, and which of its children have points below them.
+  struct node_t
+  {
+    code_type code;
+    corner_set_t children;
+  };
+
+  ///The leaves; only cells with points in them.
+  linear_octree_t<points_t, MaxDepth> leaves;
+  ///The indices of the points, sorted by the leaf they are in.
+  std::vector<std::uint32_t> order;
+  ///The internal nodes, bottom-up: deepest level first, and in Morton order within a level; so every node comes
+  /// after all of its children.
+  std::vector<node_t> nodes;
+
+  ///The same tree as an octree_t; the leaves hold their points, the internal nodes hold empty runs.
+  octree_t<points_t> pooled() const;
+};
+
+
+/**
+ * @class octree_builder_t
+ * @brief Builds a point_octree_t from a point cloud, in parallel over a thread_pool_t.
+ *
+ * Every leaf is the largest cell that holds at most @p leaf_capacity points (or a cell on MaxDepth, which may hold
+ * any number of coincident points); cells without points are left out.
+ *
+ * The build goes:
+ *  1. Each point is classified into its cell on MaxDepth, i.e. into the child octant on every level at once,
+ *      by quantizing its coordinates (see detail::quantize_n()), and the cell's Morton code is worked out; in
+ *      parallel over blocks of points.
+ *  2. The codes are sorted, along with the point indices, with a parallel radix sort (see detail::radix_sort()).
+ *  3. The leaves are found by splitting the sorted codes top-down; the large cells at the top are split on
+ *      the calling thread (8 binary searches each), and the cells small enough are split in parallel.
+ *  4. The internal nodes, and their corner_set_t masks, are emitted bottom-up from the leaves.
+ */
+template<std::size_t MaxDepth = 21>
+struct octree_builder_t
+{
+  typedef point_octree_t<MaxDepth> result_type;
+  typedef typename result_type::code_type code_type;
+  typedef typename result_type::points_t points_t;
+
+  octree_builder_t(thread_pool_t& pool, std::size_t leaf_capacity);
+
+  /**
+   * @brief Builds the octree of @p n points with float coordinates, in the root cube of side @p size with its
+   *          lowest corner at @p lower.
+   *
+   * Points outside of the root cube are clamped into it.
+   */
+  result_type build(const float* xs, const float* ys, const float* zs, std::size_t n,
+                    const std::array<float, 3>& lower, float size) const;
+  ///Builds the octree of @p n points with fixed-point coordinates; each coordinate is the cell on MaxDepth,
+  /// and must be less than `2^MaxDepth`.
+  result_type build(const std::uint32_t* xs, const std::uint32_t* ys, const std::uint32_t* zs,
+                    std::size_t n) const;
+
+  std::size_t leaf_capacity() const;
+
+private:
+  ///The number of points per block, when working on blocks of points in parallel.
+  static constexpr std::size_t BLOCK_SIZE(){ return 1 << 16; }
+
+  ///A cell, and the run of sorted points within it.
+  struct cell_t
+  {
+    code_type code;
+    std::size_t first, last;
+  };
+
+  ///Steps 2-4, once the keys are known.
+  result_type build(std::vector<std::uint64_t>& keys) const;
+  /**
+   * @brief Splits @p cell until its pieces hold at most @p grain points, and appends them in Morton order.
+   *
+   * Pieces that hold more than leaf_capacity() points, and are not on MaxDepth, are not leaves yet, which @p done
+   * says.
+   */
+  void split(const std::uint64_t* keys, const cell_t& cell, std::size_t grain,
+             std::vector<cell_t>& pieces, std::vector<bool>& done) const;
+
+  thread_pool_t& mpool;
+  std::size_t mleaf_capacity;
+};
+
+} // namespace cubexx
+
+#include "cubexx/detail/octree_builder.inl.hpp"
+
+#endif // CORNER_CASES_CUBEXX_OCTREE_BUILDER_HPP
@@ -0,0 +1,75 @@
+/*
+    Copyright (c) 2012 Azriel Fasten azriel.fasten@gmail.com
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef CORNER_CASES_CUBEXX_OCTREE_TRAVERSAL_HPP
+#define CORNER_CASES_CUBEXX_OCTREE_TRAVERSAL_HPP
+
+#include "cubexx/cubexx.hpp"
+#include "cubexx/morton.hpp"
+#include "cubexx/linear_octree.hpp"
+#include "cubexx/octree.hpp"
+
+#include <cstddef>
+
+
+namespace cubexx{
+
+/**
+ * @brief How a traversal (raycast(), cull_visit()) walks a kind of octree; specialized for octree_t and
+ *          linear_octree_t.
+ *
+ * A specialization has a `node_type`, and static `empty(tree)`, `root(tree)`, `children(tree, node)` (as a
+ * corner_set_t; empty for a leaf) and `child(tree, node, corner)`.
+ */
+template<typename tree_t>
+struct octree_traversal_t;
+
+template<typename T, std::size_t BlocksPerSlab>
+struct octree_traversal_t<octree_t<T, BlocksPerSlab>>
+{
+  typedef octree_t<T, BlocksPerSlab> tree_type;
+  typedef typename tree_type::node_id node_type;
+
+  static bool empty(const tree_type&){ return false; }
+  static node_type root(const tree_type&){ return tree_type::root(); }
+  static corner_set_t children(const tree_type& tree, node_type node){ return tree.children(node); }
+  static node_type child(const tree_type& tree, node_type node, const corner_t& corner){ return tree.child(node, corner); }
+};
+
+///The nodes are the cells' morton codes; a cell with no leaves below it is never visited.
+template<typename T, std::size_t MaxDepth>
+struct octree_traversal_t<linear_octree_t<T, MaxDepth>>
+{
+  typedef linear_octree_t<T, MaxDepth> tree_type;
+  typedef morton_code_t<MaxDepth> node_type;
+
+  static bool empty(const tree_type& tree){ return tree.empty(); }
+  static node_type root(const tree_type&){ return node_type::root(); }
+  static corner_set_t children(const tree_type& tree, const node_type& node){ return tree.children(node); }
+  static node_type child(const tree_type&, const node_type& node, const corner_t& corner){ return node.child(corner); }
+};
+
+} // namespace cubexx
+
+#endif // CORNER_CASES_CUBEXX_OCTREE_TRAVERSAL_HPP
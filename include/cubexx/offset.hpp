@@ -0,0 +1,178 @@
+/*
+    Copyright (c) 2012 Azriel Fasten azriel.fasten@gmail.com
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef CORNER_CASES_CUBEXX_OFFSET_HPP
+#define CORNER_CASES_CUBEXX_OFFSET_HPP
+
+#include "cubexx/cubexx.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+
+namespace cubexx{
+
+namespace detail{
+
+///Builds the precomputed offset tables at compile time.
+struct offset_builder_t;
+
+} // namespace detail
+
+/**
+ * @class offset_t
+ * @brief One of the 27 offsets `(dx, dy, dz)` in \f$\left\{-1,0,+1\right\}^3\f$ from a cell to itself or one of its
+ *          26 neighbors.
+ *
+ * Seen from the center of the cube, the neighbors across its 6 faces, 12 edges and 8 corners are exactly the
+ * offsets with 1, 2 and 3 non-zero components; an offset converts to and from the face_t (or direction_t),
+ * edge_t or corner_t it goes through. The center (the zero offset) is the 27th.
+ *
+ * The index() is `(dx+1) + 3*(dy+1) + 9*(dz+1)`, so x varies fastest, as in a grid; the center is 13, and
+ * the opposite of an offset is at `26 - index()`. Conversions are lookups in tables precomputed at compile time.
+ *
+ * @see offset_set_t, offset_deltas_t
+ */
+struct offset_t
+{
+  ///The center, the zero offset.
+  constexpr offset_t();
+
+  ///The offset `(dx, dy, dz)`; each component must be in `{-1, 0, +1}`.
+  static constexpr const offset_t& get(std::int_fast8_t dx, std::int_fast8_t dy, std::int_fast8_t dz);
+  ///Return the offset represented by an index.
+  ///@see index()
+  static constexpr const offset_t& get(std::uint_fast8_t idx);
+  static constexpr const offset_t& get(const offset_t& offset);
+  ///The offset to the neighbor across a face; one non-zero component.
+  static constexpr const offset_t& get(const direction_t& direction);
+  ///The offset to the neighbor across a face; one non-zero component.
+  static constexpr const offset_t& get(const face_t& face);
+  ///The offset to the neighbor across an edge; zero along the edge's axis.
+  static constexpr const offset_t& get(const edge_t& edge);
+  ///The offset to the neighbor across a corner; no zero component.
+  static constexpr const offset_t& get(const corner_t& corner);
+  static constexpr const offset_t& center();
+  ///All 27 offsets, by index().
+  static constexpr const std::array<offset_t, 27>& all();
+
+  constexpr std::int_fast8_t dx() const;
+  constexpr std::int_fast8_t dy() const;
+  constexpr std::int_fast8_t dz() const;
+  ///All three components.
+  constexpr const std::array<std::int_fast8_t, 3>& xyz() const;
+  ///The negated offset; the center is its own opposite.
+  constexpr const offset_t& opposite() const;
+
+  ///@name Kinds
+  ///By the number of non-zero components: 0, 1, 2 or 3.
+  ///@{
+  constexpr bool is_center() const;
+  constexpr bool is_face() const;
+  constexpr bool is_edge() const;
+  constexpr bool is_corner() const;
+  ///@}
+
+  ///@name Conversions
+  ///The element this offset goes through; it must be of that kind (see is_face() and so on).
+  ///@{
+  constexpr const direction_t& direction() const;
+  constexpr const face_t& face() const;
+  constexpr const edge_t& edge() const;
+  constexpr const corner_t& corner() const;
+  ///@}
+
+  ///The change in linear index that this offset makes, in an array with the given strides.
+  ///@see offset_deltas_t
+  constexpr std::ptrdiff_t delta(std::ptrdiff_t stride_x, std::ptrdiff_t stride_y, std::ptrdiff_t stride_z) const;
+
+  ///Retrieve a numeric 0-based index for the offset, less than SIZE(); see offset_t.
+  ///@see get(std::uint_fast8_t idx)
+  constexpr std::uint_fast8_t index() const;
+  ///Comparison
+  constexpr bool operator<(const offset_t& other) const;
+  ///Comparison
+  constexpr bool operator==(const offset_t& other) const;
+  ///Comparison
+  constexpr bool operator!=(const offset_t& other) const;
+
+  ///Number of offsets.
+  CORNER_CASES_CUBEXX_INLINE static constexpr std::size_t SIZE(){ return 27; }
+private:
+  friend struct detail::offset_builder_t;
+
+  std::uint8_t mindex;
+
+  explicit constexpr offset_t(std::uint8_t idx);
+};
+
+/**
+ * A set of offset_t, with the same algebra as the other sets; 27 bits.
+ */
+struct offset_set_t : public set_base_t<offset_set_t, offset_t, 27>
+{
+  typedef offset_set_t self_t;
+  typedef set_base_t<offset_set_t, offset_t, 27> base_t;
+
+  template<typename T
+          , typename = typename std::enable_if< detail::is_element_source<T, offset_t>::value >::type>
+  constexpr offset_set_t(const T& v);
+  constexpr offset_set_t();
+
+  ///The 6 offsets across faces.
+  static constexpr offset_set_t faces();
+  ///The 12 offsets across edges.
+  static constexpr offset_set_t edges();
+  ///The 8 offsets across corners.
+  static constexpr offset_set_t corners();
+  ///The neighbors of a cell by @p connectivity, which must be 6 (faces), 18 (and edges) or 26 (and corners).
+  static constexpr offset_set_t neighborhood(std::uint_fast8_t connectivity);
+};
+
+/**
+ * @class offset_deltas_t
+ * @brief The offset_t::delta() of all 27 offsets for an array with fixed strides, so that getting at a neighbor
+ *          of a linear index is one add.
+ *
+ * For a grid of `nx` by `ny` by `nz` values with x varying fastest, the strides are `1`, `nx` and `nx*ny`. The
+ * neighbor must be in the array; nothing is checked at the boundary.
+ */
+struct offset_deltas_t
+{
+  constexpr offset_deltas_t(std::ptrdiff_t stride_x, std::ptrdiff_t stride_y, std::ptrdiff_t stride_z);
+
+  ///The change in linear index that @p offset makes.
+  constexpr std::ptrdiff_t operator[](const offset_t& offset) const;
+  ///The change in linear index for each offset, by offset_t::index().
+  constexpr const std::ptrdiff_t* data() const;
+private:
+  std::ptrdiff_t mdeltas[27];
+};
+
+} // namespace cubexx
+
+#include "cubexx/detail/offset.inl.hpp"
+
+#endif // CORNER_CASES_CUBEXX_OFFSET_HPP
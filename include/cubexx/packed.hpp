@@ -0,0 +1,205 @@
+/*
+    Copyright (c) 2012 Azriel Fasten azriel.fasten@gmail.com
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef CORNER_CASES_CUBEXX_PACKED_HPP
+#define CORNER_CASES_CUBEXX_PACKED_HPP
+
+#include "cubexx/cubexx.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+#include <iterator>
+#include <vector>
+#include <type_traits>
+
+
+namespace cubexx{
+
+namespace detail{
+
+///@name Packed index kernels
+///Raw kernels behind packed_array_t, on indices stored one per byte. The 4 bit layout keeps element `i` in
+/// the low nibble of byte `i/2` if `i` is even, and in the high nibble otherwise; the 3 bit layout keeps eight
+/// elements in each (little-endian) 24 bit group, element `i` at bit `3*(i%8)` of group `i/8`.
+///The bulk kernels use SSE2 (4 bit) and BMI2 (3 bit) when the target has them.
+///@{
+CORNER_CASES_CUBEXX_INLINE std::uint_fast8_t packed4_get(const std::uint8_t* bytes, std::size_t i);
+CORNER_CASES_CUBEXX_INLINE void packed4_set(std::uint8_t* bytes, std::size_t i, std::uint_fast8_t index);
+CORNER_CASES_CUBEXX_INLINE std::uint_fast8_t packed3_get(const std::uint8_t* bytes, std::size_t i);
+CORNER_CASES_CUBEXX_INLINE void packed3_set(std::uint8_t* bytes, std::size_t i, std::uint_fast8_t index);
+
+///Overwrites all the bytes holding the first @p n elements.
+CORNER_CASES_CUBEXX_INLINE void packed4_pack_n(const std::uint8_t* indices, std::uint8_t* bytes, std::size_t n);
+CORNER_CASES_CUBEXX_INLINE void packed4_unpack_n(const std::uint8_t* bytes, std::uint8_t* indices, std::size_t n);
+///Overwrites all the (whole) groups holding the first @p n elements.
+CORNER_CASES_CUBEXX_INLINE void packed3_pack_n(const std::uint8_t* indices, std::uint8_t* bytes, std::size_t n);
+CORNER_CASES_CUBEXX_INLINE void packed3_unpack_n(const std::uint8_t* bytes, std::uint8_t* indices, std::size_t n);
+///@}
+
+} // namespace detail
+
+
+/**
+ * @class packed_array_t
+ * @brief A dynamic array of cube elements (corner_t, direction_t, face_t or edge_t), stored in @p BITS bits
+ *          per element; for annotating every node of a large octree or every vertex of a mesh.
+ *
+ * @param element_t
+ *          The element type.
+ * @param BITS
+ *          4 (two elements per byte; works for every element type), or 3 (eight elements per three bytes;
+ *          only for element types with at most 8 elements, so not edge_t).
+ *
+ * Elements are stored by index(), so null elements cannot be stored. Since the elements are
+ * not addressable, the non-const operator[] and the iterators hand out proxies.
+ *
+ * The bulk assign() and unpack() go through the SIMD kernels, and are much faster than element-by-element
+ * access when converting whole arrays.
+ */
+template<typename element_t, std::size_t BITS = 4>
+struct packed_array_t
+{
+  static_assert(BITS == 3 || BITS == 4, "packed_array_t supports 3 or 4 bits per element");
+  static_assert(element_t::SIZE() <= (std::size_t(1) << BITS), "too many distinct elements for BITS; edges need 4 bits");
+  static_assert(sizeof(element_t) == 1, "packed_array_t relies on the elements being a single byte holding their index");
+
+  typedef element_t value_type;
+  typedef std::size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+
+  ///Proxy for a single element, returned by the non-const operator[].
+  struct reference;
+  ///Random access iterator, dereferencing to element values.
+  struct const_iterator;
+
+  ///The number of bytes needed to store @p n elements; 3 bit storage is rounded up to whole groups.
+  static constexpr std::size_t byte_count(std::size_t n);
+
+  packed_array_t();
+  explicit packed_array_t(std::size_t size, const element_t& value = element_t::get(0));
+  packed_array_t(const element_t* elements, std::size_t size);
+
+  std::size_t size() const;
+  bool empty() const;
+  void clear();
+  void resize(std::size_t size, const element_t& value = element_t::get(0));
+  void push_back(const element_t& element);
+
+  element_t get(std::size_t i) const;
+  void set(std::size_t i, const element_t& element);
+
+  element_t operator[](std::size_t i) const;
+  reference operator[](std::size_t i);
+
+  const_iterator begin() const;
+  const_iterator end() const;
+  const_iterator cbegin() const;
+  const_iterator cend() const;
+
+  ///Replaces the contents with `elements[0 .. size)`.
+  void assign(const element_t* elements, std::size_t size);
+  ///Copies every element out to `elements[0 .. size())`.
+  void unpack(element_t* elements) const;
+
+  ///The packed storage; byte_count(size()) bytes.
+  const std::uint8_t* data() const;
+  std::uint8_t* data();
+
+  bool operator==(const packed_array_t& other) const;
+  bool operator!=(const packed_array_t& other) const;
+
+private:
+  std::size_t msize;
+  std::vector<std::uint8_t> mbytes;
+};
+
+template<typename element_t, std::size_t BITS>
+struct packed_array_t<element_t, BITS>::reference
+{
+  reference(packed_array_t& array, std::size_t i) : marray(array), mi(i) {}
+
+  operator element_t() const { return marray.get(mi); }
+  reference& operator=(const element_t& element) { marray.set(mi, element); return *this; }
+  reference& operator=(const reference& other) { return *this = element_t(other); }
+
+private:
+  packed_array_t& marray;
+  std::size_t mi;
+};
+
+template<typename element_t, std::size_t BITS>
+struct packed_array_t<element_t, BITS>::const_iterator
+{
+  typedef std::random_access_iterator_tag iterator_category;
+  typedef element_t value_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef const element_t* pointer;
+  ///Dereferencing returns by value.
+  typedef element_t reference;
+
+  const_iterator() : marray(nullptr), mi(0) {}
+  const_iterator(const packed_array_t* array, std::size_t i) : marray(array), mi(i) {}
+
+  element_t operator*() const { return marray->get(mi); }
+  element_t operator[](difference_type n) const { return marray->get(mi + n); }
+
+  const_iterator& operator++() { ++mi; return *this; }
+  const_iterator operator++(int) { const_iterator result = *this; ++mi; return result; }
+  const_iterator& operator--() { --mi; return *this; }
+  const_iterator operator--(int) { const_iterator result = *this; --mi; return result; }
+  const_iterator& operator+=(difference_type n) { mi += n; return *this; }
+  const_iterator& operator-=(difference_type n) { mi -= n; return *this; }
+  const_iterator operator+(difference_type n) const { return const_iterator(marray, mi + n); }
+  const_iterator operator-(difference_type n) const { return const_iterator(marray, mi - n); }
+  friend const_iterator operator+(difference_type n, const const_iterator& it) { return it + n; }
+  difference_type operator-(const const_iterator& other) const { return difference_type(mi) - difference_type(other.mi); }
+
+  bool operator==(const const_iterator& other) const { return mi == other.mi; }
+  bool operator!=(const const_iterator& other) const { return mi != other.mi; }
+  bool operator<(const const_iterator& other) const { return mi < other.mi; }
+  bool operator>(const const_iterator& other) const { return mi > other.mi; }
+  bool operator<=(const const_iterator& other) const { return mi <= other.mi; }
+  bool operator>=(const const_iterator& other) const { return mi >= other.mi; }
+
+private:
+  const packed_array_t* marray;
+  std::size_t mi;
+};
+
+
+typedef packed_array_t<corner_t> packed_corner_array_t;
+typedef packed_array_t<direction_t> packed_direction_array_t;
+typedef packed_array_t<face_t> packed_face_array_t;
+typedef packed_array_t<edge_t> packed_edge_array_t;
+
+typedef packed_array_t<corner_t, 3> packed3_corner_array_t;
+typedef packed_array_t<direction_t, 3> packed3_direction_array_t;
+typedef packed_array_t<face_t, 3> packed3_face_array_t;
+
+} // namespace cubexx
+
+#include "cubexx/detail/packed.inl.hpp"
+
+#endif // CORNER_CASES_CUBEXX_PACKED_HPP
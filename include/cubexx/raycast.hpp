@@ -0,0 +1,105 @@
+/*
+    Copyright (c) 2012 Azriel Fasten azriel.fasten@gmail.com
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef CORNER_CASES_CUBEXX_RAYCAST_HPP
+#define CORNER_CASES_CUBEXX_RAYCAST_HPP
+
+#include "cubexx/cubexx.hpp"
+#include "cubexx/morton.hpp"
+#include "cubexx/linear_octree.hpp"
+#include "cubexx/octree.hpp"
+#include "cubexx/octree_traversal.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <limits>
+
+
+namespace cubexx{
+
+///A ray; the points `origin + t*direction` for `t >= 0`. The direction need not be normalized.
+struct ray_t
+{
+  std::array<float, 3> origin;
+  std::array<float, 3> direction;
+};
+
+///The first leaf a ray hits, as returned by raycast().
+template<typename tree_t>
+struct ray_hit_t
+{
+  typedef typename octree_traversal_t<tree_t>::node_type node_type;
+
+  ///Whether the ray hit a leaf at all; if not, the rest is meaningless.
+  bool hit;
+  node_type node;
+  ///The ray parameters where the ray enters and leaves the leaf; @p t_entry is 0 if the origin is inside it.
+  float t_entry, t_exit;
+  ///The face of the leaf that the ray enters through; null if the origin is inside the leaf.
+  face_t face;
+};
+
+///@name Raycasting
+///Front-to-back traversal of an octree whose root cell is the cube of side @p size with its lowest corner at
+/// @p lower, with the parametric algorithm of Revelles et al.
+///
+///The ray is mirrored so that its direction is positive on every axis; the sign mask (a bit per negative axis)
+/// is then XOR-ed into each child's corner_t::index(), which is bit-per-axis, to get the child in the actual tree.
+/// Each node's entry and exit parameters on the three axes are halved into its children's, and only the children
+/// whose intervals are not empty, and that are present (see octree_traversal_t::children()), are visited.
+///@{
+
+/**
+ * @brief Calls `visitor(node, t_entry, t_exit, face)` for each leaf that the ray passes through, front to back,
+ *          until it returns true.
+ *
+ * The arguments are as in ray_hit_t.
+ */
+template<typename tree_t, typename visitor_t>
+void raycast_visit(const tree_t& tree, const std::array<float, 3>& lower, float size, const ray_t& ray,
+                   visitor_t&& visitor);
+
+///The first leaf that the ray hits.
+template<typename tree_t>
+ray_hit_t<tree_t> raycast(const tree_t& tree, const std::array<float, 3>& lower, float size, const ray_t& ray);
+
+/**
+ * @brief raycast() for a packet of @p Width (4 or 8) rays at once.
+ *
+ * The rays that share the first ray's sign mask go down the tree together, with their entry and exit parameters
+ * in SSE lanes (AVX for 8 rays, when the target has it): each child is tested for all of them at once, and skipped
+ * unless one of the rays still looking for a hit passes through it. Rays going some other way are traced one at a
+ * time with raycast(), so this pays off for coherent packets (e.g. a tile of neighboring pixels), not random rays.
+ */
+template<std::size_t Width, typename tree_t>
+void raycast_packet(const tree_t& tree, const std::array<float, 3>& lower, float size, const ray_t* rays,
+                    ray_hit_t<tree_t>* hits);
+///@}
+
+} // namespace cubexx
+
+#include "cubexx/detail/raycast.inl.hpp"
+
+#endif // CORNER_CASES_CUBEXX_RAYCAST_HPP
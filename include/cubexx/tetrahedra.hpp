@@ -0,0 +1,105 @@
+/*
+    Copyright (c) 2012 Azriel Fasten azriel.fasten@gmail.com
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef CORNER_CASES_CUBEXX_TETRAHEDRA_HPP
+#define CORNER_CASES_CUBEXX_TETRAHEDRA_HPP
+
+#include "cubexx/cubexx.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+
+namespace cubexx{
+
+///A tetrahedron within the cube, by its 4 corners.
+typedef std::array<corner_t, 4> tetrahedron_t;
+
+///@name Decompositions
+/**
+ * Both decompositions are computed at compile time from the corner_t numbering, and every tetrahedron is
+ * positively oriented: seen from its first corner, the other three wind counter-clockwise (the determinant of
+ * the edges from the first corner to the others is positive).
+ */
+///@{
+
+/**
+ * @brief The 6 tetrahedra around the diagonal from @p corner to `corner.opposite()`; each one follows a path of
+ *          3 cube edges from @p corner to the opposite corner, one along each axis.
+ *
+ * Each face of the cube is split by the diagonal through @p corner or the opposite corner; so cells all split
+ * the same way conform to each other.
+ */
+constexpr std::array<tetrahedron_t, 6> six_tetrahedra(const corner_t& corner);
+/**
+ * @brief The 5 tetrahedra of the alternating split: the central tetrahedron on the 4 corners of one parity (the
+ *          number of upper coordinates is odd if @p odd), and one for each other corner, with its 3 neighbors.
+ *
+ * The central tetrahedron is first. Each face is split by the diagonal between the corners of the central
+ * tetrahedron's parity; so neighboring cells must alternate parities to conform, e.g. by `(x + y + z) % 2`.
+ */
+constexpr std::array<tetrahedron_t, 5> five_tetrahedra(bool odd);
+///@}
+
+///@name Marching tetrahedra
+/**
+ * A case is 4 bits, one for each corner of a tetrahedron, in its order, set if the corner is inside (below the
+ * isovalue); see tetrahedron_case(). The surface crosses the tetrahedron's edges (see tetrahedron_edge()) whose
+ * corners straddle the case, in one triangle, or two for a quadrilateral, counter-clockwise seen from outside
+ * (toward the higher values) as long as the tetrahedron is positively oriented. These tables are generated at
+ * compile time too.
+ */
+///@{
+
+///The corners, by their positions in a tetrahedron, of the @p i-th of its 6 edges.
+constexpr std::array<std::uint8_t, 2> tetrahedron_edge(std::size_t i);
+///The case of @p tetrahedron when the @p inside corners of the cube are inside.
+constexpr std::uint_fast8_t tetrahedron_case(const tetrahedron_t& tetrahedron, const corner_set_t& inside);
+///The edges of a tetrahedron crossed in case @p inside, as a bit per edge.
+constexpr std::uint_fast8_t marching_tetrahedra_edges(std::uint_fast8_t inside);
+///The number of triangles, 0 to 2, in case @p inside.
+constexpr std::size_t marching_tetrahedra_triangle_count(std::uint_fast8_t inside);
+///The @p i-th triangle in case @p inside, as 3 edges of the tetrahedron.
+constexpr std::array<std::uint8_t, 3> marching_tetrahedra_triangle(std::uint_fast8_t inside, std::size_t i);
+
+/**
+ * @brief The case of each tetrahedron of a decomposition, for each of a row of @p n cells.
+ *
+ * @p cases are the cells' cube cases (as corner_set_t::mask(); see marching_cubes_classify_row()), and the case of
+ * tetrahedron `t` of cell `x` is written to `tetrahedron_cases[t*n + x]`.
+ *
+ * With SSE2, 16 cells at a time: each corner's bit is tested in all 16 cube cases at once, and moved to the
+ * corner's position in the tetrahedron.
+ */
+template<std::size_t N>
+void marching_tetrahedra_classify_row(const std::uint8_t* cases, std::size_t n,
+                                      const std::array<tetrahedron_t, N>& tetrahedra, std::uint8_t* tetrahedron_cases);
+///@}
+
+} // namespace cubexx
+
+#include "cubexx/detail/tetrahedra.inl.hpp"
+
+#endif // CORNER_CASES_CUBEXX_TETRAHEDRA_HPP
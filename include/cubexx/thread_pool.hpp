@@ -0,0 +1,98 @@
+/*
+    Copyright (c) 2012 Azriel Fasten azriel.fasten@gmail.com
+
+    Permission is hereby granted, free of charge, to any person
+    obtaining a copy of this software and associated documentation
+    files (the "Software"), to deal in the Software without
+    restriction, including without limitation the rights to use,
+    copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following
+    conditions:
+
+    The above copyright notice and this permission notice shall be
+    included in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+    EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+    OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+    NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+    HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+    OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef CORNER_CASES_CUBEXX_THREAD_POOL_HPP
+#define CORNER_CASES_CUBEXX_THREAD_POOL_HPP
+
+#include "cubexx/cubexx.hpp"
+
+#include <cstddef>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace cubexx{
+
+/**
+ * @class thread_pool_t
+ * @brief A fixed set of std::thread workers, for running data-parallel jobs (see run()).
+ *
+ * A job is a number of tasks, indexed from 0; the workers and the calling thread take tasks from a shared
+ * atomic counter until there are none left, so tasks of uneven cost still balance. One job runs at a time,
+ * and run() returns only when every task of it has finished. Jobs must not call run() on the same pool.
+ *
+ * The workers sleep on a condition variable between jobs.
+ */
+struct thread_pool_t
+{
+  ///A pool of @p threads threads in all, counting the thread calling run(); 0 means one per hardware thread.
+  explicit thread_pool_t(std::size_t threads = 0);
+  ~thread_pool_t();
+
+  thread_pool_t(const thread_pool_t&) = delete;
+  thread_pool_t& operator=(const thread_pool_t&) = delete;
+
+  ///The number of threads that work on a job, counting the thread calling run().
+  std::size_t size() const;
+
+  ///Calls `task(i)` for each `i` in `[0, n)`, spread over the pool; returns when all the calls have returned.
+  template<typename function_t>
+  void run(std::size_t n, const function_t& task);
+
+private:
+  ///Runs tasks of the current job until there are none left.
+  void drain(void (*invoke)(const void*, std::size_t), const void* task, std::size_t n);
+  ///The body of each worker thread.
+  void work();
+
+  std::vector<std::thread> mthreads;
+
+  std::mutex mmutex;
+  ///Signalled when a job starts, or the pool is destroyed.
+  std::condition_variable mstart;
+  ///Signalled when the last worker leaves a job.
+  std::condition_variable mfinish;
+
+  ///The current job, type-erased; null between jobs.
+  void (*minvoke)(const void*, std::size_t);
+  const void* mtask;
+  std::size_t msize;
+  ///Counts jobs, so that a worker can tell a new one from one it has already worked on.
+  std::size_t mgeneration;
+  ///The number of workers inside the current job.
+  std::size_t mactive;
+  bool mstop;
+
+  ///The next task of the current job to hand out.
+  std::atomic<std::size_t> mnext;
+};
+
+} // namespace cubexx
+
+#include "cubexx/detail/thread_pool.inl.hpp"
+
+#endif // CORNER_CASES_CUBEXX_THREAD_POOL_HPP
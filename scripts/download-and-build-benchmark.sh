@@ -0,0 +1,42 @@
+#!/bin/bash
+
+#####################################################################
+####Run this from the project root directory
+####This script will delete the library if it is already in the libs directory.
+#####################################################################
+
+
+#exit on failed line
+set -exv
+
+PROJECT_PATH=$PWD
+
+
+
+
+
+
+#############################################################################
+## get/build google benchmark
+#############################################################################
+
+
+cd "$PROJECT_PATH"
+cd libs
+
+mkdir -p benchmark && cd benchmark
+
+rm -rf ./benchmark/
+git clone https://github.com/google/benchmark.git
+cd benchmark
+git checkout "v1.7.1"
+
+mkdir -p build
+cd build
+
+cmake -G"$CMAKE_GENERATOR" ..
+cmake . -DCMAKE_BUILD_TYPE="$CMAKE_BUILD_TYPE"
+cmake . -DBENCHMARK_ENABLE_TESTING=OFF
+cmake . -DCMAKE_VERBOSE_MAKEFILE=1
+cmake --build .
+
@@ -0,0 +1,71 @@
+#ifndef CORNER_CASES_BENCHMARKS_BENCHMARKS_COMMON_HPP
+#define CORNER_CASES_BENCHMARKS_BENCHMARKS_COMMON_HPP
+
+#include "benchmark/benchmark.h"
+
+#include <vector>
+#include <random>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Shared scaffolding for cubexx-benchmarks and cubelib-benchmarks.
+ *
+ * Every benchmark runs one query over INPUT_SIZE pseudo-random inputs (with a fixed seed),
+ * so that the compiler cannot fold the query into a constant, and the branch predictor
+ * cannot learn a single answer. Items processed are reported per query.
+ */
+namespace corner_cases_benchmarks{
+
+static const std::size_t INPUT_SIZE = 4096;
+
+///@p INPUT_SIZE pseudo-random values in `[0, bound)`; the same @p seed gives the same values.
+inline std::vector<std::size_t> random_indices(std::size_t bound, unsigned seed)
+{
+  std::mt19937 generator(seed);
+  std::uniform_int_distribution<std::size_t> distribution(0, bound - 1);
+
+  std::vector<std::size_t> result(INPUT_SIZE);
+  for (auto& index : result)
+    index = distribution(generator);
+  return result;
+}
+
+///Maps each of @p indices through @p f.
+template<typename F>
+inline auto map_indices(const std::vector<std::size_t>& indices, F f)
+  -> std::vector<decltype(f(std::size_t(0)))>
+{
+  std::vector<decltype(f(std::size_t(0)))> result;
+  result.reserve(indices.size());
+  for (auto index : indices)
+    result.push_back(f(index));
+  return result;
+}
+
+///Runs @p f over the i-th element of every input sequence, for every i.
+template<typename F, typename... Inputs>
+inline void run_over(benchmark::State& state, F f, const std::vector<Inputs>&... inputs)
+{
+  for (auto _ : state)
+  {
+    for (std::size_t i = 0; i < INPUT_SIZE; ++i)
+    {
+      auto result = f(inputs[i]...);
+      benchmark::DoNotOptimize(result);
+    }
+  }
+  state.SetItemsProcessed(std::int64_t(state.iterations()) * std::int64_t(INPUT_SIZE));
+}
+
+} // namespace corner_cases_benchmarks
+
+///Defines and registers a benchmark called @p name; the rest of the arguments are passed to run_over().
+#define CORNER_CASES_BENCHMARK(name, ...)                                   \
+  static void name(benchmark::State& state)                                 \
+  {                                                                         \
+    corner_cases_benchmarks::run_over(state, __VA_ARGS__);                  \
+  }                                                                         \
+  BENCHMARK(name)
+
+#endif // CORNER_CASES_BENCHMARKS_BENCHMARKS_COMMON_HPP
@@ -0,0 +1,414 @@
+#include "cubelib/cubelib.h"
+#include "cubelib/batch.h"
+#include "cubelib/packed.h"
+
+#include "benchmarks/benchmarks-common.hpp"
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Benchmarks for every public cubelib query. Each `cubelib_calc_*` function is registered right
+ * next to its `cubelib_get_*` (table) counterpart, so the two show up side by side in the output.
+ */
+
+using corner_cases_benchmarks::random_indices;
+using corner_cases_benchmarks::map_indices;
+
+namespace {
+
+const std::vector<std::size_t> corner_indices = random_indices(8, 1);
+const std::vector<std::size_t> direction_indices = random_indices(6, 2);
+const std::vector<std::size_t> edge_indices = random_indices(12, 3);
+const std::vector<std::size_t> face_indices = random_indices(6, 4);
+
+const std::vector<cubelib_corner_t> corners
+  = map_indices(corner_indices, [](std::size_t i){ return cubelib_get_corner_by_index(i); });
+const std::vector<cubelib_corner_t> other_corners
+  = map_indices(random_indices(8, 5), [](std::size_t i){ return cubelib_get_corner_by_index(i); });
+const std::vector<cubelib_direction_t> directions
+  = map_indices(direction_indices, [](std::size_t i){ return cubelib_get_direction_by_index(i); });
+const std::vector<cubelib_edge_t> edges
+  = map_indices(edge_indices, [](std::size_t i){ return cubelib_get_edge_by_index(i); });
+const std::vector<cubelib_edge_t> other_edges
+  = map_indices(random_indices(12, 6), [](std::size_t i){ return cubelib_get_edge_by_index(i); });
+const std::vector<cubelib_face_t> faces
+  = map_indices(face_indices, [](std::size_t i){ return cubelib_get_face_by_index(i); });
+const std::vector<std::size_t> axes = random_indices(3, 7);
+const std::vector<std::size_t> pair_indices = random_indices(2, 8);
+const std::vector<std::size_t> quad_indices = random_indices(4, 9);
+const std::vector<int> signs
+  = map_indices(random_indices(2, 10), [](std::size_t i){ return i ? +1 : -1; });
+const std::vector<int> other_signs
+  = map_indices(random_indices(2, 11), [](std::size_t i){ return i ? +1 : -1; });
+const std::vector<int> third_signs
+  = map_indices(random_indices(2, 12), [](std::size_t i){ return i ? +1 : -1; });
+const std::vector<float> floats
+  = map_indices(random_indices(2001, 13), [](std::size_t i){ return float(i) / 1000.f - 1.f; });
+
+///Corners adjacent to the corresponding entry of corners.
+const std::vector<cubelib_corner_t> adjacent_corners = [](){
+  std::vector<cubelib_corner_t> result;
+  for (std::size_t i = 0; i < corners.size(); ++i)
+    result.push_back(cubelib_calc_cnr_adj_cnr(corners[i], axes[i]));
+  return result;
+}();
+
+///Directions from the corresponding entry of corners towards adjacent_corners.
+const std::vector<cubelib_direction_t> inward_directions = [](){
+  std::vector<cubelib_direction_t> result;
+  for (std::size_t i = 0; i < corners.size(); ++i)
+  {
+    int sign = cubelib_get_corner_ui(corners[i], axes[i]) ? -1 : +1;
+    result.push_back(cubelib_get_direction_by_int3(axes[i] == 0 ? sign : 0, axes[i] == 1 ? sign : 0, axes[i] == 2 ? sign : 0));
+  }
+  return result;
+}();
+
+///Directions along the axes.
+const std::vector<cubelib_direction_t> axis_directions
+  = map_indices(axes, [](std::size_t axis){
+      return cubelib_get_direction_by_int3(axis == 0, axis == 1, axis == 2);
+    });
+
+///The raw values of the above, for the batch API.
+template<typename T>
+std::vector<std::uint8_t> values_of(const std::vector<T>& elements)
+{
+  std::vector<std::uint8_t> result;
+  for (auto element : elements)
+    result.push_back(std::uint8_t(element.value));
+  return result;
+}
+const std::vector<std::uint8_t> corner_values = values_of(corners);
+const std::vector<std::uint8_t> adjacent_corner_values = values_of(adjacent_corners);
+const std::vector<std::uint8_t> direction_values = values_of(directions);
+const std::vector<std::uint8_t> edge_values = values_of(edges);
+const std::vector<float> other_floats
+  = map_indices(random_indices(2001, 14), [](std::size_t i){ return float(i) / 1000.f - 1.f; });
+const std::vector<float> third_floats
+  = map_indices(random_indices(2001, 15), [](std::size_t i){ return float(i) / 1000.f - 1.f; });
+
+///Runs a batch function over all INPUT_SIZE inputs at once; @p args are the arrays, followed by the result.
+template<typename F, typename... Args>
+void run_batch(benchmark::State& state, F f, Args... args)
+{
+  std::vector<std::uint8_t> result(corner_cases_benchmarks::INPUT_SIZE);
+  for (auto _ : state)
+  {
+    f(args..., result.data(), corner_cases_benchmarks::INPUT_SIZE);
+    benchmark::DoNotOptimize(result.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(std::int64_t(state.iterations()) * std::int64_t(corner_cases_benchmarks::INPUT_SIZE));
+}
+
+} // namespace
+
+
+/* -------------------------------------------------------------------------- */
+/* corner                                                                     */
+/* -------------------------------------------------------------------------- */
+
+CORNER_CASES_BENCHMARK(BM_cubelib_is_corner_valid,
+  [](cubelib_corner_t c){ return cubelib_is_corner_valid(c); }, corners);
+CORNER_CASES_BENCHMARK(BM_cubelib_is_corner_null,
+  [](cubelib_corner_t c){ return cubelib_is_corner_null(c); }, corners);
+CORNER_CASES_BENCHMARK(BM_cubelib_is_corner_equal,
+  [](cubelib_corner_t a, cubelib_corner_t b){ return cubelib_is_corner_equal(a, b); }, corners, other_corners);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_corner_x,
+  [](cubelib_corner_t c){ return cubelib_get_corner_x(c); }, corners);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_corner_y,
+  [](cubelib_corner_t c){ return cubelib_get_corner_y(c); }, corners);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_corner_z,
+  [](cubelib_corner_t c){ return cubelib_get_corner_z(c); }, corners);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_corner_i,
+  [](cubelib_corner_t c, std::size_t dim){ return cubelib_get_corner_i(c, dim); }, corners, axes);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_corner_ux,
+  [](cubelib_corner_t c){ return cubelib_get_corner_ux(c); }, corners);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_corner_uy,
+  [](cubelib_corner_t c){ return cubelib_get_corner_uy(c); }, corners);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_corner_uz,
+  [](cubelib_corner_t c){ return cubelib_get_corner_uz(c); }, corners);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_corner_ui,
+  [](cubelib_corner_t c, std::size_t dim){ return cubelib_get_corner_ui(c, dim); }, corners, axes);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_corner_by_float3,
+  [](float x, float y, float z){ return cubelib_get_corner_by_float3(x, y, z); },
+  floats, floats, floats);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_corner_by_int3,
+  [](int x, int y, int z){ return cubelib_get_corner_by_int3(x, y, z); },
+  signs, other_signs, third_signs);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_corner_index,
+  [](cubelib_corner_t c){ return cubelib_get_corner_index(c); }, corners);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_corner_by_index,
+  [](std::size_t i){ return cubelib_get_corner_by_index(i); }, corner_indices);
+CORNER_CASES_BENCHMARK(BM_cubelib_calc_opposite_corner,
+  [](cubelib_corner_t c){ return cubelib_calc_opposite_corner(c); }, corners);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_opposite_corner,
+  [](cubelib_corner_t c){ return cubelib_get_opposite_corner(c); }, corners);
+
+CORNER_CASES_BENCHMARK(BM_cubelib_calc_adjacent_corner,
+  [](cubelib_corner_t c, cubelib_direction_t d){ return cubelib_calc_adjacent_corner(c, d); },
+  corners, directions);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_adjacent_corner,
+  [](cubelib_corner_t c, cubelib_direction_t d){ return cubelib_get_adjacent_corner(c, d); },
+  corners, directions);
+
+CORNER_CASES_BENCHMARK(BM_cubelib_calc_corner_move,
+  [](cubelib_corner_t c, cubelib_direction_t d){ return cubelib_calc_corner_move(c, d); }, corners, directions);
+CORNER_CASES_BENCHMARK(BM_cubelib_corner_move,
+  [](cubelib_corner_t c, cubelib_direction_t d){ return cubelib_corner_move(c, d); }, corners, directions);
+CORNER_CASES_BENCHMARK(BM_cubelib_calc_corner_push,
+  [](cubelib_corner_t c, cubelib_direction_t d){ return cubelib_calc_corner_push(c, d); }, corners, directions);
+CORNER_CASES_BENCHMARK(BM_cubelib_corner_push,
+  [](cubelib_corner_t c, cubelib_direction_t d){ return cubelib_corner_push(c, d); }, corners, directions);
+
+CORNER_CASES_BENCHMARK(BM_cubelib_calc_is_corner_adjacent_corner,
+  [](cubelib_corner_t a, cubelib_corner_t b){ return cubelib_calc_is_corner_adjacent_corner(a, b); },
+  corners, other_corners);
+CORNER_CASES_BENCHMARK(BM_cubelib_is_corner_adjacent_corner,
+  [](cubelib_corner_t a, cubelib_corner_t b){ return cubelib_is_corner_adjacent_corner(a, b); },
+  corners, other_corners);
+
+CORNER_CASES_BENCHMARK(BM_cubelib_calc_cnr_adj_cnr,
+  [](cubelib_corner_t c, std::size_t dim){ return cubelib_calc_cnr_adj_cnr(c, dim); }, corners, axes);
+CORNER_CASES_BENCHMARK(BM_cubelib_cnr_adj_cnrs_table,
+  [](cubelib_corner_t c, std::size_t dim){ return cubelib_cnr_adj_cnrs[cubelib_get_corner_index(c)][dim]; },
+  corners, axes);
+
+
+/* -------------------------------------------------------------------------- */
+/* direction                                                                  */
+/* -------------------------------------------------------------------------- */
+
+CORNER_CASES_BENCHMARK(BM_cubelib_is_direction_valid,
+  [](cubelib_direction_t d){ return cubelib_is_direction_valid(d); }, directions);
+CORNER_CASES_BENCHMARK(BM_cubelib_is_direction_null,
+  [](cubelib_direction_t d){ return cubelib_is_direction_null(d); }, directions);
+CORNER_CASES_BENCHMARK(BM_cubelib_is_direction_equal,
+  [](cubelib_direction_t a, cubelib_direction_t b){ return cubelib_is_direction_equal(a, b); },
+  directions, axis_directions);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_direction_x,
+  [](cubelib_direction_t d){ return cubelib_get_direction_x(d); }, directions);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_direction_y,
+  [](cubelib_direction_t d){ return cubelib_get_direction_y(d); }, directions);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_direction_z,
+  [](cubelib_direction_t d){ return cubelib_get_direction_z(d); }, directions);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_direction_i,
+  [](cubelib_direction_t d, std::size_t dim){ return cubelib_get_direction_i(d, dim); }, directions, axes);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_direction_absx,
+  [](cubelib_direction_t d){ return cubelib_get_direction_absx(d); }, directions);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_direction_absy,
+  [](cubelib_direction_t d){ return cubelib_get_direction_absy(d); }, directions);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_direction_absz,
+  [](cubelib_direction_t d){ return cubelib_get_direction_absz(d); }, directions);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_direction_absi,
+  [](cubelib_direction_t d, std::size_t dim){ return cubelib_get_direction_absi(d, dim); }, directions, axes);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_direction_sigdim,
+  [](cubelib_direction_t d){ return cubelib_get_direction_sigdim(d); }, directions);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_direction_index,
+  [](cubelib_direction_t d){ return cubelib_get_direction_index(d); }, directions);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_direction_by_index,
+  [](std::size_t i){ return cubelib_get_direction_by_index(i); }, direction_indices);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_direction_by_int3,
+  [](std::size_t axis, int sign){
+    return cubelib_get_direction_by_int3(axis == 0 ? sign : 0, axis == 1 ? sign : 0, axis == 2 ? sign : 0);
+  }, axes, signs);
+CORNER_CASES_BENCHMARK(BM_cubelib_calc_opposite_direction,
+  [](cubelib_direction_t d){ return cubelib_calc_opposite_direction(d); }, directions);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_opposite_direction,
+  [](cubelib_direction_t d){ return cubelib_get_opposite_direction(d); }, directions);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_direction_face,
+  [](cubelib_direction_t d){ return cubelib_get_direction_face(d); }, directions);
+
+
+/* -------------------------------------------------------------------------- */
+/* edge                                                                       */
+/* -------------------------------------------------------------------------- */
+
+CORNER_CASES_BENCHMARK(BM_cubelib_is_edge_valid,
+  [](cubelib_edge_t e){ return cubelib_is_edge_valid(e); }, edges);
+CORNER_CASES_BENCHMARK(BM_cubelib_is_edge_null,
+  [](cubelib_edge_t e){ return cubelib_is_edge_null(e); }, edges);
+CORNER_CASES_BENCHMARK(BM_cubelib_is_edge_equal,
+  [](cubelib_edge_t a, cubelib_edge_t b){ return cubelib_is_edge_equal(a, b); },
+  edges, other_edges);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_edge_by_axis,
+  [](std::size_t axis, int s, int t){ return cubelib_get_edge_by_axis(axis, s > 0, t > 0); },
+  axes, signs, other_signs);
+
+CORNER_CASES_BENCHMARK(BM_cubelib_calc_edge_by_corner_direction,
+  [](cubelib_corner_t c, cubelib_direction_t d){ return cubelib_calc_edge_by_corner_direction(c, d); },
+  corners, inward_directions);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_edge_by_corner_direction,
+  [](cubelib_corner_t c, cubelib_direction_t d){ return cubelib_get_edge_by_corner_direction(c, d); },
+  corners, inward_directions);
+
+CORNER_CASES_BENCHMARK(BM_cubelib_calc_edge_by_corners,
+  [](cubelib_corner_t a, cubelib_corner_t b){ return cubelib_calc_edge_by_corners(a, b); },
+  corners, adjacent_corners);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_edge_by_corners,
+  [](cubelib_corner_t a, cubelib_corner_t b){ return cubelib_get_edge_by_corners(a, b); },
+  corners, adjacent_corners);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_edge_by_index,
+  [](std::size_t i){ return cubelib_get_edge_by_index(i); }, edge_indices);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_edge_index,
+  [](cubelib_edge_t e){ return cubelib_get_edge_index(e); }, edges);
+
+CORNER_CASES_BENCHMARK(BM_cubelib_calc_opposite_edge,
+  [](cubelib_edge_t e){ return cubelib_calc_opposite_edge(e); }, edges);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_opposite_edge,
+  [](cubelib_edge_t e){ return cubelib_get_opposite_edge(e); }, edges);
+CORNER_CASES_BENCHMARK(BM_cubelib_calc_edge_corner0,
+  [](cubelib_edge_t e){ return cubelib_calc_edge_corner0(e); }, edges);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_edge_corner0,
+  [](cubelib_edge_t e){ return cubelib_get_edge_corner0(e); }, edges);
+CORNER_CASES_BENCHMARK(BM_cubelib_calc_edge_corner1,
+  [](cubelib_edge_t e){ return cubelib_calc_edge_corner1(e); }, edges);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_edge_corner1,
+  [](cubelib_edge_t e){ return cubelib_get_edge_corner1(e); }, edges);
+CORNER_CASES_BENCHMARK(BM_cubelib_calc_edge_direction,
+  [](cubelib_edge_t e){ return cubelib_calc_edge_direction(e); }, edges);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_edge_direction,
+  [](cubelib_edge_t e){ return cubelib_get_edge_direction(e); }, edges);
+
+CORNER_CASES_BENCHMARK(BM_cubelib_calc_edge_base_axis,
+  [](cubelib_edge_t e){ return cubelib_calc_edge_base_axis(e); }, edges);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_edge_base_axis,
+  [](cubelib_edge_t e){ return cubelib_get_edge_base_axis(e); }, edges);
+CORNER_CASES_BENCHMARK(BM_cubelib_calc_edge_secondary_axis,
+  [](cubelib_edge_t e){ return cubelib_calc_edge_secondary_axis(e); }, edges);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_edge_secondary_axis,
+  [](cubelib_edge_t e){ return cubelib_get_edge_secondary_axis(e); }, edges);
+CORNER_CASES_BENCHMARK(BM_cubelib_calc_edge_tertiary_axis,
+  [](cubelib_edge_t e){ return cubelib_calc_edge_tertiary_axis(e); }, edges);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_edge_tertiary_axis,
+  [](cubelib_edge_t e){ return cubelib_get_edge_tertiary_axis(e); }, edges);
+
+CORNER_CASES_BENCHMARK(BM_cubelib_is_edge_projected_secondary,
+  [](cubelib_edge_t e){ return cubelib_is_edge_projected_secondary(e); }, edges);
+CORNER_CASES_BENCHMARK(BM_cubelib_is_edge_projected_tertiary,
+  [](cubelib_edge_t e){ return cubelib_is_edge_projected_tertiary(e); }, edges);
+
+CORNER_CASES_BENCHMARK(BM_cubelib_calc_edge_push,
+  [](cubelib_edge_t e, cubelib_direction_t d){ return cubelib_calc_edge_push(e, d); }, edges, directions);
+CORNER_CASES_BENCHMARK(BM_cubelib_edge_push,
+  [](cubelib_edge_t e, cubelib_direction_t d){ return cubelib_edge_push(e, d); }, edges, directions);
+
+CORNER_CASES_BENCHMARK(BM_cubelib_calc_face_on_edge,
+  [](cubelib_edge_t e, std::size_t i){ return cubelib_calc_face_on_edge(e, i); }, edges, pair_indices);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_face_on_edge,
+  [](cubelib_edge_t e, std::size_t i){ return cubelib_get_face_on_edge(e, i); }, edges, pair_indices);
+CORNER_CASES_BENCHMARK(BM_cubelib_calc_is_face_on_edge,
+  [](cubelib_face_t f, cubelib_edge_t e){ return cubelib_calc_is_face_on_edge(f, e); }, faces, edges);
+CORNER_CASES_BENCHMARK(BM_cubelib_is_face_on_edge,
+  [](cubelib_face_t f, cubelib_edge_t e){ return cubelib_is_face_on_edge(f, e); }, faces, edges);
+
+
+/* -------------------------------------------------------------------------- */
+/* face                                                                       */
+/* -------------------------------------------------------------------------- */
+
+CORNER_CASES_BENCHMARK(BM_cubelib_is_face_valid,
+  [](cubelib_face_t f){ return cubelib_is_face_valid(f); }, faces);
+CORNER_CASES_BENCHMARK(BM_cubelib_is_face_null,
+  [](cubelib_face_t f){ return cubelib_is_face_null(f); }, faces);
+CORNER_CASES_BENCHMARK(BM_cubelib_is_face_equal,
+  [](cubelib_face_t a, cubelib_direction_t d){ return cubelib_is_face_equal(a, cubelib_get_direction_face(d)); },
+  faces, directions);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_face_by_index,
+  [](std::size_t i){ return cubelib_get_face_by_index(i); }, face_indices);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_face_index,
+  [](cubelib_face_t f){ return cubelib_get_face_index(f); }, faces);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_face_direction,
+  [](cubelib_face_t f){ return cubelib_get_face_direction(f); }, faces);
+
+CORNER_CASES_BENCHMARK(BM_cubelib_calc_edge_on_face,
+  [](cubelib_face_t f, std::size_t i){ return cubelib_calc_edge_on_face(f, i); }, faces, quad_indices);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_edge_on_face,
+  [](cubelib_face_t f, std::size_t i){ return cubelib_get_edge_on_face(f, i); }, faces, quad_indices);
+CORNER_CASES_BENCHMARK(BM_cubelib_is_edge_on_face,
+  [](cubelib_edge_t e, cubelib_face_t f){ return cubelib_is_edge_on_face(e, f); }, edges, faces);
+
+CORNER_CASES_BENCHMARK(BM_cubelib_calc_corner_on_face,
+  [](cubelib_face_t f, std::size_t i){ return cubelib_calc_corner_on_face(f, i); }, faces, quad_indices);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_corner_on_face,
+  [](cubelib_face_t f, std::size_t i){ return cubelib_get_corner_on_face(f, i); }, faces, quad_indices);
+CORNER_CASES_BENCHMARK(BM_cubelib_calc_is_corner_on_face,
+  [](cubelib_corner_t c, cubelib_face_t f){ return cubelib_calc_is_corner_on_face(c, f); }, corners, faces);
+CORNER_CASES_BENCHMARK(BM_cubelib_is_corner_on_face,
+  [](cubelib_corner_t c, cubelib_face_t f){ return cubelib_is_corner_on_face(c, f); }, corners, faces);
+
+
+/* -------------------------------------------------------------------------- */
+/* batch                                                                      */
+/* -------------------------------------------------------------------------- */
+
+///Registers the scalar, SSE4.2, AVX2 and dispatching flavours of a batch function, skipping the ones the CPU lacks.
+#ifdef CUBELIB_BATCH_HAS_X86_SIMD
+#define CUBELIB_BATCH_BENCHMARK(name, ...)                                                          \
+  static void BM_##name##_scalar(benchmark::State& state) { run_batch(state, &name##_scalar, __VA_ARGS__); } \
+  BENCHMARK(BM_##name##_scalar);                                                                  \
+  static void BM_##name##_sse42(benchmark::State& state)                                          \
+  {                                                                                               \
+    if (cubelib_batch_isa() < CUBELIB_BATCH_ISA_SSE42) { state.SkipWithError("no SSE4.2"); return; } \
+    run_batch(state, &name##_sse42, __VA_ARGS__);                                                 \
+  }                                                                                               \
+  BENCHMARK(BM_##name##_sse42);                                                                   \
+  static void BM_##name##_avx2(benchmark::State& state)                                           \
+  {                                                                                               \
+    if (cubelib_batch_isa() < CUBELIB_BATCH_ISA_AVX2) { state.SkipWithError("no AVX2"); return; } \
+    run_batch(state, &name##_avx2, __VA_ARGS__);                                                  \
+  }                                                                                               \
+  BENCHMARK(BM_##name##_avx2);                                                                    \
+  static void BM_##name(benchmark::State& state) { run_batch(state, &name, __VA_ARGS__); }        \
+  BENCHMARK(BM_##name)
+#else
+#define CUBELIB_BATCH_BENCHMARK(name, ...)                                                          \
+  static void BM_##name##_scalar(benchmark::State& state) { run_batch(state, &name##_scalar, __VA_ARGS__); } \
+  BENCHMARK(BM_##name##_scalar);                                                                  \
+  static void BM_##name(benchmark::State& state) { run_batch(state, &name, __VA_ARGS__); }        \
+  BENCHMARK(BM_##name)
+#endif
+
+CUBELIB_BATCH_BENCHMARK(cubelib_get_opposite_corner_n, corner_values.data());
+CUBELIB_BATCH_BENCHMARK(cubelib_get_adjacent_corner_n, corner_values.data(), direction_values.data());
+CUBELIB_BATCH_BENCHMARK(cubelib_corner_move_n, corner_values.data(), direction_values.data());
+CUBELIB_BATCH_BENCHMARK(cubelib_get_edge_by_corners_n, corner_values.data(), adjacent_corner_values.data());
+CUBELIB_BATCH_BENCHMARK(cubelib_get_opposite_edge_n, edge_values.data());
+CUBELIB_BATCH_BENCHMARK(cubelib_get_corner_by_float3_n, floats.data(), other_floats.data(), third_floats.data());
+
+
+/* -------------------------------------------------------------------------- */
+/* packed                                                                     */
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+///corner_values, packed; a corner's value is its index.
+std::vector<std::uint8_t> packed_corners(std::uint_fast8_t bits)
+{
+  std::vector<std::uint8_t> result(CUBELIB_PACKED_BYTES(corner_values.size(), bits));
+  if (bits == 3)
+    cubelib_packed3_pack_n(corner_values.data(), result.data(), corner_values.size());
+  else
+    cubelib_packed4_pack_n(corner_values.data(), result.data(), corner_values.size());
+  return result;
+}
+const std::vector<std::uint8_t> packed4_corners = packed_corners(4);
+const std::vector<std::uint8_t> packed3_corners = packed_corners(3);
+
+} // namespace
+
+static void BM_cubelib_packed4_pack_n(benchmark::State& state) { run_batch(state, &cubelib_packed4_pack_n, corner_values.data()); }
+BENCHMARK(BM_cubelib_packed4_pack_n);
+static void BM_cubelib_packed4_unpack_n(benchmark::State& state) { run_batch(state, &cubelib_packed4_unpack_n, packed4_corners.data()); }
+BENCHMARK(BM_cubelib_packed4_unpack_n);
+static void BM_cubelib_packed3_pack_n(benchmark::State& state) { run_batch(state, &cubelib_packed3_pack_n, corner_values.data()); }
+BENCHMARK(BM_cubelib_packed3_pack_n);
+static void BM_cubelib_packed3_unpack_n(benchmark::State& state) { run_batch(state, &cubelib_packed3_unpack_n, packed3_corners.data()); }
+BENCHMARK(BM_cubelib_packed3_unpack_n);
+
+
+BENCHMARK_MAIN();
@@ -0,0 +1,1103 @@
+#include "cubexx/cubexx.hpp"
+#include "cubexx/packed.hpp"
+#include "cubexx/morton.hpp"
+#include "cubexx/linear_octree.hpp"
+#include "cubexx/octree.hpp"
+#include "cubexx/octree_builder.hpp"
+#include "cubexx/raycast.hpp"
+#include "cubexx/culling.hpp"
+#include "cubexx/balance.hpp"
+#include "cubexx/marching_cubes.hpp"
+#include "cubexx/cube_symmetry.hpp"
+#include "cubexx/canonicalize.hpp"
+#include "cubexx/grid_index.hpp"
+#include "cubexx/isosurface.hpp"
+#include "cubexx/tetrahedra.hpp"
+#include "cubexx/asymptotic_decider.hpp"
+#include "cubexx/offset.hpp"
+#include "cubelib/cubelib.h"
+
+#include "benchmarks/benchmarks-common.hpp"
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Benchmarks for every public cubexx query, set operation and set iteration. Where cubelib has an
+ * equivalent query, it is registered right after the cubexx one (as BM_cubelib_*), on the same
+ * inputs, so the two representations show up side by side in the output.
+ */
+
+using namespace cubexx;
+using corner_cases_benchmarks::random_indices;
+using corner_cases_benchmarks::map_indices;
+
+namespace {
+
+const std::vector<std::size_t> corner_indices = random_indices(8, 1);
+const std::vector<std::size_t> direction_indices = random_indices(6, 2);
+const std::vector<std::size_t> edge_indices = random_indices(12, 3);
+const std::vector<std::size_t> face_indices = random_indices(6, 4);
+const std::vector<std::size_t> other_corner_indices = random_indices(8, 5);
+const std::vector<std::size_t> axes = random_indices(3, 7);
+const std::vector<std::size_t> pair_indices = random_indices(2, 8);
+const std::vector<std::size_t> quad_indices = random_indices(4, 9);
+const std::vector<int> signs
+  = map_indices(random_indices(2, 10), [](std::size_t i){ return i ? +1 : -1; });
+const std::vector<int> other_signs
+  = map_indices(random_indices(2, 11), [](std::size_t i){ return i ? +1 : -1; });
+const std::vector<int> third_signs
+  = map_indices(random_indices(2, 12), [](std::size_t i){ return i ? +1 : -1; });
+
+const std::vector<corner_t> corners
+  = map_indices(corner_indices, [](std::size_t i){ return corner_t::get(i); });
+const std::vector<corner_t> other_corners
+  = map_indices(other_corner_indices, [](std::size_t i){ return corner_t::get(i); });
+const std::vector<direction_t> directions
+  = map_indices(direction_indices, [](std::size_t i){ return direction_t::get(i); });
+const std::vector<edge_t> edges
+  = map_indices(edge_indices, [](std::size_t i){ return edge_t::get(i); });
+const std::vector<face_t> faces
+  = map_indices(face_indices, [](std::size_t i){ return face_t::get(i); });
+
+///Corners adjacent to the corresponding entry of corners.
+const std::vector<corner_t> adjacent_corners = [](){
+  std::vector<corner_t> result;
+  for (std::size_t i = 0; i < corners.size(); ++i)
+    result.push_back(corners[i].adjacents()[axes[i]]);
+  return result;
+}();
+///Directions from the corresponding entry of corners towards adjacent_corners.
+const std::vector<direction_t> inward_directions = [](){
+  std::vector<direction_t> result;
+  for (std::size_t i = 0; i < corners.size(); ++i)
+    result.push_back(corners[i].get_adjacent_direction(adjacent_corners[i]));
+  return result;
+}();
+///Faces touching the corresponding entry of edges.
+const std::vector<face_t> edge_faces = [](){
+  std::vector<face_t> result;
+  for (std::size_t i = 0; i < edges.size(); ++i)
+    result.push_back(edges[i].faces()[pair_indices[i]]);
+  return result;
+}();
+///Edges on the corresponding entry of faces.
+const std::vector<edge_t> face_edges = [](){
+  std::vector<edge_t> result;
+  for (std::size_t i = 0; i < faces.size(); ++i)
+    result.push_back(faces[i].edges()[quad_indices[i]]);
+  return result;
+}();
+
+const std::vector<corner_set_t> corner_sets
+  = map_indices(random_indices(256, 20), [](std::size_t mask){ return corner_set_t::from_mask(mask); });
+const std::vector<corner_set_t> other_corner_sets
+  = map_indices(random_indices(256, 21), [](std::size_t mask){ return corner_set_t::from_mask(mask); });
+const std::vector<corner_set_t> nonempty_corner_sets
+  = map_indices(random_indices(255, 22), [](std::size_t mask){ return corner_set_t::from_mask(mask + 1); });
+const std::vector<edge_set_t> edge_sets
+  = map_indices(random_indices(4096, 23), [](std::size_t mask){ return edge_set_t::from_mask(mask); });
+const std::vector<edge_set_t> other_edge_sets
+  = map_indices(random_indices(4096, 24), [](std::size_t mask){ return edge_set_t::from_mask(mask); });
+///Ranks of elements that exist in the corresponding entry of nonempty_corner_sets.
+const std::vector<std::size_t> corner_set_ranks = [](){
+  std::vector<std::size_t> result;
+  std::vector<std::size_t> randoms = random_indices(8, 25);
+  for (std::size_t i = 0; i < nonempty_corner_sets.size(); ++i)
+    result.push_back(randoms[i] % nonempty_corner_sets[i].size());
+  return result;
+}();
+
+///The cubelib equivalents of the inputs above, built from the same random indices.
+const std::vector<cubelib_corner_t> cubelib_corners
+  = map_indices(corner_indices, [](std::size_t i){ return cubelib_get_corner_by_index(i); });
+const std::vector<cubelib_corner_t> cubelib_other_corners
+  = map_indices(other_corner_indices, [](std::size_t i){ return cubelib_get_corner_by_index(i); });
+///cubexx and cubelib agree on the bits of a corner, so the indices carry over.
+const std::vector<cubelib_corner_t> cubelib_adjacent_corner_inputs = [](){
+  std::vector<cubelib_corner_t> result;
+  for (const corner_t& corner : adjacent_corners)
+    result.push_back(cubelib_get_corner_by_index(corner.index()));
+  return result;
+}();
+const std::vector<cubelib_direction_t> cubelib_inward_directions = [](){
+  std::vector<cubelib_direction_t> result;
+  for (const direction_t& direction : inward_directions)
+    result.push_back(cubelib_get_direction_by_int3(direction.x(), direction.y(), direction.z()));
+  return result;
+}();
+const std::vector<cubelib_direction_t> cubelib_directions
+  = map_indices(direction_indices, [](std::size_t i){ return cubelib_get_direction_by_index(i); });
+const std::vector<cubelib_edge_t> cubelib_edges
+  = map_indices(edge_indices, [](std::size_t i){ return cubelib_get_edge_by_index(i); });
+const std::vector<cubelib_face_t> cubelib_faces
+  = map_indices(face_indices, [](std::size_t i){ return cubelib_get_face_by_index(i); });
+
+} // namespace
+
+
+/* -------------------------------------------------------------------------- */
+/* corner                                                                     */
+/* -------------------------------------------------------------------------- */
+
+CORNER_CASES_BENCHMARK(BM_cubexx_corner_get_by_int3,
+  [](int x, int y, int z){ return corner_t::get(x, y, z); }, signs, other_signs, third_signs);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_corner_by_int3,
+  [](int x, int y, int z){ return cubelib_get_corner_by_int3(x, y, z); }, signs, other_signs, third_signs);
+
+CORNER_CASES_BENCHMARK(BM_cubexx_corner_get_by_index,
+  [](std::size_t i){ return corner_t::get(i); }, corner_indices);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_corner_by_index,
+  [](std::size_t i){ return cubelib_get_corner_by_index(i); }, corner_indices);
+
+CORNER_CASES_BENCHMARK(BM_cubexx_corner_index,
+  [](const corner_t& c){ return c.index(); }, corners);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_corner_index,
+  [](cubelib_corner_t c){ return cubelib_get_corner_index(c); }, cubelib_corners);
+
+CORNER_CASES_BENCHMARK(BM_cubexx_corner_x,
+  [](const corner_t& c){ return c.x(); }, corners);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_corner_x,
+  [](cubelib_corner_t c){ return cubelib_get_corner_x(c); }, cubelib_corners);
+
+CORNER_CASES_BENCHMARK(BM_cubexx_corner_ux,
+  [](const corner_t& c){ return c.ux(); }, corners);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_corner_ux,
+  [](cubelib_corner_t c){ return cubelib_get_corner_ux(c); }, cubelib_corners);
+
+CORNER_CASES_BENCHMARK(BM_cubexx_corner_xyz,
+  [](const corner_t& c, std::size_t dim){ return c.xyz()[dim]; }, corners, axes);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_corner_i,
+  [](cubelib_corner_t c, std::size_t dim){ return cubelib_get_corner_i(c, dim); }, cubelib_corners, axes);
+
+CORNER_CASES_BENCHMARK(BM_cubexx_corner_uxyz,
+  [](const corner_t& c, std::size_t dim){ return c.uxyz()[dim]; }, corners, axes);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_corner_ui,
+  [](cubelib_corner_t c, std::size_t dim){ return cubelib_get_corner_ui(c, dim); }, cubelib_corners, axes);
+
+CORNER_CASES_BENCHMARK(BM_cubexx_corner_opposite,
+  [](const corner_t& c){ return c.opposite(); }, corners);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_opposite_corner,
+  [](cubelib_corner_t c){ return cubelib_get_opposite_corner(c); }, cubelib_corners);
+
+CORNER_CASES_BENCHMARK(BM_cubexx_corner_adjacent,
+  [](const corner_t& c, const direction_t& d){ return c.adjacent(d); }, corners, directions);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_adjacent_corner,
+  [](cubelib_corner_t c, cubelib_direction_t d){ return cubelib_get_adjacent_corner(c, d); },
+  cubelib_corners, cubelib_directions);
+
+CORNER_CASES_BENCHMARK(BM_cubexx_corner_push,
+  [](const corner_t& c, const direction_t& d){ return c.push(d); }, corners, directions);
+CORNER_CASES_BENCHMARK(BM_cubelib_corner_push,
+  [](cubelib_corner_t c, cubelib_direction_t d){ return cubelib_corner_push(c, d); },
+  cubelib_corners, cubelib_directions);
+
+CORNER_CASES_BENCHMARK(BM_cubexx_corner_move,
+  [](const corner_t& c, const direction_t& d){ return c.move(d); }, corners, directions);
+CORNER_CASES_BENCHMARK(BM_cubelib_corner_move,
+  [](cubelib_corner_t c, cubelib_direction_t d){ return cubelib_corner_move(c, d); },
+  cubelib_corners, cubelib_directions);
+
+CORNER_CASES_BENCHMARK(BM_cubexx_corner_is_adjacent_corner,
+  [](const corner_t& a, const corner_t& b){ return a.is_adjacent(b); }, corners, other_corners);
+CORNER_CASES_BENCHMARK(BM_cubelib_is_corner_adjacent_corner,
+  [](cubelib_corner_t a, cubelib_corner_t b){ return cubelib_is_corner_adjacent_corner(a, b); },
+  cubelib_corners, cubelib_other_corners);
+
+CORNER_CASES_BENCHMARK(BM_cubexx_corner_adjacents,
+  [](const corner_t& c, std::size_t i){ return c.adjacents()[i]; }, corners, axes);
+CORNER_CASES_BENCHMARK(BM_cubelib_calc_cnr_adj_cnr,
+  [](cubelib_corner_t c, std::size_t i){ return cubelib_calc_cnr_adj_cnr(c, i); }, cubelib_corners, axes);
+
+CORNER_CASES_BENCHMARK(BM_cubexx_corner_adjacent_set,
+  [](const corner_t& c){ return c.adjacent_set(); }, corners);
+CORNER_CASES_BENCHMARK(BM_cubexx_corner_edges,
+  [](const corner_t& c, std::size_t i){ return c.edges()[i]; }, corners, axes);
+CORNER_CASES_BENCHMARK(BM_cubexx_corner_edge_set,
+  [](const corner_t& c){ return c.edge_set(); }, corners);
+CORNER_CASES_BENCHMARK(BM_cubexx_corner_faces,
+  [](const corner_t& c, std::size_t i){ return c.faces()[i]; }, corners, axes);
+CORNER_CASES_BENCHMARK(BM_cubexx_corner_face_set,
+  [](const corner_t& c){ return c.face_set(); }, corners);
+
+CORNER_CASES_BENCHMARK(BM_cubexx_corner_edge_by_direction,
+  [](const corner_t& c, const direction_t& d){ return c.edge(d); }, corners, inward_directions);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_edge_by_corner_direction,
+  [](cubelib_corner_t c, cubelib_direction_t d){ return cubelib_get_edge_by_corner_direction(c, d); },
+  cubelib_corners, cubelib_inward_directions);
+
+CORNER_CASES_BENCHMARK(BM_cubexx_corner_is_adjacent_face,
+  [](const corner_t& c, const face_t& f){ return c.is_adjacent(f); }, corners, faces);
+CORNER_CASES_BENCHMARK(BM_cubelib_is_corner_on_face,
+  [](cubelib_corner_t c, cubelib_face_t f){ return cubelib_is_corner_on_face(c, f); },
+  cubelib_corners, cubelib_faces);
+
+
+/* -------------------------------------------------------------------------- */
+/* direction                                                                  */
+/* -------------------------------------------------------------------------- */
+
+CORNER_CASES_BENCHMARK(BM_cubexx_direction_get_by_int3,
+  [](std::size_t axis, int sign){
+    return direction_t::get(axis == 0 ? sign : 0, axis == 1 ? sign : 0, axis == 2 ? sign : 0);
+  }, axes, signs);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_direction_by_int3,
+  [](std::size_t axis, int sign){
+    return cubelib_get_direction_by_int3(axis == 0 ? sign : 0, axis == 1 ? sign : 0, axis == 2 ? sign : 0);
+  }, axes, signs);
+
+CORNER_CASES_BENCHMARK(BM_cubexx_direction_get_by_index,
+  [](std::size_t i){ return direction_t::get(i); }, direction_indices);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_direction_by_index,
+  [](std::size_t i){ return cubelib_get_direction_by_index(i); }, direction_indices);
+
+CORNER_CASES_BENCHMARK(BM_cubexx_direction_xyz,
+  [](const direction_t& d, std::size_t dim){ return d.xyz()[dim]; }, directions, axes);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_direction_i,
+  [](cubelib_direction_t d, std::size_t dim){ return cubelib_get_direction_i(d, dim); },
+  cubelib_directions, axes);
+
+CORNER_CASES_BENCHMARK(BM_cubexx_direction_axis,
+  [](const direction_t& d){ return d.axis(); }, directions);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_direction_sigdim,
+  [](cubelib_direction_t d){ return cubelib_get_direction_sigdim(d); }, cubelib_directions);
+
+CORNER_CASES_BENCHMARK(BM_cubexx_direction_opposite,
+  [](const direction_t& d){ return d.opposite(); }, directions);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_opposite_direction,
+  [](cubelib_direction_t d){ return cubelib_get_opposite_direction(d); }, cubelib_directions);
+
+CORNER_CASES_BENCHMARK(BM_cubexx_direction_face,
+  [](const direction_t& d){ return d.face(); }, directions);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_direction_face,
+  [](cubelib_direction_t d){ return cubelib_get_direction_face(d); }, cubelib_directions);
+
+CORNER_CASES_BENCHMARK(BM_cubexx_direction_adjacents,
+  [](const direction_t& d, std::size_t i){ return d.adjacents()[i]; }, directions, quad_indices);
+CORNER_CASES_BENCHMARK(BM_cubexx_direction_adjacent_set,
+  [](const direction_t& d){ return d.adjacent_set(); }, directions);
+
+
+/* -------------------------------------------------------------------------- */
+/* edge                                                                       */
+/* -------------------------------------------------------------------------- */
+
+CORNER_CASES_BENCHMARK(BM_cubexx_edge_get_by_axis,
+  [](std::size_t axis, int s, int t){ return edge_t::get(axis, s > 0, t > 0); }, axes, signs, other_signs);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_edge_by_axis,
+  [](std::size_t axis, int s, int t){ return cubelib_get_edge_by_axis(axis, s > 0, t > 0); },
+  axes, signs, other_signs);
+
+CORNER_CASES_BENCHMARK(BM_cubexx_edge_get_by_corners,
+  [](const corner_t& a, const corner_t& b){ return edge_t::get(a, b); }, corners, adjacent_corners);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_edge_by_corners,
+  [](cubelib_corner_t a, cubelib_corner_t b){ return cubelib_get_edge_by_corners(a, b); },
+  cubelib_corners, cubelib_adjacent_corner_inputs);
+
+CORNER_CASES_BENCHMARK(BM_cubexx_edge_get_by_index,
+  [](std::size_t i){ return edge_t::get(i); }, edge_indices);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_edge_by_index,
+  [](std::size_t i){ return cubelib_get_edge_by_index(i); }, edge_indices);
+
+CORNER_CASES_BENCHMARK(BM_cubexx_edge_opposite,
+  [](const edge_t& e){ return e.opposite(); }, edges);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_opposite_edge,
+  [](cubelib_edge_t e){ return cubelib_get_opposite_edge(e); }, cubelib_edges);
+
+CORNER_CASES_BENCHMARK(BM_cubexx_edge_corner0,
+  [](const edge_t& e){ return e.corner0(); }, edges);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_edge_corner0,
+  [](cubelib_edge_t e){ return cubelib_get_edge_corner0(e); }, cubelib_edges);
+
+CORNER_CASES_BENCHMARK(BM_cubexx_edge_corner1,
+  [](const edge_t& e){ return e.corner1(); }, edges);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_edge_corner1,
+  [](cubelib_edge_t e){ return cubelib_get_edge_corner1(e); }, cubelib_edges);
+
+CORNER_CASES_BENCHMARK(BM_cubexx_edge_base_axis,
+  [](const edge_t& e){ return e.base_axis(); }, edges);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_edge_base_axis,
+  [](cubelib_edge_t e){ return cubelib_get_edge_base_axis(e); }, cubelib_edges);
+
+CORNER_CASES_BENCHMARK(BM_cubexx_edge_secondary_axis,
+  [](const edge_t& e){ return e.secondary_axis(); }, edges);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_edge_secondary_axis,
+  [](cubelib_edge_t e){ return cubelib_get_edge_secondary_axis(e); }, cubelib_edges);
+
+CORNER_CASES_BENCHMARK(BM_cubexx_edge_project_secondary,
+  [](const edge_t& e){ return e.project_secondary(); }, edges);
+CORNER_CASES_BENCHMARK(BM_cubelib_is_edge_projected_secondary,
+  [](cubelib_edge_t e){ return cubelib_is_edge_projected_secondary(e); }, cubelib_edges);
+
+CORNER_CASES_BENCHMARK(BM_cubexx_edge_faces,
+  [](const edge_t& e, std::size_t i){ return e.faces()[i]; }, edges, pair_indices);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_face_on_edge,
+  [](cubelib_edge_t e, std::size_t i){ return cubelib_get_face_on_edge(e, i); }, cubelib_edges, pair_indices);
+
+CORNER_CASES_BENCHMARK(BM_cubexx_edge_is_adjacent_face,
+  [](const edge_t& e, const face_t& f){ return e.is_adjacent(f); }, edges, faces);
+CORNER_CASES_BENCHMARK(BM_cubelib_is_face_on_edge,
+  [](cubelib_edge_t e, cubelib_face_t f){ return cubelib_is_face_on_edge(f, e); }, cubelib_edges, cubelib_faces);
+
+CORNER_CASES_BENCHMARK(BM_cubexx_edge_corners,
+  [](const edge_t& e, std::size_t i){ return e.corners()[i]; }, edges, pair_indices);
+CORNER_CASES_BENCHMARK(BM_cubexx_edge_corner_set,
+  [](const edge_t& e){ return e.corner_set(); }, edges);
+CORNER_CASES_BENCHMARK(BM_cubexx_edge_face_set,
+  [](const edge_t& e){ return e.face_set(); }, edges);
+CORNER_CASES_BENCHMARK(BM_cubexx_edge_adjacent_edges,
+  [](const edge_t& e, std::size_t i){ return e.adjacent_edges()[i]; }, edges, quad_indices);
+CORNER_CASES_BENCHMARK(BM_cubexx_edge_adjacent_edge_set,
+  [](const edge_t& e){ return e.adjacent_edge_set(); }, edges);
+CORNER_CASES_BENCHMARK(BM_cubexx_edge_adjacent_edges_at_corner,
+  [](const edge_t& e, std::size_t i){ return e.adjacent_edges(e.corners()[i])[0]; }, edges, pair_indices);
+CORNER_CASES_BENCHMARK(BM_cubexx_edge_end_face,
+  [](const edge_t& e, std::size_t i){ return e.end_face(e.corners()[i]); }, edges, pair_indices);
+CORNER_CASES_BENCHMARK(BM_cubexx_edge_opposite_on_face,
+  [](const edge_t& e, const face_t& f){ return e.opposite(f); }, edges, edge_faces);
+CORNER_CASES_BENCHMARK(BM_cubexx_edge_is_adjacent_edge,
+  [](const edge_t& a, const edge_t& b){ return a.is_adjacent(b); }, edges, face_edges);
+
+
+/* -------------------------------------------------------------------------- */
+/* face                                                                       */
+/* -------------------------------------------------------------------------- */
+
+CORNER_CASES_BENCHMARK(BM_cubexx_face_get_by_index,
+  [](std::size_t i){ return face_t::get(i); }, face_indices);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_face_by_index,
+  [](std::size_t i){ return cubelib_get_face_by_index(i); }, face_indices);
+
+CORNER_CASES_BENCHMARK(BM_cubexx_face_direction,
+  [](const face_t& f){ return f.direction(); }, faces);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_face_direction,
+  [](cubelib_face_t f){ return cubelib_get_face_direction(f); }, cubelib_faces);
+
+CORNER_CASES_BENCHMARK(BM_cubexx_face_corners,
+  [](const face_t& f, std::size_t i){ return f.corners()[i]; }, faces, quad_indices);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_corner_on_face,
+  [](cubelib_face_t f, std::size_t i){ return cubelib_get_corner_on_face(f, i); }, cubelib_faces, quad_indices);
+
+CORNER_CASES_BENCHMARK(BM_cubexx_face_edges,
+  [](const face_t& f, std::size_t i){ return f.edges()[i]; }, faces, quad_indices);
+CORNER_CASES_BENCHMARK(BM_cubelib_get_edge_on_face,
+  [](cubelib_face_t f, std::size_t i){ return cubelib_get_edge_on_face(f, i); }, cubelib_faces, quad_indices);
+
+CORNER_CASES_BENCHMARK(BM_cubexx_face_is_adjacent_edge,
+  [](const face_t& f, const edge_t& e){ return f.is_adjacent(e); }, faces, edges);
+CORNER_CASES_BENCHMARK(BM_cubelib_is_edge_on_face,
+  [](cubelib_face_t f, cubelib_edge_t e){ return cubelib_is_edge_on_face(e, f); }, cubelib_faces, cubelib_edges);
+
+CORNER_CASES_BENCHMARK(BM_cubexx_face_opposite,
+  [](const face_t& f){ return f.opposite(); }, faces);
+CORNER_CASES_BENCHMARK(BM_cubexx_face_adjacents,
+  [](const face_t& f, std::size_t i){ return f.adjacents()[i]; }, faces, quad_indices);
+CORNER_CASES_BENCHMARK(BM_cubexx_face_adjacent_set,
+  [](const face_t& f){ return f.adjacent_set(); }, faces);
+CORNER_CASES_BENCHMARK(BM_cubexx_face_corner_set,
+  [](const face_t& f){ return f.corner_set(); }, faces);
+CORNER_CASES_BENCHMARK(BM_cubexx_face_edge_set,
+  [](const face_t& f){ return f.edge_set(); }, faces);
+CORNER_CASES_BENCHMARK(BM_cubexx_face_perpendicular_edges,
+  [](const face_t& f, std::size_t i){ return f.perpendicular_edges()[i]; }, faces, quad_indices);
+CORNER_CASES_BENCHMARK(BM_cubexx_face_flip,
+  [](const face_t& f, const edge_t& e){ return f.flip(e); }, faces, face_edges);
+
+
+/* -------------------------------------------------------------------------- */
+/* sets                                                                       */
+/* -------------------------------------------------------------------------- */
+
+CORNER_CASES_BENCHMARK(BM_cubexx_corner_set_union,
+  [](const corner_set_t& a, const corner_set_t& b){ return a | b; }, corner_sets, other_corner_sets);
+CORNER_CASES_BENCHMARK(BM_cubexx_corner_set_intersection,
+  [](const corner_set_t& a, const corner_set_t& b){ return a & b; }, corner_sets, other_corner_sets);
+CORNER_CASES_BENCHMARK(BM_cubexx_corner_set_difference,
+  [](const corner_set_t& a, const corner_set_t& b){ return a - b; }, corner_sets, other_corner_sets);
+CORNER_CASES_BENCHMARK(BM_cubexx_corner_set_complement,
+  [](const corner_set_t& a){ return ~a; }, corner_sets);
+CORNER_CASES_BENCHMARK(BM_cubexx_corner_set_insert,
+  [](const corner_set_t& a, const corner_t& c){ return a | c; }, corner_sets, corners);
+CORNER_CASES_BENCHMARK(BM_cubexx_corner_set_contains,
+  [](const corner_set_t& a, const corner_t& c){ return a.contains(c); }, corner_sets, corners);
+CORNER_CASES_BENCHMARK(BM_cubexx_corner_set_equal,
+  [](const corner_set_t& a, const corner_set_t& b){ return a == b; }, corner_sets, other_corner_sets);
+CORNER_CASES_BENCHMARK(BM_cubexx_corner_set_size,
+  [](const corner_set_t& a){ return a.size(); }, corner_sets);
+CORNER_CASES_BENCHMARK(BM_cubexx_corner_set_first,
+  [](const corner_set_t& a){ return a.first(); }, nonempty_corner_sets);
+CORNER_CASES_BENCHMARK(BM_cubexx_corner_set_nth,
+  [](const corner_set_t& a, std::size_t k){ return a.nth(k); }, nonempty_corner_sets, corner_set_ranks);
+CORNER_CASES_BENCHMARK(BM_cubexx_corner_set_iterate,
+  [](const corner_set_t& a){
+    std::size_t sum = 0;
+    for (const corner_t& corner : a)
+      sum += corner.index();
+    return sum;
+  }, corner_sets);
+CORNER_CASES_BENCHMARK(BM_cubexx_corner_set_from_sequence,
+  [](const corner_t& c){ return corner_set_t(c.adjacents()); }, corners);
+
+CORNER_CASES_BENCHMARK(BM_cubexx_edge_set_union,
+  [](const edge_set_t& a, const edge_set_t& b){ return a | b; }, edge_sets, other_edge_sets);
+CORNER_CASES_BENCHMARK(BM_cubexx_edge_set_intersection,
+  [](const edge_set_t& a, const edge_set_t& b){ return a & b; }, edge_sets, other_edge_sets);
+CORNER_CASES_BENCHMARK(BM_cubexx_edge_set_difference,
+  [](const edge_set_t& a, const edge_set_t& b){ return a - b; }, edge_sets, other_edge_sets);
+CORNER_CASES_BENCHMARK(BM_cubexx_edge_set_complement,
+  [](const edge_set_t& a){ return ~a; }, edge_sets);
+CORNER_CASES_BENCHMARK(BM_cubexx_edge_set_contains,
+  [](const edge_set_t& a, const edge_t& e){ return a.contains(e); }, edge_sets, edges);
+CORNER_CASES_BENCHMARK(BM_cubexx_edge_set_size,
+  [](const edge_set_t& a){ return a.size(); }, edge_sets);
+CORNER_CASES_BENCHMARK(BM_cubexx_edge_set_iterate,
+  [](const edge_set_t& a){
+    std::size_t sum = 0;
+    for (const edge_t& edge : a)
+      sum += edge.index();
+    return sum;
+  }, edge_sets);
+
+
+/* -------------------------------------------------------------------------- */
+/* packed                                                                     */
+/* -------------------------------------------------------------------------- */
+
+///Packs all of the corners at once, then unpacks them again; @p bulk picks assign()/unpack() over element access.
+template<typename packed_t>
+static void run_packed(benchmark::State& state, bool bulk)
+{
+  packed_t packed(corners.size());
+  std::vector<corner_t> result(corners.size());
+  for (auto _ : state)
+  {
+    if (bulk)
+    {
+      packed.assign(corners.data(), corners.size());
+      packed.unpack(result.data());
+    }
+    else
+    {
+      for (std::size_t i = 0; i < corners.size(); ++i)
+        packed[i] = corners[i];
+      for (std::size_t i = 0; i < corners.size(); ++i)
+        result[i] = packed[i];
+    }
+    benchmark::DoNotOptimize(result.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(std::int64_t(state.iterations()) * std::int64_t(corners.size()));
+}
+
+static void BM_cubexx_packed_corner_array_bulk(benchmark::State& state) { run_packed<packed_corner_array_t>(state, true); }
+BENCHMARK(BM_cubexx_packed_corner_array_bulk);
+static void BM_cubexx_packed_corner_array_elementwise(benchmark::State& state) { run_packed<packed_corner_array_t>(state, false); }
+BENCHMARK(BM_cubexx_packed_corner_array_elementwise);
+static void BM_cubexx_packed3_corner_array_bulk(benchmark::State& state) { run_packed<packed3_corner_array_t>(state, true); }
+BENCHMARK(BM_cubexx_packed3_corner_array_bulk);
+static void BM_cubexx_packed3_corner_array_elementwise(benchmark::State& state) { run_packed<packed3_corner_array_t>(state, false); }
+BENCHMARK(BM_cubexx_packed3_corner_array_elementwise);
+
+
+/* -------------------------------------------------------------------------- */
+/* morton                                                                     */
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+std::vector<std::uint32_t> coordinates(unsigned seed)
+{
+  return map_indices(random_indices(std::size_t(1) << 21, seed), [](std::size_t i){ return std::uint32_t(i); });
+}
+const std::vector<std::uint32_t> morton_xs = coordinates(30);
+const std::vector<std::uint32_t> morton_ys = coordinates(31);
+const std::vector<std::uint32_t> morton_zs = coordinates(32);
+const std::vector<morton_code64_t> morton_codes = []{
+  std::vector<morton_code64_t> result(morton_xs.size());
+  morton_code64_t::encode_n(morton_xs.data(), morton_ys.data(), morton_zs.data(), 21, result.data(), result.size());
+  return result;
+}();
+
+} // namespace
+
+CORNER_CASES_BENCHMARK(BM_cubexx_morton_encode,
+  [](std::uint32_t x, std::uint32_t y, std::uint32_t z){ return morton_code64_t::encode(x, y, z); },
+  morton_xs, morton_ys, morton_zs);
+CORNER_CASES_BENCHMARK(BM_cubexx_morton_decode,
+  [](const morton_code64_t& code){ return code.decode(); }, morton_codes);
+CORNER_CASES_BENCHMARK(BM_cubexx_morton_level,
+  [](const morton_code64_t& code){ return code.level(); }, morton_codes);
+CORNER_CASES_BENCHMARK(BM_cubexx_morton_corner_at,
+  [](const morton_code64_t& code, std::size_t level){ return code.corner_at(level + 1).index(); },
+  morton_codes, edge_indices);
+
+static void BM_cubexx_morton_encode_n(benchmark::State& state)
+{
+  std::vector<morton_code64_t> codes(morton_xs.size());
+  for (auto _ : state)
+  {
+    morton_code64_t::encode_n(morton_xs.data(), morton_ys.data(), morton_zs.data(), 21, codes.data(), codes.size());
+    benchmark::DoNotOptimize(codes.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(std::int64_t(state.iterations()) * std::int64_t(codes.size()));
+}
+BENCHMARK(BM_cubexx_morton_encode_n);
+
+CORNER_CASES_BENCHMARK(BM_cubexx_morton_neighbor_direction,
+  [](const morton_code64_t& code, const direction_t& d){ return neighbor(code, d).code.bits(); }, morton_codes, directions);
+CORNER_CASES_BENCHMARK(BM_cubexx_morton_neighbor_edge,
+  [](const morton_code64_t& code, const edge_t& e){ return neighbor(code, e).code.bits(); }, morton_codes, edges);
+CORNER_CASES_BENCHMARK(BM_cubexx_morton_neighbor_corner,
+  [](const morton_code64_t& code, const corner_t& c){ return neighbor(code, c).code.bits(); }, morton_codes, corners);
+
+static void BM_cubexx_morton_neighbor_n(benchmark::State& state)
+{
+  std::vector<morton_code64_t> neighbors(morton_codes.size());
+  for (auto _ : state)
+  {
+    neighbor_n(morton_codes.data(), morton_codes.size(), direction_t::get(1, 0, 0), neighbors.data(), nullptr);
+    benchmark::DoNotOptimize(neighbors.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(std::int64_t(state.iterations()) * std::int64_t(neighbors.size()));
+}
+BENCHMARK(BM_cubexx_morton_neighbor_n);
+
+
+/* -------------------------------------------------------------------------- */
+/* linear_octree                                                              */
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+///A uniformly refined octree, 7 levels deep (2M leaves), to look the morton_codes up in.
+const linear_octree_t<std::uint32_t> uniform_octree = []{
+  std::vector<morton_code64_t> codes;
+  std::vector<std::uint32_t> values;
+  for (std::uint32_t path = 0; path < (1U << 21); ++path)
+  {
+    codes.push_back(morton_code64_t::from_bits(morton_code64_t::value_type((1U << 21) | path)));
+    values.push_back(path);
+  }
+  return linear_octree_t<std::uint32_t>(std::move(codes), std::move(values));
+}();
+
+} // namespace
+
+CORNER_CASES_BENCHMARK(BM_cubexx_linear_octree_locate,
+  [](const morton_code64_t& code){ return uniform_octree.locate(code); }, morton_codes);
+CORNER_CASES_BENCHMARK(BM_cubexx_linear_octree_locate_binary,
+  [](const morton_code64_t& code){ return uniform_octree.locate_binary(code); }, morton_codes);
+CORNER_CASES_BENCHMARK(BM_cubexx_linear_octree_children,
+  [](const morton_code64_t& code){ return uniform_octree.children(code.ancestor(6)); }, morton_codes);
+
+
+/* -------------------------------------------------------------------------- */
+/* octree                                                                     */
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+///The morton_codes, 10 levels deep, in a pooled octree.
+const octree_t<std::uint32_t>& pooled_octree()
+{
+  static octree_t<std::uint32_t> octree = []{
+    octree_t<std::uint32_t> result;
+    for (const auto& code : morton_codes)
+      result.insert(code.ancestor(10));
+    return result;
+  }();
+  return octree;
+}
+
+} // namespace
+
+CORNER_CASES_BENCHMARK(BM_cubexx_octree_find,
+  [](const morton_code64_t& code){ return pooled_octree().find(code.ancestor(10)); }, morton_codes);
+
+static void BM_cubexx_octree_insert_erase(benchmark::State& state)
+{
+  ///with the pool reserved, this never touches the heap
+  octree_t<std::uint32_t> octree(morton_codes.size() * 10);
+  for (auto _ : state)
+  {
+    for (const auto& code : morton_codes)
+      octree.insert(code.ancestor(10));
+    octree.erase_children(octree.root());
+  }
+  state.SetItemsProcessed(std::int64_t(state.iterations()) * std::int64_t(morton_codes.size()));
+}
+BENCHMARK(BM_cubexx_octree_insert_erase);
+
+
+/* -------------------------------------------------------------------------- */
+/* octree_builder                                                             */
+/* -------------------------------------------------------------------------- */
+
+static void BM_cubexx_octree_builder_build(benchmark::State& state)
+{
+  ///1M uniformly random points, on a pool of state.range(0) threads
+  const std::size_t n = 1 << 20;
+  std::mt19937 generator(1234);
+  std::uniform_real_distribution<float> distribution(0, 1);
+  std::vector<float> xs(n), ys(n), zs(n);
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    xs[i] = distribution(generator);
+    ys[i] = distribution(generator);
+    zs[i] = distribution(generator);
+  }
+
+  thread_pool_t pool(std::size_t(state.range(0)));
+  octree_builder_t<> builder(pool, 16);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(builder.build(xs.data(), ys.data(), zs.data(), n, {{0, 0, 0}}, 1));
+  state.SetItemsProcessed(std::int64_t(state.iterations()) * std::int64_t(n));
+}
+BENCHMARK(BM_cubexx_octree_builder_build)->Arg(1)->Arg(4)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+
+/* -------------------------------------------------------------------------- */
+/* raycast                                                                    */
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+///Rays from random points on a sphere around the pooled_octree() (in the unit cube) toward random points in it.
+const std::vector<ray_t> rays = []{
+  std::mt19937 generator(1234);
+  std::normal_distribution<float> normal(0, 1);
+  std::uniform_real_distribution<float> uniform(0, 1);
+  std::vector<ray_t> result;
+  for (std::size_t i = 0; i < corner_cases_benchmarks::INPUT_SIZE; ++i)
+  {
+    std::array<float, 3> out = {{normal(generator), normal(generator), normal(generator)}};
+    float length = std::sqrt(out[0] * out[0] + out[1] * out[1] + out[2] * out[2]);
+    ray_t ray;
+    for (std::size_t k = 0; k < 3; ++k)
+    {
+      ray.origin[k] = 0.5f + 2 * out[k] / length;
+      ray.direction[k] = uniform(generator) - ray.origin[k];
+    }
+    result.push_back(ray);
+  }
+  return result;
+}();
+
+/**
+ * Rays from a pinhole camera at (0.5, 0.5, 2) through a 64x64 image of the unit cube, in tiles of 4x2 pixels (each
+ * the two 2x2 tiles side by side), so that every 4 or 8 consecutive rays are a packet of neighboring pixels.
+ */
+const std::vector<ray_t> coherent_rays = []{
+  const std::size_t pixels = 64;
+  std::vector<ray_t> result;
+  for (std::size_t ty = 0; ty < pixels; ty += 2)
+  for (std::size_t tx = 0; tx < pixels; tx += 4)
+  for (std::size_t i = 0; i < 8; ++i)
+  {
+    std::size_t x = tx + (i & 1) + ((i >> 2) << 1), y = ty + ((i >> 1) & 1);
+    ray_t ray = {{{0.5f, 0.5f, 2}}, {{(x + 0.5f) / pixels - 0.5f, (y + 0.5f) / pixels - 0.5f, -1}}};
+    result.push_back(ray);
+  }
+  return result;
+}();
+
+const std::array<float, 3> unit_lower = {{0, 0, 0}};
+
+} // namespace
+
+CORNER_CASES_BENCHMARK(BM_cubexx_raycast,
+  [](const ray_t& ray){ return raycast(pooled_octree(), unit_lower, 1, ray).t_entry; }, rays);
+CORNER_CASES_BENCHMARK(BM_cubexx_raycast_coherent,
+  [](const ray_t& ray){ return raycast(pooled_octree(), unit_lower, 1, ray).t_entry; }, coherent_rays);
+
+namespace {
+
+template<std::size_t Width>
+void raycast_packets(benchmark::State& state, const std::vector<ray_t>& input)
+{
+  ray_hit_t<octree_t<std::uint32_t>> hits[Width];
+  for (auto _ : state)
+  {
+    for (std::size_t i = 0; i + Width <= input.size(); i += Width)
+    {
+      raycast_packet<Width>(pooled_octree(), unit_lower, 1, input.data() + i, hits);
+      benchmark::DoNotOptimize(hits);
+    }
+  }
+  state.SetItemsProcessed(std::int64_t(state.iterations()) * std::int64_t(input.size()));
+}
+
+} // namespace
+
+template<std::size_t Width>
+static void BM_cubexx_raycast_packet(benchmark::State& state)
+{
+  ///packets of rays that are not particularly coherent, which is the worst case for packets
+  raycast_packets<Width>(state, rays);
+}
+BENCHMARK_TEMPLATE(BM_cubexx_raycast_packet, 4);
+BENCHMARK_TEMPLATE(BM_cubexx_raycast_packet, 8);
+
+template<std::size_t Width>
+static void BM_cubexx_raycast_packet_coherent(benchmark::State& state)
+{
+  ///packets of neighboring pixels, which is what they are for; compare with BM_cubexx_raycast_coherent
+  raycast_packets<Width>(state, coherent_rays);
+}
+BENCHMARK_TEMPLATE(BM_cubexx_raycast_packet_coherent, 4);
+BENCHMARK_TEMPLATE(BM_cubexx_raycast_packet_coherent, 8);
+
+
+/* -------------------------------------------------------------------------- */
+/* culling                                                                    */
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+///A perspective frustum looking down -z from (0.5, 0.5, 2) at the unit cube, 60 degrees wide.
+const culler_t frustum_culler = []{
+  const float f = 1.7320508f, near = 0.1f, far = 10.f;
+  const float a = (far + near) / (near - far), b = 2 * far * near / (near - far);
+  ///projection times a translation by (-0.5, -0.5, -2)
+  std::array<float, 16> matrix = {{f, 0, 0, -0.5f * f,
+                                   0, f, 0, -0.5f * f,
+                                   0, 0, a, -2 * a + b,
+                                   0, 0, -1, 2}};
+  return culler_t::frustum(matrix);
+}();
+
+///Boxes from the random morton_codes, 6 levels deep, in the unit cube.
+const std::vector<std::array<float, 3>> box_lowers = []{
+  std::vector<std::array<float, 3>> result;
+  for (const auto& code : morton_codes)
+  {
+    auto xyz = code.ancestor(6).decode();
+    result.push_back({{xyz[0] / 64.f, xyz[1] / 64.f, xyz[2] / 64.f}});
+  }
+  return result;
+}();
+
+} // namespace
+
+CORNER_CASES_BENCHMARK(BM_cubexx_culler_test,
+  [](const std::array<float, 3>& lower){
+    culler_t::plane_mask_t mask = frustum_culler.all();
+    return frustum_culler.test(lower, 1 / 64.f, mask) ? mask : 0;
+  }, box_lowers);
+CORNER_CASES_BENCHMARK(BM_cubexx_culler_test_children,
+  [](const std::array<float, 3>& lower){
+    culler_t::plane_mask_t child_masks[8];
+    return frustum_culler.test_children(lower, 1 / 64.f, frustum_culler.all(), child_masks);
+  }, box_lowers);
+
+static void BM_cubexx_cull_visit(benchmark::State& state)
+{
+  for (auto _ : state)
+  {
+    std::size_t count = 0;
+    cull_visit(pooled_octree(), unit_lower, 1, frustum_culler,
+               [&](octree_t<std::uint32_t>::node_id, const std::array<float, 3>&, float, bool){ ++count; });
+    benchmark::DoNotOptimize(count);
+  }
+}
+BENCHMARK(BM_cubexx_cull_visit);
+
+
+/* -------------------------------------------------------------------------- */
+/* balance                                                                    */
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+///Leaves refined 14 levels deep around 64 of the morton_codes, and no deeper anywhere else.
+linear_octree_t<std::uint32_t> pointy_octree()
+{
+  std::vector<morton_code64_t> points;
+  for (std::size_t i = 0; i < 64; ++i)
+    points.push_back(morton_codes[i].ancestor(14));
+  std::sort(points.begin(), points.end());
+
+  std::vector<morton_code64_t> codes;
+  std::vector<morton_code64_t> stack = {morton_code64_t::root()};
+  while (!stack.empty())
+  {
+    morton_code64_t code = stack.back();
+    stack.pop_back();
+    bool refine = code.level() < 14 && std::any_of(points.begin(), points.end(), [&](const morton_code64_t& point){
+      return code.contains(point);
+    });
+    if (!refine)
+    {
+      codes.push_back(code);
+      continue;
+    }
+    for (const auto& corner : corner_t::all())
+      stack.push_back(code.child(corner));
+  }
+  std::vector<std::uint32_t> values(codes.size());
+  return linear_octree_t<std::uint32_t>(std::move(codes), std::move(values));
+}
+
+} // namespace
+
+static void BM_cubexx_balance(benchmark::State& state)
+{
+  static const linear_octree_t<std::uint32_t> octree = pointy_octree();
+  thread_pool_t pool(std::size_t(state.range(0)));
+  std::size_t leaves = 0;
+  for (auto _ : state)
+    leaves = balance(octree, adjacency_t::corner, pool).size();
+  state.counters["leaves"] = double(leaves);
+}
+BENCHMARK(BM_cubexx_balance)->Arg(1)->Arg(4)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+
+/* -------------------------------------------------------------------------- */
+/* marching cubes                                                             */
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+///4 rows of a sphere's distance field, through its middle.
+std::vector<float> sphere_rows()
+{
+  const std::size_t n = corner_cases_benchmarks::INPUT_SIZE;
+  std::vector<float> values(4 * (n + 1));
+  for (std::size_t r = 0; r < 4; ++r)
+    for (std::size_t x = 0; x < n + 1; ++x)
+    {
+      float dx = float(x) - float(n) / 2, dy = float(r & 1), dz = float(r >> 1);
+      values[r * (n + 1) + x] = std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+  return values;
+}
+
+} // namespace
+
+static void BM_cubexx_marching_cubes_classify_row(benchmark::State& state)
+{
+  static const std::vector<float> values = sphere_rows();
+  const std::size_t n = corner_cases_benchmarks::INPUT_SIZE;
+  const float* rows[4] = {&values[0], &values[n + 1], &values[2 * (n + 1)], &values[3 * (n + 1)]};
+  std::vector<std::uint8_t> cases(n);
+  for (auto _ : state)
+  {
+    marching_cubes_classify_row(rows, n, float(n) / 4, cases.data());
+    benchmark::DoNotOptimize(cases.data());
+  }
+}
+BENCHMARK(BM_cubexx_marching_cubes_classify_row);
+
+static void BM_cubexx_marching_cubes_classify_row_scalar(benchmark::State& state)
+{
+  static const std::vector<float> values = sphere_rows();
+  const std::size_t n = corner_cases_benchmarks::INPUT_SIZE;
+  const float* rows[4] = {&values[0], &values[n + 1], &values[2 * (n + 1)], &values[3 * (n + 1)]};
+  std::vector<std::uint8_t> cases(n);
+  for (auto _ : state)
+  {
+    detail::marching_cubes_classify_row_scalar(rows, n, float(n) / 4, cases.data());
+    benchmark::DoNotOptimize(cases.data());
+  }
+}
+BENCHMARK(BM_cubexx_marching_cubes_classify_row_scalar);
+
+
+/* -------------------------------------------------------------------------- */
+/* cube_symmetry_t                                                            */
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+const std::vector<cube_symmetry_t> symmetries
+  = map_indices(random_indices(48, 30), [](std::size_t i){ return cube_symmetry_t::get(i); });
+const std::vector<cube_symmetry_t> other_symmetries
+  = map_indices(random_indices(48, 31), [](std::size_t i){ return cube_symmetry_t::get(i); });
+
+} // namespace
+
+CORNER_CASES_BENCHMARK(BM_cubexx_cube_symmetry_corner,
+  [](const cube_symmetry_t& s, const corner_t& c){ return s(c).index(); }, symmetries, corners);
+CORNER_CASES_BENCHMARK(BM_cubexx_cube_symmetry_edge,
+  [](const cube_symmetry_t& s, const edge_t& e){ return s(e).index(); }, symmetries, edges);
+CORNER_CASES_BENCHMARK(BM_cubexx_cube_symmetry_corner_set,
+  [](const cube_symmetry_t& s, const corner_set_t& c){ return s(c); }, symmetries, corner_sets);
+CORNER_CASES_BENCHMARK(BM_cubexx_cube_symmetry_edge_set,
+  [](const cube_symmetry_t& s, const edge_set_t& e){ return s(e); }, symmetries, edge_sets);
+///The same, an element at a time, for comparison.
+CORNER_CASES_BENCHMARK(BM_cubexx_cube_symmetry_edge_set_by_element,
+  [](const cube_symmetry_t& s, const edge_set_t& edges){
+    edge_set_t result;
+    for (const edge_t& edge : edges)
+      result |= s(edge);
+    return result;
+  }, symmetries, edge_sets);
+CORNER_CASES_BENCHMARK(BM_cubexx_cube_symmetry_compose,
+  [](const cube_symmetry_t& a, const cube_symmetry_t& b){ return (a * b).index(); }, symmetries, other_symmetries);
+
+
+/* -------------------------------------------------------------------------- */
+/* canonicalize                                                               */
+/* -------------------------------------------------------------------------- */
+
+CORNER_CASES_BENCHMARK(BM_cubexx_canonicalize_corner_set,
+  [](const corner_set_t& c){ return canonicalize(c).set; }, corner_sets);
+CORNER_CASES_BENCHMARK(BM_cubexx_canonicalize_edge_set,
+  [](const edge_set_t& e){ return canonicalize(e, cube_symmetry_group_t::all).set; }, edge_sets);
+
+
+/* -------------------------------------------------------------------------- */
+/* grid_index_t                                                               */
+/* -------------------------------------------------------------------------- */
+
+CORNER_CASES_BENCHMARK(BM_cubexx_grid_index_edge_id,
+  [](std::size_t x, const edge_t& e){
+    static const grid_index_t grid(64, 64, 64);
+    return grid.edge_id(x % 64, 7, 9, e);
+  }, random_indices(64, 40), edges);
+
+static void BM_cubexx_grid_index_edge_ids(benchmark::State& state)
+{
+  const std::size_t n = corner_cases_benchmarks::INPUT_SIZE;
+  const grid_index_t grid(n, 4, 4);
+  std::vector<grid_index_t::id_type> ids(n);
+  for (auto _ : state)
+  {
+    for (const edge_t& edge : edge_t::all())
+      grid.edge_ids(0, 1, 2, n, edge, ids.data());
+    benchmark::DoNotOptimize(ids.data());
+  }
+  state.SetItemsProcessed(std::int64_t(state.iterations()) * std::int64_t(12 * n));
+}
+BENCHMARK(BM_cubexx_grid_index_edge_ids);
+
+
+/* -------------------------------------------------------------------------- */
+/* isosurface_extractor_t                                                     */
+/* -------------------------------------------------------------------------- */
+
+namespace {
+
+///Counts what it is given.
+struct counting_sink_t
+{
+  void vertex(grid_index_t::id_type, const std::array<float, 3>&) { ++vertices; }
+  void triangle(grid_index_t::id_type, grid_index_t::id_type, grid_index_t::id_type) { ++triangles; }
+
+  std::size_t vertices = 0, triangles = 0;
+};
+
+} // namespace
+
+static void BM_cubexx_isosurface_sphere(benchmark::State& state)
+{
+  const std::size_t n = 64;
+  ///one slice, shifted down the sphere's distance field as it streams
+  std::vector<float> slice(n * n);
+  counting_sink_t sink;
+  for (auto _ : state)
+  {
+    isosurface_extractor_t extractor(n, n, n, float(n) / 3);
+    for (std::size_t z = 0; z < n; ++z)
+    {
+      for (std::size_t y = 0; y < n; ++y)
+        for (std::size_t x = 0; x < n; ++x)
+        {
+          float dx = float(x) - float(n) / 2, dy = float(y) - float(n) / 2, dz = float(z) - float(n) / 2;
+          slice[y * n + x] = std::sqrt(dx * dx + dy * dy + dz * dz);
+        }
+      extractor.push(slice.data(), sink);
+    }
+  }
+  state.counters["triangles"] = double(sink.triangles) / double(state.iterations());
+}
+BENCHMARK(BM_cubexx_isosurface_sphere)->Unit(benchmark::kMillisecond);
+
+
+/* -------------------------------------------------------------------------- */
+/* marching tetrahedra                                                        */
+/* -------------------------------------------------------------------------- */
+
+static void BM_cubexx_marching_tetrahedra_classify_row(benchmark::State& state)
+{
+  const std::size_t n = corner_cases_benchmarks::INPUT_SIZE;
+  static const std::vector<std::uint8_t> cases
+    = map_indices(random_indices(256, 50), [](std::size_t mask){ return std::uint8_t(mask); });
+  const std::array<tetrahedron_t, 6> tetrahedra = six_tetrahedra(corner_t::get(std::uint_fast8_t(0)));
+  std::vector<std::uint8_t> tetrahedron_cases(6 * n);
+  for (auto _ : state)
+  {
+    marching_tetrahedra_classify_row(cases.data(), n, tetrahedra, tetrahedron_cases.data());
+    benchmark::DoNotOptimize(tetrahedron_cases.data());
+  }
+  state.SetItemsProcessed(std::int64_t(state.iterations()) * std::int64_t(6 * n));
+}
+BENCHMARK(BM_cubexx_marching_tetrahedra_classify_row);
+
+
+/* -------------------------------------------------------------------------- */
+/* asymptotic decider                                                         */
+/* -------------------------------------------------------------------------- */
+
+static void BM_cubexx_asymptotic_decider_row(benchmark::State& state)
+{
+  ///noise, so that many faces are ambiguous; one value short of a row of cells per row of values
+  const std::size_t n = corner_cases_benchmarks::INPUT_SIZE - 1;
+  static const std::vector<float> values[4] = {
+    map_indices(random_indices(1000, 60), [](std::size_t i){ return float(i) / 500 - 1; }),
+    map_indices(random_indices(1000, 61), [](std::size_t i){ return float(i) / 500 - 1; }),
+    map_indices(random_indices(1000, 62), [](std::size_t i){ return float(i) / 500 - 1; }),
+    map_indices(random_indices(1000, 63), [](std::size_t i){ return float(i) / 500 - 1; })};
+  const float* rows[4] = {values[0].data(), values[1].data(), values[2].data(), values[3].data()};
+  std::vector<std::uint8_t> cases(n), connected(n);
+  marching_cubes_classify_row(rows, n, 0, cases.data());
+  for (auto _ : state)
+  {
+    asymptotic_decider_row(rows, n, 0, cases.data(), connected.data());
+    benchmark::DoNotOptimize(connected.data());
+  }
+  state.SetItemsProcessed(std::int64_t(state.iterations()) * std::int64_t(n));
+}
+BENCHMARK(BM_cubexx_asymptotic_decider_row);
+
+
+/* -------------------------------------------------------------------------- */
+/* offset_t                                                                   */
+/* -------------------------------------------------------------------------- */
+
+CORNER_CASES_BENCHMARK(BM_cubexx_offset_from_edge,
+  [](const edge_t& e){ return offset_t::get(e).index(); }, edges);
+
+static void BM_cubexx_offset_deltas_neighborhood(benchmark::State& state)
+{
+  ///the sum over the 26-neighborhood of random voxels, inside a 64^3 volume
+  const std::size_t n = 64;
+  static const std::vector<float> volume
+    = map_indices(random_indices(1000, 70), [](std::size_t i){ return float(i); });
+  static const std::vector<std::size_t> voxels = map_indices(random_indices((n - 2) * (n - 2) * (n - 2), 71),
+    [n](std::size_t i){ return (i % (n - 2) + 1) + n * ((i / (n - 2) % (n - 2) + 1) + n * (i / (n - 2) / (n - 2) + 1)); });
+  std::vector<float> field(n * n * n);
+  for (std::size_t i = 0; i < field.size(); ++i)
+    field[i] = volume[i % volume.size()];
+  const offset_deltas_t deltas(1, std::ptrdiff_t(n), std::ptrdiff_t(n * n));
+  const offset_set_t neighborhood = offset_set_t::neighborhood(26);
+  for (auto _ : state)
+  {
+    float sum = 0;
+    for (std::size_t voxel : voxels)
+      for (const offset_t& offset : neighborhood)
+        sum += field[std::size_t(std::ptrdiff_t(voxel) + deltas[offset])];
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(std::int64_t(state.iterations()) * std::int64_t(26 * voxels.size()));
+}
+BENCHMARK(BM_cubexx_offset_deltas_neighborhood);
+
+
+BENCHMARK_MAIN();
@@ -0,0 +1,185 @@
+#include <cubexx/cubexx.hpp>
+
+#include <set>
+#include <algorithm>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+
+/**
+ * Reports how many distinct 64-byte cache lines the cubexx relation tables
+ * touch for a few typical traversals, by recording the address of every
+ * table entry the accessors hand back. Also times each traversal.
+ *
+ * Run it before and after a change to the table layout to compare the L1
+ * footprint; the numbers do not depend on any hardware counters.
+ */
+
+namespace {
+
+static const std::uintptr_t CACHE_LINE = 64;
+
+struct footprint_t
+{
+  std::set<std::uintptr_t> lines;
+  std::uintptr_t lo = ~std::uintptr_t(0);
+  std::uintptr_t hi = 0;
+
+  template<typename T>
+  void touch(const T& object)
+  {
+    std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(&object);
+    std::uintptr_t end = begin + sizeof(T);
+
+    for (std::uintptr_t line = begin / CACHE_LINE; line <= (end - 1) / CACHE_LINE; ++line)
+      lines.insert(line);
+    lo = std::min(lo, begin);
+    hi = std::max(hi, end);
+  }
+};
+
+using namespace cubexx;
+
+template<typename visitor_t>
+void edge_walk(visitor_t& v)
+{
+  for (const auto& edge : edge_t::all())
+  {
+    v(edge.corners());
+    v(edge.faces());
+    v(edge.adjacent_edges());
+    for (const auto& corner : edge.corners())
+    {
+      v(edge.adjacent_edges(corner));
+      v(edge.adjacent_edge_set(corner));
+      v(edge.end_face(corner));
+    }
+  }
+}
+
+template<typename visitor_t>
+void corner_pair_edges(visitor_t& v)
+{
+  for (const auto& corner : corner_t::all())
+    for (const auto& other : corner.adjacents())
+      v(edge_t::get(corner, other));
+}
+
+template<typename visitor_t>
+void face_ring(visitor_t& v)
+{
+  for (const auto& face : face_t::all())
+  {
+    v(face.corners());
+    v(face.edges());
+    for (const auto& edge : face.edges())
+    {
+      v(face.flip(edge));
+      v(edge.opposite(face));
+    }
+  }
+}
+
+template<typename visitor_t>
+void all_relations(visitor_t& v)
+{
+  edge_walk(v);
+  corner_pair_edges(v);
+  face_ring(v);
+
+  for (const auto& direction : direction_t::all())
+  {
+    v(direction.adjacents());
+    v(direction.adjacent_set());
+    v(direction.xyz());
+  }
+  for (const auto& face : face_t::all())
+  {
+    v(face.adjacents());
+    v(face.adjacent_set());
+    v(face.corner_set());
+    v(face.edge_set());
+    v(face.perpendicular_edges());
+  }
+  for (const auto& corner : corner_t::all())
+  {
+    v(corner.adjacents());
+    v(corner.adjacent_set());
+    v(corner.faces());
+    v(corner.face_set());
+    v(corner.edges());
+    v(corner.edge_set());
+    v(corner.xyz());
+    v(corner.uxyz());
+  }
+  for (const auto& edge : edge_t::all())
+  {
+    v(edge.corner_set());
+    v(edge.face_set());
+    v(edge.adjacent_edge_set());
+    v(edge.end_faces());
+    v(edge.end_face_set());
+  }
+}
+
+struct recorder_t
+{
+  footprint_t& footprint;
+
+  template<typename T>
+  void operator()(const T& object) { footprint.touch(object); }
+};
+
+struct summer_t
+{
+  std::uintptr_t sum = 0;
+
+  template<typename T>
+  void operator()(const T& object) { sum += reinterpret_cast<std::uintptr_t>(&object); }
+};
+
+template<void (*traversal)(recorder_t&), void (*timed)(summer_t&)>
+void report(const std::string& name)
+{
+  footprint_t footprint;
+  recorder_t recorder{footprint};
+  traversal(recorder);
+
+  static const std::size_t ITERATIONS = 200000;
+  summer_t summer;
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < ITERATIONS; ++i)
+    timed(summer);
+  auto stop = std::chrono::steady_clock::now();
+  double ns = std::chrono::duration<double, std::nano>(stop - start).count() / ITERATIONS;
+
+  std::cout << std::left << std::setw(20) << name
+            << std::right << std::setw(8) << footprint.lines.size()
+            << std::setw(12) << footprint.lines.size() * CACHE_LINE
+            << std::setw(12) << (footprint.hi - footprint.lo)
+            << std::setw(12) << std::fixed << std::setprecision(1) << ns
+            << (summer.sum == 0 ? " " : "") << std::endl;
+}
+
+} // namespace
+
+int main()
+{
+  std::cout << std::left << std::setw(20) << "traversal"
+            << std::right << std::setw(8) << "lines"
+            << std::setw(12) << "L1 bytes"
+            << std::setw(12) << "span bytes"
+            << std::setw(12) << "ns/iter" << std::endl;
+
+  report<&edge_walk<recorder_t>, &edge_walk<summer_t> >("edge walk");
+  report<&corner_pair_edges<recorder_t>, &corner_pair_edges<summer_t> >("corner pair edges");
+  report<&face_ring<recorder_t>, &face_ring<summer_t> >("face ring");
+  report<&all_relations<recorder_t>, &all_relations<summer_t> >("all relations");
+
+  return 0;
+}
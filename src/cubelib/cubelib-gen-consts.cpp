@@ -1,121 +1,344 @@
-
-
 #include "cubelib/cubelib.h"
 
 #include <ostream>
 #include <iostream>
 #include <fstream>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <sstream>
+#include <cctype>
+#include <algorithm>
 
 
 
 /**
- * Spits out @c cubelib_cnr_adj_cnrs as raw constants, for use in opencl.
+ * A relation table, with its entries flattened in row-major order.
  */
-void generate_cnr_adj_cnrs_constants(std::ostream& out)
-{
-    out << "#define CUBELIB_CNR_ADJ_CNRS \\" << std::endl;
-    out << "    { \\" << std::endl;
+struct table_t{
+    ///Name of the table in cubelib.h, without the `cubelib_` prefix.
+    std::string name;
+    ///Element type in cubelib.h.
+    std::string type;
+    ///True if the elements are one of the cubelib element structs (i.e. are initialized as `{value}`).
+    bool is_element;
+    std::vector<std::size_t> dims;
+    ///Raw values (e.g. cubelib_corner_t::value), one per entry.
+    std::vector<unsigned> values;
+};
 
-    for (std::size_t corneri = 0; corneri < 8; ++corneri)
-    {
-        cubelib_corner_t corner = cubelib_all_corners[corneri];
+/**
+ * Builds a table by calling @p f for every `(i, j)`; one-dimensional tables get called with `j == 0`.
+ */
+template<typename F>
+table_t make_table(const std::string& name, const std::string& type, bool is_element
+                 , std::size_t rows, std::size_t columns, F f)
+{
+    table_t result;
+    result.name = name;
+    result.type = type;
+    result.is_element = is_element;
+    result.dims.push_back(rows);
+    if (columns > 0)
+        result.dims.push_back(columns);
+
+    for (std::size_t i = 0; i < rows; ++i)
+        for (std::size_t j = 0; j < std::max<std::size_t>(columns, 1); ++j)
+            result.values.push_back(unsigned(f(i, j)));
+    return result;
+}
 
-        out << "        " << (corneri == 0 ? "  " : ", ") << "{ \\" << std::endl;
-        for (std::size_t i = 0; i < 3; ++i)
-        {
-            cubelib_corner_t adj_corner = cubelib_calc_cnr_adj_cnr(corner, i);
-            // cubelib_corner_t adj_corner = cubelib_cnr_adj_cnrs[cubelib_get_corner_index(corner)][i];
+static cubelib_corner_t C(std::size_t i){ return cubelib_get_corner_by_index(i); }
+static cubelib_direction_t D(std::size_t i){ return cubelib_get_direction_by_index(i); }
+static cubelib_edge_t E(std::size_t i){ return cubelib_get_edge_by_index(i); }
+static cubelib_face_t F(std::size_t i){ return cubelib_get_face_by_index(i); }
 
-            out << "            " << (i == 0 ? "  " : ", ") << "(corner_t){" << adj_corner.value << "}" << " \\" << std::endl;
-        }
-        out << "        } \\" << std::endl;
-    }
-    out << "    }" << std::endl;
+/**
+ * Every table in cubelib.h, computed from the `cubelib_calc_*` functions; see cubelib.h for what each one holds.
+ */
+std::vector<table_t> all_tables()
+{
+    std::vector<table_t> tables;
+
+    tables.push_back(make_table("cnr_adj_cnrs", "cubelib_corner_t", true, 8, 3,
+        [](std::size_t c, std::size_t i){ return cubelib_calc_cnr_adj_cnr(C(c), i).value; }));
+    tables.push_back(make_table("faces_on_edge", "cubelib_face_t", true, 12, 2,
+        [](std::size_t e, std::size_t i){ return cubelib_calc_face_on_edge(E(e), i).value; }));
+    tables.push_back(make_table("edges_on_face", "cubelib_edge_t", true, 6, 4,
+        [](std::size_t f, std::size_t i){ return cubelib_calc_edge_on_face(F(f), i).value; }));
+    tables.push_back(make_table("corners_on_face", "cubelib_corner_t", true, 6, 4,
+        [](std::size_t f, std::size_t i){ return cubelib_calc_corner_on_face(F(f), i).value; }));
+
+    tables.push_back(make_table("opposite_corners", "cubelib_corner_t", true, 8, 0,
+        [](std::size_t c, std::size_t){ return cubelib_calc_opposite_corner(C(c)).value; }));
+    tables.push_back(make_table("adjacent_corners", "cubelib_corner_t", true, 8, 6,
+        [](std::size_t c, std::size_t d){ return cubelib_calc_adjacent_corner(C(c), D(d)).value; }));
+    tables.push_back(make_table("corner_moves", "cubelib_corner_t", true, 8, 6,
+        [](std::size_t c, std::size_t d){ return cubelib_calc_corner_move(C(c), D(d)).value; }));
+    tables.push_back(make_table("corner_pushes", "cubelib_corner_t", true, 8, 6,
+        [](std::size_t c, std::size_t d){ return cubelib_calc_corner_push(C(c), D(d)).value; }));
+    tables.push_back(make_table("corner_adjacency", "bool", false, 8, 8,
+        [](std::size_t c0, std::size_t c1){ return cubelib_calc_is_corner_adjacent_corner(C(c0), C(c1)); }));
+    tables.push_back(make_table("corner_face_incidence", "bool", false, 8, 6,
+        [](std::size_t c, std::size_t f){ return cubelib_calc_is_corner_on_face(C(c), F(f)); }));
+
+    tables.push_back(make_table("opposite_directions", "cubelib_direction_t", true, 6, 0,
+        [](std::size_t d, std::size_t){ return cubelib_calc_opposite_direction(D(d)).value; }));
+
+    tables.push_back(make_table("edges_by_corner_direction", "cubelib_edge_t", true, 8, 6,
+        [](std::size_t c, std::size_t d){
+            if (cubelib_is_corner_null(cubelib_calc_corner_move(C(c), D(d))))
+                return cubelib_null_edge.value;
+            return cubelib_calc_edge_by_corner_direction(C(c), D(d)).value;
+        }));
+    tables.push_back(make_table("edges_by_corners", "cubelib_edge_t", true, 8, 8,
+        [](std::size_t c0, std::size_t c1){
+            if (!cubelib_calc_is_corner_adjacent_corner(C(c0), C(c1)))
+                return cubelib_null_edge.value;
+            return cubelib_calc_edge_by_corners(C(c0), C(c1)).value;
+        }));
+    tables.push_back(make_table("opposite_edges", "cubelib_edge_t", true, 12, 0,
+        [](std::size_t e, std::size_t){ return cubelib_calc_opposite_edge(E(e)).value; }));
+    tables.push_back(make_table("edge_corners", "cubelib_corner_t", true, 12, 2,
+        [](std::size_t e, std::size_t i){
+            return (i == 0 ? cubelib_calc_edge_corner0(E(e)) : cubelib_calc_edge_corner1(E(e))).value;
+        }));
+    tables.push_back(make_table("edge_directions", "cubelib_direction_t", true, 12, 0,
+        [](std::size_t e, std::size_t){ return cubelib_calc_edge_direction(E(e)).value; }));
+    tables.push_back(make_table("edge_axes", "uint_fast8_t", false, 12, 3,
+        [](std::size_t e, std::size_t i){
+            return i == 0 ? cubelib_calc_edge_base_axis(E(e))
+                 : i == 1 ? cubelib_calc_edge_secondary_axis(E(e))
+                          : cubelib_calc_edge_tertiary_axis(E(e));
+        }));
+    tables.push_back(make_table("edge_pushes", "cubelib_edge_t", true, 12, 6,
+        [](std::size_t e, std::size_t d){ return cubelib_calc_edge_push(E(e), D(d)).value; }));
+    tables.push_back(make_table("edge_face_incidence", "bool", false, 12, 6,
+        [](std::size_t e, std::size_t f){ return cubelib_calc_is_face_on_edge(F(f), E(e)); }));
+
+    return tables;
 }
 
 
+std::string to_upper(std::string str)
+{
+    for (auto& c : str)
+        c = char(std::toupper(c));
+    return str;
+}
 
-
+std::string dims_string(const table_t& table)
+{
+    std::string result;
+    for (auto dim : table.dims)
+        result += "[" + std::to_string(dim) + "]";
+    return result;
+}
 
 /**
- * Spits out @c dir_adj_cnrs as raw constants, for use in opencl.
+ * Writes the brace-initializer of @p table, one row per line; each line ends with @p line_end
+ * (a backslash, when the initializer is the body of a macro).
  */
-void generate_dir_adj_cnrs_constants(std::ostream& out)
+void generate_initializer(std::ostream& out, const table_t& table, bool as_elements, const std::string& line_end)
 {
-    out << "#define CUBELIB_FACE_ADJ_CNRS \\" << std::endl;
-    out << "    { \\" << std::endl;
+    std::size_t columns = table.dims.size() > 1 ? table.dims[1] : table.dims[0];
+    std::size_t rows = table.values.size() / columns;
 
-    for (std::size_t facei = 0; facei < 6; ++facei)
-    {
-        cubelib_face_t face = cubelib_all_faces[facei];
-
-        out << "        " << (facei == 0 ? "  " : ", ") << "{ \\" << std::endl;
-        for (std::size_t i = 0; i < 4; ++i)
+    auto row_string = [&](std::size_t row){
+        std::string result = "{";
+        for (std::size_t column = 0; column < columns; ++column)
         {
-            
-            cubelib_corner_t adj_corner = cubelib_calc_corner_on_face(face, i);
-
-            out << "            " << (i == 0 ? "  " : ", ") << "(corner_t){" << adj_corner.value << "}" << " \\" << std::endl;
+            std::string value = std::to_string(table.values[row * columns + column]);
+            result += (column == 0 ? " " : ", ") + (as_elements ? "{" + value + "}" : value);
         }
-        out << "        } \\" << std::endl;
+        return result + " }";
+    };
+
+    if (table.dims.size() == 1)
+    {
+        out << "    " << row_string(0) << std::endl;
+        return;
     }
+
+    for (std::size_t row = 0; row < rows; ++row)
+        out << "    " << (row == 0 ? "{   " : "  , ") << row_string(row) << line_end << std::endl;
     out << "    }" << std::endl;
 }
 
 
 /**
- * Spits out @c (pos/neg)(x/y)face as raw constants, for use in opencl.
+ * Spits out every table as an initializer macro (e.g. @c CUBELIB_OPPOSITE_CORNERS), along with each table's
+ * offset in the @c blob backend's output.
+ *
+ * This is what cubelib.h itself consumes, for every backend; the macros are plain brace-initializers, so they
+ * work for C99 `static const`, C++ `constexpr` and OpenCL `__constant` declarations alike.
  */
-void generate_face_constants(std::ostream& out)
+void generate_macros(std::ostream& out, const std::vector<table_t>& tables)
 {
+    out << "#ifndef CORNER_CASES_CUBELIB_TABLES_H" << std::endl;
+    out << "#define CORNER_CASES_CUBELIB_TABLES_H 1" << std::endl;
+    out << std::endl;
 
+    std::size_t offset = 0;
+    for (const auto& table : tables)
+    {
+        out << std::endl;
+        out << "///@brief Initializer for `" << table.type << " cubelib_" << table.name << dims_string(table) << "`" << std::endl;
+        out << "#define CUBELIB_" << to_upper(table.name) << " \\" << std::endl;
+        generate_initializer(out, table, table.is_element, " \\");
+        out << "#define CUBELIB_BLOB_OFFSET_" << to_upper(table.name) << " " << offset << std::endl;
+        offset += table.values.size();
+    }
+    out << std::endl;
+    out << "///@brief Size in bytes of the blob backend's output" << std::endl;
+    out << "#define CUBELIB_BLOB_SIZE " << offset << std::endl;
+    out << std::endl;
+    out << std::endl;
+
+    out << "#define POSXFACE (cubelib_face_t){" << unsigned(cubelib_get_direction_by_int3(+1, 0, 0).value) << "}" << std::endl;
+    out << "#define NEGXFACE (cubelib_face_t){" << unsigned(cubelib_get_direction_by_int3(-1, 0, 0).value) << "}" << std::endl;
+    out << "#define POSYFACE (cubelib_face_t){" << unsigned(cubelib_get_direction_by_int3( 0,+1, 0).value) << "}" << std::endl;
+    out << "#define NEGYFACE (cubelib_face_t){" << unsigned(cubelib_get_direction_by_int3( 0,-1, 0).value) << "}" << std::endl;
+    out << "#define POSZFACE (cubelib_face_t){" << unsigned(cubelib_get_direction_by_int3( 0, 0,+1).value) << "}" << std::endl;
+    out << "#define NEGZFACE (cubelib_face_t){" << unsigned(cubelib_get_direction_by_int3( 0, 0,-1).value) << "}" << std::endl;
+    out << std::endl;
+    out << "#endif // CORNER_CASES_CUBELIB_TABLES_H" << std::endl;
+}
 
-    out << "#define POSXFACE (cubelib_face_t){" << posxface.value << "}" << std::endl;
-    out << "#define NEGXFACE (cubelib_face_t){" << negxface.value << "}" << std::endl;
-    out << "#define POSYFACE (cubelib_face_t){" << posyface.value << "}" << std::endl;
-    out << "#define NEGYFACE (cubelib_face_t){" << negyface.value << "}" << std::endl;
-    out << "#define POSZFACE (cubelib_face_t){" << poszface.value << "}" << std::endl;
-    out << "#define NEGZFACE (cubelib_face_t){" << negzface.value << "}" << std::endl;
 
+/**
+ * Spits out every table as a standalone array of raw values (one byte per entry), for code that does not
+ * include cubelib.h; @p qualifier and @p byte_type are the backend's, and @p prefix/@p suffix wrap the name.
+ */
+void generate_arrays(std::ostream& out, const std::vector<table_t>& tables
+                   , const std::string& qualifier, const std::string& byte_type
+                   , const std::string& prefix, const std::string& suffix)
+{
+    for (const auto& table : tables)
+    {
+        out << std::endl;
+        out << "    ///@brief `cubelib_" << table.name << dims_string(table) << "`" << std::endl;
+        out << "    " << qualifier << " " << byte_type << " " << prefix << table.name << suffix << dims_string(table) << " =" << std::endl;
+        std::ostringstream initializer;
+        generate_initializer(initializer, table, false, "");
+        std::string line;
+        std::istringstream lines(initializer.str());
+        bool first = true;
+        while (std::getline(lines, line))
+        {
+            if (!first)
+                out << std::endl;
+            out << "    " << line;
+            first = false;
+        }
+        out << ";" << std::endl;
+    }
 }
 
+void generate_c99(std::ostream& out, const std::vector<table_t>& tables)
+{
+    out << "#ifndef CORNER_CASES_CUBELIB_TABLES_C99_H" << std::endl;
+    out << "#define CORNER_CASES_CUBELIB_TABLES_C99_H 1" << std::endl;
+    out << std::endl;
+    out << "#include <stdint.h>" << std::endl;
+    generate_arrays(out, tables, "static const", "uint8_t", "cubelib_", "_values");
+    out << std::endl;
+    out << "#endif // CORNER_CASES_CUBELIB_TABLES_C99_H" << std::endl;
+}
 
+void generate_cxx(std::ostream& out, const std::vector<table_t>& tables)
+{
+    out << "#ifndef CORNER_CASES_CUBELIB_TABLES_HPP" << std::endl;
+    out << "#define CORNER_CASES_CUBELIB_TABLES_HPP 1" << std::endl;
+    out << std::endl;
+    out << "#include <cstdint>" << std::endl;
+    out << std::endl;
+    out << "namespace cubelib_tables{" << std::endl;
+    generate_arrays(out, tables, "constexpr", "std::uint8_t", "", "");
+    out << std::endl;
+    out << "} // namespace cubelib_tables" << std::endl;
+    out << std::endl;
+    out << "#endif // CORNER_CASES_CUBELIB_TABLES_HPP" << std::endl;
+}
 
+void generate_opencl(std::ostream& out, const std::vector<table_t>& tables)
+{
+    out << "#ifndef CORNER_CASES_CUBELIB_TABLES_CL_H" << std::endl;
+    out << "#define CORNER_CASES_CUBELIB_TABLES_CL_H 1" << std::endl;
+    generate_arrays(out, tables, "__constant", "uchar", "cubelib_", "_values");
+    out << std::endl;
+    out << "#endif // CORNER_CASES_CUBELIB_TABLES_CL_H" << std::endl;
+}
 
-int main(int argc, char** argv){
+/**
+ * Spits out every table's raw values, one byte per entry, back to back in the order of all_tables(); the
+ * offset of each table is @c CUBELIB_BLOB_OFFSET_* in the @c macros backend's output.
+ */
+void generate_blob(std::ostream& out, const std::vector<table_t>& tables)
+{
+    for (const auto& table : tables)
+        for (auto value : table.values)
+            out.put(char(value));
+}
 
-    //std::ofstream out("cubelib.gen.h");
-    std::ostream& out = std::cout;
 
-    out << "///Generated via cubelib.cpp" << std::endl;
+void generate_banner(std::ostream& out)
+{
+    out << "///Generated via cubelib-gen-consts.cpp" << std::endl;
     out << "///" << std::endl;
     out << "///" << std::endl;
     out << "///DO NOT MODIFY" << std::endl;
     out << "///MODIFICATIONS WILL BE OVERWRITTEN WHEN THIS FILE IS REGENERATED" << std::endl;
     out << "///EDIT THE GENERATOR IF NECESSARY" << std::endl;
+    out << std::endl;
+}
 
-    for (std::size_t i = 0; i < 5; ++i)
-        out << std::endl;
-
-
-    generate_cnr_adj_cnrs_constants(out);
-
-    for (std::size_t i = 0; i < 5; ++i)
-        out << std::endl;
 
-    generate_dir_adj_cnrs_constants(out);
+/**
+ * Usage: `cubelib-clgen-consts [macros|c99|cxx|opencl|blob] [output-file]`
+ *
+ * The backend defaults to @c macros, and the output to stdout.
+ */
+int main(int argc, char** argv){
 
-    for (std::size_t i = 0; i < 5; ++i)
-        out << std::endl;
+    std::string backend = argc > 1 ? argv[1] : "macros";
 
-    generate_face_constants(out);
+    if (backend != "macros" && backend != "c99" && backend != "cxx" && backend != "opencl" && backend != "blob")
+    {
+        std::cerr << "unknown backend " << backend << "; expected one of macros, c99, cxx, opencl, blob" << std::endl;
+        return 1;
+    }
 
-    for (std::size_t i = 0; i < 5; ++i)
-        out << std::endl;
+    std::ofstream file;
+    if (argc > 2)
+    {
+        file.open(argv[2], std::ios::out | std::ios::binary);
+        if (!file)
+        {
+            std::cerr << "cannot open " << argv[2] << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = argc > 2 ? file : std::cout;
 
-    return 0;
-}
+    std::vector<table_t> tables = all_tables();
 
+    if (backend == "blob")
+    {
+        generate_blob(out, tables);
+        return out ? 0 : 1;
+    }
 
+    generate_banner(out);
 
+    if (backend == "macros")
+        generate_macros(out, tables);
+    else if (backend == "c99")
+        generate_c99(out, tables);
+    else if (backend == "cxx")
+        generate_cxx(out, tables);
+    else if (backend == "opencl")
+        generate_opencl(out, tables);
 
+    return out ? 0 : 1;
+}
@@ -0,0 +1,211 @@
+
+
+
+#include "cubelib/cubelib.h"
+#include "cubelib/batch.h"
+#include "cubelib/formatters.hpp"
+
+#include "gtest/gtest.h"
+
+
+
+#include <vector>
+#include <random>
+#include <cstdint>
+
+
+struct CubelibBatchTest : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        ///every (corner, direction) and (corner, adjacent corner) pair, repeated enough times that the
+        /// SIMD paths get full blocks and a tail; the length is deliberately not a multiple of 16 or 32
+        const std::size_t repeats = 7;
+        for (std::size_t repeat = 0; repeat < repeats; ++repeat)
+        {
+            for (auto corner : cubelib_all_corners)
+            {
+                corners.push_back(corner.value);
+
+                for (auto direction : cubelib_all_directions)
+                {
+                    move_corners.push_back(corner.value);
+                    move_directions.push_back(direction.value);
+                }
+            }
+
+            for (auto edge : cubelib_all_edges)
+            {
+                edges.push_back(edge.value);
+
+                edge_corners0.push_back(cubelib_get_edge_corner0(edge).value);
+                edge_corners1.push_back(cubelib_get_edge_corner1(edge).value);
+
+                ///and the other way around
+                edge_corners0.push_back(cubelib_get_edge_corner1(edge).value);
+                edge_corners1.push_back(cubelib_get_edge_corner0(edge).value);
+            }
+        }
+
+        std::mt19937 generator(1234);
+        std::uniform_real_distribution<float> distribution(-1, 1);
+        for (std::size_t i = 0; i < 1000; ++i)
+        {
+            xs.push_back(distribution(generator));
+            ys.push_back(distribution(generator));
+            zs.push_back(distribution(generator));
+        }
+        ///exact zeros are on the lower side
+        xs[3] = ys[5] = zs[7] = 0;
+    }
+
+    virtual void TearDown() {
+    // Code here will be called immediately after each test
+    // (right before the destructor).
+
+    }
+
+    std::vector<std::uint8_t> corners;
+    std::vector<std::uint8_t> move_corners, move_directions;
+    std::vector<std::uint8_t> edges;
+    std::vector<std::uint8_t> edge_corners0, edge_corners1;
+    std::vector<float> xs, ys, zs;
+};
+
+
+///runs @p expr for every batch path this CPU supports, with `function` bound to the path
+#ifdef CUBELIB_BATCH_HAS_X86_SIMD
+#define CUBELIB_BATCH_TEST_ALL_PATHS(name, test)                                \
+    {                                                                           \
+        auto function = &name##_scalar; test                                    \
+    }                                                                           \
+    {                                                                           \
+        auto function = &name; test                                             \
+    }                                                                           \
+    if (cubelib_batch_detect_isa() >= CUBELIB_BATCH_ISA_SSE42)                  \
+    {                                                                           \
+        auto function = &name##_sse42; test                                     \
+    }                                                                           \
+    if (cubelib_batch_detect_isa() >= CUBELIB_BATCH_ISA_AVX2)                   \
+    {                                                                           \
+        auto function = &name##_avx2; test                                      \
+    }
+#else
+#define CUBELIB_BATCH_TEST_ALL_PATHS(name, test)                                \
+    {                                                                           \
+        auto function = &name##_scalar; test                                    \
+    }                                                                           \
+    {                                                                           \
+        auto function = &name; test                                             \
+    }
+#endif
+
+
+TEST_F(CubelibBatchTest,isa)
+{
+    EXPECT_EQ(cubelib_batch_detect_isa(), cubelib_batch_isa());
+    EXPECT_EQ(cubelib_batch_isa(), cubelib_batch_isa());
+
+#ifndef CUBELIB_BATCH_HAS_X86_SIMD
+    EXPECT_EQ(cubelib_batch_isa(), CUBELIB_BATCH_ISA_SCALAR);
+#endif
+}
+
+
+TEST_F(CubelibBatchTest,get_opposite_corner_n)
+{
+    CUBELIB_BATCH_TEST_ALL_PATHS(cubelib_get_opposite_corner_n, {
+        std::vector<std::uint8_t> result(corners.size(), 0xFF);
+        function(corners.data(), result.data(), corners.size());
+
+        for (std::size_t i = 0; i < corners.size(); ++i)
+        {
+            cubelib_corner_t corner = {corners[i]};
+            ASSERT_EQ(cubelib_get_opposite_corner(corner).value, result[i]);
+        }
+    })
+}
+
+TEST_F(CubelibBatchTest,get_adjacent_corner_n)
+{
+    CUBELIB_BATCH_TEST_ALL_PATHS(cubelib_get_adjacent_corner_n, {
+        std::vector<std::uint8_t> result(move_corners.size(), 0xFF);
+        function(move_corners.data(), move_directions.data(), result.data(), move_corners.size());
+
+        for (std::size_t i = 0; i < move_corners.size(); ++i)
+        {
+            cubelib_corner_t corner = {move_corners[i]};
+            cubelib_direction_t direction = {move_directions[i]};
+            ASSERT_EQ(cubelib_get_adjacent_corner(corner, direction).value, result[i]);
+        }
+    })
+}
+
+TEST_F(CubelibBatchTest,corner_move_n)
+{
+    CUBELIB_BATCH_TEST_ALL_PATHS(cubelib_corner_move_n, {
+        std::vector<std::uint8_t> result(move_corners.size(), 0xFF);
+        function(move_corners.data(), move_directions.data(), result.data(), move_corners.size());
+
+        for (std::size_t i = 0; i < move_corners.size(); ++i)
+        {
+            cubelib_corner_t corner = {move_corners[i]};
+            cubelib_direction_t direction = {move_directions[i]};
+            ASSERT_EQ(cubelib_corner_move(corner, direction).value, result[i]);
+        }
+    })
+}
+
+TEST_F(CubelibBatchTest,get_edge_by_corners_n)
+{
+    CUBELIB_BATCH_TEST_ALL_PATHS(cubelib_get_edge_by_corners_n, {
+        std::vector<std::uint8_t> result(edge_corners0.size(), 0xFF);
+        function(edge_corners0.data(), edge_corners1.data(), result.data(), edge_corners0.size());
+
+        for (std::size_t i = 0; i < edge_corners0.size(); ++i)
+        {
+            cubelib_corner_t corner0 = {edge_corners0[i]};
+            cubelib_corner_t corner1 = {edge_corners1[i]};
+            ASSERT_EQ(cubelib_get_edge_by_corners(corner0, corner1).value, result[i]);
+        }
+    })
+}
+
+TEST_F(CubelibBatchTest,get_opposite_edge_n)
+{
+    CUBELIB_BATCH_TEST_ALL_PATHS(cubelib_get_opposite_edge_n, {
+        std::vector<std::uint8_t> result(edges.size(), 0xFF);
+        function(edges.data(), result.data(), edges.size());
+
+        for (std::size_t i = 0; i < edges.size(); ++i)
+        {
+            cubelib_edge_t edge = {edges[i]};
+            ASSERT_EQ(cubelib_get_opposite_edge(edge).value, result[i]);
+        }
+    })
+}
+
+TEST_F(CubelibBatchTest,get_corner_by_float3_n)
+{
+    CUBELIB_BATCH_TEST_ALL_PATHS(cubelib_get_corner_by_float3_n, {
+        std::vector<std::uint8_t> result(xs.size(), 0xFF);
+        function(xs.data(), ys.data(), zs.data(), result.data(), xs.size());
+
+        for (std::size_t i = 0; i < xs.size(); ++i)
+        {
+            ASSERT_EQ(cubelib_get_corner_by_float3(xs[i], ys[i], zs[i]).value, result[i]);
+        }
+    })
+}
+
+TEST_F(CubelibBatchTest,empty)
+{
+    ///zero-length batches must not touch the arrays
+    CUBELIB_BATCH_TEST_ALL_PATHS(cubelib_get_edge_by_corners_n, {
+        function(nullptr, nullptr, nullptr, 0);
+    })
+    CUBELIB_BATCH_TEST_ALL_PATHS(cubelib_get_corner_by_float3_n, {
+        function(nullptr, nullptr, nullptr, nullptr, 0);
+    })
+}
+
+#undef CUBELIB_BATCH_TEST_ALL_PATHS
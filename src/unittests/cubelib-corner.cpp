@@ -553,6 +553,40 @@ TEST_F(CubelibCornerTest,is_corner_on_face)
 
 
 
+TEST_F(CubelibCornerTest,tables)
+{
+    ///every corner relation table must agree with the arithmetic it caches
+    for (auto corner : cubelib_all_corners)
+    {
+        uint_fast8_t ci = cubelib_get_corner_index(corner);
+        
+        EXPECT_TRUE(cubelib_is_corner_equal(cubelib_opposite_corners[ci], cubelib_calc_opposite_corner(corner)));
+        
+        for (auto direction : cubelib_all_directions)
+        {
+            uint_fast8_t di = cubelib_get_direction_index(direction);
+            
+            EXPECT_TRUE(cubelib_is_corner_equal(cubelib_adjacent_corners[ci][di], cubelib_calc_adjacent_corner(corner, direction)));
+            EXPECT_TRUE(cubelib_is_corner_equal(cubelib_corner_moves[ci][di], cubelib_calc_corner_move(corner, direction)));
+            EXPECT_TRUE(cubelib_is_corner_equal(cubelib_corner_pushes[ci][di], cubelib_calc_corner_push(corner, direction)));
+        }
+        
+        for (auto other : cubelib_all_corners)
+        {
+            uint_fast8_t oi = cubelib_get_corner_index(other);
+            EXPECT_EQ(cubelib_corner_adjacency[ci][oi], cubelib_calc_is_corner_adjacent_corner(corner, other));
+        }
+        
+        for (auto face : cubelib_all_faces)
+        {
+            uint_fast8_t fi = cubelib_get_face_index(face);
+            EXPECT_EQ(cubelib_corner_face_incidence[ci][fi], cubelib_calc_is_corner_on_face(corner, face));
+        }
+    }
+}
+
+
+
 TEST_F(CubelibCornerTest,corner_formatters)
 {
 
@@ -220,6 +220,18 @@ TEST_F(CubelibDirectionTest,get_direction_sigdim)
 }
 
 
+TEST_F(CubelibDirectionTest,tables)
+{
+    ///every direction relation table must agree with the arithmetic it caches
+    for (auto direction : cubelib_all_directions)
+    {
+        uint_fast8_t di = cubelib_get_direction_index(direction);
+        EXPECT_TRUE(cubelib_is_direction_equal(cubelib_opposite_directions[di], cubelib_calc_opposite_direction(direction)));
+    }
+}
+
+
+
 TEST_F(CubelibDirectionTest,direction_formatters)
 {
 
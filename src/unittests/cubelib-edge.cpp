@@ -374,3 +374,65 @@ TEST_F(CubelibEdgeTest,face_on_edge)
         ASSERT_EQ(4U, face_counts[ cubelib_get_face_index(face) ]);
     }
 }
+
+
+
+TEST_F(CubelibEdgeTest,tables)
+{
+    ///every edge relation table must agree with the arithmetic it caches
+    for (auto edge : cubelib_all_edges)
+    {
+        uint_fast8_t ei = cubelib_get_edge_index(edge);
+        
+        EXPECT_TRUE(cubelib_is_edge_equal(cubelib_opposite_edges[ei], cubelib_calc_opposite_edge(edge)));
+        EXPECT_TRUE(cubelib_is_corner_equal(cubelib_edge_corners[ei][0], cubelib_calc_edge_corner0(edge)));
+        EXPECT_TRUE(cubelib_is_corner_equal(cubelib_edge_corners[ei][1], cubelib_calc_edge_corner1(edge)));
+        EXPECT_TRUE(cubelib_is_direction_equal(cubelib_edge_directions[ei], cubelib_calc_edge_direction(edge)));
+        EXPECT_EQ(cubelib_edge_axes[ei][0], cubelib_calc_edge_base_axis(edge));
+        EXPECT_EQ(cubelib_edge_axes[ei][1], cubelib_calc_edge_secondary_axis(edge));
+        EXPECT_EQ(cubelib_edge_axes[ei][2], cubelib_calc_edge_tertiary_axis(edge));
+        
+        for (auto direction : cubelib_all_directions)
+        {
+            uint_fast8_t di = cubelib_get_direction_index(direction);
+            EXPECT_TRUE(cubelib_is_edge_equal(cubelib_edge_pushes[ei][di], cubelib_calc_edge_push(edge, direction)));
+        }
+        
+        for (auto face : cubelib_all_faces)
+        {
+            uint_fast8_t fi = cubelib_get_face_index(face);
+            EXPECT_EQ(cubelib_edge_face_incidence[ei][fi], cubelib_calc_is_face_on_edge(face, edge));
+        }
+    }
+    
+    for (auto corner0 : cubelib_all_corners)
+    {
+        uint_fast8_t ci = cubelib_get_corner_index(corner0);
+        
+        for (auto corner1 : cubelib_all_corners)
+        {
+            cubelib_edge_t edge = cubelib_edges_by_corners[ci][cubelib_get_corner_index(corner1)];
+            
+            ///non-adjacent corners have no edge
+            if (!cubelib_calc_is_corner_adjacent_corner(corner0, corner1))
+            {
+                EXPECT_TRUE(cubelib_is_edge_null(edge));
+                continue;
+            }
+            EXPECT_TRUE(cubelib_is_edge_equal(edge, cubelib_calc_edge_by_corners(corner0, corner1)));
+        }
+        
+        for (auto direction : cubelib_all_directions)
+        {
+            cubelib_edge_t edge = cubelib_edges_by_corner_direction[ci][cubelib_get_direction_index(direction)];
+            
+            ///directions pointing out of the cube have no edge
+            if (cubelib_is_corner_null(cubelib_calc_corner_move(corner0, direction)))
+            {
+                EXPECT_TRUE(cubelib_is_edge_null(edge));
+                continue;
+            }
+            EXPECT_TRUE(cubelib_is_edge_equal(edge, cubelib_calc_edge_by_corner_direction(corner0, direction)));
+        }
+    }
+}
@@ -127,9 +127,16 @@ TEST_F(CubelibFaceTest,edge_on_face)
 
 
 
-
-
-
-
-
-
+TEST_F(CubelibFaceTest,tables)
+{
+    ///every face relation table must agree with the arithmetic it caches
+    for (auto face : cubelib_all_faces)
+    {
+        uint_fast8_t fi = cubelib_get_face_index(face);
+        for (uint_fast8_t i = 0; i < 4; ++i)
+        {
+            EXPECT_TRUE(cubelib_is_corner_equal(cubelib_corners_on_face[fi][i], cubelib_calc_corner_on_face(face, i)));
+            EXPECT_TRUE(cubelib_is_edge_equal(cubelib_edges_on_face[fi][i], cubelib_calc_edge_on_face(face, i)));
+        }
+    }
+}
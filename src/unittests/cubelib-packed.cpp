@@ -0,0 +1,215 @@
+
+
+
+#include "cubelib/cubelib.h"
+#include "cubelib/packed.h"
+#include "cubelib/formatters.hpp"
+
+#include "gtest/gtest.h"
+
+
+
+#include <vector>
+#include <random>
+#include <cstdint>
+#include <algorithm>
+
+
+struct CubelibPackedTest : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        ///lengths around the SIMD block (32) and group (8) sizes, and one spanning several of the typed
+        /// arrays' conversion chunks
+        lengths = {0, 1, 2, 7, 8, 9, 31, 32, 33, 63, 64, 65, 1000};
+    }
+
+    virtual void TearDown() {
+    // Code here will be called immediately after each test
+    // (right before the destructor).
+
+    }
+
+    static std::vector<std::uint8_t> random_indices(std::size_t n, int limit)
+    {
+        std::mt19937 generator(1234 + n);
+        std::uniform_int_distribution<int> distribution(0, limit - 1);
+        std::vector<std::uint8_t> result;
+        for (std::size_t i = 0; i < n; ++i)
+            result.push_back(std::uint8_t(distribution(generator)));
+        return result;
+    }
+
+    std::vector<std::size_t> lengths;
+};
+
+
+TEST_F(CubelibPackedTest,bytes)
+{
+    ASSERT_EQ(0U, CUBELIB_PACKED_BYTES(0, 4));
+    ASSERT_EQ(5U, CUBELIB_PACKED_BYTES(9, 4));
+    ASSERT_EQ(0U, CUBELIB_PACKED_BYTES(0, 3));
+    ASSERT_EQ(3U, CUBELIB_PACKED_BYTES(1, 3));
+    ASSERT_EQ(3U, CUBELIB_PACKED_BYTES(8, 3));
+    ASSERT_EQ(6U, CUBELIB_PACKED_BYTES(9, 3));
+}
+
+TEST_F(CubelibPackedTest,packed4)
+{
+    for (std::size_t n : lengths)
+    {
+        auto indices = random_indices(n, 16);
+
+        std::vector<std::uint8_t> bulk(CUBELIB_PACKED_BYTES(n, 4), 0xFF);
+        cubelib_packed4_pack_n(indices.data(), bulk.data(), n);
+
+        std::vector<std::uint8_t> single(CUBELIB_PACKED_BYTES(n, 4), 0);
+        for (std::size_t i = 0; i < n; ++i)
+            cubelib_packed4_set(single.data(), i, indices[i]);
+        ASSERT_EQ(single, bulk);
+
+        for (std::size_t i = 0; i < n; ++i)
+            ASSERT_EQ(indices[i], cubelib_packed4_get(bulk.data(), i));
+
+        std::vector<std::uint8_t> unpacked(n, 0xFF);
+        cubelib_packed4_unpack_n(bulk.data(), unpacked.data(), n);
+        ASSERT_EQ(indices, unpacked);
+    }
+}
+
+TEST_F(CubelibPackedTest,packed3)
+{
+    for (std::size_t n : lengths)
+    {
+        auto indices = random_indices(n, 8);
+
+        std::vector<std::uint8_t> bulk(CUBELIB_PACKED_BYTES(n, 3), 0xFF);
+        cubelib_packed3_pack_n(indices.data(), bulk.data(), n);
+
+        std::vector<std::uint8_t> single(CUBELIB_PACKED_BYTES(n, 3), 0);
+        for (std::size_t i = 0; i < n; ++i)
+            cubelib_packed3_set(single.data(), i, indices[i]);
+        ASSERT_EQ(single, bulk);
+
+        for (std::size_t i = 0; i < n; ++i)
+            ASSERT_EQ(indices[i], cubelib_packed3_get(bulk.data(), i));
+
+        std::vector<std::uint8_t> unpacked(n, 0xFF);
+        cubelib_packed3_unpack_n(bulk.data(), unpacked.data(), n);
+        ASSERT_EQ(indices, unpacked);
+    }
+}
+
+TEST_F(CubelibPackedTest,layout)
+{
+    std::uint8_t nibbles[2] = {0, 0};
+    cubelib_packed4_set(nibbles, 0, 1);
+    cubelib_packed4_set(nibbles, 1, 6);
+    cubelib_packed4_set(nibbles, 2, 11);
+    ASSERT_EQ(0x61, nibbles[0]);
+    ASSERT_EQ(0x0B, nibbles[1]);
+
+    std::uint8_t triples[3] = {0, 0, 0};
+    cubelib_packed3_set(triples, 0, 1);
+    cubelib_packed3_set(triples, 1, 6);
+    cubelib_packed3_set(triples, 2, 7);
+    cubelib_packed3_set(triples, 7, 5);
+    ///1 | 6 << 3 | 7 << 6 | 5 << 21
+    ASSERT_EQ(0xF1, triples[0]);
+    ASSERT_EQ(0x01, triples[1]);
+    ASSERT_EQ(0xA0, triples[2]);
+}
+
+TEST_F(CubelibPackedTest,corner_array)
+{
+    for (std::uint_fast8_t bits : {3, 4})
+    {
+        std::vector<cubelib_corner_t> corners;
+        for (std::size_t repeat = 0; repeat < 70; ++repeat)
+            for (auto corner : cubelib_all_corners)
+                corners.push_back(corner);
+        std::reverse(corners.begin() + 100, corners.end());
+
+        std::vector<std::uint8_t> bytes(CUBELIB_PACKED_BYTES(corners.size(), bits));
+        cubelib_packed_corner_array_t array = cubelib_packed_corner_array(bytes.data(), corners.size(), bits);
+        cubelib_packed_corner_array_pack(array, corners.data());
+
+        for (std::size_t i = 0; i < corners.size(); ++i)
+            ASSERT_TRUE(cubelib_is_corner_equal(corners[i], cubelib_packed_corner_array_get(array, i)));
+
+        std::vector<cubelib_corner_t> unpacked(corners.size(), cubelib_null_corner);
+        cubelib_packed_corner_array_unpack(array, unpacked.data());
+        for (std::size_t i = 0; i < corners.size(); ++i)
+            ASSERT_TRUE(cubelib_is_corner_equal(corners[i], unpacked[i]));
+
+        cubelib_packed_corner_array_set(array, 5, cubelib_get_corner_by_index(7));
+        ASSERT_TRUE(cubelib_is_corner_equal(cubelib_get_corner_by_index(7), cubelib_packed_corner_array_get(array, 5)));
+        ASSERT_TRUE(cubelib_is_corner_equal(corners[4], cubelib_packed_corner_array_get(array, 4)));
+        ASSERT_TRUE(cubelib_is_corner_equal(corners[6], cubelib_packed_corner_array_get(array, 6)));
+    }
+}
+
+TEST_F(CubelibPackedTest,direction_array)
+{
+    for (std::uint_fast8_t bits : {3, 4})
+    {
+        std::vector<cubelib_direction_t> directions;
+        for (std::size_t repeat = 0; repeat < 70; ++repeat)
+            for (auto direction : cubelib_all_directions)
+                directions.push_back(direction);
+
+        std::vector<std::uint8_t> bytes(CUBELIB_PACKED_BYTES(directions.size(), bits));
+        cubelib_packed_direction_array_t array = cubelib_packed_direction_array(bytes.data(), directions.size(), bits);
+        cubelib_packed_direction_array_pack(array, directions.data());
+
+        std::vector<cubelib_direction_t> unpacked(directions.size(), cubelib_null_direction);
+        cubelib_packed_direction_array_unpack(array, unpacked.data());
+        for (std::size_t i = 0; i < directions.size(); ++i)
+        {
+            ASSERT_TRUE(cubelib_is_direction_equal(directions[i], cubelib_packed_direction_array_get(array, i)));
+            ASSERT_TRUE(cubelib_is_direction_equal(directions[i], unpacked[i]));
+        }
+    }
+}
+
+TEST_F(CubelibPackedTest,edge_array)
+{
+    std::vector<cubelib_edge_t> edges;
+    for (std::size_t repeat = 0; repeat < 70; ++repeat)
+        for (auto edge : cubelib_all_edges)
+            edges.push_back(edge);
+
+    std::vector<std::uint8_t> bytes(CUBELIB_PACKED_BYTES(edges.size(), 4));
+    cubelib_packed_edge_array_t array = cubelib_packed_edge_array(bytes.data(), edges.size());
+    cubelib_packed_edge_array_pack(array, edges.data());
+
+    std::vector<cubelib_edge_t> unpacked(edges.size(), cubelib_null_edge);
+    cubelib_packed_edge_array_unpack(array, unpacked.data());
+    for (std::size_t i = 0; i < edges.size(); ++i)
+    {
+        ASSERT_TRUE(cubelib_is_edge_equal(edges[i], cubelib_packed_edge_array_get(array, i)));
+        ASSERT_TRUE(cubelib_is_edge_equal(edges[i], unpacked[i]));
+    }
+}
+
+TEST_F(CubelibPackedTest,face_array)
+{
+    for (std::uint_fast8_t bits : {3, 4})
+    {
+        std::vector<cubelib_face_t> faces;
+        for (std::size_t repeat = 0; repeat < 70; ++repeat)
+            for (auto face : cubelib_all_faces)
+                faces.push_back(face);
+
+        std::vector<std::uint8_t> bytes(CUBELIB_PACKED_BYTES(faces.size(), bits));
+        cubelib_packed_face_array_t array = cubelib_packed_face_array(bytes.data(), faces.size(), bits);
+        cubelib_packed_face_array_pack(array, faces.data());
+
+        std::vector<cubelib_face_t> unpacked(faces.size(), cubelib_null_face);
+        cubelib_packed_face_array_unpack(array, unpacked.data());
+        for (std::size_t i = 0; i < faces.size(); ++i)
+        {
+            ASSERT_TRUE(cubelib_is_face_equal(faces[i], cubelib_packed_face_array_get(array, i)));
+            ASSERT_TRUE(cubelib_is_face_equal(faces[i], unpacked[i]));
+        }
+    }
+}
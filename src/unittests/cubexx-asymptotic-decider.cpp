@@ -0,0 +1,387 @@
+#include <map>
+#include <set>
+#include <array>
+#include <vector>
+#include <random>
+#include <utility>
+#include <cstdint>
+
+#include "cubexx/cubexx.hpp"
+#include "cubexx/asymptotic_decider.hpp"
+#include "cubexx/grid_index.hpp"
+#include "cubexx/formatters.hpp"
+
+#include "gtest/gtest.h"
+
+
+
+
+
+struct CUBEXXAsymptoticDeciderTest : public ::testing::Test {
+protected:
+    typedef std::pair<std::size_t, std::size_t> side_t;
+
+    virtual void SetUp() {
+    // Code here will be called immediately after the constructor (right
+    // before each test).
+
+    }
+
+    virtual void TearDown() {
+    // Code here will be called immediately after each test
+    // (right before the destructor).
+    
+    }
+
+    ///the index of a triangle's vertex: its edge's, or 12 for the vertex inside the cell
+    static std::size_t vertex_index(const cubexx::edge_t& edge)
+    {
+        return edge.is_null() ? 12 : edge.index();
+    }
+
+    static cubexx::corner_set_t case_of(std::size_t mask)
+    {
+        return cubexx::corner_set_t::from_mask(cubexx::corner_set_t::mask_type(mask));
+    }
+
+    ///every subset of @p faces
+    static std::vector<cubexx::face_set_t> subsets(const cubexx::face_set_t& faces)
+    {
+        std::vector<cubexx::face_set_t> result;
+        for (std::size_t mask = 0; mask < 64; ++mask)
+            if ((mask & faces.mask()) == mask)
+                result.push_back(cubexx::face_set_t::from_mask(cubexx::face_set_t::mask_type(mask)));
+        return result;
+    }
+
+    ///the saddle of the bilinear interpolant on @p face is inside, the slow way
+    static bool saddle_inside(const cubexx::face_t& face, const std::array<float, 8>& values, float isovalue)
+    {
+        ///a, b on one diagonal, c, d on the other
+        const auto& a = face.corners()[0];
+        std::vector<cubexx::corner_t> diagonal, other;
+        for (const auto& corner : face.corners())
+        {
+            std::size_t differing = (a.ux() != corner.ux()) + (a.uy() != corner.uy()) + (a.uz() != corner.uz());
+            (differing == 1 ? other : diagonal).push_back(corner);
+        }
+        float p = values[diagonal[0].index()], q = values[diagonal[1].index()];
+        float r = values[other[0].index()], s = values[other[1].index()];
+        return (p * q - r * s) / (p + q - r - s) < isovalue;
+    }
+};
+
+
+TEST_F(CUBEXXAsymptoticDeciderTest,ambiguous_faces)
+{
+    for (std::size_t mask = 0; mask < 256; ++mask)
+    {
+        auto inside = case_of(mask);
+        auto ambiguous = cubexx::marching_cubes_ambiguous_faces(inside);
+        for (const auto& face : cubexx::face_t::all())
+        {
+            ///all 4 edges crossed, i.e. the corners alternate around the face
+            bool alternating = (face.edge_set() & cubexx::marching_cubes_edges(inside)) == face.edge_set();
+            ASSERT_EQ(alternating, ambiguous.contains(face));
+        }
+    }
+    ///the checkerboards are ambiguous everywhere
+    ASSERT_EQ(6U, cubexx::marching_cubes_ambiguous_faces(case_of(0x69)).size());
+    ASSERT_EQ(6U, cubexx::marching_cubes_ambiguous_faces(case_of(0x96)).size());
+}
+
+TEST_F(CUBEXXAsymptoticDeciderTest,tables)
+{
+    std::size_t most = 0;
+    ///the segments each face gets, by the face, its inside corners, and whether they are connected
+    std::map<std::array<std::size_t, 3>, std::set<side_t> > segments;
+    for (std::size_t mask = 0; mask < 256; ++mask)
+    {
+        auto inside = case_of(mask);
+        auto edges = cubexx::marching_cubes_edges(inside);
+
+        ///separating every ambiguous face is the plain table
+        cubexx::face_set_t none;
+        ASSERT_EQ(cubexx::marching_cubes_triangle_count(inside), cubexx::marching_cubes_triangle_count(inside, none));
+        for (std::size_t i = 0; i < cubexx::marching_cubes_triangle_count(inside); ++i)
+            ASSERT_EQ(cubexx::marching_cubes_triangle(inside, i), cubexx::marching_cubes_triangle(inside, none, i));
+
+        for (const auto& connected : subsets(cubexx::marching_cubes_ambiguous_faces(inside)))
+        {
+            std::size_t count = cubexx::marching_cubes_triangle_count(inside, connected);
+            most = std::max(most, count);
+
+            std::set<side_t> sides;
+            cubexx::edge_set_t used, centered;
+            auto center = cubexx::marching_cubes_center_edges(inside, connected);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                auto triangle = cubexx::marching_cubes_triangle(inside, connected, i);
+                for (std::size_t j = 0; j < 3; ++j)
+                {
+                    ASSERT_TRUE(sides.insert(side_t(vertex_index(triangle[j]),
+                                                    vertex_index(triangle[(j + 1) % 3]))).second);
+                    if (triangle[j].is_null())
+                    {
+                        ///fanned around the vertex inside the cell: the other two are a segment of its loop
+                        centered |= triangle[(j + 1) % 3];
+                        centered |= triangle[(j + 2) % 3];
+                        continue;
+                    }
+                    ASSERT_TRUE(edges.contains(triangle[j]));
+                    used |= triangle[j];
+                }
+            }
+            ASSERT_EQ(edges, used);
+            ASSERT_EQ(center, centered);
+
+            ///the sides not shared inside the cell are on its faces
+            for (const auto& side : sides)
+            {
+                if (sides.count(side_t(side.second, side.first)))
+                    continue;
+                ASSERT_NE(12U, side.first);
+                ASSERT_NE(12U, side.second);
+                const auto& a = cubexx::edge_t::get(std::uint_fast8_t(side.first));
+                const auto& b = cubexx::edge_t::get(std::uint_fast8_t(side.second));
+                bool on_a_face = false;
+                for (const auto& face : cubexx::face_t::all())
+                {
+                    if (!face.edge_set().contains(a) || !face.edge_set().contains(b))
+                        continue;
+                    on_a_face = true;
+                    std::array<std::size_t, 3> key = {{face.index(), (face.corner_set() & inside).mask(),
+                                                       connected.contains(face)}};
+                    segments[key].insert(side_t(std::min(side.first, side.second), std::max(side.first, side.second)));
+                }
+                ASSERT_TRUE(on_a_face);
+            }
+        }
+    }
+    ASSERT_EQ(most, cubexx::marching_cubes_max_decided_triangles());
+
+    ///a face's segments depend only on the face, so cells sharing it agree
+    for (const auto& entry : segments)
+    {
+        const auto& face = cubexx::face_t::get(std::uint_fast8_t(entry.first[0]));
+        auto on_face = case_of(entry.first[1]);
+        ASSERT_EQ((face.edge_set() & cubexx::marching_cubes_edges(on_face)).size(), 2 * entry.second.size());
+    }
+}
+
+TEST_F(CUBEXXAsymptoticDeciderTest,chords)
+{
+    ///no side inside the cell crosses one of its faces, where it could cross or overlap the neighbor's; so no
+    /// triangle lies flat on a face either. The loops around tunnels that cannot be split so are fanned around the
+    /// vertex inside the cell
+    std::size_t triangles = 0, centers = 0;
+    for (std::size_t mask = 0; mask < 256; ++mask)
+    {
+        auto inside = case_of(mask);
+        for (const auto& connected : subsets(cubexx::marching_cubes_ambiguous_faces(inside)))
+        {
+            std::set<side_t> sides;
+            for (std::size_t i = 0; i < cubexx::marching_cubes_triangle_count(inside, connected); ++i)
+            {
+                auto triangle = cubexx::marching_cubes_triangle(inside, connected, i);
+                for (std::size_t j = 0; j < 3; ++j)
+                    sides.insert(side_t(vertex_index(triangle[j]), vertex_index(triangle[(j + 1) % 3])));
+                ++triangles;
+            }
+            for (const auto& side : sides)
+            {
+                ///the sides used one way only are the segments on the faces
+                if (side.first == 12 || side.second == 12 || !sides.count(side_t(side.second, side.first)))
+                    continue;
+                for (const auto& face : cubexx::face_t::all())
+                {
+                    const auto& on = face.edge_set();
+                    ASSERT_FALSE(on.contains(cubexx::edge_t::get(std::uint_fast8_t(side.first)))
+                                 && on.contains(cubexx::edge_t::get(std::uint_fast8_t(side.second))))
+                        << "case " << mask << ", connected " << int(connected.mask()) << ", side " << side.first
+                        << "-" << side.second;
+                }
+            }
+            centers += !cubexx::marching_cubes_center_edges(inside, connected).empty();
+        }
+    }
+    ASSERT_EQ(3436U, triangles);
+    ASSERT_EQ(116U, centers);
+}
+
+TEST_F(CUBEXXAsymptoticDeciderTest,decider)
+{
+    std::mt19937 generator(1234);
+    std::uniform_real_distribution<float> distribution(-1, 1);
+    std::size_t decided = 0;
+    for (std::size_t i = 0; i < 2000; ++i)
+    {
+        std::array<float, 8> values;
+        cubexx::corner_set_t inside;
+        for (const auto& corner : cubexx::corner_t::all())
+        {
+            values[corner.index()] = distribution(generator);
+            if (values[corner.index()] < 0.125f)
+                inside |= corner;
+        }
+        auto connected = cubexx::asymptotic_decider(inside, values, 0.125f);
+        for (const auto& face : cubexx::face_t::all())
+        {
+            bool ambiguous = cubexx::marching_cubes_ambiguous_faces(inside).contains(face);
+            ASSERT_EQ(ambiguous && saddle_inside(face, values, 0.125f), connected.contains(face));
+            decided += connected.contains(face);
+        }
+    }
+    ///both ways happen
+    ASSERT_LT(0U, decided);
+
+    ///a face with its inside corners deep inside connects them; barely inside, they are separated
+    std::array<float, 8> deep = {{-4, 1, 1, -4, 1, 1, 1, 1}}, shallow = {{-0.1f, 1, 1, -0.1f, 1, 1, 1, 1}};
+    auto inside = case_of(0x09);
+    const auto& bottom = cubexx::face_t::get(cubexx::direction_t::get(0, 0, -1));
+    ASSERT_TRUE(cubexx::marching_cubes_ambiguous_faces(inside).contains(bottom));
+    ASSERT_TRUE(cubexx::asymptotic_decider(inside, deep, 0).contains(bottom));
+    ASSERT_FALSE(cubexx::asymptotic_decider(inside, shallow, 0).contains(bottom));
+}
+
+TEST_F(CUBEXXAsymptoticDeciderTest,row)
+{
+    std::mt19937 generator(4321);
+    std::uniform_real_distribution<float> distribution(-1, 1);
+    for (std::size_t n : {0, 3, 4, 37})
+    {
+        std::vector<float> values[4];
+        const float* rows[4];
+        for (std::size_t r = 0; r < 4; ++r)
+        {
+            for (std::size_t x = 0; x < n + 1; ++x)
+                values[r].push_back(distribution(generator));
+            rows[r] = values[r].data();
+        }
+        std::vector<std::uint8_t> cases(n), connected(n + 1, 0xFF);
+        cubexx::marching_cubes_classify_row(rows, n, 0.f, cases.data());
+        cubexx::asymptotic_decider_row(rows, n, 0.f, cases.data(), connected.data());
+
+        for (std::size_t x = 0; x < n; ++x)
+        {
+            std::array<float, 8> corners;
+            for (const auto& corner : cubexx::corner_t::all())
+                corners[corner.index()] = values[corner.uy() + 2 * corner.uz()][x + corner.ux()];
+            ASSERT_EQ(cubexx::asymptotic_decider(case_of(cases[x]), corners, 0.f).mask(), connected[x]);
+        }
+        ASSERT_EQ(0xFF, connected[n]);
+    }
+}
+
+TEST_F(CUBEXXAsymptoticDeciderTest,watertight)
+{
+    ///a random field over a grid of cells, cut with the decided tables, is closed but for the grid's boundary
+    const std::size_t n = 6;
+    cubexx::grid_index_t grid(n, n, n);
+    std::mt19937 generator(99);
+    std::uniform_real_distribution<float> distribution(-1, 1);
+    std::vector<float> samples((n + 1) * (n + 1) * (n + 1));
+    for (auto& sample : samples)
+        sample = distribution(generator);
+
+    std::set<side_t> sides;
+    std::size_t connections = 0, centers = 0;
+    ///the sides each cell has on each grid face, by the face's id and the cell's
+    std::map<std::size_t, std::map<std::size_t, std::set<side_t> > > on_faces;
+    std::map<std::size_t, std::pair<std::array<std::size_t, 3>, std::size_t> > edges;
+    for (std::size_t z = 0; z < n; ++z)
+        for (std::size_t y = 0; y < n; ++y)
+            for (std::size_t x = 0; x < n; ++x)
+            {
+                std::array<float, 8> values;
+                cubexx::corner_set_t inside;
+                for (const auto& corner : cubexx::corner_t::all())
+                {
+                    values[corner.index()]
+                        = samples[(x + corner.ux()) + (n + 1) * ((y + corner.uy()) + (n + 1) * (z + corner.uz()))];
+                    if (values[corner.index()] < 0)
+                        inside |= corner;
+                }
+                for (const auto& edge : cubexx::edge_t::all())
+                {
+                    std::array<std::size_t, 3> lower = {{x + edge.corner0().ux(), y + edge.corner0().uy(),
+                                                         z + edge.corner0().uz()}};
+                    edges[grid.edge_id(x, y, z, edge)] = std::make_pair(lower, std::size_t(edge.base_axis()));
+                }
+
+                auto connected = cubexx::asymptotic_decider(inside, values, 0);
+                connections += connected.size();
+                centers += !cubexx::marching_cubes_center_edges(inside, connected).empty();
+
+                ///the cell's own sides; the fan's diagonals come in both directions and are dropped, the rest are the
+                /// segments on the cell's faces, which the neighbors must match. The vertex inside the cell is
+                /// numbered after the edges
+                auto vertex_id = [&](const cubexx::edge_t& edge) -> std::size_t {
+                    return edge.is_null() ? grid.edge_count() + grid.cell_id(x, y, z) : grid.edge_id(x, y, z, edge);
+                };
+                std::set<side_t> own;
+                for (std::size_t i = 0; i < cubexx::marching_cubes_triangle_count(inside, connected); ++i)
+                {
+                    auto triangle = cubexx::marching_cubes_triangle(inside, connected, i);
+                    for (std::size_t j = 0; j < 3; ++j)
+                    {
+                        const auto& a = triangle[j];
+                        const auto& b = triangle[(j + 1) % 3];
+                        ASSERT_TRUE(own.insert(side_t(vertex_id(a), vertex_id(b))).second);
+                        if (a.is_null() || b.is_null())
+                            continue;
+                        for (const auto& face : cubexx::face_t::all())
+                        {
+                            if (face.edge_set().contains(a) && face.edge_set().contains(b))
+                                on_faces[grid.face_id(x, y, z, face)][grid.cell_id(x, y, z)].insert(
+                                    side_t(vertex_id(a), vertex_id(b)));
+                        }
+                    }
+                }
+                for (const auto& side : own)
+                {
+                    if (!own.count(side_t(side.second, side.first)))
+                    {
+                        ASSERT_TRUE(sides.insert(side).second);
+                    }
+                }
+            }
+    ASSERT_LT(0U, connections);
+
+    ///a side on a face shared by two cells is that face's segment: each cell has it once, one way, and the other cell
+    /// the other way; a side across the face, or overlapping the neighbor's, would break that
+    for (const auto& face : on_faces)
+    {
+        for (const auto& cell : face.second)
+        {
+            for (const auto& side : cell.second)
+            {
+                side_t reversed(side.second, side.first);
+                ASSERT_EQ(0U, cell.second.count(reversed));
+                for (const auto& other : face.second)
+                {
+                    if (other.first != cell.first)
+                    {
+                        ASSERT_EQ(1U, other.second.count(reversed));
+                    }
+                }
+            }
+        }
+    }
+    ///and some tunnels were fanned around the vertex inside their cell
+    ASSERT_LT(0U, centers);
+
+    for (const auto& side : sides)
+    {
+        if (sides.count(side_t(side.second, side.first)))
+            continue;
+        ///both ends on the same outer face of the grid
+        const auto& a = edges[side.first];
+        const auto& b = edges[side.second];
+        bool boundary = false;
+        for (std::size_t k = 0; k < 3; ++k)
+            for (std::size_t bound : {std::size_t(0), n})
+                boundary = boundary || (a.second != k && b.second != k && a.first[k] == bound && b.first[k] == bound);
+        ASSERT_TRUE(boundary);
+    }
+}
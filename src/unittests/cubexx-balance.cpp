@@ -0,0 +1,193 @@
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cstdint>
+
+#include "cubexx/cubexx.hpp"
+#include "cubexx/balance.hpp"
+#include "cubexx/formatters.hpp"
+
+#include "gtest/gtest.h"
+
+
+
+
+
+struct CUBEXXBalanceTest : public ::testing::Test {
+protected:
+    typedef cubexx::morton_code_t<6> code_t;
+    typedef cubexx::linear_octree_t<std::size_t, 6> octree_t;
+
+    virtual void SetUp() {
+        ///refined all the way down around one point, and nowhere else; as unbalanced as a tree gets
+        std::vector<code_t> codes;
+        refine_around(code_t::root(), code_t::encode(5, 40, 17), codes);
+        pointy = make(codes);
+
+        ///a random, unevenly refined tree, with some cells left out
+        codes.clear();
+        std::mt19937 generator(1234);
+        subdivide(code_t::root(), generator, codes);
+        ragged = make(codes);
+    }
+
+    virtual void TearDown() {
+    // Code here will be called immediately after each test
+    // (right before the destructor).
+    
+    }
+
+    static octree_t make(const std::vector<code_t>& codes)
+    {
+        std::vector<std::size_t> values;
+        for (const auto& code : codes)
+            values.push_back(code.bits());
+        return octree_t(codes, values);
+    }
+
+    static void refine_around(const code_t& code, const code_t& point, std::vector<code_t>& codes)
+    {
+        if (!code.contains(point) || code.level() == code_t::MAX_DEPTH())
+        {
+            codes.push_back(code);
+            return;
+        }
+        for (auto corner : cubexx::corner_t::all())
+            refine_around(code.child(corner), point, codes);
+    }
+
+    static void subdivide(const code_t& code, std::mt19937& generator, std::vector<code_t>& codes)
+    {
+        std::uniform_int_distribution<int> distribution(0, 19);
+        int roll = distribution(generator);
+        if (code.level() == code_t::MAX_DEPTH() || (code.level() > 0 && roll < 15))
+            codes.push_back(code);
+        else if (roll == 15 && code.level() > 0)
+            return;
+        else
+            for (auto corner : cubexx::corner_t::all())
+                subdivide(code.child(corner), generator, codes);
+    }
+
+    ///balance, the slow way: the closed boxes of every pair of leaves, in units of the deepest cells
+    static bool brute_force_balanced(const octree_t& octree, cubexx::adjacency_t adjacency)
+    {
+        ///how many axes two boxes must overlap on (rather than just touch) to be neighbors
+        const int overlapping = adjacency == cubexx::adjacency_t::face ? 2 : adjacency == cubexx::adjacency_t::edge ? 1 : 0;
+        for (std::size_t i = 0; i < octree.size(); ++i)
+        {
+            for (std::size_t j = i + 1; j < octree.size(); ++j)
+            {
+                const code_t& a = octree.code(i);
+                const code_t& b = octree.code(j);
+                if (a.level() + 1 >= b.level() && b.level() + 1 >= a.level())
+                    continue;
+
+                auto axyz = a.decode(), bxyz = b.decode();
+                std::int64_t asize = 1 << (6 - a.level()), bsize = 1 << (6 - b.level());
+                int overlaps = 0;
+                bool touching = true;
+                for (std::size_t k = 0; k < 3; ++k)
+                {
+                    std::int64_t overlap = std::min(axyz[k] * asize + asize, bxyz[k] * bsize + bsize)
+                                         - std::max(axyz[k] * asize, bxyz[k] * bsize);
+                    touching = touching && overlap >= 0;
+                    overlaps += overlap > 0;
+                }
+                if (touching && overlaps >= overlapping)
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    ///each leaf of @p balanced is within a leaf of @p original, holding its value, and they cover the same volume
+    static void check_refines(const octree_t& original, const octree_t& balanced)
+    {
+        std::uint64_t original_volume = 0, balanced_volume = 0;
+        for (auto leaf : original)
+            original_volume += octree_t::span(leaf.first);
+        for (auto leaf : balanced)
+        {
+            balanced_volume += octree_t::span(leaf.first);
+            std::size_t i = original.locate(leaf.first);
+            ASSERT_NE(original.size(), i);
+            ASSERT_EQ(original.value(i), leaf.second);
+        }
+        ASSERT_EQ(original_volume, balanced_volume);
+    }
+
+    octree_t pointy, ragged;
+};
+
+
+TEST_F(CUBEXXBalanceTest,balance)
+{
+    cubexx::thread_pool_t pool(3);
+    for (const octree_t* octree : {&pointy, &ragged})
+    {
+        std::size_t previous_size = 0;
+        for (auto adjacency : {cubexx::adjacency_t::face, cubexx::adjacency_t::edge, cubexx::adjacency_t::corner})
+        {
+            ASSERT_FALSE(cubexx::is_balanced(*octree, adjacency));
+            ASSERT_FALSE(brute_force_balanced(*octree, adjacency));
+
+            octree_t balanced = cubexx::balance(*octree, adjacency, pool);
+            ASSERT_TRUE(cubexx::is_balanced(balanced, adjacency));
+            ASSERT_TRUE(brute_force_balanced(balanced, adjacency));
+            check_refines(*octree, balanced);
+
+            ///each relation includes the last, so needs at least as many leaves
+            ASSERT_LE(previous_size, balanced.size());
+            previous_size = balanced.size();
+
+            ///balancing a balanced tree does nothing
+            octree_t again = cubexx::balance(balanced, adjacency, pool);
+            ASSERT_EQ(balanced.size(), again.size());
+            for (std::size_t i = 0; i < balanced.size(); ++i)
+                ASSERT_EQ(balanced.code(i), again.code(i));
+
+            ///however many threads do it
+            cubexx::thread_pool_t single(1);
+            octree_t expected = cubexx::balance(*octree, adjacency, single);
+            ASSERT_EQ(expected.size(), balanced.size());
+            for (std::size_t i = 0; i < balanced.size(); ++i)
+                ASSERT_EQ(expected.code(i), balanced.code(i));
+        }
+    }
+}
+
+TEST_F(CUBEXXBalanceTest,minimal)
+{
+    ///a leaf next to a deep corner of the root only needs the levels in between
+    cubexx::thread_pool_t pool(2);
+    octree_t balanced = cubexx::balance(pointy, cubexx::adjacency_t::corner, pool);
+
+    ///every leaf that was split had a neighbor two or more levels deeper; so removing any split breaks balance,
+    /// which shows as some leaf of the balanced tree having a neighbor exactly one level deeper
+    std::size_t split = 0;
+    for (auto leaf : balanced)
+        split += pointy.code(pointy.locate(leaf.first)) != leaf.first;
+    ASSERT_LT(0U, split);
+
+    for (auto leaf : balanced)
+    {
+        if (pointy.code(pointy.locate(leaf.first)) == leaf.first || leaf.first.is_root())
+            continue;
+        ///the parent of a new leaf was needed: some cell next to it is at least two levels deeper than it
+        code_t parent = leaf.first.parent();
+        bool needed = false;
+        cubexx::detail::for_each_adjacent(parent, cubexx::adjacency_t::corner, [&](const code_t& cell){
+            for (auto other : balanced)
+                needed = needed || (cell.contains(other.first) && other.first.level() >= parent.level() + 2);
+        });
+        ASSERT_TRUE(needed);
+    }
+}
+
+TEST_F(CUBEXXBalanceTest,empty)
+{
+    cubexx::thread_pool_t pool(2);
+    ASSERT_TRUE(cubexx::balance(octree_t(), cubexx::adjacency_t::face, pool).empty());
+    ASSERT_TRUE(cubexx::is_balanced(octree_t(), cubexx::adjacency_t::corner));
+}
@@ -0,0 +1,101 @@
+#include <set>
+#include <cstdint>
+
+#include "cubexx/cubexx.hpp"
+#include "cubexx/canonicalize.hpp"
+#include "cubexx/formatters.hpp"
+
+#include "gtest/gtest.h"
+
+
+
+
+
+struct CUBEXXCanonicalizeTest : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+    // Code here will be called immediately after the constructor (right
+    // before each test).
+
+    }
+
+    virtual void TearDown() {
+    // Code here will be called immediately after each test
+    // (right before the destructor).
+    
+    }
+
+    static bool in_group(const cubexx::cube_symmetry_t& symmetry, cubexx::cube_symmetry_group_t group)
+    {
+        return group == cubexx::cube_symmetry_group_t::all || symmetry.is_rotation();
+    }
+
+    /**
+     * Checks every set of the type, of masks `[0, Size)`, against the orbits worked out the slow way; returns the
+     * number of canonical forms.
+     */
+    template<typename set_t, std::size_t Size>
+    static std::size_t check(cubexx::cube_symmetry_group_t group)
+    {
+        std::set<std::size_t> canonical;
+        for (std::size_t mask = 0; mask < Size; ++mask)
+        {
+            auto set = set_t::from_mask(typename set_t::mask_type(mask));
+            auto form = cubexx::canonicalize(set, group);
+            EXPECT_TRUE(in_group(form.symmetry, group));
+            EXPECT_EQ(form.set, form.symmetry(set));
+            EXPECT_EQ(set, form.symmetry.inverse()(form.set));
+            canonical.insert(form.set.mask());
+
+            ///the lowest of the orbit, and the first symmetry to reach it
+            std::size_t lowest = mask, first = 0;
+            for (const auto& symmetry : cubexx::cube_symmetry_t::all())
+            {
+                if (!in_group(symmetry, group))
+                    continue;
+                std::size_t image = symmetry(set).mask();
+                if (image < lowest)
+                {
+                    lowest = image;
+                    first = symmetry.index();
+                }
+            }
+            EXPECT_EQ(lowest, form.set.mask());
+            EXPECT_EQ(first, form.symmetry.index());
+
+            ///the canonical form is its own
+            EXPECT_EQ(form.set, cubexx::canonicalize(form.set, group).set);
+            EXPECT_EQ(cubexx::cube_symmetry_t::identity(), cubexx::canonicalize(form.set, group).symmetry);
+        }
+        return canonical.size();
+    }
+};
+
+static_assert(cubexx::canonicalize(cubexx::corner_set_t()).set.empty(), "the tables are constexpr");
+
+
+TEST_F(CUBEXXCanonicalizeTest,corner_sets)
+{
+    ASSERT_EQ(23U, (check<cubexx::corner_set_t, 256>(cubexx::cube_symmetry_group_t::rotations)));
+    ASSERT_EQ(22U, (check<cubexx::corner_set_t, 256>(cubexx::cube_symmetry_group_t::all)));
+
+    ///a single corner, wherever it is, is the first corner
+    for (const auto& corner : cubexx::corner_t::all())
+    {
+        auto form = cubexx::canonicalize(cubexx::corner_set_t(corner));
+        ASSERT_EQ(cubexx::corner_set_t(cubexx::corner_t::get(std::uint_fast8_t(0))), form.set);
+        ASSERT_EQ(cubexx::corner_t::get(std::uint_fast8_t(0)), form.symmetry(corner));
+    }
+}
+
+TEST_F(CUBEXXCanonicalizeTest,edge_sets)
+{
+    ASSERT_EQ(218U, (check<cubexx::edge_set_t, 4096>(cubexx::cube_symmetry_group_t::rotations)));
+    ASSERT_EQ(144U, (check<cubexx::edge_set_t, 4096>(cubexx::cube_symmetry_group_t::all)));
+}
+
+TEST_F(CUBEXXCanonicalizeTest,face_sets)
+{
+    ASSERT_EQ(10U, (check<cubexx::face_set_t, 64>(cubexx::cube_symmetry_group_t::rotations)));
+    ASSERT_EQ(10U, (check<cubexx::face_set_t, 64>(cubexx::cube_symmetry_group_t::all)));
+}
@@ -5,6 +5,7 @@
 #include <set>
 #include <map>
 #include <tuple>
+#include <numeric>
 
 #include "cubexx/cubexx.hpp"
 #include "cubexx/formatters.hpp"
@@ -1310,3 +1311,58 @@ TEST_F(CUBEXXCornerTest,corner_set)
 
 
 
+
+
+TEST_F(CUBEXXCornerTest,constexpr_relations)
+{
+    static_assert(std::is_literal_type<cubexx::corner_t>::value, "corner_t should be a literal type");
+    static_assert(std::is_literal_type<cubexx::corner_set_t>::value, "corner_set_t should be a literal type");
+    
+    constexpr const cubexx::corner_t& corner = cubexx::corner_t::get(-1,-1,+1);
+    
+    static_assert(corner.opposite() == cubexx::corner_t::get(+1,+1,-1), "");
+    static_assert(corner.adjacent_set().size() == 3, "");
+    static_assert(!corner.adjacent_set().contains(corner), "");
+    static_assert(corner.opposite().edges()[0].corner_set().contains(corner.opposite()), "");
+    static_assert(corner.edge(corner.adjacents()[2]) == corner.edges()[2], "");
+    static_assert((corner.face_set() & corner.opposite().face_set()).size() == 0, "");
+    
+    constexpr cubexx::corner_set_t corner_set = cubexx::corner_set_t(corner) | corner.opposite();
+    static_assert(corner_set.size() == 2, "");
+    static_assert((corner_set - corner) == cubexx::corner_set_t(corner.opposite()), "");
+    
+    ASSERT_EQ(corner.index(), 4U);
+}
+
+
+TEST_F(CUBEXXCornerTest,corner_set_mask_algebra)
+{
+    static_assert((~cubexx::corner_set_t()).size() == 8, "");
+    static_assert(cubexx::corner_set_t::from_mask(0x81).first() == cubexx::corner_t::get(0), "");
+    static_assert((cubexx::corner_set_t::from_mask(0x0F) - cubexx::corner_set_t::from_mask(0x3C)).mask() == 0x03, "");
+    static_assert(*cubexx::corner_set_t::from_mask(0x40).begin() == cubexx::corner_t::get(6), "");
+    
+    for (uint32_t combo = 0; combo < 256; ++combo)
+    {
+        auto corner_set = cubexx::corner_set_t::from_mask(combo);
+        
+        ASSERT_EQ(combo, corner_set.mask());
+        ASSERT_EQ(combo, corner_set.bits().to_ulong());
+        ASSERT_EQ(combo == 0, corner_set.empty());
+        ASSERT_EQ(cubexx::corner_set_t::from_mask(~combo & 0xFF), ~corner_set);
+        ASSERT_EQ(cubexx::corner_set_t(), corner_set & ~corner_set);
+        ASSERT_EQ(cubexx::corner_set_t::from_mask(0xFF), corner_set | ~corner_set);
+        
+        std::size_t k = 0;
+        for (auto corner : corner_set)
+        {
+            if (k == 0)
+            {
+                ASSERT_EQ(corner_set.first(), corner);
+            }
+            ASSERT_EQ(corner_set.nth(k), corner);
+            ++k;
+        }
+        ASSERT_EQ(corner_set.size(), k);
+    }
+}
@@ -0,0 +1,194 @@
+#include <set>
+#include <array>
+#include <cstdint>
+
+#include "cubexx/cubexx.hpp"
+#include "cubexx/cube_symmetry.hpp"
+#include "cubexx/formatters.hpp"
+
+#include "gtest/gtest.h"
+
+
+
+
+
+struct CUBEXXCubeSymmetryTest : public ::testing::Test {
+protected:
+    typedef cubexx::cube_symmetry_t symmetry_t;
+
+    virtual void SetUp() {
+    // Code here will be called immediately after the constructor (right
+    // before each test).
+
+    }
+
+    virtual void TearDown() {
+    // Code here will be called immediately after each test
+    // (right before the destructor).
+    
+    }
+
+    ///where @p symmetry takes @p corner, worked out from its coordinates and the images of the axes
+    static const cubexx::corner_t& image(const symmetry_t& symmetry, const cubexx::corner_t& corner)
+    {
+        const cubexx::direction_t* axes[3] = {&symmetry(cubexx::direction_t::get(1, 0, 0)),
+                                              &symmetry(cubexx::direction_t::get(0, 1, 0)),
+                                              &symmetry(cubexx::direction_t::get(0, 0, 1))};
+        const int coordinates[3] = {corner.ux(), corner.uy(), corner.uz()};
+        int xyz[3] = {0, 0, 0};
+        for (std::size_t j = 0; j < 3; ++j)
+        {
+            const cubexx::direction_t& axis = *axes[j];
+            xyz[axis.axis()] = axis.positive() ? coordinates[j] : 1 - coordinates[j];
+        }
+        return cubexx::corner_t::get(std::int_fast8_t(xyz[0] ? 1 : -1), std::int_fast8_t(xyz[1] ? 1 : -1),
+                                     std::int_fast8_t(xyz[2] ? 1 : -1));
+    }
+
+    static int determinant(const symmetry_t& symmetry)
+    {
+        const auto& x = symmetry(cubexx::direction_t::get(1, 0, 0)).xyz();
+        const auto& y = symmetry(cubexx::direction_t::get(0, 1, 0)).xyz();
+        const auto& z = symmetry(cubexx::direction_t::get(0, 0, 1)).xyz();
+        return x[0] * (y[1] * z[2] - y[2] * z[1]) - x[1] * (y[0] * z[2] - y[2] * z[0]) + x[2] * (y[0] * z[1] - y[1] * z[0]);
+    }
+};
+
+static_assert(sizeof(cubexx::cube_symmetry_t) == 1, "one byte");
+static_assert(cubexx::cube_symmetry_t::get(17).inverse() * cubexx::cube_symmetry_t::get(17)
+              == cubexx::cube_symmetry_t::identity(), "the tables are constexpr");
+
+
+TEST_F(CUBEXXCubeSymmetryTest,all)
+{
+    ASSERT_EQ(48U, symmetry_t::all().size());
+    ASSERT_EQ(symmetry_t::identity(), symmetry_t::all()[0]);
+    ASSERT_EQ(symmetry_t(), symmetry_t::identity());
+
+    std::set<std::array<std::size_t, 8> > permutations;
+    std::size_t rotations = 0;
+    for (std::size_t i = 0; i < symmetry_t::SIZE(); ++i)
+    {
+        const symmetry_t& symmetry = symmetry_t::all()[i];
+        ASSERT_EQ(i, symmetry.index());
+        ASSERT_EQ(symmetry, symmetry_t::get(std::uint_fast8_t(i)));
+
+        std::array<std::size_t, 8> permutation;
+        for (const auto& corner : cubexx::corner_t::all())
+            permutation[corner.index()] = symmetry(corner).index();
+        permutations.insert(permutation);
+
+        ASSERT_EQ(determinant(symmetry) > 0, symmetry.is_rotation());
+        rotations += symmetry.is_rotation();
+    }
+    ///all distinct
+    ASSERT_EQ(48U, permutations.size());
+    ASSERT_EQ(24U, rotations);
+}
+
+TEST_F(CUBEXXCubeSymmetryTest,get)
+{
+    for (const auto& x : cubexx::direction_t::all())
+    {
+        for (const auto& y : cubexx::direction_t::all())
+        {
+            for (const auto& z : cubexx::direction_t::all())
+            {
+                if (x.axis() == y.axis() || y.axis() == z.axis() || z.axis() == x.axis())
+                    continue;
+                symmetry_t symmetry = symmetry_t::get(x, y, z);
+                ASSERT_EQ(x, symmetry(cubexx::direction_t::get(1, 0, 0)));
+                ASSERT_EQ(y, symmetry(cubexx::direction_t::get(0, 1, 0)));
+                ASSERT_EQ(z, symmetry(cubexx::direction_t::get(0, 0, 1)));
+            }
+        }
+    }
+    ASSERT_EQ(symmetry_t::identity(), symmetry_t::get(cubexx::direction_t::get(1, 0, 0), cubexx::direction_t::get(0, 1, 0),
+                                                      cubexx::direction_t::get(0, 0, 1)));
+}
+
+TEST_F(CUBEXXCubeSymmetryTest,elements)
+{
+    for (const auto& symmetry : symmetry_t::all())
+    {
+        for (const auto& corner : cubexx::corner_t::all())
+        {
+            ASSERT_EQ(image(symmetry, corner), symmetry(corner));
+            ASSERT_EQ(symmetry(corner.opposite()), symmetry(corner).opposite());
+        }
+
+        ///every element goes along with its corners
+        for (const auto& edge : cubexx::edge_t::all())
+        {
+            ASSERT_EQ(cubexx::edge_t::get(symmetry(edge.corner0()), symmetry(edge.corner1())), symmetry(edge));
+        }
+        for (const auto& face : cubexx::face_t::all())
+        {
+            ASSERT_EQ(symmetry(face.direction()).face(), symmetry(face));
+            ASSERT_EQ(symmetry(face.opposite()), symmetry(face).opposite());
+            for (const auto& corner : face.corners())
+                ASSERT_TRUE(symmetry(face).is_adjacent(symmetry(corner)));
+            for (const auto& edge : face.edges())
+                ASSERT_TRUE(symmetry(face).is_adjacent(symmetry(edge)));
+        }
+    }
+}
+
+TEST_F(CUBEXXCubeSymmetryTest,group)
+{
+    for (const auto& a : symmetry_t::all())
+    {
+        ASSERT_EQ(symmetry_t::identity(), a * a.inverse());
+        ASSERT_EQ(symmetry_t::identity(), a.inverse() * a);
+        ASSERT_EQ(a, a * symmetry_t::identity());
+        ASSERT_EQ(a, symmetry_t::identity() * a);
+
+        for (const auto& b : symmetry_t::all())
+        {
+            symmetry_t ab = a * b;
+            ASSERT_EQ(a.is_rotation() == b.is_rotation(), ab.is_rotation());
+            for (const auto& corner : cubexx::corner_t::all())
+                ASSERT_EQ(a(b(corner)), ab(corner));
+            for (const auto& edge : cubexx::edge_t::all())
+                ASSERT_EQ(a(b(edge)), ab(edge));
+            for (const auto& direction : cubexx::direction_t::all())
+                ASSERT_EQ(a(b(direction)), ab(direction));
+        }
+    }
+}
+
+TEST_F(CUBEXXCubeSymmetryTest,sets)
+{
+    for (const auto& symmetry : symmetry_t::all())
+    {
+        for (std::size_t mask = 0; mask < 256; ++mask)
+        {
+            auto corners = cubexx::corner_set_t::from_mask(cubexx::corner_set_t::mask_type(mask));
+            cubexx::corner_set_t expected;
+            for (const auto& corner : corners)
+                expected |= symmetry(corner);
+            ASSERT_EQ(expected, symmetry(corners));
+        }
+        for (std::size_t mask = 0; mask < 4096; mask += 1 + mask % 5)
+        {
+            auto edges = cubexx::edge_set_t::from_mask(cubexx::edge_set_t::mask_type(mask));
+            cubexx::edge_set_t expected;
+            for (const auto& edge : edges)
+                expected |= symmetry(edge);
+            ASSERT_EQ(expected, symmetry(edges));
+        }
+        for (std::size_t mask = 0; mask < 64; ++mask)
+        {
+            auto faces = cubexx::face_set_t::from_mask(cubexx::face_set_t::mask_type(mask));
+            auto directions = cubexx::direction_set_t::from_mask(cubexx::direction_set_t::mask_type(mask));
+            cubexx::face_set_t expected_faces;
+            cubexx::direction_set_t expected_directions;
+            for (const auto& face : faces)
+                expected_faces |= symmetry(face);
+            for (const auto& direction : directions)
+                expected_directions |= symmetry(direction);
+            ASSERT_EQ(expected_faces, symmetry(faces));
+            ASSERT_EQ(expected_directions, symmetry(directions));
+        }
+    }
+}
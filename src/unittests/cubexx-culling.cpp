@@ -0,0 +1,227 @@
+#include <vector>
+#include <random>
+#include <array>
+#include <cstdint>
+
+#include "cubexx/cubexx.hpp"
+#include "cubexx/culling.hpp"
+#include "cubexx/formatters.hpp"
+
+#include "gtest/gtest.h"
+
+
+
+
+
+struct CUBEXXCullingTest : public ::testing::Test {
+protected:
+    typedef cubexx::morton_code_t<6> code_t;
+    typedef cubexx::linear_octree_t<int, 6> linear_octree_t;
+
+    virtual void SetUp() {
+        std::mt19937 generator(1234);
+        std::uniform_real_distribution<float> distribution(-1, 1);
+        for (std::size_t i = 0; i < 7; ++i)
+        {
+            planes.push_back(cubexx::half_space_t{{{distribution(generator), distribution(generator),
+                                                    distribution(generator)}}, distribution(generator) * 0.5f});
+        }
+        ///a plane along an axis, with zero normal components
+        planes.push_back(cubexx::half_space_t{{{0, -1, 0}}, 0.3f});
+
+        for (std::size_t i = 0; i < 300; ++i)
+        {
+            boxes.push_back({{distribution(generator), distribution(generator), distribution(generator)}});
+            sizes.push_back(distribution(generator) * 0.5f + 0.6f);
+        }
+    }
+
+    virtual void TearDown() {
+    // Code here will be called immediately after each test
+    // (right before the destructor).
+    
+    }
+
+    ///the signed distances (scaled by the normal's length) of all 8 corners of the box, by corner index
+    static std::array<float, 8> corner_values(const cubexx::half_space_t& plane, const std::array<float, 3>& lower,
+                                              float size)
+    {
+        std::array<float, 8> result;
+        for (auto corner : cubexx::corner_t::all())
+        {
+            result[corner.index()] = plane.offset;
+            for (std::size_t k = 0; k < 3; ++k)
+                result[corner.index()] += plane.normal[k] * (lower[k] + size * corner.uxyz()[k]);
+        }
+        return result;
+    }
+
+    ///the brute force test(); straddled planes are left in the mask
+    static bool brute_force(const std::vector<cubexx::half_space_t>& planes, const std::array<float, 3>& lower,
+                            float size, cubexx::culler_t::plane_mask_t& mask)
+    {
+        cubexx::culler_t::plane_mask_t result = 0;
+        for (std::size_t i = 0; i < planes.size(); ++i)
+        {
+            if (!((mask >> i) & 1))
+                continue;
+            auto values = corner_values(planes[i], lower, size);
+            bool any_inside = false, all_inside = true;
+            for (float value : values)
+            {
+                any_inside = any_inside || value >= 0;
+                all_inside = all_inside && value >= 0;
+            }
+            if (!any_inside)
+                return false;
+            if (!all_inside)
+                result |= cubexx::culler_t::plane_mask_t(1) << i;
+        }
+        mask = result;
+        return true;
+    }
+
+    std::vector<cubexx::half_space_t> planes;
+    std::vector<std::array<float, 3>> boxes;
+    std::vector<float> sizes;
+};
+
+
+TEST_F(CUBEXXCullingTest,corners)
+{
+    cubexx::culler_t culler(planes);
+    ASSERT_EQ(planes.size(), culler.size());
+    ASSERT_EQ(0xFFU, culler.all());
+
+    for (std::size_t i = 0; i < planes.size(); ++i)
+    {
+        ///the p-vertex and n-vertex are the farthest and nearest of the unit cube's corners
+        auto values = corner_values(planes[i], {{0, 0, 0}}, 1);
+        for (auto corner : cubexx::corner_t::all())
+        {
+            ASSERT_LE(values[corner.index()], values[culler.p_corner(i).index()]);
+            ASSERT_GE(values[corner.index()], values[culler.n_corner(i).index()]);
+        }
+        ASSERT_EQ(culler.p_corner(i).opposite(), culler.n_corner(i));
+    }
+
+    ///signs match the normal
+    cubexx::culler_t one({cubexx::half_space_t{{{1, -2, 0.5f}}, 0}});
+    ASSERT_EQ(cubexx::corner_t::get(1, -1, 1), one.p_corner(0));
+    ASSERT_EQ(cubexx::corner_t::get(-1, 1, -1), one.n_corner(0));
+}
+
+TEST_F(CUBEXXCullingTest,test)
+{
+    cubexx::culler_t culler(planes);
+    std::size_t visible = 0, inside = 0;
+    for (std::size_t i = 0; i < boxes.size(); ++i)
+    {
+        cubexx::culler_t::plane_mask_t mask = culler.all(), expected_mask = culler.all();
+        bool result = culler.test(boxes[i], sizes[i], mask);
+        ASSERT_EQ(brute_force(planes, boxes[i], sizes[i], expected_mask), result);
+        if (!result)
+            continue;
+        ASSERT_EQ(expected_mask, mask);
+        ++visible;
+        inside += mask != culler.all();
+    }
+    ///both outcomes happen
+    ASSERT_LT(0U, visible);
+    ASSERT_GT(boxes.size(), visible);
+    ASSERT_LT(0U, inside);
+}
+
+TEST_F(CUBEXXCullingTest,test_children)
+{
+    cubexx::culler_t culler(planes);
+    for (std::size_t i = 0; i < boxes.size(); ++i)
+    {
+        ///with every plane, and with the planes the box itself straddles
+        cubexx::culler_t::plane_mask_t parent_mask = culler.all();
+        culler.test(boxes[i], sizes[i], parent_mask);
+        for (auto mask : {culler.all(), parent_mask})
+        {
+            cubexx::culler_t::plane_mask_t child_masks[8];
+            cubexx::corner_set_t visible = culler.test_children(boxes[i], sizes[i], mask, child_masks);
+
+            float half = sizes[i] / 2;
+            for (auto corner : cubexx::corner_t::all())
+            {
+                std::array<float, 3> lower = {{boxes[i][0] + half * corner.ux(), boxes[i][1] + half * corner.uy(),
+                                               boxes[i][2] + half * corner.uz()}};
+                cubexx::culler_t::plane_mask_t expected = mask;
+                ASSERT_EQ(culler.test(lower, half, expected), visible.contains(corner));
+                if (visible.contains(corner))
+                {
+                    ASSERT_EQ(expected, child_masks[corner.index()]);
+                    ///inherited; never more planes than the parent
+                    ASSERT_EQ(0U, child_masks[corner.index()] & ~mask);
+                }
+            }
+        }
+    }
+}
+
+TEST_F(CUBEXXCullingTest,frustum)
+{
+    ///the identity is the orthographic box [-1, 1]^3
+    std::array<float, 16> identity = {{1, 0, 0, 0,  0, 1, 0, 0,  0, 0, 1, 0,  0, 0, 0, 1}};
+    cubexx::culler_t culler = cubexx::culler_t::frustum(identity);
+    ASSERT_EQ(6U, culler.size());
+
+    cubexx::culler_t::plane_mask_t mask = culler.all();
+    ASSERT_TRUE(culler.test({{-0.5f, -0.5f, -0.5f}}, 1, mask));
+    ASSERT_EQ(0U, mask);
+
+    mask = culler.all();
+    ASSERT_TRUE(culler.test({{0.5f, -0.5f, -0.5f}}, 1, mask));
+    ///straddles the right plane only
+    ASSERT_EQ(cubexx::culler_t::plane_mask_t(1) << 1, mask);
+
+    mask = culler.all();
+    ASSERT_FALSE(culler.test({{-0.5f, 1.5f, -0.5f}}, 1, mask));
+
+    ///the left plane is x >= -1
+    ASSERT_EQ(cubexx::corner_t::get(1, -1, -1), culler.p_corner(0));
+}
+
+TEST_F(CUBEXXCullingTest,cull_visit)
+{
+    ///a full octree 3 levels deep, in [-1, 1]^3
+    std::vector<code_t> codes;
+    for (std::uint32_t x = 0; x < 8; ++x)
+        for (std::uint32_t y = 0; y < 8; ++y)
+            for (std::uint32_t z = 0; z < 8; ++z)
+                codes.push_back(code_t::encode(x, y, z, 3));
+    linear_octree_t octree(codes, std::vector<int>(codes.size()));
+
+    cubexx::culler_t culler(planes);
+    std::vector<code_t> visited;
+    cull_visit(octree, {{-1, -1, -1}}, 2, culler,
+        [&](const code_t& code, const std::array<float, 3>& lower, float size, bool inside){
+            auto xyz = code.decode();
+            for (std::size_t k = 0; k < 3; ++k)
+                EXPECT_EQ(-1 + 0.25f * xyz[k], lower[k]);
+            EXPECT_EQ(0.25f, size);
+
+            cubexx::culler_t::plane_mask_t mask = culler.all();
+            EXPECT_TRUE(culler.test(lower, size, mask));
+            EXPECT_EQ(mask == 0, inside);
+            visited.push_back(code);
+        });
+
+    ///every leaf that is not outside any plane, in Morton order
+    std::vector<code_t> expected;
+    for (auto leaf : octree)
+    {
+        const code_t& code = leaf.first;
+        auto xyz = code.decode();
+        cubexx::culler_t::plane_mask_t mask = culler.all();
+        if (brute_force(planes, {{-1 + 0.25f * xyz[0], -1 + 0.25f * xyz[1], -1 + 0.25f * xyz[2]}}, 0.25f, mask))
+            expected.push_back(code);
+    }
+    ASSERT_EQ(expected, visited);
+    ASSERT_LT(0U, visited.size());
+    ASSERT_GT(codes.size(), visited.size());
+}
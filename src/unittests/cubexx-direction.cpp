@@ -279,3 +279,21 @@ TEST_F(CUBEXXDirectionTest,face)
 
 
 
+
+
+TEST_F(CUBEXXDirectionTest,constexpr_relations)
+{
+    static_assert(std::is_literal_type<cubexx::direction_t>::value, "direction_t should be a literal type");
+    static_assert(std::is_literal_type<cubexx::direction_set_t>::value, "direction_set_t should be a literal type");
+    
+    constexpr const cubexx::direction_t& direction = cubexx::direction_t::get(0,+1,0);
+    
+    static_assert(direction.axis() == 1, "");
+    static_assert(direction.positive(), "");
+    static_assert(direction.opposite().y() == -1, "");
+    static_assert(direction.face().direction() == direction, "");
+    static_assert(!direction.adjacent_set().contains(direction.opposite()), "");
+    static_assert(direction.adjacent_set().size() == 4, "");
+    
+    ASSERT_EQ(direction.xyz()[1], 1);
+}
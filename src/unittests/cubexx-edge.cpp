@@ -5,6 +5,7 @@
 #include <set>
 #include <map>
 #include <tuple>
+#include <numeric>
 
 #include "cubexx/cubexx.hpp"
 #include "cubexx/formatters.hpp"
@@ -617,3 +618,47 @@ TEST_F(CUBEXXEdgeTest,is_adjacent_to_corner)
         ASSERT_EQ(3U, all____corner_visits[corner.index()]);
     }
 }
+
+
+TEST_F(CUBEXXEdgeTest,constexpr_relations)
+{
+    static_assert(std::is_literal_type<cubexx::edge_t>::value, "edge_t should be a literal type");
+    static_assert(std::is_literal_type<cubexx::edge_set_t>::value, "edge_set_t should be a literal type");
+    
+    constexpr const cubexx::edge_t& edge = cubexx::edge_t::get(2, true, false);
+    
+    static_assert(edge.base_axis() == 2, "");
+    static_assert(edge == cubexx::edge_t::get(edge.corner1(), edge.corner0()), "");
+    static_assert(edge.opposite().opposite() == edge, "");
+    static_assert(!edge.corner_set().contains(edge.opposite().corner0()), "");
+    static_assert(edge.adjacent_edge_set().size() == 4, "");
+    static_assert(edge.opposite(edge.faces()[0]).is_adjacent(edge.faces()[0]), "");
+    static_assert(edge.end_face(edge.corner0()) == edge.end_faces()[0], "");
+    
+    ASSERT_TRUE(edge.project_secondary());
+}
+
+
+TEST_F(CUBEXXEdgeTest,edge_set_mask_algebra)
+{
+    for (uint32_t combo = 0; combo < (1U << 12); ++combo)
+    {
+        auto edge_set = cubexx::edge_set_t::from_mask(combo);
+        
+        ASSERT_EQ(combo, edge_set.mask());
+        ASSERT_EQ(cubexx::edge_set_t::from_mask(~combo & 0xFFF), ~edge_set);
+        
+        uint32_t remaining = combo;
+        std::size_t k = 0;
+        for (auto edge : edge_set)
+        {
+            ASSERT_TRUE((remaining >> edge.index()) & 1);
+            ASSERT_EQ(0U, remaining & ((1U << edge.index()) - 1));
+            ASSERT_EQ(edge_set.nth(k), edge);
+            remaining ^= 1U << edge.index();
+            ++k;
+        }
+        ASSERT_EQ(0U, remaining);
+        ASSERT_EQ(edge_set.size(), k);
+    }
+}
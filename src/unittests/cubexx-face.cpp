@@ -5,6 +5,7 @@
 #include <set>
 #include <map>
 #include <tuple>
+#include <numeric>
 
 #include "cubexx/cubexx.hpp"
 #include "cubexx/formatters.hpp"
@@ -573,3 +574,21 @@ TEST_F(CUBEXXFaceTest,perpendicular_edges)
     ASSERT_EQ(6U*4U, std::accumulate(all____edge_counts.begin(), all____edge_counts.end(), 0U));
 }
 
+
+
+TEST_F(CUBEXXFaceTest,constexpr_relations)
+{
+    static_assert(std::is_literal_type<cubexx::face_t>::value, "face_t should be a literal type");
+    static_assert(std::is_literal_type<cubexx::face_set_t>::value, "face_set_t should be a literal type");
+    
+    constexpr const cubexx::face_t& face = cubexx::face_t::get(0);
+    
+    static_assert(face.corner_set().size() == 4, "");
+    static_assert((face.corner_set() & face.opposite().corner_set()).size() == 0, "");
+    static_assert(face.flip(face.edges()[1]).is_adjacent(face), "");
+    static_assert(face.edge_set().contains(face.edges()[3]), "");
+    static_assert(!face.edge_set().contains(face.perpendicular_edges()[0]), "");
+    static_assert(face.adjacent_set().size() == 4, "");
+    
+    ASSERT_TRUE(face.is_adjacent(face.corners()[0]));
+}
@@ -0,0 +1,206 @@
+#include <map>
+#include <set>
+#include <array>
+#include <vector>
+#include <cstdint>
+
+#include "cubexx/cubexx.hpp"
+#include "cubexx/grid_index.hpp"
+#include "cubexx/formatters.hpp"
+
+#include "gtest/gtest.h"
+
+
+
+
+
+struct CUBEXXGridIndexTest : public ::testing::Test {
+protected:
+    typedef cubexx::grid_index_t::id_type id_type;
+    ///an element by where it is: the sum of the grid points around it
+    typedef std::array<std::size_t, 3> position_t;
+
+    CUBEXXGridIndexTest() : grid(5, 3, 4) {}
+
+    virtual void SetUp() {
+    // Code here will be called immediately after the constructor (right
+    // before each test).
+
+    }
+
+    virtual void TearDown() {
+    // Code here will be called immediately after each test
+    // (right before the destructor).
+    
+    }
+
+    template<typename corners_t>
+    static position_t position(std::size_t x, std::size_t y, std::size_t z, const corners_t& corners)
+    {
+        position_t result = {{0, 0, 0}};
+        for (const auto& corner : corners)
+        {
+            result[0] += x + corner.ux();
+            result[1] += y + corner.uy();
+            result[2] += z + corner.uz();
+        }
+        return result;
+    }
+
+    /**
+     * Checks that @p id gives each element (by @p positions) a single id, that distinct elements get distinct
+     * ids, and that the ids are exactly `[0, count)`.
+     */
+    template<typename elements_t, typename id_f, typename position_f>
+    void check(const elements_t& elements, id_type count, id_f id, position_f positions)
+    {
+        std::map<position_t, id_type> ids;
+        std::set<id_type> seen;
+        for (std::size_t z = 0; z < grid.size()[2]; ++z)
+            for (std::size_t y = 0; y < grid.size()[1]; ++y)
+                for (std::size_t x = 0; x < grid.size()[0]; ++x)
+                    for (const auto& element : elements)
+                    {
+                        id_type value = id(x, y, z, element);
+                        position_t where = positions(x, y, z, element);
+                        auto inserted = ids.insert(std::make_pair(where, value));
+                        ASSERT_EQ(inserted.first->second, value);
+                        seen.insert(value);
+                    }
+        ASSERT_EQ(ids.size(), seen.size());
+        ASSERT_EQ(std::size_t(count), seen.size());
+        ASSERT_EQ(0U, *seen.begin());
+        ASSERT_EQ(count - 1, *seen.rbegin());
+    }
+
+    cubexx::grid_index_t grid;
+};
+
+
+TEST_F(CUBEXXGridIndexTest,counts)
+{
+    ASSERT_EQ(60U, grid.cell_count());
+    ASSERT_EQ(6U * 4U * 5U, grid.corner_count());
+    ASSERT_EQ(5U * 4U * 5U + 6U * 3U * 5U + 6U * 4U * 4U, grid.edge_count());
+    ASSERT_EQ(6U * 3U * 4U + 5U * 4U * 4U + 5U * 3U * 5U, grid.face_count());
+}
+
+TEST_F(CUBEXXGridIndexTest,cells)
+{
+    std::set<id_type> ids;
+    for (std::size_t z = 0; z < grid.size()[2]; ++z)
+        for (std::size_t y = 0; y < grid.size()[1]; ++y)
+            for (std::size_t x = 0; x < grid.size()[0]; ++x)
+                ids.insert(grid.cell_id(x, y, z));
+    ASSERT_EQ(std::size_t(grid.cell_count()), ids.size());
+    ASSERT_EQ(grid.cell_count() - 1, *ids.rbegin());
+}
+
+TEST_F(CUBEXXGridIndexTest,shared)
+{
+    check(cubexx::corner_t::all(), grid.corner_count(),
+        [&](std::size_t x, std::size_t y, std::size_t z, const cubexx::corner_t& corner){
+            return grid.corner_id(x, y, z, corner);
+        },
+        [](std::size_t x, std::size_t y, std::size_t z, const cubexx::corner_t& corner){
+            return position(x, y, z, std::array<cubexx::corner_t, 1>{{corner}});
+        });
+    check(cubexx::edge_t::all(), grid.edge_count(),
+        [&](std::size_t x, std::size_t y, std::size_t z, const cubexx::edge_t& edge){
+            return grid.edge_id(x, y, z, edge);
+        },
+        [](std::size_t x, std::size_t y, std::size_t z, const cubexx::edge_t& edge){
+            return position(x, y, z, edge.corners());
+        });
+    check(cubexx::face_t::all(), grid.face_count(),
+        [&](std::size_t x, std::size_t y, std::size_t z, const cubexx::face_t& face){
+            return grid.face_id(x, y, z, face);
+        },
+        [](std::size_t x, std::size_t y, std::size_t z, const cubexx::face_t& face){
+            return position(x, y, z, face.corners());
+        });
+}
+
+TEST_F(CUBEXXGridIndexTest,neighbors)
+{
+    ///the element across a face, edge or corner, seen from the neighbor, is the same element
+    for (const auto& edge : cubexx::edge_t::all())
+        for (std::size_t i = 0; i < 2; ++i)
+        {
+            ///the next cell through one of the edge's faces has it across the other face
+            const auto& direction = edge.faces()[i].direction();
+            const auto& other = edge.faces()[1 - i];
+            ASSERT_EQ(grid.edge_id(2 + direction.x(), 1 + direction.y(), 2 + direction.z(), edge.opposite(other)),
+                      grid.edge_id(2, 1, 2, edge));
+        }
+    for (const auto& face : cubexx::face_t::all())
+    {
+        const auto& direction = face.direction();
+        ASSERT_EQ(grid.face_id(2 + direction.x(), 1 + direction.y(), 2 + direction.z(), face.opposite()),
+                  grid.face_id(2, 1, 2, face));
+    }
+    for (const auto& corner : cubexx::corner_t::all())
+        ASSERT_EQ(grid.corner_id(2 + corner.x(), 1 + corner.y(), 2 + corner.z(), corner.opposite()),
+                  grid.corner_id(2, 1, 2, corner));
+}
+
+TEST_F(CUBEXXGridIndexTest,rows)
+{
+    cubexx::grid_index_t wide(37, 2, 2);
+    for (std::size_t x : {0, 1, 6})
+    {
+        std::size_t n = 37 - x;
+        std::vector<id_type> ids(n + 1, 0xDEADBEEF);
+        for (const auto& corner : cubexx::corner_t::all())
+        {
+            wide.corner_ids(x, 1, 0, n, corner, ids.data());
+            for (std::size_t i = 0; i < n; ++i)
+                ASSERT_EQ(wide.corner_id(x + i, 1, 0, corner), ids[i]);
+        }
+        for (const auto& edge : cubexx::edge_t::all())
+        {
+            wide.edge_ids(x, 0, 1, n, edge, ids.data());
+            for (std::size_t i = 0; i < n; ++i)
+                ASSERT_EQ(wide.edge_id(x + i, 0, 1, edge), ids[i]);
+        }
+        for (const auto& face : cubexx::face_t::all())
+        {
+            wide.face_ids(x, 1, 1, n, face, ids.data());
+            for (std::size_t i = 0; i < n; ++i)
+                ASSERT_EQ(wide.face_id(x + i, 1, 1, face), ids[i]);
+        }
+        ///nothing past the row
+        ASSERT_EQ(0xDEADBEEF, ids[n]);
+    }
+}
+
+TEST_F(CUBEXXGridIndexTest,large)
+{
+    ///a grid with more than 2^32 edges, which a 32-bit id would wrap; no voxels are needed to number it
+    static_assert(sizeof(id_type) == 8, "ids should be 64-bit");
+    cubexx::grid_index_t large(1300, 1300, 1300);
+    ASSERT_EQ(std::uint64_t(1300) * 1300 * 1300, large.cell_count());
+    ASSERT_EQ(std::uint64_t(1301) * 1301 * 1301, large.corner_count());
+    ASSERT_EQ(std::uint64_t(6601143900), large.edge_count());
+    ASSERT_EQ(std::uint64_t(6596070000), large.face_count());
+
+    ///the last of each element is the last id
+    ASSERT_EQ(large.cell_count() - 1, large.cell_id(1299, 1299, 1299));
+    ASSERT_EQ(large.corner_count() - 1, large.corner_id(1299, 1299, 1299, cubexx::corner_t::get(7)));
+    ASSERT_EQ(large.edge_count() - 1, large.edge_id(1299, 1299, 1299,
+        cubexx::edge_t::get(cubexx::corner_t::get(3), cubexx::corner_t::get(7))));
+    ASSERT_EQ(large.face_count() - 1, large.face_id(1299, 1299, 1299,
+        cubexx::face_t::get(cubexx::direction_t::get(0, 0, 1))));
+
+    ///a row of y edges whose ids cross 2^32 stays consecutive
+    const auto& edge = cubexx::edge_t::get(cubexx::corner_t::get(0), cubexx::corner_t::get(2));
+    std::vector<id_type> ids(1300);
+    large.edge_ids(0, 581, 1238, ids.size(), edge, ids.data());
+    ASSERT_LT(ids.front(), std::uint64_t(1) << 32);
+    ASSERT_GT(ids.back(), std::uint64_t(1) << 32);
+    for (std::size_t x = 0; x < ids.size(); ++x)
+    {
+        ASSERT_EQ(large.edge_id(x, 581, 1238, edge), ids[x]);
+        ASSERT_EQ(ids.front() + x, ids[x]);
+    }
+}
@@ -0,0 +1,211 @@
+#include <map>
+#include <set>
+#include <array>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+
+#include "cubexx/cubexx.hpp"
+#include "cubexx/isosurface.hpp"
+#include "cubexx/formatters.hpp"
+
+#include "gtest/gtest.h"
+
+
+
+
+
+struct CUBEXXIsosurfaceTest : public ::testing::Test {
+protected:
+    typedef cubexx::isosurface_extractor_t::id_type id_type;
+
+    ///collects what the extractor gives it, and checks the order
+    struct sink_t
+    {
+        void vertex(id_type id, const std::array<float, 3>& position)
+        {
+            EXPECT_EQ(0U, vertices.count(id));
+            vertices[id] = position;
+        }
+        void triangle(id_type a, id_type b, id_type c)
+        {
+            EXPECT_EQ(1U, vertices.count(a));
+            EXPECT_EQ(1U, vertices.count(b));
+            EXPECT_EQ(1U, vertices.count(c));
+            triangles.push_back({{a, b, c}});
+        }
+
+        std::map<id_type, std::array<float, 3> > vertices;
+        std::vector<std::array<id_type, 3> > triangles;
+    };
+
+    virtual void SetUp() {
+    // Code here will be called immediately after the constructor (right
+    // before each test).
+
+    }
+
+    virtual void TearDown() {
+    // Code here will be called immediately after each test
+    // (right before the destructor).
+    
+    }
+
+    ///the distance from @p center, sampled on a grid of @p n samples
+    static std::vector<float> sphere(const std::array<std::size_t, 3>& n, const std::array<float, 3>& center)
+    {
+        std::vector<float> samples;
+        for (std::size_t z = 0; z < n[2]; ++z)
+            for (std::size_t y = 0; y < n[1]; ++y)
+                for (std::size_t x = 0; x < n[0]; ++x)
+                    samples.push_back(std::sqrt((x - center[0]) * (x - center[0]) + (y - center[1]) * (y - center[1])
+                                              + (z - center[2]) * (z - center[2])));
+        return samples;
+    }
+
+    static sink_t extract(const std::array<std::size_t, 3>& n, const std::vector<float>& samples, float isovalue)
+    {
+        cubexx::isosurface_extractor_t extractor(n[0], n[1], n[2], isovalue);
+        sink_t sink;
+        for (std::size_t z = 0; z < n[2]; ++z)
+        {
+            ///the extractor keeps its own copy; the caller's buffer may be reused
+            std::vector<float> slice(samples.begin() + z * n[0] * n[1], samples.begin() + (z + 1) * n[0] * n[1]);
+            extractor.push(slice.data(), sink);
+            EXPECT_EQ(z + 1, extractor.slices());
+            slice.assign(slice.size(), 0);
+        }
+        return sink;
+    }
+};
+
+
+TEST_F(CUBEXXIsosurfaceTest,sphere)
+{
+    const std::array<std::size_t, 3> n = {{11, 12, 10}};
+    const std::array<float, 3> center = {{5.2f, 5.6f, 4.7f}};
+    const float radius = 3.3f;
+    sink_t sink = extract(n, sphere(n, center), radius);
+    ASSERT_LT(0U, sink.triangles.size());
+
+    ///the vertices are on the sphere, near enough, and on the edges whose ids they have
+    cubexx::grid_index_t grid(n[0] - 1, n[1] - 1, n[2] - 1);
+    std::map<id_type, std::pair<std::array<std::size_t, 3>, std::size_t> > edges;
+    for (std::size_t z = 0; z + 1 < n[2]; ++z)
+        for (std::size_t y = 0; y + 1 < n[1]; ++y)
+            for (std::size_t x = 0; x + 1 < n[0]; ++x)
+                for (const auto& edge : cubexx::edge_t::all())
+                {
+                    std::array<std::size_t, 3> lower = {{x + edge.corner0().ux(), y + edge.corner0().uy(),
+                                                         z + edge.corner0().uz()}};
+                    edges[grid.edge_id(x, y, z, edge)] = std::make_pair(lower, std::size_t(edge.base_axis()));
+                }
+
+    for (const auto& vertex : sink.vertices)
+    {
+        const auto& p = vertex.second;
+        float distance = std::sqrt((p[0] - center[0]) * (p[0] - center[0]) + (p[1] - center[1]) * (p[1] - center[1])
+                                 + (p[2] - center[2]) * (p[2] - center[2]));
+        ASSERT_NEAR(radius, distance, 0.15f);
+
+        ///on the segment of the edge with its id
+        ASSERT_EQ(1U, edges.count(vertex.first));
+        const auto& lower = edges[vertex.first].first;
+        std::size_t axis = edges[vertex.first].second;
+        for (std::size_t k = 0; k < 3; ++k)
+        {
+            if (k != axis)
+                ASSERT_EQ(float(lower[k]), p[k]);
+            else
+            {
+                ASSERT_LE(float(lower[k]), p[k]);
+                ASSERT_GE(float(lower[k] + 1), p[k]);
+            }
+        }
+    }
+
+    ///closed and consistently oriented: each side is used once each way
+    std::set<std::pair<id_type, id_type> > sides;
+    for (const auto& triangle : sink.triangles)
+        for (std::size_t j = 0; j < 3; ++j)
+            ASSERT_TRUE(sides.insert(std::make_pair(triangle[j], triangle[(j + 1) % 3])).second);
+    for (const auto& side : sides)
+        ASSERT_EQ(1U, sides.count(std::make_pair(side.second, side.first)));
+
+    ///facing out, toward the higher distances: the enclosed volume is positive, and about a sphere's
+    double volume = 0;
+    for (const auto& triangle : sink.triangles)
+    {
+        const auto& a = sink.vertices[triangle[0]];
+        const auto& b = sink.vertices[triangle[1]];
+        const auto& c = sink.vertices[triangle[2]];
+        volume += (a[0] * (b[1] * c[2] - b[2] * c[1]) - a[1] * (b[0] * c[2] - b[2] * c[0])
+                 + a[2] * (b[0] * c[1] - b[1] * c[0])) / 6;
+    }
+    ASSERT_NEAR(4.0 / 3.0 * M_PI * radius * radius * radius, volume, 10);
+}
+
+TEST_F(CUBEXXIsosurfaceTest,slab_by_slab)
+{
+    ///the same surface, whatever slices it is split into: a taller volume padded with samples above the surface
+    const std::array<std::size_t, 3> n = {{9, 8, 7}}, tall = {{9, 8, 9}};
+    const std::array<float, 3> center = {{4.1f, 3.9f, 3.2f}};
+    sink_t short_sink = extract(n, sphere(n, center), 2.6f);
+    sink_t tall_sink = extract(tall, sphere(tall, center), 2.6f);
+
+    ASSERT_EQ(short_sink.triangles.size(), tall_sink.triangles.size());
+    ASSERT_EQ(short_sink.vertices.size(), tall_sink.vertices.size());
+    auto v = short_sink.vertices.begin(), w = tall_sink.vertices.begin();
+    for (; v != short_sink.vertices.end(); ++v, ++w)
+        ASSERT_EQ(v->second, w->second);
+}
+
+TEST_F(CUBEXXIsosurfaceTest,empty)
+{
+    const std::array<std::size_t, 3> n = {{5, 4, 3}};
+    ///entirely inside, and entirely outside
+    ASSERT_TRUE(extract(n, std::vector<float>(60, 0.f), 1.f).triangles.empty());
+    ASSERT_TRUE(extract(n, std::vector<float>(60, 2.f), 1.f).vertices.empty());
+}
+
+TEST_F(CUBEXXIsosurfaceTest,large)
+{
+    ///a volume of 1301 samples a side has more than 2^32 edges; only the two slices of the first slab are held
+    static_assert(sizeof(id_type) == 8, "vertex ids should be 64-bit");
+    const std::size_t n = 1301;
+    cubexx::isosurface_extractor_t extractor(n, n, n, 0.5f);
+    const cubexx::grid_index_t& grid = extractor.grid();
+    ASSERT_EQ(std::uint64_t(6601143900), grid.edge_count());
+
+    ///a small box of high samples in the far corner of the second slice; its vertical edges are numbered past 2^32
+    std::vector<float> slice(n * n, 0.f);
+    sink_t sink;
+    extractor.push(slice.data(), sink);
+    for (std::size_t y = n - 4; y < n; ++y)
+        for (std::size_t x = n - 5; x < n; ++x)
+            slice[y * n + x] = 1.f;
+    extractor.push(slice.data(), sink);
+    ASSERT_LT(0U, sink.triangles.size());
+    ASSERT_LT(std::uint64_t(1) << 32, sink.vertices.rbegin()->first);
+
+    ///each vertex is on the edge with its id
+    std::map<id_type, std::pair<std::array<std::size_t, 3>, std::size_t> > edges;
+    for (std::size_t y = n - 6; y + 1 < n; ++y)
+        for (std::size_t x = n - 7; x + 1 < n; ++x)
+            for (const auto& edge : cubexx::edge_t::all())
+            {
+                std::array<std::size_t, 3> lower = {{x + edge.corner0().ux(), y + edge.corner0().uy(),
+                                                     std::size_t(edge.corner0().uz())}};
+                edges[grid.edge_id(x, y, 0, edge)] = std::make_pair(lower, std::size_t(edge.base_axis()));
+            }
+    for (const auto& vertex : sink.vertices)
+    {
+        ASSERT_LT(vertex.first, grid.edge_count());
+        ASSERT_EQ(1U, edges.count(vertex.first));
+        const auto& lower = edges[vertex.first].first;
+        std::size_t axis = edges[vertex.first].second;
+        for (std::size_t k = 0; k < 3; ++k)
+            ASSERT_EQ(float(lower[k]) + (k == axis ? 0.5f : 0.f), vertex.second[k]);
+    }
+}
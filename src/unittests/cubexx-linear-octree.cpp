@@ -0,0 +1,186 @@
+
+
+
+#include <vector>
+#include <random>
+#include <algorithm>
+
+#include "cubexx/cubexx.hpp"
+#include "cubexx/linear_octree.hpp"
+#include "cubexx/formatters.hpp"
+
+#include "gtest/gtest.h"
+
+
+
+
+
+struct CUBEXXLinearOctreeTest : public ::testing::Test {
+protected:
+    typedef cubexx::morton_code_t<6> code_t;
+    typedef cubexx::linear_octree_t<std::size_t, 6> octree_t;
+
+    virtual void SetUp() {
+        ///a random, unevenly refined tree; some cells are left out, so the leaves do not cover the root
+        std::mt19937 generator(1234);
+        subdivide(code_t::root(), generator);
+
+        ///shuffle, so the constructor has to sort
+        std::shuffle(leaves.begin(), leaves.end(), generator);
+        std::vector<std::size_t> values;
+        for (const auto& leaf : leaves)
+            values.push_back(leaf.bits());
+        octree = octree_t(leaves, values);
+    }
+
+    virtual void TearDown() {
+    // Code here will be called immediately after each test
+    // (right before the destructor).
+    
+    }
+
+    void subdivide(const code_t& code, std::mt19937& generator)
+    {
+        std::uniform_int_distribution<int> distribution(0, 9);
+        int roll = distribution(generator);
+        if (code.level() == code_t::MAX_DEPTH() || (code.level() > 1 && roll < 6))
+            leaves.push_back(code);
+        else if (roll == 6 && code.level() > 1)
+            return;
+        else
+            for (auto corner : cubexx::corner_t::all())
+                subdivide(code.child(corner), generator);
+    }
+
+    ///the leaf containing @p code, the slow way
+    std::size_t brute_force_locate(const code_t& code) const
+    {
+        for (std::size_t i = 0; i < octree.size(); ++i)
+            if (octree.code(i).contains(code))
+                return i;
+        return octree.size();
+    }
+
+    std::vector<code_t> leaves;
+    octree_t octree;
+};
+
+
+TEST_F(CUBEXXLinearOctreeTest,sorted)
+{
+    ASSERT_EQ(leaves.size(), octree.size());
+    ASSERT_GT(octree.size(), 100U);
+
+    for (std::size_t i = 0; i < octree.size(); ++i)
+    {
+        ///the values moved along with their leaves
+        ASSERT_EQ(octree.code(i).bits(), octree.value(i));
+        if (i > 0)
+        {
+            ASSERT_LT(octree_t::anchor(octree.code(i - 1)), octree_t::anchor(octree.code(i)));
+        }
+    }
+
+    std::size_t i = 0;
+    for (auto leaf : octree)
+    {
+        ASSERT_EQ(octree.code(i), leaf.first);
+        ASSERT_EQ(octree.value(i), leaf.second);
+        ++i;
+    }
+}
+
+TEST_F(CUBEXXLinearOctreeTest,iterator)
+{
+    ///random access, by the standard's requirements
+    auto first = octree.begin(), last = octree.end();
+    ASSERT_EQ(std::ptrdiff_t(octree.size()), last - first);
+    ASSERT_TRUE(first < last && last > first && first <= last && last >= first);
+    ASSERT_TRUE(first <= first && first >= first && !(first < first) && !(first > first));
+    auto middle = 2 + first;
+    ASSERT_EQ(first + 2, middle);
+    ASSERT_EQ(2U, middle.index());
+    ASSERT_EQ(octree.code(2), first[2].first);
+    ASSERT_EQ(first, middle - 2);
+    ASSERT_TRUE(std::is_sorted(first, last, [](const octree_t::const_iterator::value_type& a,
+                                               const octree_t::const_iterator::value_type& b){
+        return octree_t::anchor(a.first) < octree_t::anchor(b.first);
+    }));
+}
+
+TEST_F(CUBEXXLinearOctreeTest,locate)
+{
+    std::mt19937 generator(4321);
+    std::uniform_int_distribution<std::uint32_t> distribution(0, (1U << code_t::MAX_DEPTH()) - 1);
+    for (std::size_t i = 0; i < 2000; ++i)
+    {
+        auto point = code_t::encode(distribution(generator), distribution(generator), distribution(generator));
+        std::size_t expected = brute_force_locate(point);
+        ASSERT_EQ(expected, octree.locate(point));
+        ASSERT_EQ(expected, octree.locate_binary(point));
+    }
+
+    ///every leaf contains itself
+    for (std::size_t i = 0; i < octree.size(); ++i)
+    {
+        ASSERT_EQ(i, octree.locate(octree.code(i)));
+        ASSERT_EQ(i, octree.locate_binary(octree.code(i)));
+    }
+
+    ///the root is not within any leaf
+    ASSERT_EQ(octree.size(), octree.locate(code_t::root()));
+    ASSERT_EQ(octree_t().size(), octree_t().locate(code_t::root()));
+}
+
+TEST_F(CUBEXXLinearOctreeTest,children)
+{
+    ///walk every internal node, comparing with a scan of the leaves
+    std::vector<code_t> nodes(1, code_t::root());
+    while (!nodes.empty())
+    {
+        code_t node = nodes.back();
+        nodes.pop_back();
+
+        cubexx::corner_set_t expected;
+        for (std::size_t i = 0; i < octree.size(); ++i)
+            if (octree.code(i).level() > node.level() && node.contains(octree.code(i)))
+                expected |= octree.code(i).corner_at(node.level() + 1);
+
+        ASSERT_EQ(expected, octree.children(node));
+        for (auto corner : expected)
+            nodes.push_back(node.child(corner));
+    }
+
+    for (std::size_t i = 0; i < octree.size(); ++i)
+        ASSERT_TRUE(octree.children(octree.code(i)).empty());
+}
+
+TEST_F(CUBEXXLinearOctreeTest,leaves)
+{
+    for (std::size_t i = 0; i < octree.size(); ++i)
+    {
+        const auto& leaf = octree.code(i);
+
+        ///every ancestor's run of leaves is exactly the leaves it contains
+        for (std::size_t level = 0; level <= leaf.level(); ++level)
+        {
+            auto ancestor = leaf.ancestor(level);
+            auto range = octree.leaves(ancestor);
+
+            std::size_t expected = 0;
+            for (std::size_t j = 0; j < octree.size(); ++j)
+                expected += ancestor.contains(octree.code(j));
+            ASSERT_EQ(expected, range.size());
+            for (auto entry : range)
+                ASSERT_TRUE(ancestor.contains(entry.first));
+        }
+
+        ///a cell within a leaf gives back that leaf
+        if (leaf.level() < code_t::MAX_DEPTH())
+        {
+            auto range = octree.leaves(leaf.child(cubexx::corner_t::get(std::uint_fast8_t(5))));
+            ASSERT_EQ(1U, range.size());
+            ASSERT_EQ(i, range.begin().index());
+        }
+    }
+}
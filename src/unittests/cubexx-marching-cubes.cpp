@@ -0,0 +1,228 @@
+#include <vector>
+#include <map>
+#include <set>
+#include <array>
+#include <random>
+#include <utility>
+#include <cstdint>
+
+#include "cubexx/cubexx.hpp"
+#include "cubexx/marching_cubes.hpp"
+#include "cubexx/formatters.hpp"
+
+#include "gtest/gtest.h"
+
+
+
+
+
+struct CUBEXXMarchingCubesTest : public ::testing::Test {
+protected:
+    typedef std::array<int, 3> vec_t;
+
+    virtual void SetUp() {
+    // Code here will be called immediately after the constructor (right
+    // before each test).
+
+    }
+
+    virtual void TearDown() {
+    // Code here will be called immediately after each test
+    // (right before the destructor).
+    
+    }
+
+    static bool is_inside(const cubexx::corner_set_t& inside, const cubexx::corner_t& corner)
+    {
+        return inside.contains(corner);
+    }
+
+    ///twice the midpoint of @p edge, so that it is integral
+    static vec_t midpoint(const cubexx::edge_t& edge)
+    {
+        return {{edge.corner0().ux() + edge.corner1().ux(), edge.corner0().uy() + edge.corner1().uy(),
+                 edge.corner0().uz() + edge.corner1().uz()}};
+    }
+
+    ///from the inside corner of @p edge to the outside one
+    static vec_t outward(const cubexx::corner_set_t& inside, const cubexx::edge_t& edge)
+    {
+        const cubexx::corner_t& from = is_inside(inside, edge.corner0()) ? edge.corner0() : edge.corner1();
+        const cubexx::corner_t& to = is_inside(inside, edge.corner0()) ? edge.corner1() : edge.corner0();
+        return {{to.ux() - from.ux(), to.uy() - from.uy(), to.uz() - from.uz()}};
+    }
+
+    static bool on_a_face(const cubexx::edge_t& a, const cubexx::edge_t& b)
+    {
+        for (const auto& face : cubexx::face_t::all())
+            if (face.edge_set().contains(a) && face.edge_set().contains(b))
+                return true;
+        return false;
+    }
+};
+
+static_assert(cubexx::marching_cubes_triangle_count(cubexx::corner_set_t()) == 0, "the tables are constexpr");
+static_assert(cubexx::marching_cubes_edges(cubexx::corner_set_t()).empty(), "the tables are constexpr");
+
+
+TEST_F(CUBEXXMarchingCubesTest,edges)
+{
+    for (std::size_t mask = 0; mask < 256; ++mask)
+    {
+        auto inside = cubexx::corner_set_t::from_mask(cubexx::corner_set_t::mask_type(mask));
+        auto edges = cubexx::marching_cubes_edges(inside);
+        for (const auto& edge : cubexx::edge_t::all())
+            ASSERT_EQ(is_inside(inside, edge.corner0()) != is_inside(inside, edge.corner1()), edges.contains(edge));
+
+        ///the complement crosses the same edges
+        auto outside = cubexx::corner_set_t::from_mask(cubexx::corner_set_t::mask_type(~mask & 0xFF));
+        ASSERT_EQ(edges, cubexx::marching_cubes_edges(outside));
+    }
+}
+
+TEST_F(CUBEXXMarchingCubesTest,triangles)
+{
+    std::size_t most = 0;
+    for (std::size_t mask = 0; mask < 256; ++mask)
+    {
+        auto inside = cubexx::corner_set_t::from_mask(cubexx::corner_set_t::mask_type(mask));
+        auto edges = cubexx::marching_cubes_edges(inside);
+        std::size_t count = cubexx::marching_cubes_triangle_count(inside);
+        ASSERT_LE(count, cubexx::marching_cubes_max_triangles());
+        most = std::max(most, count);
+
+        ///each triangle is 3 distinct crossed edges, and every crossed edge is used
+        cubexx::edge_set_t used;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto triangle = cubexx::marching_cubes_triangle(inside, i);
+            for (std::size_t j = 0; j < 3; ++j)
+            {
+                ASSERT_TRUE(edges.contains(triangle[j]));
+                ASSERT_NE(triangle[j], triangle[(j + 1) % 3]);
+                used |= triangle[j];
+            }
+        }
+        ASSERT_EQ(edges, used);
+        ASSERT_EQ(edges.empty(), count == 0);
+    }
+    ASSERT_EQ(most, cubexx::marching_cubes_max_triangles());
+    ASSERT_EQ(5U, cubexx::marching_cubes_max_triangles());
+}
+
+TEST_F(CUBEXXMarchingCubesTest,orientation)
+{
+    for (std::size_t mask = 0; mask < 256; ++mask)
+    {
+        auto inside = cubexx::corner_set_t::from_mask(cubexx::corner_set_t::mask_type(mask));
+        for (std::size_t i = 0; i < cubexx::marching_cubes_triangle_count(inside); ++i)
+        {
+            auto triangle = cubexx::marching_cubes_triangle(inside, i);
+            vec_t a = midpoint(triangle[0]), b = midpoint(triangle[1]), c = midpoint(triangle[2]);
+            vec_t u = {{b[0] - a[0], b[1] - a[1], b[2] - a[2]}}, v = {{c[0] - a[0], c[1] - a[1], c[2] - a[2]}};
+            vec_t normal = {{u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0]}};
+
+            ///the normal points from the inside corners of its edges to the outside ones
+            int dot = 0;
+            for (const auto& edge : triangle)
+            {
+                vec_t out = outward(inside, edge);
+                dot += normal[0] * out[0] + normal[1] * out[1] + normal[2] * out[2];
+            }
+            ASSERT_LT(0, dot) << "case " << mask << ", triangle " << i;
+
+            ///and none lies flat on a face
+            for (const auto& face : cubexx::face_t::all())
+                ASSERT_FALSE(face.edge_set().contains(triangle[0]) && face.edge_set().contains(triangle[1])
+                          && face.edge_set().contains(triangle[2]));
+        }
+    }
+}
+
+TEST_F(CUBEXXMarchingCubesTest,watertight)
+{
+    ///the boundary segments on each face, by the face and the inside corners on it
+    std::map<std::pair<std::size_t, std::size_t>, std::set<std::pair<std::size_t, std::size_t> > > segments;
+
+    for (std::size_t mask = 0; mask < 256; ++mask)
+    {
+        auto inside = cubexx::corner_set_t::from_mask(cubexx::corner_set_t::mask_type(mask));
+
+        ///the directed sides of the triangles; a side inside the cell is used once each way, consistently oriented
+        std::multiset<std::pair<std::size_t, std::size_t> > sides;
+        for (std::size_t i = 0; i < cubexx::marching_cubes_triangle_count(inside); ++i)
+        {
+            auto triangle = cubexx::marching_cubes_triangle(inside, i);
+            for (std::size_t j = 0; j < 3; ++j)
+                sides.insert(std::make_pair(std::size_t(triangle[j].index()), std::size_t(triangle[(j + 1) % 3].index())));
+        }
+
+        std::map<std::size_t, std::size_t> degree;
+        for (const auto& side : sides)
+        {
+            ASSERT_EQ(1U, sides.count(side));
+            if (sides.count(std::make_pair(side.second, side.first)))
+                continue;
+
+            ///the rest are on the boundary, and lie on a face
+            const auto& a = cubexx::edge_t::get(side.first);
+            const auto& b = cubexx::edge_t::get(side.second);
+            ASSERT_TRUE(on_a_face(a, b));
+            ++degree[side.first];
+            ++degree[side.second];
+
+            for (const auto& face : cubexx::face_t::all())
+            {
+                if (!face.edge_set().contains(a) || !face.edge_set().contains(b))
+                    continue;
+                auto key = std::make_pair(std::size_t(face.index()), std::size_t((face.corner_set() & inside).mask()));
+                segments[key].insert(std::make_pair(std::min(side.first, side.second), std::max(side.first, side.second)));
+            }
+        }
+
+        ///every crossed edge is on the boundary twice, once for each of its faces
+        for (const auto& edge : cubexx::marching_cubes_edges(inside))
+            ASSERT_EQ(2U, degree[edge.index()]);
+    }
+
+    ///the segments on a face depend only on the corners of that face, so neighboring cells agree on them
+    for (const auto& entry : segments)
+    {
+        ///the face's crossed edges are paired off
+        const auto& face = cubexx::face_t::all()[entry.first.first];
+        auto on_face = cubexx::corner_set_t::from_mask(cubexx::corner_set_t::mask_type(entry.first.second));
+        ASSERT_EQ((face.edge_set() & cubexx::marching_cubes_edges(on_face)).size(), 2 * entry.second.size());
+    }
+}
+
+TEST_F(CUBEXXMarchingCubesTest,classify_row)
+{
+    std::mt19937 generator(1234);
+    std::uniform_real_distribution<float> distribution(-1, 1);
+    for (std::size_t n : {0, 1, 15, 16, 37, 64})
+    {
+        std::vector<float> values[4];
+        const float* rows[4];
+        for (std::size_t r = 0; r < 4; ++r)
+        {
+            for (std::size_t x = 0; x < n + 1; ++x)
+                values[r].push_back(x % 7 == 3 ? 0.25f : distribution(generator));
+            rows[r] = values[r].data();
+        }
+
+        std::vector<std::uint8_t> cases(n, 0xAA), expected(n, 0x55);
+        cubexx::marching_cubes_classify_row(rows, n, 0.25f, cases.data());
+        cubexx::detail::marching_cubes_classify_row_scalar(rows, n, 0.25f, expected.data());
+        ASSERT_EQ(expected, cases);
+
+        ///against the corners themselves
+        for (std::size_t x = 0; x < n; ++x)
+        {
+            cubexx::corner_set_t inside;
+            for (const auto& corner : cubexx::corner_t::all())
+                if (values[corner.uy() + 2 * corner.uz()][x + corner.ux()] < 0.25f)
+                    inside |= corner;
+            ASSERT_EQ(inside.mask(), cases[x]);
+        }
+    }
+}
@@ -0,0 +1,295 @@
+
+
+
+#include <vector>
+#include <random>
+#include <memory>
+#include <array>
+
+#include "cubexx/cubexx.hpp"
+#include "cubexx/morton.hpp"
+#include "cubexx/formatters.hpp"
+
+#include "gtest/gtest.h"
+
+
+
+
+
+struct CUBEXXMortonTest : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        
+    }
+
+    virtual void TearDown() {
+    // Code here will be called immediately after each test
+    // (right before the destructor).
+    
+    }
+
+    ///encode() then decode() must give back the coordinates, for every level
+    template<typename code_t>
+    static void check_round_trip()
+    {
+        std::mt19937 generator(1234);
+        for (std::size_t level = 0; level <= code_t::MAX_DEPTH(); ++level)
+        {
+            std::uniform_int_distribution<std::uint32_t> distribution(0, (std::uint32_t(1) << level) - 1);
+            for (std::size_t i = 0; i < 100; ++i)
+            {
+                std::uint32_t x = distribution(generator), y = distribution(generator), z = distribution(generator);
+                code_t code = code_t::encode(x, y, z, level);
+                ASSERT_EQ(level, code.level());
+
+                auto xyz = code.decode();
+                ASSERT_EQ(x, xyz[0]);
+                ASSERT_EQ(y, xyz[1]);
+                ASSERT_EQ(z, xyz[2]);
+            }
+        }
+    }
+};
+
+
+TEST_F(CUBEXXMortonTest,dilate)
+{
+    std::mt19937_64 generator(1234);
+    for (std::size_t i = 0; i < 1000; ++i)
+    {
+        std::uint64_t v = generator() & 0x1FFFFF;
+
+        std::uint64_t expected = 0;
+        for (std::size_t bit = 0; bit < 21; ++bit)
+            expected |= ((v >> bit) & 1) << (3 * bit);
+
+        ASSERT_EQ(expected, cubexx::detail::morton_dilate3(v));
+        ASSERT_EQ(v, cubexx::detail::morton_compact3(expected));
+    }
+}
+
+TEST_F(CUBEXXMortonTest,root)
+{
+    cubexx::morton_code32_t root;
+    ASSERT_TRUE(root.is_root());
+    ASSERT_EQ(0U, root.level());
+    ASSERT_EQ(1U, root.bits());
+    ASSERT_EQ(0U, root.path());
+    ASSERT_EQ(root, cubexx::morton_code32_t::root());
+    ASSERT_EQ(root, cubexx::morton_code32_t::encode(0, 0, 0, 0));
+}
+
+TEST_F(CUBEXXMortonTest,child_is_corner_index)
+{
+    ///the first level of the code is exactly the corner's index, which is its Morton order
+    for (auto corner : cubexx::corner_t::all())
+    {
+        auto code = cubexx::morton_code64_t::root().child(corner);
+        ASSERT_EQ(1U, code.level());
+        ASSERT_EQ(corner.index(), code.path());
+        ASSERT_EQ(corner, code.corner());
+        ASSERT_EQ(cubexx::morton_code64_t::encode(corner.ux(), corner.uy(), corner.uz(), 1), code);
+        ASSERT_TRUE(code.parent().is_root());
+    }
+}
+
+TEST_F(CUBEXXMortonTest,path)
+{
+    std::mt19937 generator(1234);
+    std::uniform_int_distribution<int> distribution(0, 7);
+
+    std::vector<cubexx::corner_t> corners;
+    cubexx::morton_code32_t code;
+    std::uint32_t x = 0, y = 0, z = 0;
+    for (std::size_t level = 1; level <= cubexx::morton_code32_t::MAX_DEPTH(); ++level)
+    {
+        const auto& corner = cubexx::corner_t::get(std::uint_fast8_t(distribution(generator)));
+        corners.push_back(corner);
+
+        auto parent = code;
+        code = code.child(corner);
+        ASSERT_EQ(level, code.level());
+        ASSERT_EQ(parent, code.parent());
+        ASSERT_TRUE(parent < code);
+
+        ///descending to a child doubles the coordinates, and adds the corner
+        x = 2 * x + corner.ux();
+        y = 2 * y + corner.uy();
+        z = 2 * z + corner.uz();
+        ASSERT_EQ(cubexx::morton_code32_t::encode(x, y, z, level), code);
+
+        for (std::size_t l = 1; l <= level; ++l)
+        {
+            ASSERT_EQ(corners[l - 1], code.corner_at(l));
+            ASSERT_EQ(l, code.ancestor(l).level());
+            ASSERT_EQ(corners[l - 1], code.ancestor(l).corner());
+        }
+    }
+}
+
+TEST_F(CUBEXXMortonTest,round_trip)
+{
+    check_round_trip<cubexx::morton_code32_t>();
+    check_round_trip<cubexx::morton_code64_t>();
+    check_round_trip<cubexx::morton_code_t<3>>();
+}
+
+TEST_F(CUBEXXMortonTest,from_bits)
+{
+    auto code = cubexx::morton_code64_t::encode(12345, 54321, 99999, 17);
+    ASSERT_EQ(code, cubexx::morton_code64_t::from_bits(code.bits()));
+}
+
+TEST_F(CUBEXXMortonTest,batch)
+{
+    typedef cubexx::morton_code64_t code_t;
+
+    std::mt19937 generator(1234);
+    std::uniform_int_distribution<std::uint32_t> distribution(0, (std::uint32_t(1) << 21) - 1);
+    std::vector<std::uint32_t> xs, ys, zs;
+    for (std::size_t i = 0; i < 1001; ++i)
+    {
+        xs.push_back(distribution(generator));
+        ys.push_back(distribution(generator));
+        zs.push_back(distribution(generator));
+    }
+
+    std::vector<code_t> codes(xs.size());
+    code_t::encode_n(xs.data(), ys.data(), zs.data(), 21, codes.data(), codes.size());
+    for (std::size_t i = 0; i < codes.size(); ++i)
+        ASSERT_EQ(code_t::encode(xs[i], ys[i], zs[i]), codes[i]);
+
+    std::vector<std::uint32_t> dxs(xs.size()), dys(xs.size()), dzs(xs.size());
+    code_t::decode_n(codes.data(), dxs.data(), dys.data(), dzs.data(), codes.size());
+    ASSERT_EQ(xs, dxs);
+    ASSERT_EQ(ys, dys);
+    ASSERT_EQ(zs, dzs);
+}
+
+///the neighbor of @p code offset by @p offset, worked out on the decoded coordinates
+template<typename code_t>
+static cubexx::morton_neighbor_t<code_t::MAX_DEPTH()>
+reference_neighbor(const code_t& code, const std::array<int, 3>& offset)
+{
+    std::int64_t size = std::int64_t(1) << code.level();
+    auto xyz = code.decode();
+
+    bool outside = false;
+    std::array<std::uint32_t, 3> result;
+    for (std::size_t axis = 0; axis < 3; ++axis)
+    {
+        std::int64_t v = std::int64_t(xyz[axis]) + offset[axis];
+        outside |= v < 0 || v >= size;
+        result[axis] = std::uint32_t((v + size) % size);
+    }
+    return {code_t::encode(result[0], result[1], result[2], code.level()), outside};
+}
+
+TEST_F(CUBEXXMortonTest,neighbor)
+{
+    typedef cubexx::morton_code64_t code_t;
+
+    std::mt19937 generator(1234);
+    std::vector<code_t> codes;
+    for (std::size_t level = 0; level <= code_t::MAX_DEPTH(); ++level)
+    {
+        std::uint32_t last = (std::uint32_t(1) << level) - 1;
+        std::uniform_int_distribution<std::uint32_t> distribution(0, last);
+        for (std::size_t i = 0; i < 20; ++i)
+            codes.push_back(code_t::encode(distribution(generator), distribution(generator), distribution(generator), level));
+        ///and the boundary cells, where the neighbors leave the root
+        codes.push_back(code_t::encode(0, 0, 0, level));
+        codes.push_back(code_t::encode(last, last, last, level));
+        codes.push_back(code_t::encode(0, last, 0, level));
+    }
+
+    for (const auto& code : codes)
+    {
+        for (auto direction : cubexx::direction_t::all())
+        {
+            auto expected = reference_neighbor(code, {{direction.x(), direction.y(), direction.z()}});
+            auto actual = cubexx::neighbor(code, direction);
+            ASSERT_EQ(expected.code, actual.code);
+            ASSERT_EQ(expected.outside, actual.outside);
+        }
+        for (auto edge : cubexx::edge_t::all())
+        {
+            const auto& offset = cubexx::offset_t::get(edge);
+            auto expected = reference_neighbor(code, {{offset.dx(), offset.dy(), offset.dz()}});
+            auto actual = cubexx::neighbor(code, edge);
+            ASSERT_EQ(expected.code, actual.code);
+            ASSERT_EQ(expected.outside, actual.outside);
+        }
+        for (auto corner : cubexx::corner_t::all())
+        {
+            auto expected = reference_neighbor(code, {{corner.x(), corner.y(), corner.z()}});
+            auto actual = cubexx::neighbor(code, corner);
+            ASSERT_EQ(expected.code, actual.code);
+            ASSERT_EQ(expected.outside, actual.outside);
+        }
+        for (const auto& offset : cubexx::offset_t::all())
+        {
+            auto expected = reference_neighbor(code, {{offset.dx(), offset.dy(), offset.dz()}});
+            auto actual = cubexx::neighbor(code, offset);
+            ASSERT_EQ(expected.code, actual.code);
+            ASSERT_EQ(expected.outside, actual.outside);
+        }
+    }
+}
+
+TEST_F(CUBEXXMortonTest,neighbor_siblings)
+{
+    ///within a parent, the corner neighbor of a child is the sibling at the opposite corner
+    auto parent = cubexx::morton_code32_t::encode(3, 4, 5, 3);
+    for (auto corner : cubexx::corner_t::all())
+    {
+        auto child = parent.child(corner);
+        auto result = cubexx::neighbor(child, corner.opposite());
+        ASSERT_FALSE(result.outside);
+        ASSERT_EQ(parent.child(corner.opposite()), result.code);
+    }
+
+    ///the root has no neighbors at all
+    for (auto direction : cubexx::direction_t::all())
+    {
+        auto result = cubexx::neighbor(cubexx::morton_code32_t::root(), direction);
+        ASSERT_TRUE(result.outside);
+        ASSERT_TRUE(result.code.is_root());
+    }
+}
+
+TEST_F(CUBEXXMortonTest,neighbor_n)
+{
+    typedef cubexx::morton_code32_t code_t;
+
+    std::vector<code_t> codes;
+    for (std::uint32_t x = 0; x < 8; ++x)
+        for (std::uint32_t y = 0; y < 8; ++y)
+            codes.push_back(code_t::encode(x, y, 7 - x, 3));
+    ///codes of other levels in the same batch, down to the root
+    codes.push_back(code_t::root());
+    codes.push_back(code_t::encode(1, 0, 1, 1));
+    codes.push_back(code_t::encode(1023, 0, 512, 10));
+
+    std::vector<code_t> neighbors(codes.size());
+    std::unique_ptr<bool[]> outside(new bool[codes.size()]);
+    auto check = [&](const auto& element)
+    {
+        cubexx::neighbor_n(codes.data(), codes.size(), element, neighbors.data(), outside.get());
+        for (std::size_t i = 0; i < codes.size(); ++i)
+        {
+            auto expected = cubexx::neighbor(codes[i], element);
+            ASSERT_EQ(expected.code, neighbors[i]);
+            ASSERT_EQ(expected.outside, outside[i]);
+        }
+    };
+    for (auto direction : cubexx::direction_t::all())
+        check(direction);
+    for (auto edge : cubexx::edge_t::all())
+        check(edge);
+    for (auto corner : cubexx::corner_t::all())
+        check(corner);
+
+    cubexx::neighbor_n(codes.data(), codes.size(), cubexx::direction_t::get(1, 0, 0), neighbors.data(), nullptr);
+    ASSERT_EQ(cubexx::neighbor(codes[5], cubexx::direction_t::get(1, 0, 0)).code, neighbors[5]);
+}
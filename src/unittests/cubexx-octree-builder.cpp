@@ -0,0 +1,289 @@
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <atomic>
+#include <utility>
+#include <cstdint>
+
+#include "cubexx/cubexx.hpp"
+#include "cubexx/octree_builder.hpp"
+#include "cubexx/formatters.hpp"
+
+#include "gtest/gtest.h"
+
+
+
+
+
+struct CUBEXXOctreeBuilderTest : public ::testing::Test {
+protected:
+    static const std::size_t DEPTH = 8;
+    typedef cubexx::octree_builder_t<DEPTH> builder_t;
+    typedef builder_t::result_type result_t;
+    typedef builder_t::code_type code_t;
+
+    virtual void SetUp() {
+        ///clusters of points, so that the leaves end up on many different levels
+        std::mt19937 generator(1234);
+        std::uniform_int_distribution<std::uint32_t> any(0, (1 << DEPTH) - 1);
+        std::normal_distribution<float> spread(0, 4);
+        for (std::size_t cluster = 0; cluster < 20; ++cluster)
+        {
+            std::uint32_t cx = any(generator), cy = any(generator), cz = any(generator);
+            for (std::size_t i = 0; i < 500; ++i)
+            {
+                xs.push_back(clamp(cx + spread(generator)));
+                ys.push_back(clamp(cy + spread(generator)));
+                zs.push_back(clamp(cz + spread(generator)));
+            }
+        }
+        ///and a pile of coincident points, more than fit in a leaf
+        for (std::size_t i = 0; i < 40; ++i)
+        {
+            xs.push_back(7);
+            ys.push_back(9);
+            zs.push_back(11);
+        }
+    }
+
+    virtual void TearDown() {
+    // Code here will be called immediately after each test
+    // (right before the destructor).
+    
+    }
+
+    static std::uint32_t clamp(float v)
+    {
+        return std::uint32_t(std::min(std::max(v, 0.f), float((1 << DEPTH) - 1)));
+    }
+
+    ///checks everything about @p result, built from the fixed-point points with @p capacity
+    void check(const result_t& result, std::size_t capacity) const
+    {
+        std::vector<code_t> codes(xs.size());
+        code_t::encode_n(xs.data(), ys.data(), zs.data(), DEPTH, codes.data(), xs.size());
+        std::vector<std::uint64_t> paths;
+        for (const code_t& code : codes)
+            paths.push_back(code.path());
+        std::sort(paths.begin(), paths.end());
+
+        ///every point is in order exactly once
+        ASSERT_EQ(xs.size(), result.order.size());
+        std::vector<std::uint32_t> order = result.order;
+        std::sort(order.begin(), order.end());
+        for (std::size_t i = 0; i < order.size(); ++i)
+            ASSERT_EQ(i, order[i]);
+
+        ///the leaves' runs cover order, in order, and hold the points within them
+        std::size_t next = 0;
+        for (auto leaf : result.leaves)
+        {
+            ASSERT_EQ(next, leaf.second.first);
+            ASSERT_LT(0U, leaf.second.count);
+            next += leaf.second.count;
+            for (std::size_t i = leaf.second.first; i < next; ++i)
+                ASSERT_TRUE(leaf.first.contains(codes[result.order[i]]));
+
+            ///a leaf is as large as it can be
+            ASSERT_TRUE(leaf.second.count <= capacity || leaf.first.level() == DEPTH);
+            if (!leaf.first.is_root())
+            {
+                code_t parent = leaf.first.parent();
+                std::size_t shift = 3 * (DEPTH - parent.level());
+                std::uint64_t first = std::uint64_t(parent.path()) << shift;
+                std::uint64_t last = std::uint64_t(parent.path() + 1) << shift;
+                std::size_t count = std::lower_bound(paths.begin(), paths.end(), last)
+                                  - std::lower_bound(paths.begin(), paths.end(), first);
+                ASSERT_LT(capacity, count);
+            }
+        }
+        ASSERT_EQ(xs.size(), next);
+
+        ///the internal nodes are every ancestor of a leaf, children first
+        std::vector<code_t> ancestors;
+        for (auto leaf : result.leaves)
+            for (std::size_t level = 0; level < leaf.first.level(); ++level)
+                ancestors.push_back(leaf.first.ancestor(level));
+        std::sort(ancestors.begin(), ancestors.end());
+        ancestors.erase(std::unique(ancestors.begin(), ancestors.end()), ancestors.end());
+        ASSERT_EQ(ancestors.size(), result.nodes.size());
+
+        std::vector<code_t> seen;
+        for (const auto& node : result.nodes)
+        {
+            ASSERT_EQ(result.leaves.children(node.code), node.children);
+            for (auto corner : node.children)
+            {
+                code_t child = node.code.child(corner);
+                if (result.leaves.locate(child) == result.leaves.size())
+                {
+                    ASSERT_NE(seen.end(), std::find(seen.begin(), seen.end(), child));
+                }
+            }
+            seen.push_back(node.code);
+        }
+    }
+
+    std::vector<std::uint32_t> xs, ys, zs;
+};
+
+const std::size_t CUBEXXOctreeBuilderTest::DEPTH;
+
+
+TEST_F(CUBEXXOctreeBuilderTest,thread_pool)
+{
+    for (std::size_t threads : {1, 2, 5})
+    {
+        cubexx::thread_pool_t pool(threads);
+        ASSERT_EQ(threads, pool.size());
+
+        pool.run(0, [](std::size_t){ FAIL(); });
+
+        ///many small jobs back to back, each task run exactly once
+        for (std::size_t job = 0; job < 200; ++job)
+        {
+            std::size_t n = job % 37;
+            std::vector<std::atomic<int>> runs(n);
+            for (auto& run : runs)
+                run = 0;
+            pool.run(n, [&](std::size_t i){ ++runs[i]; });
+            for (auto& run : runs)
+                ASSERT_EQ(1, run.load());
+        }
+    }
+
+    cubexx::thread_pool_t pool;
+    ASSERT_LE(1U, pool.size());
+}
+
+TEST_F(CUBEXXOctreeBuilderTest,quantize_n)
+{
+    ///[0, 4) in 4 cells; boundaries go down, like a zero goes to the lower corner
+    std::vector<float> vs = {-1.f, 0.f, 0.5f, 1.f, 1.5f, 2.f, 3.f, 3.5f, 4.f, 9.f};
+    std::vector<std::uint32_t> expected = {0, 0, 0, 0, 1, 1, 2, 3, 3, 3};
+    std::vector<std::uint32_t> qs(vs.size());
+    cubexx::detail::quantize_n(vs.data(), qs.data(), vs.size(), 0.f, 1.f, 4);
+    ASSERT_EQ(expected, qs);
+}
+
+TEST_F(CUBEXXOctreeBuilderTest,radix_sort)
+{
+    std::mt19937_64 generator(1234);
+    cubexx::thread_pool_t pool(3);
+
+    for (std::size_t bits : {5, 24, 63})
+    {
+        std::vector<std::uint64_t> keys;
+        std::vector<std::uint32_t> values;
+        std::vector<std::pair<std::uint64_t, std::uint32_t>> expected;
+        for (std::uint32_t i = 0; i < 100000; ++i)
+        {
+            std::uint64_t key = generator() >> (64 - bits);
+            keys.push_back(key);
+            values.push_back(i);
+            expected.emplace_back(key, i);
+        }
+        ///stable, so the values of equal keys stay in order
+        std::sort(expected.begin(), expected.end());
+
+        std::vector<std::uint64_t> keys_only = keys;
+        cubexx::detail::radix_sort(pool, keys, values, bits);
+        for (std::size_t i = 0; i < expected.size(); ++i)
+        {
+            ASSERT_EQ(expected[i].first, keys[i]);
+            ASSERT_EQ(expected[i].second, values[i]);
+        }
+
+        cubexx::detail::radix_sort(pool, keys_only, bits);
+        ASSERT_EQ(keys, keys_only);
+    }
+}
+
+TEST_F(CUBEXXOctreeBuilderTest,build)
+{
+    for (std::size_t capacity : {1, 16})
+    {
+        cubexx::thread_pool_t pool(4);
+        builder_t builder(pool, capacity);
+        ASSERT_EQ(capacity, builder.leaf_capacity());
+
+        result_t result = builder.build(xs.data(), ys.data(), zs.data(), xs.size());
+        check(result, capacity);
+
+        ///the same tree, however many threads build it
+        cubexx::thread_pool_t single(1);
+        result_t expected = builder_t(single, capacity).build(xs.data(), ys.data(), zs.data(), xs.size());
+        ASSERT_EQ(expected.order, result.order);
+        ASSERT_EQ(expected.leaves.size(), result.leaves.size());
+        for (std::size_t i = 0; i < expected.leaves.size(); ++i)
+            ASSERT_EQ(expected.leaves.code(i), result.leaves.code(i));
+    }
+}
+
+TEST_F(CUBEXXOctreeBuilderTest,build_small)
+{
+    cubexx::thread_pool_t pool(2);
+    builder_t builder(pool, 4);
+
+    result_t empty = builder.build(xs.data(), ys.data(), zs.data(), 0);
+    ASSERT_TRUE(empty.leaves.empty());
+    ASSERT_TRUE(empty.nodes.empty());
+    ASSERT_TRUE(empty.order.empty());
+
+    ///few enough points for the root to be the only leaf
+    result_t root = builder.build(xs.data(), ys.data(), zs.data(), 3);
+    ASSERT_EQ(1U, root.leaves.size());
+    ASSERT_EQ(code_t::root(), root.leaves.code(0));
+    ASSERT_EQ(3U, root.leaves.value(0).count);
+    ASSERT_TRUE(root.nodes.empty());
+}
+
+TEST_F(CUBEXXOctreeBuilderTest,build_float)
+{
+    std::mt19937 generator(1234);
+    std::uniform_real_distribution<float> distribution(-1, 1);
+    std::vector<float> fxs, fys, fzs;
+    for (std::size_t i = 0; i < 5000; ++i)
+    {
+        fxs.push_back(distribution(generator));
+        fys.push_back(distribution(generator));
+        fzs.push_back(distribution(generator));
+    }
+    ///exact zeros, on the boundary between the root's children, are on the lower side
+    fxs[3] = fys[5] = fzs[7] = 0;
+    fxs[11] = fys[11] = fzs[11] = 0;
+
+    cubexx::thread_pool_t pool(3);
+    result_t result = builder_t(pool, 8).build(fxs.data(), fys.data(), fzs.data(), fxs.size(), {{-1, -1, -1}}, 2);
+    ASSERT_EQ(fxs.size(), result.order.size());
+
+    for (auto leaf : result.leaves)
+    {
+        ASSERT_LT(0U, leaf.first.level());
+        for (std::size_t i = leaf.second.first; i < leaf.second.first + leaf.second.count; ++i)
+        {
+            std::uint32_t point = result.order[i];
+            std::size_t index = (fxs[point] > 0 ? 1 : 0) | (fys[point] > 0 ? 2 : 0) | (fzs[point] > 0 ? 4 : 0);
+            ASSERT_EQ(index, leaf.first.corner_at(1).index());
+        }
+    }
+}
+
+TEST_F(CUBEXXOctreeBuilderTest,pooled)
+{
+    cubexx::thread_pool_t pool(4);
+    result_t result = builder_t(pool, 16).build(xs.data(), ys.data(), zs.data(), xs.size());
+    auto octree = result.pooled();
+
+    ASSERT_EQ(result.leaves.size() + result.nodes.size(), octree.size());
+    for (auto leaf : result.leaves)
+    {
+        auto node = octree.find(leaf.first);
+        ASSERT_NE(octree.null_node(), node);
+        ASSERT_TRUE(octree.is_leaf(node));
+        ASSERT_EQ(leaf.second.first, octree.value(node).first);
+        ASSERT_EQ(leaf.second.count, octree.value(node).count);
+    }
+    for (const auto& node : result.nodes)
+        ASSERT_EQ(node.children, octree.children(octree.find(node.code)));
+}
@@ -0,0 +1,215 @@
+
+
+
+#include <vector>
+#include <random>
+#include <set>
+#include <cstdint>
+
+#include "cubexx/cubexx.hpp"
+#include "cubexx/octree.hpp"
+#include "cubexx/formatters.hpp"
+
+#include "gtest/gtest.h"
+
+
+
+
+
+struct CUBEXXOctreeTest : public ::testing::Test {
+protected:
+    typedef cubexx::octree_t<float, 16> octree_t;
+    typedef cubexx::morton_code_t<8> code_t;
+
+    virtual void SetUp() {
+        
+    }
+
+    virtual void TearDown() {
+    // Code here will be called immediately after each test
+    // (right before the destructor).
+    
+    }
+};
+
+
+TEST_F(CUBEXXOctreeTest,root)
+{
+    octree_t octree;
+    ASSERT_EQ(1U, octree.size());
+    ASSERT_EQ(0U, octree.block_count());
+    ASSERT_TRUE(octree.is_leaf(octree.root()));
+    ASSERT_TRUE(octree.children(octree.root()).empty());
+
+    octree.value(octree.root()) = 5;
+    ASSERT_EQ(5, octree.value(octree.root()));
+    for (auto corner : cubexx::corner_t::all())
+        ASSERT_EQ(octree_t::null_node(), octree.child(octree.root(), corner));
+}
+
+TEST_F(CUBEXXOctreeTest,insert_child)
+{
+    octree_t octree;
+    auto corner0 = cubexx::corner_t::get(std::uint_fast8_t(3));
+    auto corner1 = cubexx::corner_t::get(std::uint_fast8_t(6));
+
+    auto child0 = octree.insert_child(octree.root(), corner0, 1.5f);
+    ASSERT_EQ(2U, octree.size());
+    ASSERT_EQ(1U, octree.block_count());
+    ASSERT_EQ(child0, octree.child(octree.root(), corner0));
+    ASSERT_EQ(corner0, octree_t::corner(child0));
+    ASSERT_EQ(1.5f, octree.value(child0));
+
+    ///the siblings share the block
+    auto child1 = octree.insert_child(octree.root(), corner1, 2.5f);
+    ASSERT_EQ(1U, octree.block_count());
+    ASSERT_EQ(child0 >> 3, child1 >> 3);
+    ASSERT_EQ(cubexx::corner_set_t(corner0) | corner1, octree.children(octree.root()));
+
+    ///inserting again leaves the existing child alone
+    ASSERT_EQ(child0, octree.insert_child(octree.root(), corner0, 9.f));
+    ASSERT_EQ(1.5f, octree.value(child0));
+    ASSERT_EQ(3U, octree.size());
+}
+
+TEST_F(CUBEXXOctreeTest,layout)
+{
+    ///a float node is padded to 16 bytes, and the 8 siblings are adjacent
+    octree_t octree;
+    octree.subdivide(octree.root());
+    const char* first = reinterpret_cast<const char*>(&octree.value(octree.child(octree.root(), cubexx::corner_t::get(std::uint_fast8_t(0)))));
+    for (auto corner : cubexx::corner_t::all())
+    {
+        const char* node = reinterpret_cast<const char*>(&octree.value(octree.child(octree.root(), corner)));
+        ASSERT_EQ(std::ptrdiff_t(16 * corner.index()), node - first);
+        ///so none straddles a cache line
+        ASSERT_EQ(0U, reinterpret_cast<std::uintptr_t>(node) % 16);
+    }
+}
+
+TEST_F(CUBEXXOctreeTest,erase)
+{
+    octree_t octree;
+    octree.subdivide(octree.root());
+    auto child = octree.child(octree.root(), cubexx::corner_t::get(std::uint_fast8_t(2)));
+    octree.subdivide(child);
+    octree.subdivide(octree.child(child, cubexx::corner_t::get(std::uint_fast8_t(7))));
+    ASSERT_EQ(1U + 8 + 8 + 8, octree.size());
+    ASSERT_EQ(3U, octree.block_count());
+
+    ///erasing a child erases its subtree
+    octree.erase_child(octree.root(), cubexx::corner_t::get(std::uint_fast8_t(2)));
+    ASSERT_EQ(1U + 7, octree.size());
+    ASSERT_EQ(1U, octree.block_count());
+    ASSERT_FALSE(octree.children(octree.root()).contains(cubexx::corner_t::get(std::uint_fast8_t(2))));
+
+    ///erasing the last child frees the block
+    octree.erase_children(octree.root());
+    ASSERT_EQ(1U, octree.size());
+    ASSERT_EQ(0U, octree.block_count());
+    ASSERT_TRUE(octree.is_leaf(octree.root()));
+
+    ///erasing what is not there does nothing
+    octree.erase_child(octree.root(), cubexx::corner_t::get(std::uint_fast8_t(2)));
+    ASSERT_EQ(1U, octree.size());
+}
+
+TEST_F(CUBEXXOctreeTest,codes)
+{
+    std::mt19937 generator(1234);
+    std::uniform_int_distribution<std::uint32_t> distribution(0, (1U << 8) - 1);
+
+    octree_t octree;
+    std::set<code_t> nodes;
+    nodes.insert(code_t::root());
+    for (std::size_t i = 0; i < 500; ++i)
+    {
+        auto code = code_t::encode(distribution(generator), distribution(generator), distribution(generator));
+        auto node = octree.insert(code, float(i));
+        ASSERT_EQ(node, octree.find(code));
+        for (std::size_t level = 0; level <= code.level(); ++level)
+            nodes.insert(code.ancestor(level));
+    }
+    ASSERT_EQ(nodes.size(), octree.size());
+
+    for (const auto& code : nodes)
+    {
+        auto node = octree.find(code);
+        ASSERT_NE(octree_t::null_node(), node);
+        if (!code.is_root())
+        {
+            ASSERT_EQ(code.corner(), octree_t::corner(node));
+            ASSERT_TRUE(octree.children(octree.find(code.parent())).contains(code.corner()));
+        }
+    }
+
+    ///a cell that was never inserted
+    auto missing = code_t::root().child(cubexx::corner_t::get(std::uint_fast8_t(0)));
+    octree.erase_child(octree.root(), missing.corner());
+    ASSERT_EQ(octree_t::null_node(), octree.find(missing));
+    ASSERT_EQ(octree_t::null_node(), octree.find(missing.child(cubexx::corner_t::get(std::uint_fast8_t(1)))));
+}
+
+TEST_F(CUBEXXOctreeTest,pool)
+{
+    ///with the blocks reserved up front, the pool never grows
+    octree_t octree(100);
+    std::size_t capacity = octree.capacity();
+    ASSERT_GE(capacity, 100U);
+
+    for (std::size_t round = 0; round < 10; ++round)
+    {
+        for (auto corner : cubexx::corner_t::all())
+        {
+            auto child = octree.insert_child(octree.root(), corner);
+            octree.subdivide(child);
+        }
+        ASSERT_EQ(9U, octree.block_count());
+        octree.erase_children(octree.root());
+        ASSERT_EQ(0U, octree.block_count());
+    }
+    ASSERT_EQ(capacity, octree.capacity());
+
+    ///and it grows by slabs once it runs out
+    octree_t small;
+    for (auto corner : cubexx::corner_t::all())
+        small.subdivide(small.insert_child(small.root(), corner));
+    ASSERT_EQ(1U + 8 + 64, small.size());
+    ASSERT_GE(small.capacity(), 9U);
+}
+
+namespace {
+
+///Counts the live instances, to catch nodes that are never destroyed.
+struct counted_t
+{
+    counted_t() { ++live; }
+    counted_t(const counted_t&) { ++live; }
+    counted_t& operator=(const counted_t&) = default;
+    ~counted_t() { --live; }
+
+    static int live;
+};
+
+int counted_t::live = 0;
+
+} // namespace
+
+TEST_F(CUBEXXOctreeTest,move)
+{
+    typedef cubexx::octree_t<counted_t, 8> counted_octree_t;
+    {
+        counted_octree_t a, b(20);
+        for (auto corner : cubexx::corner_t::all())
+            a.subdivide(a.insert_child(a.root(), corner));
+        b.insert_child(b.root(), cubexx::corner_t::get(std::uint_fast8_t(3)));
+        ASSERT_LT(0, counted_t::live);
+
+        ///every node of a's slabs is destroyed, by b's destructor
+        a = std::move(b);
+        ASSERT_EQ(2U, a.size());
+        counted_octree_t c(std::move(a));
+        ASSERT_EQ(2U, c.size());
+    }
+    ASSERT_EQ(0, counted_t::live);
+}
@@ -0,0 +1,174 @@
+#include <set>
+#include <array>
+#include <vector>
+#include <cstdint>
+
+#include "cubexx/cubexx.hpp"
+#include "cubexx/offset.hpp"
+#include "cubexx/formatters.hpp"
+
+#include "gtest/gtest.h"
+
+
+
+
+
+struct CUBEXXOffsetTest : public ::testing::Test {
+protected:
+
+    CUBEXXOffsetTest() {}
+
+    virtual void SetUp() {
+    // Code here will be called immediately after the constructor (right
+    // before each test).
+
+    }
+
+    virtual void TearDown() {
+    // Code here will be called immediately after each test
+    // (right before the destructor).
+    
+    }
+
+    static std::size_t nonzero(const cubexx::offset_t& offset)
+    {
+        return (offset.dx() != 0) + (offset.dy() != 0) + (offset.dz() != 0);
+    }
+};
+
+TEST_F(CUBEXXOffsetTest,get)
+{
+    ASSERT_EQ(27U, cubexx::offset_t::all().size());
+    std::set<std::array<int, 3> > seen;
+    for (std::size_t i = 0; i < cubexx::offset_t::SIZE(); ++i)
+    {
+        const auto& offset = cubexx::offset_t::get(std::uint_fast8_t(i));
+        ASSERT_EQ(i, offset.index());
+        ASSERT_EQ(offset, cubexx::offset_t::all()[i]);
+        ASSERT_EQ(offset, cubexx::offset_t::get(offset.dx(), offset.dy(), offset.dz()));
+        ASSERT_EQ(offset.xyz()[0], offset.dx());
+        ASSERT_EQ(offset.xyz()[1], offset.dy());
+        ASSERT_EQ(offset.xyz()[2], offset.dz());
+        std::array<int, 3> xyz = {{offset.dx(), offset.dy(), offset.dz()}};
+        ASSERT_TRUE(seen.insert(xyz).second);
+    }
+
+    ///x fastest
+    ASSERT_EQ(0U, cubexx::offset_t::get(-1, -1, -1).index());
+    ASSERT_EQ(1U, cubexx::offset_t::get(0, -1, -1).index());
+    ASSERT_EQ(3U, cubexx::offset_t::get(-1, 0, -1).index());
+    ASSERT_EQ(9U, cubexx::offset_t::get(-1, -1, 0).index());
+
+    ASSERT_EQ(cubexx::offset_t(), cubexx::offset_t::center());
+    ASSERT_EQ(cubexx::offset_t::get(0, 0, 0), cubexx::offset_t::center());
+}
+
+TEST_F(CUBEXXOffsetTest,opposite)
+{
+    for (const auto& offset : cubexx::offset_t::all())
+    {
+        const auto& opposite = offset.opposite();
+        ASSERT_EQ(-offset.dx(), opposite.dx());
+        ASSERT_EQ(-offset.dy(), opposite.dy());
+        ASSERT_EQ(-offset.dz(), opposite.dz());
+        ASSERT_EQ(offset, opposite.opposite());
+    }
+}
+
+TEST_F(CUBEXXOffsetTest,kinds)
+{
+    std::size_t counts[4] = {0, 0, 0, 0};
+    for (const auto& offset : cubexx::offset_t::all())
+    {
+        std::size_t kind = nonzero(offset);
+        ++counts[kind];
+        ASSERT_EQ(kind == 0, offset.is_center());
+        ASSERT_EQ(kind == 1, offset.is_face());
+        ASSERT_EQ(kind == 2, offset.is_edge());
+        ASSERT_EQ(kind == 3, offset.is_corner());
+    }
+    ASSERT_EQ(1U, counts[0]);
+    ASSERT_EQ(6U, counts[1]);
+    ASSERT_EQ(12U, counts[2]);
+    ASSERT_EQ(8U, counts[3]);
+}
+
+TEST_F(CUBEXXOffsetTest,conversions)
+{
+    for (const auto& direction : cubexx::direction_t::all())
+    {
+        const auto& offset = cubexx::offset_t::get(direction);
+        ASSERT_EQ(direction.x(), offset.dx());
+        ASSERT_EQ(direction.y(), offset.dy());
+        ASSERT_EQ(direction.z(), offset.dz());
+        ASSERT_EQ(direction, offset.direction());
+        ASSERT_EQ(direction.face(), offset.face());
+        ASSERT_EQ(offset, cubexx::offset_t::get(direction.face()));
+        ASSERT_EQ(cubexx::offset_t::get(direction.opposite()), offset.opposite());
+    }
+
+    for (const auto& edge : cubexx::edge_t::all())
+    {
+        const auto& offset = cubexx::offset_t::get(edge);
+        ASSERT_TRUE(offset.is_edge());
+        ASSERT_EQ(edge, offset.edge());
+        ASSERT_EQ(0, offset.xyz()[edge.base_axis()]);
+        ///the neighbor across the edge is across both of the edge's faces
+        for (const auto& face : edge.faces())
+            ASSERT_EQ(face.direction().xyz()[face.direction().axis()], offset.xyz()[face.direction().axis()]);
+    }
+
+    for (const auto& corner : cubexx::corner_t::all())
+    {
+        const auto& offset = cubexx::offset_t::get(corner);
+        ASSERT_EQ(corner.x(), offset.dx());
+        ASSERT_EQ(corner.y(), offset.dy());
+        ASSERT_EQ(corner.z(), offset.dz());
+        ASSERT_EQ(corner, offset.corner());
+        ASSERT_EQ(cubexx::offset_t::get(corner.opposite()), offset.opposite());
+    }
+}
+
+TEST_F(CUBEXXOffsetTest,sets)
+{
+    ASSERT_EQ(6U, cubexx::offset_set_t::faces().size());
+    ASSERT_EQ(12U, cubexx::offset_set_t::edges().size());
+    ASSERT_EQ(8U, cubexx::offset_set_t::corners().size());
+    ASSERT_EQ(6U, cubexx::offset_set_t::neighborhood(6).size());
+    ASSERT_EQ(18U, cubexx::offset_set_t::neighborhood(18).size());
+    ASSERT_EQ(26U, cubexx::offset_set_t::neighborhood(26).size());
+    ASSERT_EQ(cubexx::offset_set_t(cubexx::offset_t::center()), ~cubexx::offset_set_t::neighborhood(26));
+    ASSERT_TRUE((cubexx::offset_set_t::faces() & cubexx::offset_set_t::edges()).empty());
+
+    for (const auto& offset : cubexx::offset_set_t::faces())
+        ASSERT_TRUE(offset.is_face());
+    for (const auto& offset : cubexx::offset_set_t::edges())
+        ASSERT_TRUE(offset.is_edge());
+    for (const auto& offset : cubexx::offset_set_t::corners())
+        ASSERT_TRUE(offset.is_corner());
+
+    cubexx::offset_set_t set(std::vector<cubexx::offset_t>{cubexx::offset_t::get(1, 0, 0), cubexx::offset_t::center()});
+    ASSERT_EQ(2U, set.size());
+    ASSERT_TRUE(set.contains(cubexx::offset_t::center()));
+    set -= cubexx::offset_t::center();
+    ASSERT_EQ(cubexx::offset_t::get(1, 0, 0), set.first());
+    ASSERT_EQ(set, cubexx::offset_set_t::from_mask(set.mask()));
+    ASSERT_EQ(27U, (set | ~set).size());
+}
+
+TEST_F(CUBEXXOffsetTest,deltas)
+{
+    ///a 5 by 4 by 3 grid of values, x fastest
+    const std::size_t nx = 5, ny = 4;
+    const cubexx::offset_deltas_t deltas(1, nx, nx * ny);
+    const std::size_t x = 2, y = 1, z = 1;
+    const std::size_t center = x + nx * (y + ny * z);
+    for (const auto& offset : cubexx::offset_t::all())
+    {
+        std::size_t expected = (x + offset.dx()) + nx * ((y + offset.dy()) + ny * (z + offset.dz()));
+        ASSERT_EQ(expected, center + deltas[offset]);
+        ASSERT_EQ(deltas[offset], deltas.data()[offset.index()]);
+        ASSERT_EQ(deltas[offset], offset.delta(1, nx, nx * ny));
+        ASSERT_EQ(-deltas[offset], deltas[offset.opposite()]);
+    }
+}
@@ -0,0 +1,169 @@
+
+
+
+#include <vector>
+#include <random>
+
+#include "cubexx/cubexx.hpp"
+#include "cubexx/packed.hpp"
+#include "cubexx/formatters.hpp"
+
+#include "gtest/gtest.h"
+
+
+
+
+
+struct CUBEXXPackedTest : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        
+    }
+
+    virtual void TearDown() {
+    // Code here will be called immediately after each test
+    // (right before the destructor).
+    
+    }
+
+    ///a pseudo-random sequence of @p n elements; long enough sequences cover the SIMD blocks and the tails
+    template<typename element_t>
+    static std::vector<element_t> random_elements(std::size_t n)
+    {
+        std::mt19937 generator(1234 + n);
+        std::uniform_int_distribution<int> distribution(0, int(element_t::SIZE()) - 1);
+        std::vector<element_t> result;
+        for (std::size_t i = 0; i < n; ++i)
+            result.push_back(element_t::get(std::uint_fast8_t(distribution(generator))));
+        return result;
+    }
+
+    ///element access, bulk assign() and bulk unpack() must all agree
+    template<typename packed_t>
+    static void check_round_trip()
+    {
+        typedef typename packed_t::value_type element_t;
+        for (std::size_t n : {0, 1, 2, 7, 8, 9, 31, 32, 33, 100, 1000, 1031})
+        {
+            auto elements = random_elements<element_t>(n);
+
+            packed_t bulk(elements.data(), elements.size());
+            ASSERT_EQ(n, bulk.size());
+
+            packed_t single;
+            for (auto element : elements)
+                single.push_back(element);
+            ASSERT_EQ(bulk, single);
+
+            for (std::size_t i = 0; i < n; ++i)
+                ASSERT_EQ(elements[i], bulk[i]);
+
+            std::vector<element_t> unpacked(n, element_t::get(std::uint_fast8_t(0)));
+            bulk.unpack(unpacked.data());
+            ASSERT_EQ(elements, unpacked);
+
+            std::vector<element_t> iterated(bulk.begin(), bulk.end());
+            ASSERT_EQ(elements, iterated);
+        }
+    }
+};
+
+
+TEST_F(CUBEXXPackedTest,size)
+{
+    cubexx::packed_corner_array_t nibbles(9);
+    ASSERT_EQ(9U, nibbles.size());
+    ASSERT_EQ(5U, cubexx::packed_corner_array_t::byte_count(9));
+
+    cubexx::packed3_corner_array_t triples(9);
+    ASSERT_EQ(9U, triples.size());
+    ///whole groups of 8 elements in 3 bytes
+    ASSERT_EQ(6U, cubexx::packed3_corner_array_t::byte_count(9));
+    ASSERT_EQ(3U, cubexx::packed3_corner_array_t::byte_count(8));
+
+    cubexx::packed_edge_array_t empty;
+    ASSERT_TRUE(empty.empty());
+    ASSERT_EQ(empty.begin(), empty.end());
+}
+
+TEST_F(CUBEXXPackedTest,layout)
+{
+    cubexx::packed_corner_array_t nibbles;
+    nibbles.push_back(cubexx::corner_t::get(std::uint_fast8_t(1)));
+    nibbles.push_back(cubexx::corner_t::get(std::uint_fast8_t(6)));
+    nibbles.push_back(cubexx::corner_t::get(std::uint_fast8_t(3)));
+    ASSERT_EQ(0x61, nibbles.data()[0]);
+    ASSERT_EQ(0x03, nibbles.data()[1]);
+
+    cubexx::packed3_corner_array_t triples(3);
+    triples[0] = cubexx::corner_t::get(std::uint_fast8_t(1));
+    triples[1] = cubexx::corner_t::get(std::uint_fast8_t(6));
+    triples[2] = cubexx::corner_t::get(std::uint_fast8_t(7));
+    ///1 | 6 << 3 | 7 << 6
+    ASSERT_EQ(0xF1, triples.data()[0]);
+    ASSERT_EQ(0x01, triples.data()[1]);
+    ASSERT_EQ(0x00, triples.data()[2]);
+}
+
+TEST_F(CUBEXXPackedTest,set)
+{
+    for (auto corner : cubexx::corner_t::all())
+    {
+        cubexx::packed3_corner_array_t triples(20);
+        cubexx::packed_corner_array_t nibbles(20);
+
+        for (std::size_t i = 0; i < 20; ++i)
+        {
+            triples[i] = corner;
+            nibbles.set(i, corner);
+
+            ///setting one element leaves its neighbours alone
+            for (std::size_t j = 0; j < 20; ++j)
+            {
+                auto expected = j <= i ? corner : cubexx::corner_t::get(std::uint_fast8_t(0));
+                ASSERT_EQ(expected, triples[j]);
+                ASSERT_EQ(expected, nibbles.get(j));
+            }
+        }
+    }
+}
+
+TEST_F(CUBEXXPackedTest,resize)
+{
+    auto corner = cubexx::corner_t::get(std::uint_fast8_t(5));
+    cubexx::packed3_corner_array_t triples(11, corner);
+    triples.resize(3);
+    triples.resize(11);
+
+    ///growing again fills with the default, not with what was there before
+    cubexx::packed3_corner_array_t expected(3, corner);
+    expected.resize(11);
+    ASSERT_EQ(expected, triples);
+    ASSERT_EQ(corner, triples[2]);
+    ASSERT_EQ(cubexx::corner_t::get(std::uint_fast8_t(0)), triples[3]);
+}
+
+TEST_F(CUBEXXPackedTest,iterator)
+{
+    auto elements = random_elements<cubexx::edge_t>(50);
+    cubexx::packed_edge_array_t packed(elements.data(), elements.size());
+
+    auto it = packed.begin();
+    ASSERT_EQ(elements[0], *it);
+    ASSERT_EQ(elements[10], it[10]);
+    ASSERT_EQ(elements[49], *(packed.end() - 1));
+    ASSERT_EQ(50, packed.end() - packed.begin());
+    ASSERT_TRUE(packed.begin() < packed.end());
+}
+
+TEST_F(CUBEXXPackedTest,round_trip)
+{
+    check_round_trip<cubexx::packed_corner_array_t>();
+    check_round_trip<cubexx::packed_direction_array_t>();
+    check_round_trip<cubexx::packed_face_array_t>();
+    check_round_trip<cubexx::packed_edge_array_t>();
+
+    check_round_trip<cubexx::packed3_corner_array_t>();
+    check_round_trip<cubexx::packed3_direction_array_t>();
+    check_round_trip<cubexx::packed3_face_array_t>();
+}
@@ -0,0 +1,235 @@
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <limits>
+#include <cstdint>
+
+#include "cubexx/cubexx.hpp"
+#include "cubexx/raycast.hpp"
+#include "cubexx/formatters.hpp"
+
+#include "gtest/gtest.h"
+
+
+
+
+
+struct CUBEXXRaycastTest : public ::testing::Test {
+protected:
+    static const std::size_t DEPTH = 5;
+    typedef cubexx::morton_code_t<DEPTH> code_t;
+    typedef cubexx::octree_t<int, 64> octree_t;
+    typedef cubexx::linear_octree_t<int, DEPTH> linear_octree_t;
+
+    ///a leaf, and where the brute force says the ray passes through it
+    struct crossing_t
+    {
+        code_t code;
+        float t_entry, t_exit;
+    };
+
+    virtual void SetUp() {
+        ///a sparse tree: random cells at random depths
+        std::mt19937 generator(1234);
+        std::uniform_int_distribution<std::size_t> level(1, DEPTH);
+        for (std::size_t i = 0; i < 200; ++i)
+        {
+            std::size_t l = level(generator);
+            std::uniform_int_distribution<std::uint32_t> coordinate(0, (1 << l) - 1);
+            octree.insert(code_t::encode(coordinate(generator), coordinate(generator), coordinate(generator), l));
+        }
+
+        ///the same leaves in a linear octree
+        collect(octree.root(), code_t::root());
+        std::vector<int> values(leaves.size());
+        linear = linear_octree_t(leaves, values);
+
+        ///rays from all around, and some starting inside; some parallel to an axis or two
+        std::uniform_real_distribution<float> position(-0.5f, 1.5f), direction(-1, 1);
+        for (std::size_t i = 0; i < 400; ++i)
+        {
+            cubexx::ray_t ray = {{{position(generator), position(generator), position(generator)}},
+                                 {{direction(generator), direction(generator), direction(generator)}}};
+            if (i % 16 == 0)
+                ray.direction[i % 3] = 0;
+            if (i % 32 == 0)
+                ray.direction[(i + 1) % 3] = 0;
+            ///aim half of the rays at the tree
+            if (i % 2 == 0)
+            {
+                for (std::size_t k = 0; k < 3; ++k)
+                    ray.direction[k] = ray.direction[k] * 0.3f + (0.5f - ray.origin[k]);
+            }
+            rays.push_back(ray);
+        }
+    }
+
+    virtual void TearDown() {
+    // Code here will be called immediately after each test
+    // (right before the destructor).
+    
+    }
+
+    void collect(octree_t::node_id node, const code_t& code)
+    {
+        if (octree.is_leaf(node))
+        {
+            leaves.push_back(code);
+            return;
+        }
+        for (auto corner : octree.children(node))
+            collect(octree.child(node, corner), code.child(corner));
+    }
+
+    ///every leaf the ray passes through, by slab tests, front to back
+    std::vector<crossing_t> brute_force(const cubexx::ray_t& ray) const
+    {
+        std::vector<crossing_t> result;
+        for (const code_t& leaf : leaves)
+        {
+            auto xyz = leaf.decode();
+            float size = 1.0f / float(1 << leaf.level());
+            float t_entry = 0, t_exit = std::numeric_limits<float>::infinity();
+            for (std::size_t k = 0; k < 3; ++k)
+            {
+                float lower = float(xyz[k]) * size, upper = lower + size;
+                if (ray.direction[k] == 0)
+                {
+                    if (ray.origin[k] < lower || ray.origin[k] > upper)
+                        t_exit = -1;
+                    continue;
+                }
+                float a = (lower - ray.origin[k]) / ray.direction[k], b = (upper - ray.origin[k]) / ray.direction[k];
+                t_entry = std::max(t_entry, std::min(a, b));
+                t_exit = std::min(t_exit, std::max(a, b));
+            }
+            if (t_entry < t_exit)
+                result.push_back(crossing_t{leaf, t_entry, t_exit});
+        }
+        std::sort(result.begin(), result.end(), [](const crossing_t& a, const crossing_t& b){
+            return a.t_entry < b.t_entry;
+        });
+        return result;
+    }
+
+    octree_t octree;
+    std::vector<code_t> leaves;
+    linear_octree_t linear;
+    std::vector<cubexx::ray_t> rays;
+    const std::array<float, 3> lower = {{0, 0, 0}};
+};
+
+const std::size_t CUBEXXRaycastTest::DEPTH;
+
+
+TEST_F(CUBEXXRaycastTest,raycast)
+{
+    std::size_t hits = 0;
+    for (const auto& ray : rays)
+    {
+        auto expected = brute_force(ray);
+        auto hit = cubexx::raycast(linear, lower, 1, ray);
+        ASSERT_EQ(!expected.empty(), hit.hit);
+        if (!hit.hit)
+            continue;
+        ++hits;
+        ///ties between leaves touching the ray at the same point are possible, but not with these rays
+        ASSERT_EQ(expected.front().code, hit.node);
+        ASSERT_NEAR(expected.front().t_entry, hit.t_entry, 1e-4);
+        ASSERT_NEAR(expected.front().t_exit, hit.t_exit, 1e-4);
+
+        ///the same in the pooled octree
+        auto pooled_hit = cubexx::raycast(octree, lower, 1, ray);
+        ASSERT_TRUE(pooled_hit.hit);
+        ASSERT_EQ(octree.find(hit.node), pooled_hit.node);
+        ASSERT_EQ(hit.t_entry, pooled_hit.t_entry);
+        ASSERT_EQ(hit.face, pooled_hit.face);
+    }
+    ///the test means something
+    ASSERT_LT(50U, hits);
+}
+
+TEST_F(CUBEXXRaycastTest,visit)
+{
+    for (const auto& ray : rays)
+    {
+        auto expected = brute_force(ray);
+        std::vector<crossing_t> visited;
+        cubexx::raycast_visit(linear, lower, 1, ray,
+            [&](const code_t& code, float t_entry, float t_exit, const cubexx::face_t&){
+                visited.push_back(crossing_t{code, t_entry, t_exit});
+                return false;
+            });
+
+        ASSERT_EQ(expected.size(), visited.size());
+        for (std::size_t i = 0; i < visited.size(); ++i)
+        {
+            ASSERT_EQ(expected[i].code, visited[i].code);
+            ///front to back, and each leaf starts where the last one ended (if they touch)
+            if (i > 0)
+            {
+                ASSERT_LE(visited[i - 1].t_entry, visited[i].t_entry);
+            }
+        }
+    }
+}
+
+TEST_F(CUBEXXRaycastTest,face)
+{
+    ///into a full tree, straight along each axis
+    octree_t full;
+    full.subdivide(full.root());
+    for (auto direction : cubexx::direction_t::all())
+    {
+        cubexx::ray_t ray = {{{0.25f, 0.25f, 0.25f}}, {{float(direction.x()), float(direction.y()), float(direction.z())}}};
+        for (std::size_t k = 0; k < 3; ++k)
+            ray.origin[k] -= 2 * ray.direction[k];
+
+        auto hit = cubexx::raycast(full, lower, 1, ray);
+        ASSERT_TRUE(hit.hit);
+        ///entering against the direction of travel
+        ASSERT_EQ(cubexx::face_t::get(direction.opposite()), hit.face);
+        ASSERT_NEAR(direction.positive() ? 1.75f : 1.25f, hit.t_entry, 1e-6);
+        ASSERT_NEAR(direction.positive() ? 2.25f : 1.75f, hit.t_exit, 1e-6);
+    }
+
+    ///from inside a leaf, there is no entry face
+    cubexx::ray_t inside = {{{0.1f, 0.1f, 0.1f}}, {{1, 0, 0}}};
+    auto hit = cubexx::raycast(full, lower, 1, inside);
+    ASSERT_TRUE(hit.hit);
+    ASSERT_TRUE(hit.face.is_null());
+    ASSERT_EQ(0, hit.t_entry);
+    ASSERT_NEAR(0.4f, hit.t_exit, 1e-6);
+
+    ///pointing away
+    cubexx::ray_t away = {{{2, 2, 2}}, {{1, 0, 0}}};
+    ASSERT_FALSE(cubexx::raycast(full, lower, 1, away).hit);
+
+    ///an empty linear octree has nothing to hit
+    ASSERT_FALSE(cubexx::raycast(linear_octree_t(), lower, 1, inside).hit);
+}
+
+TEST_F(CUBEXXRaycastTest,packet)
+{
+    auto check = [&](auto width){
+        const std::size_t WIDTH = decltype(width)::value;
+        for (std::size_t first = 0; first + WIDTH <= rays.size(); first += WIDTH)
+        {
+            cubexx::ray_hit_t<linear_octree_t> hits[WIDTH];
+            cubexx::raycast_packet<WIDTH>(linear, lower, 1, rays.data() + first, hits);
+            for (std::size_t i = 0; i < WIDTH; ++i)
+            {
+                auto expected = cubexx::raycast(linear, lower, 1, rays[first + i]);
+                ASSERT_EQ(expected.hit, hits[i].hit);
+                if (!expected.hit)
+                    continue;
+                ASSERT_EQ(expected.node, hits[i].node);
+                ASSERT_EQ(expected.t_entry, hits[i].t_entry);
+                ASSERT_EQ(expected.t_exit, hits[i].t_exit);
+                ASSERT_EQ(expected.face, hits[i].face);
+            }
+        }
+    };
+    check(std::integral_constant<std::size_t, 4>());
+    check(std::integral_constant<std::size_t, 8>());
+}
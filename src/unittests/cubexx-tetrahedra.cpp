@@ -0,0 +1,246 @@
+#include <set>
+#include <array>
+#include <vector>
+#include <random>
+#include <utility>
+#include <algorithm>
+#include <cstdint>
+
+#include "cubexx/cubexx.hpp"
+#include "cubexx/tetrahedra.hpp"
+#include "cubexx/formatters.hpp"
+
+#include "gtest/gtest.h"
+
+
+
+
+
+struct CUBEXXTetrahedraTest : public ::testing::Test {
+protected:
+    typedef std::array<double, 3> point_t;
+
+    virtual void SetUp() {
+    // Code here will be called immediately after the constructor (right
+    // before each test).
+
+    }
+
+    virtual void TearDown() {
+    // Code here will be called immediately after each test
+    // (right before the destructor).
+    
+    }
+
+    static point_t position(const cubexx::corner_t& corner)
+    {
+        return {{double(corner.ux()), double(corner.uy()), double(corner.uz())}};
+    }
+
+    static double determinant(const point_t& u, const point_t& v, const point_t& w)
+    {
+        return u[0] * (v[1] * w[2] - v[2] * w[1]) - u[1] * (v[0] * w[2] - v[2] * w[0]) + u[2] * (v[0] * w[1] - v[1] * w[0]);
+    }
+
+    static point_t minus(const point_t& a, const point_t& b)
+    {
+        return {{a[0] - b[0], a[1] - b[1], a[2] - b[2]}};
+    }
+
+    ///six times the signed volume
+    static double volume(const cubexx::tetrahedron_t& t)
+    {
+        point_t a = position(t[0]);
+        return determinant(minus(position(t[1]), a), minus(position(t[2]), a), minus(position(t[3]), a));
+    }
+
+    static bool contains(const cubexx::tetrahedron_t& t, const point_t& p)
+    {
+        ///on the inner side of each face
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            point_t corners[4];
+            for (std::size_t j = 0; j < 4; ++j)
+                corners[j] = j == i ? p : position(t[j]);
+            if (determinant(minus(corners[1], corners[0]), minus(corners[2], corners[0]), minus(corners[3], corners[0])) <= 0)
+                return false;
+        }
+        return true;
+    }
+
+    ///positively oriented, distinct corners, and together they fill the cube once
+    template<std::size_t N>
+    static void check_decomposition(const std::array<cubexx::tetrahedron_t, N>& tetrahedra)
+    {
+        double total = 0;
+        for (const auto& t : tetrahedra)
+        {
+            ASSERT_LT(0, volume(t));
+            total += volume(t);
+        }
+        ASSERT_DOUBLE_EQ(6, total);
+
+        std::mt19937 generator(1234);
+        std::uniform_real_distribution<double> distribution(0, 1);
+        for (std::size_t i = 0; i < 1000; ++i)
+        {
+            point_t p = {{distribution(generator), distribution(generator), distribution(generator)}};
+            std::size_t count = 0;
+            for (const auto& t : tetrahedra)
+                count += contains(t, p);
+            ASSERT_EQ(1U, count);
+        }
+    }
+
+    ///for each face, the diagonals the tetrahedra put on it, as pairs of corner indices
+    template<std::size_t N>
+    static std::set<std::pair<std::size_t, std::size_t> > diagonals(const std::array<cubexx::tetrahedron_t, N>& tetrahedra,
+                                                                    const cubexx::face_t& face)
+    {
+        std::set<std::pair<std::size_t, std::size_t> > result;
+        for (const auto& t : tetrahedra)
+            for (std::size_t i = 0; i < 4; ++i)
+                for (std::size_t j = 0; j < 4; ++j)
+                {
+                    const auto& a = t[i];
+                    const auto& b = t[j];
+                    if (a.index() < b.index() && face.is_adjacent(a) && face.is_adjacent(b)
+                        && (a.ux() != b.ux()) + (a.uy() != b.uy()) + (a.uz() != b.uz()) == 2)
+                        result.insert(std::make_pair(std::size_t(a.index()), std::size_t(b.index())));
+                }
+        return result;
+    }
+
+    ///@p corner moved across @p face, as the corner of the neighbor there
+    static std::size_t across(const cubexx::corner_t& corner, const cubexx::face_t& face)
+    {
+        return corner.index() ^ (1U << face.direction().axis());
+    }
+};
+
+static_assert(cubexx::marching_tetrahedra_triangle_count(0) == 0, "the tables are constexpr");
+constexpr std::array<cubexx::tetrahedron_t, 6> constexpr_six
+  = cubexx::six_tetrahedra(cubexx::corner_t::get(std::uint_fast8_t(0)));
+static_assert(constexpr_six[0][0].index() == 0, "the tables are constexpr");
+
+
+TEST_F(CUBEXXTetrahedraTest,six)
+{
+    for (const auto& corner : cubexx::corner_t::all())
+    {
+        auto tetrahedra = cubexx::six_tetrahedra(corner);
+        check_decomposition(tetrahedra);
+        for (const auto& t : tetrahedra)
+        {
+            ///all around the diagonal
+            ASSERT_NE(t.end(), std::find(t.begin(), t.end(), corner));
+            ASSERT_NE(t.end(), std::find(t.begin(), t.end(), corner.opposite()));
+        }
+
+        ///one diagonal on each face, and a translated copy of the cell puts the same one on the opposite face
+        for (const auto& face : cubexx::face_t::all())
+        {
+            auto mine = diagonals(tetrahedra, face), theirs = diagonals(tetrahedra, face.opposite());
+            ASSERT_EQ(1U, mine.size());
+            ASSERT_EQ(1U, theirs.size());
+            auto moved = std::make_pair(across(cubexx::corner_t::get(std::uint_fast8_t(mine.begin()->first)), face),
+                                        across(cubexx::corner_t::get(std::uint_fast8_t(mine.begin()->second)), face));
+            ASSERT_EQ(std::make_pair(std::min(moved.first, moved.second), std::max(moved.first, moved.second)),
+                      *theirs.begin());
+        }
+    }
+}
+
+TEST_F(CUBEXXTetrahedraTest,five)
+{
+    for (bool odd : {false, true})
+    {
+        auto tetrahedra = cubexx::five_tetrahedra(odd);
+        check_decomposition(tetrahedra);
+        ASSERT_DOUBLE_EQ(2, volume(tetrahedra[0]));
+
+        ///the neighbor, of the other parity, puts the same diagonal on the shared face
+        auto other = cubexx::five_tetrahedra(!odd);
+        for (const auto& face : cubexx::face_t::all())
+        {
+            auto mine = diagonals(tetrahedra, face), theirs = diagonals(other, face.opposite());
+            ASSERT_EQ(1U, mine.size());
+            ASSERT_EQ(1U, theirs.size());
+            auto moved = std::make_pair(across(cubexx::corner_t::get(std::uint_fast8_t(mine.begin()->first)), face),
+                                        across(cubexx::corner_t::get(std::uint_fast8_t(mine.begin()->second)), face));
+            ASSERT_EQ(std::make_pair(std::min(moved.first, moved.second), std::max(moved.first, moved.second)),
+                      *theirs.begin());
+        }
+    }
+}
+
+TEST_F(CUBEXXTetrahedraTest,cases)
+{
+    auto tetrahedra = cubexx::five_tetrahedra(true);
+    for (std::uint_fast8_t inside = 0; inside < 16; ++inside)
+    {
+        std::uint_fast8_t crossed = 0;
+        for (std::size_t e = 0; e < 6; ++e)
+        {
+            auto edge = cubexx::tetrahedron_edge(e);
+            if (((inside >> edge[0]) & 1) != ((inside >> edge[1]) & 1))
+                crossed |= std::uint_fast8_t(1 << e);
+        }
+        ASSERT_EQ(crossed, cubexx::marching_tetrahedra_edges(inside));
+
+        std::size_t count = cubexx::marching_tetrahedra_triangle_count(inside);
+        std::size_t straddling = 0;
+        for (std::size_t bits = crossed; bits; bits &= bits - 1)
+            ++straddling;
+        ASSERT_EQ(straddling == 0 ? 0U : straddling - 2, count);
+
+        std::uint_fast8_t used = 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto triangle = cubexx::marching_tetrahedra_triangle(inside, i);
+            for (auto e : triangle)
+            {
+                ASSERT_TRUE((crossed >> e) & 1);
+                used |= std::uint_fast8_t(1 << e);
+            }
+
+            ///facing from the inside corners of its edges to the outside ones, in every tetrahedron of the split
+            for (const auto& t : tetrahedra)
+            {
+                point_t vertices[3], outward = {{0, 0, 0}};
+                for (std::size_t j = 0; j < 3; ++j)
+                {
+                    auto edge = cubexx::tetrahedron_edge(triangle[j]);
+                    point_t a = position(t[edge[0]]), b = position(t[edge[1]]);
+                    vertices[j] = {{(a[0] + b[0]) / 2, (a[1] + b[1]) / 2, (a[2] + b[2]) / 2}};
+                    point_t out = (inside >> edge[0]) & 1 ? minus(b, a) : minus(a, b);
+                    for (std::size_t k = 0; k < 3; ++k)
+                        outward[k] += out[k];
+                }
+                point_t u = minus(vertices[1], vertices[0]), v = minus(vertices[2], vertices[0]);
+                point_t normal = {{u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0]}};
+                ASSERT_LT(0, normal[0] * outward[0] + normal[1] * outward[1] + normal[2] * outward[2]);
+            }
+        }
+        ASSERT_EQ(crossed, used);
+    }
+}
+
+TEST_F(CUBEXXTetrahedraTest,classify_row)
+{
+    std::mt19937 generator(1234);
+    std::uniform_int_distribution<int> distribution(0, 255);
+    auto six = cubexx::six_tetrahedra(cubexx::corner_t::get(std::uint_fast8_t(3)));
+    for (std::size_t n : {0, 5, 16, 37})
+    {
+        std::vector<std::uint8_t> cases;
+        for (std::size_t x = 0; x < n; ++x)
+            cases.push_back(std::uint8_t(distribution(generator)));
+
+        std::vector<std::uint8_t> result(6 * n, 0xFF);
+        cubexx::marching_tetrahedra_classify_row(cases.data(), n, six, result.data());
+        for (std::size_t t = 0; t < 6; ++t)
+            for (std::size_t x = 0; x < n; ++x)
+                ASSERT_EQ(cubexx::tetrahedron_case(six[t], cubexx::corner_set_t::from_mask(cases[x])), result[t * n + x]);
+    }
+}